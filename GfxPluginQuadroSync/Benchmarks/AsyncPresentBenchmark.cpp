@@ -0,0 +1,336 @@
+// Runs PluginCSwapGroupClient against SimulatedSyncApi in real time (presents block until the barrier release computed
+// by the simulator) with a render thread spending a fixed amount of CPU time on every frame, presenting from the render
+// thread and then from the present worker thread (PluginCSwapGroupClient::EnableAsyncPresent).  Reports the frame rate
+// and how long the render thread was blocked in Render.  Prints one line of space separated "key=value" per mode.
+//
+// Usage: AsyncPresentBenchmark [--frames N] [--cpu-us N] [--nodes N] [--seed N] [--in-flight N] [--back-buffers N]
+//
+// Every frame follows the order of Unity's render thread: it renders the frame (--cpu-us, writing to the back buffer),
+// queries the frame count (like the QuadroSyncQueryFrameCount render event) and then calls Render (the
+// QuadroSyncPresent render event), nothing else waits for the presents.  hazards counts the frames rendered to a back
+// buffer that was still waiting to be presented (what IGraphicsDevice::WaitForNextBackBuffer prevents) and
+// backBufferWaits the times Render had to wait for that back buffer.  RealTimeSyncApi not being thread safe, this also
+// checks (when built with -fsanitize=thread) that PluginCSwapGroupClient never calls the ISyncApi while the present
+// worker is presenting.
+
+#include "BarrierWarmup.h"
+#include "IDatagramTransport.h"
+#include "IGraphicsDevice.h"
+#include "QuadroSync.h"
+#include "SimulatedSyncApi.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace GfxQuadroSync;
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     * IGraphicsDevice counting its presents (done by RealTimeSyncApi once the barrier is released) and tracking the
+     * presents queued to every back buffer like D3D12GraphicsDevice does with its fences.
+     */
+    class CountingGraphicsDevice final : public IGraphicsDevice
+    {
+    public:
+        explicit CountingGraphicsDevice(const uint32_t backBufferCount)
+            : m_QueuedPresentCounts(backBufferCount)
+            , m_DonePresentCounts(backBufferCount)
+        {
+        }
+
+        // Remarks: Type is not used by PluginCSwapGroupClient.
+        GraphicsDeviceType GetDeviceType() const override { return GraphicsDeviceType::GRAPHICS_DEVICE_D3D12; }
+
+        IUnknown* GetDevice() const override { return nullptr; }
+        // Remarks: Swap chains are only compared by SimulatedSyncApi, so any non null value will do.
+        IDXGISwapChain* GetSwapChain() const override { return reinterpret_cast<IDXGISwapChain*>(1); }
+        UINT32 GetSyncInterval() const override { return 1; }
+        UINT GetPresentFlags() const override { return 0; }
+
+        void SetDevice(IUnknown* const) override { }
+        void SetSwapChain(IDXGISwapChain* const) override { }
+
+        bool Present() override
+        {
+            m_PresentCount.fetch_add(1, std::memory_order_release);
+            return true;
+        }
+
+        void InitiatePresentRepeats() override { }
+        void PrepareSinglePresentRepeat() override { }
+        void ConcludePresentRepeats() override { }
+
+        uint32_t GetBackBufferCount() const override { return static_cast<uint32_t>(m_QueuedPresentCounts.size()); }
+
+        uint32_t OnAsyncPresentQueued() override
+        {
+            std::lock_guard lock(m_Lock);
+            // The swap chain moves to the next back buffer on every present.
+            if (m_AsyncPresentsInFlight == 0)
+            {
+                m_NextBackBufferIndex = static_cast<uint32_t>(GetPresentCount() % GetBackBufferCount());
+            }
+            const auto backBufferIndex = m_NextBackBufferIndex;
+            ++m_QueuedPresentCounts[backBufferIndex];
+            m_NextBackBufferIndex = (backBufferIndex + 1) % GetBackBufferCount();
+            ++m_AsyncPresentsInFlight;
+            return backBufferIndex;
+        }
+
+        void OnAsyncPresentDone(const uint32_t backBufferIndex) override
+        {
+            {
+                std::lock_guard lock(m_Lock);
+                ++m_DonePresentCounts[backBufferIndex];
+                --m_AsyncPresentsInFlight;
+            }
+            m_Changed.notify_all();
+        }
+
+        void WaitForNextBackBuffer() override
+        {
+            std::unique_lock lock(m_Lock);
+            if (IsNextBackBufferPending())
+            {
+                ++m_BackBufferWaitCount;
+                m_Changed.wait(lock, [this] { return !IsNextBackBufferPending(); });
+            }
+        }
+
+        uint64_t GetPresentCount() const { return m_PresentCount.load(std::memory_order_acquire); }
+        uint64_t GetBackBufferWaitCount() const { return m_BackBufferWaitCount; }
+
+        /// Is the back buffer the render thread is about to render to still waiting to be presented?
+        bool IsRenderedBackBufferPending()
+        {
+            std::lock_guard lock(m_Lock);
+            return IsNextBackBufferPending();
+        }
+
+    private:
+        bool IsNextBackBufferPending() const
+        {
+            return m_DonePresentCounts[m_NextBackBufferIndex] < m_QueuedPresentCounts[m_NextBackBufferIndex];
+        }
+
+        std::atomic<uint64_t> m_PresentCount = 0;
+        std::mutex m_Lock;
+        std::condition_variable m_Changed;
+        std::vector<uint64_t> m_QueuedPresentCounts;
+        std::vector<uint64_t> m_DonePresentCounts;
+        uint32_t m_NextBackBufferIndex = 0;
+        uint32_t m_AsyncPresentsInFlight = 0;
+        uint64_t m_BackBufferWaitCount = 0;
+    };
+
+    /**
+     * ISyncApi forwarding to a SimulatedSyncApi whose virtual clock follows the real one, presents sleep until the
+     * release of the barrier.  Not thread safe, like every ISyncApi (PluginCSwapGroupClient never calls it
+     * concurrently even when Present is called from the present worker thread).
+     */
+    class RealTimeSyncApi final : public ISyncApi
+    {
+    public:
+        explicit RealTimeSyncApi(const SimulatedSyncApi::Config& config)
+            : m_Simulated(config)
+            , m_Origin(Clock::now())
+        {
+        }
+
+        const char* GetName() const override { return "RealTimeSyncApi"; }
+        SyncApiStatus Initialize() override
+        {
+            return m_Simulated.Initialize();
+        }
+        SyncApiStatus SetupWorkstationSwapGroupFeature(const bool enable) override
+        {
+            return m_Simulated.SetupWorkstationSwapGroupFeature(enable);
+        }
+        SyncApiStatus QueryMaxSwapGroup(IUnknown* const pDevice, uint32_t& maxGroups, uint32_t& maxBarriers) override
+        {
+            return m_Simulated.QueryMaxSwapGroup(pDevice, maxGroups, maxBarriers);
+        }
+        SyncApiStatus JoinSwapGroup(IUnknown* const pDevice, IDXGISwapChain* const pSwapChain, const uint32_t group,
+            const bool blocking) override
+        {
+            return m_Simulated.JoinSwapGroup(pDevice, pSwapChain, group, blocking);
+        }
+        SyncApiStatus BindSwapBarrier(IUnknown* const pDevice, const uint32_t group, const uint32_t barrier) override
+        {
+            return m_Simulated.BindSwapBarrier(pDevice, group, barrier);
+        }
+        SyncApiStatus QuerySwapGroup(IUnknown* const pDevice, IDXGISwapChain* const pSwapChain, uint32_t& group,
+            uint32_t& barrier) override
+        {
+            return m_Simulated.QuerySwapGroup(pDevice, pSwapChain, group, barrier);
+        }
+        SyncApiStatus QueryFrameCount(IUnknown* const pDevice, uint32_t& frameCount) override
+        {
+            return m_Simulated.QueryFrameCount(pDevice, frameCount);
+        }
+        SyncApiStatus ResetFrameCount(IUnknown* const pDevice) override
+        {
+            return m_Simulated.ResetFrameCount(pDevice);
+        }
+
+        SyncApiStatus Present(IGraphicsDevice& graphicsDevice) override
+        {
+            const auto elapsedNs = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_Origin).count());
+            if (elapsedNs > m_Simulated.GetNowNs())
+            {
+                m_Simulated.AdvanceTime(elapsedNs - m_Simulated.GetNowNs());
+            }
+            const auto status = m_Simulated.Present(graphicsDevice);
+            std::this_thread::sleep_until(m_Origin + std::chrono::nanoseconds(m_Simulated.GetNowNs()));
+            if (status == SyncApiStatus::Ok)
+            {
+                graphicsDevice.Present();
+            }
+            return status;
+        }
+
+        uint64_t GetMissedVblankCount() const
+        {
+            return m_Simulated.GetMissedVblankCount();
+        }
+
+    private:
+        SimulatedSyncApi m_Simulated;
+        const Clock::time_point m_Origin;
+    };
+
+    /// IDatagramTransport for a BarrierWarmup without other nodes to communicate with.
+    class NullTransport final : public IDatagramTransport
+    {
+    public:
+        bool Send(const void*, size_t) override { return true; }
+        int Receive(void*, size_t, const std::chrono::microseconds timeout) override
+        {
+            std::this_thread::sleep_for(timeout);
+            return 0;
+        }
+    };
+
+    struct Parameters
+    {
+        uint64_t frameCount = 150;
+        uint32_t cpuUs = 20000;
+        uint32_t inFlightFrames = 1;
+        uint32_t backBufferCount = 3;
+        SimulatedSyncApi::Config syncApiConfig;
+    };
+
+    bool Run(const Parameters& parameters, const bool async)
+    {
+        auto syncApiOwner = std::make_unique<RealTimeSyncApi>(parameters.syncApiConfig);
+        auto& syncApi = *syncApiOwner;
+        CountingGraphicsDevice graphicsDevice(parameters.backBufferCount);
+        PluginCSwapGroupClient client(std::move(syncApiOwner));
+        BarrierWarmup::Config warmupConfig;
+        warmupConfig.isEmitter = true;
+        client.GetBarrierWarmup().Start(warmupConfig, std::make_unique<NullTransport>());
+        client.SetupWorkStation();
+        if (client.Initialize(nullptr, graphicsDevice.GetSwapChain()) !=
+            PluginCSwapGroupClient::InitializeStatus::Success)
+        {
+            std::cerr << "Failed to initialize PluginCSwapGroupClient" << std::endl;
+            return false;
+        }
+        client.EnableSyncCounter(true);
+        client.EnableAsyncPresent(async ? parameters.inFlightFrames : 0);
+
+        uint64_t hazardCount = 0;
+        Clock::duration renderBlockedDuration{0};
+        const auto begin = Clock::now();
+        for (uint64_t frameIndex = 0; frameIndex < parameters.frameCount; ++frameIndex)
+        {
+            // Render the frame (culling, command recording, offscreen passes, ...) to the back buffer.
+            if (graphicsDevice.IsRenderedBackBufferPending())
+            {
+                ++hazardCount;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(parameters.cpuUs));
+
+            // Like the QuadroSyncQueryFrameCount render event (queries the ISyncApi every few seconds).
+            client.QueryFrameCount(nullptr);
+
+            const auto renderStart = Clock::now();
+            client.Render(&graphicsDevice);
+            renderBlockedDuration += Clock::now() - renderStart;
+        }
+        client.WaitForPendingPresents();
+        const auto elapsed = Clock::now() - begin;
+
+        const auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+        const auto blockedUs = std::chrono::duration_cast<std::chrono::microseconds>(renderBlockedDuration).count();
+        const auto frames = static_cast<int64_t>(parameters.frameCount > 0 ? parameters.frameCount : 1);
+        const auto& presentWorker = client.GetPresentWorker();
+        std::cout << "mode=" << (async ? "async" : "sync") << " frames=" << parameters.frameCount
+                  << " cpuUs=" << parameters.cpuUs << " inFlight=" << (async ? parameters.inFlightFrames : 0)
+                  << " fps=" << (elapsedUs > 0 ? parameters.frameCount * 1000000 / elapsedUs : 0)
+                  << " renderBlockedUsPerFrame=" << blockedUs / frames
+                  << " presented=" << graphicsDevice.GetPresentCount()
+                  << " presentFailures=" << client.GetPresentFailureCount()
+                  << " missedVblanks=" << syncApi.GetMissedVblankCount()
+                  << " stalls=" << presentWorker.GetStallCount()
+                  << " maxInFlight=" << presentWorker.GetMaxInFlightCount()
+                  << " backBufferWaits=" << graphicsDevice.GetBackBufferWaitCount() << " hazards=" << hazardCount
+                  << std::endl;
+
+        client.Dispose(nullptr, graphicsDevice.GetSwapChain());
+        client.DisposeWorkStation();
+        return true;
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    Parameters parameters;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const char* const name = argv[i];
+        const auto value = std::strtoull(argv[i + 1], nullptr, 10);
+        if (std::strcmp(name, "--frames") == 0)
+            parameters.frameCount = value;
+        else if (std::strcmp(name, "--cpu-us") == 0)
+            parameters.cpuUs = static_cast<uint32_t>(value);
+        else if (std::strcmp(name, "--nodes") == 0)
+            parameters.syncApiConfig.nodeCount = static_cast<uint32_t>(value);
+        else if (std::strcmp(name, "--seed") == 0)
+            parameters.syncApiConfig.seed = value;
+        else if (std::strcmp(name, "--in-flight") == 0)
+            parameters.inFlightFrames = static_cast<uint32_t>(value);
+        else if (std::strcmp(name, "--back-buffers") == 0)
+            parameters.backBufferCount = static_cast<uint32_t>(value);
+        else
+        {
+            std::cerr << "Unknown argument: " << name << std::endl;
+            return 1;
+        }
+    }
+    if (parameters.inFlightFrames == 0)
+    {
+        std::cerr << "--in-flight must be at least 1" << std::endl;
+        return 1;
+    }
+    if (parameters.backBufferCount < 2)
+    {
+        std::cerr << "--back-buffers must be at least 2" << std::endl;
+        return 1;
+    }
+
+    return Run(parameters, false) && Run(parameters, true) ? 0 : 1;
+}
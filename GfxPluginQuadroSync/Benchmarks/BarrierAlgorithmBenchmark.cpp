@@ -0,0 +1,343 @@
+// Compares the barrier algorithms of SoftwareSyncApi on clusters of in-process nodes (one thread per node) connected
+// by a SimulatedNetwork.  For every algorithm and every node count, every node renders --frames frames (sleeping
+// --render-us plus up to --render-jitter-us, followed by a few frames that are not measured) and presents through the
+// barrier.  Since every node shares the same clock, the release latency of a frame (between the arrival of the last
+// node and the release of the last node) can be measured.  Prints one line of space separated "key=value" per
+// algorithm and node count.
+//
+// Usage: BarrierAlgorithmBenchmark [--algorithms all-to-all,tree,dissemination] [--nodes 8,32,64,128] [--fan-out N]
+//                                  [--frames N] [--render-us N] [--render-jitter-us N] [--latency-us N]
+//                                  [--network-jitter-us N] [--loss-probability P] [--timeout-ms N]
+//                                  [--dead-node N] [--dead-after-frames N]
+//
+// --dead-node stops node N (0 is the root of the tree) after --dead-after-frames frames, timeouts then counts how many
+// times the other nodes waited on it and fell_back how many nodes switched from Tree to AllToAll.
+
+#include "IGraphicsDevice.h"
+#include "SimulatedNetwork.h"
+#include "SoftwareSyncApi.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace GfxQuadroSync;
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+    typedef SoftwareSyncApi::BarrierAlgorithm BarrierAlgorithm;
+
+    /// IGraphicsDevice without any display (presents are instantaneous).
+    class NullGraphicsDevice final : public IGraphicsDevice
+    {
+    public:
+        // Remarks: Type is not used by SoftwareSyncApi.
+        GraphicsDeviceType GetDeviceType() const override { return GraphicsDeviceType::GRAPHICS_DEVICE_D3D11; }
+
+        IUnknown* GetDevice() const override { return nullptr; }
+        IDXGISwapChain* GetSwapChain() const override { return nullptr; }
+        UINT32 GetSyncInterval() const override { return 1; }
+        UINT GetPresentFlags() const override { return 0; }
+
+        void SetDevice(IUnknown* const) override { }
+        void SetSwapChain(IDXGISwapChain* const) override { }
+
+        bool Present() override { return true; }
+
+        void InitiatePresentRepeats() override { }
+        void PrepareSinglePresentRepeat() override { }
+        void ConcludePresentRepeats() override { }
+    };
+
+    struct Parameters
+    {
+        std::vector<BarrierAlgorithm> algorithms{BarrierAlgorithm::AllToAll, BarrierAlgorithm::Tree,
+            BarrierAlgorithm::Dissemination};
+        std::vector<uint32_t> nodeCounts{8, 32, 64, 128};
+        uint32_t fanOut = 4;
+        uint64_t frameCount = 200;
+        uint32_t renderUs = 2000;
+        uint32_t renderJitterUs = 1000;
+        uint32_t latencyUs = 50;
+        uint32_t networkJitterUs = 20;
+        double lossProbability = 0.0;
+        uint32_t timeoutMs = 1000;
+        int deadNode = -1;
+        uint64_t deadAfterFrames = 0;
+    };
+
+    /// Frames at the beginning that are not measured (while nodes get in step).
+    constexpr uint64_t k_SkippedFrames = 10;
+    /// Frames rendered after the measured ones (so that nodes are still there to answer the last measured frame).
+    constexpr uint64_t k_DrainFrames = 10;
+
+    const char* ToString(const BarrierAlgorithm algorithm)
+    {
+        switch (algorithm)
+        {
+        case BarrierAlgorithm::Tree:
+            return "tree";
+        case BarrierAlgorithm::Dissemination:
+            return "dissemination";
+        case BarrierAlgorithm::AllToAll:
+        default:
+            return "all-to-all";
+        }
+    }
+
+    bool ParseAlgorithm(const std::string& name, BarrierAlgorithm& algorithm)
+    {
+        for (const auto candidate : {BarrierAlgorithm::AllToAll, BarrierAlgorithm::Tree,
+                 BarrierAlgorithm::Dissemination})
+        {
+            if (name == ToString(candidate))
+            {
+                algorithm = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<std::string> Split(const char* value)
+    {
+        std::vector<std::string> items;
+        std::istringstream is(value);
+        std::string item;
+        while (std::getline(is, item, ','))
+        {
+            items.push_back(item);
+        }
+        return items;
+    }
+
+    int64_t GetPercentile(std::vector<int64_t> values, double percentile)
+    {
+        if (values.empty())
+        {
+            return 0;
+        }
+        const auto index = std::min(static_cast<size_t>(values.size() * percentile), values.size() - 1);
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+
+    /// Arrival at and release from the barrier of every frame of a node.
+    struct NodeTimes
+    {
+        std::vector<Clock::time_point> arrivals;
+        std::vector<Clock::time_point> releases;
+        /// Number of timeouts at the end of the measured frames.
+        uint64_t timeoutCount = 0;
+    };
+
+    void RunNode(const Parameters& parameters, const uint32_t nodeId, SoftwareSyncApi& syncApi, NodeTimes& times)
+    {
+        NullGraphicsDevice graphicsDevice;
+        uint64_t randomState = 0x9e3779b97f4a7c15ull * (nodeId + 1);
+        times.arrivals.reserve(parameters.frameCount);
+        times.releases.reserve(parameters.frameCount);
+        for (uint64_t frameIndex = 0; frameIndex < parameters.frameCount + k_DrainFrames; ++frameIndex)
+        {
+            if (frameIndex == parameters.frameCount)
+            {
+                times.timeoutCount = syncApi.GetTimeoutCount();
+            }
+            if (static_cast<int>(nodeId) == parameters.deadNode && frameIndex == parameters.deadAfterFrames)
+            {
+                // Stop answering the other nodes.
+                return;
+            }
+            randomState = randomState * 6364136223846793005ull + 1442695040888963407ull;
+            const auto jitterUs = parameters.renderJitterUs > 0 ?
+                (randomState >> 33) % (parameters.renderJitterUs + 1) : 0;
+            std::this_thread::sleep_for(std::chrono::microseconds(parameters.renderUs + jitterUs));
+            times.arrivals.push_back(Clock::now());
+            syncApi.Present(graphicsDevice);
+            times.releases.push_back(Clock::now());
+        }
+    }
+
+    bool Run(const Parameters& parameters, const BarrierAlgorithm algorithm, const uint32_t nodeCount)
+    {
+        SimulatedNetwork::Config networkConfig;
+        networkConfig.latency = std::chrono::microseconds(parameters.latencyUs);
+        networkConfig.jitter = std::chrono::microseconds(parameters.networkJitterUs);
+        networkConfig.lossProbability = parameters.lossProbability;
+        SimulatedNetwork network(networkConfig);
+
+        // Remarks: Endpoints are addressed by creation order, so they must be created in node id order.
+        std::vector<std::unique_ptr<SoftwareSyncApi>> syncApis;
+        for (uint32_t nodeId = 0; nodeId < nodeCount; ++nodeId)
+        {
+            SoftwareSyncApi::Config config;
+            config.nodeId = static_cast<uint8_t>(nodeId);
+            for (uint32_t otherNodeId = 0; otherNodeId < nodeCount; ++otherNodeId)
+            {
+                config.nodes.set(otherNodeId);
+            }
+            config.timeout = std::chrono::milliseconds(parameters.timeoutMs);
+            config.algorithm = algorithm;
+            config.fanOut = parameters.fanOut;
+            syncApis.push_back(std::make_unique<SoftwareSyncApi>(config, network.CreateEndpoint()));
+
+            auto& syncApi = *syncApis.back();
+            if (syncApi.Initialize() != SyncApiStatus::Ok ||
+                syncApi.JoinSwapGroup(nullptr, nullptr, 1, false) != SyncApiStatus::Ok ||
+                syncApi.BindSwapBarrier(nullptr, 1, 1) != SyncApiStatus::Ok)
+            {
+                std::cerr << "Node " << nodeId << " failed to join the swap barrier" << std::endl;
+                return false;
+            }
+        }
+
+        std::vector<NodeTimes> times(nodeCount);
+        std::vector<std::thread> threads;
+        for (uint32_t nodeId = 0; nodeId < nodeCount; ++nodeId)
+        {
+            threads.emplace_back([&parameters, nodeId, &syncApis, &times]
+                { RunNode(parameters, nodeId, *syncApis[nodeId], times[nodeId]); });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        std::vector<int64_t> releaseLatenciesUs;
+        for (uint64_t frameIndex = k_SkippedFrames; frameIndex < parameters.frameCount; ++frameIndex)
+        {
+            auto lastArrival = Clock::time_point::min();
+            auto lastRelease = Clock::time_point::min();
+            for (const auto& nodeTimes : times)
+            {
+                if (frameIndex >= nodeTimes.arrivals.size())
+                {
+                    continue;
+                }
+                lastArrival = std::max(lastArrival, nodeTimes.arrivals[frameIndex]);
+                lastRelease = std::max(lastRelease, nodeTimes.releases[frameIndex]);
+            }
+            releaseLatenciesUs.push_back(
+                std::chrono::duration_cast<std::chrono::microseconds>(lastRelease - lastArrival).count());
+        }
+
+        uint64_t timeoutCount = 0;
+        uint32_t fellBackCount = 0;
+        uint64_t skewCount = 0;
+        uint64_t skewSumUs = 0;
+        for (uint32_t nodeId = 0; nodeId < nodeCount; ++nodeId)
+        {
+            const auto& syncApi = syncApis[nodeId];
+            timeoutCount += times[nodeId].timeoutCount;
+            fellBackCount += syncApi->GetAlgorithm() != algorithm ? 1 : 0;
+            skewCount += syncApi->GetReleaseSkewStatistics().GetCount();
+            skewSumUs += syncApi->GetReleaseSkewStatistics().GetSumUs();
+        }
+        const auto nodeFrames = static_cast<double>(nodeCount) * (parameters.frameCount + k_DrainFrames);
+        std::cout << "algorithm=" << ToString(algorithm)
+                  << " nodes=" << nodeCount
+                  << " fan_out=" << parameters.fanOut
+                  << " frames=" << parameters.frameCount
+                  << " timeouts=" << timeoutCount
+                  << " fell_back=" << fellBackCount
+                  << " sent_per_node_frame=" << network.GetSentCount() / nodeFrames
+                  << " received_per_node_frame=" << network.GetDeliveredCount() / nodeFrames
+                  << " release_latency_p50_us=" << GetPercentile(releaseLatenciesUs, 0.5)
+                  << " release_latency_p99_us=" << GetPercentile(releaseLatenciesUs, 0.99)
+                  << " release_latency_max_us=" << GetPercentile(releaseLatenciesUs, 1.0)
+                  << " skew_mean_us=" << (skewCount > 0 ? skewSumUs / skewCount : 0)
+                  << std::endl;
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Parameters parameters;
+    for (int argIndex = 1; argIndex + 1 < argc; argIndex += 2)
+    {
+        const char* name = argv[argIndex];
+        const char* value = argv[argIndex + 1];
+        if (strcmp(name, "--algorithms") == 0)
+        {
+            parameters.algorithms.clear();
+            for (const auto& item : Split(value))
+            {
+                BarrierAlgorithm algorithm;
+                if (!ParseAlgorithm(item, algorithm))
+                {
+                    std::cerr << "Unknown algorithm: " << item << std::endl;
+                    return 1;
+                }
+                parameters.algorithms.push_back(algorithm);
+            }
+        }
+        else if (strcmp(name, "--nodes") == 0)
+        {
+            parameters.nodeCounts.clear();
+            for (const auto& item : Split(value))
+            {
+                parameters.nodeCounts.push_back(static_cast<uint32_t>(strtoul(item.c_str(), nullptr, 10)));
+            }
+        }
+        else if (strcmp(name, "--fan-out") == 0)
+            parameters.fanOut = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--frames") == 0)
+            parameters.frameCount = strtoull(value, nullptr, 10);
+        else if (strcmp(name, "--render-us") == 0)
+            parameters.renderUs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--render-jitter-us") == 0)
+            parameters.renderJitterUs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--latency-us") == 0)
+            parameters.latencyUs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--network-jitter-us") == 0)
+            parameters.networkJitterUs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--loss-probability") == 0)
+            parameters.lossProbability = atof(value);
+        else if (strcmp(name, "--timeout-ms") == 0)
+            parameters.timeoutMs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--dead-node") == 0)
+            parameters.deadNode = atoi(value);
+        else if (strcmp(name, "--dead-after-frames") == 0)
+            parameters.deadAfterFrames = strtoull(value, nullptr, 10);
+        else
+        {
+            std::cerr << "Unknown argument: " << name << std::endl;
+            return 1;
+        }
+    }
+
+    for (const auto nodeCount : parameters.nodeCounts)
+    {
+        if (nodeCount < 1 || nodeCount > 256)
+        {
+            std::cerr << "--nodes must be in [1, 256]" << std::endl;
+            return 1;
+        }
+    }
+    if (parameters.fanOut < 1 || parameters.frameCount <= k_SkippedFrames)
+    {
+        std::cerr << "--fan-out must be at least 1 and --frames larger than " << k_SkippedFrames << std::endl;
+        return 1;
+    }
+
+    for (const auto nodeCount : parameters.nodeCounts)
+    {
+        for (const auto algorithm : parameters.algorithms)
+        {
+            if (!Run(parameters, algorithm, nodeCount))
+            {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
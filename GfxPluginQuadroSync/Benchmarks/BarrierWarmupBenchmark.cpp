@@ -0,0 +1,413 @@
+// Runs the barrier warmup of simulated clusters (one PluginCSwapGroupClient per node, each on its own thread) against
+// a swap barrier simulated in real time and a SimulatedNetwork.  Sweeps the node count, present duration and packet
+// loss and reports, for each combination, how long it took for the barrier to be warmed up.  Output is one line per
+// combination made of space separated "key=value" to be easy to parse in CI.
+//
+// Usage: BarrierWarmupBenchmark [--nodes N,N,...] [--present-ms N,N,...] [--loss P,P,...] [--runs N] [--seed N]
+//                               [--render-ms N] [--block-delay-ms N] [--timeout-ms N] [--latency-us N]
+//                               [--network-jitter-us N] [--activation-ms N]
+
+#include "BarrierWarmup.h"
+#include "IGraphicsDevice.h"
+#include "ISyncApi.h"
+#include "QuadroSync.h"
+#include "SimulatedNetwork.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace GfxQuadroSync;
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     * Swap barrier shared by every node of the simulated cluster.  Before being active (a node specific time after
+     * the start of the run) presents of a node take a fixed amount of time; once active, presents return once every
+     * (active) node of the cluster has presented.
+     */
+    class SwapBarrier
+    {
+    public:
+        explicit SwapBarrier(uint32_t nodeCount)
+            : m_ParticipantCount(nodeCount)
+        {
+        }
+
+        void Present(const Clock::time_point activationTime, const std::chrono::microseconds presentDuration)
+        {
+            if (Clock::now() < activationTime)
+            {
+                std::this_thread::sleep_for(presentDuration);
+                return;
+            }
+
+            std::unique_lock<std::mutex> lock(m_Lock);
+            const auto generation = m_Generation;
+            if (++m_ArrivedCount >= m_ParticipantCount)
+            {
+                Release();
+            }
+            else
+            {
+                m_Released.wait(lock, [this, generation] { return m_Generation != generation; });
+            }
+        }
+
+        /// A node stops participating (so that the other nodes are not blocked waiting on it).
+        void Leave()
+        {
+            std::lock_guard<std::mutex> lock(m_Lock);
+            --m_ParticipantCount;
+            if (m_ArrivedCount > 0 && m_ArrivedCount >= m_ParticipantCount)
+            {
+                Release();
+            }
+        }
+
+    private:
+        void Release()
+        {
+            m_ArrivedCount = 0;
+            ++m_Generation;
+            m_Released.notify_all();
+        }
+
+        std::mutex m_Lock;
+        std::condition_variable m_Released;
+        uint32_t m_ParticipantCount;
+        uint32_t m_ArrivedCount = 0;
+        uint64_t m_Generation = 0;
+    };
+
+    /// ISyncApi of a node presenting through SwapBarrier.
+    class BarrierSyncApi final : public ISyncApi
+    {
+    public:
+        BarrierSyncApi(SwapBarrier& barrier, const Clock::time_point activationTime,
+            const std::chrono::microseconds presentDuration)
+            : m_Barrier(barrier)
+            , m_ActivationTime(activationTime)
+            , m_PresentDuration(presentDuration)
+        {
+        }
+
+        const char* GetName() const override { return "SwapBarrier"; }
+
+        SyncApiStatus Initialize() override { return SyncApiStatus::Ok; }
+        SyncApiStatus SetupWorkstationSwapGroupFeature(bool) override { return SyncApiStatus::Ok; }
+
+        SyncApiStatus QueryMaxSwapGroup(IUnknown*, uint32_t& maxGroups, uint32_t& maxBarriers) override
+        {
+            maxGroups = 1;
+            maxBarriers = 1;
+            return SyncApiStatus::Ok;
+        }
+
+        SyncApiStatus JoinSwapGroup(IUnknown*, IDXGISwapChain*, const uint32_t group, bool) override
+        {
+            m_GroupId = group;
+            return SyncApiStatus::Ok;
+        }
+
+        SyncApiStatus BindSwapBarrier(IUnknown*, uint32_t, const uint32_t barrier) override
+        {
+            m_BarrierId = barrier;
+            return SyncApiStatus::Ok;
+        }
+
+        SyncApiStatus QuerySwapGroup(IUnknown*, IDXGISwapChain*, uint32_t& group, uint32_t& barrier) override
+        {
+            group = m_GroupId;
+            barrier = m_BarrierId;
+            return SyncApiStatus::Ok;
+        }
+
+        SyncApiStatus QueryFrameCount(IUnknown*, uint32_t& frameCount) override
+        {
+            frameCount = 0;
+            return SyncApiStatus::Ok;
+        }
+
+        SyncApiStatus ResetFrameCount(IUnknown*) override { return SyncApiStatus::Ok; }
+
+        SyncApiStatus Present(IGraphicsDevice&) override
+        {
+            m_Barrier.Present(m_ActivationTime, m_PresentDuration);
+            return SyncApiStatus::Ok;
+        }
+
+    private:
+        SwapBarrier& m_Barrier;
+        const Clock::time_point m_ActivationTime;
+        const std::chrono::microseconds m_PresentDuration;
+        uint32_t m_GroupId = 0;
+        uint32_t m_BarrierId = 0;
+    };
+
+    /// IGraphicsDevice counting the present repeats requested by PluginCSwapGroupClient.
+    class CountingGraphicsDevice final : public IGraphicsDevice
+    {
+    public:
+        // Remarks: Type is not used by PluginCSwapGroupClient.
+        GraphicsDeviceType GetDeviceType() const override { return GraphicsDeviceType::GRAPHICS_DEVICE_D3D11; }
+
+        IUnknown* GetDevice() const override { return nullptr; }
+        IDXGISwapChain* GetSwapChain() const override { return nullptr; }
+        UINT32 GetSyncInterval() const override { return 1; }
+        UINT GetPresentFlags() const override { return 0; }
+
+        void SetDevice(IUnknown* const) override { }
+        void SetSwapChain(IDXGISwapChain* const) override { }
+
+        bool Present() override { return true; }
+
+        void InitiatePresentRepeats() override { }
+        void PrepareSinglePresentRepeat() override { ++m_RepeatCount; }
+        void ConcludePresentRepeats() override { m_Concluded = true; }
+
+        uint64_t GetRepeatCount() const { return m_RepeatCount; }
+        bool IsConcluded() const { return m_Concluded; }
+
+    private:
+        uint64_t m_RepeatCount = 0;
+        bool m_Concluded = false;
+    };
+
+    struct Parameters
+    {
+        std::vector<uint32_t> nodeCounts{2, 4, 8, 16, 32, 64, 128, 256};
+        std::vector<uint32_t> presentDurationsMs{8, 16};
+        std::vector<double> lossProbabilities{0.0, 0.05, 0.2};
+        uint32_t runs = 3;
+        uint64_t seed = 1;
+        uint32_t renderMs = 4;
+        uint32_t blockDelayMs = 150;
+        uint32_t timeoutMs = 10000;
+        uint32_t latencyUs = 100;
+        uint32_t networkJitterUs = 200;
+        uint32_t activationMs = 100;
+    };
+
+    struct RunResult
+    {
+        bool succeeded = true;
+        double durationMs = 0;
+        double repeatsPerNode = 0;
+        uint64_t datagramsSent = 0;
+        uint64_t datagramsDropped = 0;
+    };
+
+    uint64_t SplitMix64(uint64_t& state)
+    {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    RunResult RunWarmup(const Parameters& parameters, const uint32_t nodeCount, const uint32_t presentDurationMs,
+        const double lossProbability, const uint64_t seed)
+    {
+        SimulatedNetwork::Config networkConfig;
+        networkConfig.seed = seed;
+        networkConfig.lossProbability = lossProbability;
+        networkConfig.latency = std::chrono::microseconds(parameters.latencyUs);
+        networkConfig.jitter = std::chrono::microseconds(parameters.networkJitterUs);
+        SimulatedNetwork network(networkConfig);
+        SwapBarrier barrier(nodeCount);
+
+        // Every node's barrier becomes active at a slightly different time (like the real ones).
+        uint64_t randomState = seed;
+        const auto start = Clock::now();
+        std::vector<std::unique_ptr<PluginCSwapGroupClient>> clients;
+        for (uint32_t nodeId = 0; nodeId < nodeCount; ++nodeId)
+        {
+            const auto activationTime = start + std::chrono::milliseconds(parameters.activationMs) +
+                std::chrono::microseconds(SplitMix64(randomState) % (presentDurationMs * 1000 + 1));
+            clients.push_back(std::make_unique<PluginCSwapGroupClient>(std::make_unique<BarrierSyncApi>(barrier,
+                activationTime, std::chrono::milliseconds(presentDurationMs))));
+            auto& client = *clients.back();
+            client.SetupWorkStation();
+            client.Initialize(nullptr, nullptr);
+
+            BarrierWarmup::Config warmupConfig;
+            warmupConfig.isEmitter = nodeId == 0;
+            warmupConfig.nodeId = static_cast<uint8_t>(nodeId);
+            for (uint32_t repeaterId = 1; repeaterId < nodeCount; ++repeaterId)
+            {
+                warmupConfig.repeaters.set(repeaterId);
+            }
+            warmupConfig.blockDelay = std::chrono::milliseconds(parameters.blockDelayMs);
+            warmupConfig.timeout = std::chrono::milliseconds(parameters.timeoutMs);
+            client.GetBarrierWarmup().Start(warmupConfig, network.CreateEndpoint());
+        }
+
+        std::atomic<uint32_t> doneCount{0};
+        std::vector<uint64_t> repeatCounts(nodeCount);
+        std::vector<std::thread> threads;
+        for (uint32_t nodeId = 0; nodeId < nodeCount; ++nodeId)
+        {
+            threads.emplace_back([&, nodeId]
+            {
+                auto& client = *clients[nodeId];
+                CountingGraphicsDevice graphicsDevice;
+                bool done = false;
+                while (doneCount.load() < nodeCount)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(parameters.renderMs));
+                    client.Render(&graphicsDevice);
+                    if (!done && (graphicsDevice.IsConcluded() ||
+                        client.GetBarrierWarmup().GetState() != BarrierWarmupState::InProgress))
+                    {
+                        done = true;
+                        ++doneCount;
+                    }
+                }
+                repeatCounts[nodeId] = graphicsDevice.GetRepeatCount();
+                barrier.Leave();
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        RunResult result;
+        uint64_t totalRepeats = 0;
+        for (uint32_t nodeId = 0; nodeId < nodeCount; ++nodeId)
+        {
+            const auto& warmup = clients[nodeId]->GetBarrierWarmup();
+            result.succeeded &= warmup.GetState() == BarrierWarmupState::Succeeded;
+            result.durationMs = std::max(result.durationMs, warmup.GetDuration().count() / 1000.0);
+            totalRepeats += repeatCounts[nodeId];
+        }
+        result.repeatsPerNode = static_cast<double>(totalRepeats) / nodeCount;
+
+        for (auto& client : clients)
+        {
+            client->GetBarrierWarmup().Stop();
+        }
+        result.datagramsSent = network.GetSentCount();
+        result.datagramsDropped = network.GetDroppedCount();
+        return result;
+    }
+
+    template<typename T>
+    std::vector<T> ParseList(const char* value)
+    {
+        std::vector<T> values;
+        std::stringstream stream(value);
+        std::string item;
+        while (std::getline(stream, item, ','))
+        {
+            std::stringstream itemStream(item);
+            T parsed{};
+            itemStream >> parsed;
+            values.push_back(parsed);
+        }
+        return values;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Parameters parameters;
+    for (int argIndex = 1; argIndex + 1 < argc; argIndex += 2)
+    {
+        const char* name = argv[argIndex];
+        const char* value = argv[argIndex + 1];
+        if (strcmp(name, "--nodes") == 0)
+            parameters.nodeCounts = ParseList<uint32_t>(value);
+        else if (strcmp(name, "--present-ms") == 0)
+            parameters.presentDurationsMs = ParseList<uint32_t>(value);
+        else if (strcmp(name, "--loss") == 0)
+            parameters.lossProbabilities = ParseList<double>(value);
+        else if (strcmp(name, "--runs") == 0)
+            parameters.runs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--seed") == 0)
+            parameters.seed = strtoull(value, nullptr, 10);
+        else if (strcmp(name, "--render-ms") == 0)
+            parameters.renderMs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--block-delay-ms") == 0)
+            parameters.blockDelayMs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--timeout-ms") == 0)
+            parameters.timeoutMs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--latency-us") == 0)
+            parameters.latencyUs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--network-jitter-us") == 0)
+            parameters.networkJitterUs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--activation-ms") == 0)
+            parameters.activationMs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else
+        {
+            std::cerr << "Unknown argument: " << name << std::endl;
+            return 1;
+        }
+    }
+
+    for (const auto nodeCount : parameters.nodeCounts)
+    {
+        if (nodeCount < 2 || nodeCount > 256)
+        {
+            std::cerr << "Node count must be in [2, 256]: " << nodeCount << std::endl;
+            return 1;
+        }
+    }
+
+    for (const auto nodeCount : parameters.nodeCounts)
+    {
+        for (const auto presentDurationMs : parameters.presentDurationsMs)
+        {
+            for (const auto lossProbability : parameters.lossProbabilities)
+            {
+                uint32_t failures = 0;
+                double durationSumMs = 0;
+                double durationMaxMs = 0;
+                double durationMinMs = 0;
+                double repeatsSum = 0;
+                uint64_t sent = 0;
+                uint64_t dropped = 0;
+                for (uint32_t run = 0; run < parameters.runs; ++run)
+                {
+                    const auto result = RunWarmup(parameters, nodeCount, presentDurationMs, lossProbability,
+                        parameters.seed + run);
+                    failures += result.succeeded ? 0 : 1;
+                    durationSumMs += result.durationMs;
+                    durationMaxMs = std::max(durationMaxMs, result.durationMs);
+                    durationMinMs = run == 0 ? result.durationMs : std::min(durationMinMs, result.durationMs);
+                    repeatsSum += result.repeatsPerNode;
+                    sent += result.datagramsSent;
+                    dropped += result.datagramsDropped;
+                }
+
+                const auto runs = std::max(parameters.runs, 1u);
+                std::cout << "nodes=" << nodeCount
+                          << " present_ms=" << presentDurationMs
+                          << " loss=" << lossProbability
+                          << " runs=" << parameters.runs
+                          << " failures=" << failures
+                          << " failure_rate=" << static_cast<double>(failures) / runs
+                          << " warmup_mean_ms=" << durationSumMs / runs
+                          << " warmup_min_ms=" << durationMinMs
+                          << " warmup_max_ms=" << durationMaxMs
+                          << " repeats_per_node=" << repeatsSum / runs
+                          << " datagrams_sent=" << sent / runs
+                          << " datagrams_dropped=" << dropped / runs << std::endl;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,159 @@
+// Runs ClockSync between nodes of this process (node 0 being the emitter) whose clocks are artificially shifted
+// (node n is shifted by n * --offset-step-us) and whose repeaters delay every probe by --send-delay-us (an asymmetric
+// network delay, the worst case for the estimation).  Nodes communicate over UDP multicast (localhost) or, with
+// --simulated 1, over a SimulatedNetwork of --latency-us and --network-jitter-us.  Once --duration-ms elapsed every
+// repeater prints one line of space separated "key=value" comparing its estimated offset to the injected one.
+// Returns 1 if any error is larger than the uncertainty reported by ClockSync.
+//
+// Usage: ClockSyncBenchmark [--nodes N] [--duration-ms N] [--probe-interval-ms N] [--offset-step-us N]
+//                           [--send-delay-us N] [--simulated 0|1] [--latency-us N] [--network-jitter-us N]
+//                           [--multicast-address A] [--port N] [--adapter-address A]
+
+#include "ClockSync.h"
+#include "SimulatedNetwork.h"
+#include "UdpSocket.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace GfxQuadroSync;
+
+namespace
+{
+    struct Parameters
+    {
+        uint32_t nodeCount = 4;
+        uint32_t durationMs = 2000;
+        uint32_t probeIntervalMs = 20;
+        int64_t offsetStepUs = 12345;
+        uint32_t sendDelayUs = 0;
+        bool simulated = false;
+        uint32_t latencyUs = 200;
+        uint32_t networkJitterUs = 100;
+        std::string multicastAddress = "224.0.1.0";
+        uint16_t port = 25900;
+        std::string adapterAddress;
+    };
+
+    int Run(const Parameters& parameters)
+    {
+        SimulatedNetwork::Config networkConfig;
+        networkConfig.latency = std::chrono::microseconds(parameters.latencyUs);
+        networkConfig.jitter = std::chrono::microseconds(parameters.networkJitterUs);
+        SimulatedNetwork network(networkConfig);
+
+        std::vector<std::unique_ptr<ClockSync>> nodes;
+        for (uint32_t nodeId = 0; nodeId < parameters.nodeCount; ++nodeId)
+        {
+            std::unique_ptr<IDatagramTransport> transport;
+            if (parameters.simulated)
+            {
+                transport = network.CreateEndpoint();
+            }
+            else
+            {
+                auto socket = std::make_unique<UdpSocket>();
+                if (!socket->OpenMulticast(parameters.multicastAddress, parameters.port, parameters.adapterAddress))
+                {
+                    std::cerr << "Node " << nodeId << " failed to open its socket" << std::endl;
+                    return 1;
+                }
+                transport = std::move(socket);
+            }
+
+            ClockSync::Config config;
+            config.isEmitter = nodeId == 0;
+            config.nodeId = static_cast<uint8_t>(nodeId);
+            config.probeInterval = std::chrono::milliseconds(parameters.probeIntervalMs);
+            config.injectedOffset = std::chrono::microseconds(parameters.offsetStepUs * nodeId);
+            if (!config.isEmitter)
+            {
+                config.injectedSendDelay = std::chrono::microseconds(parameters.sendDelayUs);
+            }
+            nodes.push_back(std::make_unique<ClockSync>());
+            nodes.back()->Start(config, std::move(transport));
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(parameters.durationMs));
+
+        int failures = 0;
+        for (uint32_t nodeId = 1; nodeId < parameters.nodeCount; ++nodeId)
+        {
+            const auto estimate = nodes[nodeId]->GetEstimate();
+            const auto expectedOffsetNs = -parameters.offsetStepUs * 1000 * static_cast<int64_t>(nodeId);
+            const auto errorNs = estimate.offsetNs - expectedOffsetNs;
+            const bool withinUncertainty = estimate.valid && std::abs(errorNs) <= estimate.uncertaintyNs;
+            if (!withinUncertainty)
+            {
+                ++failures;
+            }
+            std::cout << "node=" << nodeId
+                      << " valid=" << estimate.valid
+                      << " samples=" << estimate.sampleCount
+                      << " probes=" << nodes[nodeId]->GetProbeCount()
+                      << " expected_offset_ns=" << expectedOffsetNs
+                      << " offset_ns=" << estimate.offsetNs
+                      << " error_ns=" << errorNs
+                      << " uncertainty_ns=" << estimate.uncertaintyNs
+                      << " round_trip_ns=" << estimate.roundTripNs
+                      << " within_uncertainty=" << withinUncertainty
+                      << std::endl;
+        }
+
+        for (auto& node : nodes)
+        {
+            node->Stop();
+        }
+        return failures == 0 ? 0 : 1;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Parameters parameters;
+    for (int argIndex = 1; argIndex + 1 < argc; argIndex += 2)
+    {
+        const char* name = argv[argIndex];
+        const char* value = argv[argIndex + 1];
+        if (strcmp(name, "--nodes") == 0)
+            parameters.nodeCount = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--duration-ms") == 0)
+            parameters.durationMs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--probe-interval-ms") == 0)
+            parameters.probeIntervalMs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--offset-step-us") == 0)
+            parameters.offsetStepUs = strtoll(value, nullptr, 10);
+        else if (strcmp(name, "--send-delay-us") == 0)
+            parameters.sendDelayUs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--simulated") == 0)
+            parameters.simulated = atoi(value) != 0;
+        else if (strcmp(name, "--latency-us") == 0)
+            parameters.latencyUs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--network-jitter-us") == 0)
+            parameters.networkJitterUs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--multicast-address") == 0)
+            parameters.multicastAddress = value;
+        else if (strcmp(name, "--port") == 0)
+            parameters.port = static_cast<uint16_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--adapter-address") == 0)
+            parameters.adapterAddress = value;
+        else
+        {
+            std::cerr << "Unknown argument: " << name << std::endl;
+            return 1;
+        }
+    }
+
+    if (parameters.nodeCount < 2 || parameters.nodeCount > 256)
+    {
+        std::cerr << "--nodes must be in [2, 256]" << std::endl;
+        return 1;
+    }
+    return Run(parameters);
+}
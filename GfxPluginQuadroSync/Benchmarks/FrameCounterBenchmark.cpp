@@ -0,0 +1,211 @@
+// Drives FrameCounter against the frame counter of SimulatedSyncApi (on its virtual clock) and checks how it queries
+// the hardware and extrapolates in between.  Output is one "key=value" per line to be easy to parse in CI, the exit
+// code is 1 if any of the checks failed.
+//
+// Usage: FrameCounterBenchmark [--seconds N] [--failing-seconds N] [--refresh-hz N] [--frame-jitter-us N] [--seed N]
+//
+// The hardware frame counter first fails for --failing-seconds (FrameCounter must back off instead of querying it on
+// every frame), then works for --seconds.  Checks:
+// - failing_queries: at most one query per NBR_SECONDS_BETWEEN_CAN_GET_FRAME_COUNT while the counter is failing.
+// - unthrottled_queries: NBR_CAN_GET_FRAME_COUNT_BEFORE_THROTTLE queries to measure the refresh period.
+// - max_query_interval_us: once throttled, the hardware is queried again (re-anchored) every
+//   NBR_SECONDS_BETWEEN_CAN_GET_FRAME_COUNT (plus at most one frame) and never more often.
+// - max_error_frames: extrapolated frame counts are at most one frame away from the hardware counter once the refresh
+//   period was measured over a re-anchor interval (first_interval_max_error_frames reports the error in the first
+//   interval, when the refresh period was only measured over the unthrottled queries).
+
+#include "FrameCounter.h"
+#include "SimulatedSyncApi.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+using namespace GfxQuadroSync;
+
+namespace
+{
+    /// FrameCounter receives nanoseconds of the virtual clock as performance counter ticks.
+    constexpr uint64_t k_TicksPerSecond = 1000000000;
+
+    struct Parameters
+    {
+        uint32_t seconds = 30;
+        uint32_t failingSeconds = 5;
+        uint32_t refreshHz = 60;
+        uint32_t frameJitterUs = 2000;
+        uint64_t seed = 1;
+    };
+
+    struct Results
+    {
+        uint64_t frames = 0;
+        uint64_t failingQueries = 0;
+        uint64_t unthrottledQueries = 0;
+        uint64_t throttledQueries = 0;
+        uint64_t minQueryIntervalNs = std::numeric_limits<uint64_t>::max();
+        uint64_t maxQueryIntervalNs = 0;
+        uint64_t firstIntervalMaxErrorFrames = 0;
+        uint64_t maxErrorFrames = 0;
+        uint64_t framesWithError = 0;
+    };
+
+    int Run(const Parameters& parameters)
+    {
+        SimulatedSyncApi::Config config;
+        config.nodeCount = 1;
+        config.seed = parameters.seed;
+        config.refreshPeriodNs = k_TicksPerSecond / parameters.refreshHz;
+        // Frames are rendered at the refresh rate, jittered so that queries are done anywhere in the refresh.
+        config.renderTimeNs = config.refreshPeriodNs;
+        config.renderTimeJitterNs = static_cast<uint64_t>(parameters.frameJitterUs) * 1000;
+        SimulatedSyncApi syncApi(config);
+
+        FrameCounter frameCounter(k_TicksPerSecond);
+        Results results;
+
+        // Hardware counter not working (yet).
+        syncApi.InjectFailure(SimulatedSyncApi::Operation::QueryFrameCount, SyncApiStatus::Error,
+            std::numeric_limits<uint32_t>::max());
+        const uint64_t failingEndNs = static_cast<uint64_t>(parameters.failingSeconds) * k_TicksPerSecond;
+        while (syncApi.GetNowNs() < failingEndNs)
+        {
+            syncApi.SimulateLocalRender();
+            const auto nowTick = syncApi.GetNowNs();
+            if (frameCounter.IsHardwareQueryDue(nowTick))
+            {
+                uint32_t count;
+                if (syncApi.QueryFrameCount(nullptr, count) == SyncApiStatus::Ok)
+                {
+                    frameCounter.OnHardwareFrameCount(nowTick, count);
+                }
+                else
+                {
+                    frameCounter.OnHardwareQueryFailed(nowTick);
+                }
+                ++results.failingQueries;
+            }
+            frameCounter.GetFrameCount(nowTick);
+            ++results.frames;
+        }
+
+        // Hardware counter now works.
+        syncApi.InjectFailure(SimulatedSyncApi::Operation::QueryFrameCount, SyncApiStatus::Ok, 0);
+        const uint64_t endNs = failingEndNs + static_cast<uint64_t>(parameters.seconds) * k_TicksPerSecond;
+        uint64_t lastThrottledQueryNs = 0;
+        bool anchored = false;
+        while (syncApi.GetNowNs() < endNs)
+        {
+            syncApi.SimulateLocalRender();
+            const auto nowTick = syncApi.GetNowNs();
+            uint32_t hardwareFrameCount = 0;
+            if (syncApi.QueryFrameCount(nullptr, hardwareFrameCount) != SyncApiStatus::Ok)
+            {
+                std::cerr << "Simulated QueryFrameCount failed" << std::endl;
+                return 1;
+            }
+
+            if (frameCounter.IsHardwareQueryDue(nowTick))
+            {
+                if (results.unthrottledQueries < FrameCounter::NBR_CAN_GET_FRAME_COUNT_BEFORE_THROTTLE)
+                {
+                    ++results.unthrottledQueries;
+                }
+                else
+                {
+                    if (lastThrottledQueryNs != 0)
+                    {
+                        const auto intervalNs = nowTick - lastThrottledQueryNs;
+                        results.minQueryIntervalNs = std::min(results.minQueryIntervalNs, intervalNs);
+                        results.maxQueryIntervalNs = std::max(results.maxQueryIntervalNs, intervalNs);
+                    }
+                    lastThrottledQueryNs = nowTick;
+                    ++results.throttledQueries;
+                }
+                frameCounter.OnHardwareFrameCount(nowTick, hardwareFrameCount);
+                anchored = true;
+            }
+
+            const auto frameCount = frameCounter.GetFrameCount(nowTick);
+            ++results.frames;
+            if (!anchored)
+            {
+                // Still backing off from the last failure, nothing to extrapolate from yet.
+                continue;
+            }
+            const auto errorFrames = static_cast<uint64_t>(std::abs(static_cast<int32_t>(frameCount -
+                hardwareFrameCount)));
+            auto& maxErrorFrames = results.throttledQueries == 0 ? results.firstIntervalMaxErrorFrames :
+                results.maxErrorFrames;
+            maxErrorFrames = std::max(maxErrorFrames, errorFrames);
+            if (errorFrames > 0)
+            {
+                ++results.framesWithError;
+            }
+        }
+
+        const uint64_t queryIntervalNs = FrameCounter::NBR_SECONDS_BETWEEN_CAN_GET_FRAME_COUNT * k_TicksPerSecond;
+        const uint64_t maxFrameNs = config.renderTimeNs + config.renderTimeJitterNs;
+        const bool failingQueriesOk = results.failingQueries <=
+            parameters.failingSeconds / FrameCounter::NBR_SECONDS_BETWEEN_CAN_GET_FRAME_COUNT + 1;
+        const bool unthrottledQueriesOk =
+            results.unthrottledQueries == FrameCounter::NBR_CAN_GET_FRAME_COUNT_BEFORE_THROTTLE;
+        const bool queryIntervalOk = results.throttledQueries > 1 && results.minQueryIntervalNs >= queryIntervalNs &&
+            results.maxQueryIntervalNs <= queryIntervalNs + maxFrameNs;
+        const bool errorOk = results.maxErrorFrames <= 1;
+
+        std::cout << "frames=" << results.frames << "\n"
+                  << "failing_queries=" << results.failingQueries << "\n"
+                  << "unthrottled_queries=" << results.unthrottledQueries << "\n"
+                  << "throttled_queries=" << results.throttledQueries << "\n"
+                  << "min_query_interval_us=" << (results.throttledQueries > 1 ? results.minQueryIntervalNs / 1000 : 0)
+                  << "\n"
+                  << "max_query_interval_us=" << results.maxQueryIntervalNs / 1000 << "\n"
+                  << "extrapolated=" << frameCounter.GetExtrapolatedCount() << "\n"
+                  << "frames_with_error=" << results.framesWithError << "\n"
+                  << "first_interval_max_error_frames=" << results.firstIntervalMaxErrorFrames << "\n"
+                  << "max_error_frames=" << results.maxErrorFrames << "\n"
+                  << "max_extrapolation_error=" << frameCounter.GetMaxExtrapolationError() << "\n"
+                  << "refresh_period_us=" << frameCounter.GetRefreshPeriodTicks() / 1000.0 << "\n"
+                  << "failing_queries_ok=" << failingQueriesOk << "\n"
+                  << "unthrottled_queries_ok=" << unthrottledQueriesOk << "\n"
+                  << "query_interval_ok=" << queryIntervalOk << "\n"
+                  << "error_ok=" << errorOk << std::endl;
+        return failingQueriesOk && unthrottledQueriesOk && queryIntervalOk && errorOk ? 0 : 1;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Parameters parameters;
+    for (int argIndex = 1; argIndex + 1 < argc; argIndex += 2)
+    {
+        const char* name = argv[argIndex];
+        const char* value = argv[argIndex + 1];
+        if (strcmp(name, "--seconds") == 0)
+            parameters.seconds = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--failing-seconds") == 0)
+            parameters.failingSeconds = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--refresh-hz") == 0)
+            parameters.refreshHz = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--frame-jitter-us") == 0)
+            parameters.frameJitterUs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--seed") == 0)
+            parameters.seed = strtoull(value, nullptr, 10);
+        else
+        {
+            std::cerr << "Unknown argument: " << name << std::endl;
+            return 1;
+        }
+    }
+
+    if (parameters.refreshHz == 0 || parameters.seconds == 0)
+    {
+        std::cerr << "--refresh-hz and --seconds must be greater than 0" << std::endl;
+        return 1;
+    }
+    return Run(parameters);
+}
@@ -0,0 +1,315 @@
+// Renders --frames frames to a GLX window and presents them through OpenGLGraphicsDevice and PluginCSwapGroupClient.
+// Presents are synchronized by GlxSwapGroupSyncApi when the display supports GLX_NV_swap_group (and --swap-group is
+// 1) and by a single node SoftwareSyncApi otherwise.  Every --repeat-interval frames a burst of --repeats present
+// repeats is done and the back buffer of every repeat is read back to check it still contains the repeated frame.
+// Prints one line of space separated "key=value" with present and repeat statistics.  Runs headless with Mesa
+// llvmpipe under a virtual X server, for example:
+//
+//   LIBGL_ALWAYS_SOFTWARE=1 xvfb-run -a GlxPresentBenchmark
+//
+// Usage: GlxPresentBenchmark [--frames N] [--width N] [--height N] [--repeat-interval N] [--repeats N]
+//                            [--swap-group 0|1] [--swap-interval N]
+
+#include "GlxSwapGroupSyncApi.h"
+#include "IGraphicsDevice.h"
+#include "OpenGLGraphicsDevice.h"
+#include "PresentStatistics.h"
+#include "QuadroSync.h"
+#include "SimulatedNetwork.h"
+#include "SoftwareSyncApi.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+// Remarks: Xlib defines Success (used by PluginCSwapGroupClient::InitializeStatus), keep its value before including it.
+namespace
+{
+    constexpr auto k_InitializeSuccess = GfxQuadroSync::PluginCSwapGroupClient::InitializeStatus::Success;
+}
+
+#include <GL/gl.h>
+#include <GL/glx.h>
+
+using namespace GfxQuadroSync;
+
+namespace
+{
+    struct Parameters
+    {
+        uint64_t frameCount = 1000;
+        uint32_t width = 1920;
+        uint32_t height = 1080;
+        uint32_t repeatInterval = 100;
+        uint32_t repeats = 4;
+        bool swapGroup = true;
+        int swapInterval = 0;
+    };
+
+    uint64_t GetPercentile(const PresentStatistics& statistics, double percentile)
+    {
+        if (statistics.GetCount() == 0)
+        {
+            return 0;
+        }
+        const auto& histogram = statistics.GetHistogram();
+        const auto target = static_cast<uint64_t>(statistics.GetCount() * percentile);
+        uint64_t accumulated = 0;
+        for (uint32_t bucketIndex = 0; bucketIndex < LatencyHistogram::k_BucketCount; ++bucketIndex)
+        {
+            accumulated += histogram.GetBucket(bucketIndex);
+            if (accumulated > target)
+            {
+                return LatencyHistogram::GetBucketLowerBound(bucketIndex);
+            }
+        }
+        return LatencyHistogram::GetBucketLowerBound(LatencyHistogram::k_BucketCount - 1);
+    }
+
+    std::string FormatStatistics(const char* name, const PresentStatistics& statistics)
+    {
+        const auto count = statistics.GetCount();
+        std::ostringstream os;
+        os << name << "_mean_us=" << (count > 0 ? statistics.GetSumUs() / count : 0)
+           << " " << name << "_p50_us=" << GetPercentile(statistics, 0.5)
+           << " " << name << "_p99_us=" << GetPercentile(statistics, 0.99)
+           << " " << name << "_max_us=" << statistics.GetMaxUs();
+        return os.str();
+    }
+
+    /// Window and context (what Unity would have created).
+    struct RenderWindow
+    {
+        Display* display = nullptr;
+        int screen = 0;
+        Colormap colormap = 0;
+        ::Window window = 0;
+        GLXWindow glxWindow = 0;
+        GLXContext context = nullptr;
+
+        ~RenderWindow()
+        {
+            if (display == nullptr)
+                return;
+            glXMakeContextCurrent(display, 0, 0, nullptr);
+            if (context != nullptr)
+                glXDestroyContext(display, context);
+            if (glxWindow != 0)
+                glXDestroyWindow(display, glxWindow);
+            if (window != 0)
+                XDestroyWindow(display, window);
+            if (colormap != 0)
+                XFreeColormap(display, colormap);
+            XCloseDisplay(display);
+        }
+    };
+
+    bool CreateRenderWindow(RenderWindow& window, const Parameters& parameters)
+    {
+        window.display = XOpenDisplay(nullptr);
+        if (window.display == nullptr)
+        {
+            std::cerr << "Cannot open the X display (run under a virtual X server like xvfb-run)" << std::endl;
+            return false;
+        }
+        window.screen = DefaultScreen(window.display);
+
+        // Remarks: Single sampled, repeats cannot blit to multisampled drawables.
+        const int attributes[] = {
+            GLX_X_RENDERABLE, True,
+            GLX_DRAWABLE_TYPE, GLX_WINDOW_BIT,
+            GLX_RENDER_TYPE, GLX_RGBA_BIT,
+            GLX_DOUBLEBUFFER, True,
+            GLX_RED_SIZE, 8,
+            GLX_GREEN_SIZE, 8,
+            GLX_BLUE_SIZE, 8,
+            GLX_SAMPLE_BUFFERS, 0,
+            None
+        };
+        int configCount = 0;
+        GLXFBConfig* const configs = glXChooseFBConfig(window.display, window.screen, attributes, &configCount);
+        if (configs == nullptr || configCount == 0)
+        {
+            std::cerr << "No double buffered RGB8 GLXFBConfig" << std::endl;
+            return false;
+        }
+        const auto config = configs[0];
+        XFree(configs);
+
+        XVisualInfo* const visual = glXGetVisualFromFBConfig(window.display, config);
+        if (visual == nullptr)
+        {
+            std::cerr << "No visual for the GLXFBConfig" << std::endl;
+            return false;
+        }
+        const auto root = RootWindow(window.display, window.screen);
+        window.colormap = XCreateColormap(window.display, root, visual->visual, AllocNone);
+        XSetWindowAttributes windowAttributes = {};
+        windowAttributes.colormap = window.colormap;
+        window.window = XCreateWindow(window.display, root, 0, 0, parameters.width, parameters.height, 0,
+            visual->depth, InputOutput, visual->visual, CWColormap, &windowAttributes);
+        XFree(visual);
+        XMapWindow(window.display, window.window);
+
+        window.glxWindow = glXCreateWindow(window.display, config, window.window, nullptr);
+        window.context = glXCreateNewContext(window.display, config, GLX_RGBA_TYPE, nullptr, True);
+        if (window.glxWindow == 0 || window.context == nullptr ||
+            !glXMakeContextCurrent(window.display, window.glxWindow, window.glxWindow, window.context))
+        {
+            std::cerr << "Failed to create the OpenGL context" << std::endl;
+            return false;
+        }
+
+        const auto swapInterval = reinterpret_cast<void (*)(Display*, GLXDrawable, int)>(
+            glXGetProcAddressARB(reinterpret_cast<const GLubyte*>("glXSwapIntervalEXT")));
+        if (swapInterval != nullptr)
+            swapInterval(window.display, window.glxWindow, parameters.swapInterval);
+        return true;
+    }
+
+    /// Color of frameIndex (so that a repeat of a different frame can be detected).
+    void GetFrameColor(const uint64_t frameIndex, GLubyte color[3])
+    {
+        color[0] = static_cast<GLubyte>(frameIndex * 37);
+        color[1] = static_cast<GLubyte>(frameIndex * 91 + 64);
+        color[2] = static_cast<GLubyte>(frameIndex * 13 + 128);
+    }
+
+    bool IsBackBufferColor(const GLubyte expected[3], const Parameters& parameters)
+    {
+        GLubyte pixel[4] = {};
+        glReadBuffer(GL_BACK);
+        glReadPixels(static_cast<GLint>(parameters.width / 2), static_cast<GLint>(parameters.height / 2), 1, 1,
+            GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+        return pixel[0] == expected[0] && pixel[1] == expected[1] && pixel[2] == expected[2];
+    }
+
+    int Run(const Parameters& parameters)
+    {
+        RenderWindow window;
+        if (!CreateRenderWindow(window, parameters))
+            return 1;
+
+        OpenGLGraphicsDevice graphicsDevice(window.display, window.glxWindow, window.screen);
+        SimulatedNetwork network(SimulatedNetwork::Config{});
+        std::unique_ptr<ISyncApi> syncApi;
+        if (parameters.swapGroup && GlxSwapGroupSyncApi::IsSupported(window.display, window.screen))
+        {
+            syncApi = std::make_unique<GlxSwapGroupSyncApi>(window.screen);
+        }
+        else
+        {
+            SoftwareSyncApi::Config syncConfig;
+            syncConfig.nodeId = 0;
+            syncConfig.nodes.set(0);
+            syncApi = std::make_unique<SoftwareSyncApi>(syncConfig, network.CreateEndpoint());
+        }
+        const std::string syncApiName = syncApi->GetName();
+        PluginCSwapGroupClient client(std::move(syncApi));
+        client.SetupWorkStation();
+        if (client.Initialize(graphicsDevice.GetDevice(), graphicsDevice.GetSwapChain()) != k_InitializeSuccess)
+        {
+            std::cerr << "Failed to initialize PluginCSwapGroupClient" << std::endl;
+            return 1;
+        }
+
+        PresentStatistics repeatStatistics;
+        uint64_t repeatedPresents = 0;
+        uint64_t repeatMismatches = 0;
+        const auto begin = std::chrono::steady_clock::now();
+        for (uint64_t frameIndex = 0; frameIndex < parameters.frameCount; ++frameIndex)
+        {
+            GLubyte color[3];
+            GetFrameColor(frameIndex, color);
+            glClearColor(color[0] / 255.0f, color[1] / 255.0f, color[2] / 255.0f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+
+            const bool repeat = parameters.repeatInterval > 0 && parameters.repeats > 0 &&
+                frameIndex % parameters.repeatInterval == parameters.repeatInterval - 1;
+            if (!repeat)
+            {
+                client.Render(&graphicsDevice);
+                continue;
+            }
+
+            // Same sequence as PluginCSwapGroupClient while warming up the barrier, the back buffer content is
+            // undefined after every swap so it is cleared to black before the repeat.
+            const auto repeatBegin = std::chrono::steady_clock::now();
+            graphicsDevice.InitiatePresentRepeats();
+            graphicsDevice.Present();
+            for (uint32_t repeatIndex = 0; repeatIndex < parameters.repeats; ++repeatIndex)
+            {
+                glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+                glClear(GL_COLOR_BUFFER_BIT);
+                graphicsDevice.PrepareSinglePresentRepeat();
+                if (!IsBackBufferColor(color, parameters))
+                    ++repeatMismatches;
+                graphicsDevice.Present();
+                ++repeatedPresents;
+            }
+            graphicsDevice.ConcludePresentRepeats();
+            repeatStatistics.Record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - repeatBegin).count()));
+        }
+        glFinish();
+        const auto elapsed = std::chrono::steady_clock::now() - begin;
+        client.Dispose(graphicsDevice.GetDevice(), graphicsDevice.GetSwapChain());
+
+        std::ostringstream os;
+        os << "sync_api=" << syncApiName
+           << " renderer=" << reinterpret_cast<const char*>(glGetString(GL_RENDERER))
+           << " width=" << parameters.width
+           << " height=" << parameters.height
+           << " frames=" << parameters.frameCount
+           << " elapsed_ms=" << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()
+           << " presents_failed=" << client.GetPresentFailureCount()
+           << " repeat_bursts=" << repeatStatistics.GetCount()
+           << " repeated_presents=" << repeatedPresents
+           << " repeat_mismatches=" << repeatMismatches
+           << " " << FormatStatistics("present", client.GetPresentStatistics())
+           << " " << FormatStatistics("repeat_burst", repeatStatistics)
+           << "\n";
+        std::cout << os.str() << std::flush;
+        return client.GetPresentFailureCount() == 0 && repeatMismatches == 0 ? 0 : 1;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Parameters parameters;
+    for (int argIndex = 1; argIndex + 1 < argc; argIndex += 2)
+    {
+        const char* name = argv[argIndex];
+        const char* value = argv[argIndex + 1];
+        if (strcmp(name, "--frames") == 0)
+            parameters.frameCount = strtoull(value, nullptr, 10);
+        else if (strcmp(name, "--width") == 0)
+            parameters.width = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--height") == 0)
+            parameters.height = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--repeat-interval") == 0)
+            parameters.repeatInterval = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--repeats") == 0)
+            parameters.repeats = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--swap-group") == 0)
+            parameters.swapGroup = atoi(value) != 0;
+        else if (strcmp(name, "--swap-interval") == 0)
+            parameters.swapInterval = atoi(value);
+        else
+        {
+            std::cerr << "Unknown argument: " << name << std::endl;
+            return 1;
+        }
+    }
+
+    if (parameters.width == 0 || parameters.height == 0)
+    {
+        std::cerr << "--width and --height must be greater than 0" << std::endl;
+        return 1;
+    }
+    return Run(parameters);
+}
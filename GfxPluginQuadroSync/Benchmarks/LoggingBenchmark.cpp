@@ -0,0 +1,136 @@
+// Measures what CLUSTER_LOG costs the threads logging when the managed callback is slow (like Debug.Log is), with the
+// messages delivered by the thread logging them and then by the background thread of Logger.  Every thread logs a burst
+// of messages (like a failing present logging an error every frame) and then waits for the next frame.  Prints one
+// line of space separated "key=value" per mode.
+//
+// Usage: LoggingBenchmark [--threads N] [--frames N] [--messages-per-frame N] [--frame-us N] [--callback-us N]
+
+#include "Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace GfxQuadroSync;
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+
+    std::chrono::microseconds s_CallbackDuration{20};
+
+    /// Managed callback spending s_CallbackDuration on every message.
+    void UNITY_INTERFACE_API SlowCallback(int, const char*)
+    {
+        const auto end = Clock::now() + s_CallbackDuration;
+        while (Clock::now() < end)
+        {
+        }
+    }
+
+    struct Parameters
+    {
+        uint32_t threadCount = 2;
+        uint32_t frameCount = 200;
+        uint32_t messagesPerFrame = 8;
+        uint32_t frameUs = 2000;
+        uint32_t callbackUs = 20;
+    };
+
+    struct ThreadResult
+    {
+        Clock::duration logDuration{0};
+        /// Longest time a frame spent logging its messages.
+        Clock::duration maxFrameLogDuration{0};
+    };
+
+    void Run(const Parameters& parameters, const bool asynchronous)
+    {
+        auto& logger = Logger::Instance();
+        logger.SetAsynchronous(asynchronous);
+        const auto droppedBefore = logger.GetDroppedCount();
+        const auto deliveredBefore = logger.GetDeliveredCount();
+
+        std::vector<ThreadResult> results(parameters.threadCount);
+        std::vector<std::thread> threads;
+        for (uint32_t threadIndex = 0; threadIndex < parameters.threadCount; ++threadIndex)
+        {
+            threads.emplace_back([&parameters, &result = results[threadIndex], threadIndex]
+            {
+                for (uint32_t frameIndex = 0; frameIndex < parameters.frameCount; ++frameIndex)
+                {
+                    const auto frameStart = Clock::now();
+                    for (uint32_t messageIndex = 0; messageIndex < parameters.messagesPerFrame; ++messageIndex)
+                    {
+                        CLUSTER_LOG_ERROR << "Present failed: thread " << threadIndex << ", frame " << frameIndex
+                                          << ", message " << messageIndex << ", status " << -1;
+                    }
+                    const auto frameLogDuration = Clock::now() - frameStart;
+                    result.logDuration += frameLogDuration;
+                    result.maxFrameLogDuration = std::max(result.maxFrameLogDuration, frameLogDuration);
+                    std::this_thread::sleep_until(frameStart + std::chrono::microseconds(parameters.frameUs));
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        logger.Flush();
+
+        Clock::duration logDuration{0};
+        Clock::duration maxFrameLogDuration{0};
+        for (const auto& result : results)
+        {
+            logDuration += result.logDuration;
+            maxFrameLogDuration = std::max(maxFrameLogDuration, result.maxFrameLogDuration);
+        }
+        const auto messageCount = static_cast<uint64_t>(parameters.threadCount) * parameters.frameCount *
+            parameters.messagesPerFrame;
+        const auto logNs = std::chrono::duration_cast<std::chrono::nanoseconds>(logDuration).count();
+        std::cout << "mode=" << (asynchronous ? "async" : "sync") << " threads=" << parameters.threadCount
+                  << " messages=" << messageCount << " callbackUs=" << parameters.callbackUs
+                  << " nsPerMessage=" << (messageCount > 0 ? logNs / static_cast<int64_t>(messageCount) : 0)
+                  << " maxFrameLogUs="
+                  << std::chrono::duration_cast<std::chrono::microseconds>(maxFrameLogDuration).count()
+                  << " delivered=" << logger.GetDeliveredCount() - deliveredBefore
+                  << " dropped=" << logger.GetDroppedCount() - droppedBefore << std::endl;
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    Parameters parameters;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const char* const name = argv[i];
+        const auto value = static_cast<uint32_t>(std::strtoul(argv[i + 1], nullptr, 10));
+        if (std::strcmp(name, "--threads") == 0)
+            parameters.threadCount = value;
+        else if (std::strcmp(name, "--frames") == 0)
+            parameters.frameCount = value;
+        else if (std::strcmp(name, "--messages-per-frame") == 0)
+            parameters.messagesPerFrame = value;
+        else if (std::strcmp(name, "--frame-us") == 0)
+            parameters.frameUs = value;
+        else if (std::strcmp(name, "--callback-us") == 0)
+            parameters.callbackUs = value;
+        else
+        {
+            std::cerr << "Unknown argument: " << name << std::endl;
+            return 1;
+        }
+    }
+
+    s_CallbackDuration = std::chrono::microseconds(parameters.callbackUs);
+    Logger::Instance().SetManagedCallback(&SlowCallback);
+    Run(parameters, false);
+    Run(parameters, true);
+    Logger::Instance().Shutdown();
+    return 0;
+}
@@ -0,0 +1,418 @@
+// Runs the whole plugin the way Unity does when running with the null renderer (batch mode): UnityPluginLoad, the
+// render events of GfxPluginQuadroSyncSystem and UnityRenderingExtQuery(kUnityRenderingExtQueryOverridePresentFrame)
+// for every frame, all presenting to a NullGraphicsDevice.  Needs no GPU nor display so that the cost of the plugin
+// loop can be measured (and regressions caught) in CI.  Prints one line of space separated "key=value".
+//
+// Usage: PluginLoopBenchmark [--frames N] [--refresh-us N] [--sync-interval N] [--back-buffers N]
+//                            [--max-frame-latency N] [--query-frame-count-every N] [--reset-every N]
+//                            [--async-present N] [--trace <file>] [--profiler 0|1]
+//
+// --async-present N presents from the present worker thread with up to N frames in flight (QuadroSyncWaitForPresent
+// is issued before every frame, where Unity would start rendering to the back buffer).
+//
+// --trace <file> records the events of the plugin in <file> (StartEventTrace), to be converted by EventTraceDecoder
+// (and to measure the cost of tracing by comparing nsPerFrame with and without it).
+//
+// --profiler 1 provides a fake IUnityProfilerV2 to the plugin and prints what was reported to it (markers begun and
+// ended, value of the counters at the end).
+
+#include <cstdint>
+
+#include "GfxQuadroSync.h"
+#include "StateBlock.h"
+#include "../Unity/IUnityProfiler.h"
+#include "../Unity/IUnityRenderingExtensions.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+
+using namespace GfxQuadroSync;
+
+/**
+ * Parameters of UseNullGraphicsDevice.
+ *
+ * \remark Must match QuadroSyncNullGraphicsDeviceParameters in GfxQuadroSync.cpp.
+ */
+struct QuadroSyncNullGraphicsDeviceParameters
+{
+    uint32_t backBufferCount;
+    uint32_t refreshPeriodUs;
+    uint32_t syncInterval;
+    uint32_t maxFrameLatency;
+};
+
+extern "C"
+{
+    bool UNITY_INTERFACE_API UseNullGraphicsDevice(const QuadroSyncNullGraphicsDeviceParameters* parameters);
+    UnityRenderingEventAndData UNITY_INTERFACE_API GetRenderEventFunc();
+    const void* UNITY_INTERFACE_API GetStateBlock();
+    bool UNITY_INTERFACE_API StartEventTrace(const char* path, uint32_t recordCount);
+    bool UNITY_INTERFACE_API UnityRenderingExtQuery(UnityRenderingExtQueryType query);
+}
+
+namespace
+{
+    /**
+     * Minimal implementation of the Unity interfaces used by the plugin (IUnityGraphics, and IUnityProfilerV2 when
+     * enabled).
+     */
+    class FakeUnity
+    {
+    public:
+        /// Maximum number of markers and of counters of the fake profiler.
+        static constexpr size_t k_MaxProfilerObjectCount = 16;
+
+        explicit FakeUnity(const bool withProfiler)
+            : m_WithProfiler(withProfiler)
+        {
+            m_Interfaces.GetInterface = &GetInterface;
+            m_Interfaces.RegisterInterface = &RegisterInterface;
+            m_Interfaces.GetInterfaceSplit = &GetInterfaceSplit;
+            m_Interfaces.RegisterInterfaceSplit = &RegisterInterfaceSplit;
+            m_Graphics.GetRenderer = &GetRenderer;
+            m_Graphics.RegisterDeviceEventCallback = &RegisterDeviceEventCallback;
+            m_Graphics.UnregisterDeviceEventCallback = &UnregisterDeviceEventCallback;
+            m_Graphics.ReserveEventIDRange = &ReserveEventIDRange;
+            m_Profiler.EmitEvent = &EmitEvent;
+            m_Profiler.IsEnabled = &IsProfilerEnabled;
+            m_Profiler.IsAvailable = &IsProfilerEnabled;
+            m_Profiler.CreateMarker = &CreateMarker;
+            m_Profiler.SetMarkerMetadataName = &SetMarkerMetadataName;
+            m_Profiler.CreateCategory = &CreateCategory;
+            m_Profiler.RegisterThread = &RegisterThread;
+            m_Profiler.UnregisterThread = &UnregisterThread;
+            m_Profiler.CreateCounterValue = &CreateCounterValue;
+            m_Profiler.FlushCounterValue = &FlushCounterValue;
+            s_Instance = this;
+        }
+
+        ~FakeUnity() { s_Instance = nullptr; }
+
+        FakeUnity(const FakeUnity&) = delete;
+        FakeUnity& operator=(const FakeUnity&) = delete;
+
+        IUnityInterfaces* GetInterfaces() { return &m_Interfaces; }
+
+        void RaiseDeviceEvent(const UnityGfxDeviceEventType eventType) const
+        {
+            if (m_DeviceEventCallback != nullptr)
+            {
+                m_DeviceEventCallback(eventType);
+            }
+        }
+
+        uint64_t GetBeginEventCount() const { return m_BeginEventCount.load(std::memory_order_relaxed); }
+        uint64_t GetEndEventCount() const { return m_EndEventCount.load(std::memory_order_relaxed); }
+        uint32_t GetMarkerCount() const { return m_MarkerCount; }
+        int GetRegisteredThreadCount() const { return m_RegisteredThreadCount.load(std::memory_order_relaxed); }
+
+        /// Value of a counter created by the plugin (0 if there is no counter with that name).
+        int64_t GetCounterValue(const char* const name) const
+        {
+            for (size_t counterIndex = 0; counterIndex < m_CounterCount; ++counterIndex)
+            {
+                if (std::strcmp(m_CounterNames[counterIndex], name) == 0)
+                {
+                    return m_CounterValues[counterIndex];
+                }
+            }
+            return 0;
+        }
+
+    private:
+        static IUnityInterface* UNITY_INTERFACE_API GetInterface(const UnityInterfaceGUID guid)
+        {
+            return GetInterfaceSplit(guid.m_GUIDHigh, guid.m_GUIDLow);
+        }
+
+        static void UNITY_INTERFACE_API RegisterInterface(UnityInterfaceGUID, IUnityInterface*) { }
+
+        static IUnityInterface* UNITY_INTERFACE_API GetInterfaceSplit(const unsigned long long guidHigh,
+            const unsigned long long guidLow)
+        {
+            if (UnityInterfaceGUID(guidHigh, guidLow) == GetUnityInterfaceGUID<IUnityGraphics>())
+            {
+                return &s_Instance->m_Graphics;
+            }
+            if (s_Instance->m_WithProfiler &&
+                UnityInterfaceGUID(guidHigh, guidLow) == GetUnityInterfaceGUID<IUnityProfilerV2>())
+            {
+                return &s_Instance->m_Profiler;
+            }
+            return nullptr;
+        }
+
+        static void UNITY_INTERFACE_API RegisterInterfaceSplit(unsigned long long, unsigned long long,
+            IUnityInterface*) { }
+
+        static UnityGfxRenderer UNITY_INTERFACE_API GetRenderer() { return kUnityGfxRendererNull; }
+
+        static void UNITY_INTERFACE_API RegisterDeviceEventCallback(const IUnityGraphicsDeviceEventCallback callback)
+        {
+            s_Instance->m_DeviceEventCallback = callback;
+        }
+
+        static void UNITY_INTERFACE_API UnregisterDeviceEventCallback(const IUnityGraphicsDeviceEventCallback callback)
+        {
+            if (s_Instance->m_DeviceEventCallback == callback)
+            {
+                s_Instance->m_DeviceEventCallback = nullptr;
+            }
+        }
+
+        static int UNITY_INTERFACE_API ReserveEventIDRange(int) { return 0; }
+
+        static void UNITY_INTERFACE_API EmitEvent(const UnityProfilerMarkerDesc*,
+            const UnityProfilerMarkerEventType eventType, uint16_t, const UnityProfilerMarkerData*)
+        {
+            auto& count = eventType == kUnityProfilerMarkerEventTypeBegin ? s_Instance->m_BeginEventCount :
+                s_Instance->m_EndEventCount;
+            count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static int UNITY_INTERFACE_API IsProfilerEnabled() { return 1; }
+
+        static int UNITY_INTERFACE_API CreateMarker(const UnityProfilerMarkerDesc** desc, const char* const name,
+            const UnityProfilerCategoryId category, const UnityProfilerMarkerFlags flags, int)
+        {
+            if (s_Instance->m_MarkerCount == k_MaxProfilerObjectCount)
+            {
+                return -1;
+            }
+            auto& marker = s_Instance->m_Markers[s_Instance->m_MarkerCount];
+            new (&marker) UnityProfilerMarkerDesc{nullptr, static_cast<UnityProfilerMarkerId>(
+                s_Instance->m_MarkerCount), flags, category, name, nullptr};
+            ++s_Instance->m_MarkerCount;
+            *desc = &marker;
+            return 0;
+        }
+
+        static int UNITY_INTERFACE_API SetMarkerMetadataName(const UnityProfilerMarkerDesc*, int, const char*,
+            UnityProfilerMarkerDataType, UnityProfilerMarkerDataUnit)
+        {
+            return 0;
+        }
+
+        static int UNITY_INTERFACE_API CreateCategory(UnityProfilerCategoryId* const category, const char*, uint32_t)
+        {
+            *category = 1000;
+            return 0;
+        }
+
+        static int UNITY_INTERFACE_API RegisterThread(UnityProfilerThreadId* const threadId, const char*, const char*)
+        {
+            *threadId = static_cast<UnityProfilerThreadId>(s_Instance->m_RegisteredThreadCount.fetch_add(1) + 1);
+            return 0;
+        }
+
+        static int UNITY_INTERFACE_API UnregisterThread(UnityProfilerThreadId)
+        {
+            s_Instance->m_RegisteredThreadCount.fetch_sub(1);
+            return 0;
+        }
+
+        static int UNITY_INTERFACE_API CreateCounterValue(void** const counter, const char* const name,
+            UnityProfilerCategoryId, UnityProfilerMarkerFlags, UnityProfilerMarkerDataType, UnityProfilerMarkerDataUnit,
+            const size_t valueSize, UnityProfilerCounterFlags, UnityProfilerCounterStatePtrCallback,
+            UnityProfilerCounterStatePtrCallback, void*)
+        {
+            if (s_Instance->m_CounterCount == k_MaxProfilerObjectCount || valueSize != sizeof(int64_t))
+            {
+                return -1;
+            }
+            s_Instance->m_CounterNames[s_Instance->m_CounterCount] = name;
+            *counter = &s_Instance->m_CounterValues[s_Instance->m_CounterCount++];
+            return 0;
+        }
+
+        static void UNITY_INTERFACE_API FlushCounterValue(void*) { }
+
+        static FakeUnity* s_Instance;
+        const bool m_WithProfiler;
+        IUnityInterfaces m_Interfaces = {};
+        IUnityGraphics m_Graphics = {};
+        IUnityGraphicsDeviceEventCallback m_DeviceEventCallback = nullptr;
+        IUnityProfilerV2 m_Profiler = {};
+        std::atomic<uint64_t> m_BeginEventCount = 0;
+        std::atomic<uint64_t> m_EndEventCount = 0;
+        std::atomic<int> m_RegisteredThreadCount = 0;
+        // Remarks: Raw storage since the fields of UnityProfilerMarkerDesc are const.
+        alignas(UnityProfilerMarkerDesc) unsigned char m_MarkerStorage[k_MaxProfilerObjectCount *
+            sizeof(UnityProfilerMarkerDesc)] = {};
+        UnityProfilerMarkerDesc* const m_Markers = reinterpret_cast<UnityProfilerMarkerDesc*>(m_MarkerStorage);
+        uint32_t m_MarkerCount = 0;
+        const char* m_CounterNames[k_MaxProfilerObjectCount] = {};
+        int64_t m_CounterValues[k_MaxProfilerObjectCount] = {};
+        size_t m_CounterCount = 0;
+    };
+
+    FakeUnity* FakeUnity::s_Instance = nullptr;
+
+    struct Parameters
+    {
+        uint64_t frameCount = 5000000;
+        uint32_t refreshUs = 0;
+        uint32_t syncInterval = 1;
+        uint32_t backBufferCount = 3;
+        uint32_t maxFrameLatency = 3;
+        uint64_t queryFrameCountEvery = 0;
+        uint64_t resetEvery = 0;
+        uint32_t asyncPresentFrames = 0;
+        const char* tracePath = nullptr;
+        bool profiler = false;
+    };
+
+    bool ParseArguments(const int argc, char** argv, Parameters& parameters)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* const argument = argv[i];
+            if (i + 1 >= argc)
+            {
+                std::cerr << "Missing value for " << argument << std::endl;
+                return false;
+            }
+            if (std::strcmp(argument, "--trace") == 0)
+            {
+                parameters.tracePath = argv[++i];
+                continue;
+            }
+            const auto value = std::strtoull(argv[++i], nullptr, 10);
+            if (std::strcmp(argument, "--frames") == 0)
+                parameters.frameCount = value;
+            else if (std::strcmp(argument, "--refresh-us") == 0)
+                parameters.refreshUs = static_cast<uint32_t>(value);
+            else if (std::strcmp(argument, "--sync-interval") == 0)
+                parameters.syncInterval = static_cast<uint32_t>(value);
+            else if (std::strcmp(argument, "--back-buffers") == 0)
+                parameters.backBufferCount = static_cast<uint32_t>(value);
+            else if (std::strcmp(argument, "--max-frame-latency") == 0)
+                parameters.maxFrameLatency = static_cast<uint32_t>(value);
+            else if (std::strcmp(argument, "--query-frame-count-every") == 0)
+                parameters.queryFrameCountEvery = value;
+            else if (std::strcmp(argument, "--reset-every") == 0)
+                parameters.resetEvery = value;
+            else if (std::strcmp(argument, "--async-present") == 0)
+                parameters.asyncPresentFrames = static_cast<uint32_t>(value);
+            else if (std::strcmp(argument, "--profiler") == 0)
+                parameters.profiler = value != 0;
+            else
+            {
+                std::cerr << "Unknown argument " << argument << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void IssueRenderEvent(const UnityRenderingEventAndData renderEvent, const EQuadroSyncRenderEvent eventId,
+        void* const data = nullptr)
+    {
+        renderEvent(static_cast<int>(eventId), data);
+    }
+
+    void* BoolData(const bool value)
+    {
+        return reinterpret_cast<void*>(static_cast<uintptr_t>(value ? 1 : 0));
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    Parameters parameters;
+    if (!ParseArguments(argc, argv, parameters))
+    {
+        return 1;
+    }
+
+    QuadroSyncNullGraphicsDeviceParameters deviceParameters;
+    deviceParameters.backBufferCount = parameters.backBufferCount;
+    deviceParameters.refreshPeriodUs = parameters.refreshUs;
+    deviceParameters.syncInterval = parameters.syncInterval;
+    deviceParameters.maxFrameLatency = parameters.maxFrameLatency;
+    if (!UseNullGraphicsDevice(&deviceParameters))
+    {
+        std::cerr << "UseNullGraphicsDevice failed" << std::endl;
+        return 1;
+    }
+
+    if (parameters.tracePath != nullptr && !StartEventTrace(parameters.tracePath, 0))
+    {
+        std::cerr << "StartEventTrace failed" << std::endl;
+        return 1;
+    }
+
+    FakeUnity unity(parameters.profiler);
+    UnityPluginLoad(unity.GetInterfaces());
+
+    // Same sequence as GfxPluginQuadroSyncSystem
+    const auto renderEvent = GetRenderEventFunc();
+    IssueRenderEvent(renderEvent, EQuadroSyncRenderEvent::QuadroSyncInitialize);
+    IssueRenderEvent(renderEvent, EQuadroSyncRenderEvent::QuadroSyncEnableSystem, BoolData(true));
+    IssueRenderEvent(renderEvent, EQuadroSyncRenderEvent::QuadroSyncEnableSwapGroup, BoolData(true));
+    IssueRenderEvent(renderEvent, EQuadroSyncRenderEvent::QuadroSyncEnableSwapBarrier, BoolData(true));
+    if (parameters.asyncPresentFrames > 0)
+    {
+        IssueRenderEvent(renderEvent, EQuadroSyncRenderEvent::QuadroSyncEnableAsyncPresent,
+            reinterpret_cast<void*>(static_cast<uintptr_t>(parameters.asyncPresentFrames)));
+    }
+
+    uint64_t presentedCount = 0;
+    int frameCount = 0;
+    const auto begin = std::chrono::steady_clock::now();
+    for (uint64_t frameIndex = 0; frameIndex < parameters.frameCount; ++frameIndex)
+    {
+        if (parameters.resetEvery > 0 && frameIndex % parameters.resetEvery == parameters.resetEvery - 1)
+        {
+            // Same as Unity resetting the device (for example when switching to fullscreen)
+            unity.RaiseDeviceEvent(kUnityGfxDeviceEventBeforeReset);
+            unity.RaiseDeviceEvent(kUnityGfxDeviceEventAfterReset);
+        }
+        if (parameters.queryFrameCountEvery > 0 && frameIndex % parameters.queryFrameCountEvery == 0)
+        {
+            IssueRenderEvent(renderEvent, EQuadroSyncRenderEvent::QuadroSyncQueryFrameCount, &frameCount);
+        }
+        if (parameters.asyncPresentFrames > 0)
+        {
+            IssueRenderEvent(renderEvent, EQuadroSyncRenderEvent::QuadroSyncWaitForPresent);
+        }
+        if (UnityRenderingExtQuery(kUnityRenderingExtQueryOverridePresentFrame))
+        {
+            ++presentedCount;
+        }
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - begin;
+
+    IssueRenderEvent(renderEvent, EQuadroSyncRenderEvent::QuadroSyncEnableSwapBarrier, BoolData(false));
+    IssueRenderEvent(renderEvent, EQuadroSyncRenderEvent::QuadroSyncEnableSwapGroup, BoolData(false));
+    IssueRenderEvent(renderEvent, EQuadroSyncRenderEvent::QuadroSyncEnableSystem, BoolData(false));
+    IssueRenderEvent(renderEvent, EQuadroSyncRenderEvent::QuadroSyncDispose);
+    unity.RaiseDeviceEvent(kUnityGfxDeviceEventShutdown);
+    UnityPluginUnload();
+
+    const auto elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    const auto frames = parameters.frameCount > 0 ? parameters.frameCount : 1;
+    std::cout << "frames=" << parameters.frameCount << " presented=" << presentedCount
+              << " refreshUs=" << parameters.refreshUs << " asyncPresent=" << parameters.asyncPresentFrames
+              << " frameCount=" << frameCount << " statePublishes="
+              << static_cast<const StateBlockHeader*>(GetStateBlock())->publishCount.load(std::memory_order_relaxed)
+              << " elapsedMs=" << elapsedNs / 1000000 << " nsPerFrame=" << elapsedNs / static_cast<int64_t>(frames)
+              << std::endl;
+    if (parameters.profiler)
+    {
+        std::cout << "profilerMarkers=" << unity.GetMarkerCount() << " markerBegins=" << unity.GetBeginEventCount()
+                  << " markerEnds=" << unity.GetEndEventCount()
+                  << " registeredThreads=" << unity.GetRegisteredThreadCount()
+                  << " presentDurationNs=" << unity.GetCounterValue("QuadroSync Present Duration")
+                  << " barrierWaitNs=" << unity.GetCounterValue("QuadroSync Barrier Wait")
+                  << " warmupRepeats=" << unity.GetCounterValue("QuadroSync Warmup Repeats")
+                  << " presentSuccesses=" << unity.GetCounterValue("QuadroSync Present Successes")
+                  << " presentFailures=" << unity.GetCounterValue("QuadroSync Present Failures") << std::endl;
+    }
+    return presentedCount == parameters.frameCount ? 0 : 1;
+}
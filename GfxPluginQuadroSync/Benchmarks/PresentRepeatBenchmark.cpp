@@ -0,0 +1,169 @@
+// Runs PresentRepeatScheduler against a mock GPU queue (executing every repeat in a fixed amount of real time) the way
+// D3D12GraphicsDevice does while the barrier is warming up: submit the repeat to the current back buffer, present
+// (simulated by sleeping) and move to the next back buffer.  Compares the pipelined scheduling with waiting on the GPU
+// after every repeat (how repeats used to be done) and checks that the commands of a back buffer are never executed
+// again while still executing.  Prints one line of space separated "key=value" per mode.
+//
+// Usage: PresentRepeatBenchmark [--repeats N] [--back-buffers N] [--gpu-us N] [--present-us N]
+
+#include "IPresentRepeatQueue.h"
+#include "PresentRepeatScheduler.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace GfxQuadroSync;
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+
+    /// IPresentRepeatQueue executing every repeat (in order) in gpuDuration once the GPU is done with the previous.
+    class MockPresentRepeatQueue final : public IPresentRepeatQueue
+    {
+    public:
+        MockPresentRepeatQueue(const uint32_t backBufferCount, const Clock::duration gpuDuration)
+            : m_GpuDuration(gpuDuration)
+            , m_BackBufferDoneTime(backBufferCount, Clock::time_point())
+        {
+        }
+
+        bool ExecuteRepeat(const uint32_t backBufferIndex, const uint64_t fenceValue) override
+        {
+            const auto now = Clock::now();
+            if (m_BackBufferDoneTime[backBufferIndex] > now)
+            {
+                ++m_HazardCount;
+            }
+            const auto startTime = m_GpuBusyUntil > now ? m_GpuBusyUntil : now;
+            m_GpuBusyUntil = startTime + m_GpuDuration;
+            m_BackBufferDoneTime[backBufferIndex] = m_GpuBusyUntil;
+            m_Pending.push_back({fenceValue, m_GpuBusyUntil});
+            return true;
+        }
+
+        uint64_t GetCompletedFenceValue() override
+        {
+            const auto now = Clock::now();
+            while (!m_Pending.empty() && m_Pending.front().doneTime <= now)
+            {
+                m_CompletedFenceValue = m_Pending.front().fenceValue;
+                m_Pending.pop_front();
+            }
+            return m_CompletedFenceValue;
+        }
+
+        void WaitForFenceValue(const uint64_t fenceValue) override
+        {
+            const auto waitStart = Clock::now();
+            for (const auto& pending : m_Pending)
+            {
+                if (pending.fenceValue >= fenceValue)
+                {
+                    std::this_thread::sleep_until(pending.doneTime);
+                    break;
+                }
+            }
+            GetCompletedFenceValue();
+            m_WaitDuration += Clock::now() - waitStart;
+        }
+
+        /// Number of repeats executed while the previous repeat to the same back buffer was still executing.
+        uint64_t GetHazardCount() const { return m_HazardCount; }
+        /// Time the CPU spent waiting on the GPU.
+        Clock::duration GetWaitDuration() const { return m_WaitDuration; }
+
+    private:
+        struct PendingRepeat
+        {
+            uint64_t fenceValue;
+            Clock::time_point doneTime;
+        };
+
+        const Clock::duration m_GpuDuration;
+        std::vector<Clock::time_point> m_BackBufferDoneTime;
+        std::deque<PendingRepeat> m_Pending;
+        Clock::time_point m_GpuBusyUntil;
+        uint64_t m_CompletedFenceValue = 0;
+        uint64_t m_HazardCount = 0;
+        Clock::duration m_WaitDuration{0};
+    };
+
+    struct Parameters
+    {
+        uint64_t repeatCount = 2000;
+        uint32_t backBufferCount = 3;
+        uint32_t gpuUs = 400;
+        uint32_t presentUs = 300;
+    };
+
+    void Run(const Parameters& parameters, const bool pipelined)
+    {
+        MockPresentRepeatQueue queue(parameters.backBufferCount, std::chrono::microseconds(parameters.gpuUs));
+        PresentRepeatScheduler scheduler;
+        scheduler.Reset(parameters.backBufferCount, 0);
+
+        const auto begin = Clock::now();
+        for (uint64_t repeatIndex = 0; repeatIndex < parameters.repeatCount; ++repeatIndex)
+        {
+            const auto backBufferIndex = static_cast<uint32_t>(repeatIndex % parameters.backBufferCount);
+            scheduler.SubmitRepeat(queue, backBufferIndex);
+            if (!pipelined)
+            {
+                scheduler.WaitForIdle(queue);
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(parameters.presentUs));
+        }
+        scheduler.WaitForIdle(queue);
+        const auto elapsed = Clock::now() - begin;
+
+        const auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+        const auto waitUs = std::chrono::duration_cast<std::chrono::microseconds>(queue.GetWaitDuration()).count();
+        const auto repeatCount = parameters.repeatCount > 0 ? parameters.repeatCount : 1;
+        std::cout << "mode=" << (pipelined ? "pipelined" : "serialized")
+                  << " repeats=" << parameters.repeatCount << " backBuffers=" << parameters.backBufferCount
+                  << " gpuUs=" << parameters.gpuUs << " presentUs=" << parameters.presentUs
+                  << " usPerRepeat=" << elapsedUs / static_cast<int64_t>(repeatCount)
+                  << " cpuWaitUsPerRepeat=" << waitUs / static_cast<int64_t>(repeatCount)
+                  << " stalls=" << scheduler.GetStallCount() << " maxInFlight=" << scheduler.GetMaxInFlightCount()
+                  << " hazards=" << queue.GetHazardCount() << std::endl;
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    Parameters parameters;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const char* const name = argv[i];
+        const auto value = std::strtoull(argv[i + 1], nullptr, 10);
+        if (std::strcmp(name, "--repeats") == 0)
+            parameters.repeatCount = value;
+        else if (std::strcmp(name, "--back-buffers") == 0)
+            parameters.backBufferCount = static_cast<uint32_t>(value);
+        else if (std::strcmp(name, "--gpu-us") == 0)
+            parameters.gpuUs = static_cast<uint32_t>(value);
+        else if (std::strcmp(name, "--present-us") == 0)
+            parameters.presentUs = static_cast<uint32_t>(value);
+        else
+        {
+            std::cerr << "Unknown argument: " << name << std::endl;
+            return 1;
+        }
+    }
+    if (parameters.backBufferCount == 0)
+    {
+        std::cerr << "--back-buffers must be at least 1" << std::endl;
+        return 1;
+    }
+
+    Run(parameters, false);
+    Run(parameters, true);
+    return 0;
+}
@@ -0,0 +1,267 @@
+// Runs a cluster whose nodes (one PluginCSwapGroupClient per node, each on its own thread) present at the time
+// assigned by the emitter through PresentScheduler, each node having its clock artificially shifted and synchronized
+// by ClockSync over a SimulatedNetwork.  Since every node really shares the steady clock, the true skew between the
+// presents of the same frame (same target) on the different nodes can be measured.  Prints one line of space
+// separated "key=value" per node (jitter against the target) and one for the cluster (true skew).
+//
+// Usage: ScheduledPresentBenchmark [--nodes N] [--frames N] [--refresh-us N] [--lead-periods N] [--render-ms N]
+//                                  [--render-jitter-ms N] [--offset-step-us N] [--latency-us N]
+//                                  [--network-jitter-us N] [--clock-sync-ms N]
+
+#include "IGraphicsDevice.h"
+#include "PresentStatistics.h"
+#include "QuadroSync.h"
+#include "SimulatedNetwork.h"
+#include "SimulatedSyncApi.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace GfxQuadroSync;
+
+namespace
+{
+    uint64_t NowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /// IGraphicsDevice without any display that notes the (true) time of every present.
+    class RecordingGraphicsDevice final : public IGraphicsDevice
+    {
+    public:
+        // Remarks: Type is not used by PluginCSwapGroupClient.
+        GraphicsDeviceType GetDeviceType() const override { return GraphicsDeviceType::GRAPHICS_DEVICE_D3D11; }
+
+        IUnknown* GetDevice() const override { return nullptr; }
+        IDXGISwapChain* GetSwapChain() const override { return nullptr; }
+        UINT32 GetSyncInterval() const override { return 1; }
+        UINT GetPresentFlags() const override { return 0; }
+
+        void SetDevice(IUnknown* const) override { }
+        void SetSwapChain(IDXGISwapChain* const) override { }
+
+        bool Present() override
+        {
+            m_LastPresentNs = NowNs();
+            return true;
+        }
+
+        void InitiatePresentRepeats() override { }
+        void PrepareSinglePresentRepeat() override { }
+        void ConcludePresentRepeats() override { }
+
+        uint64_t GetLastPresentNs() const { return m_LastPresentNs; }
+
+    private:
+        uint64_t m_LastPresentNs = 0;
+    };
+
+    struct Parameters
+    {
+        uint32_t nodeCount = 4;
+        uint64_t frameCount = 600;
+        uint32_t refreshUs = 16667;
+        uint32_t leadPeriods = 2;
+        uint32_t renderMs = 8;
+        uint32_t renderJitterMs = 4;
+        int64_t offsetStepUs = 12345;
+        uint32_t latencyUs = 200;
+        uint32_t networkJitterUs = 100;
+        uint32_t clockSyncMs = 500;
+    };
+
+    /// What a node presented: target of every frame and the true time at which it was presented.
+    typedef std::vector<std::pair<int64_t, uint64_t>> Presents;
+
+    uint64_t GetPercentile(std::vector<uint64_t> values, double percentile)
+    {
+        if (values.empty())
+        {
+            return 0;
+        }
+        const auto index = std::min(static_cast<size_t>(values.size() * percentile), values.size() - 1);
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+
+    std::string FormatStatistics(const char* name, const PresentStatistics& statistics)
+    {
+        const auto count = statistics.GetCount();
+        std::ostringstream os;
+        os << name << "_mean_us=" << (count > 0 ? statistics.GetSumUs() / count : 0)
+           << " " << name << "_max_us=" << statistics.GetMaxUs();
+        return os.str();
+    }
+
+    void RunNode(const Parameters& parameters, const uint32_t nodeId, PluginCSwapGroupClient& client,
+        Presents& presents)
+    {
+        RecordingGraphicsDevice graphicsDevice;
+        uint64_t randomState = 0x9e3779b97f4a7c15ull * (nodeId + 1);
+        for (uint64_t frameIndex = 0; frameIndex < parameters.frameCount; ++frameIndex)
+        {
+            randomState = randomState * 6364136223846793005ull + 1442695040888963407ull;
+            const auto jitterUs = parameters.renderJitterMs > 0 ?
+                (randomState >> 33) % (parameters.renderJitterMs * 1000 + 1) : 0;
+            std::this_thread::sleep_for(std::chrono::microseconds(parameters.renderMs * 1000 + jitterUs));
+            client.Render(&graphicsDevice);
+            presents.emplace_back(client.GetPresentScheduler().GetLastTargetNs(), graphicsDevice.GetLastPresentNs());
+        }
+    }
+
+    int Run(const Parameters& parameters)
+    {
+        SimulatedNetwork::Config networkConfig;
+        networkConfig.latency = std::chrono::microseconds(parameters.latencyUs);
+        networkConfig.jitter = std::chrono::microseconds(parameters.networkJitterUs);
+        SimulatedNetwork clockSyncNetwork(networkConfig);
+        SimulatedNetwork scheduleNetwork(networkConfig);
+
+        std::vector<std::unique_ptr<PluginCSwapGroupClient>> clients;
+        for (uint32_t nodeId = 0; nodeId < parameters.nodeCount; ++nodeId)
+        {
+            // Remarks: The ISyncApi is not used when presents are scheduled.
+            clients.push_back(std::make_unique<PluginCSwapGroupClient>(
+                std::make_unique<SimulatedSyncApi>(SimulatedSyncApi::Config())));
+            auto& client = *clients.back();
+
+            ClockSync::Config clockSyncConfig;
+            clockSyncConfig.isEmitter = nodeId == 0;
+            clockSyncConfig.nodeId = static_cast<uint8_t>(nodeId);
+            clockSyncConfig.probeInterval = std::chrono::milliseconds(20);
+            clockSyncConfig.injectedOffset = std::chrono::microseconds(parameters.offsetStepUs * nodeId);
+            client.GetClockSync().Start(clockSyncConfig, clockSyncNetwork.CreateEndpoint());
+
+            PresentScheduler::Config schedulerConfig;
+            schedulerConfig.isEmitter = nodeId == 0;
+            schedulerConfig.refreshPeriod = std::chrono::microseconds(parameters.refreshUs);
+            schedulerConfig.leadPeriods = parameters.leadPeriods;
+            schedulerConfig.scheduleTimeout = schedulerConfig.refreshPeriod * 2;
+            client.GetPresentScheduler().Start(schedulerConfig, client.GetClockSync(),
+                scheduleNetwork.CreateEndpoint());
+        }
+
+        // Let the clocks get synchronized before starting to present.
+        std::this_thread::sleep_for(std::chrono::milliseconds(parameters.clockSyncMs));
+
+        std::vector<Presents> presents(parameters.nodeCount);
+        std::vector<std::thread> threads;
+        for (uint32_t nodeId = 0; nodeId < parameters.nodeCount; ++nodeId)
+        {
+            threads.emplace_back([&parameters, nodeId, &clients, &presents]
+                { RunNode(parameters, nodeId, *clients[nodeId], presents[nodeId]); });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        for (uint32_t nodeId = 0; nodeId < parameters.nodeCount; ++nodeId)
+        {
+            const auto& client = *clients[nodeId];
+            const auto& presentScheduler = client.GetPresentScheduler();
+            const auto estimate = client.GetClockSync().GetEstimate();
+            std::cout << "node=" << nodeId
+                      << " frames=" << parameters.frameCount
+                      << " late=" << presentScheduler.GetLatePresentCount()
+                      << " missing_target=" << presentScheduler.GetMissingTargetCount()
+                      << " unsynchronized=" << presentScheduler.GetUnsynchronizedPresentCount()
+                      << " spin_margin_us=" << presentScheduler.GetSpinMarginNs() / 1000
+                      << " clock_uncertainty_us=" << estimate.uncertaintyNs / 1000
+                      << " " << FormatStatistics("jitter", presentScheduler.GetJitterStatistics())
+                      << std::endl;
+        }
+
+        // True skew between the presents of the same target on every node.
+        std::map<int64_t, std::pair<uint64_t, uint64_t>> presentTimesPerTarget;
+        std::map<int64_t, uint32_t> nodesPerTarget;
+        for (const auto& nodePresents : presents)
+        {
+            for (const auto& present : nodePresents)
+            {
+                auto inserted = presentTimesPerTarget.emplace(present.first,
+                    std::make_pair(present.second, present.second));
+                if (!inserted.second)
+                {
+                    inserted.first->second.first = std::min(inserted.first->second.first, present.second);
+                    inserted.first->second.second = std::max(inserted.first->second.second, present.second);
+                }
+                ++nodesPerTarget[present.first];
+            }
+        }
+        std::vector<uint64_t> skewsUs;
+        for (const auto& target : presentTimesPerTarget)
+        {
+            if (nodesPerTarget[target.first] == parameters.nodeCount)
+            {
+                skewsUs.push_back((target.second.second - target.second.first) / 1000);
+            }
+        }
+        std::cout << "cluster nodes=" << parameters.nodeCount
+                  << " common_targets=" << skewsUs.size()
+                  << " skew_p50_us=" << GetPercentile(skewsUs, 0.5)
+                  << " skew_p99_us=" << GetPercentile(skewsUs, 0.99)
+                  << " skew_max_us=" << GetPercentile(skewsUs, 1.0)
+                  << std::endl;
+
+        for (auto& client : clients)
+        {
+            client->GetPresentScheduler().Stop();
+            client->GetClockSync().Stop();
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Parameters parameters;
+    for (int argIndex = 1; argIndex + 1 < argc; argIndex += 2)
+    {
+        const char* name = argv[argIndex];
+        const char* value = argv[argIndex + 1];
+        if (strcmp(name, "--nodes") == 0)
+            parameters.nodeCount = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--frames") == 0)
+            parameters.frameCount = strtoull(value, nullptr, 10);
+        else if (strcmp(name, "--refresh-us") == 0)
+            parameters.refreshUs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--lead-periods") == 0)
+            parameters.leadPeriods = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--render-ms") == 0)
+            parameters.renderMs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--render-jitter-ms") == 0)
+            parameters.renderJitterMs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--offset-step-us") == 0)
+            parameters.offsetStepUs = strtoll(value, nullptr, 10);
+        else if (strcmp(name, "--latency-us") == 0)
+            parameters.latencyUs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--network-jitter-us") == 0)
+            parameters.networkJitterUs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--clock-sync-ms") == 0)
+            parameters.clockSyncMs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else
+        {
+            std::cerr << "Unknown argument: " << name << std::endl;
+            return 1;
+        }
+    }
+
+    if (parameters.nodeCount < 1 || parameters.nodeCount > 256)
+    {
+        std::cerr << "--nodes must be in [1, 256]" << std::endl;
+        return 1;
+    }
+    return Run(parameters);
+}
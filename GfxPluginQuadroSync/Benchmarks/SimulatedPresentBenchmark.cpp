@@ -0,0 +1,282 @@
+// Runs PluginCSwapGroupClient against SimulatedSyncApi and reports the cost of the present loop (in real time) and what
+// the simulated cluster experienced (in virtual time).  Output is one "key=value" per line to be easy to parse in CI.
+//
+// Usage: SimulatedPresentBenchmark [--nodes N] [--frames N] [--seed N] [--render-jitter-us N] [--barrier-jitter-us N]
+//                                  [--warmup-presents N] [--failure-probability P] [--replace-swap-chain-every N]
+//                                  [--release-replaced-swap-chain 0|1] [--rejoin 0|1] [--late-frame-every N]
+//                                  [--late-frame-us N] [--frame-hold 0|1] [--hold-deadline-us N]
+//                                  [--node-render-us N,N,...] [--node-render-jitter-us N,N,...]
+//
+// --replace-swap-chain-every simulates Unity recreating its swap chain (for example on fullscreen transitions), the
+// new swap chain is put back in the swap group by PluginCSwapGroupClient::RejoinSwapGroup unless --rejoin is 0.
+// --release-replaced-swap-chain 0 keeps the replaced swap chain alive (so the barrier stays bound to the group).
+// --late-frame-every makes one frame out of N take --late-frame-us more to render, with --frame-hold 1 the last frame
+// is presented again (PluginCSwapGroupClient::HoldFrame) every --hold-deadline-us the late frame is still not ready.
+// skipped_refreshes counts the refreshes during which the cluster presented nothing (all nodes waiting on this one).
+// --node-render-us and --node-render-jitter-us give the render time (and its jitter) of each node, starting with the
+// local node, nodes that are not listed use the defaults (8000 +/- --render-jitter-us).
+
+#include "BarrierWarmup.h"
+#include "IDatagramTransport.h"
+#include "IGraphicsDevice.h"
+#include "PresentStatistics.h"
+#include "QuadroSync.h"
+#include "SimulatedSyncApi.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace GfxQuadroSync;
+
+namespace
+{
+    /// IGraphicsDevice that has nothing to present (everything happens in SimulatedSyncApi).
+    class SimulatedGraphicsDevice final : public IGraphicsDevice
+    {
+    public:
+        // Remarks: Type is not used by PluginCSwapGroupClient.
+        GraphicsDeviceType GetDeviceType() const override { return GraphicsDeviceType::GRAPHICS_DEVICE_D3D11; }
+
+        IUnknown* GetDevice() const override { return nullptr; }
+        IDXGISwapChain* GetSwapChain() const override { return m_SwapChain; }
+        UINT32 GetSyncInterval() const override { return 1; }
+        UINT GetPresentFlags() const override { return 0; }
+
+        void SetDevice(IUnknown* const) override { }
+        void SetSwapChain(IDXGISwapChain* const swapChain) override { m_SwapChain = swapChain; }
+
+        bool Present() override { return true; }
+
+        void InitiatePresentRepeats() override { }
+        void PrepareSinglePresentRepeat() override { }
+        void ConcludePresentRepeats() override { }
+
+        void SaveFrameToHold() override { m_HeldFrameSaved = true; }
+        bool PrepareHeldFramePresent() override { return m_HeldFrameSaved; }
+        void ReleaseHeldFrame() override { m_HeldFrameSaved = false; }
+
+    private:
+        IDXGISwapChain* m_SwapChain = nullptr;
+        bool m_HeldFrameSaved = false;
+    };
+
+    /// IDatagramTransport for a BarrierWarmup without other nodes to communicate with.
+    class NullTransport final : public IDatagramTransport
+    {
+    public:
+        bool Send(const void*, size_t) override { return true; }
+        int Receive(void*, size_t, const std::chrono::microseconds timeout) override
+        {
+            std::this_thread::sleep_for(timeout);
+            return 0;
+        }
+    };
+
+    /// Parse a comma separated list of microseconds into nanoseconds.
+    std::vector<uint64_t> ParseMicrosecondsList(const char* value)
+    {
+        std::vector<uint64_t> ret;
+        const char* cursor = value;
+        while (*cursor != '\0')
+        {
+            char* end = nullptr;
+            const auto microseconds = strtoull(cursor, &end, 10);
+            if (end == cursor)
+            {
+                break;
+            }
+            ret.push_back(microseconds * 1000);
+            cursor = *end == ',' ? end + 1 : end;
+        }
+        return ret;
+    }
+
+    uint64_t GetPercentile(const LatencyHistogram& histogram, uint64_t count, double percentile)
+    {
+        const auto target = static_cast<uint64_t>(count * percentile);
+        uint64_t accumulated = 0;
+        for (uint32_t bucketIndex = 0; bucketIndex < LatencyHistogram::k_BucketCount; ++bucketIndex)
+        {
+            accumulated += histogram.GetBucket(bucketIndex);
+            if (accumulated > target)
+            {
+                return LatencyHistogram::GetBucketLowerBound(bucketIndex);
+            }
+        }
+        return LatencyHistogram::GetBucketLowerBound(LatencyHistogram::k_BucketCount - 1);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    SimulatedSyncApi::Config config;
+    uint64_t frameCount = 1000000;
+    uint64_t replaceSwapChainEvery = 0;
+    bool releaseReplacedSwapChain = true;
+    bool rejoin = true;
+    uint64_t lateFrameEvery = 0;
+    uint64_t lateFrameNs = 0;
+    bool frameHold = false;
+    uint64_t holdDeadlineNs = 8000000;
+    for (int argIndex = 1; argIndex + 1 < argc; argIndex += 2)
+    {
+        const char* name = argv[argIndex];
+        const char* value = argv[argIndex + 1];
+        if (strcmp(name, "--nodes") == 0)
+            config.nodeCount = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--frames") == 0)
+            frameCount = strtoull(value, nullptr, 10);
+        else if (strcmp(name, "--seed") == 0)
+            config.seed = strtoull(value, nullptr, 10);
+        else if (strcmp(name, "--render-jitter-us") == 0)
+            config.renderTimeJitterNs = strtoull(value, nullptr, 10) * 1000;
+        else if (strcmp(name, "--barrier-jitter-us") == 0)
+            config.barrierJitterNs = strtoull(value, nullptr, 10) * 1000;
+        else if (strcmp(name, "--warmup-presents") == 0)
+            config.barrierWarmupPresents = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--failure-probability") == 0)
+            config.presentFailureProbability = strtod(value, nullptr);
+        else if (strcmp(name, "--replace-swap-chain-every") == 0)
+            replaceSwapChainEvery = strtoull(value, nullptr, 10);
+        else if (strcmp(name, "--release-replaced-swap-chain") == 0)
+            releaseReplacedSwapChain = strtoul(value, nullptr, 10) != 0;
+        else if (strcmp(name, "--rejoin") == 0)
+            rejoin = strtoul(value, nullptr, 10) != 0;
+        else if (strcmp(name, "--late-frame-every") == 0)
+            lateFrameEvery = strtoull(value, nullptr, 10);
+        else if (strcmp(name, "--late-frame-us") == 0)
+            lateFrameNs = strtoull(value, nullptr, 10) * 1000;
+        else if (strcmp(name, "--frame-hold") == 0)
+            frameHold = strtoul(value, nullptr, 10) != 0;
+        else if (strcmp(name, "--hold-deadline-us") == 0)
+            holdDeadlineNs = strtoull(value, nullptr, 10) * 1000;
+        else if (strcmp(name, "--node-render-us") == 0)
+            config.nodeRenderTimeNs = ParseMicrosecondsList(value);
+        else if (strcmp(name, "--node-render-jitter-us") == 0)
+            config.nodeRenderTimeJitterNs = ParseMicrosecondsList(value);
+        else
+        {
+            std::cerr << "Unknown argument: " << name << std::endl;
+            return 1;
+        }
+    }
+
+    if (holdDeadlineNs == 0)
+    {
+        std::cerr << "--hold-deadline-us must be at least 1" << std::endl;
+        return 1;
+    }
+
+    auto syncApiOwner = std::make_unique<SimulatedSyncApi>(config);
+    auto& syncApi = *syncApiOwner;
+    syncApi.InstallAsPerformanceCounterSource();
+
+    // Swap chains are only compared by SimulatedSyncApi, so any distinct non null value will do.
+    uintptr_t swapChainIndex = 1;
+    SimulatedGraphicsDevice graphicsDevice;
+    graphicsDevice.SetSwapChain(reinterpret_cast<IDXGISwapChain*>(swapChainIndex));
+    PluginCSwapGroupClient client(std::move(syncApiOwner));
+    // Other nodes are simulated by SimulatedSyncApi, so the emitter has no repeater to warm up the barrier with.
+    BarrierWarmup::Config warmupConfig;
+    warmupConfig.isEmitter = true;
+    client.GetBarrierWarmup().Start(warmupConfig, std::make_unique<NullTransport>());
+    client.SetupWorkStation();
+    if (client.Initialize(nullptr, graphicsDevice.GetSwapChain()) != PluginCSwapGroupClient::InitializeStatus::Success)
+    {
+        std::cerr << "Failed to initialize PluginCSwapGroupClient" << std::endl;
+        return 1;
+    }
+    client.EnableFrameHold(&graphicsDevice, frameHold);
+
+    // Every present returns once released by the barrier (so on the refresh it is displayed).
+    uint64_t lastPresentRefresh = 0;
+    uint64_t skippedRefreshCount = 0;
+    const auto onPresented = [&]()
+    {
+        const auto refresh = syncApi.GetNowNs() / config.refreshPeriodNs;
+        if (refresh > lastPresentRefresh + 1)
+        {
+            skippedRefreshCount += refresh - lastPresentRefresh - 1;
+        }
+        lastPresentRefresh = refresh;
+    };
+
+    const auto begin = std::chrono::steady_clock::now();
+    for (uint64_t frameIndex = 0; frameIndex < frameCount; ++frameIndex)
+    {
+        if (replaceSwapChainEvery > 0 && frameIndex % replaceSwapChainEvery == replaceSwapChainEvery - 1)
+        {
+            const auto replacedSwapChain = graphicsDevice.GetSwapChain();
+            graphicsDevice.SetSwapChain(reinterpret_cast<IDXGISwapChain*>(++swapChainIndex));
+            if (releaseReplacedSwapChain)
+            {
+                syncApi.ReleaseSwapChain(replacedSwapChain);
+            }
+            if (rejoin && client.RejoinSwapGroup(nullptr, graphicsDevice.GetSwapChain()) !=
+                PluginCSwapGroupClient::InitializeStatus::Success)
+            {
+                std::cerr << "Failed to join the swap group again" << std::endl;
+                return 1;
+            }
+        }
+        syncApi.SimulateLocalRender();
+        if (lateFrameEvery > 0 && frameIndex % lateFrameEvery == lateFrameEvery - 1)
+        {
+            const auto readyNs = syncApi.GetNowNs() + lateFrameNs;
+            while (frameHold && readyNs > syncApi.GetNowNs() + holdDeadlineNs)
+            {
+                syncApi.AdvanceTime(holdDeadlineNs);
+                if (client.HoldFrame(&graphicsDevice))
+                {
+                    onPresented();
+                }
+            }
+            if (readyNs > syncApi.GetNowNs())
+            {
+                syncApi.AdvanceTime(readyNs - syncApi.GetNowNs());
+            }
+        }
+        client.QueryFrameCount(nullptr);
+        client.Render(&graphicsDevice);
+        onPresented();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const auto elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+
+    const auto& statistics = client.GetPresentStatistics();
+    const auto presentCount = statistics.GetCount();
+    std::cout << "nodes=" << config.nodeCount << "\n"
+              << "frames=" << frameCount << "\n"
+              << "seed=" << config.seed << "\n"
+              << "wall_ns_per_frame=" << (frameCount > 0 ? elapsedNs / frameCount : 0) << "\n"
+              << "presents_succeeded=" << client.GetPresentSuccessCount() << "\n"
+              << "presents_failed=" << client.GetPresentFailureCount() << "\n"
+              << "present_mean_us=" << (presentCount > 0 ? statistics.GetSumUs() / presentCount : 0) << "\n"
+              << "present_p50_us=" << GetPercentile(statistics.GetHistogram(), presentCount, 0.5) << "\n"
+              << "present_p99_us=" << GetPercentile(statistics.GetHistogram(), presentCount, 0.99) << "\n"
+              << "present_max_us=" << statistics.GetMaxUs() << "\n"
+              << "barrier_wait_mean_us=" <<
+                 (syncApi.GetPresentCount() > 0 ? syncApi.GetTotalBarrierWaitNs() / syncApi.GetPresentCount() / 1000 : 0)
+              << "\n"
+              << "missed_vblanks=" << syncApi.GetMissedVblankCount() << "\n"
+              << "unsynchronized_presents=" << syncApi.GetUnsynchronizedPresentCount() << "\n"
+              << "swap_group_rejoins=" << client.GetSwapGroupRejoinCount() << "\n"
+              << "swap_group_rejoin_warmups=" << client.GetSwapGroupRejoinWarmupCount() << "\n"
+              << "last_swap_group_rejoin_us=" << client.GetLastSwapGroupRejoinDurationUs() << "\n"
+              << "held_frames=" << client.GetHeldFrameCount() << "\n"
+              << "frame_hold_failures=" << client.GetFrameHoldFailureCount() << "\n"
+              << "skipped_refreshes=" << skippedRefreshCount << "\n"
+              << "frame_count=" << client.QueryFrameCount(nullptr) << "\n"
+              << "virtual_time_ms=" << syncApi.GetNowNs() / 1000000 << std::endl;
+
+    client.Dispose(nullptr, graphicsDevice.GetSwapChain());
+    client.DisposeWorkStation();
+    return 0;
+}
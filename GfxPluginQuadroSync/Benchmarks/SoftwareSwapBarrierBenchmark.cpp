@@ -0,0 +1,295 @@
+// Runs a cluster of nodes synchronized by SoftwareSyncApi over UDP multicast, every node being a different process on
+// this computer (so the real network stack is used).  Without --node-id the executable launches --nodes copies of
+// itself (one per node) and waits for them.  Every node warms up the barrier (node 0 being the emitter), renders
+// --frames frames and prints one line of space separated "key=value" with its present, barrier wait and release skew
+// statistics (skew is meaningful since all the processes share the same clock).  With --instances-per-host every
+// node is made of that many instances synchronized by a HostBarrier (only instance 0 of every node communicates with
+// the other nodes), the other instances also print the latency between the release by instance 0 and their wake up.
+//
+// Usage: SoftwareSwapBarrierBenchmark [--nodes N] [--frames N] [--render-ms N] [--render-jitter-ms N]
+//                                     [--multicast-address A] [--port N] [--adapter-address A] [--warmup 0|1]
+//                                     [--instances-per-host N] [--node-id N] [--instance-index N]
+
+#include "BarrierWarmup.h"
+#include "IGraphicsDevice.h"
+#include "PresentStatistics.h"
+#include "QuadroSync.h"
+#include "SoftwareSyncApi.h"
+#include "UdpSocket.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace GfxQuadroSync;
+
+namespace
+{
+    /// IGraphicsDevice without any display (presents are instantaneous).
+    class NullGraphicsDevice final : public IGraphicsDevice
+    {
+    public:
+        // Remarks: Type is not used by PluginCSwapGroupClient.
+        GraphicsDeviceType GetDeviceType() const override { return GraphicsDeviceType::GRAPHICS_DEVICE_D3D11; }
+
+        IUnknown* GetDevice() const override { return nullptr; }
+        IDXGISwapChain* GetSwapChain() const override { return nullptr; }
+        UINT32 GetSyncInterval() const override { return 1; }
+        UINT GetPresentFlags() const override { return 0; }
+
+        void SetDevice(IUnknown* const) override { }
+        void SetSwapChain(IDXGISwapChain* const) override { }
+
+        bool Present() override { return true; }
+
+        void InitiatePresentRepeats() override { }
+        void PrepareSinglePresentRepeat() override { }
+        void ConcludePresentRepeats() override { }
+    };
+
+    struct Parameters
+    {
+        uint32_t nodeCount = 4;
+        uint64_t frameCount = 1000;
+        uint32_t renderMs = 8;
+        uint32_t renderJitterMs = 4;
+        std::string multicastAddress = "224.0.1.0";
+        uint16_t port = 25700;
+        std::string adapterAddress;
+        bool warmup = true;
+        uint32_t instancesPerHost = 1;
+        int nodeId = -1;
+        uint32_t instanceIndex = 0;
+    };
+
+    uint64_t GetPercentile(const PresentStatistics& statistics, double percentile)
+    {
+        if (statistics.GetCount() == 0)
+        {
+            return 0;
+        }
+        const auto& histogram = statistics.GetHistogram();
+        const auto target = static_cast<uint64_t>(statistics.GetCount() * percentile);
+        uint64_t accumulated = 0;
+        for (uint32_t bucketIndex = 0; bucketIndex < LatencyHistogram::k_BucketCount; ++bucketIndex)
+        {
+            accumulated += histogram.GetBucket(bucketIndex);
+            if (accumulated > target)
+            {
+                return LatencyHistogram::GetBucketLowerBound(bucketIndex);
+            }
+        }
+        return LatencyHistogram::GetBucketLowerBound(LatencyHistogram::k_BucketCount - 1);
+    }
+
+    std::string FormatStatistics(const char* name, const PresentStatistics& statistics)
+    {
+        const auto count = statistics.GetCount();
+        std::ostringstream os;
+        os << name << "_mean_us=" << (count > 0 ? statistics.GetSumUs() / count : 0)
+           << " " << name << "_p50_us=" << GetPercentile(statistics, 0.5)
+           << " " << name << "_p99_us=" << GetPercentile(statistics, 0.99)
+           << " " << name << "_max_us=" << statistics.GetMaxUs();
+        return os.str();
+    }
+
+    int RunNode(const Parameters& parameters)
+    {
+        const auto nodeId = static_cast<uint8_t>(parameters.nodeId);
+        SoftwareSyncApi::Config syncConfig;
+        syncConfig.nodeId = nodeId;
+        for (uint32_t otherNodeId = 0; otherNodeId < parameters.nodeCount; ++otherNodeId)
+        {
+            syncConfig.nodes.set(otherNodeId);
+        }
+        const bool isRepresentative = parameters.instanceIndex == 0;
+        if (parameters.instancesPerHost > 1)
+        {
+            syncConfig.hostBarrierName = "GfxQuadroSyncBenchmark_" + std::to_string(parameters.port) + "_" +
+                std::to_string(parameters.nodeId);
+            syncConfig.hostInstanceCount = parameters.instancesPerHost;
+            syncConfig.hostInstanceIndex = parameters.instanceIndex;
+        }
+
+        // Remarks: Only the representative of the node communicates with the other nodes.
+        std::unique_ptr<UdpSocket> barrierSocket;
+        std::unique_ptr<UdpSocket> warmupSocket;
+        if (isRepresentative)
+        {
+            barrierSocket = std::make_unique<UdpSocket>();
+            warmupSocket = std::make_unique<UdpSocket>();
+            if (!barrierSocket->OpenMulticast(parameters.multicastAddress, parameters.port,
+                    parameters.adapterAddress) ||
+                !warmupSocket->OpenMulticast(parameters.multicastAddress, parameters.port + 1,
+                    parameters.adapterAddress))
+            {
+                std::cerr << "Node " << parameters.nodeId << " failed to open its sockets" << std::endl;
+                return 1;
+            }
+        }
+
+        auto syncApiOwner = std::make_unique<SoftwareSyncApi>(syncConfig, std::move(barrierSocket));
+        auto& syncApi = *syncApiOwner;
+        PluginCSwapGroupClient client(std::move(syncApiOwner));
+        if (parameters.warmup && isRepresentative)
+        {
+            BarrierWarmup::Config warmupConfig;
+            warmupConfig.nodeId = nodeId;
+            warmupConfig.isEmitter = nodeId == 0;
+            if (warmupConfig.isEmitter)
+            {
+                warmupConfig.repeaters = syncConfig.nodes;
+                warmupConfig.repeaters.reset(nodeId);
+            }
+            client.GetBarrierWarmup().Start(warmupConfig, std::move(warmupSocket));
+        }
+        client.SetupWorkStation();
+        if (client.Initialize(nullptr, nullptr) != PluginCSwapGroupClient::InitializeStatus::Success)
+        {
+            std::cerr << "Node " << parameters.nodeId << " failed to initialize PluginCSwapGroupClient" << std::endl;
+            return 1;
+        }
+
+        // Every node renders with its own (reproducible) jitter so that the barrier has something to synchronize.
+        uint64_t randomState = 0x9e3779b97f4a7c15ull * (nodeId * parameters.instancesPerHost +
+            parameters.instanceIndex + 1);
+        NullGraphicsDevice graphicsDevice;
+        const auto begin = std::chrono::steady_clock::now();
+        for (uint64_t frameIndex = 0; frameIndex < parameters.frameCount; ++frameIndex)
+        {
+            randomState = randomState * 6364136223846793005ull + 1442695040888963407ull;
+            const auto jitterUs = parameters.renderJitterMs > 0 ?
+                (randomState >> 33) % (parameters.renderJitterMs * 1000 + 1) : 0;
+            std::this_thread::sleep_for(std::chrono::microseconds(parameters.renderMs * 1000 + jitterUs));
+            client.QueryFrameCount(nullptr);
+            client.Render(&graphicsDevice);
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - begin;
+        client.GetBarrierWarmup().Stop();
+
+        // Remarks: Output of every node is written with a single write so that lines of different processes do not
+        // get mixed.
+        uint32_t frameCount = 0;
+        syncApi.QueryFrameCount(nullptr, frameCount);
+        std::ostringstream os;
+        os << "node=" << parameters.nodeId
+           << " instance=" << parameters.instanceIndex
+           << " nodes=" << parameters.nodeCount
+           << " frames=" << parameters.frameCount
+           << " barrier_frame_count=" << frameCount
+           << " warmup_state=" << static_cast<uint32_t>(client.GetBarrierWarmup().GetState())
+           << " warmup_ms=" << client.GetBarrierWarmup().GetDuration().count() / 1000
+           << " elapsed_ms=" << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()
+           << " presents_failed=" << client.GetPresentFailureCount()
+           << " barrier_timeouts=" << syncApi.GetTimeoutCount()
+           << " " << FormatStatistics("present", client.GetPresentStatistics())
+           << " " << FormatStatistics("barrier_wait", syncApi.GetBarrierWaitStatistics())
+           << " skew_samples=" << syncApi.GetReleaseSkewStatistics().GetCount()
+           << " " << FormatStatistics("skew", syncApi.GetReleaseSkewStatistics())
+           << " " << FormatStatistics("host_release_latency", syncApi.GetHostReleaseLatencyStatistics())
+           << "\n";
+        std::cout << os.str() << std::flush;
+        return client.GetPresentFailureCount() == 0 ? 0 : 1;
+    }
+
+    int LaunchNodes(const std::string& executable, const Parameters& parameters, const std::string& arguments)
+    {
+        const auto processCount = parameters.nodeCount * parameters.instancesPerHost;
+        std::vector<std::thread> launchers;
+        std::vector<int> results(processCount, 0);
+        for (uint32_t processIndex = 0; processIndex < processCount; ++processIndex)
+        {
+            const auto command = "\"" + executable + "\"" + arguments +
+                " --node-id " + std::to_string(processIndex / parameters.instancesPerHost) +
+                " --instance-index " + std::to_string(processIndex % parameters.instancesPerHost);
+            launchers.emplace_back([command, &results, processIndex]
+                { results[processIndex] = std::system(command.c_str()); });
+        }
+
+        int failedProcesses = 0;
+        for (uint32_t processIndex = 0; processIndex < processCount; ++processIndex)
+        {
+            launchers[processIndex].join();
+            if (results[processIndex] != 0)
+            {
+                std::cerr << "Node " << processIndex / parameters.instancesPerHost << " instance "
+                          << processIndex % parameters.instancesPerHost << " failed (" << results[processIndex] << ")"
+                          << std::endl;
+                ++failedProcesses;
+            }
+        }
+        return failedProcesses == 0 ? 0 : 1;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Parameters parameters;
+    std::string nodeArguments;
+    for (int argIndex = 1; argIndex + 1 < argc; argIndex += 2)
+    {
+        const char* name = argv[argIndex];
+        const char* value = argv[argIndex + 1];
+        if (strcmp(name, "--node-id") == 0)
+        {
+            parameters.nodeId = atoi(value);
+            continue;
+        }
+        if (strcmp(name, "--instance-index") == 0)
+        {
+            parameters.instanceIndex = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+            continue;
+        }
+
+        if (strcmp(name, "--nodes") == 0)
+            parameters.nodeCount = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--frames") == 0)
+            parameters.frameCount = strtoull(value, nullptr, 10);
+        else if (strcmp(name, "--render-ms") == 0)
+            parameters.renderMs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--render-jitter-ms") == 0)
+            parameters.renderJitterMs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--multicast-address") == 0)
+            parameters.multicastAddress = value;
+        else if (strcmp(name, "--port") == 0)
+            parameters.port = static_cast<uint16_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--adapter-address") == 0)
+            parameters.adapterAddress = value;
+        else if (strcmp(name, "--warmup") == 0)
+            parameters.warmup = atoi(value) != 0;
+        else if (strcmp(name, "--instances-per-host") == 0)
+            parameters.instancesPerHost = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else
+        {
+            std::cerr << "Unknown argument: " << name << std::endl;
+            return 1;
+        }
+        nodeArguments += std::string(" ") + name + " \"" + value + "\"";
+    }
+
+    if (parameters.nodeCount < 1 || parameters.nodeCount > 256 ||
+        parameters.nodeId >= static_cast<int>(parameters.nodeCount))
+    {
+        std::cerr << "--nodes must be in [1, 256] and --node-id smaller than --nodes" << std::endl;
+        return 1;
+    }
+    if (parameters.instancesPerHost < 1 || parameters.instancesPerHost > HostBarrier::k_MaxInstances ||
+        parameters.instanceIndex >= parameters.instancesPerHost)
+    {
+        std::cerr << "--instances-per-host must be in [1, " << HostBarrier::k_MaxInstances
+                  << "] and --instance-index smaller than --instances-per-host" << std::endl;
+        return 1;
+    }
+
+    if (parameters.nodeId < 0)
+    {
+        return LaunchNodes(argv[0], parameters, nodeArguments);
+    }
+    return RunNode(parameters);
+}
@@ -0,0 +1,541 @@
+// Renders --frames frames to a headless swap chain (VK_EXT_headless_surface, so it runs on lavapipe or any driver
+// without a display) and presents them through VulkanGraphicsDevice and PluginCSwapGroupClient the way Unity frames
+// are presented by the plugin.  Every frame clears the acquired image and hands the present to the device
+// (SetPendingPresent) before PluginCSwapGroupClient::Render.  Presents are synchronized by VulkanPresentBarrierSyncApi
+// when the device supports VK_NV_present_barrier and by a single node SoftwareSyncApi otherwise.  Every
+// --repeat-interval frames a burst of --repeats present repeats is done (copying the last image back to the swap
+// chain).  Prints one line of space separated "key=value" with present and repeat statistics.
+//
+// Usage: VulkanPresentBenchmark [--frames N] [--width N] [--height N] [--repeat-interval N] [--repeats N]
+//                               [--present-barrier 0|1]
+
+#include "IGraphicsDevice.h"
+#include "PresentStatistics.h"
+#include "QuadroSync.h"
+#include "SimulatedNetwork.h"
+#include "SoftwareSyncApi.h"
+#include "VulkanGraphicsDevice.h"
+#include "VulkanPresentBarrierSyncApi.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace GfxQuadroSync;
+
+namespace
+{
+    struct Parameters
+    {
+        uint64_t frameCount = 1000;
+        uint32_t width = 1920;
+        uint32_t height = 1080;
+        uint32_t repeatInterval = 100;
+        uint32_t repeats = 4;
+        bool presentBarrier = true;
+    };
+
+    uint64_t GetPercentile(const PresentStatistics& statistics, double percentile)
+    {
+        if (statistics.GetCount() == 0)
+        {
+            return 0;
+        }
+        const auto& histogram = statistics.GetHistogram();
+        const auto target = static_cast<uint64_t>(statistics.GetCount() * percentile);
+        uint64_t accumulated = 0;
+        for (uint32_t bucketIndex = 0; bucketIndex < LatencyHistogram::k_BucketCount; ++bucketIndex)
+        {
+            accumulated += histogram.GetBucket(bucketIndex);
+            if (accumulated > target)
+            {
+                return LatencyHistogram::GetBucketLowerBound(bucketIndex);
+            }
+        }
+        return LatencyHistogram::GetBucketLowerBound(LatencyHistogram::k_BucketCount - 1);
+    }
+
+    std::string FormatStatistics(const char* name, const PresentStatistics& statistics)
+    {
+        const auto count = statistics.GetCount();
+        std::ostringstream os;
+        os << name << "_mean_us=" << (count > 0 ? statistics.GetSumUs() / count : 0)
+           << " " << name << "_p50_us=" << GetPercentile(statistics, 0.5)
+           << " " << name << "_p99_us=" << GetPercentile(statistics, 0.99)
+           << " " << name << "_max_us=" << statistics.GetMaxUs();
+        return os.str();
+    }
+
+    bool Check(const VkResult result, const char* what)
+    {
+        if (result != VK_SUCCESS)
+        {
+            std::cerr << what << " failed (" << result << ")" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool HasExtension(const std::vector<VkExtensionProperties>& extensions, const char* name)
+    {
+        for (const auto& extension : extensions)
+        {
+            if (strcmp(extension.extensionName, name) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Everything created to render to the headless swap chain (what Unity would have created).
+    struct Renderer
+    {
+        VkInstance instance = VK_NULL_HANDLE;
+        VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+        VkDevice device = VK_NULL_HANDLE;
+        uint32_t queueFamilyIndex = 0;
+        VkQueue queue = VK_NULL_HANDLE;
+        VkSurfaceKHR surface = VK_NULL_HANDLE;
+        VulkanGraphicsDevice::Swapchain swapchain;
+        std::vector<VkImage> images;
+        VkCommandPool commandPool = VK_NULL_HANDLE;
+        /// Clear of every swap chain image (recorded once).
+        std::vector<VkCommandBuffer> commandBuffers;
+        std::vector<VkFence> renderDoneFences;
+        /// Rotating semaphores signaled by vkAcquireNextImageKHR.
+        std::vector<VkSemaphore> acquireSemaphores;
+        /// Signaled once the clear of every swap chain image is done (waited on by its present).
+        std::vector<VkSemaphore> renderDoneSemaphores;
+
+        ~Renderer()
+        {
+            if (device != VK_NULL_HANDLE)
+            {
+                vkDeviceWaitIdle(device);
+                for (auto semaphore : acquireSemaphores)
+                    vkDestroySemaphore(device, semaphore, nullptr);
+                for (auto semaphore : renderDoneSemaphores)
+                    vkDestroySemaphore(device, semaphore, nullptr);
+                for (auto fence : renderDoneFences)
+                    vkDestroyFence(device, fence, nullptr);
+                if (commandPool != VK_NULL_HANDLE)
+                    vkDestroyCommandPool(device, commandPool, nullptr);
+                if (swapchain.swapchain != VK_NULL_HANDLE)
+                    vkDestroySwapchainKHR(device, swapchain.swapchain, nullptr);
+                vkDestroyDevice(device, nullptr);
+            }
+            if (instance != VK_NULL_HANDLE)
+            {
+                if (surface != VK_NULL_HANDLE)
+                    vkDestroySurfaceKHR(instance, surface, nullptr);
+                vkDestroyInstance(instance, nullptr);
+            }
+        }
+    };
+
+    bool CreateDevice(Renderer& renderer, const bool presentBarrier)
+    {
+        const char* instanceExtensions[] = {VK_KHR_SURFACE_EXTENSION_NAME, VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME};
+        VkApplicationInfo applicationInfo = {};
+        applicationInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+        applicationInfo.pApplicationName = "VulkanPresentBenchmark";
+        applicationInfo.apiVersion = VK_API_VERSION_1_1;
+        VkInstanceCreateInfo instanceCreateInfo = {};
+        instanceCreateInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+        instanceCreateInfo.pApplicationInfo = &applicationInfo;
+        instanceCreateInfo.enabledExtensionCount = 2;
+        instanceCreateInfo.ppEnabledExtensionNames = instanceExtensions;
+        if (!Check(vkCreateInstance(&instanceCreateInfo, nullptr, &renderer.instance), "vkCreateInstance"))
+            return false;
+
+        uint32_t physicalDeviceCount = 1;
+        const auto enumerateResult =
+            vkEnumeratePhysicalDevices(renderer.instance, &physicalDeviceCount, &renderer.physicalDevice);
+        if (physicalDeviceCount == 0 || (enumerateResult != VK_SUCCESS && enumerateResult != VK_INCOMPLETE))
+        {
+            std::cerr << "No Vulkan physical device" << std::endl;
+            return false;
+        }
+
+        // Remarks: Headless surfaces can be presented by any queue family supporting graphics.
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(renderer.physicalDevice, &queueFamilyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(renderer.physicalDevice, &queueFamilyCount, queueFamilies.data());
+        renderer.queueFamilyIndex = queueFamilyCount;
+        for (uint32_t queueFamilyIndex = 0; queueFamilyIndex < queueFamilyCount; ++queueFamilyIndex)
+        {
+            if ((queueFamilies[queueFamilyIndex].queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0)
+            {
+                renderer.queueFamilyIndex = queueFamilyIndex;
+                break;
+            }
+        }
+        if (renderer.queueFamilyIndex == queueFamilyCount)
+        {
+            std::cerr << "No graphics queue" << std::endl;
+            return false;
+        }
+
+        uint32_t extensionCount = 0;
+        vkEnumerateDeviceExtensionProperties(renderer.physicalDevice, nullptr, &extensionCount, nullptr);
+        std::vector<VkExtensionProperties> extensions(extensionCount);
+        vkEnumerateDeviceExtensionProperties(renderer.physicalDevice, nullptr, &extensionCount, extensions.data());
+
+        std::vector<const char*> deviceExtensions = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
+        const float queuePriority = 1.0f;
+        VkDeviceQueueCreateInfo queueCreateInfo = {};
+        queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        queueCreateInfo.queueFamilyIndex = renderer.queueFamilyIndex;
+        queueCreateInfo.queueCount = 1;
+        queueCreateInfo.pQueuePriorities = &queuePriority;
+        VkDeviceCreateInfo deviceCreateInfo = {};
+        deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        deviceCreateInfo.queueCreateInfoCount = 1;
+        deviceCreateInfo.pQueueCreateInfos = &queueCreateInfo;
+#ifdef VK_NV_present_barrier
+        VkPhysicalDevicePresentBarrierFeaturesNV presentBarrierFeatures =
+            {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_BARRIER_FEATURES_NV};
+        presentBarrierFeatures.presentBarrier = VK_TRUE;
+        if (presentBarrier && HasExtension(extensions, VK_NV_PRESENT_BARRIER_EXTENSION_NAME))
+        {
+            deviceExtensions.push_back(VK_NV_PRESENT_BARRIER_EXTENSION_NAME);
+            deviceCreateInfo.pNext = &presentBarrierFeatures;
+            renderer.swapchain.presentBarrierEnabled = true;
+        }
+#else
+        (void)presentBarrier;
+#endif
+        deviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
+        deviceCreateInfo.ppEnabledExtensionNames = deviceExtensions.data();
+        if (!Check(vkCreateDevice(renderer.physicalDevice, &deviceCreateInfo, nullptr, &renderer.device),
+                "vkCreateDevice"))
+            return false;
+        vkGetDeviceQueue(renderer.device, renderer.queueFamilyIndex, 0, &renderer.queue);
+        return true;
+    }
+
+    bool CreateSwapchain(Renderer& renderer, const Parameters& parameters)
+    {
+        const auto createHeadlessSurface = reinterpret_cast<PFN_vkCreateHeadlessSurfaceEXT>(
+            vkGetInstanceProcAddr(renderer.instance, "vkCreateHeadlessSurfaceEXT"));
+        VkHeadlessSurfaceCreateInfoEXT surfaceCreateInfo = {};
+        surfaceCreateInfo.sType = VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT;
+        if (createHeadlessSurface == nullptr ||
+            !Check(createHeadlessSurface(renderer.instance, &surfaceCreateInfo, nullptr, &renderer.surface),
+                "vkCreateHeadlessSurfaceEXT"))
+            return false;
+
+        VkSurfaceCapabilitiesKHR capabilities;
+        if (!Check(vkGetPhysicalDeviceSurfaceCapabilitiesKHR(renderer.physicalDevice, renderer.surface,
+                &capabilities), "vkGetPhysicalDeviceSurfaceCapabilitiesKHR"))
+            return false;
+        uint32_t formatCount = 1;
+        VkSurfaceFormatKHR surfaceFormat;
+        const auto formatResult = vkGetPhysicalDeviceSurfaceFormatsKHR(renderer.physicalDevice, renderer.surface,
+            &formatCount, &surfaceFormat);
+        if (formatCount == 0 || (formatResult != VK_SUCCESS && formatResult != VK_INCOMPLETE))
+        {
+            std::cerr << "No surface format" << std::endl;
+            return false;
+        }
+
+        // Same usage as the swap chains created by Unity once intercepted (see VulkanInterception).
+        VkSwapchainCreateInfoKHR swapchainCreateInfo = {};
+        swapchainCreateInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+        swapchainCreateInfo.surface = renderer.surface;
+        swapchainCreateInfo.minImageCount = std::max(capabilities.minImageCount, 3u);
+        if (capabilities.maxImageCount != 0)
+            swapchainCreateInfo.minImageCount = std::min(swapchainCreateInfo.minImageCount, capabilities.maxImageCount);
+        swapchainCreateInfo.imageFormat = surfaceFormat.format;
+        swapchainCreateInfo.imageColorSpace = surfaceFormat.colorSpace;
+        swapchainCreateInfo.imageExtent = {parameters.width, parameters.height};
+        swapchainCreateInfo.imageArrayLayers = 1;
+        swapchainCreateInfo.imageUsage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        swapchainCreateInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        swapchainCreateInfo.preTransform = capabilities.currentTransform;
+        swapchainCreateInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+        swapchainCreateInfo.presentMode = VK_PRESENT_MODE_FIFO_KHR;
+        swapchainCreateInfo.clipped = VK_TRUE;
+#ifdef VK_NV_present_barrier
+        VkSwapchainPresentBarrierCreateInfoNV presentBarrierCreateInfo =
+            {VK_STRUCTURE_TYPE_SWAPCHAIN_PRESENT_BARRIER_CREATE_INFO_NV};
+        presentBarrierCreateInfo.presentBarrierEnable = VK_TRUE;
+        if (renderer.swapchain.presentBarrierEnabled)
+            swapchainCreateInfo.pNext = &presentBarrierCreateInfo;
+#endif
+        if (!Check(vkCreateSwapchainKHR(renderer.device, &swapchainCreateInfo, nullptr,
+                &renderer.swapchain.swapchain), "vkCreateSwapchainKHR"))
+            return false;
+        renderer.swapchain.format = swapchainCreateInfo.imageFormat;
+        renderer.swapchain.extent = swapchainCreateInfo.imageExtent;
+        renderer.swapchain.usage = swapchainCreateInfo.imageUsage;
+
+        uint32_t imageCount = 0;
+        vkGetSwapchainImagesKHR(renderer.device, renderer.swapchain.swapchain, &imageCount, nullptr);
+        renderer.images.resize(imageCount);
+        vkGetSwapchainImagesKHR(renderer.device, renderer.swapchain.swapchain, &imageCount, renderer.images.data());
+        return true;
+    }
+
+    bool RecordRendering(Renderer& renderer)
+    {
+        VkCommandPoolCreateInfo commandPoolCreateInfo = {};
+        commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        commandPoolCreateInfo.queueFamilyIndex = renderer.queueFamilyIndex;
+        if (!Check(vkCreateCommandPool(renderer.device, &commandPoolCreateInfo, nullptr, &renderer.commandPool),
+                "vkCreateCommandPool"))
+            return false;
+
+        const auto imageCount = static_cast<uint32_t>(renderer.images.size());
+        renderer.commandBuffers.resize(imageCount);
+        VkCommandBufferAllocateInfo allocateInfo = {};
+        allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocateInfo.commandPool = renderer.commandPool;
+        allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocateInfo.commandBufferCount = imageCount;
+        if (!Check(vkAllocateCommandBuffers(renderer.device, &allocateInfo, renderer.commandBuffers.data()),
+                "vkAllocateCommandBuffers"))
+            return false;
+
+        const VkImageSubresourceRange range = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+        for (uint32_t imageIndex = 0; imageIndex < imageCount; ++imageIndex)
+        {
+            const auto commandBuffer = renderer.commandBuffers[imageIndex];
+            VkCommandBufferBeginInfo beginInfo = {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+            VkImageMemoryBarrier barrier = {};
+
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = renderer.images[imageIndex];
+            barrier.subresourceRange = range;
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                0, nullptr, 0, nullptr, 1, &barrier);
+
+            VkClearColorValue color = {};
+            color.float32[0] = static_cast<float>(imageIndex + 1) / static_cast<float>(imageCount);
+            color.float32[3] = 1.0f;
+            vkCmdClearColorImage(commandBuffer, renderer.images[imageIndex], VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                &color, 1, &range);
+
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = 0;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                0, 0, nullptr, 0, nullptr, 1, &barrier);
+            if (!Check(vkEndCommandBuffer(commandBuffer), "vkEndCommandBuffer"))
+                return false;
+        }
+
+        VkSemaphoreCreateInfo semaphoreCreateInfo = {};
+
+        semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        VkFenceCreateInfo fenceCreateInfo = {};
+        fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        fenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+        renderer.acquireSemaphores.resize(imageCount + 1);
+        renderer.renderDoneSemaphores.resize(imageCount);
+        renderer.renderDoneFences.resize(imageCount);
+        for (auto& semaphore : renderer.acquireSemaphores)
+        {
+            if (!Check(vkCreateSemaphore(renderer.device, &semaphoreCreateInfo, nullptr, &semaphore),
+                    "vkCreateSemaphore"))
+                return false;
+        }
+        for (uint32_t imageIndex = 0; imageIndex < imageCount; ++imageIndex)
+        {
+            if (!Check(vkCreateSemaphore(renderer.device, &semaphoreCreateInfo, nullptr,
+                    &renderer.renderDoneSemaphores[imageIndex]), "vkCreateSemaphore") ||
+                !Check(vkCreateFence(renderer.device, &fenceCreateInfo, nullptr,
+                    &renderer.renderDoneFences[imageIndex]), "vkCreateFence"))
+                return false;
+        }
+        return true;
+    }
+
+    /// Render a frame and give its present to graphicsDevice (what Unity does before its vkQueuePresentKHR).
+    bool RenderFrame(Renderer& renderer, VulkanGraphicsDevice& graphicsDevice, const uint64_t frameIndex)
+    {
+        const auto acquireSemaphore = renderer.acquireSemaphores[frameIndex % renderer.acquireSemaphores.size()];
+        uint32_t imageIndex = 0;
+        const auto acquireResult = vkAcquireNextImageKHR(renderer.device, renderer.swapchain.swapchain, UINT64_MAX,
+            acquireSemaphore, VK_NULL_HANDLE, &imageIndex);
+        if (acquireResult != VK_SUCCESS && acquireResult != VK_SUBOPTIMAL_KHR)
+        {
+            std::cerr << "vkAcquireNextImageKHR failed (" << acquireResult << ")" << std::endl;
+            return false;
+        }
+
+        const auto fence = renderer.renderDoneFences[imageIndex];
+        vkWaitForFences(renderer.device, 1, &fence, VK_TRUE, UINT64_MAX);
+        vkResetFences(renderer.device, 1, &fence);
+
+        const VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        VkSubmitInfo submitInfo = {};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.waitSemaphoreCount = 1;
+        submitInfo.pWaitSemaphores = &acquireSemaphore;
+        submitInfo.pWaitDstStageMask = &waitStage;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &renderer.commandBuffers[imageIndex];
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = &renderer.renderDoneSemaphores[imageIndex];
+        if (!Check(vkQueueSubmit(renderer.queue, 1, &submitInfo, fence), "vkQueueSubmit"))
+            return false;
+
+        VkPresentInfoKHR presentInfo = {};
+
+        presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+        presentInfo.waitSemaphoreCount = 1;
+        presentInfo.pWaitSemaphores = &renderer.renderDoneSemaphores[imageIndex];
+        presentInfo.swapchainCount = 1;
+        presentInfo.pSwapchains = &renderer.swapchain.swapchain;
+        presentInfo.pImageIndices = &imageIndex;
+        if (!graphicsDevice.SetPendingPresent(renderer.queue, presentInfo))
+        {
+            std::cerr << "SetPendingPresent failed" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    int Run(const Parameters& parameters)
+    {
+        Renderer renderer;
+        if (!CreateDevice(renderer, parameters.presentBarrier) || !CreateSwapchain(renderer, parameters) ||
+            !RecordRendering(renderer))
+            return 1;
+
+        VulkanGraphicsDevice graphicsDevice(renderer.instance, renderer.physicalDevice, renderer.device,
+            renderer.queue, renderer.queueFamilyIndex, vkGetInstanceProcAddr);
+        if (graphicsDevice.GetDevice() == nullptr)
+        {
+            std::cerr << "VulkanGraphicsDevice failed to fetch the Vulkan functions" << std::endl;
+            return 1;
+        }
+        graphicsDevice.SetSwapchain(renderer.swapchain);
+
+        SimulatedNetwork network(SimulatedNetwork::Config{});
+        std::unique_ptr<ISyncApi> syncApi;
+        if (graphicsDevice.IsPresentBarrierEnabled())
+        {
+            syncApi = std::make_unique<VulkanPresentBarrierSyncApi>();
+        }
+        else
+        {
+            SoftwareSyncApi::Config syncConfig;
+            syncConfig.nodeId = 0;
+            syncConfig.nodes.set(0);
+            syncApi = std::make_unique<SoftwareSyncApi>(syncConfig, network.CreateEndpoint());
+        }
+        const std::string syncApiName = syncApi->GetName();
+        PluginCSwapGroupClient client(std::move(syncApi));
+        client.SetupWorkStation();
+        if (client.Initialize(graphicsDevice.GetDevice(), graphicsDevice.GetSwapChain()) !=
+            PluginCSwapGroupClient::InitializeStatus::Success)
+        {
+            std::cerr << "Failed to initialize PluginCSwapGroupClient" << std::endl;
+            return 1;
+        }
+
+        PresentStatistics repeatStatistics;
+        uint64_t repeatedPresents = 0;
+        const auto begin = std::chrono::steady_clock::now();
+        for (uint64_t frameIndex = 0; frameIndex < parameters.frameCount; ++frameIndex)
+        {
+            if (!RenderFrame(renderer, graphicsDevice, frameIndex))
+                return 1;
+
+            const bool repeat = parameters.repeatInterval > 0 && parameters.repeats > 0 &&
+                frameIndex % parameters.repeatInterval == parameters.repeatInterval - 1;
+            if (!repeat)
+            {
+                client.Render(&graphicsDevice);
+                continue;
+            }
+
+            // Same sequence as PluginCSwapGroupClient while warming up the barrier.
+            const auto repeatBegin = std::chrono::steady_clock::now();
+            graphicsDevice.InitiatePresentRepeats();
+            graphicsDevice.Present();
+            for (uint32_t repeatIndex = 0; repeatIndex < parameters.repeats; ++repeatIndex)
+            {
+                graphicsDevice.PrepareSinglePresentRepeat();
+                graphicsDevice.Present();
+                ++repeatedPresents;
+            }
+            graphicsDevice.ConcludePresentRepeats();
+            repeatStatistics.Record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - repeatBegin).count()));
+        }
+        vkDeviceWaitIdle(renderer.device);
+        const auto elapsed = std::chrono::steady_clock::now() - begin;
+        client.Dispose(graphicsDevice.GetDevice(), graphicsDevice.GetSwapChain());
+
+        std::ostringstream os;
+        os << "sync_api=" << syncApiName
+           << " width=" << parameters.width
+           << " height=" << parameters.height
+           << " swapchain_images=" << renderer.images.size()
+           << " frames=" << parameters.frameCount
+           << " elapsed_ms=" << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()
+           << " presents_failed=" << client.GetPresentFailureCount()
+           << " last_present_result=" << graphicsDevice.GetLastPresentResult()
+           << " repeat_bursts=" << repeatStatistics.GetCount()
+           << " repeated_presents=" << repeatedPresents
+           << " " << FormatStatistics("present", client.GetPresentStatistics())
+           << " " << FormatStatistics("repeat_burst", repeatStatistics)
+           << "\n";
+        std::cout << os.str() << std::flush;
+        return client.GetPresentFailureCount() == 0 ? 0 : 1;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Parameters parameters;
+    for (int argIndex = 1; argIndex + 1 < argc; argIndex += 2)
+    {
+        const char* name = argv[argIndex];
+        const char* value = argv[argIndex + 1];
+        if (strcmp(name, "--frames") == 0)
+            parameters.frameCount = strtoull(value, nullptr, 10);
+        else if (strcmp(name, "--width") == 0)
+            parameters.width = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--height") == 0)
+            parameters.height = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--repeat-interval") == 0)
+            parameters.repeatInterval = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--repeats") == 0)
+            parameters.repeats = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (strcmp(name, "--present-barrier") == 0)
+            parameters.presentBarrier = atoi(value) != 0;
+        else
+        {
+            std::cerr << "Unknown argument: " << name << std::endl;
+            return 1;
+        }
+    }
+
+    if (parameters.width == 0 || parameters.height == 0)
+    {
+        std::cerr << "--width and --height must be greater than 0" << std::endl;
+        return 1;
+    }
+    return Run(parameters);
+}
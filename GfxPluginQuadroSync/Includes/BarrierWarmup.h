@@ -0,0 +1,196 @@
+#pragma once
+
+#include "IDatagramTransport.h"
+
+#include <bitset>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace GfxQuadroSync
+{
+    /// What PluginCSwapGroupClient::Render has to do after a present done while the swap barrier is warming up.
+    enum class BarrierWarmupAction
+    {
+        RepeatPresent,
+        ContinueToNextFrame,
+        BarrierWarmedUp,
+    };
+
+    /// Stage of the barrier warmup (the first three match the managed QuadroBarrierWarmupStage).
+    enum class BarrierWarmupStage : uint8_t
+    {
+        /// Repeaters present as fast as they can until they get blocked by the barrier.
+        RepeaterFastPresent,
+        /// All repeaters are blocked, emitter waits for them to be ready and does a long present to release them.
+        RepeatersPaused,
+        /// Repeaters do the additional presents requested by the emitter to catch up on its presents count.
+        LastRepeatersBurst,
+        /// Emitter is done, repeaters can stop sending their status.
+        Done,
+    };
+
+    /**
+     * State of the barrier warmup.
+     *
+     * \remark Any change must be reflected in GfxPluginQuadroSyncBarrierWarmupState in GfxPluginQuadroSyncState.cs.
+     */
+    enum class BarrierWarmupState : uint32_t
+    {
+        NotStarted = 0,
+        InProgress = 1,
+        Succeeded = 2,
+        Timeout = 3,
+        Aborted = 4,
+        NetworkFailure = 5,
+    };
+
+    /**
+     * \brief Warm up the swap barrier of every node of the cluster.
+     *
+     * Once the swap barrier is enabled, the first presents of the different nodes are not synchronized: a node can be
+     * a few presents ahead of the others (in the NvAPI frame count) and stay that way.  Nodes therefore present in
+     * a coordinated way until they are all blocked by the barrier and then do a last burst of presents so that every
+     * node has done the same number of presents:
+     * - RepeaterFastPresent: Repeaters present until they detect a long present (a present blocked for more than
+     *   blockDelay by the barrier since the emitter is not presenting), the emitter presents as slowly as possible.
+     * - RepeatersPaused: Emitter waits for blockDelay (so that every repeater is blocked) and then does a present
+     *   releasing every repeater.  It continues presenting until one of its presents gets blocked (by repeaters that
+     *   are done) and counts the number of presents it did.
+     * - LastRepeatersBurst: Repeaters do half the number of presents done by the emitter (the other half was done
+     *   by the emitter catching up on repeaters).
+     *
+     * Messages are exchanged through an IDatagramTransport by a network thread owned by this class (that also detects
+     * long presents while the render thread is blocked in them).  The render thread only has to call OnPresentStarting
+     * and OnPresentCompleted around every present.
+     *
+     * \remark This is the native version of the protocol that used to be implemented by QuadroSyncInitEmitterState
+     * and QuadroSyncInitRepeaterState.  Running it natively avoids depending on the managed main thread being
+     * responsive (it is blocked waiting on the render thread while presents are repeated).
+     */
+    class BarrierWarmup final
+    {
+    public:
+        struct Config
+        {
+            /// Is this node the emitter (that drives the warmup) or a repeater?
+            bool isEmitter = false;
+            /// Identifier of this node in the cluster.
+            uint8_t nodeId = 0;
+            /// Node id of every repeater the emitter has to wait on (not used by repeaters).
+            std::bitset<256> repeaters;
+            /// Number of presents the emitter skips before starting to warm up (to let delayed repeaters catch up).
+            uint32_t presentsToSkip = 0;
+            /// Duration of a present for it to be considered as blocked by the barrier.
+            std::chrono::milliseconds blockDelay{150};
+            /// Interval at which the current heartbeat (emitter) or status (repeaters) is repeated.
+            std::chrono::milliseconds repeatMessageInterval{25};
+            /// Maximum duration of the warmup.
+            std::chrono::milliseconds timeout{30000};
+            /// How long the emitter continues to answer repeaters once it is done (in case they lost the last heartbeat).
+            std::chrono::milliseconds lingerDuration{500};
+        };
+
+        BarrierWarmup() = default;
+        ~BarrierWarmup();
+
+        /**
+         * Start warming up the barrier (stopping any previous warmup).
+         *
+         * \param[in] config How to warmup.
+         * \param[in] transport Used to exchange messages with the other nodes of the cluster.
+         *
+         * \return Success?
+         */
+        bool Start(const Config& config, std::unique_ptr<IDatagramTransport> transport);
+
+        /// Abort the warmup in progress (the render thread will stop repeating presents).
+        void Abort();
+
+        /// Stop the network thread (and the warmup if still in progress).
+        void Stop();
+
+        /// Indicate the render thread is starting a present.
+        void OnPresentStarting();
+
+        /**
+         * Indicate the render thread completed a present.
+         *
+         * \return What the render thread has to do next.
+         *
+         * \remark Can block the calling thread for up to 2 * blockDelay (to wait for the other nodes).
+         */
+        BarrierWarmupAction OnPresentCompleted();
+
+        BarrierWarmupState GetState() const;
+        /// Duration of the warmup (up to now if it is still in progress).
+        std::chrono::microseconds GetDuration() const;
+        /// Number of presents the emitter did while repeaters were paused (0 on repeaters).
+        uint32_t GetPresentWhileRepeatersArePausedCount() const;
+
+        BarrierWarmup(const BarrierWarmup&) = delete;
+        BarrierWarmup& operator=(const BarrierWarmup&) = delete;
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+        typedef std::unique_lock<std::mutex> Lock;
+
+        void NetworkThreadMain();
+        void ProcessMessage(const uint8_t* message, int size);
+        size_t BuildMessage(uint8_t* message) const;
+        bool IsNetworkThreadDone(Clock::time_point now) const;
+
+        BarrierWarmupAction EmitterStep(Lock& lock);
+        BarrierWarmupAction RepeaterStep(Lock& lock);
+        BarrierWarmupAction ConcludeRenderThread();
+        void OnLongPresent();
+        bool AllRepeatersCompleted() const;
+        void WaitForRepeaterCompletion(Lock& lock, Clock::duration maxWait);
+        void SetHeartbeat(BarrierWarmupStage stage, uint32_t additionalPresentCount = 0);
+        void SetStatus(BarrierWarmupStage stage, bool completed);
+        void Conclude(BarrierWarmupState state);
+
+        /// Special value returned by EmitterStep and RepeaterStep to indicate the step is to be evaluated again.
+        static constexpr auto k_StepAgain = static_cast<BarrierWarmupAction>(-1);
+
+        Config m_Config;
+        std::unique_ptr<IDatagramTransport> m_Transport;
+        std::thread m_NetworkThread;
+
+        // Everything below is protected by m_Lock.
+        mutable std::mutex m_Lock;
+        std::condition_variable m_Changed;
+        BarrierWarmupState m_State = BarrierWarmupState::NotStarted;
+        bool m_StopNetworkThread = false;
+        /// Has the render thread concluded the warmup (so OnPresentCompleted has nothing more to do)?
+        bool m_RenderThreadDone = false;
+        bool m_SendNow = false;
+        Clock::time_point m_StartTime;
+        Clock::time_point m_EndTime;
+        Clock::time_point m_Deadline;
+
+        // Presents monitoring
+        bool m_PresentInProgress = false;
+        Clock::time_point m_PresentStartTime;
+        /// Is the present in progress (or the next one) to be monitored for being blocked by the barrier?
+        bool m_MonitorPresent = false;
+        bool m_PresentDetectedAsLong = false;
+
+        // Emitter state (heartbeat is also used by repeaters to store the last one received)
+        bool m_HasHeartbeat = false;
+        BarrierWarmupStage m_HeartbeatStage = BarrierWarmupStage::RepeaterFastPresent;
+        uint32_t m_HeartbeatAdditionalPresentCount = 0;
+        std::bitset<256> m_StageCompletedRepeaters;
+        bool m_RepeaterCompletedSinceLastWait = false;
+        uint32_t m_PresentsToSkip = 0;
+        uint32_t m_PresentWhileRepeatersArePaused = 0;
+
+        // Repeater state
+        BarrierWarmupStage m_StatusStage = BarrierWarmupStage::RepeaterFastPresent;
+        bool m_StatusCompleted = false;
+        uint32_t m_AdditionalPresentsDone = 0;
+    };
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "IDatagramTransport.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Estimate the offset between the clock of this node and the clock of the emitter (the cluster time).
+     *
+     * Repeaters periodically send a probe (with its send time t1) to the emitter that answers with the time it
+     * received the probe (t2) and sent the answer (t3), the repeater then notes the time it received the answer (t4).
+     * Like NTP:
+     * - round trip = (t4 - t1) - (t3 - t2)
+     * - offset = ((t2 - t1) + (t3 - t4)) / 2
+     * Delays are rarely symmetrical (and are mostly made of queuing that only ever adds to the round trip), so the
+     * sample with the smallest round trip among the last sampleWindow ones is the one used (its error is at most half
+     * its round trip, plus the drift of the clocks since it was taken).
+     *
+     * Messages are exchanged through an IDatagramTransport by a network thread owned by this class, so estimates are
+     * refined in the background and can be read from any thread.
+     *
+     * \remark Times are in nanoseconds of the steady clock (plus injectedOffset).  The emitter's time is the cluster
+     *         time.
+     * \remark injectedOffset and injectedSendDelay are to test the estimation on a single computer (where every node
+     *         shares the same clock and the network has almost no latency).
+     */
+    class ClockSync final
+    {
+    public:
+        struct Config
+        {
+            /// Is this node the emitter (whose clock is the cluster time) or a repeater?
+            bool isEmitter = false;
+            /// Identifier of this node in the cluster.
+            uint8_t nodeId = 0;
+            /// Interval between the probes sent by repeaters.
+            std::chrono::milliseconds probeInterval{100};
+            /// Number of recent samples among which the one with the smallest round trip is used.
+            uint32_t sampleWindow = 16;
+            /// Maximum drift between the clocks of two nodes (in parts per million), used to compute the uncertainty.
+            uint32_t maxDriftPpm = 100;
+            /// Added to the local clock of this node (to simulate nodes with different clocks).
+            std::chrono::nanoseconds injectedOffset{0};
+            /// Delay between timestamping and sending every message (to simulate network latency).
+            std::chrono::microseconds injectedSendDelay{0};
+        };
+
+        /// Current estimate of the offset between the local clock and the cluster time.
+        struct Estimate
+        {
+            /// Did we get at least one sample?  (always true on the emitter)
+            bool valid = false;
+            /// To be added to the local time to get the cluster time.
+            int64_t offsetNs = 0;
+            /// Maximum error on offsetNs.
+            int64_t uncertaintyNs = 0;
+            /// Round trip of the sample the estimate comes from.
+            int64_t roundTripNs = 0;
+            /// Number of samples received since Start.
+            uint64_t sampleCount = 0;
+        };
+
+        ClockSync() = default;
+        ~ClockSync();
+
+        /**
+         * Start synchronizing (stopping any previous synchronization).
+         *
+         * \param[in] config How to synchronize.
+         * \param[in] transport Used to exchange messages with the other nodes of the cluster.
+         *
+         * \return Success?
+         */
+        bool Start(const Config& config, std::unique_ptr<IDatagramTransport> transport);
+
+        /// Stop the network thread (the last estimate stays available).
+        void Stop();
+
+        bool IsRunning() const;
+
+        /// Local time of this node (steady clock + injectedOffset).
+        int64_t GetLocalTimeNs() const;
+
+        Estimate GetEstimate() const;
+
+        /**
+         * Convert a local time to the cluster time.
+         *
+         * \return Could the time be converted (false until the first sample is received)?
+         */
+        bool ToClusterTime(int64_t localTimeNs, int64_t& clusterTimeNs) const;
+
+        /**
+         * Convert a cluster time to the local time.
+         *
+         * \return Could the time be converted (false until the first sample is received)?
+         */
+        bool ToLocalTime(int64_t clusterTimeNs, int64_t& localTimeNs) const;
+
+        /// Number of probes sent (repeater) or answered (emitter).
+        uint64_t GetProbeCount() const;
+
+        ClockSync(const ClockSync&) = delete;
+        ClockSync& operator=(const ClockSync&) = delete;
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+        typedef std::unique_lock<std::mutex> Lock;
+
+        struct Sample
+        {
+            int64_t offsetNs;
+            int64_t roundTripNs;
+            /// Local time at which the sample was taken.
+            int64_t timeNs;
+        };
+
+        void NetworkThreadMain();
+        void SendProbe(uint32_t sequence);
+        void AnswerProbe(const uint8_t* message, int64_t receiveTimeNs);
+        void ProcessAnswer(const uint8_t* message, int64_t receiveTimeNs);
+        void Send(const uint8_t* message, size_t size);
+        Estimate ComputeEstimate(int64_t nowNs) const;
+
+        Config m_Config;
+        std::unique_ptr<IDatagramTransport> m_Transport;
+        std::thread m_NetworkThread;
+
+        // Everything below is protected by m_Lock.
+        mutable std::mutex m_Lock;
+        std::condition_variable m_Changed;
+        bool m_StopNetworkThread = false;
+        bool m_Running = false;
+        std::deque<Sample> m_Samples;
+        /// Sample of m_Samples with the smallest round trip.
+        Sample m_BestSample = {};
+        uint64_t m_SampleCount = 0;
+        uint64_t m_ProbeCount = 0;
+    };
+}
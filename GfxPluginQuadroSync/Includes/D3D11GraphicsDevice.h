@@ -4,9 +4,18 @@
 #include "dxgi.h"
 #include "IGraphicsDevice.h"
 #include "ComHelpers.h"
+#include "SavedFrameCache.h"
 
 namespace GfxQuadroSync
 {
+    /**
+     * \brief IGraphicsDevice presenting a Direct3D 11 swap chain.
+     *
+     * Present repeats copy the back buffer to a texture of our own when InitiatePresentRepeats is called and copy it
+     * back before every repeat.  That texture is kept from one barrier warmup to the next (see SavedFrameCache), only
+     * the references to the back buffer are released by ConcludePresentRepeats (so that Unity can resize it).  Frame
+     * hold saves every frame to that same texture.
+     */
     class D3D11GraphicsDevice final : public IGraphicsDevice
     {
     public:
@@ -25,14 +34,26 @@ namespace GfxQuadroSync
         UINT32          GetSyncInterval() const override { return m_SyncInterval; }
         UINT            GetPresentFlags() const override { return m_PresentFlags; }
 
-        void SetDevice(IUnknown* const device) override { m_D3D11Device = static_cast<ID3D11Device*>(device); }
+        void SetDevice(IUnknown* const device) override;
         void SetSwapChain(IDXGISwapChain* const swapChain) override { m_SwapChain = swapChain; }
 
+        bool Present() override;
+
         void InitiatePresentRepeats() override;
         void PrepareSinglePresentRepeat() override;
         void ConcludePresentRepeats() override;
 
+        const SavedFrameCache* GetSavedFrameCache() const override { return &m_SavedFrameCache; }
+
+        void SaveFrameToHold() override;
+        bool PrepareHeldFramePresent() override;
+        void ReleaseHeldFrame() override { m_HeldFrameSaved = false; }
+
     private:
+        /// Make sure m_SavedToPresent (and m_DeviceContext) can receive a copy of backBuffer.
+        void EnsureSavedFrame(const ComSharedPtr<ID3D11Texture2D>& backBuffer, bool countReuse);
+        void FreeSavedFrame();
+
         ID3D11Device* m_D3D11Device;
         IDXGISwapChain* m_SwapChain;
         UINT32 m_SyncInterval;
@@ -42,5 +63,8 @@ namespace GfxQuadroSync
         ComSharedPtr<ID3D11RenderTargetView> m_BackBufferRenderTargetView;
         ComSharedPtr<ID3D11Texture2D> m_SavedToPresent;
         ComSharedPtr<ID3D11DeviceContext> m_DeviceContext;
+        SavedFrameCache m_SavedFrameCache;
+        /// Does m_SavedToPresent contain the last frame presented (saved by SaveFrameToHold)?
+        bool m_HeldFrameSaved = false;
     };
 }
@@ -3,15 +3,38 @@
 #include "d3d12.h"
 #include "dxgi.h"
 #include "IGraphicsDevice.h"
+#include "IPresentRepeatQueue.h"
 #include "ComHelpers.h"
+#include "PresentRepeatScheduler.h"
+#include "SavedFrameCache.h"
 
+#include <atomic>
 #include <vector>
 
 struct IDXGISwapChain3;
 
 namespace GfxQuadroSync
 {
-    class D3D12GraphicsDevice final : public IGraphicsDevice
+    /**
+     * \brief IGraphicsDevice presenting a Direct3D 12 swap chain.
+     *
+     * Present repeats copy the frame to repeat to a texture of our own when InitiatePresentRepeats is called and
+     * record, for every back buffer, the commands copying it back to that back buffer.  A repeat then only executes the
+     * commands of the current back buffer, PresentRepeatScheduler only waits on the GPU when the previous repeat to
+     * that back buffer is still in flight.
+     *
+     * The texture, command allocators and command lists are kept from one barrier warmup to the next (see
+     * SavedFrameCache), only the references to the back buffers are released by ConcludePresentRepeats.
+     *
+     * Frame hold saves every frame to that same texture (and copies it back for held presents) with commands recorded
+     * for every present, one command allocator per back buffer so that the CPU never waits on the GPU.  Held presents
+     * move to the next back buffer like any other present, so Unity's next frame can only be presented once the swap
+     * chain is back to the back buffer Unity rendered it to (see GetPendingHeldFramePresentCount).
+     *
+     * Presents done by the present worker signal a fence per back buffer, Unity only waits for the one of the back
+     * buffer it renders to next (see WaitForNextBackBuffer) instead of waiting for every present in flight.
+     */
+    class D3D12GraphicsDevice final : public IGraphicsDevice, private IPresentRepeatQueue
     {
     public:
         D3D12GraphicsDevice(
@@ -33,15 +56,68 @@ namespace GfxQuadroSync
         void SetDevice(IUnknown* const device) override;
         void SetSwapChain(IDXGISwapChain* const swapChain) override;
 
+        bool Present() override;
+
         void InitiatePresentRepeats() override;
         void PrepareSinglePresentRepeat() override;
         void ConcludePresentRepeats() override;
 
+        const SavedFrameCache* GetSavedFrameCache() const override { return &m_SavedFrameCache; }
+
+        void SaveFrameToHold() override;
+        bool PrepareHeldFramePresent() override;
+        uint32_t GetPendingHeldFramePresentCount() const override;
+        void ReleaseHeldFrame() override { m_HeldFrameSaved = false; }
+
+        uint32_t GetBackBufferCount() const override;
+        uint32_t OnAsyncPresentQueued() override;
+        void OnAsyncPresentDone(uint32_t backBufferIndex) override;
+        void WaitForNextBackBuffer() override;
+
     private:
+        /// Commands copying the frame to repeat to a back buffer (recorded by every InitiatePresentRepeats).
+        struct RepeatCommands
+        {
+            ComSharedPtr<ID3D12CommandAllocator> commandAllocator;
+            ComSharedPtr<ID3D12GraphicsCommandList> commandList;
+        };
+
+        /// Commands saving the frame to hold or copying it back to a back buffer (recorded for every present).
+        struct FrameHoldCommands
+        {
+            ComSharedPtr<ID3D12CommandAllocator> commandAllocator;
+            ComSharedPtr<ID3D12GraphicsCommandList> commandList;
+            /// Value the fence is signaled with once the GPU is done with them.
+            uint64_t fenceValue = 0;
+        };
+
+        /// Fence signaled once the present worker presented a back buffer.
+        struct AsyncPresentFence
+        {
+            ComSharedPtr<ID3D12Fence> fence;
+            /// Presents of the back buffer handed to the present worker (value of the fence once they are all done).
+            uint64_t queuedCount = 0;
+            /// Presents of the back buffer done by the present worker (only used by the worker).
+            uint64_t doneCount = 0;
+        };
+
+        bool ExecuteRepeat(uint32_t backBufferIndex, uint64_t fenceValue) override;
+        uint64_t GetCompletedFenceValue() override;
+        void WaitForFenceValue(uint64_t fenceValue) override;
+
         bool IsFenceCreated() const { return m_CommandExecutionDoneFence != nullptr; }
         void EnsureFenceCreated();
-        void QueueUpdateFence();
-        void WaitForFence();
+        bool CreateResources(const ComSharedPtr<ID3D12Resource>& backBuffer, UINT backBufferCount);
+        bool ResetCommandList(const ComSharedPtr<ID3D12CommandAllocator>& commandAllocator,
+            const ComSharedPtr<ID3D12GraphicsCommandList>& commandList);
+        bool RecordRepeatCommands(UINT backBufferIndex);
+        /// Copy the current back buffer to m_SavedTexture (saveBackBuffer) or the other way around.
+        bool ExecuteFrameHoldCopy(bool saveBackBuffer);
+        /// Create a fence per back buffer (if the number of back buffers changed), no present must be in flight.
+        void UpdateAsyncPresentFences();
+        /// Release what is only used during a warmup (the back buffers).
+        void ReleaseBackBuffers();
+        /// Release everything (the resources kept between warmups included).
         void FreeResources();
 
         ComSharedPtr<ID3D12Device> m_D3D12Device;
@@ -51,13 +127,29 @@ namespace GfxQuadroSync
         UINT m_PresentFlags;
 
         ComSharedPtr<ID3D12Fence> m_CommandExecutionDoneFence;
-        UINT64 m_CommandExecutionDoneFenceNextValue = 1;
         HandleWrapper m_BarrierReachedEvent;
 
         std::vector<ComSharedPtr<ID3D12Resource>> m_BackBuffers;
+        // Commands saving the frame to repeat to m_SavedTexture
         ComSharedPtr<ID3D12CommandAllocator> m_CommandAllocator;
         ComSharedPtr<ID3D12GraphicsCommandList> m_CommandList;
+        std::vector<RepeatCommands> m_RepeatCommands;
         ComSharedPtr<ID3D12Resource> m_SavedTexture;
+        D3D12_RESOURCE_STATES m_SavedTextureState = D3D12_RESOURCE_STATE_COMMON;
+        SavedFrameCache m_SavedFrameCache;
+        std::vector<FrameHoldCommands> m_FrameHoldCommands;
+        /// Does m_SavedTexture contain the last frame presented (saved by SaveFrameToHold)?
+        bool m_HeldFrameSaved = false;
+        /// Back buffer Unity renders its next frame to while frames are held (-1 when not holding).
+        UINT m_HoldBackBufferIndex = -1;
+        PresentRepeatScheduler m_RepeatScheduler;
         UINT m_FirstRepeatBackBufferIndex = -1;
+
+        std::vector<AsyncPresentFence> m_AsyncPresentFences;
+        HandleWrapper m_AsyncPresentDoneEvent;
+        /// Back buffer Unity renders to after the last one handed to the present worker.
+        UINT m_NextAsyncPresentBackBufferIndex = 0;
+        /// Back buffers handed to the present worker and not presented yet.
+        std::atomic<uint32_t> m_AsyncPresentsInFlight = 0;
     };
 }
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "PerformanceCounter.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Identifier of the events recorded by EventTrace.
+     *
+     * \remark Values are stored in trace files, never change the value of an existing event (add new ones at the end
+     *         and describe them in GetEventTraceDescription).
+     */
+    enum class EventTraceId : uint16_t
+    {
+        /// Entering the call presenting a frame (args: frame index, repeat index).
+        PresentBegin = 1,
+        /// Returning from the call presenting a frame (args: frame index, repeat index, SyncApiStatus).
+        PresentEnd = 2,
+        /// ISyncApi::JoinSwapGroup called (args: group, blocking, SyncApiStatus).
+        JoinSwapGroup = 3,
+        /// ISyncApi::BindSwapBarrier called (args: group, barrier, SyncApiStatus).
+        BindSwapBarrier = 4,
+        /// BarrierWarmupState changed (args: state).
+        WarmupState = 5,
+        /// BarrierWarmupStage changed (args: stage, is emitter, additional presents for the emitter or completed for
+        /// a repeater).
+        WarmupStage = 6,
+        /// BarrierWarmupAction decided after a present (args: action, repeat index).
+        WarmupAction = 7,
+        /// Unity graphics device event received (args: UnityGfxDeviceEventType).
+        DeviceEvent = 8,
+        /// Render event received (args: EQuadroSyncRenderEvent, data).
+        RenderEvent = 9,
+    };
+
+    /// Name of an event and of its arguments (nullptr for the unused ones), used to decode trace files.
+    struct EventTraceDescription
+    {
+        const char* name;
+        const char* argumentNames[3];
+    };
+
+    /**
+     * Returns the description of an event (nullptr if the event is unknown, for example when decoding a file written
+     * by a newer version).
+     */
+    const EventTraceDescription* GetEventTraceDescription(uint16_t eventId);
+
+    /**
+     * \brief Event recorded by EventTrace.
+     *
+     * \remark Any change to this struct must increment EventTraceHeader::k_Version.
+     */
+    struct EventTraceRecord
+    {
+        /// Index of the record (since the trace was started) + 1, 0 while the record is being written (or was never
+        /// written).  Stored last so that readers can detect records that were not completely written.
+        std::atomic<uint64_t> sequence;
+        /// Performance counter tick of the event.
+        uint64_t tick;
+        /// Identifier of the thread recording the event.
+        uint32_t threadId;
+        /// EventTraceId
+        uint16_t eventId;
+        uint16_t reserved;
+        /// Arguments (meaning depends on eventId).
+        int64_t args[3];
+    };
+    static_assert(sizeof(EventTraceRecord) == 48, "Unexpected EventTraceRecord size");
+
+    /**
+     * \brief Header at the beginning of a trace file (followed by recordCount EventTraceRecord).
+     */
+    struct EventTraceHeader
+    {
+        static constexpr uint32_t k_Magic = 0x54455147; // "GQET"
+        static constexpr uint32_t k_Version = 1;
+
+        uint32_t magic;
+        uint32_t version;
+        uint32_t headerSize;
+        uint32_t recordSize;
+        uint32_t recordCount;
+        /// Identifier of the process writing the trace.
+        uint32_t processId;
+        /// Frequency of the performance counter used for the ticks of the records.
+        uint64_t performanceCounterFrequency;
+        /// Performance counter tick when the trace was started.
+        uint64_t startTick;
+        /// Number of records written since the trace was started (the next record will be written at index
+        /// writeIndex % recordCount).
+        std::atomic<uint64_t> writeIndex;
+        uint64_t reserved[2];
+    };
+    static_assert(sizeof(EventTraceHeader) == 64, "Unexpected EventTraceHeader size");
+
+    /**
+     * \brief Records the events of the plugin in a fixed size ring of EventTraceRecord mapped to a file.
+     *
+     * Recording an event is a relaxed atomic increment to reserve a record and a few stores in the mapped memory (no
+     * lock and no system call), so it can be done from any thread, including while presenting.  Once the ring is full
+     * the oldest records are overwritten, so the file always contains the last recordCount events (and survives a
+     * crash of the process).  Files are converted to text or Chrome trace JSON by EventTraceDecoder.
+     *
+     * \remark Write does nothing (beyond loading an atomic) while the trace is not started.
+     */
+    class EventTrace final
+    {
+    public:
+        static constexpr uint32_t k_DefaultRecordCount = 65536;
+
+        static EventTrace& Instance()
+        {
+            static EventTrace staticInstance;
+            return staticInstance;
+        }
+
+        /**
+         * Create the trace file and start recording events in it.
+         *
+         * \param[in] path Path of the trace file (replaced if it already exists).
+         * \param[in] recordCount Number of records in the ring (rounded up to a power of 2).
+         *
+         * \return Was the trace started?  (false if the file cannot be created or if a trace was already started)
+         *
+         * \remark A process can only record a single trace: the file stays mapped until the process ends since other
+         *         threads might still be recording events in it.
+         */
+        bool Start(const std::string& path, uint32_t recordCount = k_DefaultRecordCount);
+
+        /**
+         * Stop recording events and ask the system to write the file to disk.
+         */
+        void Stop();
+
+        bool IsEnabled() const { return m_Enabled.load(std::memory_order_relaxed); }
+
+        /// Returns the header of the ring (nullptr if never started).
+        const EventTraceHeader* GetHeader() const { return m_Header; }
+
+        /// Record an event that happens now.
+        void Write(const EventTraceId eventId, const int64_t arg0 = 0, const int64_t arg1 = 0, const int64_t arg2 = 0)
+        {
+            if (m_Enabled.load(std::memory_order_acquire))
+            {
+                WriteRecord(GetCurrentPerformanceCounterTick(), eventId, arg0, arg1, arg2);
+            }
+        }
+
+        /// Record an event that happened at tick (to reuse a tick that was already fetched).
+        void WriteAt(const uint64_t tick, const EventTraceId eventId, const int64_t arg0 = 0, const int64_t arg1 = 0,
+            const int64_t arg2 = 0)
+        {
+            if (m_Enabled.load(std::memory_order_acquire))
+            {
+                WriteRecord(tick, eventId, arg0, arg1, arg2);
+            }
+        }
+
+        EventTrace(const EventTrace&) = delete;
+        EventTrace& operator=(const EventTrace&) = delete;
+
+    private:
+        EventTrace() = default;
+
+        void WriteRecord(uint64_t tick, EventTraceId eventId, int64_t arg0, int64_t arg1, int64_t arg2);
+
+        std::mutex m_StartLock;
+        MappedFile m_File;
+        EventTraceHeader* m_Header = nullptr;
+        EventTraceRecord* m_Records = nullptr;
+        uint64_t m_RecordIndexMask = 0;
+        std::atomic<bool> m_Enabled = false;
+    };
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Keeps track of the Quadro Sync frame counter without querying the hardware on every frame.
+     *
+     * Querying the hardware frame counter (NvAPI_D3D1x_QueryFrameCount) is heavy.  So this class only asks for it to be
+     * queried a few times to measure the refresh period and then once in a while (throttled).  In between it
+     * extrapolates the frame count from the performance counter and the measured refresh period.  Every new hardware
+     * query corrects any drift and the difference between what was extrapolated and what the hardware returned is
+     * kept as a statistic.
+     *
+     * \remark The class never reads the time or the hardware by itself, the caller is responsible to provide them.  This
+     *         makes it possible to drive it with a simulated counter.
+     * \remark Not thread safe, except for the statistics getters that can be called from any thread.
+     */
+    class FrameCounter final
+    {
+    public:
+        /// Number of hardware queries done without any throttling (to measure the refresh period).
+        static constexpr uint64_t NBR_CAN_GET_FRAME_COUNT_BEFORE_THROTTLE = 60; // This is one second at 60 fps...
+        /// Delay between hardware queries once we are throttled.
+        static constexpr uint64_t NBR_SECONDS_BETWEEN_CAN_GET_FRAME_COUNT = 1;  // Let's check every second once we are throttled...
+
+        /**
+         * Constructor
+         *
+         * \param[in] ticksPerSecond Frequency of the performance counter used for all the timestamps we receive.
+         */
+        explicit FrameCounter(uint64_t ticksPerSecond);
+
+        /**
+         * Forget everything we know about the hardware frame count (to be called when it is reset).
+         *
+         * \remark Measured refresh period is kept since it has nothing to do with the frame counter value.
+         */
+        void Invalidate();
+
+        /**
+         * Returns if the caller should query the hardware frame count and report it with OnHardwareFrameCount before
+         * calling GetFrameCount.
+         *
+         * \param[in] nowTick Current performance counter tick.
+         */
+        bool IsHardwareQueryDue(uint64_t nowTick) const;
+
+        /**
+         * Reports a value freshly read from the hardware frame counter.
+         *
+         * \param[in] nowTick Performance counter tick at which the hardware frame counter was read.
+         * \param[in] hardwareFrameCount Frame count read from the hardware.
+         */
+        void OnHardwareFrameCount(uint64_t nowTick, uint32_t hardwareFrameCount);
+
+        /**
+         * Reports that querying the hardware frame counter failed (so that we do not try again before
+         * NBR_SECONDS_BETWEEN_CAN_GET_FRAME_COUNT, even while still measuring the refresh period).
+         *
+         * \param[in] nowTick Performance counter tick at which the hardware frame counter query was attempted.
+         */
+        void OnHardwareQueryFailed(uint64_t nowTick);
+
+        /**
+         * Returns the frame count, extrapolated from the last hardware frame count if needed.
+         *
+         * \param[in] nowTick Current performance counter tick.
+         *
+         * \remark Returned value never goes backward (unless Invalidate is called).
+         */
+        uint32_t GetFrameCount(uint64_t nowTick);
+
+        /// Number of times the hardware frame counter has been queried.
+        uint64_t GetHardwareQueryCount() const { return m_HardwareQueryCount.load(std::memory_order_relaxed); }
+        /// Number of frame counts that were extrapolated (as opposed as directly coming from the hardware).
+        uint64_t GetExtrapolatedCount() const { return m_ExtrapolatedCount.load(std::memory_order_relaxed); }
+        /// Difference (hardware - extrapolated) measured on the last hardware query done after being throttled.
+        int32_t GetLastExtrapolationError() const { return m_LastExtrapolationError.load(std::memory_order_relaxed); }
+        /// Largest absolute difference between hardware and extrapolated frame count since construction.
+        uint32_t GetMaxExtrapolationError() const { return m_MaxExtrapolationError.load(std::memory_order_relaxed); }
+        /// Measured refresh period (in ticks), 0 if not yet measured.
+        double GetRefreshPeriodTicks() const { return m_RefreshPeriodTicks.load(std::memory_order_relaxed); }
+
+    private:
+        uint32_t Extrapolate(uint64_t nowTick) const;
+
+        const uint64_t m_TicksPerSecond;
+
+        bool m_HasHardwareAnchor = false;
+        uint64_t m_AnchorTick = 0;
+        uint32_t m_AnchorFrameCount = 0;
+        /// Hardware frame count from which the refresh period is measured (first anchor after Invalidate or after the
+        /// refresh rate changed).
+        uint64_t m_PeriodOriginTick = 0;
+        uint32_t m_PeriodOriginFrameCount = 0;
+        uint64_t m_NextHardwareQueryTick = 0;
+        /// No hardware query before this tick (set when a query fails, 0 otherwise).
+        uint64_t m_RetryHardwareQueryTick = 0;
+        uint64_t m_UnthrottledQueryCount = 0;
+        uint32_t m_LastReturnedFrameCount = 0;
+
+        // Remarks: Atomic since they can be read from the game loop thread for reporting (no need for correlation).
+        std::atomic<double> m_RefreshPeriodTicks = 0.0;
+        std::atomic<uint64_t> m_HardwareQueryCount = 0;
+        std::atomic<uint64_t> m_ExtrapolatedCount = 0;
+        std::atomic<int32_t> m_LastExtrapolationError = 0;
+        std::atomic<uint32_t> m_MaxExtrapolationError = 0;
+    };
+}
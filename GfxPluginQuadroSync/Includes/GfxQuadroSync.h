@@ -15,7 +15,11 @@ namespace GfxQuadroSync {
         QuadroSyncEnableSwapGroup,
         QuadroSyncEnableSwapBarrier,
         QuadroSyncEnableSyncCounter,
-        QuadroSyncSkipSyncForNextFrame
+        QuadroSyncSkipSyncForNextFrame,
+        QuadroSyncEnableFrameHold,
+        QuadroSyncHoldFrame,
+        QuadroSyncEnableAsyncPresent,
+        QuadroSyncWaitForPresent
     };
 
     ///////////////////////////////////////////////////////////////////////////////
@@ -24,13 +28,14 @@ namespace GfxQuadroSync {
     //
     //! DESCRIPTION:   Overrided callbacks to handle the Device related events.
     //!
-    //! WHEN TO USE:   Automatically called and used when the system is initialized or destroyed.
+    //! WHEN TO USE:   Automatically called and used when the system is initialized or destroyed, and
+    //!                around the reset of the device (the context is then validated again).
     //!
-    //  SUPPORTED GFX: D3D11 & D3D12
+    //  SUPPORTED GFX: D3D11, D3D12 & Vulkan
     //!
     //! \param [in]    eventType      Either specify that the Device has been initialized or destroyed.
     ///////////////////////////////////////////////////////////////////////////////
-    static void UNITY_INTERFACE_API OnGraphicsDeviceEvent(UnityGfxDeviceEventType eventType);
+    void UNITY_INTERFACE_API OnGraphicsDeviceEvent(UnityGfxDeviceEventType eventType);
 
 
 
@@ -42,12 +47,12 @@ namespace GfxQuadroSync {
     //!
     //! WHEN TO USE:   Called from C# to use a specific Quadro Sync functionality.
     //!
-    //  SUPPORTED GFX: D3D11 & D3D12
+    //  SUPPORTED GFX: D3D11, D3D12 & Vulkan
     //!
     //! \param [in]    eventID      EQuadroSyncRenderEvent corresponding to the event.
     //! \param [in]    data         Buffer containing the data related to the event.
     ///////////////////////////////////////////////////////////////////////////////
-    static void UNITY_INTERFACE_API OnRenderEvent(int eventID, void* data);
+    void UNITY_INTERFACE_API OnRenderEvent(int eventID, void* data);
 
 
 
@@ -55,11 +60,12 @@ namespace GfxQuadroSync {
     //
     // FUNCTION NAME:  IsContextValid
     //
-    //! DESCRIPTION:   Verify if the D3D11 Device and the SwapChain are correct.
+    //! DESCRIPTION:   Verify if the D3D11 Device and the SwapChain are correct.  They are only validated
+    //!                again after being invalidated by a device event (reset or shutdown).
     //!
     //! WHEN TO USE:   Use it internally, before calling any other functions related to NvAPI.
     //!
-    //  SUPPORTED GFX: D3D11 & D3D12
+    //  SUPPORTED GFX: D3D11, D3D12 & Vulkan
     //!
     //! \retval ::true          The context is valid (D3D11 Device and the SwapChain)
     //! \retval ::false         The context is invalid (either the D3D11 Device or/and the SwapChain)
@@ -68,6 +74,36 @@ namespace GfxQuadroSync {
 
 
 
+    ///////////////////////////////////////////////////////////////////////////////
+    //
+    // FUNCTION NAME:  SetDevice
+    //
+    //! DESCRIPTION:   Give the Device of Unity to the graphics device.
+    //!
+    //! WHEN TO USE:   Use it internally, when the Device is missing or after a device reset.
+    //!
+    //  SUPPORTED GFX: D3D11 & D3D12
+    //!
+    ///////////////////////////////////////////////////////////////////////////////
+    void SetDevice();
+
+
+
+    ///////////////////////////////////////////////////////////////////////////////
+    //
+    // FUNCTION NAME:  SetSwapChain
+    //
+    //! DESCRIPTION:   Give the SwapChain of Unity to the graphics device.
+    //!
+    //! WHEN TO USE:   Use it internally, when the SwapChain is missing or after a device reset.
+    //!
+    //  SUPPORTED GFX: D3D11, D3D12 & Vulkan
+    //!
+    ///////////////////////////////////////////////////////////////////////////////
+    void SetSwapChain();
+
+
+
     ///////////////////////////////////////////////////////////////////////////////
     //
     // FUNCTION NAME:  QuadroSyncQueryFrameCount
@@ -78,7 +114,7 @@ namespace GfxQuadroSync {
     //! WHEN TO USE:   After the system has been initialized, use it in runtime to
     //                 retrieve the actual frame count.
     //!
-    //  SUPPORTED GFX: D3D11 & D3D12
+    //  SUPPORTED GFX: D3D11, D3D12 & Vulkan
     //!
     //! \param [in]    value      Storage that will contain the frame count.
     ///////////////////////////////////////////////////////////////////////////////
@@ -95,7 +131,7 @@ namespace GfxQuadroSync {
     //!
     //! WHEN TO USE:   After the system has been initialized, use it in runtime as a toggle.
     //!
-    //  SUPPORTED GFX: D3D11 & D3D12
+    //  SUPPORTED GFX: D3D11, D3D12 & Vulkan
     //!
     ///////////////////////////////////////////////////////////////////////////////
     void QuadroSyncResetFrameCount();
@@ -111,7 +147,7 @@ namespace GfxQuadroSync {
     //!
     //! WHEN TO USE:   At the start of the program, after NvAPI_Initialize function.
     //!
-    //  SUPPORTED GFX: D3D11 & D3D12
+    //  SUPPORTED GFX: D3D11, D3D12 & Vulkan
     //!
     ///////////////////////////////////////////////////////////////////////////////
     void QuadroSyncInitialize();
@@ -127,7 +163,7 @@ namespace GfxQuadroSync {
     //!
     //! WHEN TO USE:   At the end of the program.
     //!
-    //  SUPPORTED GFX: D3D11 & D3D12
+    //  SUPPORTED GFX: D3D11, D3D12 & Vulkan
     //!
     ///////////////////////////////////////////////////////////////////////////////
     void QuadroSyncDispose();
@@ -142,7 +178,7 @@ namespace GfxQuadroSync {
     //!
     //! WHEN TO USE:   After the system has been initialized, use it in runtime as a toggle.
     //!
-    //  SUPPORTED GFX: D3D11 & D3D12
+    //  SUPPORTED GFX: D3D11, D3D12 & Vulkan
     //!
     //! \param [in]    value      Value that corresponds to the activation or not.
     ///////////////////////////////////////////////////////////////////////////////
@@ -158,7 +194,7 @@ namespace GfxQuadroSync {
     //!
     //! WHEN TO USE:   After the system has been initialized, use it in runtime as a toggle.
     //!
-    //  SUPPORTED GFX: D3D11 & D3D12
+    //  SUPPORTED GFX: D3D11, D3D12 & Vulkan
     //!
     //! \param [in]    value      Value that corresponds to the activation or not.
     //
@@ -175,7 +211,7 @@ namespace GfxQuadroSync {
     //!
     //! WHEN TO USE:   After the system has been initialized, use it in runtime as a toggle.
     //!
-    //  SUPPORTED GFX: D3D11 & D3D12
+    //  SUPPORTED GFX: D3D11, D3D12 & Vulkan
     //!
     //! \param [in]    value      Value that corresponds to the activation or not.
     //
@@ -192,7 +228,7 @@ namespace GfxQuadroSync {
     //!
     //! WHEN TO USE:   After the system has been initialized, use it in runtime as a toggle.
     //!
-    //  SUPPORTED GFX: D3D11 & D3D12
+    //  SUPPORTED GFX: D3D11, D3D12 & Vulkan
     //!
     //! \param [in]    value      Value that corresponds to the activation or not.
     //
@@ -211,9 +247,82 @@ namespace GfxQuadroSync {
     //!                presented without waiting for the other nodes synchronized
     //!                with this node.
     //!
-    //  SUPPORTED GFX: D3D11 & D3D12
+    //  SUPPORTED GFX: D3D11, D3D12 & Vulkan
     //!
     ///////////////////////////////////////////////////////////////////////////////
     void QuadroSyncSkipSyncForNextFrame();
 
+    ///////////////////////////////////////////////////////////////////////////////
+    //
+    // FUNCTION NAME:  QuadroSyncEnableFrameHold
+    //
+    //! DESCRIPTION:   Enable or disable saving every frame before presenting it
+    //!                so that it can be presented again by QuadroSyncHoldFrame.
+    //!
+    //! WHEN TO USE:   After the system has been initialized, on nodes that might
+    //!                receive the data of their frames late (repeaters).
+    //!
+    //  SUPPORTED GFX: D3D11 & D3D12
+    //!
+    //! \param [in]    value      Value that corresponds to the activation or not.
+    //
+    ///////////////////////////////////////////////////////////////////////////////
+    void QuadroSyncEnableFrameHold(bool value);
+
+    ///////////////////////////////////////////////////////////////////////////////
+    //
+    // FUNCTION NAME:  QuadroSyncHoldFrame
+    //
+    //! DESCRIPTION:   Present the last frame again using the Nvidia synchronized
+    //!                present call.
+    //!
+    //! WHEN TO USE:   When the next frame is not ready by its deadline (for
+    //!                example its data was lost by the network), so that the
+    //!                other nodes keep presenting at the refresh rate instead of
+    //!                waiting on this node.  Can be used multiple times in a row.
+    //!
+    //  SUPPORTED GFX: D3D11 & D3D12
+    //!
+    ///////////////////////////////////////////////////////////////////////////////
+    void QuadroSyncHoldFrame();
+
+    ///////////////////////////////////////////////////////////////////////////////
+    //
+    // FUNCTION NAME:  QuadroSyncEnableAsyncPresent
+    //
+    //! DESCRIPTION:   Present (and wait on the swap barrier) from a native
+    //!                worker thread so that the rendering thread can work on
+    //!                the next frame instead of blocking until the whole
+    //!                cluster reached the barrier.  Presents then wait for
+    //!                the back buffer rendered to next to be presented
+    //!                (never more frames in flight than back buffers - 1).
+    //!
+    //! WHEN TO USE:   After the system has been initialized, for content
+    //!                whose render thread is busy while the GPU is not.
+    //!
+    //  SUPPORTED GFX: D3D12
+    //!
+    //! \param [in]    maxInFlightFrames   Number of frames that can be waiting
+    //!                                    to be presented, 0 to present from
+    //!                                    the rendering thread again.
+    //
+    ///////////////////////////////////////////////////////////////////////////////
+    void QuadroSyncEnableAsyncPresent(uint32_t maxInFlightFrames);
+
+    ///////////////////////////////////////////////////////////////////////////////
+    //
+    // FUNCTION NAME:  QuadroSyncWaitForPresent
+    //
+    //! DESCRIPTION:   Wait for every frame handed to the present worker thread
+    //!                to be presented.
+    //!
+    //! WHEN TO USE:   When QuadroSyncEnableAsyncPresent is used, before
+    //!                using something the frames in flight still use (the
+    //!                back buffer rendered to next is already waited for).
+    //!
+    //  SUPPORTED GFX: D3D12
+    //!
+    ///////////////////////////////////////////////////////////////////////////////
+    void QuadroSyncWaitForPresent();
+
 }
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "ISyncApi.h"
+
+// Remarks: Same declaration as Xlib (see OpenGLGraphicsDevice.h).
+typedef struct _XDisplay Display;
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief ISyncApi forwarding to GLX_NV_swap_group (Quadro Sync hardware with OpenGL on Linux).
+     *
+     * Expects the Display and GLXDrawable of OpenGLGraphicsDevice (GetDevice and GetSwapChain) as the device and swap
+     * chain.  The driver synchronizes the glXSwapBuffers of the drawables of the swap group bound to the barrier, so
+     * Present simply presents.
+     *
+     * \remark Not every driver exposes the extension (Mesa does not), use IsSupported to decide between this and
+     *         SoftwareSyncApi.
+     */
+    class GlxSwapGroupSyncApi final : public ISyncApi
+    {
+    public:
+        /**
+         * \param[in] screen Screen of the drawables (used by the per screen functions like QueryFrameCount).
+         */
+        explicit GlxSwapGroupSyncApi(int screen);
+
+        /// Does the GLX implementation of the display support GLX_NV_swap_group?
+        static bool IsSupported(Display* display, int screen);
+
+        const char* GetName() const override { return "GLX_NV_swap_group"; }
+
+        SyncApiStatus Initialize() override;
+        SyncApiStatus SetupWorkstationSwapGroupFeature(bool) override { return SyncApiStatus::Ok; }
+
+        SyncApiStatus QueryMaxSwapGroup(IUnknown* pDevice, uint32_t& maxGroups, uint32_t& maxBarriers) override;
+        SyncApiStatus JoinSwapGroup(IUnknown* pDevice, IDXGISwapChain* pSwapChain, uint32_t group,
+            bool blocking) override;
+        SyncApiStatus BindSwapBarrier(IUnknown* pDevice, uint32_t group, uint32_t barrier) override;
+        SyncApiStatus QuerySwapGroup(IUnknown* pDevice, IDXGISwapChain* pSwapChain, uint32_t& group,
+            uint32_t& barrier) override;
+        SyncApiStatus QueryFrameCount(IUnknown* pDevice, uint32_t& frameCount) override;
+        SyncApiStatus ResetFrameCount(IUnknown* pDevice) override;
+        SyncApiStatus Present(IGraphicsDevice& graphicsDevice) override;
+
+    private:
+        /// GLX_NV_swap_group functions (fetched through glXGetProcAddress by Initialize).
+        struct Functions
+        {
+            int (*glXJoinSwapGroupNV)(Display* display, unsigned long drawable, unsigned int group) = nullptr;
+            int (*glXBindSwapBarrierNV)(Display* display, unsigned int group, unsigned int barrier) = nullptr;
+            int (*glXQuerySwapGroupNV)(Display* display, unsigned long drawable, unsigned int* group,
+                unsigned int* barrier) = nullptr;
+            int (*glXQueryMaxSwapGroupsNV)(Display* display, int screen, unsigned int* maxGroups,
+                unsigned int* maxBarriers) = nullptr;
+            int (*glXQueryFrameCountNV)(Display* display, int screen, unsigned int* count) = nullptr;
+            int (*glXResetFrameCountNV)(Display* display, int screen) = nullptr;
+        };
+
+        int m_Screen;
+        Functions m_Functions;
+        bool m_Initialized = false;
+    };
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "SharedMemory.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Barrier between the processes (instances) running on the same computer, through shared memory.
+     *
+     * Instance 0 is the representative of the computer: it waits for every other instance to arrive, does whatever
+     * has to be done before releasing them (like taking part in the barrier with the other computers of the cluster)
+     * and then releases them.  Waits are done on a futex (process shared) on Linux and on a named event per instance
+     * on Windows (WaitOnAddress only works within a process), so that instances are released within microseconds.
+     * Other platforms simply poll.
+     *
+     * \remark Instances that do not arrive before the timeout are no longer waited on by the representative until they
+     *         arrive again and instances give up waiting on the representative after the timeout (so that a dead
+     *         instance does not block the others).
+     */
+    class HostBarrier final
+    {
+    public:
+        /// Maximum number of instances sharing the barrier.
+        static constexpr uint32_t k_MaxInstances = 16;
+
+        HostBarrier() = default;
+        ~HostBarrier();
+
+        /**
+         * Create or open the shared memory of the barrier.
+         *
+         * \param[in] name Name of the barrier (every instance of the computer must use the same name).
+         * \param[in] instanceCount Number of instances sharing the barrier.
+         * \param[in] instanceIndex Index of this instance (0 for the representative).
+         *
+         * \return Success?
+         */
+        bool Open(const std::string& name, uint32_t instanceCount, uint32_t instanceIndex);
+
+        bool IsOpen() const { return m_Segment != nullptr; }
+        bool IsRepresentative() const { return m_InstanceIndex == 0; }
+
+        /**
+         * Wait (representative only) for every other instance to arrive at the barrier.
+         *
+         * \return Did every instance arrive (false if some timed out)?
+         */
+        bool WaitForOtherInstances(std::chrono::microseconds timeout);
+
+        /**
+         * Release (representative only) every instance waiting on the barrier.
+         *
+         * \param[in] generation Generation of the barrier released (read by the other instances).
+         */
+        void Release(uint64_t generation);
+
+        /**
+         * Arrive at the barrier and wait for the representative to release it (every instance but the representative).
+         *
+         * \param[out] generation Generation given to Release by the representative.
+         * \param[out] releaseLatency Time between the call to Release and this instance waking up (only meaningful if
+         *             the barrier was released).
+         *
+         * \return Was the barrier released (false if we timed out)?
+         */
+        bool ArriveAndWait(std::chrono::microseconds timeout, uint64_t& generation,
+            std::chrono::nanoseconds& releaseLatency);
+
+        HostBarrier(const HostBarrier&) = delete;
+        HostBarrier& operator=(const HostBarrier&) = delete;
+
+    private:
+        struct Segment;
+        typedef std::chrono::steady_clock Clock;
+
+        template <typename Predicate>
+        bool WaitFor(Predicate predicate, Clock::time_point deadline);
+        void Wake(uint32_t instanceIndex);
+        void CloseEvents();
+
+        SharedMemory m_SharedMemory;
+        Segment* m_Segment = nullptr;
+        uint32_t m_InstanceCount = 0;
+        uint32_t m_InstanceIndex = 0;
+        /// Instances the representative waits on (bit per instance).
+        uint32_t m_ActiveInstances = 0;
+#ifdef _WIN32
+        /// Auto-reset event of every instance signaled to wake it up.
+        void* m_Events[k_MaxInstances] = {};
+#endif
+    };
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Interface to an unreliable datagram transport reaching every node of the cluster (like UDP multicast).
+     *
+     * \remark Exists so that protocols running between nodes (like BarrierWarmup) can run on a simulated network.
+     */
+    class IDatagramTransport
+    {
+    public:
+        IDatagramTransport() {}
+        virtual ~IDatagramTransport() {}
+
+        /**
+         * Send a datagram to every other node (and possibly to ourselves).
+         *
+         * \return Was the datagram sent (which does not mean it will be received)?
+         */
+        virtual bool Send(const void* data, size_t size) = 0;
+
+        /**
+         * Send a datagram meant for a single node.
+         *
+         * \param[in] nodeId Node the datagram is meant for.
+         *
+         * \return Was the datagram sent (which does not mean it will be received)?
+         *
+         * \remark Transports that cannot address a single node send it to every node (so receivers must still ignore
+         *         datagrams that are not meant for them).
+         */
+        virtual bool SendTo(uint8_t nodeId, const void* data, size_t size)
+        {
+            (void)nodeId;
+            return Send(data, size);
+        }
+
+        /**
+         * Receive the next datagram.
+         *
+         * \param[out] buffer Receives the datagram.
+         * \param[in] size Size of buffer (larger datagrams are truncated).
+         * \param[in] timeout Maximum amount of time to wait for a datagram.
+         *
+         * \return Size of the received datagram, 0 if nothing was received before the timeout or -1 on error.
+         */
+        virtual int Receive(void* buffer, size_t size, std::chrono::microseconds timeout) = 0;
+    };
+}
@@ -1,7 +1,11 @@
 #pragma once
 
+#include "PlatformTypes.h"
+
 namespace GfxQuadroSync
 {
+    class SavedFrameCache;
+
     enum class GraphicsDeviceType
     {
         GRAPHICS_DEVICE_D3D11 = 0,
@@ -9,6 +13,7 @@ namespace GfxQuadroSync
         GRAPHICS_DEVICE_OPENGL,
         GRAPHICS_DEVICE_METAL,
         GRAPHICS_DEVICE_VULKAN,
+        GRAPHICS_DEVICE_NULL,
     };
 
     class IGraphicsDevice
@@ -27,6 +32,14 @@ namespace GfxQuadroSync
         virtual void SetDevice(IUnknown* const device) = 0;
         virtual void SetSwapChain(IDXGISwapChain* const swapChain) = 0;
 
+        /**
+         * Present the back buffer of the swap chain without any synchronization with other nodes (used by the ISyncApi
+         * implementations that do not rely on NvAPI).
+         *
+         * \return Success?
+         */
+        virtual bool Present() = 0;
+
         /**
          * Called before starting a sequence of "additional present" required to warm up the quadro sync barrier.
          */
@@ -39,5 +52,54 @@ namespace GfxQuadroSync
          * Called after the sequence of "additional present" required to warm up the quadro sync barrier.
          */
         virtual void ConcludePresentRepeats() = 0;
+
+        /**
+         * Resources kept from one sequence of "additional present" to the next (nullptr if the device allocates them
+         * every time).
+         */
+        virtual const SavedFrameCache* GetSavedFrameCache() const { return nullptr; }
+
+        /**
+         * Save the back buffer about to be presented so that it can be presented again by PrepareHeldFramePresent
+         * (called before the present of every frame while frame hold is enabled).
+         */
+        virtual void SaveFrameToHold() { }
+        /**
+         * Copy the frame saved by SaveFrameToHold to the current back buffer so that it is presented again.
+         *
+         * \return Is there a frame to present?  (false if no frame was saved or the device cannot hold frames)
+         */
+        virtual bool PrepareHeldFramePresent() { return false; }
+        /**
+         * Number of presents of the held frame still needed before the next frame of Unity can be presented (for swap
+         * chains that must be back to the back buffer Unity rendered to).
+         */
+        virtual uint32_t GetPendingHeldFramePresentCount() const { return 0; }
+        /**
+         * Forget about the frame saved by SaveFrameToHold (frame hold disabled).
+         */
+        virtual void ReleaseHeldFrame() { }
+
+        /**
+         * Number of buffers of the swap chain (0 if unknown), the present worker never has more than this minus one
+         * frame in flight.
+         */
+        virtual uint32_t GetBackBufferCount() const { return 0; }
+        /**
+         * Called by the rendering thread when handing the current back buffer to the present worker.
+         *
+         * \return Index of that back buffer, to be given to OnAsyncPresentDone once it is presented.
+         */
+        virtual uint32_t OnAsyncPresentQueued() { return 0; }
+        /**
+         * Called by the present worker after presenting (successfully or not) the back buffer returned by
+         * OnAsyncPresentQueued.
+         */
+        virtual void OnAsyncPresentDone(uint32_t) { }
+        /**
+         * Called by the rendering thread before returning to Unity after handing a back buffer to the present worker,
+         * waits for every present of the back buffer Unity renders to next to be done.
+         */
+        virtual void WaitForNextBackBuffer() { }
     };
 }
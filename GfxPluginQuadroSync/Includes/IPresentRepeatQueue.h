@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Interface to the GPU queue executing the commands that copy the frame to repeat to a back buffer.
+     *
+     * \remark Exists so that PresentRepeatScheduler can be run against a mock queue (the commands of every back buffer
+     *         are recorded once by the IGraphicsDevice and only executed again afterwards).
+     */
+    class IPresentRepeatQueue
+    {
+    public:
+        IPresentRepeatQueue() {}
+        virtual ~IPresentRepeatQueue() {}
+
+        /**
+         * Execute the commands copying the frame to repeat to a back buffer and signal a fence once they are done.
+         *
+         * \param[in] backBufferIndex Index of the back buffer to copy the frame to.
+         * \param[in] fenceValue Value the fence is to be signaled with once done (always larger than the previous).
+         *
+         * \return Were the commands executed and the fence signaled?
+         */
+        virtual bool ExecuteRepeat(uint32_t backBufferIndex, uint64_t fenceValue) = 0;
+
+        /// Last value the fence was signaled with.
+        virtual uint64_t GetCompletedFenceValue() = 0;
+
+        /// Block the calling thread until the fence is signaled with fenceValue (or a larger value).
+        virtual void WaitForFenceValue(uint64_t fenceValue) = 0;
+    };
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "PlatformTypes.h"
+
+#include <cstdint>
+#include <ostream>
+
+namespace GfxQuadroSync
+{
+    class IGraphicsDevice;
+
+    /**
+     * \brief Status returned by the ISyncApi methods.
+     *
+     * \remark Values are the same as the matching NvAPI_Status so that NvApiSyncApi can simply cast them (and any other
+     *         NvAPI_Status value can also be carried).
+     */
+    enum class SyncApiStatus : int32_t
+    {
+        Ok = 0,
+        Error = -1,
+        LibraryNotFound = -2,
+        NoImplementation = -3,
+        ApiNotInitialized = -4,
+        InvalidArgument = -5,
+        NvidiaDeviceNotFound = -6,
+        InvalidHandle = -8,
+        NotSupported = -104,
+        DeviceBusy = -108,
+        InvalidCall = -134,
+    };
+
+    /**
+     * operator<< for SyncApiStatus that will write it to the stream as a string and a number.  Ideal to conclude a
+     * message about a call to ISyncApi that failed.
+     */
+    std::ostream& operator<<(std::ostream& os, SyncApiStatus status);
+
+    /**
+     * \brief Interface to the swap group and swap barrier functionalities used by PluginCSwapGroupClient.
+     *
+     * Methods map one to one to the NvAPI functions we used to call directly (see NvApiSyncApi) so that other
+     * implementations (like SimulatedSyncApi) can be used to run PluginCSwapGroupClient without Quadro Sync hardware.
+     *
+     * \remark All methods are called from the rendering thread, except Present that is called from the present worker
+     *         thread when presents are asynchronous (see PluginCSwapGroupClient::EnableAsyncPresent).  Calls are never
+     *         concurrent (PluginCSwapGroupClient waits for pending presents before any other call), so implementations
+     *         do not have to be thread safe.
+     */
+    class ISyncApi
+    {
+    public:
+        ISyncApi() {}
+        virtual ~ISyncApi() {}
+
+        /// Name of the implementation (for logging).
+        virtual const char* GetName() const = 0;
+
+        /// Prepare the api for use in this application.
+        virtual SyncApiStatus Initialize() = 0;
+
+        /// Register (or unregister) our request to use workstation SwapGroup resources on every GPU.
+        virtual SyncApiStatus SetupWorkstationSwapGroupFeature(bool enable) = 0;
+
+        virtual SyncApiStatus QueryMaxSwapGroup(IUnknown* pDevice, uint32_t& maxGroups, uint32_t& maxBarriers) = 0;
+        virtual SyncApiStatus JoinSwapGroup(IUnknown* pDevice, IDXGISwapChain* pSwapChain, uint32_t group,
+            bool blocking) = 0;
+        virtual SyncApiStatus BindSwapBarrier(IUnknown* pDevice, uint32_t group, uint32_t barrier) = 0;
+        virtual SyncApiStatus QuerySwapGroup(IUnknown* pDevice, IDXGISwapChain* pSwapChain, uint32_t& group,
+            uint32_t& barrier) = 0;
+        virtual SyncApiStatus QueryFrameCount(IUnknown* pDevice, uint32_t& frameCount) = 0;
+        virtual SyncApiStatus ResetFrameCount(IUnknown* pDevice) = 0;
+
+        /**
+         * Present the back buffer of the swap chain of the graphics device (synchronized with the other members of the
+         * swap group / barrier).
+         */
+        virtual SyncApiStatus Present(IGraphicsDevice& graphicsDevice) = 0;
+    };
+}
@@ -1,8 +1,14 @@
 #pragma once
 
-#include <sstream>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <thread>
 
-#include "../External/NvAPI/nvapi_lite_common.h"
 #include "../Unity/IUnityInterface.h"
 
 namespace GfxQuadroSync
@@ -20,11 +26,21 @@ namespace GfxQuadroSync
     /**
      * \brief Helper class performing work to process logs.
      *
+     * Messages are copied in a preallocated ring of records (lock free, for any number of threads logging at once) and
+     * delivered to the managed callback in batches by a background thread, so logging never blocks the thread logging
+     * (like the rendering thread in the middle of a present) on the managed code.  When the ring is full the message is
+     * dropped and counted instead of waiting, the number of messages dropped is then logged by the background thread.
+     *
      * \remark Sending actual log messages is done using the CLUSTER_LOG, CLUSTER_LOG_WARNING and CLUSTER_LOG_ERROR macros.
      */
     class Logger final
     {
     public:
+        /// Maximum length of a message (including the terminating null), longer messages are truncated.
+        static constexpr size_t k_MaxMessageLength = 512;
+        /// Number of messages the ring can hold waiting to be delivered (power of 2).
+        static constexpr size_t k_RecordCount = 256;
+
         /**
          * Returns access to the singleton responsible for log messages.
          *
@@ -39,27 +55,139 @@ namespace GfxQuadroSync
         /// Type of callback to managed function that receive the log messages
         typedef void(UNITY_INTERFACE_API* ManagedCallback)(int, const char*);
 
-        /// Sets the function to be called for every logging message we receive.
+        /**
+         * Sets the function to be called for every logging message we receive (nullptr to stop logging, delivering the
+         * messages not delivered yet to the previous callback first).
+         */
         void SetManagedCallback(ManagedCallback managedCallback);
 
         /// Returns if we need to spend time producing the message (because there is someone interested in them).
-        bool AreMessagesUseful() const { return m_ManagedCallback != nullptr; }
+        bool AreMessagesUseful() const { return m_ManagedCallback.load(std::memory_order_relaxed) != nullptr; }
+
+        /**
+         * Deliver messages from a background thread (default) or from the thread logging them (to debug crashes
+         * happening before the background thread had a chance to deliver the last messages).
+         */
+        void SetAsynchronous(bool value);
 
         /**
          * Method called by LoggingStream to send a logging message.
          *
          * \param[in] logType Type of log message.
-         * \param[in] message The actual log message text.
+         * \param[in] message The actual log message text (does not have to be null terminated).
+         * \param[in] length Length of message.
          */
-        void LogMessage(LogType logType, const std::string& message);
+        void LogMessage(LogType logType, const char* message, size_t length);
+
+        /// Wait for every message logged so far to be delivered.
+        void Flush();
+
+        /**
+         * Deliver the remaining messages and stop the background thread, messages are then delivered synchronously.
+         *
+         * \remark To be called before the plugin is unloaded (the thread cannot be joined while the library is being
+         *         unloaded).
+         */
+        void Shutdown();
+
+        /// Number of messages dropped because the ring was full.
+        uint64_t GetDroppedCount() const { return m_DroppedCount.load(std::memory_order_relaxed); }
+        /// Number of messages delivered to the managed callback.
+        uint64_t GetDeliveredCount() const { return m_DeliveredCount.load(std::memory_order_relaxed); }
 
     private:
+        /// One message of the ring.
+        struct Record
+        {
+            /// Position (in the sequence of messages) of the message the record is ready to receive (== position) or
+            /// contains (== position + 1).
+            std::atomic<uint64_t> sequence;
+            LogType logType;
+            char message[k_MaxMessageLength];
+        };
+
         // Private constructor and destructor to enforce singleton usage
-        Logger() = default;
-        ~Logger() = default;
+        Logger();
+        ~Logger();
+
+        void StartDrainThread();
+        void StopDrainThread();
+        void DrainThreadMain();
+        /// Deliver every message of the ring to the managed callback (only from one thread at a time).
+        void Drain();
 
         // Member variables
-        ManagedCallback m_ManagedCallback = nullptr;
+        std::atomic<ManagedCallback> m_ManagedCallback = nullptr;
+        std::atomic<bool> m_Asynchronous = true;
+
+        Record m_Records[k_RecordCount];
+        std::atomic<uint64_t> m_EnqueuePosition = 0;
+        /// Next message to deliver, only modified by the thread draining the ring.
+        std::atomic<uint64_t> m_DequeuePosition = 0;
+        std::atomic<uint64_t> m_DroppedCount = 0;
+        std::atomic<uint64_t> m_DeliveredCount = 0;
+        /// Value of m_DroppedCount the last time dropped messages were reported.
+        uint64_t m_ReportedDroppedCount = 0;
+
+        // Remarks: m_DrainLock is never taken by the threads logging, only to start and stop the drain thread and to
+        // make it sleep between batches.
+        std::mutex m_DrainLock;
+        std::condition_variable m_DrainChanged;
+        std::thread m_DrainThread;
+        bool m_StopDrainThread = false;
+        /// Serializes the threads delivering messages (drain thread, Flush, synchronous LogMessage, ...).
+        std::mutex m_DeliverLock;
+    };
+
+    /**
+     * Internal mechanic class, no need to manually use it.
+     *
+     * std::streambuf writing to a fixed size buffer (so that formatting messages does not allocate), whatever does not
+     * fit in it is dropped (and the message ends with "...").
+     */
+    class LoggingStreamBuffer final : public std::streambuf
+    {
+    public:
+        LoggingStreamBuffer() { setp(m_Buffer, m_Buffer + sizeof(m_Buffer)); }
+
+        const char* GetMessage() const { return pbase(); }
+        size_t GetLength() const { return static_cast<size_t>(pptr() - pbase()); }
+
+        /// Mark the message as truncated (if it was).
+        void Conclude()
+        {
+            if (m_Truncated)
+            {
+                for (size_t index = sizeof(m_Buffer) - 3; index < sizeof(m_Buffer); ++index)
+                {
+                    m_Buffer[index] = '.';
+                }
+            }
+        }
+
+    protected:
+        int_type overflow(const int_type character) override
+        {
+            m_Truncated = true;
+            return traits_type::not_eof(character);
+        }
+
+        std::streamsize xsputn(const char* const text, const std::streamsize count) override
+        {
+            const auto available = epptr() - pptr();
+            const auto copied = count < available ? count : available;
+            std::char_traits<char>::copy(pptr(), text, static_cast<size_t>(copied));
+            pbump(static_cast<int>(copied));
+            if (copied < count)
+            {
+                m_Truncated = true;
+            }
+            return count;
+        }
+
+    private:
+        char m_Buffer[Logger::k_MaxMessageLength - 1];
+        bool m_Truncated = false;
     };
 
     /**
@@ -67,29 +195,27 @@ namespace GfxQuadroSync
      *
      * \remark Used by CLUSTER_LOG, CLUSTER_LOG_WARNING and CLUSTER_LOG_ERROR macros.
      */
-    class LoggingStream final : public std::ostringstream
+    class LoggingStream final : public std::ostream
     {
     public:
         LoggingStream(LogType logType)
-            : m_LogType(logType)
+            : std::ostream(nullptr)
+            , m_LogType(logType)
         {
+            rdbuf(&m_Buffer);
             *this << "QuadroSync: ";
         }
 
         ~LoggingStream()
         {
-            Logger::Instance().LogMessage(m_LogType, str());
+            m_Buffer.Conclude();
+            Logger::Instance().LogMessage(m_LogType, m_Buffer.GetMessage(), m_Buffer.GetLength());
         }
 
     private:
         const LogType m_LogType;
+        LoggingStreamBuffer m_Buffer;
     };
-
-    /**
-     * operator<< for NvAPI_Status that will write it to the stream as a number and a string (string returned by
-     * NvAPI_GetErrorMessage).  Ideal to conclude a message about a call to NvAPI that failed.
-     */
-    std::ostream& operator<<(std::ostream& os, NvAPI_Status status);
 }
 
 /**
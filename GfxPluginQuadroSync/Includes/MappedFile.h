@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Helper class managing a file mapped in memory (so that what is written to the memory ends up in the file
+     * without any system call, even if the process crashes).
+     *
+     * Uses CreateFile / CreateFileMapping / MapViewOfFile on Windows and open / ftruncate / mmap elsewhere.
+     *
+     * \remark Designed to behave sort of like std::unique_ptr (cannot be copied, file is unmapped in the destructor).
+     */
+    class MappedFile final
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(MappedFile&& toMove) noexcept;
+        MappedFile& operator=(MappedFile&& toMove) noexcept;
+
+        /**
+         * Create the file (truncating it if it already exists) and map it in memory.
+         *
+         * \param[in] path Path of the file.
+         * \param[in] size Size of the file in bytes (content is initialized to 0).
+         *
+         * \return Was the file successfully created and mapped?
+         */
+        bool Create(const std::string& path, size_t size);
+
+        /**
+         * Ask the system to write the modified pages to the file now (they are written eventually anyway).
+         */
+        void Flush();
+
+        /**
+         * Unmap the file (that stays on disk).
+         */
+        void reset();
+
+        explicit operator bool() const noexcept { return m_Data != nullptr; }
+        void* get() const noexcept { return m_Data; }
+        size_t size() const noexcept { return m_Size; }
+        const std::string& path() const noexcept { return m_Path; }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+    private:
+        void* m_Data = nullptr;
+        size_t m_Size = 0;
+        std::string m_Path;
+#ifdef _WIN32
+        void* m_FileHandle = nullptr;
+        void* m_MappingHandle = nullptr;
+#endif
+    };
+}
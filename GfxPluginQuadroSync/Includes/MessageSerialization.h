@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+namespace GfxQuadroSync
+{
+    // Helpers to write and read the multi-byte values of the messages exchanged between nodes (always little endian,
+    // whatever the endianness of the nodes).
+
+    inline void WriteUInt32(uint8_t* const destination, const uint32_t value)
+    {
+        destination[0] = static_cast<uint8_t>(value);
+        destination[1] = static_cast<uint8_t>(value >> 8);
+        destination[2] = static_cast<uint8_t>(value >> 16);
+        destination[3] = static_cast<uint8_t>(value >> 24);
+    }
+
+    inline uint32_t ReadUInt32(const uint8_t* const source)
+    {
+        return static_cast<uint32_t>(source[0]) | (static_cast<uint32_t>(source[1]) << 8) |
+            (static_cast<uint32_t>(source[2]) << 16) | (static_cast<uint32_t>(source[3]) << 24);
+    }
+
+    inline void WriteUInt64(uint8_t* const destination, const uint64_t value)
+    {
+        WriteUInt32(destination, static_cast<uint32_t>(value));
+        WriteUInt32(destination + 4, static_cast<uint32_t>(value >> 32));
+    }
+
+    inline uint64_t ReadUInt64(const uint8_t* const source)
+    {
+        return static_cast<uint64_t>(ReadUInt32(source)) | (static_cast<uint64_t>(ReadUInt32(source + 4)) << 32);
+    }
+}
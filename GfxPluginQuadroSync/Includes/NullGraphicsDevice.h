@@ -0,0 +1,108 @@
+#pragma once
+
+#include "IGraphicsDevice.h"
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief IGraphicsDevice without any GPU, presenting to a synthetic swap chain.
+     *
+     * The swap chain behaves like a flip model DXGI swap chain:
+     * - Every present rotates the back buffers.
+     * - With a refresh period, every present is flipped on a vblank at least syncInterval refreshes after the previous
+     *   flip.
+     * - Present blocks while maxFrameLatency presents are already waiting for their flip.
+     * Without a refresh period presents are flipped immediately and never block, so only the cost of the code calling
+     * Present is measured.
+     *
+     * \remark GetDevice and GetSwapChain return pointers to objects that are not COM objects, the device can only be
+     *         used with the ISyncApi that do not depend on Direct3D (NullSyncApi, SoftwareSyncApi, ...).
+     */
+    class NullGraphicsDevice final : public IGraphicsDevice
+    {
+    public:
+        struct Config
+        {
+            /// Number of buffers of the swap chain.
+            uint32_t backBufferCount = 3;
+            /// Duration of a refresh of the display, 0 for a display without vsync (presents never block).
+            std::chrono::nanoseconds refreshPeriod{0};
+            /// Number of refreshes between two flips (0 to flip immediately, like a present without vsync).
+            uint32_t syncInterval = 1;
+            /// Number of presents that can wait for their flip before Present blocks.
+            uint32_t maxFrameLatency = 3;
+        };
+
+        explicit NullGraphicsDevice(const Config& config);
+
+        GraphicsDeviceType GetDeviceType() const override { return GraphicsDeviceType::GRAPHICS_DEVICE_NULL; }
+
+        IUnknown*       GetDevice() const override;
+        IDXGISwapChain* GetSwapChain() const override;
+        UINT32          GetSyncInterval() const override { return m_Config.syncInterval; }
+        UINT            GetPresentFlags() const override { return 0; }
+
+        // Remarks: Device and swap chain are synthetic and never change.
+        void SetDevice(IUnknown* const) override { }
+        void SetSwapChain(IDXGISwapChain* const) override { }
+
+        bool Present() override;
+
+        void InitiatePresentRepeats() override;
+        void PrepareSinglePresentRepeat() override;
+        void ConcludePresentRepeats() override;
+
+        void SaveFrameToHold() override { m_HeldFrameSaved = true; }
+        bool PrepareHeldFramePresent() override { return m_HeldFrameSaved; }
+        void ReleaseHeldFrame() override { m_HeldFrameSaved = false; }
+
+        uint32_t GetBackBufferCount() const override { return m_Config.backBufferCount; }
+
+        /// Index of the back buffer to render to.
+        uint32_t GetBackBufferIndex() const { return m_BackBufferIndex; }
+        /// Number of presents (including repeats).
+        uint64_t GetPresentCount() const { return m_PresentCount; }
+        /// Number of presents that had to wait for a previous present to be flipped.
+        uint64_t GetBlockedPresentCount() const { return m_BlockedPresentCount; }
+        /// Total time spent blocked in Present.
+        std::chrono::nanoseconds GetBlockedDuration() const { return m_BlockedDuration; }
+        /// Number of PrepareSinglePresentRepeat between InitiatePresentRepeats and ConcludePresentRepeats.
+        uint64_t GetRepeatCount() const { return m_RepeatCount; }
+        /// Number of calls to the repeat methods out of order (that would have failed on a real device).
+        uint64_t GetRepeatContractViolationCount() const { return m_RepeatContractViolationCount; }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        /// Opaque object GetSwapChain points to.
+        struct SyntheticSwapChain
+        {
+            const NullGraphicsDevice* device;
+        };
+
+        const Config m_Config;
+        SyntheticSwapChain m_SwapChain;
+        /// First vblank, the other ones happen every refreshPeriod after it.
+        const Clock::time_point m_VblankOrigin;
+
+        uint32_t m_BackBufferIndex = 0;
+        uint64_t m_PresentCount = 0;
+        /// Time of the flip of every present that was not flipped yet, in present order (used as a circular buffer).
+        std::vector<Clock::time_point> m_PendingFlips;
+        size_t m_FirstPendingFlip = 0;
+        size_t m_PendingFlipCount = 0;
+        Clock::time_point m_LastFlip;
+
+        uint64_t m_BlockedPresentCount = 0;
+        std::chrono::nanoseconds m_BlockedDuration{0};
+
+        bool m_Repeating = false;
+        bool m_HeldFrameSaved = false;
+        uint64_t m_RepeatCount = 0;
+        uint64_t m_RepeatContractViolationCount = 0;
+    };
+}
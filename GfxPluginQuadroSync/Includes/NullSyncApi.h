@@ -0,0 +1,39 @@
+#pragma once
+
+#include "ISyncApi.h"
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief ISyncApi without any synchronization.
+     *
+     * Joining swap groups and binding barriers always succeeds (ids are only remembered to answer QuerySwapGroup) and
+     * presents are done by the graphics device as soon as asked.  Used where NvAPI is not available (platforms other
+     * than Windows and NullGraphicsDevice) when no other synchronization was asked for.
+     *
+     * \remark QueryFrameCount returns the number of presents done since the last ResetFrameCount.
+     */
+    class NullSyncApi final : public ISyncApi
+    {
+    public:
+        const char* GetName() const override { return "Null"; }
+
+        SyncApiStatus Initialize() override { return SyncApiStatus::Ok; }
+        SyncApiStatus SetupWorkstationSwapGroupFeature(bool) override { return SyncApiStatus::Ok; }
+
+        SyncApiStatus QueryMaxSwapGroup(IUnknown* pDevice, uint32_t& maxGroups, uint32_t& maxBarriers) override;
+        SyncApiStatus JoinSwapGroup(IUnknown* pDevice, IDXGISwapChain* pSwapChain, uint32_t group,
+            bool blocking) override;
+        SyncApiStatus BindSwapBarrier(IUnknown* pDevice, uint32_t group, uint32_t barrier) override;
+        SyncApiStatus QuerySwapGroup(IUnknown* pDevice, IDXGISwapChain* pSwapChain, uint32_t& group,
+            uint32_t& barrier) override;
+        SyncApiStatus QueryFrameCount(IUnknown* pDevice, uint32_t& frameCount) override;
+        SyncApiStatus ResetFrameCount(IUnknown* pDevice) override;
+        SyncApiStatus Present(IGraphicsDevice& graphicsDevice) override;
+
+    private:
+        uint32_t m_GroupId = 0;
+        uint32_t m_BarrierId = 0;
+        uint32_t m_PresentCount = 0;
+    };
+}
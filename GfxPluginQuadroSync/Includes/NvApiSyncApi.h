@@ -0,0 +1,27 @@
+#pragma once
+
+#include "ISyncApi.h"
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief ISyncApi implementation forwarding to NvAPI (Quadro Sync hardware).
+     */
+    class NvApiSyncApi final : public ISyncApi
+    {
+    public:
+        const char* GetName() const override { return "NvAPI"; }
+
+        SyncApiStatus Initialize() override;
+        SyncApiStatus SetupWorkstationSwapGroupFeature(bool enable) override;
+        SyncApiStatus QueryMaxSwapGroup(IUnknown* pDevice, uint32_t& maxGroups, uint32_t& maxBarriers) override;
+        SyncApiStatus JoinSwapGroup(IUnknown* pDevice, IDXGISwapChain* pSwapChain, uint32_t group,
+            bool blocking) override;
+        SyncApiStatus BindSwapBarrier(IUnknown* pDevice, uint32_t group, uint32_t barrier) override;
+        SyncApiStatus QuerySwapGroup(IUnknown* pDevice, IDXGISwapChain* pSwapChain, uint32_t& group,
+            uint32_t& barrier) override;
+        SyncApiStatus QueryFrameCount(IUnknown* pDevice, uint32_t& frameCount) override;
+        SyncApiStatus ResetFrameCount(IUnknown* pDevice) override;
+        SyncApiStatus Present(IGraphicsDevice& graphicsDevice) override;
+    };
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "IGraphicsDevice.h"
+
+#include <memory>
+
+// Remarks: Same declarations as Xlib / GLX so that including this header does not bring the Xlib macros (None,
+// Success, Status, ...) to every file using it.
+typedef struct _XDisplay Display;
+typedef unsigned long GLXDrawable;
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief IGraphicsDevice presenting a GLX drawable (OpenGL on Linux).
+     *
+     * Present repeats blit the back buffer to a framebuffer object of our own when InitiatePresentRepeats is called and
+     * every PrepareSinglePresentRepeat blits it back to the back buffer (glBlitFramebuffer, so the copy stays on the
+     * GPU and no texture has to be shared with the application).
+     *
+     * \remark Every method has to be called with the OpenGL context rendering to the drawable current on the calling
+     *         thread.  The framebuffer bindings and scissor test of the context are restored after every blit.
+     * \remark GetDevice and GetSwapChain return the Display and GLXDrawable in disguise, they are only meant to be
+     *         passed to the ISyncApi that do not depend on Direct3D (GlxSwapGroupSyncApi, SoftwareSyncApi, ...).
+     * \remark Repeats are not possible on multisampled drawables (that cannot be the destination of a blit from a
+     *         single sampled framebuffer), they are skipped (and the same frame presented again) with a warning.
+     */
+    class OpenGLGraphicsDevice final : public IGraphicsDevice
+    {
+    public:
+        /**
+         * \param[in] display Display of the drawable.
+         * \param[in] drawable Drawable presented by glXSwapBuffers.
+         * \param[in] screen Screen of the drawable.
+         */
+        OpenGLGraphicsDevice(Display* display, GLXDrawable drawable, int screen);
+        ~OpenGLGraphicsDevice();
+
+        /**
+         * Create an OpenGLGraphicsDevice presenting the drawable of the GLX context current on the calling thread
+         * (the one Unity renders with when called from a render event).
+         *
+         * \return The device or nullptr if no GLX context is current.
+         */
+        static std::unique_ptr<OpenGLGraphicsDevice> CreateForCurrentContext();
+
+        Display* GetDisplay() const { return m_Display; }
+        int GetScreen() const { return m_Screen; }
+
+        GraphicsDeviceType GetDeviceType() const override { return GraphicsDeviceType::GRAPHICS_DEVICE_OPENGL; }
+
+        IUnknown*       GetDevice() const override;
+        IDXGISwapChain* GetSwapChain() const override;
+        UINT32          GetSyncInterval() const override { return 1; }
+        UINT            GetPresentFlags() const override { return 0; }
+
+        // Remarks: Display and drawable are given to the constructor.
+        void SetDevice(IUnknown* const) override { }
+        void SetSwapChain(IDXGISwapChain* const) override { }
+
+        bool Present() override;
+
+        void InitiatePresentRepeats() override;
+        void PrepareSinglePresentRepeat() override;
+        void ConcludePresentRepeats() override;
+
+        OpenGLGraphicsDevice(const OpenGLGraphicsDevice&) = delete;
+        OpenGLGraphicsDevice& operator=(const OpenGLGraphicsDevice&) = delete;
+
+    private:
+        /// OpenGL 3.0 functions we use (fetched through glXGetProcAddress).
+        struct Functions
+        {
+            void (*glGenFramebuffers)(int n, unsigned int* framebuffers) = nullptr;
+            void (*glDeleteFramebuffers)(int n, const unsigned int* framebuffers) = nullptr;
+            void (*glBindFramebuffer)(unsigned int target, unsigned int framebuffer) = nullptr;
+            unsigned int (*glCheckFramebufferStatus)(unsigned int target) = nullptr;
+            void (*glFramebufferRenderbuffer)(unsigned int target, unsigned int attachment,
+                unsigned int renderbufferTarget, unsigned int renderbuffer) = nullptr;
+            void (*glGenRenderbuffers)(int n, unsigned int* renderbuffers) = nullptr;
+            void (*glDeleteRenderbuffers)(int n, const unsigned int* renderbuffers) = nullptr;
+            void (*glBindRenderbuffer)(unsigned int target, unsigned int renderbuffer) = nullptr;
+            void (*glRenderbufferStorage)(unsigned int target, unsigned int internalFormat, int width,
+                int height) = nullptr;
+            void (*glBlitFramebuffer)(int srcX0, int srcY0, int srcX1, int srcY1, int dstX0, int dstY0, int dstX1,
+                int dstY1, unsigned int mask, unsigned int filter) = nullptr;
+        };
+
+        bool CreateSavedFramebuffer();
+        void Blit(bool toSavedFramebuffer);
+
+        Functions m_Functions;
+        bool m_FunctionsLoaded = false;
+        Display* m_Display;
+        GLXDrawable m_Drawable;
+        int m_Screen;
+
+        // Copy of the back buffer to repeat (kept until ConcludePresentRepeats).
+        unsigned int m_SavedFramebuffer = 0;
+        unsigned int m_SavedRenderbuffer = 0;
+        int m_Width = 0;
+        int m_Height = 0;
+        bool m_MultisampledLogged = false;
+    };
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+namespace GfxQuadroSync
+{
+    /**
+     * Returns the current value of the high resolution performance counter (QueryPerformanceCounter on Windows, a
+     * monotonic clock expressed in nanoseconds elsewhere).
+     */
+    uint64_t GetCurrentPerformanceCounterTick();
+
+    /**
+     * Returns the number of performance counter ticks per second.
+     *
+     * \remark Value is fetched once and cached, so calling it often is cheap.
+     */
+    uint64_t GetPerformanceCounterFrequency();
+
+    /// Function returning the current performance counter tick, see SetPerformanceCounterSource.
+    typedef uint64_t (*PerformanceCounterSource)(void* context);
+
+    /**
+     * Replace the clock returned by GetCurrentPerformanceCounterTick (to run on a virtual clock in simulations).
+     *
+     * \param[in] source Function returning the current tick (ticking at GetPerformanceCounterFrequency), nullptr to go
+     *                   back to the real performance counter.
+     * \param[in] context Value passed to source.
+     *
+     * \remark Not thread safe, must be done while nobody is using the performance counter.
+     */
+    void SetPerformanceCounterSource(PerformanceCounterSource source, void* context);
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <cstdint>
+
+// Minimal declarations of the Windows types used by the platform independent parts of the plugin so that they can be
+// compiled (and run against SimulatedSyncApi) on other platforms.
+struct IUnknown;
+typedef uint32_t UINT32;
+typedef unsigned int UINT;
+#endif
+
+struct IDXGISwapChain;
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "../Unity/IUnityProfiler.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace GfxQuadroSync
+{
+    /// Markers emitted by the plugin (displayed in the timeline of the Unity profiler).
+    enum class PluginProfilerMarker
+    {
+        /// PluginCSwapGroupClient::Render
+        Render,
+        /// Every present (including the repeats of a barrier warmup and the presents of a held frame).
+        Present,
+        /// Preparation of a repeated present of a barrier warmup.
+        BarrierWarmupRepeat,
+        /// ISyncApi::QueryFrameCount
+        QueryFrameCount,
+        Count
+    };
+
+    /// Counters of the plugin (displayed in the Unity profiler, sampled at the end of every frame).
+    enum class PluginProfilerCounter
+    {
+        /// Duration of the last present, in nanoseconds.
+        PresentDuration,
+        /// Duration of the last present done through the swap barrier (0 if it was not), in nanoseconds.
+        BarrierWait,
+        /// Number of presents repeated by the current (or last) barrier warmup.
+        WarmupRepeats,
+        /// Number of successful presents since the plugin was loaded.
+        PresentSuccesses,
+        /// Number of failed presents since the plugin was loaded.
+        PresentFailures,
+        Count
+    };
+
+    /**
+     * \brief Reports markers and counters of the plugin to the Unity profiler (IUnityProfilerV2, or IUnityProfiler
+     *        without counters on versions older than 2021.2).
+     *
+     * Everything does nothing (beyond loading an atomic) when Unity does not provide a profiler or when it is not
+     * available (release players).  The profiler is only used through the function pointers of the interface, so a
+     * fake IUnityInterfaces providing a fake profiler can be given to Initialize to check what is reported.
+     */
+    class PluginProfiler final
+    {
+    public:
+        static PluginProfiler& Instance()
+        {
+            static PluginProfiler staticInstance;
+            return staticInstance;
+        }
+
+        /**
+         * Create the markers and counters (called from UnityPluginLoad).
+         *
+         * \return Is the profiler available?
+         */
+        bool Initialize(IUnityInterfaces* unityInterfaces);
+
+        /// Stop reporting to the profiler (called from UnityPluginUnload).
+        void Shutdown();
+
+        bool IsEnabled() const { return m_Enabled.load(std::memory_order_relaxed); }
+
+        void BeginMarker(const PluginProfilerMarker marker) const
+        {
+            if (m_Enabled.load(std::memory_order_acquire))
+            {
+                if (const auto desc = m_Markers[static_cast<int>(marker)])
+                {
+                    m_EmitEvent(desc, kUnityProfilerMarkerEventTypeBegin, 0, nullptr);
+                }
+            }
+        }
+
+        void EndMarker(const PluginProfilerMarker marker) const
+        {
+            if (m_Enabled.load(std::memory_order_acquire))
+            {
+                if (const auto desc = m_Markers[static_cast<int>(marker)])
+                {
+                    m_EmitEvent(desc, kUnityProfilerMarkerEventTypeEnd, 0, nullptr);
+                }
+            }
+        }
+
+        /// Set the value of a counter (sampled by Unity at the end of the frame).
+        void SetCounter(const PluginProfilerCounter counter, const int64_t value) const
+        {
+            if (m_Enabled.load(std::memory_order_acquire))
+            {
+                if (const auto pValue = m_Counters[static_cast<int>(counter)])
+                {
+                    *pValue = value;
+                }
+            }
+        }
+
+        /// Register the calling thread so that its markers are displayed in the timeline (for threads of the plugin).
+        void RegisterThread(const char* name);
+        /// Unregister the calling thread before it exits.
+        void UnregisterThread();
+
+        PluginProfiler(const PluginProfiler&) = delete;
+        PluginProfiler& operator=(const PluginProfiler&) = delete;
+
+    private:
+        PluginProfiler() = default;
+
+        template <typename ProfilerInterface>
+        void CreateMarkers(ProfilerInterface* profiler, UnityProfilerCategoryId category);
+
+        decltype(IUnityProfilerV2::EmitEvent) m_EmitEvent = nullptr;
+        decltype(IUnityProfilerV2::RegisterThread) m_RegisterThread = nullptr;
+        decltype(IUnityProfilerV2::UnregisterThread) m_UnregisterThread = nullptr;
+        /// nullptr for the markers that could not be created.
+        const UnityProfilerMarkerDesc* m_Markers[static_cast<int>(PluginProfilerMarker::Count)] = {};
+        /// Storage of the counters (owned by Unity), nullptr for the counters that could not be created.
+        int64_t* m_Counters[static_cast<int>(PluginProfilerCounter::Count)] = {};
+        std::atomic<bool> m_Enabled = false;
+    };
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "IPresentRepeatQueue.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Keep present repeats in flight on the GPU without waiting on it after every repeat.
+     *
+     * Every back buffer has its own commands copying the frame to repeat to it, so the only thing a repeat has to wait
+     * for is the previous repeat to the same back buffer (its commands cannot be executed again while they are still
+     * executing).  Since the swap chain goes through every other back buffer in between, that repeat is normally long
+     * done and the CPU only waits when the GPU is more than a whole swap chain behind.
+     *
+     * \remark Only to be used from the rendering thread.
+     */
+    class PresentRepeatScheduler final
+    {
+    public:
+        /**
+         * Start scheduling repeats (forgetting about the previous ones, that must be done).
+         *
+         * \param[in] backBufferCount Number of back buffers of the swap chain.
+         * \param[in] lastFenceValue Last value the fence of the queue was signaled with.
+         */
+        void Reset(uint32_t backBufferCount, uint64_t lastFenceValue);
+
+        /**
+         * Execute the repeat to a back buffer, after waiting for the previous repeat to that back buffer to be done
+         * (if needed).
+         *
+         * \return Success?
+         */
+        bool SubmitRepeat(IPresentRepeatQueue& queue, uint32_t backBufferIndex);
+
+        /**
+         * The fence was signaled with fenceValue (GetLastFenceValue() + 1) by work other than a repeat executed on the
+         * same queue (so that the next repeats use larger values and WaitForIdle also waits for it).
+         */
+        void OnOtherWorkSignaled(const uint64_t fenceValue) { m_LastFenceValue = fenceValue; }
+
+        /// Wait for every repeat submitted to be done (before releasing anything they use).
+        void WaitForIdle(IPresentRepeatQueue& queue);
+
+        /// Number of repeats submitted since the last Reset.
+        uint64_t GetSubmittedCount() const { return m_SubmittedCount; }
+        /// Number of repeats that had to wait for the GPU before being submitted.
+        uint64_t GetStallCount() const { return m_StallCount; }
+        /// Largest number of repeats that were in flight at the same time.
+        uint32_t GetMaxInFlightCount() const { return m_MaxInFlightCount; }
+        /// Last value the fence was (or will be) signaled with.
+        uint64_t GetLastFenceValue() const { return m_LastFenceValue; }
+
+    private:
+        /// Value signaled once the last repeat to each back buffer is done (0 if there was none).
+        std::vector<uint64_t> m_BackBufferFenceValues;
+        uint64_t m_LastFenceValue = 0;
+        uint64_t m_SubmittedCount = 0;
+        uint64_t m_StallCount = 0;
+        uint32_t m_MaxInFlightCount = 0;
+    };
+}
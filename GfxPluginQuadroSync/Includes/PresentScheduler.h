@@ -0,0 +1,117 @@
+#pragma once
+
+#include "ClockSync.h"
+#include "IDatagramTransport.h"
+#include "PresentStatistics.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Present every frame at a cluster time assigned by the emitter (instead of waiting on a barrier).
+     *
+     * When rendering a frame, the emitter picks its present time (leadPeriods refresh periods in the future, and at
+     * least one refresh period after the previous one) and multicasts it.  Every node (emitter included) then waits
+     * until that time (converted to its local clock by ClockSync) and presents.  Unlike a barrier nothing has to go
+     * back to the emitter, so there is no round trip to wait on every frame.  Repeaters use the most recent target
+     * they received that is later than the one of their previous present; if none arrives within scheduleTimeout they
+     * extrapolate one from the previous target and the refresh period.
+     *
+     * Waiting is done by sleeping (on a high resolution timer when available) until a spin margin before the target
+     * and spinning for the rest.  The spin margin is calibrated from how late recent sleeps woke up and is capped to a
+     * quarter of the refresh period.
+     *
+     * \remark Only to be used from the rendering thread (except for the getters).
+     * \remark Displays are not genlocked: frames are presented at the same time but then wait for the next vblank of
+     *         their own display.
+     */
+    class PresentScheduler final
+    {
+    public:
+        struct Config
+        {
+            /// Is this node the emitter (that assigns the present time of every frame) or a repeater?
+            bool isEmitter = false;
+            /// Refresh period of the displays.
+            std::chrono::microseconds refreshPeriod{16667};
+            /// How far in the future (in refresh periods) the emitter schedules presents.
+            uint32_t leadPeriods = 2;
+            /// Maximum time repeaters wait for the target of the next frame before extrapolating one.
+            std::chrono::microseconds scheduleTimeout{33333};
+        };
+
+        PresentScheduler() = default;
+        ~PresentScheduler();
+
+        /**
+         * Start scheduling presents (stopping any previous scheduling).
+         *
+         * \param[in] config How to schedule.
+         * \param[in] clockSync Gives the cluster time (must outlive the scheduling).
+         * \param[in] transport Used to send (emitter) or receive (repeaters) present times.
+         *
+         * \return Success?
+         */
+        bool Start(const Config& config, const ClockSync& clockSync, std::unique_ptr<IDatagramTransport> transport);
+
+        /// Stop scheduling presents.
+        void Stop();
+
+        bool IsStarted() const { return m_Started.load(std::memory_order_relaxed); }
+
+        /// Wait until the present of the next frame is due.
+        void WaitForNextPresent();
+
+        /// Time between the target and the time the wait was over (in microseconds).
+        const PresentStatistics& GetJitterStatistics() const { return m_JitterStatistics; }
+        /// Number of presents whose target was already passed when we started waiting.
+        uint64_t GetLatePresentCount() const { return m_LatePresentCount.load(std::memory_order_relaxed); }
+        /// Number of presents for which repeaters did not receive a target in time (and extrapolated it).
+        uint64_t GetMissingTargetCount() const { return m_MissingTargetCount.load(std::memory_order_relaxed); }
+        /// Number of presents done immediately because there is no cluster time yet (ClockSync has no sample).
+        uint64_t GetUnsynchronizedPresentCount() const
+        {
+            return m_UnsynchronizedPresentCount.load(std::memory_order_relaxed);
+        }
+        /// Current margin before the target at which we stop sleeping and start spinning (in nanoseconds).
+        int64_t GetSpinMarginNs() const { return m_SpinMarginNs.load(std::memory_order_relaxed); }
+        /// Target cluster time of the last present (in nanoseconds, 0 if none).
+        int64_t GetLastTargetNs() const { return m_LastTargetNs.load(std::memory_order_relaxed); }
+
+        PresentScheduler(const PresentScheduler&) = delete;
+        PresentScheduler& operator=(const PresentScheduler&) = delete;
+
+    private:
+        int64_t ScheduleNextTarget();
+        bool ReceiveNextTarget(int64_t& targetNs);
+        /// Process a received message, returns if it contained a target later than m_LastTargetNs.
+        bool ProcessMessage(const uint8_t* message, int size);
+        void WaitUntil(int64_t localTimeNs);
+        void Sleep(int64_t durationNs);
+        void CloseTimer();
+
+        Config m_Config;
+        const ClockSync* m_ClockSync = nullptr;
+        std::unique_ptr<IDatagramTransport> m_Transport;
+        std::atomic<bool> m_Started{false};
+        uint64_t m_Sequence = 0;
+        /// Latest target received by repeaters (0 if none).
+        int64_t m_ReceivedTargetNs = 0;
+        std::atomic<int64_t> m_LastTargetNs{0};
+        /// Recent (slowly decaying) maximum of how late sleeps woke up.
+        int64_t m_OversleepNs = 0;
+        std::atomic<int64_t> m_SpinMarginNs{0};
+#ifdef _WIN32
+        void* m_Timer = nullptr;
+#endif
+
+        PresentStatistics m_JitterStatistics;
+        std::atomic<uint64_t> m_LatePresentCount{0};
+        std::atomic<uint64_t> m_MissingTargetCount{0};
+        std::atomic<uint64_t> m_UnsynchronizedPresentCount{0};
+    };
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Log-linear (HDR histogram like) histogram of durations expressed in microseconds.
+     *
+     * Values smaller than k_SubBucketCount each get their own bucket, larger values are grouped by power of two, each
+     * power of two being split in k_SubBucketCount linear sub-buckets (so the relative error of a bucket is always
+     * smaller than 1 / k_SubBucketCount).
+     *
+     * \remark Recording is wait-free but there must be a single writer.  Reading can be done from any thread at any
+     *         time (but the buckets read are not necessarily coherent with each other).
+     */
+    class LatencyHistogram final
+    {
+    public:
+        static constexpr uint32_t k_SubBucketBits = 6;
+        static constexpr uint32_t k_SubBucketCount = 1 << k_SubBucketBits;
+        /// Largest power of two covered by the histogram (2^26 us is a little bit more than a minute).
+        static constexpr uint32_t k_MaxMagnitude = 26;
+        static constexpr uint32_t k_BucketCount = k_SubBucketCount * (k_MaxMagnitude - k_SubBucketBits + 2);
+
+        /// Returns the index of the bucket in which the given value is to be counted.
+        static uint32_t GetBucketIndex(uint64_t value);
+        /// Returns the smallest value counted in the bucket at the given index.
+        static uint64_t GetBucketLowerBound(uint32_t bucketIndex);
+
+        /// Add a value to the histogram (can only be called from a single thread).
+        void Record(uint64_t value)
+        {
+            auto& bucket = m_Buckets[GetBucketIndex(value)];
+            bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        /// Number of values counted in the bucket at the given index.
+        uint64_t GetBucket(uint32_t bucketIndex) const
+        {
+            return m_Buckets[bucketIndex].load(std::memory_order_relaxed);
+        }
+
+        /// Clear the histogram (can only be called from the writer thread).
+        void Reset();
+
+    private:
+        std::array<std::atomic<uint64_t>, k_BucketCount> m_Buckets = {};
+    };
+
+    /**
+     * \brief Statistics about how long every call to present took (in other words, how long we waited on the swap
+     * barrier).
+     *
+     * Keeps a LatencyHistogram, the min / max / mean and the worst durations seen during the last
+     * k_OutlierWindowLength presents.
+     *
+     * \remark Like LatencyHistogram, recording is wait-free and there must be a single writer at a time (the render
+     *         thread, or the present worker thread while presents are asynchronous, PluginCSwapGroupClient waiting for
+     *         pending presents before recording from the render thread again) while reading can be done from any
+     *         thread.
+     */
+    class PresentStatistics final
+    {
+    public:
+        /// Number of outliers (worst presents) kept.
+        static constexpr uint32_t k_OutlierCount = 8;
+        /// Approximate number of presents for which outliers are kept.
+        static constexpr uint32_t k_OutlierWindowLength = 1024;
+
+        /// One of the worst recent presents
+        struct Outlier
+        {
+            /// Duration of the present in microseconds
+            uint32_t durationUs;
+            /// Index of the present (lower 32 bits)
+            uint32_t presentIndex;
+        };
+
+        /**
+         * Record the duration of a present.
+         *
+         * \param[in] durationUs How long the present took in microseconds.
+         */
+        void Record(uint64_t durationUs);
+
+        /// Clear all the statistics (can only be called from the writer thread).
+        void Reset();
+
+        uint64_t GetCount() const { return m_Count.load(std::memory_order_relaxed); }
+        uint64_t GetSumUs() const { return m_SumUs.load(std::memory_order_relaxed); }
+        uint64_t GetMinUs() const { return m_MinUs.load(std::memory_order_relaxed); }
+        uint64_t GetMaxUs() const { return m_MaxUs.load(std::memory_order_relaxed); }
+        const LatencyHistogram& GetHistogram() const { return m_Histogram; }
+
+        /**
+         * Get the worst recent presents, sorted from the longest to the shortest.
+         *
+         * \param[out] outliers Receives the outliers, unused entries have a duration of 0.
+         */
+        void GetOutliers(std::array<Outlier, k_OutlierCount>& outliers) const;
+
+    private:
+        static uint64_t PackOutlier(uint64_t durationUs, uint64_t presentIndex);
+
+        LatencyHistogram m_Histogram;
+        std::atomic<uint64_t> m_Count = 0;
+        std::atomic<uint64_t> m_SumUs = 0;
+        std::atomic<uint64_t> m_MinUs = UINT64_MAX;
+        std::atomic<uint64_t> m_MaxUs = 0;
+
+        // Outliers are kept in two epochs of k_OutlierWindowLength / 2 presents, the current one and the previous one.
+        // Every entry is packed in a single 64 bits value (duration in the high bits and present index in the low
+        // bits) so that it can be read without tearing and compared directly.
+        std::array<std::array<std::atomic<uint64_t>, k_OutlierCount>, 2> m_Outliers = {};
+        uint32_t m_CurrentOutlierEpoch = 0;
+    };
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "SharedMemory.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Information about a single present done by PluginCSwapGroupClient::Render.
+     *
+     * \remark Any change to this struct must be matched in Unity.ClusterDisplay.GfxPluginQuadroSyncPresentTelemetry in
+     *         GfxPluginQuadroSyncPresentTelemetry.cs (and increment PresentTelemetryHeader::k_Version).
+     */
+    struct PresentTelemetryRecord
+    {
+        /// Seqlock sequence number, odd while the record is being written.
+        std::atomic<uint32_t> sequence;
+        /// Status returned by the present call (0 when successful).
+        int32_t status;
+        /// Index of the record (since the ring was created), used by readers to detect records overwritten while
+        /// they were lagging behind.
+        uint64_t recordIndex;
+        /// Index of the frame (number of calls to PluginCSwapGroupClient::Render).
+        uint64_t frameIndex;
+        /// Performance counter tick when present was entered.
+        uint64_t presentStartTick;
+        /// Performance counter tick when present returned.
+        uint64_t presentEndTick;
+        /// Was the synchronized present skipped (because of SkipSynchronizedPresentOfNextFrame)?
+        uint8_t skippedSync;
+        /// BarrierWarmupAction decided after the present (k_NoWarmupAction if the barrier was not warming up).
+        uint8_t warmupAction;
+        /// Index of the present repeat (0 for the first present of a frame).
+        uint16_t repeatIndex;
+        uint32_t reserved;
+
+        static constexpr uint8_t k_NoWarmupAction = 0xFF;
+    };
+    static_assert(sizeof(PresentTelemetryRecord) == 48, "Unexpected PresentTelemetryRecord size");
+
+    /**
+     * \brief Header at the beginning of the present telemetry shared memory block (followed by recordCount
+     * PresentTelemetryRecord).
+     */
+    struct PresentTelemetryHeader
+    {
+        static constexpr uint32_t k_Magic = 0x54505147; // "GQPT"
+        static constexpr uint32_t k_Version = 1;
+
+        uint32_t magic;
+        uint32_t version;
+        uint32_t headerSize;
+        uint32_t recordSize;
+        uint32_t recordCount;
+        uint32_t reserved;
+        /// Frequency of the performance counter used for the ticks of the records.
+        uint64_t performanceCounterFrequency;
+        /// Number of records written since the ring was created (the next record will be written at index writeIndex %
+        /// recordCount).
+        std::atomic<uint64_t> writeIndex;
+    };
+    static_assert(sizeof(PresentTelemetryHeader) == 40, "Unexpected PresentTelemetryHeader size");
+
+    /**
+     * \brief Fixed size ring of PresentTelemetryRecord that can be read without locks by other threads or processes.
+     *
+     * The ring is placed in a named shared memory block ("GfxPluginQuadroSyncTelemetry_<process id>") so that external
+     * monitors can map it.  Readers use a seqlock protocol on every record:
+     * 1. Read sequence (acquire), retry later if odd.
+     * 2. Copy the record.
+     * 3. Acquire fence and read sequence again, the copy is valid if it did not change.
+     * 4. Check recordIndex is the expected one (otherwise the writer lapped the reader).
+     *
+     * \remark There must be a single writer at a time (the render thread, or the present worker thread while presents
+     *         are asynchronous).
+     */
+    class PresentTelemetry final
+    {
+    public:
+        static constexpr uint32_t k_DefaultRecordCount = 1024;
+
+        /**
+         * Creates the ring.
+         *
+         * \param[in] recordCount Number of records in the ring.
+         *
+         * \remark Falls back to process private memory if the shared memory block cannot be created (in process readers
+         *         can still find it with GetHeader).
+         */
+        void Initialize(uint32_t recordCount = k_DefaultRecordCount);
+
+        /// Returns the header of the ring (nullptr if not initialized).
+        const PresentTelemetryHeader* GetHeader() const { return m_Header; }
+
+        /// Returns the name of the shared memory block (empty if not in shared memory).
+        const std::string& GetSharedMemoryName() const { return m_SharedMemory.name(); }
+
+        /**
+         * Write a new record in the ring (see PresentTelemetryRecord for the meaning of the parameters).
+         */
+        void Write(uint64_t frameIndex, uint64_t presentStartTick, uint64_t presentEndTick, int32_t status,
+            bool skippedSync, uint8_t warmupAction, uint16_t repeatIndex);
+
+    private:
+        SharedMemory m_SharedMemory;
+        std::unique_ptr<uint64_t[]> m_PrivateMemory;
+        PresentTelemetryHeader* m_Header = nullptr;
+        PresentTelemetryRecord* m_Records = nullptr;
+    };
+}
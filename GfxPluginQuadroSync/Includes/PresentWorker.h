@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Thread presenting frames on behalf of the rendering thread so that it does not block while the swap
+     * barrier waits on the rest of the cluster.
+     *
+     * The rendering thread submits one job per frame (the present and everything measuring it) and returns right away.
+     * Jobs are executed in submission order by a single worker thread.  The number of frames in flight (submitted but
+     * not presented yet) is bounded: Submit blocks (back-pressure) while maxInFlightFrames are already in flight, so
+     * the rendering thread is never more than that number of frames ahead of the presents.  It is also never more than
+     * the number of back buffers minus one, so that there is always a back buffer that is not waiting to be presented
+     * for the rendering thread to render to.
+     *
+     * \remark Start, Stop, IsRunning, Submit and WaitForIdle are only to be called from the rendering thread, the
+     *         counters can be read from any thread.
+     */
+    class PresentWorker final
+    {
+    public:
+        typedef std::function<void()> Job;
+
+        PresentWorker() = default;
+        ~PresentWorker();
+
+        /**
+         * Start the worker thread (stopping any previous one).
+         *
+         * \param[in] maxInFlightFrames Number of frames that can be submitted without being presented yet (at least 1,
+         *                              see Submit for the limit set by the number of back buffers).
+         */
+        void Start(uint32_t maxInFlightFrames);
+
+        /// Execute every job submitted and stop the worker thread.
+        void Stop();
+
+        bool IsRunning() const { return m_Running; }
+        uint32_t GetMaxInFlightFrames() const { return m_MaxInFlightFrames; }
+
+        /**
+         * Queue a job to be executed by the worker thread, waiting first for a frame to be presented if the limit of
+         * frames in flight is reached.
+         *
+         * \param[in] job Job presenting the frame.
+         * \param[in] backBufferCount Number of buffers of the swap chain, limits the frames in flight to
+         *                            backBufferCount - 1 (0 if unknown, only one frame can then be in flight).
+         */
+        void Submit(Job job, uint32_t backBufferCount);
+
+        /// Wait for every job submitted to be executed (before the rendering thread uses what the jobs use).
+        void WaitForIdle();
+
+        /// Number of jobs submitted.
+        uint64_t GetSubmitCount() const { return m_SubmitCount.load(std::memory_order_relaxed); }
+        /// Number of Submit that had to wait for a frame to be presented.
+        uint64_t GetStallCount() const { return m_StallCount.load(std::memory_order_relaxed); }
+        /// Total time the rendering thread was blocked by Submit.
+        uint64_t GetStallDurationUs() const { return m_StallDurationUs.load(std::memory_order_relaxed); }
+        /// Largest number of frames that were in flight at once.
+        uint32_t GetMaxInFlightCount() const { return m_MaxInFlightCount.load(std::memory_order_relaxed); }
+
+        PresentWorker(const PresentWorker&) = delete;
+        PresentWorker& operator=(const PresentWorker&) = delete;
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+        typedef std::unique_lock<std::mutex> Lock;
+
+        void ThreadMain();
+        uint32_t GetInFlightCount() const { return static_cast<uint32_t>(m_Jobs.size()) + (m_Executing ? 1 : 0); }
+        uint32_t GetInFlightLimit(uint32_t backBufferCount) const;
+
+        std::thread m_Thread;
+        bool m_Running = false;
+        uint32_t m_MaxInFlightFrames = 1;
+
+        // Everything below is protected by m_Lock.
+        std::mutex m_Lock;
+        std::condition_variable m_Changed;
+        bool m_StopThread = false;
+        std::deque<Job> m_Jobs;
+        /// Is the worker thread executing a job (already removed from m_Jobs)?
+        bool m_Executing = false;
+
+        std::atomic<uint64_t> m_SubmitCount = 0;
+        std::atomic<uint64_t> m_StallCount = 0;
+        std::atomic<uint64_t> m_StallDurationUs = 0;
+        std::atomic<uint32_t> m_MaxInFlightCount = 0;
+    };
+}
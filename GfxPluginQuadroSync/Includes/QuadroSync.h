@@ -1,13 +1,19 @@
 #pragma once
 
-#include "../External/NvAPI/nvapi.h"
 #include "../Unity/IUnityInterface.h"
+#include "BarrierWarmup.h"
+#include "ClockSync.h"
+#include "FrameCounter.h"
+#include "ISyncApi.h"
+#include "PlatformTypes.h"
+#include "PresentScheduler.h"
+#include "PresentStatistics.h"
+#include "PresentTelemetry.h"
+#include "PresentWorker.h"
 
 #include <atomic>
 #include <cstdint>
-
-class ID3D11Device;
-class IDXGISwapChain;
+#include <memory>
 
 namespace GfxQuadroSync
 {
@@ -16,7 +22,7 @@ namespace GfxQuadroSync
     class PluginCSwapGroupClient
     {
     public:
-        PluginCSwapGroupClient();
+        explicit PluginCSwapGroupClient(std::unique_ptr<ISyncApi> syncApi);
         ~PluginCSwapGroupClient();
 
         enum class InitializeStatus
@@ -34,60 +40,161 @@ namespace GfxQuadroSync
         void Prepare();
         InitializeStatus Initialize(IUnknown* pDevice, IDXGISwapChain* pSwapChain);
         void Dispose(IUnknown* pDevice, IDXGISwapChain* pSwapChain);
+        /**
+         * Put a swap chain that replaced the one given to Initialize (recreated by Unity, for example on a fullscreen
+         * transition) in the swap group and swap barrier we are using.  Only what the new swap chain is missing is
+         * done again and the barrier is only warmed up again if it had to be bound again.
+         */
+        InitializeStatus RejoinSwapGroup(IUnknown* pDevice, IDXGISwapChain* pSwapChain);
 
         void SetupWorkStation();
         void DisposeWorkStation();
 
         bool Render(IGraphicsDevice* pGraphicsDevice);
         void SkipSynchronizedPresentOfNextFrame() { m_SkipSynchronizedPresentOfNextFrame = true; }
+        /**
+         * Present (and so wait on the swap barrier) from a worker thread so that Render returns right away and the
+         * rendering thread can work on the next frame in the meantime.
+         *
+         * \param[in] maxInFlightFrames Number of frames Render can return before they are presented, 0 to present
+         *                              from the rendering thread again.
+         *
+         * \remark Only plain presents are done by the worker, barrier warmups, scheduled presents and frame hold still
+         *         present from the rendering thread once the worker is done.  Render only returns once the back buffer
+         *         Unity renders to next is not waiting to be presented anymore (see
+         *         IGraphicsDevice::WaitForNextBackBuffer), so frames in flight are also limited to the number of back
+         *         buffers minus one.
+         */
+        void EnableAsyncPresent(uint32_t maxInFlightFrames);
+        bool IsAsyncPresentEnabled() const { return m_PresentWorker.IsRunning(); }
+        /// Wait for every frame handed to the present worker to be presented (see EnableAsyncPresent).
+        void WaitForPendingPresents() { m_PresentWorker.WaitForIdle(); }
+        /**
+         * While enabled, every frame is saved before being presented so that HoldFrame can present it again.
+         */
+        void EnableFrameHold(IGraphicsDevice* pGraphicsDevice, bool value);
+        bool IsFrameHoldEnabled() const { return m_FrameHoldEnabled; }
+        /**
+         * Present the last frame again (through the synchronized present) because the next one is not ready in time,
+         * so that the other nodes are not stalled waiting on this one.
+         *
+         * \return Was the frame presented?  (false if frame hold is not enabled, the barrier is warming up or the
+         *         graphics device cannot hold frames)
+         */
+        bool HoldFrame(IGraphicsDevice* pGraphicsDevice);
         void ResetFrameCount(IUnknown* pDevice);
-        NvU32 QueryFrameCount(IUnknown* pDevice);
+        uint32_t QueryFrameCount(IUnknown* pDevice);
 
         void EnableSystem(IUnknown* pDevice, IDXGISwapChain* pSwapChain, bool value);
         void EnableSwapGroup(IUnknown* pDevice, IDXGISwapChain* pSwapChain, bool value);
-        NvU32 GetSwapGroupId() const { return m_GroupId.load(std::memory_order_relaxed); }
+        uint32_t GetSwapGroupId() const { return m_GroupId.load(std::memory_order_relaxed); }
         void EnableSwapBarrier(IUnknown* pDevice, bool value);
-        NvU32 GetSwapBarrierId() const { return m_BarrierId.load(std::memory_order_relaxed); }
+        uint32_t GetSwapBarrierId() const { return m_BarrierId.load(std::memory_order_relaxed); }
         void EnableSyncCounter(const bool value);
 
+        ISyncApi& GetSyncApi() const { return *m_SyncApi; }
+        /// Replace the ISyncApi (must be called from the rendering thread, before Initialize).
+        void SetSyncApi(std::unique_ptr<ISyncApi> syncApi);
         uint64_t GetPresentSuccessCount() const { return m_PresentSuccessCount.load(std::memory_order_relaxed); }
         uint64_t GetPresentFailureCount() const { return m_PresentFailureCount.load(std::memory_order_relaxed); }
-
-        enum class BarrierWarmupAction
+        uint64_t GetSwapGroupRejoinCount() const { return m_SwapGroupRejoinCount.load(std::memory_order_relaxed); }
+        /// Number of RejoinSwapGroup that had to bind the barrier again (and so to warm it up again).
+        uint64_t GetSwapGroupRejoinWarmupCount() const
         {
-            RepeatPresent,
-            ContinueToNextFrame,
-            BarrierWarmedUp,
-        };
-
-        // Type of callback to a managed function that is called after the first present when barrier is active.
-        typedef BarrierWarmupAction(UNITY_INTERFACE_API* BarrierWarmupCallback)();
-
-        void SetBarrierWarmupCallback(BarrierWarmupCallback callback)
+            return m_SwapGroupRejoinWarmupCount.load(std::memory_order_relaxed);
+        }
+        uint64_t GetLastSwapGroupRejoinDurationUs() const
+        {
+            return m_LastSwapGroupRejoinDurationUs.load(std::memory_order_relaxed);
+        }
+        /// Number of times the graphics device allocated the resources used to repeat presents (as of the last warmup).
+        uint64_t GetSavedFrameAllocationCount() const
+        {
+            return m_SavedFrameAllocationCount.load(std::memory_order_relaxed);
+        }
+        /// Number of barrier warmups that reused the resources of a previous one (as of the last warmup).
+        uint64_t GetSavedFrameReuseCount() const { return m_SavedFrameReuseCount.load(std::memory_order_relaxed); }
+        /// Number of times these resources were released because of a resize or device loss (as of the last warmup).
+        uint64_t GetSavedFrameReleaseCount() const
         {
-            m_BarrierWarmupCallback = callback ? callback : &EmptyBarrierWarmupCallback;
+            return m_SavedFrameReleaseCount.load(std::memory_order_relaxed);
         }
+        /// Number of presents of a held frame (see HoldFrame).
+        uint64_t GetHeldFrameCount() const { return m_HeldFrameCount.load(std::memory_order_relaxed); }
+        /// Number of HoldFrame that could not present the held frame.
+        uint64_t GetFrameHoldFailureCount() const { return m_FrameHoldFailureCount.load(std::memory_order_relaxed); }
+        const FrameCounter& GetFrameCounter() const { return m_FrameCounter; }
+        const PresentStatistics& GetPresentStatistics() const { return m_PresentStatistics; }
+        void InitializePresentTelemetry() { m_PresentTelemetry.Initialize(); }
+        const PresentTelemetry& GetPresentTelemetry() const { return m_PresentTelemetry; }
+        const PresentWorker& GetPresentWorker() const { return m_PresentWorker; }
+
+        BarrierWarmup& GetBarrierWarmup() { return m_BarrierWarmup; }
+        const BarrierWarmup& GetBarrierWarmup() const { return m_BarrierWarmup; }
+        ClockSync& GetClockSync() { return m_ClockSync; }
+        const ClockSync& GetClockSync() const { return m_ClockSync; }
+        /// When started, presents are done at the time assigned by the emitter instead of through the ISyncApi.
+        PresentScheduler& GetPresentScheduler() { return m_PresentScheduler; }
+        const PresentScheduler& GetPresentScheduler() const { return m_PresentScheduler; }
 
     private:
-        static BarrierWarmupAction EmptyBarrierWarmupCallback() { return BarrierWarmupAction::ContinueToNextFrame; }
+        /// Implementation of Render (that adds the render_begin and render_end tracepoints around it).
+        bool RenderFrame(IGraphicsDevice* pGraphicsDevice);
+        /// Render when the PresentScheduler is started (present at the time assigned by the emitter).
+        bool RenderScheduled(uint64_t frameIndex, IGraphicsDevice* pGraphicsDevice);
+        /// Present the frame saved by IGraphicsDevice::SaveFrameToHold again.
+        bool PresentHeldFrame(IGraphicsDevice* pGraphicsDevice);
+        /// Done holding frames, Unity's next frame is about to be presented.
+        void ConcludeFrameHold(IGraphicsDevice* pGraphicsDevice);
+        /// Present a frame without barrier warmup (from the present worker thread).
+        void PresentFrame(uint64_t frameIndex, IGraphicsDevice* pGraphicsDevice);
+        /// ISyncApi::JoinSwapGroup recorded in the EventTrace.
+        SyncApiStatus JoinSwapGroup(IUnknown* pDevice, IDXGISwapChain* pSwapChain, uint32_t group, bool blocking);
+        /// ISyncApi::BindSwapBarrier recorded in the EventTrace.
+        SyncApiStatus BindSwapBarrier(IUnknown* pDevice, uint32_t group, uint32_t barrier);
+        /// Do presents through the ISyncApi wait on a swap barrier?
+        bool IsBarrierBound() const { return m_BarrierId.load(std::memory_order_relaxed) > 0; }
 
         // Remarks: Some variables are atomic because they can be accessed from the rendering thread or the game loop
         // thread for the implementation of the GetState function.  There is no need for a strong correlation between
         // each of the variables since the GetState function is only for reporting the state, so using atomic is enough
         // (and faster than a mutex).
-        std::atomic<NvU32> m_GroupId = 1;
-        std::atomic<NvU32> m_BarrierId = 1;
-        NvU32 m_FrameCount = 0;
-        NvU32 m_GSyncSwapGroups = 0;
-        NvU32 m_GSyncBarriers = 0;
+        std::unique_ptr<ISyncApi> m_SyncApi;
+        std::atomic<uint32_t> m_GroupId = 1;
+        std::atomic<uint32_t> m_BarrierId = 1;
+        uint32_t m_FrameCount = 0;
+        uint32_t m_GSyncSwapGroups = 0;
+        uint32_t m_GSyncBarriers = 0;
         bool m_GSyncMaster = true;
         bool m_GSyncCounter = false;
         bool m_IsActive = false;
         bool m_NeedToWarmUpBarrier = false;
         bool m_SkipSynchronizedPresentOfNextFrame = false;
+        bool m_FrameHoldEnabled = false;
+        /// Number of presents of the held frame since the last frame rendered by Unity.
+        uint16_t m_HeldFramePresentCount = 0;
+        /// Number of presents repeated by the barrier warmup in progress (reported to the PluginProfiler).
+        int64_t m_WarmupRepeatCount = 0;
         std::atomic<uint64_t> m_PresentSuccessCount = 0;
         std::atomic<uint64_t> m_PresentFailureCount = 0;
-        BarrierWarmupCallback m_BarrierWarmupCallback = &EmptyBarrierWarmupCallback;
+        std::atomic<uint64_t> m_SwapGroupRejoinCount = 0;
+        std::atomic<uint64_t> m_SwapGroupRejoinWarmupCount = 0;
+        std::atomic<uint64_t> m_LastSwapGroupRejoinDurationUs = 0;
+        std::atomic<uint64_t> m_SavedFrameAllocationCount = 0;
+        std::atomic<uint64_t> m_SavedFrameReuseCount = 0;
+        std::atomic<uint64_t> m_SavedFrameReleaseCount = 0;
+        std::atomic<uint64_t> m_HeldFrameCount = 0;
+        std::atomic<uint64_t> m_FrameHoldFailureCount = 0;
+        FrameCounter m_FrameCounter;
+        PresentStatistics m_PresentStatistics;
+        PresentTelemetry m_PresentTelemetry;
+        uint64_t m_RenderCount = 0;
+        const uint64_t m_PerformanceCounterFrequency;
+        BarrierWarmup m_BarrierWarmup;
+        ClockSync m_ClockSync;
+        PresentScheduler m_PresentScheduler;
+        // Remarks: Last so that the worker thread is stopped before anything it uses is destroyed.
+        PresentWorker m_PresentWorker;
     };
 
 }
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Description of the back buffers the resources used to repeat presents have to be compatible with.
+     *
+     * \remark Format and sample count are the values of the graphics API (DXGI_FORMAT, VkFormat, ...).
+     */
+    struct SavedFrameDescription
+    {
+        uint64_t width = 0;
+        uint32_t height = 0;
+        uint32_t format = 0;
+        uint32_t sampleCount = 0;
+        uint32_t backBufferCount = 0;
+
+        bool operator==(const SavedFrameDescription& other) const
+        {
+            return width == other.width && height == other.height && format == other.format &&
+                sampleCount == other.sampleCount && backBufferCount == other.backBufferCount;
+        }
+        bool operator!=(const SavedFrameDescription& other) const { return !(*this == other); }
+    };
+
+    /**
+     * \brief Keeps track of the resources an IGraphicsDevice uses to repeat presents (a back buffer sized texture and
+     * the objects copying it) so that they are kept from one barrier warmup to the next instead of being allocated by
+     * every InitiatePresentRepeats.
+     *
+     * The IGraphicsDevice owns the resources, this only tells it when they can be reused (the back buffers still have
+     * the same description) and counts allocations and reuses.  Resources are to be released when the back buffers are
+     * resized (detected by the next InitiatePresentRepeats) or when the device is lost or replaced.
+     *
+     * \remark Only to be used from the rendering thread.
+     */
+    class SavedFrameCache final
+    {
+    public:
+        /**
+         * Called by InitiatePresentRepeats to know if the cached resources can be used to repeat presents on back
+         * buffers of the given description.
+         *
+         * \return true if they can (counted as a reuse), false if the cached resources (if any) have to be released and
+         *         new ones allocated (and OnAllocated called once done).
+         */
+        bool TryReuse(const SavedFrameDescription& description);
+
+        /// Are the cached resources compatible with back buffers of the given description (not counted as a reuse)?
+        bool Matches(const SavedFrameDescription& description) const
+        {
+            return m_Valid && m_Description == description;
+        }
+
+        /// The resources for back buffers of the given description were allocated.
+        void OnAllocated(const SavedFrameDescription& description);
+
+        /// The cached resources were released (or failed to be allocated).
+        void OnReleased();
+
+        /// Are there cached resources?
+        bool IsValid() const { return m_Valid; }
+        /// Description of the back buffers the cached resources are compatible with (if IsValid).
+        const SavedFrameDescription& GetDescription() const { return m_Description; }
+
+        /// Number of times the resources were allocated.
+        uint64_t GetAllocationCount() const { return m_AllocationCount; }
+        /// Number of InitiatePresentRepeats that reused the cached resources.
+        uint64_t GetReuseCount() const { return m_ReuseCount; }
+        /// Number of times the cached resources were released (resize, device lost, ...).
+        uint64_t GetReleaseCount() const { return m_ReleaseCount; }
+
+    private:
+        SavedFrameDescription m_Description;
+        bool m_Valid = false;
+        uint64_t m_AllocationCount = 0;
+        uint64_t m_ReuseCount = 0;
+        uint64_t m_ReleaseCount = 0;
+    };
+}
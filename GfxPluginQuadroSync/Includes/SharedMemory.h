@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Helper class managing a named block of memory shared between processes.
+     *
+     * Uses CreateFileMapping / MapViewOfFile on Windows and shm_open / mmap elsewhere.
+     *
+     * \remark Designed to behave sort of like std::unique_ptr (cannot be copied, memory is unmapped and the name
+     *         released in the destructor).
+     */
+    class SharedMemory final
+    {
+    public:
+        SharedMemory() = default;
+        ~SharedMemory();
+
+        SharedMemory(SharedMemory&& toMove) noexcept;
+        SharedMemory& operator=(SharedMemory&& toMove) noexcept;
+
+        /**
+         * Create (or open if it already exists) the named shared memory block.
+         *
+         * \param[in] name Name of the block (without any platform specific prefix, i.e. no "Local\" or "/").
+         * \param[in] size Size of the block in bytes.
+         * \param[out] created Set to true if the block was created by this call (as opposed to already existing), so
+         *                     that the caller knows if it has to initialize it.
+         *
+         * \return Was the block successfully mapped?
+         */
+        bool CreateOrOpen(const std::string& name, size_t size, bool& created);
+
+        /**
+         * Unmap the block (and remove its name if we were the one creating it).
+         */
+        void reset();
+
+        explicit operator bool() const noexcept { return m_Data != nullptr; }
+        void* get() const noexcept { return m_Data; }
+        size_t size() const noexcept { return m_Size; }
+        const std::string& name() const noexcept { return m_Name; }
+
+        SharedMemory(const SharedMemory&) = delete;
+        SharedMemory& operator=(const SharedMemory&) = delete;
+
+    private:
+        void* m_Data = nullptr;
+        size_t m_Size = 0;
+        std::string m_Name;
+        bool m_Created = false;
+#ifdef _WIN32
+        void* m_Handle = nullptr;
+#endif
+    };
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "IDatagramTransport.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief In-process network connecting IDatagramTransport endpoints (one per simulated node).
+     *
+     * Every datagram sent by an endpoint is delivered to every other endpoint after a configurable latency (plus
+     * jitter), unless it is dropped (with a configurable probability, independently for each receiver).  Used to run
+     * protocols between nodes (like BarrierWarmup) on a single computer without any network adapter.
+     *
+     * \remark Unlike SimulatedSyncApi this runs in real time (Receive really waits) since the protocols it is used with
+     * rely on threads and real time waits.  Drops and delays are picked by a pseudo random number generator per endpoint
+     * (seeded from the seed and the creation order of the endpoint) but the order in which threads send datagrams is
+     * not deterministic.
+     * \remark Endpoints are addressed (IDatagramTransport::SendTo) by their creation order: the first endpoint created
+     *         is node 0, the next one node 1, ...
+     * \remark The network must outlive the endpoints it created.
+     */
+    class SimulatedNetwork final
+    {
+    public:
+        struct Config
+        {
+            /// Seed of the pseudo random number generator.
+            uint64_t seed = 1;
+            /// Probability that a datagram is not delivered to a receiver.
+            double lossProbability = 0.0;
+            /// Minimum time between sending and being able to receive a datagram.
+            std::chrono::microseconds latency{50};
+            /// Additional delay, uniformly distributed in [0, jitter] (datagrams can be reordered).
+            std::chrono::microseconds jitter{0};
+        };
+
+        explicit SimulatedNetwork(const Config& config);
+        ~SimulatedNetwork();
+
+        /// Create a new endpoint (a new node) connected to the network (Send must not be called concurrently on it).
+        std::unique_ptr<IDatagramTransport> CreateEndpoint();
+
+        /// Number of datagrams sent by all the endpoints.
+        uint64_t GetSentCount() const;
+        /// Number of datagrams that were delivered (each datagram is delivered once per receiver).
+        uint64_t GetDeliveredCount() const;
+        /// Number of datagrams that were dropped (each datagram can be dropped once per receiver).
+        uint64_t GetDroppedCount() const;
+
+        SimulatedNetwork(const SimulatedNetwork&) = delete;
+        SimulatedNetwork& operator=(const SimulatedNetwork&) = delete;
+
+    private:
+        class Endpoint;
+        struct Inbox;
+
+        typedef std::vector<std::shared_ptr<Inbox>> Inboxes;
+
+        /// Deliver a datagram to every endpoint but the sender (destination < 0) or to a single endpoint.
+        void Deliver(const Inbox* sender, int destination, uint64_t& randomState, const void* data, size_t size);
+        void Remove(const Inbox* inbox);
+
+        const Config m_Config;
+        /// Protects m_Inboxes (that is replaced, never modified, so that Deliver can work on a snapshot).
+        std::mutex m_Lock;
+        std::shared_ptr<const Inboxes> m_Inboxes;
+        uint64_t m_CreatedEndpointCount = 0;
+        std::atomic<uint64_t> m_SentCount{0};
+        std::atomic<uint64_t> m_DeliveredCount{0};
+        std::atomic<uint64_t> m_DroppedCount{0};
+    };
+}
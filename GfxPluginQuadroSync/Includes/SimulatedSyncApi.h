@@ -0,0 +1,163 @@
+#pragma once
+
+#include "ISyncApi.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Deterministic ISyncApi simulating a cluster of nodes sharing a swap barrier on a virtual clock.
+     *
+     * The node using the simulator is node 0, the other nodes are simulated.  Every node renders for a configurable
+     * (jittered) amount of time after the previous barrier release and then presents.  Once the swap barrier is active,
+     * a present is released at the first vblank following the arrival of the last node (plus a small release jitter).
+     * Nothing ever sleeps, presents simply move the virtual clock forward, so millions of frames can be simulated in
+     * seconds.  Calling InstallAsPerformanceCounterSource makes GetCurrentPerformanceCounterTick return the virtual
+     * clock so that everything measured by PluginCSwapGroupClient is in simulated time.
+     *
+     * \remark The same Config (and same sequence of calls) always produces the same results, on every platform.
+     */
+    class SimulatedSyncApi final : public ISyncApi
+    {
+    public:
+        /// Operations in which failures can be injected.
+        enum class Operation
+        {
+            Initialize,
+            SetupWorkstationSwapGroupFeature,
+            QueryMaxSwapGroup,
+            JoinSwapGroup,
+            BindSwapBarrier,
+            QuerySwapGroup,
+            QueryFrameCount,
+            ResetFrameCount,
+            Present,
+            Count
+        };
+
+        struct Config
+        {
+            /// Number of nodes in the cluster (including the local node).
+            uint32_t nodeCount = 4;
+            /// Seed of the pseudo random number generator.
+            uint64_t seed = 1;
+            /// Duration of a refresh of the displays (all displays are genlocked).
+            uint64_t refreshPeriodNs = 16666667;
+            /// Average time it takes a node to render a frame.
+            uint64_t renderTimeNs = 8000000;
+            /// Render time is uniformly distributed in [renderTimeNs - renderTimeJitterNs, renderTimeNs +
+            /// renderTimeJitterNs].
+            uint64_t renderTimeJitterNs = 2000000;
+            /// Average render time of each node, indexed by node (node 0 being the local node).  Nodes past its end use
+            /// renderTimeNs.
+            std::vector<uint64_t> nodeRenderTimeNs;
+            /// Render time jitter of each node, indexed by node.  Nodes past its end use renderTimeJitterNs.
+            std::vector<uint64_t> nodeRenderTimeJitterNs;
+            /// Maximum delay (uniformly distributed) between the barrier release and the present returning.
+            uint64_t barrierJitterNs = 50000;
+            /// Number of presents after binding the barrier before it starts to synchronize nodes.
+            uint32_t barrierWarmupPresents = 0;
+            /// Values returned by QueryMaxSwapGroup.
+            uint32_t maxSwapGroups = 1;
+            uint32_t maxSwapBarriers = 1;
+            /// Probability that any present fails with presentFailureStatus.
+            double presentFailureProbability = 0.0;
+            SyncApiStatus presentFailureStatus = SyncApiStatus::Error;
+        };
+
+        explicit SimulatedSyncApi(const Config& config);
+        ~SimulatedSyncApi();
+
+        /**
+         * Make the next count calls to operation fail.
+         *
+         * \param[in] operation The operation that will fail.
+         * \param[in] status Status returned by the failing calls.
+         * \param[in] count Number of calls that will fail.
+         */
+        void InjectFailure(Operation operation, SyncApiStatus status, uint32_t count = 1);
+
+        /// Current time of the virtual clock.
+        uint64_t GetNowNs() const { return m_NowNs; }
+
+        /// Move the virtual clock forward (to simulate work done by the local node).
+        void AdvanceTime(uint64_t durationNs) { m_NowNs += durationNs; }
+
+        /// Move the virtual clock forward by a render time picked the same way as for the simulated nodes.
+        void SimulateLocalRender() { m_NowNs += NextRenderTimeNs(0); }
+
+        /// Use the virtual clock as the performance counter (until this object is destroyed).
+        void InstallAsPerformanceCounterSource();
+
+        /// Number of presents that were simulated.
+        uint64_t GetPresentCount() const { return m_PresentCount; }
+
+        /// Sum of the time presents of the local node spent waiting on other nodes.
+        uint64_t GetTotalBarrierWaitNs() const { return m_TotalBarrierWaitNs; }
+
+        /// Number of presents that missed a vblank because of the slowest node.
+        uint64_t GetMissedVblankCount() const { return m_MissedVblankCount; }
+
+        /// Number of presents that were not synchronized with the other nodes (no barrier bound, barrier not warmed
+        /// up yet or swap chain not in the swap group).
+        uint64_t GetUnsynchronizedPresentCount() const { return m_UnsynchronizedPresentCount; }
+
+        /**
+         * Simulate the driver forgetting a swap chain destroyed by the application: it leaves the swap group, which
+         * loses its barrier if it was the only swap chain in it.
+         */
+        void ReleaseSwapChain(IDXGISwapChain* pSwapChain);
+
+        const char* GetName() const override { return "Simulated"; }
+
+        SyncApiStatus Initialize() override;
+        SyncApiStatus SetupWorkstationSwapGroupFeature(bool enable) override;
+        SyncApiStatus QueryMaxSwapGroup(IUnknown* pDevice, uint32_t& maxGroups, uint32_t& maxBarriers) override;
+        SyncApiStatus JoinSwapGroup(IUnknown* pDevice, IDXGISwapChain* pSwapChain, uint32_t group,
+            bool blocking) override;
+        SyncApiStatus BindSwapBarrier(IUnknown* pDevice, uint32_t group, uint32_t barrier) override;
+        SyncApiStatus QuerySwapGroup(IUnknown* pDevice, IDXGISwapChain* pSwapChain, uint32_t& group,
+            uint32_t& barrier) override;
+        SyncApiStatus QueryFrameCount(IUnknown* pDevice, uint32_t& frameCount) override;
+        SyncApiStatus ResetFrameCount(IUnknown* pDevice) override;
+        SyncApiStatus Present(IGraphicsDevice& graphicsDevice) override;
+
+        SimulatedSyncApi(const SimulatedSyncApi&) = delete;
+        SimulatedSyncApi& operator=(const SimulatedSyncApi&) = delete;
+
+    private:
+        struct InjectedFailure
+        {
+            SyncApiStatus status = SyncApiStatus::Ok;
+            uint32_t remaining = 0;
+        };
+
+        bool ConsumeInjectedFailure(Operation operation, SyncApiStatus& status);
+        uint64_t NextRandom();
+        double NextUniform();
+        uint64_t NextRenderTimeNs(size_t nodeIndex);
+        static uint64_t GetPerformanceCounterTick(void* context);
+
+        const Config m_Config;
+        uint64_t m_RandomState;
+        uint64_t m_NowNs = 0;
+        /// When each node finishes rendering and arrives at the barrier (index 0 is unused, local node arrives at
+        /// m_NowNs).
+        std::vector<uint64_t> m_NodeArrivalNs;
+        uint64_t m_FrameCountResetNs = 0;
+        uint32_t m_GroupId = 0;
+        uint32_t m_BarrierId = 0;
+        /// Swap chain in the swap group (the group only supports one).
+        IDXGISwapChain* m_SwapChain = nullptr;
+        uint32_t m_PresentsSinceBarrierBound = 0;
+        uint64_t m_PresentCount = 0;
+        uint64_t m_TotalBarrierWaitNs = 0;
+        uint64_t m_MissedVblankCount = 0;
+        uint64_t m_UnsynchronizedPresentCount = 0;
+        bool m_InstalledAsPerformanceCounterSource = false;
+        std::array<InjectedFailure, static_cast<size_t>(Operation::Count)> m_InjectedFailures;
+    };
+}
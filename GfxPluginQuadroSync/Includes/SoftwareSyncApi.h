@@ -0,0 +1,234 @@
+#pragma once
+
+#include "HostBarrier.h"
+#include "IDatagramTransport.h"
+#include "ISyncApi.h"
+#include "PresentStatistics.h"
+
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief ISyncApi implementing the swap barrier in software by exchanging datagrams with the other nodes.
+     *
+     * Used where there is no Quadro Sync hardware (or NvAPI).  Every present is a new generation of the barrier: the
+     * node multicasts an Arrive message for that generation and waits until it received the Arrive of every other node
+     * of the cluster before presenting (without synchronization, through IGraphicsDevice::Present).  Receiving the
+     * Arrive of a later generation also releases the node (the sender could only get there once the barrier of our
+     * generation was released), which recovers from lost datagrams.  Arrive messages are repeated every resendInterval
+     * while waiting and the node presents anyway after timeout.  Nodes that did not arrive before the timeout are then
+     * no longer waited on until we receive a message from them again (so that a dead node does not block the cluster).
+     *
+     * The frame count is the number of barrier generations since the last ResetFrameCount, so it progresses at the same
+     * rate on every node (like the hardware frame counter).
+     *
+     * \remark Displays are not genlocked: presents are released at the same time but are then only synchronized to the
+     *         vblank of their own display.
+     * \remark Release skew is computed from the release time every node includes in its next Arrive message.  Those
+     *         are read from the steady clock of every node, so the skew is only meaningful when nodes share the same
+     *         clock (multiple processes on the same computer).
+     * \remark Datagrams are only processed while waiting in Present (on the render thread, so no extra thread has to
+     *         wake up to release the barrier).
+     * \remark The algorithm above (AllToAll) makes every node process a message from every other node on every frame.
+     *         For large clusters the barrier can instead combine arrivals up a tree (Tree, each node waiting on at most
+     *         fanOut children before reporting to its parent and the root multicasting the release) or run a
+     *         dissemination barrier (Dissemination, log(nodes) / log(fanOut + 1) rounds in which every node notifies
+     *         fanOut other nodes).  Tree only skips leaves that timed out.  When a node with children of its own or
+     *         the parent of a node times out twice in a row (which would lose the subtree of the node or leave nobody
+     *         to release the barrier), the node falls back to AllToAll and its Arrive messages make every other node
+     *         fall back as well.  With Dissemination a dead node makes every generation time out.
+     * \remark When multiple instances run on the same computer (hostInstanceCount > 1) only the representative of the
+     *         computer (hostInstanceIndex 0) takes part in the barrier with the other nodes: the other instances wait on
+     *         it through a HostBarrier and are released by it (without any network traffic).
+     */
+    class SoftwareSyncApi final : public ISyncApi
+    {
+    public:
+        /// Algorithm used to synchronize the nodes (every node of the cluster must use the same one).
+        enum class BarrierAlgorithm : uint8_t
+        {
+            /// Every node multicasts its arrival and waits on the arrival of every other node.
+            AllToAll = 0,
+            /// Arrivals are combined up a tree of fanOut children per node, the root multicasts the release.
+            Tree = 1,
+            /// Every node notifies fanOut other nodes per round for log(nodes) / log(fanOut + 1) rounds.
+            Dissemination = 2,
+        };
+
+        struct Config
+        {
+            /// Identifier of this node in the cluster.
+            uint8_t nodeId = 0;
+            /// Every node of the cluster sharing the barrier (this node included, only the representative of every
+            /// computer when using a HostBarrier).
+            std::bitset<256> nodes;
+            /// Interval at which the Arrive message is repeated while waiting on the barrier.
+            std::chrono::microseconds resendInterval{2000};
+            /// Maximum time to wait on the barrier before presenting anyway (must be longer than BarrierWarmup's
+            /// blockDelay for the warmup to detect repeaters blocked by the barrier).
+            std::chrono::microseconds timeout{1000000};
+            /// Algorithm used to synchronize the nodes.
+            BarrierAlgorithm algorithm = BarrierAlgorithm::AllToAll;
+            /// Number of children of every node (Tree) or of nodes notified per round (Dissemination).
+            uint32_t fanOut = 4;
+            /// Name of the HostBarrier shared by the instances running on this computer (when hostInstanceCount > 1).
+            std::string hostBarrierName;
+            /// Number of instances running on this computer.
+            uint32_t hostInstanceCount = 1;
+            /// Index of this instance among the ones running on this computer (0 for the representative).
+            uint32_t hostInstanceIndex = 0;
+        };
+
+        SoftwareSyncApi(const Config& config, std::unique_ptr<IDatagramTransport> transport);
+        ~SoftwareSyncApi();
+
+        /// Number of times the barrier was released.
+        uint64_t GetReleaseCount() const { return m_ReleaseCount.load(std::memory_order_relaxed); }
+        /// Number of times we presented because waiting on the barrier timed out.
+        uint64_t GetTimeoutCount() const { return m_TimeoutCount.load(std::memory_order_relaxed); }
+        /// Algorithm currently used (AllToAll once Tree fell back to it).
+        BarrierAlgorithm GetAlgorithm() const { return m_Algorithm.load(std::memory_order_relaxed); }
+        /// Time between our arrival at the barrier and its release (in microseconds).
+        const PresentStatistics& GetBarrierWaitStatistics() const { return m_BarrierWaitStatistics; }
+        /// Time between the first and last node to be released (in microseconds, see remarks about clocks, only
+        /// computed by the root with Tree).
+        const PresentStatistics& GetReleaseSkewStatistics() const { return m_ReleaseSkewStatistics; }
+        /// Time between the release of the HostBarrier by the representative and this instance waking up (in
+        /// microseconds, only for the instances that are not the representative).
+        const PresentStatistics& GetHostReleaseLatencyStatistics() const { return m_HostReleaseLatencyStatistics; }
+
+        const char* GetName() const override { return "Software"; }
+
+        SyncApiStatus Initialize() override;
+        SyncApiStatus SetupWorkstationSwapGroupFeature(bool enable) override;
+        SyncApiStatus QueryMaxSwapGroup(IUnknown* pDevice, uint32_t& maxGroups, uint32_t& maxBarriers) override;
+        SyncApiStatus JoinSwapGroup(IUnknown* pDevice, IDXGISwapChain* pSwapChain, uint32_t group,
+            bool blocking) override;
+        SyncApiStatus BindSwapBarrier(IUnknown* pDevice, uint32_t group, uint32_t barrier) override;
+        SyncApiStatus QuerySwapGroup(IUnknown* pDevice, IDXGISwapChain* pSwapChain, uint32_t& group,
+            uint32_t& barrier) override;
+        SyncApiStatus QueryFrameCount(IUnknown* pDevice, uint32_t& frameCount) override;
+        SyncApiStatus ResetFrameCount(IUnknown* pDevice) override;
+        SyncApiStatus Present(IGraphicsDevice& graphicsDevice) override;
+
+        SoftwareSyncApi(const SoftwareSyncApi&) = delete;
+        SoftwareSyncApi& operator=(const SoftwareSyncApi&) = delete;
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        void WaitOnBarrier();
+        void WaitOnHostBarrier();
+        bool IsHostFollower() const { return m_HostBarrier.IsOpen() && !m_HostBarrier.IsRepresentative(); }
+        /// Arrive at m_Generation, returns if the barrier is already released.
+        bool Arrive();
+        /// Send (again) our messages of m_Generation.
+        void ResendArrival();
+        /// Nodes we are currently waiting on.
+        std::bitset<256> GetMissingNodes() const;
+        void SendArrive();
+        void SendGather();
+        /// Send a Release to a node (or to every node when nodeId < 0).
+        void SendRelease(int nodeId, uint64_t generation);
+        void SendNotify(uint32_t round);
+        void SendNotify(uint8_t nodeId, uint64_t generation, uint32_t round);
+        /// Ask nodes to send us (again) their Notify of the current round.
+        void SendResend(const std::bitset<256>& nodes);
+        /// Process a received message, returns if the barrier of m_Generation is to be released.
+        bool ProcessMessage(const uint8_t* message, int size);
+        bool ProcessArrive(uint8_t nodeId, uint64_t generation, uint64_t previousReleaseTimeNs);
+        bool ProcessGather(uint8_t nodeId, uint64_t generation, uint64_t minReleaseTimeNs, uint64_t maxReleaseTimeNs);
+        bool ProcessRelease(uint8_t nodeId, uint64_t generation);
+        bool ProcessNotify(uint8_t nodeId, uint64_t generation, uint32_t round, uint64_t minReleaseTimeNs,
+            uint64_t maxReleaseTimeNs);
+        bool ProcessResend(uint8_t nodeId, uint64_t generation, uint32_t round);
+        /// Gather (or release the barrier when we are the root) once every child arrived, returns if released.
+        bool ProgressTree();
+        /// Move to the next rounds for which every source notified us, returns if released.
+        bool ProgressDissemination();
+        /// Handle a Tree generation that timed out, returns the children that are no longer to be waited on.
+        std::bitset<256> OnTreeTimeout(const std::bitset<256>& missingChildren);
+        /// Switch from Tree to AllToAll (see remarks of the class).
+        void FallBackToAllToAll();
+        /// Other nodes are way ahead (we just joined the barrier or missed many presents), jump to their generation.
+        void JumpToGeneration(uint64_t generation, uint8_t nodeId);
+        void OnReleased(Clock::time_point releaseTime);
+
+        const Config m_Config;
+        const std::unique_ptr<IDatagramTransport> m_Transport;
+        HostBarrier m_HostBarrier;
+        uint32_t m_GroupId = 0;
+        uint32_t m_BarrierId = 0;
+        /// Algorithm of m_Config unless Tree fell back to AllToAll (atomic only for GetAlgorithm).
+        std::atomic<BarrierAlgorithm> m_Algorithm;
+
+        /// Generation of the barrier we are waiting on (or last released).
+        uint64_t m_Generation = 0;
+        uint64_t m_FrameCountBaseGeneration = 0;
+        /// Nodes we are waiting on (nodes of m_Config minus the ones that timed out).
+        std::bitset<256> m_ActiveNodes;
+        /// Nodes that arrived at m_Generation.
+        std::bitset<256> m_Arrived;
+        /// Nodes that already arrived at m_Generation + 1 (while we were still waiting on m_Generation).
+        std::bitset<256> m_ArrivedNext;
+        /// Was the barrier of m_Generation released by completing the algorithm (rather than by a later generation
+        /// or a timeout)?
+        bool m_Complete = false;
+
+        /// Node id of our parent in the tree (Tree, -1 for the root).
+        int m_ParentNodeId = -1;
+        /// Our children in the tree (Tree, m_Arrived and m_ArrivedNext then only contain children).
+        std::bitset<256> m_Children;
+        /// Have we sent our Gather of m_Generation (Tree)?
+        bool m_Gathered = false;
+        /// Nodes having children in the tree (Tree).
+        std::bitset<256> m_InteriorNodes;
+        /// Parent or children with children of their own that the last generation timed out on (Tree).
+        std::bitset<256> m_SuspectedNodes;
+
+        /// Nodes notifying us and nodes we notify in a round (Dissemination).
+        struct DisseminationRound
+        {
+            std::bitset<256> sources;
+            std::vector<uint8_t> targets;
+        };
+        std::vector<DisseminationRound> m_Rounds;
+        /// Round of m_Generation we are in (Dissemination, m_Rounds.size() once released).
+        uint32_t m_Round = 0;
+        /// Sources that notified us per round of m_Generation and m_Generation + 1 (Dissemination).
+        std::vector<std::bitset<256>> m_Notified;
+        std::vector<std::bitset<256>> m_NotifiedNext;
+        /// Our release time of the previous generation (in nanoseconds of the steady clock of this node).
+        uint64_t m_PreviousReleaseTimeNs = 0;
+
+        /// Release time of a generation of every node (gathered from the Arrive messages of the next generation).
+        struct ReleaseTimes
+        {
+            std::bitset<256> received;
+            uint64_t minNs = 0;
+            uint64_t maxNs = 0;
+            /// Was the release time of some node unknown (combined release times of Tree and Dissemination)?
+            bool incomplete = false;
+
+            void Add(uint8_t nodeId, uint64_t releaseTimeNs);
+            /// Add release times combined by another node (minNs of 0 when it did not know all of them).
+            void Merge(uint8_t nodeId, uint64_t otherMinNs, uint64_t otherMaxNs);
+            void Reset();
+        };
+        /// Indexed by the parity of the generation (only the current and previous generations are needed).
+        ReleaseTimes m_ReleaseTimes[2];
+
+        std::atomic<uint64_t> m_ReleaseCount = 0;
+        std::atomic<uint64_t> m_TimeoutCount = 0;
+        PresentStatistics m_BarrierWaitStatistics;
+        PresentStatistics m_ReleaseSkewStatistics;
+        PresentStatistics m_HostReleaseLatencyStatistics;
+    };
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Header at the beginning of a StateBlock (followed by stateSize bytes of state).
+     *
+     * \remark Any change to this struct must be matched in Unity.ClusterDisplay.GfxPluginQuadroSyncStateBlock in
+     *         GfxPluginQuadroSyncStateBlock.cs (and increment k_Version).
+     */
+    struct StateBlockHeader
+    {
+        static constexpr uint32_t k_Magic = 0x42535147; // "GQSB"
+        static constexpr uint32_t k_Version = 1;
+
+        uint32_t magic;
+        uint32_t version;
+        uint32_t headerSize;
+        /// Size of the state following the header.  Fields are only ever added at the end of the state, so readers
+        /// knowing about a smaller state copy what they know about and readers knowing about a larger one leave the
+        /// fields missing from the block to their default value.
+        uint32_t stateSize;
+        /// Seqlock sequence number, odd while the state is being written.
+        std::atomic<uint32_t> sequence;
+        uint32_t reserved;
+        /// Number of times the state was published (0 until the first Publish, the state is meaningless until then).
+        std::atomic<uint64_t> publishCount;
+    };
+    static_assert(sizeof(StateBlockHeader) == 32, "Unexpected StateBlockHeader size");
+
+    /**
+     * \brief State of type State published by a single writer under a seqlock so that readers (other threads or
+     * managed code reading the memory directly) get a consistent snapshot of every field without locks nor calls.
+     *
+     * Readers use the seqlock protocol:
+     * 1. Read sequence (acquire), retry if odd.
+     * 2. Copy min(stateSize, size of the state they know about) bytes following the header.
+     * 3. Acquire fence and read sequence again, the copy is valid if it did not change.
+     *
+     * \remark There must be a single writer (the rendering thread for the plugin's state).
+     */
+    template <typename State>
+    class StateBlock final
+    {
+        static_assert(std::is_trivially_copyable<State>::value, "State is copied with memcpy");
+
+    public:
+        StateBlock()
+        {
+            auto& header = m_Block.header;
+            header.magic = StateBlockHeader::k_Magic;
+            header.version = StateBlockHeader::k_Version;
+            header.headerSize = sizeof(StateBlockHeader);
+            header.stateSize = sizeof(State);
+            header.sequence.store(0, std::memory_order_relaxed);
+            header.reserved = 0;
+            header.publishCount.store(0, std::memory_order_relaxed);
+        }
+
+        StateBlock(const StateBlock&) = delete;
+        StateBlock& operator=(const StateBlock&) = delete;
+
+        /// Returns the header of the block (the state follows it).
+        const StateBlockHeader* GetHeader() const { return &m_Block.header; }
+
+        /**
+         * Publish a new state.
+         *
+         * \remark The state is prepared by the caller so that readers only have to retry while it is being copied.
+         */
+        void Publish(const State& state)
+        {
+            auto& header = m_Block.header;
+            const auto sequence = header.sequence.load(std::memory_order_relaxed);
+            header.sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            std::memcpy(&m_Block.state, &state, sizeof(State));
+
+            header.sequence.store(sequence + 2, std::memory_order_release);
+            header.publishCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * Read the last state published (for readers in native code).
+         *
+         * \return Was a consistent state read?  (false if nothing was published yet or if the writer kept updating it
+         *         during every attempt)
+         */
+        bool TryRead(State& state, const int maxAttempts = 16) const
+        {
+            const auto& header = m_Block.header;
+            if (header.publishCount.load(std::memory_order_relaxed) == 0)
+            {
+                return false;
+            }
+            for (int attempt = 0; attempt < maxAttempts; ++attempt)
+            {
+                const auto sequenceBefore = header.sequence.load(std::memory_order_acquire);
+                if ((sequenceBefore & 1) != 0)
+                {
+                    continue;
+                }
+                std::memcpy(&state, &m_Block.state, sizeof(State));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (header.sequence.load(std::memory_order_relaxed) == sequenceBefore)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    private:
+        struct Block
+        {
+            StateBlockHeader header;
+            State state;
+        };
+        Block m_Block;
+    };
+}
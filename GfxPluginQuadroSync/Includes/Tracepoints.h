@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Static tracepoints of PluginCSwapGroupClient for system tools (see Tools/Probes for example scripts).
+ *
+ * - Linux (when sys/sdt.h is found, QUADROSYNC_USDT): USDT probes of provider "gfxquadrosync" that bpftrace or perf
+ *   can attach to.  A probe is a nop until a tool attaches to it.
+ * - Windows: TraceLogging events of provider "Unity.ClusterDisplay.GfxPluginQuadroSync"
+ *   ({8c84e33f-eeb2-5b3b-0600-643ac053846f}, the GUID hashed from the name).  An event is a test of the provider's
+ *   enabled level until a session enables the provider.
+ * - Elsewhere the tracepoints compile to nothing.
+ *
+ * Probes and their arguments:
+ * - render_begin (frameIndex), render_end (frameIndex, presented): PluginCSwapGroupClient::Render
+ * - present_begin (frameIndex, repeatIndex), present_end (frameIndex, repeatIndex, status, durationUs): every present
+ * - warmup_action (frameIndex, repeatIndex, BarrierWarmupAction): barrier warmup decision after a present
+ * - initialize_stage (TracepointInitializeStage, status): step of PluginCSwapGroupClient::Initialize completed
+ * - enable_swap_group (value, status), enable_swap_barrier (value, status): swap group or barrier changed
+ *
+ * \remark Names and arguments are used by the scripts in Tools/Probes, keep them in sync.
+ */
+
+namespace GfxQuadroSync
+{
+    /// Step of PluginCSwapGroupClient::Initialize reported by the initialize_stage tracepoint.
+    enum class TracepointInitializeStage : uint32_t
+    {
+        QueryMaxSwapGroup = 0,
+        JoinSwapGroup = 1,
+        QueryFrameCount = 2,
+        ResetFrameCount = 3,
+        BindSwapBarrier = 4,
+        QuerySwapGroup = 5,
+    };
+
+    /// Register the tracepoints provider with the system (only does something on Windows).
+    void RegisterTracepoints();
+
+    /// Unregister the tracepoints provider (only does something on Windows).
+    void UnregisterTracepoints();
+}
+
+#if defined(QUADROSYNC_USDT)
+
+#include <sys/sdt.h>
+
+#define QUADROSYNC_PROBE_RENDER_BEGIN(frameIndex) DTRACE_PROBE1(gfxquadrosync, render_begin, frameIndex)
+#define QUADROSYNC_PROBE_RENDER_END(frameIndex, presented) \
+    DTRACE_PROBE2(gfxquadrosync, render_end, frameIndex, presented)
+#define QUADROSYNC_PROBE_PRESENT_BEGIN(frameIndex, repeatIndex) \
+    DTRACE_PROBE2(gfxquadrosync, present_begin, frameIndex, repeatIndex)
+#define QUADROSYNC_PROBE_PRESENT_END(frameIndex, repeatIndex, status, durationUs) \
+    DTRACE_PROBE4(gfxquadrosync, present_end, frameIndex, repeatIndex, status, durationUs)
+#define QUADROSYNC_PROBE_WARMUP_ACTION(frameIndex, repeatIndex, action) \
+    DTRACE_PROBE3(gfxquadrosync, warmup_action, frameIndex, repeatIndex, action)
+#define QUADROSYNC_PROBE_INITIALIZE_STAGE(stage, status) \
+    DTRACE_PROBE2(gfxquadrosync, initialize_stage, stage, status)
+#define QUADROSYNC_PROBE_ENABLE_SWAP_GROUP(value, status) \
+    DTRACE_PROBE2(gfxquadrosync, enable_swap_group, value, status)
+#define QUADROSYNC_PROBE_ENABLE_SWAP_BARRIER(value, status) \
+    DTRACE_PROBE2(gfxquadrosync, enable_swap_barrier, value, status)
+
+#elif defined(_WIN32)
+
+#include <Windows.h>
+#include <TraceLoggingProvider.h>
+
+TRACELOGGING_DECLARE_PROVIDER(g_GfxQuadroSyncTraceLoggingProvider);
+
+#define QUADROSYNC_PROBE_RENDER_BEGIN(frameIndex) \
+    TraceLoggingWrite(g_GfxQuadroSyncTraceLoggingProvider, "RenderBegin", \
+        TraceLoggingUInt64(static_cast<uint64_t>(frameIndex), "frameIndex"))
+#define QUADROSYNC_PROBE_RENDER_END(frameIndex, presented) \
+    TraceLoggingWrite(g_GfxQuadroSyncTraceLoggingProvider, "RenderEnd", \
+        TraceLoggingUInt64(static_cast<uint64_t>(frameIndex), "frameIndex"), \
+        TraceLoggingInt32(static_cast<int32_t>(presented), "presented"))
+#define QUADROSYNC_PROBE_PRESENT_BEGIN(frameIndex, repeatIndex) \
+    TraceLoggingWrite(g_GfxQuadroSyncTraceLoggingProvider, "PresentBegin", \
+        TraceLoggingUInt64(static_cast<uint64_t>(frameIndex), "frameIndex"), \
+        TraceLoggingUInt32(static_cast<uint32_t>(repeatIndex), "repeatIndex"))
+#define QUADROSYNC_PROBE_PRESENT_END(frameIndex, repeatIndex, status, durationUs) \
+    TraceLoggingWrite(g_GfxQuadroSyncTraceLoggingProvider, "PresentEnd", \
+        TraceLoggingUInt64(static_cast<uint64_t>(frameIndex), "frameIndex"), \
+        TraceLoggingUInt32(static_cast<uint32_t>(repeatIndex), "repeatIndex"), \
+        TraceLoggingInt32(static_cast<int32_t>(status), "status"), \
+        TraceLoggingUInt64(static_cast<uint64_t>(durationUs), "durationUs"))
+#define QUADROSYNC_PROBE_WARMUP_ACTION(frameIndex, repeatIndex, action) \
+    TraceLoggingWrite(g_GfxQuadroSyncTraceLoggingProvider, "WarmupAction", \
+        TraceLoggingUInt64(static_cast<uint64_t>(frameIndex), "frameIndex"), \
+        TraceLoggingUInt32(static_cast<uint32_t>(repeatIndex), "repeatIndex"), \
+        TraceLoggingInt32(static_cast<int32_t>(action), "action"))
+#define QUADROSYNC_PROBE_INITIALIZE_STAGE(stage, status) \
+    TraceLoggingWrite(g_GfxQuadroSyncTraceLoggingProvider, "InitializeStage", \
+        TraceLoggingUInt32(static_cast<uint32_t>(stage), "stage"), \
+        TraceLoggingInt32(static_cast<int32_t>(status), "status"))
+#define QUADROSYNC_PROBE_ENABLE_SWAP_GROUP(value, status) \
+    TraceLoggingWrite(g_GfxQuadroSyncTraceLoggingProvider, "EnableSwapGroup", \
+        TraceLoggingInt32(static_cast<int32_t>(value), "value"), \
+        TraceLoggingInt32(static_cast<int32_t>(status), "status"))
+#define QUADROSYNC_PROBE_ENABLE_SWAP_BARRIER(value, status) \
+    TraceLoggingWrite(g_GfxQuadroSyncTraceLoggingProvider, "EnableSwapBarrier", \
+        TraceLoggingInt32(static_cast<int32_t>(value), "value"), \
+        TraceLoggingInt32(static_cast<int32_t>(status), "status"))
+
+#else
+
+// Arguments are still evaluated (as they would be with probes) so that values only computed for probes are not
+// reported as unused.
+#define QUADROSYNC_PROBE_RENDER_BEGIN(frameIndex) ((void)(frameIndex))
+#define QUADROSYNC_PROBE_RENDER_END(frameIndex, presented) ((void)(frameIndex), (void)(presented))
+#define QUADROSYNC_PROBE_PRESENT_BEGIN(frameIndex, repeatIndex) ((void)(frameIndex), (void)(repeatIndex))
+#define QUADROSYNC_PROBE_PRESENT_END(frameIndex, repeatIndex, status, durationUs) \
+    ((void)(frameIndex), (void)(repeatIndex), (void)(status), (void)(durationUs))
+#define QUADROSYNC_PROBE_WARMUP_ACTION(frameIndex, repeatIndex, action) \
+    ((void)(frameIndex), (void)(repeatIndex), (void)(action))
+#define QUADROSYNC_PROBE_INITIALIZE_STAGE(stage, status) ((void)(stage), (void)(status))
+#define QUADROSYNC_PROBE_ENABLE_SWAP_GROUP(value, status) ((void)(value), (void)(status))
+#define QUADROSYNC_PROBE_ENABLE_SWAP_BARRIER(value, status) ((void)(value), (void)(status))
+
+#endif
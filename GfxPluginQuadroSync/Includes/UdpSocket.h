@@ -0,0 +1,57 @@
+#pragma once
+
+#include "IDatagramTransport.h"
+
+#include <cstdint>
+#include <string>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief IDatagramTransport sending and receiving UDP multicast datagrams.
+     *
+     * Configured like the managed UdpAgent: multicast loopback on (so that multiple nodes can run on the same computer),
+     * a TTL of 1 and address reuse.
+     */
+    class UdpSocket final : public IDatagramTransport
+    {
+    public:
+        UdpSocket() = default;
+        ~UdpSocket();
+
+        /**
+         * Open the socket and join the multicast group.
+         *
+         * \param[in] multicastAddress Multicast address (like "224.0.1.0") to which datagrams are sent.
+         * \param[in] port Port to which datagrams are sent and on which we receive them.
+         * \param[in] adapterAddress IPv4 address of the network adapter to use (empty for the default one).
+         *
+         * \return Success?
+         */
+        bool OpenMulticast(const std::string& multicastAddress, uint16_t port, const std::string& adapterAddress);
+
+        /// Close the socket.
+        void Close();
+
+        explicit operator bool() const noexcept { return m_Socket != k_InvalidSocket; }
+
+        bool Send(const void* data, size_t size) override;
+        int Receive(void* buffer, size_t size, std::chrono::microseconds timeout) override;
+
+        UdpSocket(const UdpSocket&) = delete;
+        UdpSocket& operator=(const UdpSocket&) = delete;
+
+    private:
+#ifdef _WIN32
+        typedef uintptr_t SocketHandle;
+        static constexpr SocketHandle k_InvalidSocket = ~static_cast<uintptr_t>(0);
+#else
+        typedef int SocketHandle;
+        static constexpr SocketHandle k_InvalidSocket = -1;
+#endif
+
+        SocketHandle m_Socket = k_InvalidSocket;
+        /// Destination of the datagrams (sockaddr_in, kept as bytes to avoid including the socket headers here).
+        uint8_t m_Destination[16] = {};
+    };
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "IGraphicsDevice.h"
+
+#include <vulkan/vulkan.h>
+
+#include <vector>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief IGraphicsDevice presenting through Vulkan.
+     *
+     * Unity presents by itself on Vulkan (there is no present override), so the present of Unity has to be intercepted
+     * (vkQueuePresentKHR) and given to SetPendingPresent before calling PluginCSwapGroupClient::Render that will do the
+     * present (synchronized with the other nodes) through Present.
+     *
+     * Present repeats copy the image being presented when InitiatePresentRepeats is called to an image of our own and
+     * every PrepareSinglePresentRepeat acquires a new image of the swap chain and copies that image back to it (using
+     * command buffers recorded once for every image of the swap chain).
+     *
+     * \remark Every Vulkan function is fetched through the vkGetInstanceProcAddr given to the constructor (so that the
+     *         functions of the driver are called and not any hook we might have installed in Unity).
+     * \remark GetDevice and GetSwapChain return the VkDevice and VkSwapchainKHR in disguise, they are only meant
+     *         to be passed to the ISyncApi that do not depend on Direct3D (SoftwareSyncApi,
+     *         VulkanPresentBarrierSyncApi, ...).
+     */
+    class VulkanGraphicsDevice final : public IGraphicsDevice
+    {
+    public:
+        /// Swap chain Unity presents to.
+        struct Swapchain
+        {
+            VkSwapchainKHR swapchain = VK_NULL_HANDLE;
+            VkFormat format = VK_FORMAT_UNDEFINED;
+            VkExtent2D extent = {0, 0};
+            VkImageUsageFlags usage = 0;
+            /// Was the swap chain created with VkSwapchainPresentBarrierCreateInfoNV::presentBarrierEnable?
+            bool presentBarrierEnabled = false;
+        };
+
+        VulkanGraphicsDevice(
+            VkInstance instance,
+            VkPhysicalDevice physicalDevice,
+            VkDevice device,
+            VkQueue queue,
+            uint32_t queueFamilyIndex,
+            PFN_vkGetInstanceProcAddr getInstanceProcAddr);
+
+        ~VulkanGraphicsDevice();
+
+        GraphicsDeviceType GetDeviceType() const override { return GraphicsDeviceType::GRAPHICS_DEVICE_VULKAN; }
+
+        IUnknown*       GetDevice() const override { return reinterpret_cast<IUnknown*>(m_Device); }
+        IDXGISwapChain* GetSwapChain() const override;
+        UINT32          GetSyncInterval() const override { return 1; }
+        UINT            GetPresentFlags() const override { return 0; }
+
+        // Remarks: Device cannot change and the swap chain is given through SetSwapchain.
+        void SetDevice(IUnknown* const) override { }
+        void SetSwapChain(IDXGISwapChain* const) override { }
+
+        /**
+         * Set the swap chain presented to (releasing everything that was created for the previous one).
+         */
+        void SetSwapchain(const Swapchain& swapchain);
+        const Swapchain& GetSwapchain() const { return m_Swapchain; }
+
+        /// Will presents be synchronized by the driver (VK_NV_present_barrier)?
+        bool IsPresentBarrierEnabled() const { return m_Swapchain.presentBarrierEnabled; }
+
+        /**
+         * Set the present to be done by the next call to Present.
+         *
+         * \param[in] queue Queue on which to present.
+         * \param[in] presentInfo What to present, must contain a single image of the swap chain given to SetSwapchain.
+         * \return Success?  (false if presentInfo cannot be presented by us)
+         */
+        bool SetPendingPresent(VkQueue queue, const VkPresentInfoKHR& presentInfo);
+
+        /// Is there a present waiting to be done by Present?
+        bool HasPendingPresent() const { return m_PendingPresentQueue != VK_NULL_HANDLE; }
+
+        /// Result of the last vkQueuePresentKHR done by Present.
+        VkResult GetLastPresentResult() const { return m_LastPresentResult; }
+
+        bool Present() override;
+
+        void InitiatePresentRepeats() override;
+        void PrepareSinglePresentRepeat() override;
+        void ConcludePresentRepeats() override;
+
+        VulkanGraphicsDevice(const VulkanGraphicsDevice&) = delete;
+        VulkanGraphicsDevice& operator=(const VulkanGraphicsDevice&) = delete;
+
+    private:
+        /// Vulkan functions we use (fetched from the driver).
+        struct Functions
+        {
+            PFN_vkGetPhysicalDeviceMemoryProperties vkGetPhysicalDeviceMemoryProperties = nullptr;
+            PFN_vkGetDeviceProcAddr vkGetDeviceProcAddr = nullptr;
+            PFN_vkDeviceWaitIdle vkDeviceWaitIdle = nullptr;
+            PFN_vkQueueSubmit vkQueueSubmit = nullptr;
+            PFN_vkQueuePresentKHR vkQueuePresentKHR = nullptr;
+            PFN_vkAcquireNextImageKHR vkAcquireNextImageKHR = nullptr;
+            PFN_vkGetSwapchainImagesKHR vkGetSwapchainImagesKHR = nullptr;
+            PFN_vkCreateCommandPool vkCreateCommandPool = nullptr;
+            PFN_vkDestroyCommandPool vkDestroyCommandPool = nullptr;
+            PFN_vkAllocateCommandBuffers vkAllocateCommandBuffers = nullptr;
+            PFN_vkBeginCommandBuffer vkBeginCommandBuffer = nullptr;
+            PFN_vkEndCommandBuffer vkEndCommandBuffer = nullptr;
+            PFN_vkCmdPipelineBarrier vkCmdPipelineBarrier = nullptr;
+            PFN_vkCmdCopyImage vkCmdCopyImage = nullptr;
+            PFN_vkCreateImage vkCreateImage = nullptr;
+            PFN_vkDestroyImage vkDestroyImage = nullptr;
+            PFN_vkGetImageMemoryRequirements vkGetImageMemoryRequirements = nullptr;
+            PFN_vkAllocateMemory vkAllocateMemory = nullptr;
+            PFN_vkFreeMemory vkFreeMemory = nullptr;
+            PFN_vkBindImageMemory vkBindImageMemory = nullptr;
+            PFN_vkCreateSemaphore vkCreateSemaphore = nullptr;
+            PFN_vkDestroySemaphore vkDestroySemaphore = nullptr;
+            PFN_vkCreateFence vkCreateFence = nullptr;
+            PFN_vkDestroyFence vkDestroyFence = nullptr;
+            PFN_vkWaitForFences vkWaitForFences = nullptr;
+            PFN_vkResetFences vkResetFences = nullptr;
+        };
+
+        bool AreRepeatResourcesCreated() const { return m_CommandPool != VK_NULL_HANDLE; }
+        void CreateRepeatResources();
+        void RecordCopy(VkCommandBuffer commandBuffer, VkImage swapchainImage, bool toSavedImage);
+        bool Submit(VkCommandBuffer commandBuffer, uint32_t waitSemaphoreCount, const VkSemaphore* waitSemaphores,
+            VkSemaphore signalSemaphore);
+        void WaitForFence();
+        void FreeRepeatResources();
+
+        Functions m_Functions;
+        VkPhysicalDevice m_PhysicalDevice;
+        VkDevice m_Device;
+        VkQueue m_Queue;
+        uint32_t m_QueueFamilyIndex;
+        Swapchain m_Swapchain;
+
+        // Present to be done by the next call to Present.
+        VkQueue m_PendingPresentQueue = VK_NULL_HANDLE;
+        uint32_t m_PendingImageIndex = 0;
+        std::vector<VkSemaphore> m_PendingWaitSemaphores;
+        VkResult m_LastPresentResult = VK_SUCCESS;
+
+        // Resources used to repeat presents (kept until ConcludePresentRepeats).
+        std::vector<VkImage> m_SwapchainImages;
+        VkImage m_SavedImage = VK_NULL_HANDLE;
+        VkDeviceMemory m_SavedImageMemory = VK_NULL_HANDLE;
+        VkCommandPool m_CommandPool = VK_NULL_HANDLE;
+        /// Copy of every swap chain image to m_SavedImage.
+        std::vector<VkCommandBuffer> m_SaveCommandBuffers;
+        /// Copy of m_SavedImage to every swap chain image.
+        std::vector<VkCommandBuffer> m_RestoreCommandBuffers;
+        /// Signaled once the copy to (or from) every swap chain image is done (waited on by its present).
+        std::vector<VkSemaphore> m_PresentReadySemaphores;
+        VkSemaphore m_AcquireSemaphore = VK_NULL_HANDLE;
+        /// Signaled once the last copy submitted is done.
+        VkFence m_CopyDoneFence = VK_NULL_HANDLE;
+        bool m_CopyPending = false;
+        bool m_MissingTransferUsageLogged = false;
+    };
+}
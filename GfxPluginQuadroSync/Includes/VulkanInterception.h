@@ -0,0 +1,42 @@
+#pragma once
+
+#include "VulkanGraphicsDevice.h"
+
+#include "../Unity/IUnityGraphicsVulkan.h"
+
+namespace GfxQuadroSync
+{
+    /**
+     * Called instead of the vkQueuePresentKHR done by Unity.
+     *
+     * \param[in] queue Queue on which Unity presents.
+     * \param[in] presentInfo What Unity presents.
+     * \param[out] result Result of the present (when it was done by the handler).
+     * \return Was the present done by the handler?  (false to let it be done as usual)
+     */
+    typedef bool (*VulkanPresentHandler)(VkQueue queue, const VkPresentInfoKHR& presentInfo, VkResult& result);
+
+    /**
+     * Intercept the initialization of Vulkan by Unity to:
+     * - Enable VK_NV_present_barrier on the device (when supported by the physical device).
+     * - Create the swap chains with the present barrier enabled (when possible) and with images that can be copied
+     *   (to repeat presents).
+     * - Give every vkQueuePresentKHR of Unity to presentHandler.
+     *
+     * \param[in] unityGraphicsVulkan Unity interface to intercept the initialization of Vulkan.
+     * \param[in] presentHandler Called instead of every vkQueuePresentKHR of Unity.
+     * \return Success?  (false if the graphics device was already initialized, the plugin has to be preloaded)
+     */
+    bool InterceptVulkanInitialization(IUnityGraphicsVulkan* unityGraphicsVulkan, VulkanPresentHandler presentHandler);
+
+    /// Was the Vulkan device of Unity created through InterceptVulkanInitialization hooks?
+    bool IsVulkanInitializationIntercepted();
+
+    /**
+     * Description of a swap chain created by Unity.
+     *
+     * \param[in] swapchain The swap chain, VK_NULL_HANDLE for the last one created.
+     * \return Its description (with a VK_NULL_HANDLE swapchain if unknown).
+     */
+    VulkanGraphicsDevice::Swapchain GetInterceptedVulkanSwapchain(VkSwapchainKHR swapchain = VK_NULL_HANDLE);
+}
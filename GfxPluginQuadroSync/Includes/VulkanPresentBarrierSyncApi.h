@@ -0,0 +1,43 @@
+#pragma once
+
+#include "ISyncApi.h"
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief ISyncApi for Vulkan swap chains created with VK_NV_present_barrier enabled.
+     *
+     * The present barrier is a property of the swap chain: once the swap chain has been created with
+     * VkSwapchainPresentBarrierCreateInfoNV::presentBarrierEnable, the driver synchronizes every present with the other
+     * swap chains of the cluster (through the Quadro Sync hardware).  So this implementation simply presents and only
+     * keeps track of the group and barrier ids to answer the queries of PluginCSwapGroupClient.
+     *
+     * \remark Leaving the swap group or unbinding the barrier does not stop the synchronization (it would require the
+     *         swap chain to be recreated by Unity).
+     * \remark There is no frame counter shared by the cluster, QueryFrameCount returns the number of presents done by
+     *         this node since the last ResetFrameCount.
+     */
+    class VulkanPresentBarrierSyncApi final : public ISyncApi
+    {
+    public:
+        const char* GetName() const override { return "VulkanPresentBarrier"; }
+
+        SyncApiStatus Initialize() override { return SyncApiStatus::Ok; }
+        SyncApiStatus SetupWorkstationSwapGroupFeature(bool) override { return SyncApiStatus::Ok; }
+
+        SyncApiStatus QueryMaxSwapGroup(IUnknown* pDevice, uint32_t& maxGroups, uint32_t& maxBarriers) override;
+        SyncApiStatus JoinSwapGroup(IUnknown* pDevice, IDXGISwapChain* pSwapChain, uint32_t group,
+            bool blocking) override;
+        SyncApiStatus BindSwapBarrier(IUnknown* pDevice, uint32_t group, uint32_t barrier) override;
+        SyncApiStatus QuerySwapGroup(IUnknown* pDevice, IDXGISwapChain* pSwapChain, uint32_t& group,
+            uint32_t& barrier) override;
+        SyncApiStatus QueryFrameCount(IUnknown* pDevice, uint32_t& frameCount) override;
+        SyncApiStatus ResetFrameCount(IUnknown* pDevice) override;
+        SyncApiStatus Present(IGraphicsDevice& graphicsDevice) override;
+
+    private:
+        uint32_t m_GroupId = 0;
+        uint32_t m_BarrierId = 0;
+        uint32_t m_PresentCount = 0;
+    };
+}
@@ -0,0 +1,520 @@
+#include "BarrierWarmup.h"
+#include "EventTrace.h"
+#include "Logger.h"
+#include "MessageSerialization.h"
+
+#include <algorithm>
+
+namespace GfxQuadroSync
+{
+    namespace
+    {
+        // Messages exchanged between nodes:
+        // - Header:    uint32 magic, uint8 version, uint8 type.
+        // - Heartbeat: uint8 stage, uint8 padding, uint32 additionalPresentCount.
+        // - Status:    uint8 nodeId, uint8 stage, uint8 completed.
+        // Multi-byte values are little endian.
+        constexpr uint32_t k_MessageMagic = 0x57425147; // "GQBW"
+        constexpr uint8_t k_MessageVersion = 1;
+        constexpr size_t k_HeaderSize = 6;
+        constexpr size_t k_HeartbeatSize = k_HeaderSize + 6;
+        constexpr size_t k_StatusSize = k_HeaderSize + 3;
+        constexpr size_t k_MaxMessageSize = 64;
+
+        enum class MessageType : uint8_t
+        {
+            Heartbeat = 1,
+            Status = 2,
+        };
+
+        size_t WriteHeader(uint8_t* const message, const MessageType type)
+        {
+            WriteUInt32(message, k_MessageMagic);
+            message[4] = k_MessageVersion;
+            message[5] = static_cast<uint8_t>(type);
+            return k_HeaderSize;
+        }
+
+        const char* ToString(const BarrierWarmupStage stage)
+        {
+            switch (stage)
+            {
+            case BarrierWarmupStage::RepeaterFastPresent: return "RepeaterFastPresent";
+            case BarrierWarmupStage::RepeatersPaused: return "RepeatersPaused";
+            case BarrierWarmupStage::LastRepeatersBurst: return "LastRepeatersBurst";
+            case BarrierWarmupStage::Done: return "Done";
+            }
+            return "Unknown";
+        }
+    }
+
+    BarrierWarmup::~BarrierWarmup()
+    {
+        Stop();
+    }
+
+    bool BarrierWarmup::Start(const Config& config, std::unique_ptr<IDatagramTransport> transport)
+    {
+        Stop();
+
+        Lock lock(m_Lock);
+        m_Config = config;
+        m_Transport = std::move(transport);
+        m_StopNetworkThread = false;
+        m_RenderThreadDone = false;
+        m_SendNow = true;
+        m_StartTime = Clock::now();
+        m_EndTime = m_StartTime;
+        m_Deadline = m_StartTime + m_Config.timeout;
+        m_PresentInProgress = false;
+        m_MonitorPresent = false;
+        m_PresentDetectedAsLong = false;
+        m_HasHeartbeat = m_Config.isEmitter;
+        m_HeartbeatStage = BarrierWarmupStage::RepeaterFastPresent;
+        m_HeartbeatAdditionalPresentCount = 0;
+        m_StageCompletedRepeaters.reset();
+        m_RepeaterCompletedSinceLastWait = false;
+        m_PresentsToSkip = m_Config.presentsToSkip;
+        m_PresentWhileRepeatersArePaused = 0;
+        m_StatusStage = BarrierWarmupStage::RepeaterFastPresent;
+        m_StatusCompleted = false;
+        m_AdditionalPresentsDone = 0;
+
+        if (!m_Transport)
+        {
+            CLUSTER_LOG_ERROR << "BarrierWarmup: no transport to communicate with other nodes";
+            m_State = BarrierWarmupState::NetworkFailure;
+            EventTrace::Instance().Write(EventTraceId::WarmupState, static_cast<int64_t>(m_State));
+            return false;
+        }
+
+        CLUSTER_LOG << "BarrierWarmup: starting as " << (m_Config.isEmitter ? "emitter" : "repeater") << " "
+                    << static_cast<int>(m_Config.nodeId);
+        m_State = BarrierWarmupState::InProgress;
+        EventTrace::Instance().Write(EventTraceId::WarmupState, static_cast<int64_t>(m_State));
+        m_NetworkThread = std::thread(&BarrierWarmup::NetworkThreadMain, this);
+        return true;
+    }
+
+    void BarrierWarmup::Abort()
+    {
+        Lock lock(m_Lock);
+        if (m_State == BarrierWarmupState::InProgress)
+        {
+            CLUSTER_LOG_WARNING << "BarrierWarmup: aborted";
+            Conclude(BarrierWarmupState::Aborted);
+        }
+    }
+
+    void BarrierWarmup::Stop()
+    {
+        {
+            Lock lock(m_Lock);
+            if (m_State == BarrierWarmupState::InProgress)
+            {
+                Conclude(BarrierWarmupState::Aborted);
+            }
+            m_StopNetworkThread = true;
+            m_Changed.notify_all();
+        }
+        if (m_NetworkThread.joinable())
+        {
+            m_NetworkThread.join();
+        }
+        m_Transport.reset();
+    }
+
+    void BarrierWarmup::OnPresentStarting()
+    {
+        Lock lock(m_Lock);
+        m_PresentInProgress = true;
+        m_PresentStartTime = Clock::now();
+        m_PresentDetectedAsLong = false;
+    }
+
+    BarrierWarmupAction BarrierWarmup::OnPresentCompleted()
+    {
+        Lock lock(m_Lock);
+        if (m_PresentInProgress)
+        {
+            m_PresentInProgress = false;
+            if (m_MonitorPresent && !m_PresentDetectedAsLong)
+            {
+                // Network thread might not have had the chance to detect it, or it is a normal present of the emitter.
+                if (Clock::now() - m_PresentStartTime >= m_Config.blockDelay)
+                {
+                    m_PresentDetectedAsLong = true;
+                    OnLongPresent();
+                }
+                else if (m_Config.isEmitter)
+                {
+                    ++m_PresentWhileRepeatersArePaused;
+                }
+            }
+        }
+        m_MonitorPresent = false;
+
+        if (m_State != BarrierWarmupState::InProgress || m_RenderThreadDone)
+        {
+            return BarrierWarmupAction::ContinueToNextFrame;
+        }
+
+        for (;;)
+        {
+            const auto action = m_Config.isEmitter ? EmitterStep(lock) : RepeaterStep(lock);
+            if (m_State != BarrierWarmupState::InProgress && !m_RenderThreadDone)
+            {
+                // Failed while waiting for other nodes.
+                return BarrierWarmupAction::ContinueToNextFrame;
+            }
+            if (action != k_StepAgain)
+            {
+                return action;
+            }
+        }
+    }
+
+    BarrierWarmupState BarrierWarmup::GetState() const
+    {
+        Lock lock(m_Lock);
+        return m_State;
+    }
+
+    std::chrono::microseconds BarrierWarmup::GetDuration() const
+    {
+        Lock lock(m_Lock);
+        const auto endTime = m_State == BarrierWarmupState::InProgress ? Clock::now() : m_EndTime;
+        return std::chrono::duration_cast<std::chrono::microseconds>(endTime - m_StartTime);
+    }
+
+    uint32_t BarrierWarmup::GetPresentWhileRepeatersArePausedCount() const
+    {
+        Lock lock(m_Lock);
+        return m_PresentWhileRepeatersArePaused;
+    }
+
+    BarrierWarmupAction BarrierWarmup::EmitterStep(Lock& lock)
+    {
+        switch (m_HeartbeatStage)
+        {
+        case BarrierWarmupStage::RepeaterFastPresent:
+            if (m_PresentsToSkip > 0)
+            {
+                --m_PresentsToSkip;
+                return BarrierWarmupAction::ContinueToNextFrame;
+            }
+            if (m_Config.repeaters.none())
+            {
+                // Nobody to synchronize with.
+                SetHeartbeat(BarrierWarmupStage::Done);
+                return ConcludeRenderThread();
+            }
+            if (AllRepeatersCompleted())
+            {
+                // Give the time to the last repeaters to complete to get blocked in their present.
+                const auto waitEnd = Clock::now() + m_Config.blockDelay;
+                m_Changed.wait_until(lock, waitEnd,
+                    [this] { return m_State != BarrierWarmupState::InProgress; });
+                SetHeartbeat(BarrierWarmupStage::RepeatersPaused);
+                return k_StepAgain;
+            }
+            // Present as slowly as possible to be sure repeaters are blocked by the barrier (but still present
+            // regularly in case a repeater was blocked by a previous present of the emitter).
+            WaitForRepeaterCompletion(lock, 2 * m_Config.blockDelay);
+            return AllRepeatersCompleted() ? k_StepAgain : BarrierWarmupAction::RepeatPresent;
+        case BarrierWarmupStage::RepeatersPaused:
+            if (AllRepeatersCompleted())
+            {
+                // Every repeater is blocked, presents until one of our presents gets blocked.
+                m_MonitorPresent = true;
+                return BarrierWarmupAction::RepeatPresent;
+            }
+            WaitForRepeaterCompletion(lock, m_Deadline - Clock::now());
+            return k_StepAgain;
+        case BarrierWarmupStage::LastRepeatersBurst:
+            if (AllRepeatersCompleted())
+            {
+                SetHeartbeat(BarrierWarmupStage::Done);
+                return ConcludeRenderThread();
+            }
+            WaitForRepeaterCompletion(lock, m_Deadline - Clock::now());
+            return k_StepAgain;
+        case BarrierWarmupStage::Done:
+            break;
+        }
+        return ConcludeRenderThread();
+    }
+
+    BarrierWarmupAction BarrierWarmup::RepeaterStep(Lock& lock)
+    {
+        switch (m_HeartbeatStage)
+        {
+        case BarrierWarmupStage::RepeaterFastPresent:
+            if (!m_StatusCompleted)
+            {
+                m_MonitorPresent = true;
+            }
+            return BarrierWarmupAction::RepeatPresent;
+        case BarrierWarmupStage::RepeatersPaused:
+            // Network thread answers the emitter, we only have to wait for it to release us.
+            m_Changed.wait_until(lock, m_Deadline, [this]
+                {
+                    return m_State != BarrierWarmupState::InProgress ||
+                        m_HeartbeatStage != BarrierWarmupStage::RepeatersPaused;
+                });
+            return k_StepAgain;
+        case BarrierWarmupStage::LastRepeatersBurst:
+        case BarrierWarmupStage::Done:
+            if (m_StatusStage != BarrierWarmupStage::LastRepeatersBurst)
+            {
+                SetStatus(BarrierWarmupStage::LastRepeatersBurst, false);
+            }
+            else
+            {
+                ++m_AdditionalPresentsDone;
+            }
+            if (m_AdditionalPresentsDone < m_HeartbeatAdditionalPresentCount)
+            {
+                return BarrierWarmupAction::RepeatPresent;
+            }
+            SetStatus(BarrierWarmupStage::LastRepeatersBurst, true);
+            return ConcludeRenderThread();
+        }
+        return BarrierWarmupAction::RepeatPresent;
+    }
+
+    BarrierWarmupAction BarrierWarmup::ConcludeRenderThread()
+    {
+        if (m_State == BarrierWarmupState::InProgress)
+        {
+            Conclude(BarrierWarmupState::Succeeded);
+        }
+        m_RenderThreadDone = true;
+        return BarrierWarmupAction::BarrierWarmedUp;
+    }
+
+    void BarrierWarmup::OnLongPresent()
+    {
+        if (m_Config.isEmitter)
+        {
+            if (m_HeartbeatStage == BarrierWarmupStage::RepeatersPaused)
+            {
+                ++m_PresentWhileRepeatersArePaused;
+                SetHeartbeat(BarrierWarmupStage::LastRepeatersBurst, m_PresentWhileRepeatersArePaused / 2);
+            }
+        }
+        else if (m_StatusStage == BarrierWarmupStage::RepeaterFastPresent && !m_StatusCompleted)
+        {
+            SetStatus(BarrierWarmupStage::RepeaterFastPresent, true);
+        }
+    }
+
+    bool BarrierWarmup::AllRepeatersCompleted() const
+    {
+        return (m_StageCompletedRepeaters & m_Config.repeaters) == m_Config.repeaters;
+    }
+
+    void BarrierWarmup::WaitForRepeaterCompletion(Lock& lock, const Clock::duration maxWait)
+    {
+        m_Changed.wait_for(lock, std::max(maxWait, Clock::duration::zero()), [this]
+            {
+                return m_State != BarrierWarmupState::InProgress || m_RepeaterCompletedSinceLastWait;
+            });
+        m_RepeaterCompletedSinceLastWait = false;
+    }
+
+    void BarrierWarmup::SetHeartbeat(const BarrierWarmupStage stage, const uint32_t additionalPresentCount)
+    {
+        CLUSTER_LOG << "BarrierWarmup: emitter moving to " << ToString(stage) << " (additional presents: "
+                    << additionalPresentCount << ")";
+        EventTrace::Instance().Write(EventTraceId::WarmupStage, static_cast<int64_t>(stage), 1, additionalPresentCount);
+        m_HeartbeatStage = stage;
+        m_HeartbeatAdditionalPresentCount = additionalPresentCount;
+        m_StageCompletedRepeaters.reset();
+        m_RepeaterCompletedSinceLastWait = false;
+        m_SendNow = true;
+    }
+
+    void BarrierWarmup::SetStatus(const BarrierWarmupStage stage, const bool completed)
+    {
+        EventTrace::Instance().Write(EventTraceId::WarmupStage, static_cast<int64_t>(stage), 0, completed ? 1 : 0);
+        m_StatusStage = stage;
+        m_StatusCompleted = completed;
+        m_SendNow = true;
+    }
+
+    void BarrierWarmup::Conclude(const BarrierWarmupState state)
+    {
+        m_State = state;
+        m_EndTime = Clock::now();
+        EventTrace::Instance().Write(EventTraceId::WarmupState, static_cast<int64_t>(state));
+        CLUSTER_LOG << "BarrierWarmup: concluded with state " << static_cast<uint32_t>(state) << " after "
+                    << std::chrono::duration_cast<std::chrono::milliseconds>(m_EndTime - m_StartTime).count() << " ms";
+        m_Changed.notify_all();
+    }
+
+    void BarrierWarmup::NetworkThreadMain()
+    {
+        // Don't wait on the socket for too long so that state changes of the render thread are sent quickly.
+        const auto maxReceiveWait = std::max<Clock::duration>(m_Config.repeatMessageInterval / 5,
+            std::chrono::milliseconds(1));
+        bool loggedReceiveError = false;
+        auto nextSend = Clock::now();
+        uint8_t message[k_MaxMessageSize];
+
+        Lock lock(m_Lock);
+        while (!m_StopNetworkThread)
+        {
+            const auto now = Clock::now();
+            if (m_State == BarrierWarmupState::InProgress && now >= m_Deadline)
+            {
+                CLUSTER_LOG_ERROR << "BarrierWarmup: timeout (emitter stage " << ToString(m_HeartbeatStage)
+                                  << ", repeater stage " << ToString(m_StatusStage) << ")";
+                Conclude(BarrierWarmupState::Timeout);
+            }
+            if (IsNetworkThreadDone(now))
+            {
+                break;
+            }
+
+            // Detect presents blocked by the barrier while the render thread is stuck in them.
+            auto wakeUpTime = std::min(now + maxReceiveWait, nextSend);
+            if (m_PresentInProgress && m_MonitorPresent && !m_PresentDetectedAsLong)
+            {
+                const auto longPresentTime = m_PresentStartTime + m_Config.blockDelay;
+                if (now >= longPresentTime)
+                {
+                    m_PresentDetectedAsLong = true;
+                    OnLongPresent();
+                }
+                else
+                {
+                    wakeUpTime = std::min(wakeUpTime, longPresentTime);
+                }
+            }
+
+            if (m_SendNow || now >= nextSend)
+            {
+                const auto messageSize = BuildMessage(message);
+                m_SendNow = false;
+                nextSend = now + m_Config.repeatMessageInterval;
+                lock.unlock();
+                m_Transport->Send(message, messageSize);
+                lock.lock();
+                continue;
+            }
+
+            lock.unlock();
+            const auto timeout = std::chrono::duration_cast<std::chrono::microseconds>(wakeUpTime - now);
+            const int received = m_Transport->Receive(message, sizeof(message),
+                std::max(timeout, std::chrono::microseconds::zero()));
+            lock.lock();
+            if (received > 0)
+            {
+                ProcessMessage(message, received);
+            }
+            else if (received < 0)
+            {
+                if (!loggedReceiveError)
+                {
+                    CLUSTER_LOG_WARNING << "BarrierWarmup: failed to receive from other nodes";
+                    loggedReceiveError = true;
+                }
+                // Avoid spinning on a persistent error, timeout will conclude the warmup.
+                m_Changed.wait_for(lock, maxReceiveWait, [this] { return m_StopNetworkThread; });
+            }
+        }
+    }
+
+    bool BarrierWarmup::IsNetworkThreadDone(const Clock::time_point now) const
+    {
+        switch (m_State)
+        {
+        case BarrierWarmupState::InProgress:
+            return false;
+        case BarrierWarmupState::Succeeded:
+            // Emitter lingers to send the last heartbeat to repeaters that lost it while repeaters continue to send
+            // their status until they get that last heartbeat (or we reach the deadline).
+            if (m_Config.isEmitter)
+            {
+                return now >= m_EndTime + m_Config.lingerDuration;
+            }
+            return m_HeartbeatStage == BarrierWarmupStage::Done || now >= m_Deadline;
+        default:
+            return true;
+        }
+    }
+
+    size_t BarrierWarmup::BuildMessage(uint8_t* const message) const
+    {
+        if (m_Config.isEmitter)
+        {
+            WriteHeader(message, MessageType::Heartbeat);
+            message[k_HeaderSize] = static_cast<uint8_t>(m_HeartbeatStage);
+            message[k_HeaderSize + 1] = 0;
+            WriteUInt32(message + k_HeaderSize + 2, m_HeartbeatAdditionalPresentCount);
+            return k_HeartbeatSize;
+        }
+
+        WriteHeader(message, MessageType::Status);
+        message[k_HeaderSize] = m_Config.nodeId;
+        message[k_HeaderSize + 1] = static_cast<uint8_t>(m_StatusStage);
+        message[k_HeaderSize + 2] = m_StatusCompleted ? 1 : 0;
+        return k_StatusSize;
+    }
+
+    void BarrierWarmup::ProcessMessage(const uint8_t* const message, const int size)
+    {
+        if (size < static_cast<int>(k_HeaderSize) || ReadUInt32(message) != k_MessageMagic ||
+            message[4] != k_MessageVersion)
+        {
+            return;
+        }
+
+        const auto type = static_cast<MessageType>(message[5]);
+        if (type == MessageType::Status && m_Config.isEmitter && size >= static_cast<int>(k_StatusSize))
+        {
+            const uint8_t nodeId = message[k_HeaderSize];
+            const auto stage = static_cast<BarrierWarmupStage>(message[k_HeaderSize + 1]);
+            const bool completed = message[k_HeaderSize + 2] != 0;
+            if (stage == BarrierWarmupStage::LastRepeatersBurst && m_HeartbeatStage == BarrierWarmupStage::Done)
+            {
+                // Repeater has not received our last heartbeat yet.
+                m_SendNow = true;
+            }
+            else if (completed && stage == m_HeartbeatStage && !m_StageCompletedRepeaters.test(nodeId))
+            {
+                // Remarks: Status of a previous stage might still be in flight, this is why we check the stage.
+                m_StageCompletedRepeaters.set(nodeId);
+                m_RepeaterCompletedSinceLastWait = true;
+                m_Changed.notify_all();
+            }
+        }
+        else if (type == MessageType::Heartbeat && !m_Config.isEmitter && size >= static_cast<int>(k_HeartbeatSize))
+        {
+            const auto stage = static_cast<BarrierWarmupStage>(message[k_HeaderSize]);
+            const uint32_t additionalPresentCount = ReadUInt32(message + k_HeaderSize + 2);
+            if (stage > BarrierWarmupStage::Done ||
+                (m_HasHeartbeat && stage == m_HeartbeatStage &&
+                    additionalPresentCount == m_HeartbeatAdditionalPresentCount))
+            {
+                return;
+            }
+            if (m_HasHeartbeat && stage < m_HeartbeatStage)
+            {
+                // Heartbeat of a previous stage delivered late.
+                return;
+            }
+
+            m_HasHeartbeat = true;
+            m_HeartbeatStage = stage;
+            m_HeartbeatAdditionalPresentCount = additionalPresentCount;
+            if (stage == BarrierWarmupStage::RepeatersPaused)
+            {
+                // We are blocked in a present waiting on the emitter, let it know we are ready.
+                SetStatus(BarrierWarmupStage::RepeatersPaused, true);
+            }
+            m_Changed.notify_all();
+        }
+    }
+}
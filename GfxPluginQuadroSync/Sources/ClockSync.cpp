@@ -0,0 +1,290 @@
+#include "ClockSync.h"
+#include "Logger.h"
+#include "MessageSerialization.h"
+
+#include <algorithm>
+
+namespace GfxQuadroSync
+{
+    namespace
+    {
+        // Messages exchanged between nodes:
+        // - Header: uint32 magic, uint8 version, uint8 type.
+        // - Probe:  uint8 nodeId, uint32 sequence, uint64 t1.
+        // - Answer: uint8 nodeId (of the probe), uint32 sequence, uint64 t1, uint64 t2, uint64 t3.
+        // Multi-byte values are little endian, times are in nanoseconds.
+        constexpr uint32_t k_MessageMagic = 0x53435147; // "GQCS"
+        constexpr uint8_t k_MessageVersion = 1;
+        constexpr size_t k_HeaderSize = 6;
+        constexpr size_t k_ProbeSize = k_HeaderSize + 13;
+        constexpr size_t k_AnswerSize = k_HeaderSize + 29;
+        constexpr size_t k_MaxMessageSize = 64;
+
+        /// Maximum time the network thread waits for a message (so that it stops quickly).
+        constexpr std::chrono::milliseconds k_MaxReceiveWait{10};
+
+        enum class MessageType : uint8_t
+        {
+            Probe = 1,
+            Answer = 2,
+        };
+
+        size_t WriteHeader(uint8_t* const message, const MessageType type)
+        {
+            WriteUInt32(message, k_MessageMagic);
+            message[4] = k_MessageVersion;
+            message[5] = static_cast<uint8_t>(type);
+            return k_HeaderSize;
+        }
+    }
+
+    ClockSync::~ClockSync()
+    {
+        Stop();
+    }
+
+    bool ClockSync::Start(const Config& config, std::unique_ptr<IDatagramTransport> transport)
+    {
+        Stop();
+
+        Lock lock(m_Lock);
+        m_Config = config;
+        m_Config.sampleWindow = std::max(m_Config.sampleWindow, 1u);
+        m_Transport = std::move(transport);
+        m_StopNetworkThread = false;
+        m_Samples.clear();
+        m_BestSample = {};
+        m_SampleCount = 0;
+        m_ProbeCount = 0;
+
+        if (!m_Transport)
+        {
+            CLUSTER_LOG_ERROR << "ClockSync: no transport to communicate with other nodes";
+            return false;
+        }
+
+        CLUSTER_LOG << "ClockSync: starting as " << (m_Config.isEmitter ? "emitter" : "repeater") << " "
+                    << static_cast<int>(m_Config.nodeId);
+        m_Running = true;
+        m_NetworkThread = std::thread(&ClockSync::NetworkThreadMain, this);
+        return true;
+    }
+
+    void ClockSync::Stop()
+    {
+        {
+            Lock lock(m_Lock);
+            m_StopNetworkThread = true;
+            m_Changed.notify_all();
+        }
+        if (m_NetworkThread.joinable())
+        {
+            m_NetworkThread.join();
+        }
+        m_Transport.reset();
+
+        Lock lock(m_Lock);
+        m_Running = false;
+    }
+
+    bool ClockSync::IsRunning() const
+    {
+        Lock lock(m_Lock);
+        return m_Running;
+    }
+
+    int64_t ClockSync::GetLocalTimeNs() const
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count() +
+            m_Config.injectedOffset.count();
+    }
+
+    ClockSync::Estimate ClockSync::GetEstimate() const
+    {
+        const auto nowNs = GetLocalTimeNs();
+        Lock lock(m_Lock);
+        return ComputeEstimate(nowNs);
+    }
+
+    bool ClockSync::ToClusterTime(const int64_t localTimeNs, int64_t& clusterTimeNs) const
+    {
+        Lock lock(m_Lock);
+        if (!m_Config.isEmitter && m_SampleCount == 0)
+        {
+            return false;
+        }
+        clusterTimeNs = localTimeNs + m_BestSample.offsetNs;
+        return true;
+    }
+
+    bool ClockSync::ToLocalTime(const int64_t clusterTimeNs, int64_t& localTimeNs) const
+    {
+        Lock lock(m_Lock);
+        if (!m_Config.isEmitter && m_SampleCount == 0)
+        {
+            return false;
+        }
+        localTimeNs = clusterTimeNs - m_BestSample.offsetNs;
+        return true;
+    }
+
+    uint64_t ClockSync::GetProbeCount() const
+    {
+        Lock lock(m_Lock);
+        return m_ProbeCount;
+    }
+
+    ClockSync::Estimate ClockSync::ComputeEstimate(const int64_t nowNs) const
+    {
+        Estimate estimate;
+        estimate.sampleCount = m_SampleCount;
+        if (m_Config.isEmitter)
+        {
+            estimate.valid = true;
+            return estimate;
+        }
+        if (m_SampleCount == 0)
+        {
+            return estimate;
+        }
+
+        const auto ageNs = std::max<int64_t>(nowNs - m_BestSample.timeNs, 0);
+        estimate.valid = true;
+        estimate.offsetNs = m_BestSample.offsetNs;
+        estimate.roundTripNs = m_BestSample.roundTripNs;
+        estimate.uncertaintyNs = m_BestSample.roundTripNs / 2 +
+            static_cast<int64_t>(static_cast<double>(ageNs) * m_Config.maxDriftPpm / 1000000.0);
+        return estimate;
+    }
+
+    void ClockSync::NetworkThreadMain()
+    {
+        bool loggedReceiveError = false;
+        uint32_t nextSequence = 0;
+        auto nextProbe = Clock::now();
+        uint8_t message[k_MaxMessageSize];
+
+        for (;;)
+        {
+            {
+                Lock lock(m_Lock);
+                if (m_StopNetworkThread)
+                {
+                    break;
+                }
+            }
+
+            const auto now = Clock::now();
+            auto wakeUpTime = now + k_MaxReceiveWait;
+            if (!m_Config.isEmitter)
+            {
+                if (now >= nextProbe)
+                {
+                    SendProbe(nextSequence++);
+                    nextProbe = now + m_Config.probeInterval;
+                }
+                wakeUpTime = std::min(wakeUpTime, nextProbe);
+            }
+
+            const auto timeout = std::chrono::duration_cast<std::chrono::microseconds>(wakeUpTime - Clock::now());
+            const int received = m_Transport->Receive(message, sizeof(message),
+                std::max(timeout, std::chrono::microseconds::zero()));
+            const auto receiveTimeNs = GetLocalTimeNs();
+            if (received < 0)
+            {
+                if (!loggedReceiveError)
+                {
+                    CLUSTER_LOG_WARNING << "ClockSync: failed to receive from other nodes";
+                    loggedReceiveError = true;
+                }
+                // Avoid spinning on a persistent error.
+                Lock lock(m_Lock);
+                m_Changed.wait_for(lock, k_MaxReceiveWait, [this] { return m_StopNetworkThread; });
+                continue;
+            }
+            if (received < static_cast<int>(k_HeaderSize) || ReadUInt32(message) != k_MessageMagic ||
+                message[4] != k_MessageVersion)
+            {
+                continue;
+            }
+
+            const auto type = static_cast<MessageType>(message[5]);
+            if (m_Config.isEmitter && type == MessageType::Probe && received >= static_cast<int>(k_ProbeSize))
+            {
+                AnswerProbe(message, receiveTimeNs);
+            }
+            else if (!m_Config.isEmitter && type == MessageType::Answer && received >= static_cast<int>(k_AnswerSize))
+            {
+                ProcessAnswer(message, receiveTimeNs);
+            }
+        }
+    }
+
+    void ClockSync::SendProbe(const uint32_t sequence)
+    {
+        uint8_t message[k_ProbeSize];
+        auto offset = WriteHeader(message, MessageType::Probe);
+        message[offset++] = m_Config.nodeId;
+        WriteUInt32(message + offset, sequence);
+        WriteUInt64(message + offset + 4, static_cast<uint64_t>(GetLocalTimeNs()));
+        Send(message, sizeof(message));
+
+        Lock lock(m_Lock);
+        ++m_ProbeCount;
+    }
+
+    void ClockSync::AnswerProbe(const uint8_t* const probe, const int64_t receiveTimeNs)
+    {
+        uint8_t message[k_AnswerSize];
+        auto offset = WriteHeader(message, MessageType::Answer);
+        // Remarks: nodeId, sequence and t1 are simply echoed.
+        std::copy_n(probe + k_HeaderSize, 13, message + offset);
+        offset += 13;
+        WriteUInt64(message + offset, static_cast<uint64_t>(receiveTimeNs));
+        WriteUInt64(message + offset + 8, static_cast<uint64_t>(GetLocalTimeNs()));
+        Send(message, sizeof(message));
+
+        Lock lock(m_Lock);
+        ++m_ProbeCount;
+    }
+
+    void ClockSync::ProcessAnswer(const uint8_t* const message, const int64_t receiveTimeNs)
+    {
+        if (message[k_HeaderSize] != m_Config.nodeId)
+        {
+            return; // Answer to another repeater
+        }
+        const auto t1 = static_cast<int64_t>(ReadUInt64(message + k_HeaderSize + 5));
+        const auto t2 = static_cast<int64_t>(ReadUInt64(message + k_HeaderSize + 13));
+        const auto t3 = static_cast<int64_t>(ReadUInt64(message + k_HeaderSize + 21));
+        const auto t4 = receiveTimeNs;
+
+        Sample sample;
+        sample.roundTripNs = (t4 - t1) - (t3 - t2);
+        if (t1 > t4 || t2 > t3 || sample.roundTripNs < 0)
+        {
+            return; // Corrupted or answer to a probe from a previous run
+        }
+        sample.offsetNs = ((t2 - t1) + (t3 - t4)) / 2;
+        sample.timeNs = t4;
+
+        Lock lock(m_Lock);
+        m_Samples.push_back(sample);
+        if (m_Samples.size() > m_Config.sampleWindow)
+        {
+            m_Samples.pop_front();
+        }
+        m_BestSample = *std::min_element(m_Samples.begin(), m_Samples.end(),
+            [](const Sample& a, const Sample& b) { return a.roundTripNs < b.roundTripNs; });
+        ++m_SampleCount;
+    }
+
+    void ClockSync::Send(const uint8_t* const message, const size_t size)
+    {
+        if (m_Config.injectedSendDelay.count() > 0)
+        {
+            std::this_thread::sleep_for(m_Config.injectedSendDelay);
+        }
+        m_Transport->Send(message, size);
+    }
+}
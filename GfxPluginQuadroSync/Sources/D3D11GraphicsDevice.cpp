@@ -45,6 +45,17 @@ namespace GfxQuadroSync
         return ComSharedPtr<ID3D11Texture2D>(compatibleTexture);
     }
 
+    SavedFrameDescription GetSavedFrameDescription(const D3D11_TEXTURE2D_DESC& backBufferDesc)
+    {
+        SavedFrameDescription savedFrameDescription;
+        savedFrameDescription.width = backBufferDesc.Width;
+        savedFrameDescription.height = backBufferDesc.Height;
+        savedFrameDescription.format = static_cast<uint32_t>(backBufferDesc.Format);
+        savedFrameDescription.sampleCount = backBufferDesc.SampleDesc.Count;
+        savedFrameDescription.backBufferCount = 1;
+        return savedFrameDescription;
+    }
+
     D3D11GraphicsDevice::D3D11GraphicsDevice(
         ID3D11Device* const device,
         IDXGISwapChain* const swapChain,
@@ -57,23 +68,49 @@ namespace GfxQuadroSync
     {
     }
 
+    bool D3D11GraphicsDevice::Present()
+    {
+        const auto hr = m_SwapChain->Present(m_SyncInterval, m_PresentFlags);
+        if (FAILED(hr))
+        {
+            CLUSTER_LOG_ERROR << "IDXGISwapChain::Present failed: " << hr;
+            return false;
+        }
+        return true;
+    }
+
+    void D3D11GraphicsDevice::SetDevice(IUnknown* const device)
+    {
+        // Resources kept between warmups belong to the previous device.
+        if (device != m_D3D11Device)
+        {
+            FreeSavedFrame();
+        }
+        m_D3D11Device = static_cast<ID3D11Device*>(device);
+    }
+
     void D3D11GraphicsDevice::InitiatePresentRepeats()
     {
-        if (m_BackBufferTexture || m_BackBufferRenderTargetView || m_DeviceContext || m_SavedToPresent)
+        if (m_BackBufferTexture || m_BackBufferRenderTargetView)
         {
             CLUSTER_LOG_ERROR << "SaveToPresent called multiple times without calling FreeSavedToPresent";
             return;
         }
 
-        m_BackBufferTexture = GetBackBufferTexture(m_SwapChain);
-        m_BackBufferRenderTargetView = CreateRenderTargetView(m_D3D11Device, m_BackBufferTexture);
-        m_SavedToPresent = CreateCompatibleTexture(m_D3D11Device, m_BackBufferTexture);
+        try
+        {
+            m_BackBufferTexture = GetBackBufferTexture(m_SwapChain);
+            m_BackBufferRenderTargetView = CreateRenderTargetView(m_D3D11Device, m_BackBufferTexture);
 
+            EnsureSavedFrame(m_BackBufferTexture, true);
+        }
+        catch (const std::exception&)
         {
-            ID3D11DeviceContext* deviceContext;
-            m_D3D11Device->GetImmediateContext(&deviceContext);
-            m_DeviceContext.reset(deviceContext);
+            ConcludePresentRepeats();
+            FreeSavedFrame();
+            return;
         }
+
         ID3D11RenderTargetView* const renderTargetViews[] = {m_BackBufferRenderTargetView.get()};
         m_DeviceContext->OMSetRenderTargets(1, renderTargetViews, nullptr);
 
@@ -90,9 +127,88 @@ namespace GfxQuadroSync
 
     void D3D11GraphicsDevice::ConcludePresentRepeats()
     {
-        m_DeviceContext.reset();
-        m_SavedToPresent.reset();
+        // Remarks: The saved texture is kept for the next warmup, but nothing referencing the back buffer can be kept
+        // (IDXGISwapChain::ResizeBuffers fails while there are references to it).
         m_BackBufferRenderTargetView.reset();
         m_BackBufferTexture.reset();
     }
+
+    void D3D11GraphicsDevice::SaveFrameToHold()
+    {
+        // Remarks: The frame saved by the barrier warmup is the one being presented, nothing else to do.
+        if (m_BackBufferTexture)
+        {
+            m_HeldFrameSaved = true;
+            return;
+        }
+
+        try
+        {
+            const auto backBufferTexture = GetBackBufferTexture(m_SwapChain);
+            EnsureSavedFrame(backBufferTexture, false);
+            m_DeviceContext->CopyResource(m_SavedToPresent.get(), backBufferTexture.get());
+            m_HeldFrameSaved = true;
+        }
+        catch (const std::exception&)
+        {
+            m_HeldFrameSaved = false;
+        }
+    }
+
+    bool D3D11GraphicsDevice::PrepareHeldFramePresent()
+    {
+        if (!m_HeldFrameSaved || !m_SavedToPresent || !m_DeviceContext)
+        {
+            return false;
+        }
+
+        try
+        {
+            const auto backBufferTexture = GetBackBufferTexture(m_SwapChain);
+            D3D11_TEXTURE2D_DESC backBufferDesc;
+            backBufferTexture->GetDesc(&backBufferDesc);
+            if (!m_SavedFrameCache.Matches(GetSavedFrameDescription(backBufferDesc)))
+            {
+                // Back buffer was resized since the frame was saved.
+                m_HeldFrameSaved = false;
+                return false;
+            }
+            m_DeviceContext->CopyResource(backBufferTexture.get(), m_SavedToPresent.get());
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+        return true;
+    }
+
+    void D3D11GraphicsDevice::EnsureSavedFrame(const ComSharedPtr<ID3D11Texture2D>& backBuffer, const bool countReuse)
+    {
+        D3D11_TEXTURE2D_DESC backBufferDesc;
+        backBuffer->GetDesc(&backBufferDesc);
+        const auto savedFrameDescription = GetSavedFrameDescription(backBufferDesc);
+        const auto reusable = countReuse ? m_SavedFrameCache.TryReuse(savedFrameDescription) :
+            m_SavedFrameCache.Matches(savedFrameDescription);
+        if (!reusable)
+        {
+            FreeSavedFrame();
+            m_SavedToPresent = CreateCompatibleTexture(m_D3D11Device, backBuffer);
+            m_SavedFrameCache.OnAllocated(savedFrameDescription);
+        }
+
+        if (!m_DeviceContext)
+        {
+            ID3D11DeviceContext* deviceContext;
+            m_D3D11Device->GetImmediateContext(&deviceContext);
+            m_DeviceContext.reset(deviceContext);
+        }
+    }
+
+    void D3D11GraphicsDevice::FreeSavedFrame()
+    {
+        m_DeviceContext.reset();
+        m_SavedToPresent.reset();
+        m_SavedFrameCache.OnReleased();
+        m_HeldFrameSaved = false;
+    }
 }
@@ -78,6 +78,31 @@ namespace GfxQuadroSync
 
             return ComSharedPtr<ID3D12Resource>(savedTexture);
         }
+
+        SavedFrameDescription GetSavedFrameDescription(const D3D12_RESOURCE_DESC& backBufferDesc,
+            const UINT backBufferCount)
+        {
+            SavedFrameDescription savedFrameDescription;
+            savedFrameDescription.width = backBufferDesc.Width;
+            savedFrameDescription.height = backBufferDesc.Height;
+            savedFrameDescription.format = static_cast<uint32_t>(backBufferDesc.Format);
+            savedFrameDescription.sampleCount = backBufferDesc.SampleDesc.Count;
+            savedFrameDescription.backBufferCount = backBufferCount;
+            return savedFrameDescription;
+        }
+
+        D3D12_RESOURCE_BARRIER TransitionBarrier(ID3D12Resource* const resource, const D3D12_RESOURCE_STATES before,
+            const D3D12_RESOURCE_STATES after)
+        {
+            D3D12_RESOURCE_BARRIER barrier;
+            barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+            barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+            barrier.Transition.pResource = resource;
+            barrier.Transition.StateBefore = before;
+            barrier.Transition.StateAfter = after;
+            barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+            return barrier;
+        }
     }
 
     D3D12GraphicsDevice::D3D12GraphicsDevice(
@@ -103,6 +128,13 @@ namespace GfxQuadroSync
 
     void D3D12GraphicsDevice::SetDevice(IUnknown* const device)
     {
+        // Resources kept between warmups belong to the previous device (no present is in flight while the device
+        // changes, see kUnityGfxDeviceEventBeforeReset).
+        if (device != m_D3D12Device.get())
+        {
+            FreeResources();
+            m_AsyncPresentFences.clear();
+        }
         m_D3D12Device.reset(static_cast<ID3D12Device*>(device));
         device->AddRef();
     }
@@ -120,6 +152,17 @@ namespace GfxQuadroSync
         m_SwapChain.reset(swapChain3);
     }
 
+    bool D3D12GraphicsDevice::Present()
+    {
+        const auto hr = m_SwapChain->Present(m_SyncInterval, m_PresentFlags);
+        if (FAILED(hr))
+        {
+            CLUSTER_LOG_ERROR << "IDXGISwapChain::Present failed: " << hr;
+            return false;
+        }
+        return true;
+    }
+
     void D3D12GraphicsDevice::InitiatePresentRepeats()
     {
         if (!m_SwapChain)
@@ -127,7 +170,7 @@ namespace GfxQuadroSync
             return;
         }
 
-        if (m_CommandAllocator || m_CommandList || !m_BackBuffers.empty() || m_SavedTexture)
+        if (!m_BackBuffers.empty())
         {
             CLUSTER_LOG_ERROR << "SaveToPresent called multiple times without calling FreeSavedToPresent";
             return;
@@ -141,40 +184,71 @@ namespace GfxQuadroSync
             CLUSTER_LOG_ERROR << "IDXGISwapChain1::GetDesc1 failed: " << hr;
             return;
         }
-        m_BackBuffers.reserve(swapChainDesc.BufferCount);
-        for (auto backBufferIndex = 0; backBufferIndex < swapChainDesc.BufferCount; ++backBufferIndex)
-        {
-            m_BackBuffers.push_back(GetSwapChainBuffer(m_SwapChain, backBufferIndex));
-        }
-
-        // Create resources
         auto backBufferIndex = m_SwapChain->GetCurrentBackBufferIndex();
         try
         {
-            m_CommandAllocator = CreateCommandAllocator(m_D3D12Device);
-            m_CommandAllocator->SetName(L"GfxPluginQuadroSync CommandAllocator");
-            m_CommandList = CreateCommandList(m_D3D12Device, m_CommandAllocator);
-            m_CommandList->SetName(L"GfxPluginQuadroSync CommandList");
-            m_SavedTexture = CreateCompatibleBuffer(m_D3D12Device, m_BackBuffers[backBufferIndex]);
-            m_SavedTexture->SetName(L"GfxPluginQuadroSync SavedTexture");
+            m_BackBuffers.reserve(swapChainDesc.BufferCount);
+            for (UINT bufferIndex = 0; bufferIndex < swapChainDesc.BufferCount; ++bufferIndex)
+            {
+                m_BackBuffers.push_back(GetSwapChainBuffer(m_SwapChain, bufferIndex));
+            }
         }
         catch (const std::exception&)
         {
+            ReleaseBackBuffers();
             return;
         }
 
+        // Create resources (unless the ones of the previous warmup are still compatible with the back buffers)
+        const auto savedFrameDescription = GetSavedFrameDescription(m_BackBuffers[backBufferIndex]->GetDesc(),
+            swapChainDesc.BufferCount);
+        if (m_SavedFrameCache.TryReuse(savedFrameDescription))
+        {
+            if (!ResetCommandList(m_CommandAllocator, m_CommandList))
+            {
+                FreeResources();
+                ReleaseBackBuffers();
+                return;
+            }
+        }
+        else
+        {
+            FreeResources();
+            if (!CreateResources(m_BackBuffers[backBufferIndex], swapChainDesc.BufferCount))
+            {
+                FreeResources();
+                ReleaseBackBuffers();
+                return;
+            }
+            m_SavedFrameCache.OnAllocated(savedFrameDescription);
+        }
+
+        // Commands of every repeat are recorded once per warmup (the back buffers might not be the same as the ones of
+        // the previous warmup), they only have to be executed afterwards.
+        for (UINT repeatIndex = 0; repeatIndex < m_RepeatCommands.size(); ++repeatIndex)
+        {
+            if (!RecordRepeatCommands(repeatIndex))
+            {
+                FreeResources();
+                ReleaseBackBuffers();
+                return;
+            }
+        }
+
         // Copy current backbuffer to a texture we will repeat
+        if (m_SavedTextureState != D3D12_RESOURCE_STATE_COMMON)
+        {
+            const auto copyDestBarrier = TransitionBarrier(m_SavedTexture.get(), m_SavedTextureState,
+                D3D12_RESOURCE_STATE_COPY_DEST);
+            m_CommandList->ResourceBarrier(1, &copyDestBarrier);
+        }
         m_CommandList->CopyResource(m_SavedTexture.get(), m_BackBuffers[backBufferIndex].get());
 
         // Indicate that the texture will become a copy source
-        D3D12_RESOURCE_BARRIER renderTargetBarrier;
-        renderTargetBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        renderTargetBarrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        renderTargetBarrier.Transition.pResource = m_SavedTexture.get();
-        renderTargetBarrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
-        renderTargetBarrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_SOURCE;
-        renderTargetBarrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        m_CommandList->ResourceBarrier(1, &renderTargetBarrier);
+        const auto savedTextureBarrier = TransitionBarrier(m_SavedTexture.get(), D3D12_RESOURCE_STATE_COPY_DEST,
+            D3D12_RESOURCE_STATE_COPY_SOURCE);
+        m_CommandList->ResourceBarrier(1, &savedTextureBarrier);
+        m_SavedTextureState = D3D12_RESOURCE_STATE_COPY_SOURCE;
 
         // Conclude the operations
         m_CommandList->Close();
@@ -183,14 +257,24 @@ namespace GfxQuadroSync
 
         // Wait for copy to be executed (is it really necessary?  Good question, but its safer and we are not in a
         // hurry anyway as this is only executed once at initialization time.)
-        EnsureFenceCreated();
-        QueueUpdateFence();
-        WaitForFence();
+        const UINT64 savedFenceValue = m_RepeatScheduler.GetLastFenceValue() + 1;
+        hr = m_CommandQueue->Signal(m_CommandExecutionDoneFence.get(), savedFenceValue);
+        if (FAILED(hr))
+        {
+            CLUSTER_LOG_WARNING << "ID3D12CommandQueue::Signal failed: " << hr;
+            m_RepeatScheduler.Reset(static_cast<uint32_t>(m_RepeatCommands.size()),
+                m_RepeatScheduler.GetLastFenceValue());
+        }
+        else
+        {
+            WaitForFenceValue(savedFenceValue);
+            m_RepeatScheduler.Reset(static_cast<uint32_t>(m_RepeatCommands.size()), savedFenceValue);
+        }
     }
 
     void D3D12GraphicsDevice::PrepareSinglePresentRepeat()
     {
-        if (!m_SwapChain)
+        if (!m_SwapChain || m_BackBuffers.empty())
         {
             return;
         }
@@ -200,77 +284,304 @@ namespace GfxQuadroSync
             m_FirstRepeatBackBufferIndex = backBufferIndex;
         }
 
-        WaitForFence();
+        m_RepeatScheduler.SubmitRepeat(*this, backBufferIndex);
+    }
+
+    void D3D12GraphicsDevice::ConcludePresentRepeats()
+    {
+        if (!m_SwapChain)
+        {
+            return;
+        }
+
+        // Looks like GetCurrentBackBufferIndex must match the one of the first time we have been called or it
+        // generates problems where Unity then tries to render to a back buffer that is not the current back buffer.
+        // So continue repeating frames and presenting (using the normal present, not Quadro Sync present) until they
+        // match.
+        // Remarks: IDXGISwapChain::Present moves to the next back buffer right away, so there is no need to wait for
+        // the GPU to know the current back buffer index (and the loop is bounded in case presents keep failing).
+        if (!m_BackBuffers.empty() && m_FirstRepeatBackBufferIndex != -1)
+        {
+            for (size_t realignPresentCount = 0; realignPresentCount < m_BackBuffers.size() &&
+                m_SwapChain->GetCurrentBackBufferIndex() != m_FirstRepeatBackBufferIndex; ++realignPresentCount)
+            {
+                PrepareSinglePresentRepeat();
+                auto hr = m_SwapChain->Present(m_SyncInterval, m_PresentFlags);
+                if (FAILED(hr))
+                {
+                    CLUSTER_LOG_ERROR << "IDXGISwapChain::Present failed while re-aligning CurrentBackBufferIndex: "
+                        << hr;
+                }
+            }
+        }
+
+        if (m_RepeatScheduler.GetStallCount() > 0)
+        {
+            CLUSTER_LOG << "D3D12GraphicsDevice: " << m_RepeatScheduler.GetStallCount() << " of "
+                << m_RepeatScheduler.GetSubmittedCount() << " present repeats waited on the GPU";
+        }
 
-        // Prepare the command allocator and list for new commands
-        // Remarks: Need to be kept alive until processing of those commands are done, so we keep it until next frame.
-        m_CommandAllocator->Reset();
-        m_CommandList->Reset(m_CommandAllocator.get(), nullptr);
+        ReleaseBackBuffers();
+    }
+
+    bool D3D12GraphicsDevice::CreateResources(const ComSharedPtr<ID3D12Resource>& backBuffer,
+        const UINT backBufferCount)
+    {
+        try
+        {
+            m_CommandAllocator = CreateCommandAllocator(m_D3D12Device);
+            m_CommandAllocator->SetName(L"GfxPluginQuadroSync CommandAllocator");
+            m_CommandList = CreateCommandList(m_D3D12Device, m_CommandAllocator);
+            m_CommandList->SetName(L"GfxPluginQuadroSync CommandList");
+            m_SavedTexture = CreateCompatibleBuffer(m_D3D12Device, backBuffer);
+            m_SavedTexture->SetName(L"GfxPluginQuadroSync SavedTexture");
+            m_SavedTextureState = D3D12_RESOURCE_STATE_COMMON;
 
-        // Indicate that the back buffer will be used as a render target.
-        D3D12_RESOURCE_BARRIER renderTargetBarrier;
-        renderTargetBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        renderTargetBarrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        renderTargetBarrier.Transition.pResource = m_BackBuffers[backBufferIndex].get();
-        renderTargetBarrier.Transition.StateBefore = D3D12_RESOURCE_STATE_PRESENT;
-        renderTargetBarrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_DEST;
-        renderTargetBarrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        m_CommandList->ResourceBarrier(1, &renderTargetBarrier);
+            m_RepeatCommands.resize(backBufferCount);
+            for (auto& repeatCommands : m_RepeatCommands)
+            {
+                repeatCommands.commandAllocator = CreateCommandAllocator(m_D3D12Device);
+                repeatCommands.commandAllocator->SetName(L"GfxPluginQuadroSync Repeat CommandAllocator");
+                repeatCommands.commandList = CreateCommandList(m_D3D12Device, repeatCommands.commandAllocator);
+                repeatCommands.commandList->SetName(L"GfxPluginQuadroSync Repeat CommandList");
+                // Remarks: Command lists are created in the recording state while RecordRepeatCommands expects them
+                // to be closed (like they are when reused by the next warmup).
+                repeatCommands.commandList->Close();
+            }
+
+            m_FrameHoldCommands.resize(backBufferCount);
+            for (auto& frameHoldCommands : m_FrameHoldCommands)
+            {
+                frameHoldCommands.commandAllocator = CreateCommandAllocator(m_D3D12Device);
+                frameHoldCommands.commandAllocator->SetName(L"GfxPluginQuadroSync FrameHold CommandAllocator");
+                frameHoldCommands.commandList = CreateCommandList(m_D3D12Device, frameHoldCommands.commandAllocator);
+                frameHoldCommands.commandList->SetName(L"GfxPluginQuadroSync FrameHold CommandList");
+                frameHoldCommands.commandList->Close();
+            }
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+
+        EnsureFenceCreated();
+        return IsFenceCreated();
+    }
+
+    bool D3D12GraphicsDevice::ResetCommandList(const ComSharedPtr<ID3D12CommandAllocator>& commandAllocator,
+        const ComSharedPtr<ID3D12GraphicsCommandList>& commandList)
+    {
+        // Remarks: The GPU must be done with the commands previously recorded (ReleaseBackBuffers waited for the ones
+        // of the previous warmup).
+        auto hr = commandAllocator->Reset();
+        if (FAILED(hr))
+        {
+            CLUSTER_LOG_ERROR << "ID3D12CommandAllocator::Reset failed: " << hr;
+            return false;
+        }
+        hr = commandList->Reset(commandAllocator.get(), nullptr);
+        if (FAILED(hr))
+        {
+            CLUSTER_LOG_ERROR << "ID3D12GraphicsCommandList::Reset failed: " << hr;
+            return false;
+        }
+        return true;
+    }
+
+    bool D3D12GraphicsDevice::RecordRepeatCommands(const UINT backBufferIndex)
+    {
+        const auto& repeatCommands = m_RepeatCommands[backBufferIndex];
+        const auto& commandList = repeatCommands.commandList;
+        const auto& backBuffer = m_BackBuffers[backBufferIndex];
+        if (!ResetCommandList(repeatCommands.commandAllocator, commandList))
+        {
+            return false;
+        }
+
+        // Indicate that the back buffer will be used as a copy destination.
+        const auto copyDestBarrier = TransitionBarrier(backBuffer.get(), D3D12_RESOURCE_STATE_PRESENT,
+            D3D12_RESOURCE_STATE_COPY_DEST);
+        commandList->ResourceBarrier(1, &copyDestBarrier);
 
         // Copy the saved texture to it
-        m_CommandList->CopyResource(m_BackBuffers[backBufferIndex].get(), m_SavedTexture.get());
+        commandList->CopyResource(backBuffer.get(), m_SavedTexture.get());
 
         // Indicate that the back buffer will be used to present
-        D3D12_RESOURCE_BARRIER presentBarrier;
-        renderTargetBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        renderTargetBarrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        renderTargetBarrier.Transition.pResource = m_BackBuffers[backBufferIndex].get();
-        renderTargetBarrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
-        renderTargetBarrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PRESENT;
-        renderTargetBarrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        m_CommandList->ResourceBarrier(1, &renderTargetBarrier);
+        const auto presentBarrier = TransitionBarrier(backBuffer.get(), D3D12_RESOURCE_STATE_COPY_DEST,
+            D3D12_RESOURCE_STATE_PRESENT);
+        commandList->ResourceBarrier(1, &presentBarrier);
 
         // Command list is completed
-        m_CommandList->Close();
-        ID3D12CommandList* const commandListsToExecute[] = {m_CommandList.get()};
-        m_CommandQueue->ExecuteCommandLists(1, commandListsToExecute);
+        commandList->Close();
+        return true;
+    }
 
-        // Add a barrier to be signaled when commands are done being processed
-        QueueUpdateFence();
+    void D3D12GraphicsDevice::SaveFrameToHold()
+    {
+        // Remarks: The frame saved by the barrier warmup is the one being presented, nothing else to do.
+        if (!m_BackBuffers.empty())
+        {
+            m_HeldFrameSaved = true;
+            return;
+        }
+        if (!ExecuteFrameHoldCopy(true))
+        {
+            m_HeldFrameSaved = false;
+        }
     }
 
-    void D3D12GraphicsDevice::ConcludePresentRepeats()
+    bool D3D12GraphicsDevice::PrepareHeldFramePresent()
+    {
+        if (!m_SwapChain || !m_HeldFrameSaved || !m_BackBuffers.empty())
+        {
+            return false;
+        }
+
+        // Remarks: When aligned again the next held present starts a new sequence from the current back buffer.
+        const auto backBufferIndex = m_SwapChain->GetCurrentBackBufferIndex();
+        if (GetPendingHeldFramePresentCount() == 0)
+        {
+            m_HoldBackBufferIndex = backBufferIndex;
+        }
+        return ExecuteFrameHoldCopy(false);
+    }
+
+    uint32_t D3D12GraphicsDevice::GetPendingHeldFramePresentCount() const
+    {
+        const auto backBufferCount = static_cast<UINT>(m_FrameHoldCommands.size());
+        if (!m_SwapChain || m_HoldBackBufferIndex == -1 || backBufferCount == 0)
+        {
+            return 0;
+        }
+        return (m_HoldBackBufferIndex + backBufferCount - m_SwapChain->GetCurrentBackBufferIndex()) % backBufferCount;
+    }
+
+    bool D3D12GraphicsDevice::ExecuteFrameHoldCopy(const bool saveBackBuffer)
     {
         if (!m_SwapChain)
         {
-            return;
+            return false;
         }
 
-        // Why do we WaitForFence here, doesn't PrepareSinglePresentRepeat start with a WaitForFence?  Yes it does, but
-        // I wanted to be sure the current back buffer index (returned by the IDXGISwapChain3::GetCurrentBackBufferIndex
-        // call below) would return the index after the previous frame is over and not potentially the previous one.
-        // Is it really necessary?  Not 100% sure, but this code is only executed once during the initialization, so I
-        // prefer to play safe than trying to squeeze every possible bit of speed...
-        WaitForFence();
+        DXGI_SWAP_CHAIN_DESC1 swapChainDesc;
+        auto hr = m_SwapChain->GetDesc1(&swapChainDesc);
+        if (FAILED(hr))
+        {
+            CLUSTER_LOG_ERROR << "IDXGISwapChain1::GetDesc1 failed: " << hr;
+            return false;
+        }
+        const auto backBufferIndex = m_SwapChain->GetCurrentBackBufferIndex();
+        ComSharedPtr<ID3D12Resource> backBuffer;
+        try
+        {
+            backBuffer = GetSwapChainBuffer(m_SwapChain, backBufferIndex);
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
 
-        // Looks like GetCurrentBackBufferIndex must match the one of the first time we have been called or it
-        // generates problems where Unity then tries to render to a back buffer that is not the current back buffer.
-        // So continue repeating frames and presenting (using the normal present, not Quadro Sync present) until they
-        // match.
-        while (m_SwapChain->GetCurrentBackBufferIndex() != m_FirstRepeatBackBufferIndex)
+        const auto savedFrameDescription = GetSavedFrameDescription(backBuffer->GetDesc(), swapChainDesc.BufferCount);
+        if (!m_SavedFrameCache.Matches(savedFrameDescription))
         {
-            PrepareSinglePresentRepeat();
-            auto hr = m_SwapChain->Present(m_SyncInterval, m_PresentFlags);
-            if (FAILED(hr))
+            if (!saveBackBuffer)
+            {
+                // Back buffers were resized since the frame was saved.
+                m_HeldFrameSaved = false;
+                m_HoldBackBufferIndex = -1;
+                return false;
+            }
+            FreeResources();
+            if (!CreateResources(backBuffer, swapChainDesc.BufferCount))
             {
-                CLUSTER_LOG_ERROR << "IDXGISwapChain::Present failed while re-aligning CurrentBackBufferIndex: " << hr;
+                FreeResources();
+                return false;
             }
+            m_SavedFrameCache.OnAllocated(savedFrameDescription);
+        }
 
-            // Same reason for this WaitForFence as the one a few lines above.
-            WaitForFence();
+        // Remarks: The allocator of a back buffer was last used by the previous present to that back buffer, so the
+        // GPU is normally long done with it.
+        auto& frameHoldCommands = m_FrameHoldCommands[backBufferIndex];
+        WaitForFenceValue(frameHoldCommands.fenceValue);
+        if (!ResetCommandList(frameHoldCommands.commandAllocator, frameHoldCommands.commandList))
+        {
+            return false;
         }
 
-        FreeResources();
+        const auto& commandList = frameHoldCommands.commandList;
+        if (saveBackBuffer)
+        {
+            if (m_SavedTextureState != D3D12_RESOURCE_STATE_COMMON)
+            {
+                const auto copyDestBarrier = TransitionBarrier(m_SavedTexture.get(), m_SavedTextureState,
+                    D3D12_RESOURCE_STATE_COPY_DEST);
+                commandList->ResourceBarrier(1, &copyDestBarrier);
+            }
+            commandList->CopyResource(m_SavedTexture.get(), backBuffer.get());
+            const auto copySourceBarrier = TransitionBarrier(m_SavedTexture.get(), D3D12_RESOURCE_STATE_COPY_DEST,
+                D3D12_RESOURCE_STATE_COPY_SOURCE);
+            commandList->ResourceBarrier(1, &copySourceBarrier);
+            m_SavedTextureState = D3D12_RESOURCE_STATE_COPY_SOURCE;
+        }
+        else
+        {
+            const auto copyDestBarrier = TransitionBarrier(backBuffer.get(), D3D12_RESOURCE_STATE_PRESENT,
+                D3D12_RESOURCE_STATE_COPY_DEST);
+            commandList->ResourceBarrier(1, &copyDestBarrier);
+            commandList->CopyResource(backBuffer.get(), m_SavedTexture.get());
+            const auto presentBarrier = TransitionBarrier(backBuffer.get(), D3D12_RESOURCE_STATE_COPY_DEST,
+                D3D12_RESOURCE_STATE_PRESENT);
+            commandList->ResourceBarrier(1, &presentBarrier);
+        }
+        commandList->Close();
+        ID3D12CommandList* const commandListsToExecute[] = {commandList.get()};
+        m_CommandQueue->ExecuteCommandLists(1, commandListsToExecute);
+
+        const auto fenceValue = m_RepeatScheduler.GetLastFenceValue() + 1;
+        hr = m_CommandQueue->Signal(m_CommandExecutionDoneFence.get(), fenceValue);
+        if (FAILED(hr))
+        {
+            CLUSTER_LOG_WARNING << "ID3D12CommandQueue::Signal failed: " << hr;
+            return false;
+        }
+        m_RepeatScheduler.OnOtherWorkSignaled(fenceValue);
+        frameHoldCommands.fenceValue = fenceValue;
+        if (saveBackBuffer)
+        {
+            m_HeldFrameSaved = true;
+        }
+        return true;
+    }
+
+    bool D3D12GraphicsDevice::ExecuteRepeat(const uint32_t backBufferIndex, const uint64_t fenceValue)
+    {
+        ID3D12CommandList* const commandListsToExecute[] = {m_RepeatCommands[backBufferIndex].commandList.get()};
+        m_CommandQueue->ExecuteCommandLists(1, commandListsToExecute);
+
+        // Add a barrier to be signaled when commands are done being processed
+        auto hr = m_CommandQueue->Signal(m_CommandExecutionDoneFence.get(), fenceValue);
+        if (FAILED(hr))
+        {
+            CLUSTER_LOG_WARNING << "ID3D12CommandQueue::Signal failed: " << hr;
+            return false;
+        }
+        return true;
+    }
+
+    uint64_t D3D12GraphicsDevice::GetCompletedFenceValue()
+    {
+        return m_CommandExecutionDoneFence->GetCompletedValue();
+    }
+
+    void D3D12GraphicsDevice::WaitForFenceValue(const uint64_t fenceValue)
+    {
+        if (m_CommandExecutionDoneFence->GetCompletedValue() < fenceValue)
+        {
+            ResetEvent(m_BarrierReachedEvent.get());
+            m_CommandExecutionDoneFence->SetEventOnCompletion(fenceValue, m_BarrierReachedEvent.get());
+            WaitForSingleObject(m_BarrierReachedEvent.get(), INFINITE);
+        }
     }
 
     void D3D12GraphicsDevice::EnsureFenceCreated()
@@ -283,8 +594,8 @@ namespace GfxQuadroSync
         if (!m_CommandExecutionDoneFence)
         {
             ID3D12Fence* commandExecutionDoneFence;
-            auto hr = m_D3D12Device->CreateFence(m_CommandExecutionDoneFenceNextValue - 1, D3D12_FENCE_FLAG_NONE,
-                __uuidof(ID3D12Fence), reinterpret_cast<void**>(&commandExecutionDoneFence));
+            auto hr = m_D3D12Device->CreateFence(0, D3D12_FENCE_FLAG_NONE, __uuidof(ID3D12Fence),
+                reinterpret_cast<void**>(&commandExecutionDoneFence));
             if (FAILED(hr))
             {
                 CLUSTER_LOG_ERROR << "ID3D12Device::CreateFence failed: " << hr;
@@ -295,39 +606,131 @@ namespace GfxQuadroSync
         }
     }
 
-    void D3D12GraphicsDevice::QueueUpdateFence()
+    uint32_t D3D12GraphicsDevice::GetBackBufferCount() const
     {
-        ++m_CommandExecutionDoneFenceNextValue;
-        auto hr = m_CommandQueue->Signal(m_CommandExecutionDoneFence.get(), m_CommandExecutionDoneFenceNextValue);
-        if (FAILED(hr))
+        DXGI_SWAP_CHAIN_DESC1 swapChainDesc;
+        if (!m_SwapChain || FAILED(m_SwapChain->GetDesc1(&swapChainDesc)))
         {
-            CLUSTER_LOG_WARNING << "ID3D12CommandQueue::Signal failed: " << hr;
+            return 0;
+        }
+        return swapChainDesc.BufferCount;
+    }
+
+    uint32_t D3D12GraphicsDevice::OnAsyncPresentQueued()
+    {
+        // Remarks: The swap chain only moves to the next back buffer once the worker presented, so the index we get
+        // from it is only the one of the back buffer handed to the worker when no present is in flight.
+        if (m_AsyncPresentsInFlight.load(std::memory_order_acquire) == 0)
+        {
+            UpdateAsyncPresentFences();
+            m_NextAsyncPresentBackBufferIndex = m_SwapChain->GetCurrentBackBufferIndex();
+        }
+
+        const auto backBufferIndex = m_NextAsyncPresentBackBufferIndex;
+        if (backBufferIndex < m_AsyncPresentFences.size())
+        {
+            ++m_AsyncPresentFences[backBufferIndex].queuedCount;
+            m_NextAsyncPresentBackBufferIndex = (backBufferIndex + 1) % static_cast<UINT>(m_AsyncPresentFences.size());
+        }
+        m_AsyncPresentsInFlight.fetch_add(1, std::memory_order_relaxed);
+        return backBufferIndex;
+    }
+
+    void D3D12GraphicsDevice::OnAsyncPresentDone(const uint32_t backBufferIndex)
+    {
+        // Remarks: Failed presents also signal the fence, the rendering thread would otherwise wait forever (the
+        // index of the next back buffer is fetched again from the swap chain once no present is in flight).
+        if (backBufferIndex < m_AsyncPresentFences.size())
+        {
+            auto& asyncPresentFence = m_AsyncPresentFences[backBufferIndex];
+            const auto hr = m_CommandQueue->Signal(asyncPresentFence.fence.get(), ++asyncPresentFence.doneCount);
+            if (FAILED(hr))
+            {
+                CLUSTER_LOG_ERROR << "ID3D12CommandQueue::Signal failed: " << hr;
+                asyncPresentFence.fence->Signal(asyncPresentFence.doneCount);
+            }
         }
+        m_AsyncPresentsInFlight.fetch_sub(1, std::memory_order_release);
     }
 
-    void D3D12GraphicsDevice::WaitForFence()
+    void D3D12GraphicsDevice::WaitForNextBackBuffer()
     {
-        if (!IsFenceCreated())
+        if (m_NextAsyncPresentBackBufferIndex >= m_AsyncPresentFences.size())
         {
             return;
         }
 
-        if (m_CommandExecutionDoneFence->GetCompletedValue() < m_CommandExecutionDoneFenceNextValue)
+        const auto& asyncPresentFence = m_AsyncPresentFences[m_NextAsyncPresentBackBufferIndex];
+        if (asyncPresentFence.fence->GetCompletedValue() < asyncPresentFence.queuedCount)
         {
-            ResetEvent(m_BarrierReachedEvent.get());
-            m_CommandExecutionDoneFence->SetEventOnCompletion(m_CommandExecutionDoneFenceNextValue,
-                m_BarrierReachedEvent.get());
-            WaitForSingleObject(m_BarrierReachedEvent.get(), INFINITE);
+            ResetEvent(m_AsyncPresentDoneEvent.get());
+            asyncPresentFence.fence->SetEventOnCompletion(asyncPresentFence.queuedCount,
+                m_AsyncPresentDoneEvent.get());
+            WaitForSingleObject(m_AsyncPresentDoneEvent.get(), INFINITE);
         }
     }
 
+    void D3D12GraphicsDevice::UpdateAsyncPresentFences()
+    {
+        if (!m_AsyncPresentDoneEvent)
+        {
+            m_AsyncPresentDoneEvent.reset(CreateEvent(nullptr, FALSE, FALSE, nullptr));
+        }
+
+        const auto backBufferCount = GetBackBufferCount();
+        if (backBufferCount == m_AsyncPresentFences.size())
+        {
+            return;
+        }
+
+        m_AsyncPresentFences.clear();
+        std::vector<AsyncPresentFence> asyncPresentFences(backBufferCount);
+        for (auto& asyncPresentFence : asyncPresentFences)
+        {
+            ID3D12Fence* fence;
+            auto hr = m_D3D12Device->CreateFence(0, D3D12_FENCE_FLAG_NONE, __uuidof(ID3D12Fence),
+                reinterpret_cast<void**>(&fence));
+            if (FAILED(hr))
+            {
+                CLUSTER_LOG_ERROR << "ID3D12Device::CreateFence failed: " << hr;
+                return;
+            }
+            asyncPresentFence.fence.reset(fence);
+            asyncPresentFence.fence->SetName(L"GfxPluginQuadroSync Async Present Fence");
+        }
+        m_AsyncPresentFences = std::move(asyncPresentFences);
+    }
+
+    void D3D12GraphicsDevice::ReleaseBackBuffers()
+    {
+        // Nothing referencing the back buffers can be kept between warmups (IDXGISwapChain::ResizeBuffers fails while
+        // there are references to them or while the GPU is still using them).
+        if (IsFenceCreated())
+        {
+            m_RepeatScheduler.WaitForIdle(*this);
+        }
+        m_BackBuffers.clear();
+        m_RepeatScheduler.Reset(0, m_RepeatScheduler.GetLastFenceValue());
+        m_FirstRepeatBackBufferIndex = -1;
+    }
+
     void D3D12GraphicsDevice::FreeResources()
     {
+        // Command lists and textures must not be released while the GPU is still using them.
+        if (IsFenceCreated())
+        {
+            m_RepeatScheduler.WaitForIdle(*this);
+        }
         m_BarrierReachedEvent.reset();
         m_CommandExecutionDoneFence.reset();
         m_CommandList.reset();
         m_CommandAllocator.reset();
-        m_BackBuffers.clear();
+        m_RepeatCommands.clear();
+        m_FrameHoldCommands.clear();
+        m_HeldFrameSaved = false;
         m_SavedTexture.reset();
+        m_SavedTextureState = D3D12_RESOURCE_STATE_COMMON;
+        m_RepeatScheduler.Reset(0, 0);
+        m_SavedFrameCache.OnReleased();
     }
 }
@@ -0,0 +1,147 @@
+#include "EventTrace.h"
+#include "Logger.h"
+
+#include <new>
+
+#ifdef _WIN32
+#include <Windows.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#include <unistd.h>
+#else
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace GfxQuadroSync
+{
+    namespace
+    {
+        const EventTraceDescription k_EventDescriptions[] = {
+            {"PresentBegin", {"frameIndex", "repeatIndex", nullptr}},
+            {"PresentEnd", {"frameIndex", "repeatIndex", "status"}},
+            {"JoinSwapGroup", {"group", "blocking", "status"}},
+            {"BindSwapBarrier", {"group", "barrier", "status"}},
+            {"WarmupState", {"state", nullptr, nullptr}},
+            {"WarmupStage", {"stage", "isEmitter", "value"}},
+            {"WarmupAction", {"action", "repeatIndex", nullptr}},
+            {"DeviceEvent", {"eventType", nullptr, nullptr}},
+            {"RenderEvent", {"eventId", "data", nullptr}},
+        };
+
+        uint32_t GetProcessId()
+        {
+#ifdef _WIN32
+            return GetCurrentProcessId();
+#else
+            return static_cast<uint32_t>(getpid());
+#endif
+        }
+
+        uint32_t FetchThreadId()
+        {
+#ifdef _WIN32
+            return GetCurrentThreadId();
+#elif defined(__APPLE__)
+            uint64_t threadId = 0;
+            pthread_threadid_np(nullptr, &threadId);
+            return static_cast<uint32_t>(threadId);
+#else
+            return static_cast<uint32_t>(syscall(SYS_gettid));
+#endif
+        }
+
+        uint32_t GetThreadId()
+        {
+            // Remarks: Cached since fetching it is a system call on Linux.
+            thread_local const uint32_t threadId = FetchThreadId();
+            return threadId;
+        }
+    }
+
+    const EventTraceDescription* GetEventTraceDescription(const uint16_t eventId)
+    {
+        constexpr auto descriptionCount = sizeof(k_EventDescriptions) / sizeof(k_EventDescriptions[0]);
+        if (eventId == 0 || eventId > descriptionCount)
+        {
+            return nullptr;
+        }
+        return &k_EventDescriptions[eventId - 1];
+    }
+
+    bool EventTrace::Start(const std::string& path, const uint32_t recordCount)
+    {
+        std::lock_guard<std::mutex> lock(m_StartLock);
+        if (m_Header != nullptr)
+        {
+            CLUSTER_LOG_ERROR << "EventTrace: a trace was already started in " << m_File.path();
+            return false;
+        }
+
+        // Remarks: A power of 2 so that the record of an index can be found with a mask.
+        uint32_t roundedRecordCount = 1;
+        while (roundedRecordCount < recordCount && roundedRecordCount < (1u << 30))
+        {
+            roundedRecordCount <<= 1;
+        }
+
+        const size_t totalSize = sizeof(EventTraceHeader) + sizeof(EventTraceRecord) * roundedRecordCount;
+        if (!m_File.Create(path, totalSize))
+        {
+            return false;
+        }
+
+        // Remarks: The file is full of zeros, so records already have a 0 sequence (never written).
+        auto header = new (m_File.get()) EventTraceHeader();
+        header->magic = EventTraceHeader::k_Magic;
+        header->version = EventTraceHeader::k_Version;
+        header->headerSize = sizeof(EventTraceHeader);
+        header->recordSize = sizeof(EventTraceRecord);
+        header->recordCount = roundedRecordCount;
+        header->processId = GetProcessId();
+        header->performanceCounterFrequency = GetPerformanceCounterFrequency();
+        header->startTick = GetCurrentPerformanceCounterTick();
+        header->writeIndex.store(0, std::memory_order_relaxed);
+
+        m_Records = reinterpret_cast<EventTraceRecord*>(header + 1);
+        m_RecordIndexMask = roundedRecordCount - 1;
+        m_Header = header;
+        m_Enabled.store(true, std::memory_order_release);
+        CLUSTER_LOG << "EventTrace: recording the last " << roundedRecordCount << " events in " << path;
+        return true;
+    }
+
+    void EventTrace::Stop()
+    {
+        std::lock_guard<std::mutex> lock(m_StartLock);
+        if (!m_Enabled.exchange(false, std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        m_File.Flush();
+        CLUSTER_LOG << "EventTrace: stopped after " << m_Header->writeIndex.load(std::memory_order_relaxed)
+                    << " events";
+    }
+
+    void EventTrace::WriteRecord(const uint64_t tick, const EventTraceId eventId, const int64_t arg0,
+        const int64_t arg1, const int64_t arg2)
+    {
+        const auto recordIndex = m_Header->writeIndex.fetch_add(1, std::memory_order_relaxed);
+        auto& record = m_Records[recordIndex & m_RecordIndexMask];
+
+        // Invalidate the record (it might contain an older event) before touching any of its content.
+        record.sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        record.tick = tick;
+        record.threadId = GetThreadId();
+        record.eventId = static_cast<uint16_t>(eventId);
+        record.reserved = 0;
+        record.args[0] = arg0;
+        record.args[1] = arg1;
+        record.args[2] = arg2;
+
+        record.sequence.store(recordIndex + 1, std::memory_order_release);
+    }
+}
@@ -0,0 +1,152 @@
+#include "FrameCounter.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace GfxQuadroSync
+{
+    namespace
+    {
+        /// How far (in proportion) a new refresh period measurement must be from the current one to consider the
+        /// refresh rate changed (and restart measurement from scratch).
+        constexpr double k_RefreshPeriodChangeThreshold = 0.25;
+
+        /// Minimum number of frames a measurement of the refresh period must cover to be used.  Hardware frame counts
+        /// are only precise to a frame, so shorter measurements are too coarse (a measurement over one frame done
+        /// just before and just after a vertical blank can be off by 100%).
+        constexpr uint32_t k_MinFramesToMeasureRefreshPeriod = 8;
+    }
+
+    FrameCounter::FrameCounter(const uint64_t ticksPerSecond)
+        : m_TicksPerSecond(ticksPerSecond)
+    {
+    }
+
+    void FrameCounter::Invalidate()
+    {
+        m_HasHardwareAnchor = false;
+        m_NextHardwareQueryTick = 0;
+        m_RetryHardwareQueryTick = 0;
+        m_LastReturnedFrameCount = 0;
+    }
+
+    bool FrameCounter::IsHardwareQueryDue(const uint64_t nowTick) const
+    {
+        // Back off after a failure, even if we never got any value from the hardware.  Otherwise a hardware counter
+        // that does not work would be queried, and the failure logged, on every frame.
+        if (nowTick < m_RetryHardwareQueryTick)
+        {
+            return false;
+        }
+        if (!m_HasHardwareAnchor || m_RefreshPeriodTicks.load(std::memory_order_relaxed) <= 0.0 ||
+            m_UnthrottledQueryCount < NBR_CAN_GET_FRAME_COUNT_BEFORE_THROTTLE)
+        {
+            return true;
+        }
+        return nowTick >= m_NextHardwareQueryTick;
+    }
+
+    void FrameCounter::OnHardwareFrameCount(const uint64_t nowTick, const uint32_t hardwareFrameCount)
+    {
+        m_HardwareQueryCount.fetch_add(1, std::memory_order_relaxed);
+
+        if (m_HasHardwareAnchor)
+        {
+            // Only this thread writes the refresh period, the atomic is for the readers reporting it.
+            const double refreshPeriodTicks = m_RefreshPeriodTicks.load(std::memory_order_relaxed);
+            const bool throttled = m_UnthrottledQueryCount >= NBR_CAN_GET_FRAME_COUNT_BEFORE_THROTTLE;
+            if (throttled && refreshPeriodTicks > 0.0)
+            {
+                const auto extrapolationError = static_cast<int32_t>(hardwareFrameCount - Extrapolate(nowTick));
+                m_LastExtrapolationError.store(extrapolationError, std::memory_order_relaxed);
+                const auto absoluteError = static_cast<uint32_t>(std::abs(extrapolationError));
+                if (absoluteError > m_MaxExtrapolationError.load(std::memory_order_relaxed))
+                {
+                    m_MaxExtrapolationError.store(absoluteError, std::memory_order_relaxed);
+                }
+            }
+
+            // Restart measuring the refresh period from the previous anchor if it changed since then.
+            const uint32_t framesSinceAnchor = hardwareFrameCount - m_AnchorFrameCount;
+            if (refreshPeriodTicks > 0.0 && framesSinceAnchor >= k_MinFramesToMeasureRefreshPeriod &&
+                nowTick > m_AnchorTick)
+            {
+                const double measuredPeriod = static_cast<double>(nowTick - m_AnchorTick) / framesSinceAnchor;
+                const double changeThreshold = refreshPeriodTicks * k_RefreshPeriodChangeThreshold;
+                if (std::abs(measuredPeriod - refreshPeriodTicks) > changeThreshold)
+                {
+                    m_PeriodOriginTick = m_AnchorTick;
+                    m_PeriodOriginFrameCount = m_AnchorFrameCount;
+                }
+            }
+
+            // Measure the refresh period over everything since the origin, the error caused by the frame count only
+            // being precise to a frame shrinks as it covers more frames.
+            const uint32_t framesSinceOrigin = hardwareFrameCount - m_PeriodOriginFrameCount;
+            if (framesSinceOrigin > 0 && nowTick > m_PeriodOriginTick &&
+                (refreshPeriodTicks <= 0.0 || framesSinceOrigin >= k_MinFramesToMeasureRefreshPeriod))
+            {
+                m_RefreshPeriodTicks.store(static_cast<double>(nowTick - m_PeriodOriginTick) / framesSinceOrigin,
+                    std::memory_order_relaxed);
+            }
+        }
+        else
+        {
+            m_PeriodOriginTick = nowTick;
+            m_PeriodOriginFrameCount = hardwareFrameCount;
+        }
+
+        m_HasHardwareAnchor = true;
+        m_AnchorTick = nowTick;
+        m_AnchorFrameCount = hardwareFrameCount;
+        if (m_UnthrottledQueryCount < NBR_CAN_GET_FRAME_COUNT_BEFORE_THROTTLE)
+        {
+            ++m_UnthrottledQueryCount;
+        }
+        m_NextHardwareQueryTick = nowTick + NBR_SECONDS_BETWEEN_CAN_GET_FRAME_COUNT * m_TicksPerSecond;
+        m_RetryHardwareQueryTick = 0;
+    }
+
+    void FrameCounter::OnHardwareQueryFailed(const uint64_t nowTick)
+    {
+        m_NextHardwareQueryTick = nowTick + NBR_SECONDS_BETWEEN_CAN_GET_FRAME_COUNT * m_TicksPerSecond;
+        m_RetryHardwareQueryTick = m_NextHardwareQueryTick;
+    }
+
+    uint32_t FrameCounter::GetFrameCount(const uint64_t nowTick)
+    {
+        uint32_t frameCount;
+        if (m_HasHardwareAnchor && nowTick == m_AnchorTick)
+        {
+            frameCount = m_AnchorFrameCount;
+        }
+        else
+        {
+            frameCount = Extrapolate(nowTick);
+            m_ExtrapolatedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Never go backward, this would be really confusing for the caller (we instead simply stay on the same frame
+        // until the extrapolation catch up).
+        if (static_cast<int32_t>(frameCount - m_LastReturnedFrameCount) < 0)
+        {
+            frameCount = m_LastReturnedFrameCount;
+        }
+        m_LastReturnedFrameCount = frameCount;
+        return frameCount;
+    }
+
+    uint32_t FrameCounter::Extrapolate(const uint64_t nowTick) const
+    {
+        const double refreshPeriodTicks = m_RefreshPeriodTicks.load(std::memory_order_relaxed);
+        if (!m_HasHardwareAnchor || refreshPeriodTicks <= 0.0 || nowTick <= m_AnchorTick)
+        {
+            return m_AnchorFrameCount;
+        }
+
+        // The vertical blank that incremented the anchor frame count happened anywhere in the refresh period before
+        // the anchor, so assume it was in the middle.
+        const auto elapsedFrames = static_cast<uint64_t>((nowTick - m_AnchorTick) / refreshPeriodTicks + 0.5);
+        return m_AnchorFrameCount + static_cast<uint32_t>(elapsedFrames);
+    }
+}
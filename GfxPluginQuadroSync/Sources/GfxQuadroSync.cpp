@@ -1,26 +1,120 @@
+#ifdef _WIN32
 #include "D3D11GraphicsDevice.h"
 #include "D3D12GraphicsDevice.h"
+#include "NvApiSyncApi.h"
+#endif
 #include "QuadroSync.h"
 #include "GfxQuadroSync.h"
+#include "EventTrace.h"
 #include "Logger.h"
+#include "NullGraphicsDevice.h"
+#include "NullSyncApi.h"
+#include "PluginProfiler.h"
+#include "SoftwareSyncApi.h"
+#include "StateBlock.h"
+#include "Tracepoints.h"
+#include "UdpSocket.h"
+#ifdef QUADROSYNC_VULKAN
+#include "VulkanGraphicsDevice.h"
+#include "VulkanInterception.h"
+#include "VulkanPresentBarrierSyncApi.h"
+#endif
+#ifdef QUADROSYNC_OPENGL
+#include "GlxSwapGroupSyncApi.h"
+#include "OpenGLGraphicsDevice.h"
+#endif
 
 #include "../Unity/IUnityRenderingExtensions.h"
+#ifdef _WIN32
 #include "../Unity/IUnityGraphicsD3D11.h"
 #include "../Unity/IUnityGraphicsD3D12.h"
+#endif
 
+#include <algorithm>
 #include <assert.h>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
 
 namespace GfxQuadroSync
 {
     static IUnityInterfaces* s_UnityInterfaces = nullptr;
     static IUnityGraphics* s_UnityGraphics = nullptr;
+#ifdef _WIN32
     static IUnityGraphicsD3D11* s_UnityGraphicsD3D11 = nullptr;
     static IUnityGraphicsD3D12v7* s_UnityGraphicsD3D12 = nullptr;
+#endif
+#ifdef QUADROSYNC_VULKAN
+    static IUnityGraphicsVulkan* s_UnityGraphicsVulkan = nullptr;
+#endif
 
     static std::unique_ptr<IGraphicsDevice> s_GraphicsDevice = nullptr;
-    static PluginCSwapGroupClient s_SwapGroupClient;
+#ifdef _WIN32
+    static PluginCSwapGroupClient s_SwapGroupClient(std::make_unique<NvApiSyncApi>());
+#else
+    // Remarks: NvAPI is only available on Windows.
+    static PluginCSwapGroupClient s_SwapGroupClient(std::make_unique<NullSyncApi>());
+#endif
     static bool s_Initialized = false;
 
+    // Lifecycle of the graphics context (s_GraphicsDevice and the device / swap chain of Unity it presents to).
+    // Remarks: Only changed on the rendering thread (render and device events), atomic so that GetState can read it.
+    enum class GraphicsContextState : uint32_t
+    {
+        /// No graphics device (before QuadroSyncInitialize or after kUnityGfxDeviceEventShutdown)
+        NoDevice = 0,
+        /// Device and swap chain have to be validated (again) before being used
+        Unvalidated = 1,
+        /// Unity is resetting the device (between kUnityGfxDeviceEventBeforeReset and AfterReset), must not be used
+        Resetting = 2,
+        /// Device and swap chain were validated and cached in s_ContextDevice and s_ContextSwapChain
+        Valid = 3,
+    };
+    static std::atomic<GraphicsContextState> s_GraphicsContextState = GraphicsContextState::NoDevice;
+    // Number of times the context was validated (after being created or invalidated by a device event).
+    static std::atomic<uint64_t> s_GraphicsContextValidationCount = 0;
+    // Device and swap chain of s_GraphicsDevice as of the last validation (only meaningful while Valid).
+    static IUnknown* s_ContextDevice = nullptr;
+    static IDXGISwapChain* s_ContextSwapChain = nullptr;
+    // Swap chain returned by Unity as of the last validation (to detect Unity recreating it).
+    static IDXGISwapChain* s_UnitySwapChain = nullptr;
+
+    // SoftwareSyncApi created by UseSoftwareSwapBarrier waiting to be given to s_SwapGroupClient by
+    // QuadroSyncInitialize (on the rendering thread).
+    static std::mutex s_PendingSyncApiLock;
+    static std::unique_ptr<ISyncApi> s_PendingSyncApi;
+    // SoftwareSyncApi used by s_SwapGroupClient (if any, owned by s_SwapGroupClient), to get its statistics.
+    static std::atomic<SoftwareSyncApi*> s_SoftwareSyncApi = nullptr;
+    // Scheduling of presents requested by UseScheduledPresents waiting to be started by QuadroSyncInitialize (also
+    // protected by s_PendingSyncApiLock).
+    struct PendingScheduledPresents
+    {
+        PresentScheduler::Config config;
+        std::unique_ptr<IDatagramTransport> transport;
+    };
+    static std::unique_ptr<PendingScheduledPresents> s_PendingScheduledPresents;
+    // NullGraphicsDevice requested by UseNullGraphicsDevice waiting to be created by InitializeGraphicsDevice (also
+    // protected by s_PendingSyncApiLock).
+    static std::unique_ptr<NullGraphicsDevice::Config> s_PendingNullGraphicsDeviceConfig;
+
+    static bool HasPendingNullGraphicsDevice()
+    {
+        std::lock_guard<std::mutex> lock(s_PendingSyncApiLock);
+        return s_PendingNullGraphicsDeviceConfig != nullptr;
+    }
+
+    // Swap chain Unity currently presents to (nullptr when it is not available through the Unity interfaces).
+    static IDXGISwapChain* GetUnitySwapChain()
+    {
+#ifdef _WIN32
+        if (s_UnityGraphicsD3D11 != nullptr)
+            return s_UnityGraphicsD3D11->GetSwapChain();
+        if (s_UnityGraphicsD3D12 != nullptr)
+            return s_UnityGraphicsD3D12->GetSwapChain();
+#endif
+        return nullptr;
+    }
+
     // Any change made to this enum's constants must be reflected in
     // Unity.ClusterDisplay.GfxPluginQuadroSyncInitializationState in GfxPluginQuadroSyncState.cs.
     enum class QuadroSyncInitializationStatus : uint32_t
@@ -42,23 +136,44 @@ namespace GfxQuadroSync
         SwapBarrierIdMismatch = 12,
     };
     static std::atomic<QuadroSyncInitializationStatus> s_InitializationStatus = QuadroSyncInitializationStatus::NotInitialized;
-    static uint64_t s_PerformanceCounterFrequency = 0;
-    constexpr uint64_t NBR_CAN_GET_FRAME_COUNT_BEFORE_THROTTLE = 60; // This is one second at 60 fps...
-    constexpr uint64_t NBR_SECONDS_BETWEEN_CAN_GET_FRAME_COUNT = 1;  // Let's check every second once we are throttled...
+    QuadroSyncInitializationStatus ConvertToQuadroSyncInitializationStatus(
+        PluginCSwapGroupClient::InitializeStatus toConvert);
+    static void PublishState();
 
-    uint64_t GetCurrentPerformanceCounterTick()
+#ifdef QUADROSYNC_VULKAN
+    // Unity presents by itself on Vulkan (kUnityRenderingExtQueryOverridePresentFrame is not supported), so its
+    // vkQueuePresentKHR is intercepted and done by s_SwapGroupClient instead.
+    static bool OnVulkanPresent(const VkQueue queue, const VkPresentInfoKHR& presentInfo, VkResult& result)
     {
-        LARGE_INTEGER ret;
-        if (QueryPerformanceCounter(&ret))
+        if (s_GraphicsDevice == nullptr ||
+            s_GraphicsDevice->GetDeviceType() != GraphicsDeviceType::GRAPHICS_DEVICE_VULKAN || !IsContextValid())
         {
-            return ret.QuadPart;
+            return false;
         }
-        else
+
+        auto& vulkanGraphicsDevice = static_cast<VulkanGraphicsDevice&>(*s_GraphicsDevice);
+        if (presentInfo.swapchainCount == 1 &&
+            presentInfo.pSwapchains[0] != vulkanGraphicsDevice.GetSwapchain().swapchain)
+        {
+            vulkanGraphicsDevice.SetSwapchain(GetInterceptedVulkanSwapchain(presentInfo.pSwapchains[0]));
+            s_GraphicsContextState.store(GraphicsContextState::Unvalidated, std::memory_order_relaxed);
+        }
+        if (!vulkanGraphicsDevice.SetPendingPresent(queue, presentInfo))
+        {
+            return false;
+        }
+
+        s_SwapGroupClient.Render(&vulkanGraphicsDevice);
+        if (vulkanGraphicsDevice.HasPendingPresent())
         {
-            // I've never seen QueryPerformanceCounter fail, but let's play safe...
-            return 0;
+            // Present was skipped (see QuadroSyncSkipSyncForNextFrame) or failed before presenting.
+            vulkanGraphicsDevice.Present();
         }
+        PublishState();
+        result = vulkanGraphicsDevice.GetLastPresentResult();
+        return true;
     }
+#endif
 
     // Override the function defining the load of the plugin
     extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API
@@ -68,8 +183,20 @@ namespace GfxQuadroSync
         {
             CLUSTER_LOG << "UnityPluginLoad triggered";
 
+            RegisterTracepoints();
+            PluginProfiler::Instance().Initialize(unityInterfaces);
+            s_SwapGroupClient.InitializePresentTelemetry();
+
             s_UnityInterfaces = unityInterfaces;
             s_UnityGraphics = unityInterfaces->Get<IUnityGraphics>();
+#ifdef QUADROSYNC_VULKAN
+            // Remarks: Has to be done before the graphics device is created (so the plugin has to be preloaded).
+            const auto unityGraphicsVulkan = unityInterfaces->Get<IUnityGraphicsVulkan>();
+            if (unityGraphicsVulkan != nullptr)
+            {
+                InterceptVulkanInitialization(unityGraphicsVulkan, &OnVulkanPresent);
+            }
+#endif
             if (s_UnityGraphics)
             {
                 s_UnityGraphics->RegisterDeviceEventCallback(OnGraphicsDeviceEvent);
@@ -78,12 +205,6 @@ namespace GfxQuadroSync
                 // to not miss the event in case the graphics device is already initialized
                 OnGraphicsDeviceEvent(kUnityGfxDeviceEventInitialize);
             }
-
-            LARGE_INTEGER performanceCounterFrequency;
-            if (QueryPerformanceFrequency(&performanceCounterFrequency))
-            {
-                s_PerformanceCounterFrequency = performanceCounterFrequency.QuadPart;
-            }
         }
         else
         {
@@ -92,6 +213,15 @@ namespace GfxQuadroSync
         }
     }
 
+    // Unity plugin unload event
+    extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API UnityPluginUnload()
+    {
+        EventTrace::Instance().Stop();
+        PluginProfiler::Instance().Shutdown();
+        UnregisterTracepoints();
+        Logger::Instance().Shutdown();
+    }
+
     // Freely defined function to pass a callback to plugin-specific scripts
     extern "C" UnityRenderingEventAndData UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API
         GetRenderEventFunc()
@@ -105,20 +235,372 @@ namespace GfxQuadroSync
         Logger::Instance().SetManagedCallback(callback);
     }
 
-    // Freely defined function to set a callback that will be called before the present of each frame
-    extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API SetBarrierWarmupCallback(
-        PluginCSwapGroupClient::BarrierWarmupCallback callback)
+    /**
+     * Parameters of StartBarrierWarmup.
+     *
+     * \remark Any change to this struct must be matched in
+     *         Unity.ClusterDisplay.GfxPluginQuadroSyncSystem.GfxPluginQuadroSyncUtilities.BarrierWarmupParameters in
+     *         GfxPluginQuadroSyncSystem.cs.
+     */
+    struct QuadroSyncBarrierWarmupParameters
+    {
+        /// Multicast address used to communicate with the other nodes of the cluster
+        const char* multicastAddress;
+        /// Address of the network adapter to use
+        const char* adapterAddress;
+        /// Port used to communicate with the other nodes of the cluster
+        uint16_t port;
+        /// Identifier of this node
+        uint8_t nodeId;
+        /// Is this node the emitter (1) or a repeater (0)?
+        uint8_t isEmitter;
+        /// Number of presents the emitter skips before starting to warm up
+        uint32_t presentsToSkip;
+        /// Maximum duration of the warmup
+        uint32_t timeoutMs;
+        /// Bit vector (one bit per node id) of the repeaters the emitter has to wait on
+        uint64_t repeaters[4];
+    };
+
+    /**
+     * Start warming up the swap barrier (as soon as it is enabled) in coordination with the other nodes.
+     *
+     * \return Was the warmup started (false if we fail to communicate with the other nodes)?
+     */
+    extern "C" bool UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API StartBarrierWarmup(
+        const QuadroSyncBarrierWarmupParameters* parameters)
+    {
+        auto transport = std::make_unique<UdpSocket>();
+        if (!transport->OpenMulticast(parameters->multicastAddress, parameters->port, parameters->adapterAddress))
+        {
+            // Remarks: Start with a null transport to set the state to NetworkFailure.
+            transport.reset();
+        }
+
+        BarrierWarmup::Config config;
+        config.isEmitter = parameters->isEmitter != 0;
+        config.nodeId = parameters->nodeId;
+        for (size_t bitIndex = 0; bitIndex < config.repeaters.size(); ++bitIndex)
+        {
+            config.repeaters[bitIndex] = (parameters->repeaters[bitIndex / 64] >> (bitIndex % 64)) & 1;
+        }
+        config.presentsToSkip = parameters->presentsToSkip;
+        config.timeout = std::chrono::milliseconds(parameters->timeoutMs);
+        return s_SwapGroupClient.GetBarrierWarmup().Start(config, std::move(transport));
+    }
+
+    /**
+     * Abort the barrier warmup in progress (if any).
+     */
+    extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API AbortBarrierWarmup()
     {
-        s_SwapGroupClient.SetBarrierWarmupCallback(callback);
+        s_SwapGroupClient.GetBarrierWarmup().Abort();
     }
 
     /**
-     * Status of the QuadroSync as returned by GetStatus.
+     * Parameters of UseSoftwareSwapBarrier.
      *
      * \remark Any change to this struct must be matched in
-     *         Unity.ClusterDisplay.GfxPluginQuadroSyncSystem.GfxPluginQuadroSyncUtilities.QuadroSyncState in
+     *         Unity.ClusterDisplay.GfxPluginQuadroSyncSystem.GfxPluginQuadroSyncUtilities.SoftwareSwapBarrierParameters
+     *         in GfxPluginQuadroSyncSystem.cs.
+     */
+    struct QuadroSyncSoftwareSwapBarrierParameters
+    {
+        /// Multicast address used to communicate with the other nodes of the cluster
+        const char* multicastAddress;
+        /// Address of the network adapter to use
+        const char* adapterAddress;
+        /// Port used to communicate with the other nodes of the cluster
+        uint16_t port;
+        /// Identifier of this node
+        uint8_t nodeId;
+        /// Maximum time to wait on the other nodes before presenting anyway
+        uint32_t timeoutMs;
+        /// Bit vector (one bit per node id) of every node of the cluster (including this one, only the representative
+        /// of every computer when hostInstanceCount > 1)
+        uint64_t nodes[4];
+        /// Name of the barrier shared by the instances running on this computer (when hostInstanceCount > 1)
+        const char* hostBarrierName;
+        /// Number of instances running on this computer (only instance 0 communicates with the other nodes)
+        uint8_t hostInstanceCount;
+        /// Index of this instance among the ones running on this computer
+        uint8_t hostInstanceIndex;
+        /// SoftwareSyncApi::BarrierAlgorithm used to synchronize the nodes (must be the same on every node)
+        uint8_t algorithm;
+        /// Number of children of every node (Tree) or of nodes notified per round (Dissemination), 0 for the default
+        uint8_t fanOut;
+    };
+
+    /**
+     * Use a swap barrier implemented in software (exchanging datagrams with the other nodes) instead of the Quadro Sync
+     * hardware.  Must be called before the QuadroSyncInitialize render event and can only be called once.
+     *
+     * \return Success?  (false if we fail to communicate with the other nodes or if it was already called)
+     */
+    extern "C" bool UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API UseSoftwareSwapBarrier(
+        const QuadroSyncSoftwareSwapBarrierParameters* parameters)
+    {
+        std::lock_guard<std::mutex> lock(s_PendingSyncApiLock);
+        if (s_PendingSyncApi || s_SoftwareSyncApi.load() != nullptr)
+        {
+            CLUSTER_LOG_ERROR << "UseSoftwareSwapBarrier can only be called once";
+            return false;
+        }
+
+        // Remarks: Only the representative of the computer communicates with the other nodes.
+        std::unique_ptr<UdpSocket> transport;
+        if (parameters->hostInstanceCount <= 1 || parameters->hostInstanceIndex == 0)
+        {
+            transport = std::make_unique<UdpSocket>();
+            if (!transport->OpenMulticast(parameters->multicastAddress, parameters->port, parameters->adapterAddress))
+            {
+                return false;
+            }
+        }
+
+        SoftwareSyncApi::Config config;
+        config.nodeId = parameters->nodeId;
+        for (size_t bitIndex = 0; bitIndex < config.nodes.size(); ++bitIndex)
+        {
+            config.nodes[bitIndex] = (parameters->nodes[bitIndex / 64] >> (bitIndex % 64)) & 1;
+        }
+        config.nodes.set(config.nodeId);
+        if (parameters->timeoutMs > 0)
+        {
+            config.timeout = std::chrono::milliseconds(parameters->timeoutMs);
+        }
+        if (parameters->algorithm > static_cast<uint8_t>(SoftwareSyncApi::BarrierAlgorithm::Dissemination))
+        {
+            CLUSTER_LOG_ERROR << "UseSoftwareSwapBarrier: unknown algorithm "
+                              << static_cast<int>(parameters->algorithm);
+            return false;
+        }
+        config.algorithm = static_cast<SoftwareSyncApi::BarrierAlgorithm>(parameters->algorithm);
+        if (parameters->fanOut > 0)
+        {
+            config.fanOut = parameters->fanOut;
+        }
+        if (parameters->hostInstanceCount > 1)
+        {
+            if (parameters->hostBarrierName == nullptr)
+            {
+                CLUSTER_LOG_ERROR << "UseSoftwareSwapBarrier: hostBarrierName is required when hostInstanceCount > 1";
+                return false;
+            }
+            config.hostBarrierName = parameters->hostBarrierName;
+            config.hostInstanceCount = parameters->hostInstanceCount;
+            config.hostInstanceIndex = parameters->hostInstanceIndex;
+        }
+        s_PendingSyncApi = std::make_unique<SoftwareSyncApi>(config, std::move(transport));
+        return true;
+    }
+
+    /**
+     * Parameters of UseNullGraphicsDevice.
+     *
+     * \remark Any change to this struct must be matched in Benchmarks/PluginLoopBenchmark.cpp.
+     */
+    struct QuadroSyncNullGraphicsDeviceParameters
+    {
+        /// Number of buffers of the swap chain
+        uint32_t backBufferCount;
+        /// Duration of a refresh of the display (0 for a display without vsync, presents never block)
+        uint32_t refreshPeriodUs;
+        /// Number of refreshes between two flips
+        uint32_t syncInterval;
+        /// Number of presents that can wait for their flip before a present blocks
+        uint32_t maxFrameLatency;
+    };
+
+    /**
+     * Present to a NullGraphicsDevice (a synthetic swap chain without any GPU) when Unity runs with the null renderer
+     * (batch mode).  Presents are not synchronized unless UseSoftwareSwapBarrier is also called.  Must be called
+     * before the QuadroSyncInitialize render event.
+     *
+     * \return Success?  (false if the graphics device was already created)
+     */
+    extern "C" bool UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API UseNullGraphicsDevice(
+        const QuadroSyncNullGraphicsDeviceParameters* parameters)
+    {
+        std::lock_guard<std::mutex> lock(s_PendingSyncApiLock);
+        if (s_GraphicsDevice != nullptr)
+        {
+            CLUSTER_LOG_ERROR << "UseNullGraphicsDevice must be called before QuadroSyncInitialize";
+            return false;
+        }
+
+        NullGraphicsDevice::Config config;
+        if (parameters->backBufferCount > 0)
+        {
+            config.backBufferCount = parameters->backBufferCount;
+        }
+        config.refreshPeriod = std::chrono::microseconds(parameters->refreshPeriodUs);
+        config.syncInterval = parameters->syncInterval;
+        if (parameters->maxFrameLatency > 0)
+        {
+            config.maxFrameLatency = parameters->maxFrameLatency;
+        }
+        s_PendingNullGraphicsDeviceConfig = std::make_unique<NullGraphicsDevice::Config>(config);
+        return true;
+    }
+
+    /**
+     * Parameters of StartClockSync.
+     *
+     * \remark Any change to this struct must be matched in
+     *         Unity.ClusterDisplay.GfxPluginQuadroSyncSystem.GfxPluginQuadroSyncUtilities.ClockSyncParameters in
      *         GfxPluginQuadroSyncSystem.cs.
      */
+    struct QuadroSyncClockSyncParameters
+    {
+        /// Multicast address used to communicate with the other nodes of the cluster
+        const char* multicastAddress;
+        /// Address of the network adapter to use
+        const char* adapterAddress;
+        /// Port used to communicate with the other nodes of the cluster
+        uint16_t port;
+        /// Identifier of this node
+        uint8_t nodeId;
+        /// Is this node the emitter (1, whose clock is the cluster time) or a repeater (0)?
+        uint8_t isEmitter;
+        /// Interval between the probes sent by repeaters (0 for the default)
+        uint32_t probeIntervalMs;
+    };
+
+    /**
+     * Start estimating the offset between the clock of this node and the clock of the emitter (in the background).
+     *
+     * \return Was the synchronization started (false if we fail to communicate with the other nodes)?
+     */
+    extern "C" bool UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API StartClockSync(
+        const QuadroSyncClockSyncParameters* parameters)
+    {
+        auto transport = std::make_unique<UdpSocket>();
+        if (!transport->OpenMulticast(parameters->multicastAddress, parameters->port, parameters->adapterAddress))
+        {
+            transport.reset();
+        }
+
+        ClockSync::Config config;
+        config.isEmitter = parameters->isEmitter != 0;
+        config.nodeId = parameters->nodeId;
+        if (parameters->probeIntervalMs > 0)
+        {
+            config.probeInterval = std::chrono::milliseconds(parameters->probeIntervalMs);
+        }
+        return s_SwapGroupClient.GetClockSync().Start(config, std::move(transport));
+    }
+
+    /**
+     * Estimate of the cluster time as returned by GetClockSyncState.
+     *
+     * \remark Any change to this struct must be matched in Unity.ClusterDisplay.GfxPluginQuadroSyncClockSyncState in
+     *         GfxPluginQuadroSyncClockSyncState.cs.
+     */
+    struct QuadroSyncClockSyncState
+    {
+        /// Is the estimate valid (the synchronization is started and we received at least one sample)?
+        uint8_t valid;
+        /// Time of this node when the state was fetched (in nanoseconds)
+        int64_t localTimeNs;
+        /// Cluster time when the state was fetched (in nanoseconds)
+        int64_t clusterTimeNs;
+        /// To be added to the local time to get the cluster time (in nanoseconds)
+        int64_t offsetNs;
+        /// Maximum error on offsetNs (in nanoseconds)
+        int64_t uncertaintyNs;
+        /// Round trip of the sample the estimate comes from (in nanoseconds)
+        int64_t roundTripNs;
+        /// Number of samples received
+        uint64_t sampleCount;
+    };
+
+    /**
+     * Method to be called by managed code to get the current estimate of the cluster time.
+     */
+    extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetClockSyncState(QuadroSyncClockSyncState* state)
+    {
+        const auto& clockSync = s_SwapGroupClient.GetClockSync();
+        const auto localTimeNs = clockSync.GetLocalTimeNs();
+        const auto estimate = clockSync.GetEstimate();
+        state->valid = estimate.valid ? 1 : 0;
+        state->localTimeNs = localTimeNs;
+        state->clusterTimeNs = localTimeNs + estimate.offsetNs;
+        state->offsetNs = estimate.offsetNs;
+        state->uncertaintyNs = estimate.uncertaintyNs;
+        state->roundTripNs = estimate.roundTripNs;
+        state->sampleCount = estimate.sampleCount;
+    }
+
+    /**
+     * Parameters of UseScheduledPresents.
+     *
+     * \remark Any change to this struct must be matched in
+     *         Unity.ClusterDisplay.GfxPluginQuadroSyncSystem.GfxPluginQuadroSyncUtilities.ScheduledPresentsParameters
+     *         in GfxPluginQuadroSyncSystem.cs.
+     */
+    struct QuadroSyncScheduledPresentsParameters
+    {
+        /// Multicast address used to communicate with the other nodes of the cluster
+        const char* multicastAddress;
+        /// Address of the network adapter to use
+        const char* adapterAddress;
+        /// Port used to communicate with the other nodes of the cluster
+        uint16_t port;
+        /// Is this node the emitter (1, assigning the present time of every frame) or a repeater (0)?
+        uint8_t isEmitter;
+        /// How far in the future (in refresh periods) the emitter schedules presents (0 for the default)
+        uint8_t leadPeriods;
+        /// Refresh period of the displays (in microseconds)
+        uint32_t refreshPeriodUs;
+    };
+
+    /**
+     * Present every frame at a cluster time assigned by the emitter instead of waiting on a swap barrier (for clusters
+     * without Quadro Sync hardware).  Must be called before the QuadroSyncInitialize render event and can only be
+     * called once.  Repeaters must also call StartClockSync to know the cluster time.
+     *
+     * \return Success?  (false if we fail to communicate with the other nodes or if it was already called)
+     */
+    extern "C" bool UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API UseScheduledPresents(
+        const QuadroSyncScheduledPresentsParameters* parameters)
+    {
+        std::lock_guard<std::mutex> lock(s_PendingSyncApiLock);
+        if (s_PendingScheduledPresents || s_SwapGroupClient.GetPresentScheduler().IsStarted())
+        {
+            CLUSTER_LOG_ERROR << "UseScheduledPresents can only be called once";
+            return false;
+        }
+
+        auto transport = std::make_unique<UdpSocket>();
+        if (!transport->OpenMulticast(parameters->multicastAddress, parameters->port, parameters->adapterAddress))
+        {
+            return false;
+        }
+
+        auto pending = std::make_unique<PendingScheduledPresents>();
+        pending->config.isEmitter = parameters->isEmitter != 0;
+        if (parameters->leadPeriods > 0)
+        {
+            pending->config.leadPeriods = parameters->leadPeriods;
+        }
+        if (parameters->refreshPeriodUs > 0)
+        {
+            pending->config.refreshPeriod = std::chrono::microseconds(parameters->refreshPeriodUs);
+            pending->config.scheduleTimeout = pending->config.refreshPeriod * 2;
+        }
+        pending->transport = std::move(transport);
+        s_PendingScheduledPresents = std::move(pending);
+        return true;
+    }
+
+    /**
+     * Status of the QuadroSync as returned by GetState and published in the state block (see GetStateBlock).
+     *
+     * \remark Any change to this struct must be matched in Unity.ClusterDisplay.GfxPluginQuadroSyncState in
+     *         GfxPluginQuadroSyncState.cs.  New fields must always be added at the end (readers of the state block
+     *         rely on it).
+     */
     struct QuadroSyncState
     {
         /// Initialization status of the QuadroSync system (not using QuadroSyncInitializationStatus for safer interop
@@ -132,18 +614,338 @@ namespace GfxQuadroSync
         uint64_t presentedFramesSuccess = 0;
         /// Number of frames that failed to be presented using QuadroSync's present call
         uint64_t presentedFramesFailed = 0;
+        /// Number of times the (heavy) hardware frame counter was queried
+        uint64_t frameCountHardwareQueries = 0;
+        /// Number of frame counts that were extrapolated instead of queried from the hardware
+        uint64_t frameCountExtrapolations = 0;
+        /// Difference between the hardware and extrapolated frame count measured on the last hardware query
+        int32_t frameCountLastExtrapolationError = 0;
+        /// Largest absolute difference between the hardware and extrapolated frame count
+        uint32_t frameCountMaxExtrapolationError = 0;
+        /// BarrierWarmupState of the barrier warmup
+        uint32_t barrierWarmupState = 0;
+        /// Number of presents the emitter did while repeaters were paused during the barrier warmup
+        uint32_t barrierWarmupPresentWhileRepeatersArePaused = 0;
+        /// Duration of the barrier warmup in microseconds (up to now if still in progress)
+        uint64_t barrierWarmupDurationUs = 0;
+        /// Number of times the software swap barrier was released (0 when using the Quadro Sync hardware)
+        uint64_t softwareBarrierReleases = 0;
+        /// Number of times the software swap barrier timed out waiting on other nodes
+        uint64_t softwareBarrierTimeouts = 0;
+        /// Number of scheduled presents whose time was already passed when we started waiting
+        uint64_t scheduledPresentsLate = 0;
+        /// Number of scheduled presents for which the time assigned by the emitter was not received in time
+        uint64_t scheduledPresentsMissingTarget = 0;
+        /// GraphicsContextState of the graphics device and swap chain
+        uint32_t graphicsContextState = 0;
+        /// Number of times the graphics device and swap chain were validated (again after every device reset)
+        uint64_t graphicsContextValidations = 0;
+        /// Number of times the swap chain was replaced by Unity and put back in the swap group
+        uint64_t swapGroupRejoins = 0;
+        /// Number of swap group rejoins after which the barrier had to be bound (and warmed up) again
+        uint64_t swapGroupRejoinWarmups = 0;
+        /// Time spent by the last swap group rejoin in microseconds (not including the warmup)
+        uint64_t lastSwapGroupRejoinDurationUs = 0;
+        /// Number of times the texture (and other resources) used to repeat presents during barrier warmups was
+        /// allocated
+        uint64_t savedFrameAllocations = 0;
+        /// Number of barrier warmups that reused the resources allocated by a previous warmup
+        uint64_t savedFrameReuses = 0;
+        /// Number of times these resources were released because the back buffers were resized or the device lost
+        uint64_t savedFrameReleases = 0;
+        /// Number of presents of a held frame (see QuadroSyncHoldFrame)
+        uint64_t heldFrames = 0;
+        /// Number of QuadroSyncHoldFrame that could not present the held frame (frame hold not enabled, barrier
+        /// warming up or renderer not supporting it)
+        uint64_t frameHoldFailures = 0;
+        /// Number of frames presented by the present worker thread (see QuadroSyncEnableAsyncPresent)
+        uint64_t asyncPresents = 0;
+        /// Number of frames for which the rendering thread had to wait on the present worker (too many frames in
+        /// flight)
+        uint64_t asyncPresentStalls = 0;
+        /// Total time the rendering thread waited on the present worker in microseconds
+        uint64_t asyncPresentStallUs = 0;
+        /// Number of log messages dropped because they were logged faster than they could be delivered
+        uint64_t droppedLogMessages = 0;
     };
 
-    /**
-     * Method to be called by managed code to get some information about the status of the QuadroSync plugin.
-     */
-    extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetState(QuadroSyncState* state)
+    // Remarks: Static storage so that the address returned by GetStateBlock stays valid while the plugin is loaded.
+    static StateBlock<QuadroSyncState> s_StateBlock;
+
+    static void FillState(QuadroSyncState* const state)
     {
         state->initializationState = (uint32_t)s_InitializationStatus.load(std::memory_order_relaxed);
         state->swapGroupId = s_SwapGroupClient.GetSwapGroupId();
         state->swapBarrierId = s_SwapGroupClient.GetSwapBarrierId();
         state->presentedFramesSuccess = s_SwapGroupClient.GetPresentSuccessCount();
         state->presentedFramesFailed = s_SwapGroupClient.GetPresentFailureCount();
+        const auto& frameCounter = s_SwapGroupClient.GetFrameCounter();
+        state->frameCountHardwareQueries = frameCounter.GetHardwareQueryCount();
+        state->frameCountExtrapolations = frameCounter.GetExtrapolatedCount();
+        state->frameCountLastExtrapolationError = frameCounter.GetLastExtrapolationError();
+        state->frameCountMaxExtrapolationError = frameCounter.GetMaxExtrapolationError();
+        const auto& barrierWarmup = s_SwapGroupClient.GetBarrierWarmup();
+        state->barrierWarmupState = static_cast<uint32_t>(barrierWarmup.GetState());
+        state->barrierWarmupPresentWhileRepeatersArePaused = barrierWarmup.GetPresentWhileRepeatersArePausedCount();
+        state->barrierWarmupDurationUs = barrierWarmup.GetDuration().count();
+        const auto softwareSyncApi = s_SoftwareSyncApi.load(std::memory_order_acquire);
+        state->softwareBarrierReleases = softwareSyncApi ? softwareSyncApi->GetReleaseCount() : 0;
+        state->softwareBarrierTimeouts = softwareSyncApi ? softwareSyncApi->GetTimeoutCount() : 0;
+        const auto& presentScheduler = s_SwapGroupClient.GetPresentScheduler();
+        state->scheduledPresentsLate = presentScheduler.GetLatePresentCount();
+        state->scheduledPresentsMissingTarget = presentScheduler.GetMissingTargetCount();
+        state->graphicsContextState =
+            static_cast<uint32_t>(s_GraphicsContextState.load(std::memory_order_relaxed));
+        state->graphicsContextValidations = s_GraphicsContextValidationCount.load(std::memory_order_relaxed);
+        state->swapGroupRejoins = s_SwapGroupClient.GetSwapGroupRejoinCount();
+        state->swapGroupRejoinWarmups = s_SwapGroupClient.GetSwapGroupRejoinWarmupCount();
+        state->lastSwapGroupRejoinDurationUs = s_SwapGroupClient.GetLastSwapGroupRejoinDurationUs();
+        state->savedFrameAllocations = s_SwapGroupClient.GetSavedFrameAllocationCount();
+        state->savedFrameReuses = s_SwapGroupClient.GetSavedFrameReuseCount();
+        state->savedFrameReleases = s_SwapGroupClient.GetSavedFrameReleaseCount();
+        state->heldFrames = s_SwapGroupClient.GetHeldFrameCount();
+        state->frameHoldFailures = s_SwapGroupClient.GetFrameHoldFailureCount();
+        const auto& presentWorker = s_SwapGroupClient.GetPresentWorker();
+        state->asyncPresents = presentWorker.GetSubmitCount();
+        state->asyncPresentStalls = presentWorker.GetStallCount();
+        state->asyncPresentStallUs = presentWorker.GetStallDurationUs();
+        state->droppedLogMessages = Logger::Instance().GetDroppedCount();
+    }
+
+    /// Publish the current state in s_StateBlock (only from the rendering thread, the single writer of the block).
+    static void PublishState()
+    {
+        QuadroSyncState state;
+        FillState(&state);
+        s_StateBlock.Publish(state);
+    }
+
+    /**
+     * Method to be called by managed code to get some information about the status of the QuadroSync plugin.
+     *
+     * \remark Fields are read one by one, so they are not necessarily consistent with each other (the state block
+     *         returned by GetStateBlock is).
+     */
+    extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetState(QuadroSyncState* state)
+    {
+        FillState(state);
+    }
+
+    /**
+     * Method to be called by managed code to get the address of the state block: a StateBlockHeader followed by the
+     * QuadroSyncState published by the rendering thread after every frame, render event and device event.  Readers
+     * get a consistent snapshot of it with the seqlock protocol described in StateBlock.h, without any P/Invoke.
+     *
+     * \return Address of the StateBlockHeader (valid as long as the plugin is loaded).
+     */
+    extern "C" UNITY_INTERFACE_EXPORT const void* UNITY_INTERFACE_API GetStateBlock()
+    {
+        return s_StateBlock.GetHeader();
+    }
+
+    /**
+     * Statistics about the duration of the presents as returned by GetPresentStatistics.
+     *
+     * \remark Versioned: the caller must set size to the size of the struct it knows about and we fill the part of it
+     *         we both know about (size and version are then set to what we filled).  New fields must always be added
+     *         at the end (and increment k_Version).
+     * \remark Any change to this struct must be matched in Unity.ClusterDisplay.GfxPluginQuadroSyncPresentStatistics in
+     *         GfxPluginQuadroSyncPresentStatistics.cs.
+     */
+    struct QuadroSyncPresentStatistics
+    {
+        static constexpr uint32_t k_Version = 1;
+
+        /// Size of the struct as known by the caller (in) and as filled by us (out).
+        uint32_t size = sizeof(QuadroSyncPresentStatistics);
+        /// Version of the struct filled by us.
+        uint32_t version = k_Version;
+        /// Number of presents measured
+        uint64_t count = 0;
+        /// Sum of the duration of all the presents (in microseconds)
+        uint64_t sumUs = 0;
+        /// Shortest present (in microseconds)
+        uint64_t minUs = 0;
+        /// Longest present (in microseconds)
+        uint64_t maxUs = 0;
+        /// Worst presents of (approximately) the last PresentStatistics::k_OutlierWindowLength presents
+        PresentStatistics::Outlier outliers[PresentStatistics::k_OutlierCount] = {};
+        /// Number of bits used for the linear sub-buckets of each power of two of the histogram
+        uint32_t histogramSubBucketBits = LatencyHistogram::k_SubBucketBits;
+        /// Number of buckets in histogram
+        uint32_t histogramBucketCount = LatencyHistogram::k_BucketCount;
+        /// Log-linear histogram of the duration of the presents (see LatencyHistogram)
+        uint64_t histogram[LatencyHistogram::k_BucketCount] = {};
+    };
+
+    /// Size of the fields every version of QuadroSyncPresentStatistics starts with (size and version).
+    static constexpr uint32_t k_PresentStatisticsHeaderSize = offsetof(QuadroSyncPresentStatistics, count);
+
+    /**
+     * Fill a QuadroSyncPresentStatistics from a PresentStatistics.
+     */
+    static void FillPresentStatistics(const PresentStatistics& presentStatistics,
+        QuadroSyncPresentStatistics* const statistics)
+    {
+        statistics->size = sizeof(QuadroSyncPresentStatistics);
+        statistics->version = QuadroSyncPresentStatistics::k_Version;
+        statistics->count = presentStatistics.GetCount();
+        statistics->sumUs = presentStatistics.GetSumUs();
+        statistics->minUs = statistics->count > 0 ? presentStatistics.GetMinUs() : 0;
+        statistics->maxUs = presentStatistics.GetMaxUs();
+
+        std::array<PresentStatistics::Outlier, PresentStatistics::k_OutlierCount> outliers;
+        presentStatistics.GetOutliers(outliers);
+        std::copy(outliers.begin(), outliers.end(), statistics->outliers);
+
+        statistics->histogramSubBucketBits = LatencyHistogram::k_SubBucketBits;
+        statistics->histogramBucketCount = LatencyHistogram::k_BucketCount;
+        const auto& histogram = presentStatistics.GetHistogram();
+        for (uint32_t bucketIndex = 0; bucketIndex < LatencyHistogram::k_BucketCount; ++bucketIndex)
+        {
+            statistics->histogram[bucketIndex] = histogram.GetBucket(bucketIndex);
+        }
+    }
+
+    /**
+     * Fill the part of the caller's QuadroSyncPresentStatistics that both of us know about (the smallest of its size
+     * and ours) from a PresentStatistics.
+     *
+     * \return Was statistics filled?  (false if it is too small to even hold size and version)
+     */
+    static bool CopyPresentStatistics(const PresentStatistics& presentStatistics,
+        QuadroSyncPresentStatistics* const statistics)
+    {
+        if (statistics->size < k_PresentStatisticsHeaderSize)
+        {
+            return false;
+        }
+
+        QuadroSyncPresentStatistics filled;
+        FillPresentStatistics(presentStatistics, &filled);
+        filled.size = std::min(statistics->size, static_cast<uint32_t>(sizeof(QuadroSyncPresentStatistics)));
+        memcpy(statistics, &filled, filled.size);
+        return true;
+    }
+
+    /**
+     * Method to be called by managed code to get statistics about the duration of the presents (how long we are
+     * waiting on the swap barrier).
+     *
+     * \return Was statistics filled?  (false if the size specified by the caller cannot even hold size and version)
+     *
+     * \remark Callers knowing about a smaller (older) struct get the fields they know about, callers knowing about a
+     *         larger (newer) one get the fields we know about, size and version tell which.
+     */
+    extern "C" bool UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetPresentStatistics(
+        QuadroSyncPresentStatistics* statistics)
+    {
+        if (statistics == nullptr)
+        {
+            return false;
+        }
+
+        return CopyPresentStatistics(s_SwapGroupClient.GetPresentStatistics(), statistics);
+    }
+
+    /**
+     * Method to be called by managed code to get the address of the ring of PresentTelemetryRecord (starting with a
+     * PresentTelemetryHeader) so that it can read it directly (without any P/Invoke per frame).
+     *
+     * \return Address of the PresentTelemetryHeader or nullptr if telemetry is not available.
+     */
+    extern "C" UNITY_INTERFACE_EXPORT const void* UNITY_INTERFACE_API GetPresentTelemetry()
+    {
+        return s_SwapGroupClient.GetPresentTelemetry().GetHeader();
+    }
+
+    /**
+     * Start recording the events of the plugin (presents, swap group and barrier changes, barrier warmup, device and
+     * render events) in a binary trace file (see EventTrace) that can be converted by EventTraceDecoder.  Can only be
+     * called once per process, the trace is stopped by StopEventTrace or when the plugin is unloaded.
+     *
+     * \param[in] path Path of the trace file (replaced if it already exists).
+     * \param[in] recordCount Number of events kept in the file (the oldest ones are overwritten), 0 for the default.
+     *
+     * \return Was the trace started?
+     */
+    extern "C" bool UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API StartEventTrace(const char* path, uint32_t recordCount)
+    {
+        if (path == nullptr)
+        {
+            return false;
+        }
+        return EventTrace::Instance().Start(path, recordCount > 0 ? recordCount : EventTrace::k_DefaultRecordCount);
+    }
+
+    /**
+     * Stop recording events in the trace file started by StartEventTrace.
+     */
+    extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API StopEventTrace()
+    {
+        EventTrace::Instance().Stop();
+    }
+
+    /**
+     * Statistics of the software swap barrier that can be fetched with GetSoftwareSwapBarrierStatistics.
+     *
+     * \remark Any change must be reflected in SoftwareSwapBarrierStatistic in GfxPluginQuadroSyncSystem.cs.
+     */
+    enum class SoftwareSwapBarrierStatistic : uint32_t
+    {
+        /// Time between our arrival at the barrier and its release
+        BarrierWait = 0,
+        /// Time between the first and last node to be released
+        ReleaseSkew = 1,
+        /// Time between the release of the intra-computer barrier by the representative and this instance waking up
+        HostReleaseLatency = 2,
+    };
+
+    /**
+     * Method to be called by managed code to get statistics about the software swap barrier (in the same format as
+     * GetPresentStatistics).
+     *
+     * \return Was statistics filled?  (false if the size specified by the caller cannot even hold size and version, the
+     *         statistic is unknown or the software swap barrier is not used)
+     */
+    extern "C" bool UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetSoftwareSwapBarrierStatistics(
+        const uint32_t statistic, QuadroSyncPresentStatistics* statistics)
+    {
+        const auto softwareSyncApi = s_SoftwareSyncApi.load(std::memory_order_acquire);
+        if (softwareSyncApi == nullptr || statistics == nullptr)
+        {
+            return false;
+        }
+
+        switch (static_cast<SoftwareSwapBarrierStatistic>(statistic))
+        {
+        case SoftwareSwapBarrierStatistic::BarrierWait:
+            return CopyPresentStatistics(softwareSyncApi->GetBarrierWaitStatistics(), statistics);
+        case SoftwareSwapBarrierStatistic::ReleaseSkew:
+            return CopyPresentStatistics(softwareSyncApi->GetReleaseSkewStatistics(), statistics);
+        case SoftwareSwapBarrierStatistic::HostReleaseLatency:
+            return CopyPresentStatistics(softwareSyncApi->GetHostReleaseLatencyStatistics(), statistics);
+        }
+        return false;
+    }
+
+    /**
+     * Method to be called by managed code to get statistics about how late scheduled presents were compared to the time
+     * assigned by the emitter (in the same format as GetPresentStatistics).
+     *
+     * \return Was statistics filled?  (false if the size specified by the caller cannot even hold size and version or
+     *         presents are not scheduled)
+     */
+    extern "C" bool UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetScheduledPresentJitterStatistics(
+        QuadroSyncPresentStatistics* statistics)
+    {
+        const auto& presentScheduler = s_SwapGroupClient.GetPresentScheduler();
+        if (!presentScheduler.IsStarted() || statistics == nullptr)
+        {
+            return false;
+        }
+
+        return CopyPresentStatistics(presentScheduler.GetJitterStatistics(), statistics);
     }
 
     // Override the query method to use the `PresentFrame` callback
@@ -153,10 +955,30 @@ namespace GfxQuadroSync
     {
         if (query == UnityRenderingExtQueryType::kUnityRenderingExtQueryOverridePresentFrame)
         {
+            // Remarks: Vulkan presents are intercepted instead (see OnVulkanPresent).
+            if (s_GraphicsDevice != nullptr &&
+                s_GraphicsDevice->GetDeviceType() == GraphicsDeviceType::GRAPHICS_DEVICE_VULKAN)
+                return false;
+
             if (!IsContextValid())
                 return false;
 
-            return s_SwapGroupClient.Render(s_GraphicsDevice.get());
+#ifdef _WIN32
+            // Remarks: Unity recreates its swap chain without any device event (for example on fullscreen
+            // transitions).
+            if (GetUnitySwapChain() != s_UnitySwapChain)
+            {
+                s_SwapGroupClient.WaitForPendingPresents();
+                SetSwapChain();
+                s_GraphicsContextState.store(GraphicsContextState::Unvalidated, std::memory_order_relaxed);
+                if (!IsContextValid())
+                    return false;
+            }
+#endif
+
+            const bool presented = s_SwapGroupClient.Render(s_GraphicsDevice.get());
+            PublishState();
+            return presented;
         }
         return false;
     }
@@ -165,6 +987,7 @@ namespace GfxQuadroSync
     {
         switch (renderer)
         {
+#ifdef _WIN32
         case UnityGfxRenderer::kUnityGfxRendererD3D11:
             CLUSTER_LOG << "Detected D3D11 renderer";
             s_UnityGraphicsD3D11 = s_UnityInterfaces->Get<IUnityGraphicsD3D11>();
@@ -173,6 +996,27 @@ namespace GfxQuadroSync
             CLUSTER_LOG << "Detected D3D12 renderer";
             s_UnityGraphicsD3D12 = s_UnityInterfaces->Get<IUnityGraphicsD3D12v7>();
             break;
+#endif
+#ifdef QUADROSYNC_VULKAN
+        case UnityGfxRenderer::kUnityGfxRendererVulkan:
+            CLUSTER_LOG << "Detected Vulkan renderer";
+            s_UnityGraphicsVulkan = s_UnityInterfaces->Get<IUnityGraphicsVulkan>();
+            break;
+#endif
+#ifdef QUADROSYNC_OPENGL
+        case UnityGfxRenderer::kUnityGfxRendererOpenGLCore:
+            // Remarks: Unity has no interface for OpenGL, the display and drawable are those of its current context.
+            CLUSTER_LOG << "Detected OpenGL core renderer";
+            break;
+#endif
+        case UnityGfxRenderer::kUnityGfxRendererNull:
+            if (HasPendingNullGraphicsDevice())
+            {
+                CLUSTER_LOG << "Detected null renderer";
+                break;
+            }
+            CLUSTER_LOG_ERROR << "Graphic API not supported (UseNullGraphicsDevice was not called)";
+            break;
         default:
             CLUSTER_LOG_ERROR << "Graphic API not supported";
             break;
@@ -180,35 +1024,67 @@ namespace GfxQuadroSync
     }
 
     // Override function to receive graphics event
-    static void UNITY_INTERFACE_API OnGraphicsDeviceEvent(UnityGfxDeviceEventType eventType)
+    void UNITY_INTERFACE_API OnGraphicsDeviceEvent(UnityGfxDeviceEventType eventType)
     {
+        EventTrace::Instance().Write(EventTraceId::DeviceEvent, static_cast<int64_t>(eventType));
         if (eventType == kUnityGfxDeviceEventInitialize && !s_Initialized)
         {
             CLUSTER_LOG << "kUnityGfxDeviceEventInitialize called";
             s_Initialized = true;
         }
+        else if (eventType == kUnityGfxDeviceEventBeforeReset)
+        {
+            // Device and swap chain of Unity are about to be released, stop using them until AfterReset.
+            if (s_GraphicsDevice != nullptr)
+            {
+                CLUSTER_LOG << "kUnityGfxDeviceEventBeforeReset called";
+                s_SwapGroupClient.WaitForPendingPresents();
+                s_GraphicsContextState.store(GraphicsContextState::Resetting, std::memory_order_relaxed);
+            }
+        }
+        else if (eventType == kUnityGfxDeviceEventAfterReset)
+        {
+            if (s_GraphicsDevice != nullptr)
+            {
+                CLUSTER_LOG << "kUnityGfxDeviceEventAfterReset called";
+                SetDevice();
+                SetSwapChain();
+                s_GraphicsContextState.store(GraphicsContextState::Unvalidated, std::memory_order_relaxed);
+            }
+        }
         else if (eventType == kUnityGfxDeviceEventShutdown)
         {
+            s_SwapGroupClient.EnableAsyncPresent(0);
             s_Initialized = false;
+            s_GraphicsContextState.store(GraphicsContextState::NoDevice, std::memory_order_relaxed);
+            s_ContextDevice = nullptr;
+            s_ContextSwapChain = nullptr;
             s_UnityInterfaces = nullptr;
             s_UnityGraphics = nullptr;
+#ifdef _WIN32
             s_UnityGraphicsD3D11 = nullptr;
             s_UnityGraphicsD3D12 = nullptr;
+#endif
+#ifdef QUADROSYNC_VULKAN
+            s_UnityGraphicsVulkan = nullptr;
+#endif
             s_GraphicsDevice = nullptr;
         }
+        PublishState();
     }
 
     // Plugin function to handle a specific rendering event.
-    static void UNITY_INTERFACE_API
+    void UNITY_INTERFACE_API
         OnRenderEvent(int eventID, void* data)
     {
+        EventTrace::Instance().Write(EventTraceId::RenderEvent, eventID, reinterpret_cast<intptr_t>(data));
         switch (static_cast<EQuadroSyncRenderEvent>(eventID))
         {
         case EQuadroSyncRenderEvent::QuadroSyncInitialize:
             QuadroSyncInitialize();
             break;
         case EQuadroSyncRenderEvent::QuadroSyncQueryFrameCount:
-            QuadroSyncQueryFrameCount(static_cast<int* const>(data));
+            QuadroSyncQueryFrameCount(static_cast<int*>(data));
             break;
         case EQuadroSyncRenderEvent::QuadroSyncResetFrameCount:
             QuadroSyncResetFrameCount();
@@ -231,43 +1107,105 @@ namespace GfxQuadroSync
         case EQuadroSyncRenderEvent::QuadroSyncSkipSyncForNextFrame:
             QuadroSyncSkipSyncForNextFrame();
             break;
+        case EQuadroSyncRenderEvent::QuadroSyncEnableFrameHold:
+            QuadroSyncEnableFrameHold(static_cast<bool>(data));
+            break;
+        case EQuadroSyncRenderEvent::QuadroSyncHoldFrame:
+            QuadroSyncHoldFrame();
+            break;
+        case EQuadroSyncRenderEvent::QuadroSyncEnableAsyncPresent:
+            QuadroSyncEnableAsyncPresent(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(data)));
+            break;
+        case EQuadroSyncRenderEvent::QuadroSyncWaitForPresent:
+            QuadroSyncWaitForPresent();
+            break;
         default:
             break;
         }
+        PublishState();
     }
 
     void SetDevice()
     {
+#ifdef _WIN32
         if (s_UnityGraphicsD3D11 != nullptr)
         {
             auto device = s_UnityGraphicsD3D11->GetDevice();
-            s_GraphicsDevice->SetDevice(device);
+            if (device != nullptr)
+                s_GraphicsDevice->SetDevice(device);
         }
         else if (s_UnityGraphicsD3D12)
         {
             auto device = s_UnityGraphicsD3D12->GetDevice();
-            s_GraphicsDevice->SetDevice(device);
+            if (device != nullptr)
+                s_GraphicsDevice->SetDevice(device);
         }
+#endif
     }
 
     void SetSwapChain()
     {
+#ifdef _WIN32
         if (s_UnityGraphicsD3D11 != nullptr)
         {
             auto swapChain = s_UnityGraphicsD3D11->GetSwapChain();
-            s_GraphicsDevice->SetSwapChain(swapChain);
+            if (swapChain != nullptr)
+                s_GraphicsDevice->SetSwapChain(swapChain);
+            return;
         }
         else if (s_UnityGraphicsD3D12)
         {
             auto swapChain = s_UnityGraphicsD3D12->GetSwapChain();
-            s_GraphicsDevice->SetSwapChain(swapChain);
+            if (swapChain != nullptr)
+                s_GraphicsDevice->SetSwapChain(swapChain);
+            return;
         }
+#endif
+#ifdef QUADROSYNC_VULKAN
+        if (s_UnityGraphicsVulkan != nullptr)
+        {
+            static_cast<VulkanGraphicsDevice*>(s_GraphicsDevice.get())->SetSwapchain(GetInterceptedVulkanSwapchain());
+        }
+#endif
     }
 
-    // Verify if the D3D Device and the Swap Chain are valid.
+    static bool IsRendererSupported(const UnityGfxRenderer renderer)
+    {
+        switch (renderer)
+        {
+#ifdef _WIN32
+        case UnityGfxRenderer::kUnityGfxRendererD3D11:
+        case UnityGfxRenderer::kUnityGfxRendererD3D12:
+            return true;
+#endif
+#ifdef QUADROSYNC_VULKAN
+        case UnityGfxRenderer::kUnityGfxRendererVulkan:
+            return true;
+#endif
+#ifdef QUADROSYNC_OPENGL
+        case UnityGfxRenderer::kUnityGfxRendererOpenGLCore:
+            return true;
+#endif
+        case UnityGfxRenderer::kUnityGfxRendererNull:
+            // Remarks: Unity also reports the null renderer while the real one is initializing, so it is only
+            // supported once UseNullGraphicsDevice created the device.
+            return s_GraphicsDevice != nullptr &&
+                s_GraphicsDevice->GetDeviceType() == GraphicsDeviceType::GRAPHICS_DEVICE_NULL;
+        default:
+            return false;
+        }
+    }
+
+    // Verify if the D3D Device and the Swap Chain are valid and cache them (validated again only once invalidated by a
+    // device event, or when it fails).
     // The Swapchain can be invalid (for obscure reason) during the first Unity frame.
-    bool IsContextValid()
+    static bool ValidateContext()
     {
+        if (s_GraphicsContextState.load(std::memory_order_relaxed) == GraphicsContextState::Resetting)
+        {
+            return false;
+        }
+
         if (s_UnityGraphics == nullptr)
         {
             CLUSTER_LOG_ERROR << "IsContextValid, s_UnityGraphics == nullptr";
@@ -280,10 +1218,9 @@ namespace GfxQuadroSync
             return false;
         }
 
-        if (s_UnityGraphics->GetRenderer() != UnityGfxRenderer::kUnityGfxRendererD3D11 &&
-            s_UnityGraphics->GetRenderer() != UnityGfxRenderer::kUnityGfxRendererD3D12)
+        if (!IsRendererSupported(s_UnityGraphics->GetRenderer()))
         {
-            CLUSTER_LOG_ERROR << "IsContextValid, s_UnityGraphics->GetRenderer() != UnityGfxRenderer::kUnityGfxRendererD3D11-12";
+            CLUSTER_LOG_ERROR << "IsContextValid, s_UnityGraphics->GetRenderer() is not a supported renderer";
             return false;
         }
 
@@ -309,9 +1246,37 @@ namespace GfxQuadroSync
             s_InitializationStatus = QuadroSyncInitializationStatus::MissingSwapChain;
             return false;
         }
+
+        const bool swapChainReplaced =
+            s_ContextSwapChain != nullptr && s_ContextSwapChain != s_GraphicsDevice->GetSwapChain();
+        s_ContextDevice = s_GraphicsDevice->GetDevice();
+        s_ContextSwapChain = s_GraphicsDevice->GetSwapChain();
+        s_UnitySwapChain = GetUnitySwapChain();
+        s_GraphicsContextValidationCount.fetch_add(1, std::memory_order_relaxed);
+        s_GraphicsContextState.store(GraphicsContextState::Valid, std::memory_order_relaxed);
+
+        if (swapChainReplaced &&
+            s_InitializationStatus.load(std::memory_order_relaxed) == QuadroSyncInitializationStatus::Initialized)
+        {
+            CLUSTER_LOG << "IsContextValid, the swap chain was replaced, joining the swap group again";
+            const auto rejoinStatus = s_SwapGroupClient.RejoinSwapGroup(s_ContextDevice, s_ContextSwapChain);
+            if (rejoinStatus != PluginCSwapGroupClient::InitializeStatus::Success)
+            {
+                s_InitializationStatus = ConvertToQuadroSyncInitializationStatus(rejoinStatus);
+                CLUSTER_LOG_ERROR << "Failed to join the swap group again with the new swap chain";
+            }
+        }
         return true;
     }
 
+    bool IsContextValid()
+    {
+        // Remarks: Called for every present, so only a state check unless a device event invalidated the context.
+        if (s_GraphicsContextState.load(std::memory_order_relaxed) == GraphicsContextState::Valid)
+            return true;
+        return ValidateContext();
+    }
+
     bool InitializeGraphicsDevice()
     {
         // We cannot call this function earlier, because GetRenderer is sometimes
@@ -321,7 +1286,15 @@ namespace GfxQuadroSync
 
         if (s_GraphicsDevice == nullptr)
         {
-            if (s_UnityGraphicsD3D11 != nullptr)
+            if (renderer == UnityGfxRenderer::kUnityGfxRendererNull && HasPendingNullGraphicsDevice())
+            {
+                std::lock_guard<std::mutex> lock(s_PendingSyncApiLock);
+                s_GraphicsDevice = std::make_unique<NullGraphicsDevice>(*s_PendingNullGraphicsDeviceConfig);
+                s_PendingNullGraphicsDeviceConfig.reset();
+                CLUSTER_LOG << "NullGraphicsDevice successfully created";
+            }
+#ifdef _WIN32
+            else if (s_UnityGraphicsD3D11 != nullptr)
             {
                 auto device = s_UnityGraphicsD3D11->GetDevice();
                 auto swapChain = s_UnityGraphicsD3D11->GetSwapChain();
@@ -343,12 +1316,46 @@ namespace GfxQuadroSync
                     presentFlags);
                 CLUSTER_LOG << "D3D12GraphicsDevice successfully created";
             }
+#endif
+#ifdef QUADROSYNC_VULKAN
+            else if (s_UnityGraphicsVulkan != nullptr)
+            {
+                if (!IsVulkanInitializationIntercepted())
+                {
+                    s_InitializationStatus = QuadroSyncInitializationStatus::UnsupportedGraphicApi;
+                    CLUSTER_LOG_ERROR << "Vulkan presents cannot be intercepted, the plugin has to be preloaded";
+                    return false;
+                }
+
+                const auto instance = s_UnityGraphicsVulkan->Instance();
+                auto vulkanGraphicsDevice = std::make_unique<VulkanGraphicsDevice>(instance.instance,
+                    instance.physicalDevice, instance.device, instance.graphicsQueue, instance.queueFamilyIndex,
+                    instance.getInstanceProcAddr);
+                vulkanGraphicsDevice->SetSwapchain(GetInterceptedVulkanSwapchain());
+                s_GraphicsDevice = std::move(vulkanGraphicsDevice);
+                CLUSTER_LOG << "VulkanGraphicsDevice successfully created";
+            }
+#endif
+#ifdef QUADROSYNC_OPENGL
+            else if (renderer == UnityGfxRenderer::kUnityGfxRendererOpenGLCore)
+            {
+                // Remarks: Called from a render event, so with the context Unity renders with current.
+                s_GraphicsDevice = OpenGLGraphicsDevice::CreateForCurrentContext();
+                if (s_GraphicsDevice == nullptr)
+                {
+                    s_InitializationStatus = QuadroSyncInitializationStatus::MissingDevice;
+                    return false;
+                }
+                CLUSTER_LOG << "OpenGLGraphicsDevice successfully created";
+            }
+#endif
             else
             {
                 s_InitializationStatus = QuadroSyncInitializationStatus::UnsupportedGraphicApi;
                 CLUSTER_LOG_ERROR << "Graphic API incompatible";
                 return false;
             }
+            s_GraphicsContextState.store(GraphicsContextState::Unvalidated, std::memory_order_relaxed);
         }
         return true;
     }
@@ -390,8 +1397,80 @@ namespace GfxQuadroSync
         if (!IsContextValid())
             return;
 
+        {
+            std::lock_guard<std::mutex> lock(s_PendingSyncApiLock);
+            // NvAPI only knows about Direct3D, the null device is not synchronized (unless using the software barrier).
+            if (s_GraphicsDevice->GetDeviceType() == GraphicsDeviceType::GRAPHICS_DEVICE_NULL && !s_PendingSyncApi &&
+                s_SoftwareSyncApi.load() == nullptr)
+            {
+                s_SwapGroupClient.SetSyncApi(std::make_unique<NullSyncApi>());
+            }
+#ifdef QUADROSYNC_VULKAN
+            // NvAPI only knows about Direct3D, Vulkan presents are synchronized by the driver (when the swap chain was
+            // created with VK_NV_present_barrier) or by the software swap barrier.
+            // Remarks: Every node of the cluster is expected to have the same hardware (and so to pick the same one).
+            if (s_GraphicsDevice->GetDeviceType() == GraphicsDeviceType::GRAPHICS_DEVICE_VULKAN)
+            {
+                if (static_cast<VulkanGraphicsDevice*>(s_GraphicsDevice.get())->IsPresentBarrierEnabled())
+                {
+                    if (s_PendingSyncApi)
+                    {
+                        CLUSTER_LOG << "VK_NV_present_barrier is used instead of the software swap barrier";
+                        s_PendingSyncApi.reset();
+                    }
+                    s_SwapGroupClient.SetSyncApi(std::make_unique<VulkanPresentBarrierSyncApi>());
+                }
+                else if (!s_PendingSyncApi && s_SoftwareSyncApi.load() == nullptr)
+                {
+                    s_InitializationStatus = QuadroSyncInitializationStatus::UnsupportedGraphicApi;
+                    CLUSTER_LOG_ERROR << "VK_NV_present_barrier is not available, UseSoftwareSwapBarrier has to be "
+                        << "called to synchronize Vulkan presents";
+                    return;
+                }
+            }
+#endif
+#ifdef QUADROSYNC_OPENGL
+            // NvAPI only knows about Direct3D, OpenGL presents are synchronized by GLX_NV_swap_group (Quadro Sync
+            // hardware) or by the software swap barrier (drivers without the extension, like Mesa).
+            if (s_GraphicsDevice->GetDeviceType() == GraphicsDeviceType::GRAPHICS_DEVICE_OPENGL)
+            {
+                const auto& openGLGraphicsDevice = static_cast<const OpenGLGraphicsDevice&>(*s_GraphicsDevice);
+                if (GlxSwapGroupSyncApi::IsSupported(openGLGraphicsDevice.GetDisplay(),
+                    openGLGraphicsDevice.GetScreen()))
+                {
+                    if (s_PendingSyncApi)
+                    {
+                        CLUSTER_LOG << "GLX_NV_swap_group is used instead of the software swap barrier";
+                        s_PendingSyncApi.reset();
+                    }
+                    s_SwapGroupClient.SetSyncApi(
+                        std::make_unique<GlxSwapGroupSyncApi>(openGLGraphicsDevice.GetScreen()));
+                }
+                else if (!s_PendingSyncApi && s_SoftwareSyncApi.load() == nullptr)
+                {
+                    s_InitializationStatus = QuadroSyncInitializationStatus::UnsupportedGraphicApi;
+                    CLUSTER_LOG_ERROR << "GLX_NV_swap_group is not available, UseSoftwareSwapBarrier has to be "
+                        << "called to synchronize OpenGL presents";
+                    return;
+                }
+            }
+#endif
+            if (s_PendingSyncApi)
+            {
+                const auto softwareSyncApi = static_cast<SoftwareSyncApi*>(s_PendingSyncApi.get());
+                s_SoftwareSyncApi.store(softwareSyncApi, std::memory_order_release);
+                s_SwapGroupClient.SetSyncApi(std::move(s_PendingSyncApi));
+            }
+            if (s_PendingScheduledPresents)
+            {
+                s_SwapGroupClient.GetPresentScheduler().Start(s_PendingScheduledPresents->config,
+                    s_SwapGroupClient.GetClockSync(), std::move(s_PendingScheduledPresents->transport));
+                s_PendingScheduledPresents.reset();
+            }
+        }
+
         s_SwapGroupClient.SetupWorkStation();
-        auto swapGroupClientInitializeStatus = s_SwapGroupClient.Initialize(s_GraphicsDevice->GetDevice(), s_GraphicsDevice->GetSwapChain());
+        auto swapGroupClientInitializeStatus = s_SwapGroupClient.Initialize(s_ContextDevice, s_ContextSwapChain);
         if (swapGroupClientInitializeStatus == PluginCSwapGroupClient::InitializeStatus::Success)
         {
             s_InitializationStatus = QuadroSyncInitializationStatus::Initialized;
@@ -410,7 +1489,7 @@ namespace GfxQuadroSync
         if (!IsContextValid() || value == nullptr)
             return;
 
-        auto frameCount = s_SwapGroupClient.QueryFrameCount(s_GraphicsDevice->GetDevice());
+        auto frameCount = s_SwapGroupClient.QueryFrameCount(s_ContextDevice);
         *value = (int)frameCount;
     }
 
@@ -420,7 +1499,7 @@ namespace GfxQuadroSync
         if (!IsContextValid())
             return;
 
-        s_SwapGroupClient.ResetFrameCount(s_GraphicsDevice->GetDevice());
+        s_SwapGroupClient.ResetFrameCount(s_ContextDevice);
     }
 
     // Leave the Barrier and Swap Group, disable the Workstation SwapGroup
@@ -430,8 +1509,8 @@ namespace GfxQuadroSync
             return;
 
         s_SwapGroupClient.Dispose(
-            s_GraphicsDevice->GetDevice(),
-            s_GraphicsDevice->GetSwapChain());
+            s_ContextDevice,
+            s_ContextSwapChain);
 
         s_SwapGroupClient.DisposeWorkStation();
 
@@ -445,8 +1524,8 @@ namespace GfxQuadroSync
             return;
 
         s_SwapGroupClient.EnableSystem(
-            s_GraphicsDevice->GetDevice(),
-            s_GraphicsDevice->GetSwapChain(), value);
+            s_ContextDevice,
+            s_ContextSwapChain, value);
     }
 
     // Toggle to join/leave the SwapGroup
@@ -456,8 +1535,8 @@ namespace GfxQuadroSync
             return;
 
         s_SwapGroupClient.EnableSwapGroup(
-            s_GraphicsDevice->GetDevice(),
-            s_GraphicsDevice->GetSwapChain(),
+            s_ContextDevice,
+            s_ContextSwapChain,
             value);
     }
 
@@ -468,7 +1547,7 @@ namespace GfxQuadroSync
             return;
 
         s_SwapGroupClient.EnableSwapBarrier(
-            s_GraphicsDevice->GetDevice(),
+            s_ContextDevice,
             value);
     }
 
@@ -489,4 +1568,47 @@ namespace GfxQuadroSync
 
         s_SwapGroupClient.SkipSynchronizedPresentOfNextFrame();
     }
+
+    // Enable or disable saving every frame so that it can be presented again by QuadroSyncHoldFrame
+    void QuadroSyncEnableFrameHold(const bool value)
+    {
+        if (!IsContextValid())
+            return;
+
+        s_SwapGroupClient.EnableFrameHold(s_GraphicsDevice.get(), value);
+    }
+
+    // Present the last frame again because the next one is not ready in time
+    void QuadroSyncHoldFrame()
+    {
+        if (!IsContextValid())
+            return;
+
+        s_SwapGroupClient.HoldFrame(s_GraphicsDevice.get());
+    }
+
+    // Present from a worker thread instead of the rendering thread
+    void QuadroSyncEnableAsyncPresent(const uint32_t maxInFlightFrames)
+    {
+        if (!IsContextValid())
+            return;
+
+        // Remarks: D3D11 immediate contexts cannot be used while another thread presents and Vulkan presents are
+        // intercepted (see OnVulkanPresent), so they have to stay on the rendering thread.
+        const auto deviceType = s_GraphicsDevice->GetDeviceType();
+        if (maxInFlightFrames > 0 && deviceType != GraphicsDeviceType::GRAPHICS_DEVICE_D3D12 &&
+            deviceType != GraphicsDeviceType::GRAPHICS_DEVICE_NULL)
+        {
+            CLUSTER_LOG_ERROR << "QuadroSyncEnableAsyncPresent is only supported with D3D12";
+            return;
+        }
+
+        s_SwapGroupClient.EnableAsyncPresent(maxInFlightFrames);
+    }
+
+    // Wait for the frames handed to the present worker thread to be presented
+    void QuadroSyncWaitForPresent()
+    {
+        s_SwapGroupClient.WaitForPendingPresents();
+    }
 }
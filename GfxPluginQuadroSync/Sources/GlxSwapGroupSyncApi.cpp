@@ -0,0 +1,192 @@
+#include "GlxSwapGroupSyncApi.h"
+#include "IGraphicsDevice.h"
+#include "Logger.h"
+
+#include <GL/glx.h>
+
+#include <cstdint>
+#include <cstring>
+
+namespace GfxQuadroSync
+{
+    namespace
+    {
+        template <typename FunctionType>
+        bool LoadFunction(const char* const name, FunctionType& loaded)
+        {
+            loaded = reinterpret_cast<FunctionType>(glXGetProcAddressARB(reinterpret_cast<const GLubyte*>(name)));
+            if (loaded == nullptr)
+            {
+                CLUSTER_LOG_ERROR << "GlxSwapGroupSyncApi: failed to get " << name;
+                return false;
+            }
+            return true;
+        }
+
+        Display* ToDisplay(IUnknown* const pDevice)
+        {
+            return reinterpret_cast<Display*>(pDevice);
+        }
+
+        GLXDrawable ToDrawable(IDXGISwapChain* const pSwapChain)
+        {
+            return static_cast<GLXDrawable>(reinterpret_cast<uintptr_t>(pSwapChain));
+        }
+
+        SyncApiStatus ToSyncApiStatus(const Bool success)
+        {
+            return success ? SyncApiStatus::Ok : SyncApiStatus::Error;
+        }
+    }
+
+    GlxSwapGroupSyncApi::GlxSwapGroupSyncApi(const int screen)
+        : m_Screen(screen)
+    {
+    }
+
+    bool GlxSwapGroupSyncApi::IsSupported(Display* const display, const int screen)
+    {
+        if (display == nullptr)
+        {
+            return false;
+        }
+
+        // Remarks: Extensions are space separated, look for the whole name (and not a prefix of another one).
+        const char* const extensions = glXQueryExtensionsString(display, screen);
+        const char* const extension = "GLX_NV_swap_group";
+        const auto extensionLength = strlen(extension);
+        for (const char* found = extensions != nullptr ? strstr(extensions, extension) : nullptr; found != nullptr;
+             found = strstr(found + extensionLength, extension))
+        {
+            const bool startsName = found == extensions || found[-1] == ' ';
+            const bool endsName = found[extensionLength] == ' ' || found[extensionLength] == '\0';
+            if (startsName && endsName)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    SyncApiStatus GlxSwapGroupSyncApi::Initialize()
+    {
+        if (m_Initialized)
+        {
+            return SyncApiStatus::Ok;
+        }
+
+        auto& functions = m_Functions;
+        bool loaded = LoadFunction("glXJoinSwapGroupNV", functions.glXJoinSwapGroupNV);
+        loaded = LoadFunction("glXBindSwapBarrierNV", functions.glXBindSwapBarrierNV) && loaded;
+        loaded = LoadFunction("glXQuerySwapGroupNV", functions.glXQuerySwapGroupNV) && loaded;
+        loaded = LoadFunction("glXQueryMaxSwapGroupsNV", functions.glXQueryMaxSwapGroupsNV) && loaded;
+        loaded = LoadFunction("glXQueryFrameCountNV", functions.glXQueryFrameCountNV) && loaded;
+        loaded = LoadFunction("glXResetFrameCountNV", functions.glXResetFrameCountNV) && loaded;
+        m_Initialized = loaded;
+        return loaded ? SyncApiStatus::Ok : SyncApiStatus::NoImplementation;
+    }
+
+    SyncApiStatus GlxSwapGroupSyncApi::QueryMaxSwapGroup(IUnknown* const pDevice, uint32_t& maxGroups,
+        uint32_t& maxBarriers)
+    {
+        if (!m_Initialized)
+        {
+            return SyncApiStatus::ApiNotInitialized;
+        }
+        if (pDevice == nullptr)
+        {
+            return SyncApiStatus::InvalidHandle;
+        }
+        unsigned int glxMaxGroups = 0;
+        unsigned int glxMaxBarriers = 0;
+        const auto status = ToSyncApiStatus(
+            m_Functions.glXQueryMaxSwapGroupsNV(ToDisplay(pDevice), m_Screen, &glxMaxGroups, &glxMaxBarriers));
+        maxGroups = glxMaxGroups;
+        maxBarriers = glxMaxBarriers;
+        return status;
+    }
+
+    SyncApiStatus GlxSwapGroupSyncApi::JoinSwapGroup(IUnknown* const pDevice, IDXGISwapChain* const pSwapChain,
+        const uint32_t group, bool)
+    {
+        if (!m_Initialized)
+        {
+            return SyncApiStatus::ApiNotInitialized;
+        }
+        if (pDevice == nullptr || pSwapChain == nullptr)
+        {
+            return SyncApiStatus::InvalidHandle;
+        }
+        // Remarks: There is no non blocking variant, joining the group never waits for the other members.
+        return ToSyncApiStatus(m_Functions.glXJoinSwapGroupNV(ToDisplay(pDevice), ToDrawable(pSwapChain), group));
+    }
+
+    SyncApiStatus GlxSwapGroupSyncApi::BindSwapBarrier(IUnknown* const pDevice, const uint32_t group,
+        const uint32_t barrier)
+    {
+        if (!m_Initialized)
+        {
+            return SyncApiStatus::ApiNotInitialized;
+        }
+        if (pDevice == nullptr)
+        {
+            return SyncApiStatus::InvalidHandle;
+        }
+        return ToSyncApiStatus(m_Functions.glXBindSwapBarrierNV(ToDisplay(pDevice), group, barrier));
+    }
+
+    SyncApiStatus GlxSwapGroupSyncApi::QuerySwapGroup(IUnknown* const pDevice, IDXGISwapChain* const pSwapChain,
+        uint32_t& group, uint32_t& barrier)
+    {
+        if (!m_Initialized)
+        {
+            return SyncApiStatus::ApiNotInitialized;
+        }
+        if (pDevice == nullptr || pSwapChain == nullptr)
+        {
+            return SyncApiStatus::InvalidHandle;
+        }
+        unsigned int glxGroup = 0;
+        unsigned int glxBarrier = 0;
+        const auto status = ToSyncApiStatus(
+            m_Functions.glXQuerySwapGroupNV(ToDisplay(pDevice), ToDrawable(pSwapChain), &glxGroup, &glxBarrier));
+        group = glxGroup;
+        barrier = glxBarrier;
+        return status;
+    }
+
+    SyncApiStatus GlxSwapGroupSyncApi::QueryFrameCount(IUnknown* const pDevice, uint32_t& frameCount)
+    {
+        if (!m_Initialized)
+        {
+            return SyncApiStatus::ApiNotInitialized;
+        }
+        if (pDevice == nullptr)
+        {
+            return SyncApiStatus::InvalidHandle;
+        }
+        unsigned int glxFrameCount = 0;
+        const auto status =
+            ToSyncApiStatus(m_Functions.glXQueryFrameCountNV(ToDisplay(pDevice), m_Screen, &glxFrameCount));
+        frameCount = glxFrameCount;
+        return status;
+    }
+
+    SyncApiStatus GlxSwapGroupSyncApi::ResetFrameCount(IUnknown* const pDevice)
+    {
+        if (!m_Initialized)
+        {
+            return SyncApiStatus::ApiNotInitialized;
+        }
+        if (pDevice == nullptr)
+        {
+            return SyncApiStatus::InvalidHandle;
+        }
+        return ToSyncApiStatus(m_Functions.glXResetFrameCountNV(ToDisplay(pDevice), m_Screen));
+    }
+
+    SyncApiStatus GlxSwapGroupSyncApi::Present(IGraphicsDevice& graphicsDevice)
+    {
+        return graphicsDevice.Present() ? SyncApiStatus::Ok : SyncApiStatus::Error;
+    }
+}
@@ -0,0 +1,275 @@
+#include "HostBarrier.h"
+#include "Logger.h"
+
+#include <thread>
+
+#ifdef _WIN32
+#include <Windows.h>
+#elif defined(__linux__)
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace GfxQuadroSync
+{
+    /**
+     * Content of the shared memory.
+     *
+     * \remark Every instance has its own cache line so that arriving instances do not fight over the same one.
+     */
+    struct HostBarrier::Segment
+    {
+        static constexpr uint32_t k_Magic = 0x42485147; // "GQHB"
+        static constexpr uint32_t k_Version = 1;
+
+        /// Set to k_Magic (last) by the instance creating the segment once it is initialized.
+        std::atomic<uint32_t> magic;
+        uint32_t version;
+        uint32_t instanceCount;
+
+        /// Incremented by the representative every time it releases the barrier.
+        alignas(64) std::atomic<uint32_t> releaseSequence;
+        /// Generation and time (in nanoseconds of the steady clock) of the last release.
+        std::atomic<uint64_t> releasedGeneration;
+        std::atomic<uint64_t> releaseTimeNs;
+
+        struct alignas(64) Instance
+        {
+            /// Incremented to wake the instance up (futex word on Linux).
+            std::atomic<uint32_t> wakeSequence;
+            /// releaseSequence + 1 of the release the instance is waiting for.
+            std::atomic<uint32_t> arrivedSequence;
+        };
+        Instance instances[k_MaxInstances];
+    };
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+        "Atomics in shared memory must be lock free to work across processes");
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "Futex words must be plain 32 bits integers");
+
+    namespace
+    {
+        uint64_t NowNs()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+    }
+
+    HostBarrier::~HostBarrier()
+    {
+        CloseEvents();
+    }
+
+    bool HostBarrier::Open(const std::string& name, const uint32_t instanceCount, const uint32_t instanceIndex)
+    {
+        m_Segment = nullptr;
+        CloseEvents();
+        if (instanceCount < 1 || instanceCount > k_MaxInstances || instanceIndex >= instanceCount)
+        {
+            CLUSTER_LOG_ERROR << "HostBarrier: invalid instance " << instanceIndex << " of " << instanceCount;
+            return false;
+        }
+
+        bool created = false;
+        if (!m_SharedMemory.CreateOrOpen(name, sizeof(Segment), created))
+        {
+            return false;
+        }
+        auto segment = static_cast<Segment*>(m_SharedMemory.get());
+        if (created)
+        {
+            segment->version = Segment::k_Version;
+            segment->instanceCount = instanceCount;
+            segment->releaseSequence.store(0, std::memory_order_relaxed);
+            segment->releasedGeneration.store(0, std::memory_order_relaxed);
+            segment->releaseTimeNs.store(0, std::memory_order_relaxed);
+            for (auto& instance : segment->instances)
+            {
+                instance.wakeSequence.store(0, std::memory_order_relaxed);
+                instance.arrivedSequence.store(0, std::memory_order_relaxed);
+            }
+            segment->magic.store(Segment::k_Magic, std::memory_order_release);
+        }
+        else
+        {
+            // Wait for the instance that created the segment to initialize it.
+            const auto deadline = Clock::now() + std::chrono::seconds(1);
+            while (segment->magic.load(std::memory_order_acquire) != Segment::k_Magic && Clock::now() < deadline)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            if (segment->magic.load(std::memory_order_acquire) != Segment::k_Magic ||
+                segment->version != Segment::k_Version || segment->instanceCount != instanceCount)
+            {
+                CLUSTER_LOG_ERROR << "HostBarrier: " << name << " is not a compatible barrier of " << instanceCount
+                                  << " instances";
+                m_SharedMemory.reset();
+                return false;
+            }
+        }
+
+#ifdef _WIN32
+        for (uint32_t eventIndex = 0; eventIndex < instanceCount; ++eventIndex)
+        {
+            const auto eventName = "Local\\" + name + "_" + std::to_string(eventIndex);
+            m_Events[eventIndex] = CreateEventA(nullptr, FALSE, FALSE, eventName.c_str());
+            if (m_Events[eventIndex] == nullptr)
+            {
+                CLUSTER_LOG_ERROR << "HostBarrier: CreateEvent failed for " << eventName << ": " << GetLastError();
+                CloseEvents();
+                m_SharedMemory.reset();
+                return false;
+            }
+        }
+#endif
+
+        m_Segment = segment;
+        m_InstanceCount = instanceCount;
+        m_InstanceIndex = instanceIndex;
+        m_ActiveInstances = ((1u << instanceCount) - 1) & ~1u;
+        return true;
+    }
+
+    bool HostBarrier::WaitForOtherInstances(const std::chrono::microseconds timeout)
+    {
+        const auto targetSequence = m_Segment->releaseSequence.load(std::memory_order_relaxed) + 1;
+        const auto hasArrived = [this, targetSequence](const uint32_t instanceIndex)
+        {
+            return m_Segment->instances[instanceIndex].arrivedSequence.load(std::memory_order_acquire) ==
+                targetSequence;
+        };
+
+        // Instances that timed out are waited on again as soon as they arrive.
+        for (uint32_t instanceIndex = 1; instanceIndex < m_InstanceCount; ++instanceIndex)
+        {
+            if ((m_ActiveInstances & (1u << instanceIndex)) == 0 && hasArrived(instanceIndex))
+            {
+                CLUSTER_LOG << "HostBarrier: instance " << instanceIndex << " is back, waiting on it again";
+                m_ActiveInstances |= 1u << instanceIndex;
+            }
+        }
+
+        uint32_t missingInstances = 0;
+        const auto allArrived = [this, &hasArrived, &missingInstances]
+        {
+            missingInstances = 0;
+            for (uint32_t instanceIndex = 1; instanceIndex < m_InstanceCount; ++instanceIndex)
+            {
+                if ((m_ActiveInstances & (1u << instanceIndex)) != 0 && !hasArrived(instanceIndex))
+                {
+                    missingInstances |= 1u << instanceIndex;
+                }
+            }
+            return missingInstances == 0;
+        };
+        if (WaitFor(allArrived, Clock::now() + timeout))
+        {
+            return true;
+        }
+
+        CLUSTER_LOG_WARNING << "HostBarrier: timed out, no longer waiting on instance(s) with mask 0x" << std::hex
+                            << missingInstances;
+        m_ActiveInstances &= ~missingInstances;
+        return false;
+    }
+
+    void HostBarrier::Release(const uint64_t generation)
+    {
+        m_Segment->releasedGeneration.store(generation, std::memory_order_relaxed);
+        m_Segment->releaseTimeNs.store(NowNs(), std::memory_order_relaxed);
+        m_Segment->releaseSequence.fetch_add(1, std::memory_order_release);
+        for (uint32_t instanceIndex = 1; instanceIndex < m_InstanceCount; ++instanceIndex)
+        {
+            Wake(instanceIndex);
+        }
+    }
+
+    bool HostBarrier::ArriveAndWait(const std::chrono::microseconds timeout, uint64_t& generation,
+        std::chrono::nanoseconds& releaseLatency)
+    {
+        const auto sequence = m_Segment->releaseSequence.load(std::memory_order_acquire);
+        m_Segment->instances[m_InstanceIndex].arrivedSequence.store(sequence + 1, std::memory_order_release);
+        Wake(0);
+
+        const auto released = [this, sequence]
+        {
+            return m_Segment->releaseSequence.load(std::memory_order_acquire) != sequence;
+        };
+        if (!WaitFor(released, Clock::now() + timeout))
+        {
+            return false;
+        }
+        const auto nowNs = NowNs();
+        generation = m_Segment->releasedGeneration.load(std::memory_order_relaxed);
+        const auto releaseTimeNs = m_Segment->releaseTimeNs.load(std::memory_order_relaxed);
+        releaseLatency = std::chrono::nanoseconds(nowNs > releaseTimeNs ? nowNs - releaseTimeNs : 0);
+        return true;
+    }
+
+    template <typename Predicate>
+    bool HostBarrier::WaitFor(Predicate predicate, const Clock::time_point deadline)
+    {
+        auto& wakeSequence = m_Segment->instances[m_InstanceIndex].wakeSequence;
+        for (;;)
+        {
+            // Remarks: Read the sequence before testing the predicate so that a wake up happening in between is not
+            // lost (the futex wait returns immediately if the sequence changed).
+            const auto sequence = wakeSequence.load(std::memory_order_acquire);
+            if (predicate())
+            {
+                return true;
+            }
+            const auto now = Clock::now();
+            if (now >= deadline)
+            {
+                return false;
+            }
+            const auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
+
+#ifdef _WIN32
+            (void)sequence;
+            const auto remainingMs = std::chrono::ceil<std::chrono::milliseconds>(remaining).count();
+            WaitForSingleObject(m_Events[m_InstanceIndex], static_cast<DWORD>(remainingMs));
+#elif defined(__linux__)
+            timespec waitTime;
+            waitTime.tv_sec = static_cast<time_t>(remaining.count() / 1000000000);
+            waitTime.tv_nsec = static_cast<long>(remaining.count() % 1000000000);
+            // Remarks: Not FUTEX_PRIVATE_FLAG since the futex is shared with other processes.
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&wakeSequence), FUTEX_WAIT, sequence, &waitTime, nullptr,
+                0);
+#else
+            (void)sequence;
+            std::this_thread::sleep_for(std::min(remaining, std::chrono::nanoseconds(100000)));
+#endif
+        }
+    }
+
+    void HostBarrier::Wake(const uint32_t instanceIndex)
+    {
+        auto& wakeSequence = m_Segment->instances[instanceIndex].wakeSequence;
+        wakeSequence.fetch_add(1, std::memory_order_release);
+#ifdef _WIN32
+        SetEvent(m_Events[instanceIndex]);
+#elif defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&wakeSequence), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#endif
+    }
+
+    void HostBarrier::CloseEvents()
+    {
+#ifdef _WIN32
+        for (auto& event : m_Events)
+        {
+            if (event != nullptr)
+            {
+                CloseHandle(event);
+                event = nullptr;
+            }
+        }
+#endif
+    }
+}
@@ -0,0 +1,24 @@
+#include "ISyncApi.h"
+
+namespace GfxQuadroSync
+{
+    std::ostream& operator<<(std::ostream& os, const SyncApiStatus status)
+    {
+        const char* statusString = "Unknown";
+        switch (status)
+        {
+        case SyncApiStatus::Ok: statusString = "Ok"; break;
+        case SyncApiStatus::Error: statusString = "Error"; break;
+        case SyncApiStatus::LibraryNotFound: statusString = "LibraryNotFound"; break;
+        case SyncApiStatus::NoImplementation: statusString = "NoImplementation"; break;
+        case SyncApiStatus::ApiNotInitialized: statusString = "ApiNotInitialized"; break;
+        case SyncApiStatus::InvalidArgument: statusString = "InvalidArgument"; break;
+        case SyncApiStatus::NvidiaDeviceNotFound: statusString = "NvidiaDeviceNotFound"; break;
+        case SyncApiStatus::InvalidHandle: statusString = "InvalidHandle"; break;
+        case SyncApiStatus::NotSupported: statusString = "NotSupported"; break;
+        case SyncApiStatus::DeviceBusy: statusString = "DeviceBusy"; break;
+        case SyncApiStatus::InvalidCall: statusString = "InvalidCall"; break;
+        }
+        return os << statusString << " (" << static_cast<int>(status) << ')';
+    }
+}
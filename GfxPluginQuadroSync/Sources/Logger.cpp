@@ -1,26 +1,193 @@
 #include "Logger.h"
 
-#include "../../External/NvAPI/nvapi.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 
 namespace GfxQuadroSync
 {
+    namespace
+    {
+        static_assert((Logger::k_RecordCount & (Logger::k_RecordCount - 1)) == 0,
+            "k_RecordCount must be a power of 2");
+
+        /// Interval at which the drain thread delivers the messages logged in the meantime.
+        constexpr std::chrono::milliseconds k_DrainInterval{5};
+    }
+
+    Logger::Logger()
+    {
+        for (size_t recordIndex = 0; recordIndex < k_RecordCount; ++recordIndex)
+        {
+            m_Records[recordIndex].sequence.store(recordIndex, std::memory_order_relaxed);
+        }
+    }
+
+    Logger::~Logger()
+    {
+        StopDrainThread();
+    }
+
     void Logger::SetManagedCallback(const ManagedCallback managedCallback)
     {
-        m_ManagedCallback = managedCallback;
+        if (managedCallback == nullptr)
+        {
+            StopDrainThread();
+            m_ManagedCallback.store(nullptr, std::memory_order_relaxed);
+            return;
+        }
+
+        m_ManagedCallback.store(managedCallback, std::memory_order_relaxed);
+        if (m_Asynchronous.load(std::memory_order_relaxed))
+        {
+            StartDrainThread();
+        }
+    }
+
+    void Logger::SetAsynchronous(const bool value)
+    {
+        m_Asynchronous.store(value, std::memory_order_relaxed);
+        if (!value)
+        {
+            StopDrainThread();
+        }
+        else if (AreMessagesUseful())
+        {
+            StartDrainThread();
+        }
     }
 
-    void Logger::LogMessage(const LogType logType, const std::string& message)
+    void Logger::LogMessage(const LogType logType, const char* const message, const size_t length)
     {
-        if (m_ManagedCallback)
+        // Reserve a record (Dmitry Vyukov's bounded queue, multiple producers and a single consumer)
+        auto position = m_EnqueuePosition.load(std::memory_order_relaxed);
+        Record* record;
+        for (;;)
         {
-            m_ManagedCallback((int)logType, message.c_str());
+            record = &m_Records[position & (k_RecordCount - 1)];
+            const auto sequence = record->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<int64_t>(sequence - position);
+            if (difference == 0)
+            {
+                if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (difference < 0)
+            {
+                // Ring is full, never wait on the managed code.
+                m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            else
+            {
+                position = m_EnqueuePosition.load(std::memory_order_relaxed);
+            }
         }
+
+        const auto copiedLength = std::min(length, k_MaxMessageLength - 1);
+        record->logType = logType;
+        std::memcpy(record->message, message, copiedLength);
+        record->message[copiedLength] = 0;
+        record->sequence.store(position + 1, std::memory_order_release);
+
+        if (!m_Asynchronous.load(std::memory_order_relaxed))
+        {
+            Drain();
+        }
+    }
+
+    void Logger::Flush()
+    {
+        Drain();
     }
 
-    std::ostream& operator<<(std::ostream& os, const NvAPI_Status status)
+    void Logger::Shutdown()
     {
-        NvAPI_ShortString statusString;
-        NvAPI_GetErrorMessage(status, statusString);
-        return os << statusString << " (" << (int)status << ')';
+        m_Asynchronous.store(false, std::memory_order_relaxed);
+        StopDrainThread();
+    }
+
+    void Logger::StartDrainThread()
+    {
+        std::lock_guard<std::mutex> lock(m_DrainLock);
+        if (m_DrainThread.joinable())
+        {
+            return;
+        }
+
+        m_StopDrainThread = false;
+        try
+        {
+            m_DrainThread = std::thread(&Logger::DrainThreadMain, this);
+        }
+        catch (const std::exception&)
+        {
+            // Remarks: Messages are then delivered by the threads logging them.
+            m_Asynchronous.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    void Logger::StopDrainThread()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_DrainLock);
+            m_StopDrainThread = true;
+            m_DrainChanged.notify_all();
+        }
+        if (m_DrainThread.joinable())
+        {
+            m_DrainThread.join();
+        }
+        Drain();
+    }
+
+    void Logger::DrainThreadMain()
+    {
+        std::unique_lock<std::mutex> lock(m_DrainLock);
+        while (!m_StopDrainThread)
+        {
+            lock.unlock();
+            Drain();
+            lock.lock();
+            m_DrainChanged.wait_for(lock, k_DrainInterval, [this] { return m_StopDrainThread; });
+        }
+    }
+
+    void Logger::Drain()
+    {
+        std::lock_guard<std::mutex> lock(m_DeliverLock);
+        const auto managedCallback = m_ManagedCallback.load(std::memory_order_relaxed);
+        auto position = m_DequeuePosition.load(std::memory_order_relaxed);
+        uint64_t deliveredCount = 0;
+        for (;;)
+        {
+            auto& record = m_Records[position & (k_RecordCount - 1)];
+            if (record.sequence.load(std::memory_order_acquire) != position + 1)
+            {
+                break;
+            }
+            if (managedCallback != nullptr)
+            {
+                managedCallback(static_cast<int>(record.logType), record.message);
+                ++deliveredCount;
+            }
+            record.sequence.store(position + k_RecordCount, std::memory_order_release);
+            ++position;
+        }
+        m_DequeuePosition.store(position, std::memory_order_relaxed);
+        m_DeliveredCount.fetch_add(deliveredCount, std::memory_order_relaxed);
+
+        const auto droppedCount = m_DroppedCount.load(std::memory_order_relaxed);
+        if (droppedCount != m_ReportedDroppedCount && managedCallback != nullptr)
+        {
+            char message[96];
+            std::snprintf(message, sizeof(message), "QuadroSync: %llu log message(s) dropped (too many messages)",
+                static_cast<unsigned long long>(droppedCount - m_ReportedDroppedCount));
+            managedCallback(static_cast<int>(LogType::Warning), message);
+            m_ReportedDroppedCount = droppedCount;
+        }
     }
 }
@@ -0,0 +1,162 @@
+#include "MappedFile.h"
+#include "Logger.h"
+
+#include <cstdint>
+#include <utility>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace GfxQuadroSync
+{
+    MappedFile::~MappedFile()
+    {
+        reset();
+    }
+
+    MappedFile::MappedFile(MappedFile&& toMove) noexcept
+    {
+        *this = std::move(toMove);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& toMove) noexcept
+    {
+        std::swap(m_Data, toMove.m_Data);
+        std::swap(m_Size, toMove.m_Size);
+        std::swap(m_Path, toMove.m_Path);
+#ifdef _WIN32
+        std::swap(m_FileHandle, toMove.m_FileHandle);
+        std::swap(m_MappingHandle, toMove.m_MappingHandle);
+#endif
+        return *this;
+    }
+
+#ifdef _WIN32
+    bool MappedFile::Create(const std::string& path, const size_t size)
+    {
+        reset();
+
+        const auto fileHandle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+            CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE)
+        {
+            CLUSTER_LOG_ERROR << "CreateFile failed for " << path << ": " << GetLastError();
+            return false;
+        }
+
+        // Remarks: Mapping a file larger than it is extends it (with zeros).
+        const auto mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READWRITE,
+            static_cast<DWORD>(static_cast<uint64_t>(size) >> 32), static_cast<DWORD>(size), nullptr);
+        if (mappingHandle == NULL)
+        {
+            CLUSTER_LOG_ERROR << "CreateFileMapping failed for " << path << ": " << GetLastError();
+            CloseHandle(fileHandle);
+            return false;
+        }
+
+        const auto data = MapViewOfFile(mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+        if (data == nullptr)
+        {
+            CLUSTER_LOG_ERROR << "MapViewOfFile failed for " << path << ": " << GetLastError();
+            CloseHandle(mappingHandle);
+            CloseHandle(fileHandle);
+            return false;
+        }
+
+        m_FileHandle = fileHandle;
+        m_MappingHandle = mappingHandle;
+        m_Data = data;
+        m_Size = size;
+        m_Path = path;
+        return true;
+    }
+
+    void MappedFile::Flush()
+    {
+        if (m_Data != nullptr)
+        {
+            FlushViewOfFile(m_Data, m_Size);
+        }
+    }
+
+    void MappedFile::reset()
+    {
+        if (m_Data != nullptr)
+        {
+            UnmapViewOfFile(m_Data);
+            m_Data = nullptr;
+        }
+        if (m_MappingHandle != nullptr)
+        {
+            CloseHandle(m_MappingHandle);
+            m_MappingHandle = nullptr;
+        }
+        if (m_FileHandle != nullptr)
+        {
+            CloseHandle(m_FileHandle);
+            m_FileHandle = nullptr;
+        }
+        m_Size = 0;
+        m_Path.clear();
+    }
+#else
+    bool MappedFile::Create(const std::string& path, const size_t size)
+    {
+        reset();
+
+        const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+        if (fd < 0)
+        {
+            CLUSTER_LOG_ERROR << "open failed for " << path << ": " << strerror(errno);
+            return false;
+        }
+
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            CLUSTER_LOG_ERROR << "ftruncate failed for " << path << ": " << strerror(errno);
+            close(fd);
+            return false;
+        }
+
+        const auto data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED)
+        {
+            CLUSTER_LOG_ERROR << "mmap failed for " << path << ": " << strerror(errno);
+            return false;
+        }
+
+        m_Data = data;
+        m_Size = size;
+        m_Path = path;
+        return true;
+    }
+
+    void MappedFile::Flush()
+    {
+        if (m_Data != nullptr)
+        {
+            msync(m_Data, m_Size, MS_ASYNC);
+        }
+    }
+
+    void MappedFile::reset()
+    {
+        if (m_Data != nullptr)
+        {
+            munmap(m_Data, m_Size);
+            m_Data = nullptr;
+        }
+        m_Size = 0;
+        m_Path.clear();
+    }
+#endif
+}
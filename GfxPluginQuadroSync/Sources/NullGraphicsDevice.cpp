@@ -0,0 +1,95 @@
+#include "NullGraphicsDevice.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace GfxQuadroSync
+{
+    NullGraphicsDevice::NullGraphicsDevice(const Config& config)
+        : m_Config(config)
+        , m_SwapChain{this}
+        , m_VblankOrigin(Clock::now())
+        , m_PendingFlips(std::max(config.maxFrameLatency, 1u))
+        , m_LastFlip(m_VblankOrigin)
+    {
+    }
+
+    IUnknown* NullGraphicsDevice::GetDevice() const
+    {
+        return reinterpret_cast<IUnknown*>(const_cast<NullGraphicsDevice*>(this));
+    }
+
+    IDXGISwapChain* NullGraphicsDevice::GetSwapChain() const
+    {
+        return reinterpret_cast<IDXGISwapChain*>(const_cast<SyntheticSwapChain*>(&m_SwapChain));
+    }
+
+    bool NullGraphicsDevice::Present()
+    {
+        m_BackBufferIndex = (m_BackBufferIndex + 1) % std::max(m_Config.backBufferCount, 1u);
+        ++m_PresentCount;
+        const auto refreshPeriod = m_Config.refreshPeriod;
+        if (refreshPeriod.count() <= 0 || m_Config.syncInterval == 0)
+        {
+            return true;
+        }
+
+        // Forget about the presents that were flipped since the last present.
+        auto now = Clock::now();
+        const auto capacity = m_PendingFlips.size();
+        while (m_PendingFlipCount > 0 && m_PendingFlips[m_FirstPendingFlip] <= now)
+        {
+            m_FirstPendingFlip = (m_FirstPendingFlip + 1) % capacity;
+            --m_PendingFlipCount;
+        }
+
+        // The flip queue is full, wait until the oldest present is flipped.
+        if (m_PendingFlipCount == capacity)
+        {
+            const auto flip = m_PendingFlips[m_FirstPendingFlip];
+            std::this_thread::sleep_until(flip);
+            const auto unblocked = Clock::now();
+            ++m_BlockedPresentCount;
+            m_BlockedDuration += std::chrono::duration_cast<std::chrono::nanoseconds>(unblocked - now);
+            now = unblocked;
+            m_FirstPendingFlip = (m_FirstPendingFlip + 1) % capacity;
+            --m_PendingFlipCount;
+        }
+
+        // Flip on the first vblank after now that is at least syncInterval refreshes after the previous flip.
+        const auto refreshesSinceOrigin = (now - m_VblankOrigin + refreshPeriod - Clock::duration(1)) / refreshPeriod;
+        const auto nextVblank = m_VblankOrigin + refreshesSinceOrigin * refreshPeriod;
+        const auto flip = std::max(nextVblank, m_LastFlip + m_Config.syncInterval * refreshPeriod);
+        m_PendingFlips[(m_FirstPendingFlip + m_PendingFlipCount) % capacity] =
+            std::chrono::time_point_cast<Clock::duration>(flip);
+        ++m_PendingFlipCount;
+        m_LastFlip = std::chrono::time_point_cast<Clock::duration>(flip);
+        return true;
+    }
+
+    void NullGraphicsDevice::InitiatePresentRepeats()
+    {
+        if (m_Repeating)
+        {
+            CLUSTER_LOG_ERROR << "InitiatePresentRepeats called multiple times without calling ConcludePresentRepeats";
+            ++m_RepeatContractViolationCount;
+        }
+        m_Repeating = true;
+    }
+
+    void NullGraphicsDevice::PrepareSinglePresentRepeat()
+    {
+        if (!m_Repeating)
+        {
+            ++m_RepeatContractViolationCount;
+            return;
+        }
+        ++m_RepeatCount;
+    }
+
+    void NullGraphicsDevice::ConcludePresentRepeats()
+    {
+        m_Repeating = false;
+    }
+}
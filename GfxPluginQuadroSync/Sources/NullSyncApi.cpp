@@ -0,0 +1,65 @@
+#include "NullSyncApi.h"
+#include "IGraphicsDevice.h"
+
+namespace GfxQuadroSync
+{
+    SyncApiStatus NullSyncApi::QueryMaxSwapGroup(IUnknown*, uint32_t& maxGroups, uint32_t& maxBarriers)
+    {
+        maxGroups = 1;
+        maxBarriers = 1;
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus NullSyncApi::JoinSwapGroup(IUnknown*, IDXGISwapChain*, const uint32_t group, bool)
+    {
+        if (group > 1)
+        {
+            return SyncApiStatus::InvalidArgument;
+        }
+        m_GroupId = group;
+        if (m_GroupId == 0)
+        {
+            m_BarrierId = 0;
+        }
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus NullSyncApi::BindSwapBarrier(IUnknown*, const uint32_t group, const uint32_t barrier)
+    {
+        if (barrier > 1 || group != m_GroupId || (barrier > 0 && m_GroupId == 0))
+        {
+            return SyncApiStatus::InvalidArgument;
+        }
+        m_BarrierId = barrier;
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus NullSyncApi::QuerySwapGroup(IUnknown*, IDXGISwapChain*, uint32_t& group, uint32_t& barrier)
+    {
+        group = m_GroupId;
+        barrier = m_BarrierId;
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus NullSyncApi::QueryFrameCount(IUnknown*, uint32_t& frameCount)
+    {
+        frameCount = m_PresentCount;
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus NullSyncApi::ResetFrameCount(IUnknown*)
+    {
+        m_PresentCount = 0;
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus NullSyncApi::Present(IGraphicsDevice& graphicsDevice)
+    {
+        if (!graphicsDevice.Present())
+        {
+            return SyncApiStatus::Error;
+        }
+        ++m_PresentCount;
+        return SyncApiStatus::Ok;
+    }
+}
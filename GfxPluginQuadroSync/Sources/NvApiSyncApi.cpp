@@ -0,0 +1,113 @@
+#include "NvApiSyncApi.h"
+#include "IGraphicsDevice.h"
+#include "Logger.h"
+
+#include "../External/NvAPI/nvapi.h"
+
+namespace GfxQuadroSync
+{
+    namespace
+    {
+        /**
+         * operator<< for NvAPI_Status that will write it to the stream as a number and a string (string returned by
+         * NvAPI_GetErrorMessage).
+         */
+        std::ostream& operator<<(std::ostream& os, const NvAPI_Status status)
+        {
+            NvAPI_ShortString statusString;
+            NvAPI_GetErrorMessage(status, statusString);
+            return os << statusString << " (" << (int)status << ')';
+        }
+
+        SyncApiStatus ToSyncApiStatus(const NvAPI_Status status)
+        {
+            return static_cast<SyncApiStatus>(status);
+        }
+    }
+
+    SyncApiStatus NvApiSyncApi::Initialize()
+    {
+        return ToSyncApiStatus(NvAPI_Initialize());
+    }
+
+    SyncApiStatus NvApiSyncApi::SetupWorkstationSwapGroupFeature(const bool enable)
+    {
+        NvU32 gpuCount;
+        NvPhysicalGpuHandle nvGPUHandle[NVAPI_MAX_PHYSICAL_GPUS];
+        NvAPI_Status status = NvAPI_EnumPhysicalGPUs(nvGPUHandle, &gpuCount);
+        if (status != NVAPI_OK)
+        {
+            CLUSTER_LOG_ERROR << "NvAPI_EnumPhysicalGPUs failed: " << status;
+            return ToSyncApiStatus(status);
+        }
+
+        auto ret = NVAPI_OK;
+        for (unsigned int gpuIndex = 0; gpuIndex < gpuCount; gpuIndex++)
+        {
+            // send request to enable / disable NVAPI_GPU_WORKSTATION_FEATURE_MASK_SWAPGROUP
+            const NvU32 enableMask = enable ? NVAPI_GPU_WORKSTATION_FEATURE_MASK_SWAPGROUP : 0;
+            const NvU32 disableMask = enable ? 0 : NVAPI_GPU_WORKSTATION_FEATURE_MASK_SWAPGROUP;
+            status = NvAPI_GPU_WorkstationFeatureSetup(nvGPUHandle[gpuIndex], enableMask, disableMask);
+
+            if (status == NvAPI_Status::NVAPI_OK)
+                CLUSTER_LOG << "GPU " << gpuIndex << ": NvAPI_GPU_WorkstationFeatureSetup successful";
+            else
+            {
+                CLUSTER_LOG_ERROR << "GPU " << gpuIndex << ": NvAPI_GPU_WorkstationFeatureSetup failed: " << status;
+                ret = status;
+            }
+        }
+        return ToSyncApiStatus(ret);
+    }
+
+    SyncApiStatus NvApiSyncApi::QueryMaxSwapGroup(IUnknown* const pDevice, uint32_t& maxGroups, uint32_t& maxBarriers)
+    {
+        NvU32 nvMaxGroups = 0;
+        NvU32 nvMaxBarriers = 0;
+        const auto status = NvAPI_D3D1x_QueryMaxSwapGroup(pDevice, &nvMaxGroups, &nvMaxBarriers);
+        maxGroups = nvMaxGroups;
+        maxBarriers = nvMaxBarriers;
+        return ToSyncApiStatus(status);
+    }
+
+    SyncApiStatus NvApiSyncApi::JoinSwapGroup(IUnknown* const pDevice, IDXGISwapChain* const pSwapChain,
+        const uint32_t group, const bool blocking)
+    {
+        return ToSyncApiStatus(NvAPI_D3D1x_JoinSwapGroup(pDevice, pSwapChain, group, blocking ? 1 : 0));
+    }
+
+    SyncApiStatus NvApiSyncApi::BindSwapBarrier(IUnknown* const pDevice, const uint32_t group, const uint32_t barrier)
+    {
+        return ToSyncApiStatus(NvAPI_D3D1x_BindSwapBarrier(pDevice, group, barrier));
+    }
+
+    SyncApiStatus NvApiSyncApi::QuerySwapGroup(IUnknown* const pDevice, IDXGISwapChain* const pSwapChain,
+        uint32_t& group, uint32_t& barrier)
+    {
+        NvU32 nvGroup = 0;
+        NvU32 nvBarrier = 0;
+        const auto status = NvAPI_D3D1x_QuerySwapGroup(pDevice, pSwapChain, &nvGroup, &nvBarrier);
+        group = nvGroup;
+        barrier = nvBarrier;
+        return ToSyncApiStatus(status);
+    }
+
+    SyncApiStatus NvApiSyncApi::QueryFrameCount(IUnknown* const pDevice, uint32_t& frameCount)
+    {
+        NvU32 nvFrameCount = 0;
+        const auto status = NvAPI_D3D1x_QueryFrameCount(pDevice, &nvFrameCount);
+        frameCount = nvFrameCount;
+        return ToSyncApiStatus(status);
+    }
+
+    SyncApiStatus NvApiSyncApi::ResetFrameCount(IUnknown* const pDevice)
+    {
+        return ToSyncApiStatus(NvAPI_D3D1x_ResetFrameCount(pDevice));
+    }
+
+    SyncApiStatus NvApiSyncApi::Present(IGraphicsDevice& graphicsDevice)
+    {
+        return ToSyncApiStatus(NvAPI_D3D1x_Present(graphicsDevice.GetDevice(), graphicsDevice.GetSwapChain(),
+            graphicsDevice.GetSyncInterval(), graphicsDevice.GetPresentFlags()));
+    }
+}
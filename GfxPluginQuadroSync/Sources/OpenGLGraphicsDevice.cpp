@@ -0,0 +1,242 @@
+#include "OpenGLGraphicsDevice.h"
+#include "Logger.h"
+
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <GL/glx.h>
+
+#include <cstdint>
+
+namespace GfxQuadroSync
+{
+    namespace
+    {
+        template <typename FunctionType>
+        bool LoadFunction(const char* const name, FunctionType& loaded)
+        {
+            loaded = reinterpret_cast<FunctionType>(glXGetProcAddressARB(reinterpret_cast<const GLubyte*>(name)));
+            if (loaded == nullptr)
+            {
+                CLUSTER_LOG_ERROR << "OpenGLGraphicsDevice: failed to get " << name;
+                return false;
+            }
+            return true;
+        }
+
+        /// Framebuffer state modified by the blits (restored by the destructor).
+        class FramebufferStateGuard
+        {
+        public:
+            FramebufferStateGuard(void (*bindFramebuffer)(unsigned int, unsigned int))
+                : m_BindFramebuffer(bindFramebuffer)
+            {
+                glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &m_ReadFramebuffer);
+                glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &m_DrawFramebuffer);
+                m_ScissorTest = glIsEnabled(GL_SCISSOR_TEST);
+
+                // Remarks: Read and draw buffers are a state of the framebuffer, the ones of the default framebuffer
+                // are changed by the blits.
+                m_BindFramebuffer(GL_FRAMEBUFFER, 0);
+                glGetIntegerv(GL_READ_BUFFER, &m_DefaultReadBuffer);
+                glGetIntegerv(GL_DRAW_BUFFER, &m_DefaultDrawBuffer);
+                glDisable(GL_SCISSOR_TEST);
+            }
+
+            ~FramebufferStateGuard()
+            {
+                m_BindFramebuffer(GL_FRAMEBUFFER, 0);
+                glReadBuffer(static_cast<GLenum>(m_DefaultReadBuffer));
+                glDrawBuffer(static_cast<GLenum>(m_DefaultDrawBuffer));
+                m_BindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(m_ReadFramebuffer));
+                m_BindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(m_DrawFramebuffer));
+                if (m_ScissorTest)
+                    glEnable(GL_SCISSOR_TEST);
+            }
+
+            FramebufferStateGuard(const FramebufferStateGuard&) = delete;
+            FramebufferStateGuard& operator=(const FramebufferStateGuard&) = delete;
+
+        private:
+            void (*m_BindFramebuffer)(unsigned int, unsigned int);
+            GLint m_ReadFramebuffer = 0;
+            GLint m_DrawFramebuffer = 0;
+            GLint m_DefaultReadBuffer = GL_BACK;
+            GLint m_DefaultDrawBuffer = GL_BACK;
+            GLboolean m_ScissorTest = GL_FALSE;
+        };
+    }
+
+    OpenGLGraphicsDevice::OpenGLGraphicsDevice(Display* const display, const GLXDrawable drawable, const int screen)
+        : m_Display(display)
+        , m_Drawable(drawable)
+        , m_Screen(screen)
+    {
+        auto& functions = m_Functions;
+        bool loaded = LoadFunction("glGenFramebuffers", functions.glGenFramebuffers);
+        loaded = LoadFunction("glDeleteFramebuffers", functions.glDeleteFramebuffers) && loaded;
+        loaded = LoadFunction("glBindFramebuffer", functions.glBindFramebuffer) && loaded;
+        loaded = LoadFunction("glCheckFramebufferStatus", functions.glCheckFramebufferStatus) && loaded;
+        loaded = LoadFunction("glFramebufferRenderbuffer", functions.glFramebufferRenderbuffer) && loaded;
+        loaded = LoadFunction("glGenRenderbuffers", functions.glGenRenderbuffers) && loaded;
+        loaded = LoadFunction("glDeleteRenderbuffers", functions.glDeleteRenderbuffers) && loaded;
+        loaded = LoadFunction("glBindRenderbuffer", functions.glBindRenderbuffer) && loaded;
+        loaded = LoadFunction("glRenderbufferStorage", functions.glRenderbufferStorage) && loaded;
+        loaded = LoadFunction("glBlitFramebuffer", functions.glBlitFramebuffer) && loaded;
+        // Remarks: Presents still work without them, only the repeats are skipped.
+        m_FunctionsLoaded = loaded;
+    }
+
+    OpenGLGraphicsDevice::~OpenGLGraphicsDevice()
+    {
+        // Remarks: Objects are only deleted when the context is still current (it is not once Unity destroyed it).
+        if (glXGetCurrentContext() != nullptr)
+        {
+            ConcludePresentRepeats();
+        }
+    }
+
+    std::unique_ptr<OpenGLGraphicsDevice> OpenGLGraphicsDevice::CreateForCurrentContext()
+    {
+        const auto context = glXGetCurrentContext();
+        const auto display = glXGetCurrentDisplay();
+        const auto drawable = glXGetCurrentDrawable();
+        if (context == nullptr || display == nullptr || drawable == None)
+        {
+            CLUSTER_LOG_ERROR << "OpenGLGraphicsDevice: no GLX context is current on the calling thread";
+            return nullptr;
+        }
+
+        int screen = DefaultScreen(display);
+        if (glXQueryContext(display, context, GLX_SCREEN, &screen) != Success)
+        {
+            CLUSTER_LOG_WARNING << "OpenGLGraphicsDevice: failed to get the screen of the context, using screen "
+                << DefaultScreen(display);
+            screen = DefaultScreen(display);
+        }
+        return std::make_unique<OpenGLGraphicsDevice>(display, drawable, screen);
+    }
+
+    IUnknown* OpenGLGraphicsDevice::GetDevice() const
+    {
+        return reinterpret_cast<IUnknown*>(m_Display);
+    }
+
+    IDXGISwapChain* OpenGLGraphicsDevice::GetSwapChain() const
+    {
+        return reinterpret_cast<IDXGISwapChain*>(static_cast<uintptr_t>(m_Drawable));
+    }
+
+    bool OpenGLGraphicsDevice::Present()
+    {
+        if (m_Display == nullptr || m_Drawable == 0)
+        {
+            return false;
+        }
+        glXSwapBuffers(m_Display, m_Drawable);
+        return true;
+    }
+
+    void OpenGLGraphicsDevice::InitiatePresentRepeats()
+    {
+        if (m_SavedFramebuffer != 0)
+        {
+            CLUSTER_LOG_ERROR << "InitiatePresentRepeats called multiple times without calling ConcludePresentRepeats";
+            return;
+        }
+        if (!m_FunctionsLoaded || !CreateSavedFramebuffer())
+        {
+            return;
+        }
+        Blit(true);
+    }
+
+    void OpenGLGraphicsDevice::PrepareSinglePresentRepeat()
+    {
+        if (m_SavedFramebuffer != 0)
+        {
+            Blit(false);
+        }
+    }
+
+    void OpenGLGraphicsDevice::ConcludePresentRepeats()
+    {
+        if (m_SavedFramebuffer != 0)
+        {
+            m_Functions.glDeleteFramebuffers(1, &m_SavedFramebuffer);
+            m_SavedFramebuffer = 0;
+        }
+        if (m_SavedRenderbuffer != 0)
+        {
+            m_Functions.glDeleteRenderbuffers(1, &m_SavedRenderbuffer);
+            m_SavedRenderbuffer = 0;
+        }
+    }
+
+    bool OpenGLGraphicsDevice::CreateSavedFramebuffer()
+    {
+        unsigned int width = 0;
+        unsigned int height = 0;
+        glXQueryDrawable(m_Display, m_Drawable, GLX_WIDTH, &width);
+        glXQueryDrawable(m_Display, m_Drawable, GLX_HEIGHT, &height);
+        if (width == 0 || height == 0)
+        {
+            CLUSTER_LOG_ERROR << "OpenGLGraphicsDevice: failed to get the size of the drawable";
+            return false;
+        }
+
+        FramebufferStateGuard stateGuard(m_Functions.glBindFramebuffer);
+        GLint sampleBuffers = 0;
+        glGetIntegerv(GL_SAMPLE_BUFFERS, &sampleBuffers);
+        if (sampleBuffers != 0)
+        {
+            if (!m_MultisampledLogged)
+            {
+                CLUSTER_LOG_WARNING << "OpenGLGraphicsDevice: present repeats are not supported on multisampled "
+                    << "drawables, the last frame will be presented as is";
+                m_MultisampledLogged = true;
+            }
+            return false;
+        }
+
+        GLint previousRenderbuffer = 0;
+        glGetIntegerv(GL_RENDERBUFFER_BINDING, &previousRenderbuffer);
+        m_Functions.glGenRenderbuffers(1, &m_SavedRenderbuffer);
+        m_Functions.glBindRenderbuffer(GL_RENDERBUFFER, m_SavedRenderbuffer);
+        m_Functions.glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, static_cast<int>(width),
+            static_cast<int>(height));
+        m_Functions.glBindRenderbuffer(GL_RENDERBUFFER, static_cast<GLuint>(previousRenderbuffer));
+
+        m_Functions.glGenFramebuffers(1, &m_SavedFramebuffer);
+        m_Functions.glBindFramebuffer(GL_FRAMEBUFFER, m_SavedFramebuffer);
+        m_Functions.glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER,
+            m_SavedRenderbuffer);
+        const auto status = m_Functions.glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        if (status != GL_FRAMEBUFFER_COMPLETE)
+        {
+            CLUSTER_LOG_ERROR << "OpenGLGraphicsDevice: saved framebuffer is incomplete: " << status;
+            ConcludePresentRepeats();
+            return false;
+        }
+
+        m_Width = static_cast<int>(width);
+        m_Height = static_cast<int>(height);
+        return true;
+    }
+
+    void OpenGLGraphicsDevice::Blit(const bool toSavedFramebuffer)
+    {
+        FramebufferStateGuard stateGuard(m_Functions.glBindFramebuffer);
+        if (toSavedFramebuffer)
+        {
+            glReadBuffer(GL_BACK);
+            m_Functions.glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_SavedFramebuffer);
+        }
+        else
+        {
+            glDrawBuffer(GL_BACK);
+            m_Functions.glBindFramebuffer(GL_READ_FRAMEBUFFER, m_SavedFramebuffer);
+        }
+        m_Functions.glBlitFramebuffer(0, 0, m_Width, m_Height, 0, 0, m_Width, m_Height, GL_COLOR_BUFFER_BIT,
+            GL_NEAREST);
+    }
+}
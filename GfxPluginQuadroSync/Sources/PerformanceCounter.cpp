@@ -0,0 +1,77 @@
+#include "PerformanceCounter.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace GfxQuadroSync
+{
+    namespace
+    {
+        PerformanceCounterSource s_PerformanceCounterSource = nullptr;
+        void* s_PerformanceCounterSourceContext = nullptr;
+    }
+
+    void SetPerformanceCounterSource(const PerformanceCounterSource source, void* const context)
+    {
+        s_PerformanceCounterSource = source;
+        s_PerformanceCounterSourceContext = context;
+    }
+
+#ifdef _WIN32
+    uint64_t GetCurrentPerformanceCounterTick()
+    {
+        if (s_PerformanceCounterSource != nullptr)
+        {
+            return s_PerformanceCounterSource(s_PerformanceCounterSourceContext);
+        }
+
+        LARGE_INTEGER ret;
+        if (QueryPerformanceCounter(&ret))
+        {
+            return ret.QuadPart;
+        }
+        else
+        {
+            // I've never seen QueryPerformanceCounter fail, but let's play safe...
+            return 0;
+        }
+    }
+
+    uint64_t GetPerformanceCounterFrequency()
+    {
+        static const uint64_t s_PerformanceCounterFrequency = []() -> uint64_t
+        {
+            LARGE_INTEGER performanceCounterFrequency;
+            if (QueryPerformanceFrequency(&performanceCounterFrequency))
+            {
+                return performanceCounterFrequency.QuadPart;
+            }
+            return 0;
+        }();
+        return s_PerformanceCounterFrequency;
+    }
+#else
+    uint64_t GetCurrentPerformanceCounterTick()
+    {
+        if (s_PerformanceCounterSource != nullptr)
+        {
+            return s_PerformanceCounterSource(s_PerformanceCounterSourceContext);
+        }
+
+        timespec now;
+        if (clock_gettime(CLOCK_MONOTONIC, &now) == 0)
+        {
+            return static_cast<uint64_t>(now.tv_sec) * 1000000000ull + now.tv_nsec;
+        }
+        return 0;
+    }
+
+    uint64_t GetPerformanceCounterFrequency()
+    {
+        return 1000000000ull;
+    }
+#endif
+}
@@ -0,0 +1,143 @@
+#include "PluginProfiler.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace GfxQuadroSync
+{
+    namespace
+    {
+        const char* const k_MarkerNames[] = {
+            "QuadroSync.Render",
+            "QuadroSync.Present",
+            "QuadroSync.BarrierWarmupRepeat",
+            "QuadroSync.QueryFrameCount",
+        };
+        static_assert(sizeof(k_MarkerNames) / sizeof(k_MarkerNames[0]) ==
+            static_cast<size_t>(PluginProfilerMarker::Count), "Missing marker name");
+
+        struct CounterDescription
+        {
+            const char* name;
+            UnityProfilerMarkerDataUnit unit;
+        };
+
+        const CounterDescription k_CounterDescriptions[] = {
+            {"QuadroSync Present Duration", kUnityProfilerMarkerDataUnitTimeNanoseconds},
+            {"QuadroSync Barrier Wait", kUnityProfilerMarkerDataUnitTimeNanoseconds},
+            {"QuadroSync Warmup Repeats", kUnityProfilerMarkerDataUnitCount},
+            {"QuadroSync Present Successes", kUnityProfilerMarkerDataUnitCount},
+            {"QuadroSync Present Failures", kUnityProfilerMarkerDataUnitCount},
+        };
+        static_assert(sizeof(k_CounterDescriptions) / sizeof(k_CounterDescriptions[0]) ==
+            static_cast<size_t>(PluginProfilerCounter::Count), "Missing counter description");
+
+        struct RegisteredThread
+        {
+            UnityProfilerThreadId id = 0;
+            bool registered = false;
+        };
+
+        thread_local RegisteredThread t_RegisteredThread;
+    }
+
+    bool PluginProfiler::Initialize(IUnityInterfaces* const unityInterfaces)
+    {
+        if (m_Enabled.load(std::memory_order_relaxed))
+        {
+            return true;
+        }
+
+        std::fill(std::begin(m_Counters), std::end(m_Counters), nullptr);
+        if (const auto profilerV2 = unityInterfaces->Get<IUnityProfilerV2>())
+        {
+            if (!profilerV2->IsAvailable())
+            {
+                return false;
+            }
+
+            UnityProfilerCategoryId category = kUnityProfilerCategoryRender;
+            if (profilerV2->CreateCategory(&category, "QuadroSync", 0) != 0)
+            {
+                category = kUnityProfilerCategoryRender;
+            }
+            CreateMarkers(profilerV2, category);
+            for (size_t counterIndex = 0; counterIndex < static_cast<size_t>(PluginProfilerCounter::Count);
+                 ++counterIndex)
+            {
+                const auto& description = k_CounterDescriptions[counterIndex];
+                void* pValue = nullptr;
+                if (profilerV2->CreateCounterValue(&pValue, description.name, category,
+                        kUnityProfilerMarkerFlagDefault, kUnityProfilerMarkerDataTypeInt64, description.unit,
+                        sizeof(int64_t), kUnityProfilerCounterFlushOnEndOfFrame, nullptr, nullptr, nullptr) != 0)
+                {
+                    CLUSTER_LOG_WARNING << "PluginProfiler: failed to create counter " << description.name;
+                    pValue = nullptr;
+                }
+                m_Counters[counterIndex] = static_cast<int64_t*>(pValue);
+            }
+        }
+        else if (const auto profiler = unityInterfaces->Get<IUnityProfiler>())
+        {
+            if (!profiler->IsAvailable())
+            {
+                return false;
+            }
+            CreateMarkers(profiler, kUnityProfilerCategoryRender);
+        }
+        else
+        {
+            return false;
+        }
+
+        m_Enabled.store(true, std::memory_order_release);
+        CLUSTER_LOG << "PluginProfiler: reporting markers" << (m_Counters[0] != nullptr ? " and counters" : "")
+                    << " to the Unity profiler";
+        return true;
+    }
+
+    template <typename ProfilerInterface>
+    void PluginProfiler::CreateMarkers(ProfilerInterface* const profiler, const UnityProfilerCategoryId category)
+    {
+        m_EmitEvent = profiler->EmitEvent;
+        m_RegisterThread = profiler->RegisterThread;
+        m_UnregisterThread = profiler->UnregisterThread;
+        for (size_t markerIndex = 0; markerIndex < static_cast<size_t>(PluginProfilerMarker::Count); ++markerIndex)
+        {
+            if (profiler->CreateMarker(&m_Markers[markerIndex], k_MarkerNames[markerIndex], category,
+                    kUnityProfilerMarkerFlagDefault, 0) != 0)
+            {
+                CLUSTER_LOG_WARNING << "PluginProfiler: failed to create marker " << k_MarkerNames[markerIndex];
+                m_Markers[markerIndex] = nullptr;
+            }
+        }
+    }
+
+    void PluginProfiler::Shutdown()
+    {
+        m_Enabled.store(false, std::memory_order_relaxed);
+    }
+
+    void PluginProfiler::RegisterThread(const char* const name)
+    {
+        if (!m_Enabled.load(std::memory_order_acquire) || t_RegisteredThread.registered)
+        {
+            return;
+        }
+        t_RegisteredThread.registered = m_RegisterThread(&t_RegisteredThread.id, "QuadroSync", name) == 0;
+    }
+
+    void PluginProfiler::UnregisterThread()
+    {
+        if (!t_RegisteredThread.registered)
+        {
+            return;
+        }
+        if (m_Enabled.load(std::memory_order_acquire))
+        {
+            m_UnregisterThread(t_RegisteredThread.id);
+        }
+        t_RegisteredThread.registered = false;
+    }
+}
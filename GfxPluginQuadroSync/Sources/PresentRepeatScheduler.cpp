@@ -0,0 +1,54 @@
+#include "PresentRepeatScheduler.h"
+#include "Logger.h"
+
+#include <algorithm>
+
+namespace GfxQuadroSync
+{
+    void PresentRepeatScheduler::Reset(const uint32_t backBufferCount, const uint64_t lastFenceValue)
+    {
+        m_BackBufferFenceValues.assign(backBufferCount, 0);
+        m_LastFenceValue = lastFenceValue;
+        m_SubmittedCount = 0;
+        m_StallCount = 0;
+        m_MaxInFlightCount = 0;
+    }
+
+    bool PresentRepeatScheduler::SubmitRepeat(IPresentRepeatQueue& queue, const uint32_t backBufferIndex)
+    {
+        if (backBufferIndex >= m_BackBufferFenceValues.size())
+        {
+            CLUSTER_LOG_ERROR << "PresentRepeatScheduler: back buffer " << backBufferIndex << " out of "
+                << m_BackBufferFenceValues.size();
+            return false;
+        }
+
+        const auto previousFenceValue = m_BackBufferFenceValues[backBufferIndex];
+        auto completedFenceValue = queue.GetCompletedFenceValue();
+        if (completedFenceValue < previousFenceValue)
+        {
+            ++m_StallCount;
+            queue.WaitForFenceValue(previousFenceValue);
+            completedFenceValue = previousFenceValue;
+        }
+
+        const auto fenceValue = m_LastFenceValue + 1;
+        if (!queue.ExecuteRepeat(backBufferIndex, fenceValue))
+        {
+            return false;
+        }
+        m_LastFenceValue = fenceValue;
+        m_BackBufferFenceValues[backBufferIndex] = fenceValue;
+        ++m_SubmittedCount;
+        m_MaxInFlightCount = std::max(m_MaxInFlightCount, static_cast<uint32_t>(fenceValue - completedFenceValue));
+        return true;
+    }
+
+    void PresentRepeatScheduler::WaitForIdle(IPresentRepeatQueue& queue)
+    {
+        if (queue.GetCompletedFenceValue() < m_LastFenceValue)
+        {
+            queue.WaitForFenceValue(m_LastFenceValue);
+        }
+    }
+}
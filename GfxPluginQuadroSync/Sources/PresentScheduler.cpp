@@ -0,0 +1,259 @@
+#include "PresentScheduler.h"
+#include "Logger.h"
+#include "MessageSerialization.h"
+
+#include <algorithm>
+#include <thread>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+namespace GfxQuadroSync
+{
+    namespace
+    {
+        // Messages sent by the emitter:
+        // - Header: uint32 magic, uint8 version, uint8 type.
+        // - Target: uint64 sequence, uint64 target (cluster time in ns), uint64 refresh period (in ns).
+        // Multi-byte values are little endian.
+        constexpr uint32_t k_MessageMagic = 0x53505147; // "GQPS"
+        constexpr uint8_t k_MessageVersion = 1;
+        constexpr size_t k_HeaderSize = 6;
+        constexpr size_t k_TargetSize = k_HeaderSize + 24;
+        constexpr size_t k_MaxMessageSize = 64;
+
+        enum class MessageType : uint8_t
+        {
+            Target = 1,
+        };
+
+        /// Bounds of the margin before the target at which we stop sleeping and start spinning.
+        constexpr int64_t k_MinSpinMarginNs = 50000;
+        constexpr int64_t k_InitialSpinMarginNs = 1000000;
+    }
+
+    PresentScheduler::~PresentScheduler()
+    {
+        Stop();
+    }
+
+    bool PresentScheduler::Start(const Config& config, const ClockSync& clockSync,
+        std::unique_ptr<IDatagramTransport> transport)
+    {
+        Stop();
+
+        m_Config = config;
+        m_Config.refreshPeriod = std::max(m_Config.refreshPeriod, std::chrono::microseconds(1));
+        m_ClockSync = &clockSync;
+        m_Transport = std::move(transport);
+        m_Sequence = 0;
+        m_ReceivedTargetNs = 0;
+        m_LastTargetNs = 0;
+        m_OversleepNs = 0;
+        m_SpinMarginNs = std::min(k_InitialSpinMarginNs,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(m_Config.refreshPeriod).count() / 4);
+        m_JitterStatistics.Reset();
+        m_LatePresentCount = 0;
+        m_MissingTargetCount = 0;
+        m_UnsynchronizedPresentCount = 0;
+
+        if (!m_Transport)
+        {
+            CLUSTER_LOG_ERROR << "PresentScheduler: no transport to communicate with other nodes";
+            return false;
+        }
+
+#ifdef _WIN32
+        m_Timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+        if (m_Timer == nullptr)
+        {
+            // Remarks: High resolution timers are only available starting with Windows 10 1803.
+            m_Timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+        }
+#endif
+
+        CLUSTER_LOG << "PresentScheduler: starting as " << (m_Config.isEmitter ? "emitter" : "repeater")
+                    << " with a refresh period of " << m_Config.refreshPeriod.count() << " us";
+        m_Started = true;
+        return true;
+    }
+
+    void PresentScheduler::Stop()
+    {
+        m_Started = false;
+        m_Transport.reset();
+        CloseTimer();
+    }
+
+    void PresentScheduler::WaitForNextPresent()
+    {
+        int64_t targetNs = 0;
+        if (m_Config.isEmitter)
+        {
+            targetNs = ScheduleNextTarget();
+        }
+        else if (!ReceiveNextTarget(targetNs))
+        {
+            const auto lastTargetNs = m_LastTargetNs.load(std::memory_order_relaxed);
+            if (lastTargetNs == 0)
+            {
+                m_UnsynchronizedPresentCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            targetNs = lastTargetNs +
+                std::chrono::duration_cast<std::chrono::nanoseconds>(m_Config.refreshPeriod).count();
+            m_MissingTargetCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        m_LastTargetNs.store(targetNs, std::memory_order_relaxed);
+
+        int64_t localTargetNs = 0;
+        if (!m_ClockSync->ToLocalTime(targetNs, localTargetNs))
+        {
+            m_UnsynchronizedPresentCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (m_ClockSync->GetLocalTimeNs() > localTargetNs)
+        {
+            m_LatePresentCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            WaitUntil(localTargetNs);
+        }
+        m_JitterStatistics.Record(std::max<int64_t>(m_ClockSync->GetLocalTimeNs() - localTargetNs, 0) / 1000);
+    }
+
+    int64_t PresentScheduler::ScheduleNextTarget()
+    {
+        const auto periodNs = std::chrono::duration_cast<std::chrono::nanoseconds>(m_Config.refreshPeriod).count();
+        int64_t nowNs = 0;
+        m_ClockSync->ToClusterTime(m_ClockSync->GetLocalTimeNs(), nowNs);
+        const auto targetNs = std::max(m_LastTargetNs.load(std::memory_order_relaxed) + periodNs,
+            nowNs + periodNs * m_Config.leadPeriods);
+
+        uint8_t message[k_TargetSize];
+        WriteUInt32(message, k_MessageMagic);
+        message[4] = k_MessageVersion;
+        message[5] = static_cast<uint8_t>(MessageType::Target);
+        WriteUInt64(message + k_HeaderSize, m_Sequence++);
+        WriteUInt64(message + k_HeaderSize + 8, static_cast<uint64_t>(targetNs));
+        WriteUInt64(message + k_HeaderSize + 16, static_cast<uint64_t>(periodNs));
+        m_Transport->Send(message, sizeof(message));
+        return targetNs;
+    }
+
+    bool PresentScheduler::ReceiveNextTarget(int64_t& targetNs)
+    {
+        uint8_t message[k_MaxMessageSize];
+        bool received = false;
+
+        // Process everything already received (we might be late and the emitter already sent multiple targets).
+        for (;;)
+        {
+            const int size = m_Transport->Receive(message, sizeof(message), std::chrono::microseconds::zero());
+            if (size <= 0)
+            {
+                break;
+            }
+            received = ProcessMessage(message, size) || received;
+        }
+
+        const auto deadline = std::chrono::steady_clock::now() + m_Config.scheduleTimeout;
+        while (!received)
+        {
+            const auto remaining = std::chrono::ceil<std::chrono::microseconds>(
+                deadline - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0)
+            {
+                break;
+            }
+            const int size = m_Transport->Receive(message, sizeof(message), remaining);
+            if (size < 0)
+            {
+                break;
+            }
+            received = size > 0 && ProcessMessage(message, size);
+        }
+
+        if (received)
+        {
+            targetNs = m_ReceivedTargetNs;
+        }
+        return received;
+    }
+
+    bool PresentScheduler::ProcessMessage(const uint8_t* const message, const int size)
+    {
+        if (size < static_cast<int>(k_TargetSize) || ReadUInt32(message) != k_MessageMagic ||
+            message[4] != k_MessageVersion || message[5] != static_cast<uint8_t>(MessageType::Target))
+        {
+            return false;
+        }
+        const auto targetNs = static_cast<int64_t>(ReadUInt64(message + k_HeaderSize + 8));
+        m_ReceivedTargetNs = std::max(m_ReceivedTargetNs, targetNs);
+        return m_ReceivedTargetNs > m_LastTargetNs.load(std::memory_order_relaxed);
+    }
+
+    void PresentScheduler::WaitUntil(const int64_t localTimeNs)
+    {
+        const auto maxSpinMarginNs =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(m_Config.refreshPeriod).count() / 4;
+        for (;;)
+        {
+            const auto nowNs = m_ClockSync->GetLocalTimeNs();
+            const auto remainingNs = localTimeNs - nowNs;
+            if (remainingNs <= 0)
+            {
+                return;
+            }
+
+            const auto spinMarginNs = m_SpinMarginNs.load(std::memory_order_relaxed);
+            if (remainingNs <= spinMarginNs)
+            {
+                while (m_ClockSync->GetLocalTimeNs() < localTimeNs)
+                {
+                    std::this_thread::yield();
+                }
+                return;
+            }
+
+            // Calibrate the spin margin from how late we wake up (keeping a slowly decaying maximum).
+            const auto sleepNs = remainingNs - spinMarginNs;
+            Sleep(sleepNs);
+            const auto oversleepNs = std::max<int64_t>(m_ClockSync->GetLocalTimeNs() - (nowNs + sleepNs), 0);
+            m_OversleepNs = std::max(oversleepNs, m_OversleepNs - m_OversleepNs / 64);
+            m_SpinMarginNs.store(std::clamp(m_OversleepNs * 2, k_MinSpinMarginNs,
+                std::max(maxSpinMarginNs, k_MinSpinMarginNs)), std::memory_order_relaxed);
+        }
+    }
+
+    void PresentScheduler::Sleep(const int64_t durationNs)
+    {
+#ifdef _WIN32
+        if (m_Timer != nullptr)
+        {
+            // Remarks: Negative due time is relative, in 100 ns units.
+            LARGE_INTEGER dueTime;
+            dueTime.QuadPart = -std::max<int64_t>(durationNs / 100, 1);
+            if (SetWaitableTimer(m_Timer, &dueTime, 0, nullptr, nullptr, FALSE))
+            {
+                WaitForSingleObject(m_Timer, INFINITE);
+                return;
+            }
+        }
+#endif
+        std::this_thread::sleep_for(std::chrono::nanoseconds(durationNs));
+    }
+
+    void PresentScheduler::CloseTimer()
+    {
+#ifdef _WIN32
+        if (m_Timer != nullptr)
+        {
+            CloseHandle(m_Timer);
+            m_Timer = nullptr;
+        }
+#endif
+    }
+}
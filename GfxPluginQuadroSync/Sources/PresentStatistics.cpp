@@ -0,0 +1,151 @@
+#include "PresentStatistics.h"
+
+#include <algorithm>
+#include <functional>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace GfxQuadroSync
+{
+    namespace
+    {
+        /// Index of the most significant bit set in value (value must not be 0).
+        uint32_t MostSignificantBit(const uint64_t value)
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanReverse64(&index, value);
+            return index;
+#else
+            return 63 - __builtin_clzll(value);
+#endif
+        }
+    }
+
+    uint32_t LatencyHistogram::GetBucketIndex(const uint64_t value)
+    {
+        if (value < k_SubBucketCount * 2)
+        {
+            return static_cast<uint32_t>(value);
+        }
+
+        const auto magnitude = MostSignificantBit(value);
+        if (magnitude > k_MaxMagnitude)
+        {
+            return k_BucketCount - 1;
+        }
+
+        // Value >> shift is in [k_SubBucketCount, 2 * k_SubBucketCount[, so every shift value gets its own range of
+        // k_SubBucketCount buckets.
+        const auto shift = magnitude - k_SubBucketBits;
+        return shift * k_SubBucketCount + static_cast<uint32_t>(value >> shift);
+    }
+
+    uint64_t LatencyHistogram::GetBucketLowerBound(const uint32_t bucketIndex)
+    {
+        if (bucketIndex < k_SubBucketCount * 2)
+        {
+            return bucketIndex;
+        }
+
+        const auto shift = bucketIndex / k_SubBucketCount - 1;
+        const uint64_t subBucket = bucketIndex % k_SubBucketCount + k_SubBucketCount;
+        return subBucket << shift;
+    }
+
+    void LatencyHistogram::Reset()
+    {
+        for (auto& bucket : m_Buckets)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void PresentStatistics::Record(const uint64_t durationUs)
+    {
+        // Remarks: We are the only writer, so there is no need to pay for the (more expensive) atomic read-modify-write
+        // operations, a relaxed load followed by a relaxed store is enough.
+        const auto presentIndex = m_Count.load(std::memory_order_relaxed);
+        m_Histogram.Record(durationUs);
+        m_SumUs.store(m_SumUs.load(std::memory_order_relaxed) + durationUs, std::memory_order_relaxed);
+        if (durationUs < m_MinUs.load(std::memory_order_relaxed))
+        {
+            m_MinUs.store(durationUs, std::memory_order_relaxed);
+        }
+        if (durationUs > m_MaxUs.load(std::memory_order_relaxed))
+        {
+            m_MaxUs.store(durationUs, std::memory_order_relaxed);
+        }
+
+        // Move to the next outlier epoch (forgetting about the oldest one) every half window.
+        if (presentIndex > 0 && presentIndex % (k_OutlierWindowLength / 2) == 0)
+        {
+            m_CurrentOutlierEpoch = 1 - m_CurrentOutlierEpoch;
+            for (auto& outlier : m_Outliers[m_CurrentOutlierEpoch])
+            {
+                outlier.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        // Replace the smallest outlier of the current epoch if we are worse than it.
+        auto& epochOutliers = m_Outliers[m_CurrentOutlierEpoch];
+        const auto packed = PackOutlier(durationUs, presentIndex);
+        auto smallestIt = std::min_element(epochOutliers.begin(), epochOutliers.end(),
+            [](const std::atomic<uint64_t>& left, const std::atomic<uint64_t>& right)
+            {
+                return left.load(std::memory_order_relaxed) < right.load(std::memory_order_relaxed);
+            });
+        if (packed > smallestIt->load(std::memory_order_relaxed))
+        {
+            smallestIt->store(packed, std::memory_order_relaxed);
+        }
+
+        m_Count.store(presentIndex + 1, std::memory_order_release);
+    }
+
+    void PresentStatistics::Reset()
+    {
+        m_Histogram.Reset();
+        m_SumUs.store(0, std::memory_order_relaxed);
+        m_MinUs.store(UINT64_MAX, std::memory_order_relaxed);
+        m_MaxUs.store(0, std::memory_order_relaxed);
+        for (auto& epochOutliers : m_Outliers)
+        {
+            for (auto& outlier : epochOutliers)
+            {
+                outlier.store(0, std::memory_order_relaxed);
+            }
+        }
+        m_CurrentOutlierEpoch = 0;
+        m_Count.store(0, std::memory_order_release);
+    }
+
+    void PresentStatistics::GetOutliers(std::array<Outlier, k_OutlierCount>& outliers) const
+    {
+        std::array<uint64_t, k_OutlierCount * 2> allOutliers;
+        auto allOutliersIt = allOutliers.begin();
+        for (const auto& epochOutliers : m_Outliers)
+        {
+            for (const auto& outlier : epochOutliers)
+            {
+                *allOutliersIt++ = outlier.load(std::memory_order_relaxed);
+            }
+        }
+        std::partial_sort(allOutliers.begin(), allOutliers.begin() + k_OutlierCount, allOutliers.end(),
+            std::greater<uint64_t>());
+
+        for (uint32_t outlierIndex = 0; outlierIndex < k_OutlierCount; ++outlierIndex)
+        {
+            outliers[outlierIndex].durationUs = static_cast<uint32_t>(allOutliers[outlierIndex] >> 32);
+            outliers[outlierIndex].presentIndex = static_cast<uint32_t>(allOutliers[outlierIndex]);
+        }
+    }
+
+    uint64_t PresentStatistics::PackOutlier(const uint64_t durationUs, const uint64_t presentIndex)
+    {
+        const uint64_t clampedDuration = std::min<uint64_t>(durationUs, UINT32_MAX);
+        return (clampedDuration << 32) | (presentIndex & UINT32_MAX);
+    }
+}
@@ -0,0 +1,105 @@
+#include "PresentTelemetry.h"
+#include "PerformanceCounter.h"
+#include "Logger.h"
+
+#include <new>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace GfxQuadroSync
+{
+    namespace
+    {
+        uint32_t GetProcessId()
+        {
+#ifdef _WIN32
+            return GetCurrentProcessId();
+#else
+            return static_cast<uint32_t>(getpid());
+#endif
+        }
+    }
+
+    void PresentTelemetry::Initialize(const uint32_t recordCount)
+    {
+        if (m_Header != nullptr || recordCount == 0)
+        {
+            return;
+        }
+
+        const size_t totalSize = sizeof(PresentTelemetryHeader) + sizeof(PresentTelemetryRecord) * recordCount;
+        void* memory = nullptr;
+        bool created = false;
+        if (m_SharedMemory.CreateOrOpen("GfxPluginQuadroSyncTelemetry_" + std::to_string(GetProcessId()), totalSize,
+            created) && created)
+        {
+            memory = m_SharedMemory.get();
+            CLUSTER_LOG << "Present telemetry available in shared memory " << m_SharedMemory.name();
+        }
+        else
+        {
+            // Someone else is using our name (or we failed to create it), either way, continue with private memory.
+            m_SharedMemory.reset();
+            m_PrivateMemory.reset(new uint64_t[(totalSize + sizeof(uint64_t) - 1) / sizeof(uint64_t)]);
+            memory = m_PrivateMemory.get();
+            CLUSTER_LOG_WARNING << "Present telemetry is only available in process";
+        }
+
+        auto header = new (memory) PresentTelemetryHeader();
+        header->magic = PresentTelemetryHeader::k_Magic;
+        header->version = PresentTelemetryHeader::k_Version;
+        header->headerSize = sizeof(PresentTelemetryHeader);
+        header->recordSize = sizeof(PresentTelemetryRecord);
+        header->recordCount = recordCount;
+        header->reserved = 0;
+        header->performanceCounterFrequency = GetPerformanceCounterFrequency();
+        header->writeIndex.store(0, std::memory_order_relaxed);
+
+        auto records = reinterpret_cast<PresentTelemetryRecord*>(header + 1);
+        for (uint32_t recordIndex = 0; recordIndex < recordCount; ++recordIndex)
+        {
+            new (&records[recordIndex]) PresentTelemetryRecord();
+            records[recordIndex].sequence.store(0, std::memory_order_relaxed);
+        }
+
+        // Publish
+        std::atomic_thread_fence(std::memory_order_release);
+        m_Records = records;
+        m_Header = header;
+    }
+
+    void PresentTelemetry::Write(const uint64_t frameIndex, const uint64_t presentStartTick,
+        const uint64_t presentEndTick, const int32_t status, const bool skippedSync, const uint8_t warmupAction,
+        const uint16_t repeatIndex)
+    {
+        if (m_Header == nullptr)
+        {
+            return;
+        }
+
+        const auto recordIndex = m_Header->writeIndex.load(std::memory_order_relaxed);
+        auto& record = m_Records[recordIndex % m_Header->recordCount];
+
+        // Mark the record as being written (odd sequence) before touching any of its content.
+        const auto sequence = record.sequence.load(std::memory_order_relaxed);
+        record.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        record.status = status;
+        record.recordIndex = recordIndex;
+        record.frameIndex = frameIndex;
+        record.presentStartTick = presentStartTick;
+        record.presentEndTick = presentEndTick;
+        record.skippedSync = skippedSync ? 1 : 0;
+        record.warmupAction = warmupAction;
+        record.repeatIndex = repeatIndex;
+
+        // Back to an even sequence, record is ready to be read.
+        record.sequence.store(sequence + 2, std::memory_order_release);
+        m_Header->writeIndex.store(recordIndex + 1, std::memory_order_release);
+    }
+}
@@ -0,0 +1,114 @@
+#include "PresentWorker.h"
+#include "Logger.h"
+#include "PluginProfiler.h"
+
+#include <algorithm>
+
+namespace GfxQuadroSync
+{
+    PresentWorker::~PresentWorker()
+    {
+        Stop();
+    }
+
+    void PresentWorker::Start(const uint32_t maxInFlightFrames)
+    {
+        Stop();
+
+        m_MaxInFlightFrames = std::max(maxInFlightFrames, 1u);
+        {
+            Lock lock(m_Lock);
+            m_StopThread = false;
+        }
+        CLUSTER_LOG << "PresentWorker: starting with " << m_MaxInFlightFrames << " frame(s) in flight";
+        m_Thread = std::thread(&PresentWorker::ThreadMain, this);
+        m_Running = true;
+    }
+
+    void PresentWorker::Stop()
+    {
+        if (!m_Running)
+        {
+            return;
+        }
+
+        {
+            Lock lock(m_Lock);
+            m_StopThread = true;
+            m_Changed.notify_all();
+        }
+        m_Thread.join();
+        m_Running = false;
+        CLUSTER_LOG << "PresentWorker: stopped";
+    }
+
+    void PresentWorker::Submit(Job job, const uint32_t backBufferCount)
+    {
+        const auto inFlightLimit = GetInFlightLimit(backBufferCount);
+        Lock lock(m_Lock);
+        if (GetInFlightCount() >= inFlightLimit)
+        {
+            const auto stallStart = Clock::now();
+            m_Changed.wait(lock, [this, inFlightLimit] { return GetInFlightCount() < inFlightLimit; });
+            const auto stallDuration = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - stallStart);
+            m_StallCount.fetch_add(1, std::memory_order_relaxed);
+            m_StallDurationUs.fetch_add(stallDuration.count(), std::memory_order_relaxed);
+        }
+
+        m_Jobs.push_back(std::move(job));
+        const auto inFlightCount = GetInFlightCount();
+        if (inFlightCount > m_MaxInFlightCount.load(std::memory_order_relaxed))
+        {
+            m_MaxInFlightCount.store(inFlightCount, std::memory_order_relaxed);
+        }
+        m_SubmitCount.fetch_add(1, std::memory_order_relaxed);
+        m_Changed.notify_all();
+    }
+
+    uint32_t PresentWorker::GetInFlightLimit(const uint32_t backBufferCount) const
+    {
+        // Remarks: The back buffer the rendering thread renders to must not be one waiting to be presented.
+        if (backBufferCount < 2)
+        {
+            return 1;
+        }
+        return std::min(m_MaxInFlightFrames, backBufferCount - 1);
+    }
+
+    void PresentWorker::WaitForIdle()
+    {
+        if (!m_Running)
+        {
+            return;
+        }
+
+        Lock lock(m_Lock);
+        m_Changed.wait(lock, [this] { return GetInFlightCount() == 0; });
+    }
+
+    void PresentWorker::ThreadMain()
+    {
+        PluginProfiler::Instance().RegisterThread("Present Worker");
+        Lock lock(m_Lock);
+        for (;;)
+        {
+            m_Changed.wait(lock, [this] { return m_StopThread || !m_Jobs.empty(); });
+            if (m_Jobs.empty())
+            {
+                // Remarks: Only stop once every job submitted was executed.
+                lock.unlock();
+                PluginProfiler::Instance().UnregisterThread();
+                return;
+            }
+
+            auto job = std::move(m_Jobs.front());
+            m_Jobs.pop_front();
+            m_Executing = true;
+            lock.unlock();
+            job();
+            lock.lock();
+            m_Executing = false;
+            m_Changed.notify_all();
+        }
+    }
+}
@@ -1,19 +1,55 @@
 #include <string>
 #include <sstream>
 #include <fstream>
-
-#include "d3d11.h"
-#include "d3d12.h"
+#include <limits>
 
 #include "QuadroSync.h"
+#include "EventTrace.h"
 #include "Logger.h"
 #include "IGraphicsDevice.h"
+#include "SavedFrameCache.h"
+#include "PerformanceCounter.h"
+#include "PluginProfiler.h"
+#include "Tracepoints.h"
 
 namespace GfxQuadroSync
 {
-    PluginCSwapGroupClient::PluginCSwapGroupClient()
+    namespace
+    {
+        /// Record the start of a present in the EventTrace, the present_begin tracepoint and the profiler.
+        void TracePresentBegin(const uint64_t tick, const uint64_t frameIndex, const uint32_t repeatIndex)
+        {
+            EventTrace::Instance().WriteAt(tick, EventTraceId::PresentBegin, frameIndex, repeatIndex);
+            QUADROSYNC_PROBE_PRESENT_BEGIN(frameIndex, repeatIndex);
+            PluginProfiler::Instance().BeginMarker(PluginProfilerMarker::Present);
+        }
+
+        /**
+         * Record the end of a present in the EventTrace, the present_end tracepoint and the profiler.
+         *
+         * \param[in] throughBarrier Was the present done through the swap barrier?  (the wait on the barrier cannot be
+         *                           told apart from the present itself, so the whole present is reported as the wait)
+         */
+        void TracePresentEnd(const uint64_t tick, const uint64_t frameIndex, const uint32_t repeatIndex,
+            const SyncApiStatus status, const uint64_t durationUs, const bool throughBarrier)
+        {
+            EventTrace::Instance().WriteAt(tick, EventTraceId::PresentEnd, frameIndex, repeatIndex,
+                static_cast<int64_t>(status));
+            QUADROSYNC_PROBE_PRESENT_END(frameIndex, repeatIndex, static_cast<int32_t>(status), durationUs);
+            const auto& profiler = PluginProfiler::Instance();
+            profiler.EndMarker(PluginProfilerMarker::Present);
+            const auto durationNs = static_cast<int64_t>(durationUs * 1000);
+            profiler.SetCounter(PluginProfilerCounter::PresentDuration, durationNs);
+            profiler.SetCounter(PluginProfilerCounter::BarrierWait, throughBarrier ? durationNs : 0);
+        }
+    }
+
+    PluginCSwapGroupClient::PluginCSwapGroupClient(std::unique_ptr<ISyncApi> syncApi)
+        : m_SyncApi(std::move(syncApi))
+        , m_FrameCounter(GetPerformanceCounterFrequency())
+        , m_PerformanceCounterFrequency(GetPerformanceCounterFrequency())
     {
-        CLUSTER_LOG << "Initialize PluginCSwapGroupClient";
+        CLUSTER_LOG << "Initialize PluginCSwapGroupClient using " << m_SyncApi->GetName();
         Prepare();
     }
 
@@ -22,97 +58,88 @@ namespace GfxQuadroSync
         CLUSTER_LOG << "Destroy PluginCSwapGroupClient";
     }
 
+    void PluginCSwapGroupClient::SetSyncApi(std::unique_ptr<ISyncApi> syncApi)
+    {
+        WaitForPendingPresents();
+        m_SyncApi = std::move(syncApi);
+        CLUSTER_LOG << "PluginCSwapGroupClient now using " << m_SyncApi->GetName();
+        Prepare();
+    }
+
     void PluginCSwapGroupClient::Prepare()
     {
-        // Prepare NVAPI for use in this application
-        NvAPI_Status status = NvAPI_Initialize();
+        // Prepare the sync api for use in this application
+        const auto status = m_SyncApi->Initialize();
 
-        if (status != NVAPI_OK)
+        if (status != SyncApiStatus::Ok)
         {
-            CLUSTER_LOG_ERROR << "NvAPI_Initialize: " << status;
+            CLUSTER_LOG_ERROR << m_SyncApi->GetName() << " Initialize: " << status;
         }
         else
-            CLUSTER_LOG << "NvAPI_Initialize successful";
+            CLUSTER_LOG << m_SyncApi->GetName() << " Initialize successful";
     }
 
     void PluginCSwapGroupClient::SetupWorkStation()
     {
         // Register our request to use workstation SwapGroup resources in the driver
-        NvU32 gpuCount;
-        NvPhysicalGpuHandle nvGPUHandle[NVAPI_MAX_PHYSICAL_GPUS];
-        NvAPI_Status status = NvAPI_EnumPhysicalGPUs(nvGPUHandle, &gpuCount);
-        if (NVAPI_OK == status)
+        const auto status = m_SyncApi->SetupWorkstationSwapGroupFeature(true);
+        if (status != SyncApiStatus::Ok)
         {
-            for (unsigned int gpuIndex = 0; gpuIndex < gpuCount; gpuIndex++)
-            {
-                // send request to enable NVAPI_GPU_WORKSTATION_FEATURE_MASK_SWAPGROUP
-                status = NvAPI_GPU_WorkstationFeatureSetup(nvGPUHandle[gpuIndex], NVAPI_GPU_WORKSTATION_FEATURE_MASK_SWAPGROUP, 0);
-
-                if (status == NvAPI_Status::NVAPI_OK)
-                    CLUSTER_LOG << "GPU " << gpuIndex << ": NvAPI_GPU_WorkstationFeatureSetup successful";
-                else
-                    CLUSTER_LOG_ERROR << "GPU " << gpuIndex << ": NvAPI_GPU_WorkstationFeatureSetup failed: " << status;
-            }
+            CLUSTER_LOG_ERROR << "SetupWorkstationSwapGroupFeature(true) failed: " << status;
         }
     }
 
     void PluginCSwapGroupClient::DisposeWorkStation()
     {
+        WaitForPendingPresents();
         // Unregister our request to use workstation SwapGroup resources in the driver
-        NvAPI_Status status;
-        NvU32 gpuCount;
-        NvPhysicalGpuHandle nvGPUHandle[NVAPI_MAX_PHYSICAL_GPUS];
-        status = NvAPI_EnumPhysicalGPUs(nvGPUHandle, &gpuCount);
-        if (NVAPI_OK == status)
+        const auto status = m_SyncApi->SetupWorkstationSwapGroupFeature(false);
+        if (status != SyncApiStatus::Ok)
         {
-            for (unsigned int gpuIndex = 0; gpuIndex < gpuCount; gpuIndex++)
-            {
-                // send request to disable NVAPI_GPU_WORKSTATION_FEATURE_MASK_SWAPGROUP
-                status = NvAPI_GPU_WorkstationFeatureSetup(nvGPUHandle[gpuIndex], 0, NVAPI_GPU_WORKSTATION_FEATURE_MASK_SWAPGROUP);
-
-                if (status == NvAPI_Status::NVAPI_OK)
-                    CLUSTER_LOG << "GPU " << gpuIndex << ": NvAPI_GPU_WorkstationFeatureSetup successful";
-                else
-                    CLUSTER_LOG_ERROR << "GPU " << gpuIndex << ": NvAPI_GPU_WorkstationFeatureSetup failed: " << status;
-            }
+            CLUSTER_LOG_ERROR << "SetupWorkstationSwapGroupFeature(false) failed: " << status;
         }
     }
 
     PluginCSwapGroupClient::InitializeStatus PluginCSwapGroupClient::Initialize(IUnknown* const pDevice,
                                                                                 IDXGISwapChain* const pSwapChain)
     {
-        auto status = NVAPI_OK;
+        WaitForPendingPresents();
+        auto status = SyncApiStatus::Ok;
 
-        status = NvAPI_D3D1x_QueryMaxSwapGroup(pDevice, &m_GSyncSwapGroups, &m_GSyncBarriers);
+        status = m_SyncApi->QueryMaxSwapGroup(pDevice, m_GSyncSwapGroups, m_GSyncBarriers);
+        QUADROSYNC_PROBE_INITIALIZE_STAGE(static_cast<uint32_t>(TracepointInitializeStage::QueryMaxSwapGroup),
+            static_cast<int32_t>(status));
 
-        if (status == NvAPI_Status::NVAPI_OK)
-            CLUSTER_LOG << "NvAPI_D3D1x_QueryMaxSwapGroup successful";
+        if (status == SyncApiStatus::Ok)
+            CLUSTER_LOG << "QueryMaxSwapGroup successful";
         else
         {
-            CLUSTER_LOG_ERROR << "NvAPI_D3D1x_QueryMaxSwapGroup failed: " << status;
+            CLUSTER_LOG_ERROR << "QueryMaxSwapGroup failed: " << status;
             return InitializeStatus::QuerySwapGroupFailed;
         }
 
         if (m_GSyncSwapGroups > 0)
         {
-            if ((m_GroupId >= 0) && (m_GroupId <= m_GSyncSwapGroups))
+            if (m_GroupId <= m_GSyncSwapGroups)
             {
-                status = NvAPI_D3D1x_JoinSwapGroup(pDevice, pSwapChain, m_GroupId, m_GroupId > 0 ? true : false);
+                status = JoinSwapGroup(pDevice, pSwapChain, m_GroupId, m_GroupId > 0 ? true : false);
+                QUADROSYNC_PROBE_INITIALIZE_STAGE(static_cast<uint32_t>(TracepointInitializeStage::JoinSwapGroup),
+                    static_cast<int32_t>(status));
 
-                if (status == NvAPI_Status::NVAPI_OK)
+                if (status == SyncApiStatus::Ok)
                 {
-                    CLUSTER_LOG << "NvAPI_D3D1x_JoinSwapGroup returned NVAPI_OK";
+                    CLUSTER_LOG << "JoinSwapGroup successful";
                 }
                 else
                 {
-                    CLUSTER_LOG_ERROR << "NvAPI_D3D1x_JoinSwapGroup failed: " << status;
+                    CLUSTER_LOG_ERROR << "JoinSwapGroup failed: " << status;
                 }
 
 #ifdef _DEBUG
                 CLUSTER_LOG << "SwapGroup (" << m_GroupId << ") / (" << m_GSyncSwapGroups << ")";
 #endif
 
-                if (status != NVAPI_OK)
+                if (status != SyncApiStatus::Ok)
                 {
                     return InitializeStatus::FailedToJoinSwapGroup;
                 }
@@ -120,34 +147,40 @@ namespace GfxQuadroSync
 
             if (m_GSyncBarriers > 0)
             {
-                NvU32 frameCount;
+                uint32_t frameCount;
 
                 //! heavy
-                status = NvAPI_D3D1x_QueryFrameCount(pDevice, &frameCount);
+                status = m_SyncApi->QueryFrameCount(pDevice, frameCount);
+                QUADROSYNC_PROBE_INITIALIZE_STAGE(static_cast<uint32_t>(TracepointInitializeStage::QueryFrameCount),
+                    static_cast<int32_t>(status));
 
-                m_GSyncCounter = (status == NVAPI_OK);
+                m_GSyncCounter = (status == SyncApiStatus::Ok);
 
                 //! sync node
                 if (m_GSyncMaster && m_GSyncCounter)
                 {
-                    status = NvAPI_D3D1x_ResetFrameCount(pDevice);
+                    status = m_SyncApi->ResetFrameCount(pDevice);
+                    QUADROSYNC_PROBE_INITIALIZE_STAGE(static_cast<uint32_t>(TracepointInitializeStage::ResetFrameCount),
+                        static_cast<int32_t>(status));
                 }
+                m_FrameCounter.Invalidate();
 
-                if ((m_BarrierId >= 0) && (m_BarrierId <= m_GSyncBarriers) &&
-                    (m_GroupId >= 0) && (m_GroupId <= m_GSyncSwapGroups))
+                if ((m_BarrierId <= m_GSyncBarriers) && (m_GroupId <= m_GSyncSwapGroups))
                 {
-                    status = NvAPI_D3D1x_BindSwapBarrier(pDevice, m_GroupId, m_BarrierId);
+                    status = BindSwapBarrier(pDevice, m_GroupId, m_BarrierId);
+                    QUADROSYNC_PROBE_INITIALIZE_STAGE(static_cast<uint32_t>(TracepointInitializeStage::BindSwapBarrier),
+                        static_cast<int32_t>(status));
 
-                    if (status == NvAPI_Status::NVAPI_OK)
+                    if (status == SyncApiStatus::Ok)
                     {
-                        CLUSTER_LOG << "NvAPI_D3D1x_BindSwapBarrier successful";
+                        CLUSTER_LOG << "BindSwapBarrier successful";
                     }
                     else
                     {
-                        CLUSTER_LOG_ERROR << "NvAPI_D3D1x_BindSwapBarrier failed: " << status;
+                        CLUSTER_LOG_ERROR << "BindSwapBarrier failed: " << status;
                     }
 
-                    if (status != NVAPI_OK)
+                    if (status != SyncApiStatus::Ok)
                     {
                         return InitializeStatus::FailedToBindSwapBarrier;
                     }
@@ -156,7 +189,7 @@ namespace GfxQuadroSync
             }
             else if (m_BarrierId > 0)
             {
-                CLUSTER_LOG_ERROR << "NvAPI_D3D1x_QueryMaxSwapGroup returned 0 barriers";
+                CLUSTER_LOG_ERROR << "QueryMaxSwapGroup returned 0 barriers";
                 m_BarrierId = 0;
                 return InitializeStatus::SwapBarrierIdMismatch;
             }
@@ -165,51 +198,54 @@ namespace GfxQuadroSync
             CLUSTER_LOG << "BindSwapBarrier (" << m_BarrierId << ") / (" << m_GSyncBarriers << ")";
 #endif
 
-            NvU32 groupId;
-            NvU32 barrierId;
-            status = NvAPI_D3D1x_QuerySwapGroup(pDevice, pSwapChain, &groupId, &barrierId);
+            uint32_t groupId = 0;
+            uint32_t barrierId = 0;
+            status = m_SyncApi->QuerySwapGroup(pDevice, pSwapChain, groupId, barrierId);
+            QUADROSYNC_PROBE_INITIALIZE_STAGE(static_cast<uint32_t>(TracepointInitializeStage::QuerySwapGroup),
+                static_cast<int32_t>(status));
             m_GroupId = groupId;
             m_BarrierId = barrierId;
 
-            if (status == NvAPI_Status::NVAPI_OK)
-                CLUSTER_LOG << "NvAPI_D3D1x_QuerySwapGroup successful";
+            if (status == SyncApiStatus::Ok)
+                CLUSTER_LOG << "QuerySwapGroup successful";
             else
             {
-                CLUSTER_LOG_ERROR << "NvAPI_D3D1x_QuerySwapGroup failed: " << status;
+                CLUSTER_LOG_ERROR << "QuerySwapGroup failed: " << status;
                 return InitializeStatus::QuerySwapGroupFailed;
             }
         }
         else if (m_GSyncSwapGroups == 0)
         {
-            CLUSTER_LOG_ERROR << "NvAPI_D3D1x_QueryMaxSwapGroup returned 0 groups";
+            CLUSTER_LOG_ERROR << "QueryMaxSwapGroup returned 0 groups";
             return InitializeStatus::NoSwapGroupDetected;
         }
         else
         {
-            CLUSTER_LOG_ERROR << "NvAPI_D3D1x_QueryMaxSwapGroup returned " << m_GSyncSwapGroups
+            CLUSTER_LOG_ERROR << "QueryMaxSwapGroup returned " << m_GSyncSwapGroups
                               << " groups and m_GroupId is " << m_GroupId;
             m_GroupId = 0;
             return InitializeStatus::SwapGroupMismatch;
         }
 
-        return (status == NVAPI_OK) ? InitializeStatus::Success : InitializeStatus::Failed;
+        return (status == SyncApiStatus::Ok) ? InitializeStatus::Success : InitializeStatus::Failed;
     }
     
     void PluginCSwapGroupClient::Dispose(IUnknown* const pDevice,
                                          IDXGISwapChain* const pSwapChain)
     {
-        NvAPI_Status status;
+        WaitForPendingPresents();
+        SyncApiStatus status;
         if (m_GroupId > 0)
         {
             if (m_BarrierId > 0)
             {
-                if (NVAPI_OK == (status = NvAPI_D3D1x_BindSwapBarrier(pDevice, m_GroupId, 0)))
+                if (SyncApiStatus::Ok == (status = BindSwapBarrier(pDevice, m_GroupId, 0)))
                 {
                     m_BarrierId = 0;
                 }
             }
 
-            if (NVAPI_OK == (status = NvAPI_D3D1x_JoinSwapGroup(pDevice, pSwapChain, 0, 0)))
+            if (SyncApiStatus::Ok == (status = JoinSwapGroup(pDevice, pSwapChain, 0, false)))
             {
                 m_GroupId = 0;
             }
@@ -217,19 +253,103 @@ namespace GfxQuadroSync
 
         m_PresentSuccessCount = 0;
         m_PresentFailureCount = 0;
+        m_PresentStatistics.Reset();
+    }
+
+    PluginCSwapGroupClient::InitializeStatus PluginCSwapGroupClient::RejoinSwapGroup(IUnknown* const pDevice,
+                                                                                     IDXGISwapChain* const pSwapChain)
+    {
+        WaitForPendingPresents();
+        const uint32_t groupId = m_GroupId;
+        const uint32_t barrierId = m_BarrierId;
+        if (groupId == 0)
+        {
+            // Not in a swap group, the new swap chain will join it when EnableSwapGroup is called.
+            return InitializeStatus::Success;
+        }
+
+        // Remarks: The previous swap chain is not removed from the swap group, it was released by Unity (and so
+        // forgotten by the driver).
+        const auto startTick = GetCurrentPerformanceCounterTick();
+        auto result = InitializeStatus::Success;
+        uint32_t queriedGroupId = 0;
+        uint32_t queriedBarrierId = 0;
+        auto status = m_SyncApi->QuerySwapGroup(pDevice, pSwapChain, queriedGroupId, queriedBarrierId);
+        if (status != SyncApiStatus::Ok || queriedGroupId != groupId)
+        {
+            status = JoinSwapGroup(pDevice, pSwapChain, groupId, true);
+            if (status == SyncApiStatus::Ok)
+            {
+                CLUSTER_LOG << "RejoinSwapGroup: JoinSwapGroup successful";
+                if (m_SyncApi->QuerySwapGroup(pDevice, pSwapChain, queriedGroupId, queriedBarrierId) !=
+                    SyncApiStatus::Ok)
+                {
+                    queriedBarrierId = 0;
+                }
+            }
+            else
+            {
+                CLUSTER_LOG_ERROR << "RejoinSwapGroup: JoinSwapGroup failed: " << status;
+                m_GroupId = 0;
+                m_BarrierId = 0;
+                result = InitializeStatus::FailedToJoinSwapGroup;
+            }
+        }
+
+        if (result == InitializeStatus::Success && barrierId > 0 && queriedBarrierId != barrierId)
+        {
+            status = BindSwapBarrier(pDevice, groupId, barrierId);
+            if (status == SyncApiStatus::Ok)
+            {
+                CLUSTER_LOG << "RejoinSwapGroup: BindSwapBarrier successful, the barrier has to be warmed up again";
+                m_FrameCounter.Invalidate();
+                m_NeedToWarmUpBarrier = true;
+                m_SwapGroupRejoinWarmupCount.fetch_add(1, std::memory_order_relaxed);
+            }
+            else
+            {
+                CLUSTER_LOG_ERROR << "RejoinSwapGroup: BindSwapBarrier failed: " << status;
+                m_BarrierId = 0;
+                result = InitializeStatus::FailedToBindSwapBarrier;
+            }
+        }
+
+        const auto durationTicks = GetCurrentPerformanceCounterTick() - startTick;
+        m_LastSwapGroupRejoinDurationUs.store(durationTicks * 1000000 / m_PerformanceCounterFrequency,
+            std::memory_order_relaxed);
+        m_SwapGroupRejoinCount.fetch_add(1, std::memory_order_relaxed);
+        return result;
     }
 
-    NvU32 PluginCSwapGroupClient::QueryFrameCount(IUnknown* const pDevice)
+    uint32_t PluginCSwapGroupClient::QueryFrameCount(IUnknown* const pDevice)
     {
-        NvU32 count = 0;
+        uint32_t count = 0;
 
         if (m_GSyncCounter)
         {
-            NvAPI_Status status;
-            if (NVAPI_OK == (status = NvAPI_D3D1x_QueryFrameCount(pDevice, &count)))
+            // QueryFrameCount is heavy, so only call it once in a while and extrapolate in between.
+            const auto nowTick = GetCurrentPerformanceCounterTick();
+            if (m_FrameCounter.IsHardwareQueryDue(nowTick))
             {
-                m_FrameCount = count;
+                // ISyncApi is not thread safe, so the present worker must be done before we query (this only happens
+                // once every NBR_SECONDS_BETWEEN_CAN_GET_FRAME_COUNT seconds).
+                WaitForPendingPresents();
+                SyncApiStatus status;
+                const auto& profiler = PluginProfiler::Instance();
+                profiler.BeginMarker(PluginProfilerMarker::QueryFrameCount);
+                status = m_SyncApi->QueryFrameCount(pDevice, count);
+                profiler.EndMarker(PluginProfilerMarker::QueryFrameCount);
+                if (SyncApiStatus::Ok == status)
+                {
+                    m_FrameCounter.OnHardwareFrameCount(nowTick, count);
+                }
+                else
+                {
+                    m_FrameCounter.OnHardwareQueryFailed(nowTick);
+                    CLUSTER_LOG_WARNING << "QueryFrameCount failed: " << status;
+                }
             }
+            m_FrameCount = m_FrameCounter.GetFrameCount(nowTick);
         }
         else
         {
@@ -241,10 +361,15 @@ namespace GfxQuadroSync
 
     void PluginCSwapGroupClient::ResetFrameCount(IUnknown* const pDevice)
     {
+        WaitForPendingPresents();
         if (m_GSyncMaster)
         {
-            auto status = NVAPI_OK;
-            status = NvAPI_D3D1x_ResetFrameCount(pDevice);
+            const auto status = m_SyncApi->ResetFrameCount(pDevice);
+            if (status != SyncApiStatus::Ok)
+            {
+                CLUSTER_LOG_WARNING << "ResetFrameCount failed: " << status;
+            }
+            m_FrameCounter.Invalidate();
         }
         else
         {
@@ -254,44 +379,128 @@ namespace GfxQuadroSync
 
     bool PluginCSwapGroupClient::Render(IGraphicsDevice* pGraphicsDevice)
     {
+        const auto frameIndex = m_RenderCount;
+        const auto& profiler = PluginProfiler::Instance();
+        QUADROSYNC_PROBE_RENDER_BEGIN(frameIndex);
+        profiler.BeginMarker(PluginProfilerMarker::Render);
+        const bool presented = RenderFrame(pGraphicsDevice);
+        profiler.EndMarker(PluginProfilerMarker::Render);
+        QUADROSYNC_PROBE_RENDER_END(frameIndex, presented ? 1 : 0);
+        // Remarks: Presents done by the worker are only reported with the next frame.
+        profiler.SetCounter(PluginProfilerCounter::PresentSuccesses, static_cast<int64_t>(GetPresentSuccessCount()));
+        profiler.SetCounter(PluginProfilerCounter::PresentFailures, static_cast<int64_t>(GetPresentFailureCount()));
+        return presented;
+    }
+
+    bool PluginCSwapGroupClient::RenderFrame(IGraphicsDevice* const pGraphicsDevice)
+    {
+        // Remarks: Only plain presents are done by the worker, anything else using the graphics device first waits
+        // for the presents in flight.
+        const bool presentAsync = m_PresentWorker.IsRunning() && !m_NeedToWarmUpBarrier &&
+            !m_SkipSynchronizedPresentOfNextFrame && !m_PresentScheduler.IsStarted();
+        if (!presentAsync || m_FrameHoldEnabled || m_HeldFramePresentCount > 0)
+        {
+            WaitForPendingPresents();
+        }
+
+        ConcludeFrameHold(pGraphicsDevice);
+
+        const auto frameIndex = m_RenderCount++;
+
         if (m_SkipSynchronizedPresentOfNextFrame)
         {
             m_SkipSynchronizedPresentOfNextFrame = false;
+            const auto nowTick = GetCurrentPerformanceCounterTick();
+            m_PresentTelemetry.Write(frameIndex, nowTick, nowTick, static_cast<int32_t>(SyncApiStatus::Ok),
+                true, PresentTelemetryRecord::k_NoWarmupAction, 0);
             return false;
         }
 
-        const auto pDevice = pGraphicsDevice->GetDevice();
-        const auto pSwapChain = pGraphicsDevice->GetSwapChain();
-        const auto pVsync = pGraphicsDevice->GetSyncInterval();
-        const auto pFlags = pGraphicsDevice->GetPresentFlags();
+        if (m_FrameHoldEnabled && !m_NeedToWarmUpBarrier)
+        {
+            pGraphicsDevice->SaveFrameToHold();
+        }
+
+        if (presentAsync)
+        {
+            const auto backBufferIndex = pGraphicsDevice->OnAsyncPresentQueued();
+            m_PresentWorker.Submit([this, frameIndex, pGraphicsDevice, backBufferIndex]
+                {
+                    PresentFrame(frameIndex, pGraphicsDevice);
+                    pGraphicsDevice->OnAsyncPresentDone(backBufferIndex);
+                }, pGraphicsDevice->GetBackBufferCount());
+            // Unity renders to the next back buffer as soon as we return, it might still be waiting to be presented.
+            pGraphicsDevice->WaitForNextBackBuffer();
+            return true;
+        }
+
+        if (m_PresentScheduler.IsStarted())
+        {
+            return RenderScheduled(frameIndex, pGraphicsDevice);
+        }
 
         if (m_NeedToWarmUpBarrier)
         {
             pGraphicsDevice->InitiatePresentRepeats();
+            if (const auto savedFrameCache = pGraphicsDevice->GetSavedFrameCache())
+            {
+                m_SavedFrameAllocationCount.store(savedFrameCache->GetAllocationCount(), std::memory_order_relaxed);
+                m_SavedFrameReuseCount.store(savedFrameCache->GetReuseCount(), std::memory_order_relaxed);
+                m_SavedFrameReleaseCount.store(savedFrameCache->GetReleaseCount(), std::memory_order_relaxed);
+            }
         }
 
-        for (;;)
+        for (uint16_t repeatIndex = 0;; ++repeatIndex)
         {
-            auto result = NvAPI_D3D1x_Present(pDevice, pSwapChain, pVsync, pFlags);
-            if (result != NVAPI_OK)
+            if (m_NeedToWarmUpBarrier)
+            {
+                m_BarrierWarmup.OnPresentStarting();
+            }
+            const auto presentStartTick = GetCurrentPerformanceCounterTick();
+            TracePresentBegin(presentStartTick, frameIndex, repeatIndex);
+            const auto result = m_SyncApi->Present(*pGraphicsDevice);
+            const auto presentEndTick = GetCurrentPerformanceCounterTick();
+            const auto presentDurationUs =
+                (presentEndTick - presentStartTick) * 1000000 / m_PerformanceCounterFrequency;
+            m_PresentStatistics.Record(presentDurationUs);
+            TracePresentEnd(presentEndTick, frameIndex, repeatIndex, result, presentDurationUs, IsBarrierBound());
+            if (result != SyncApiStatus::Ok)
             {
+                m_PresentTelemetry.Write(frameIndex, presentStartTick, presentEndTick,
+                    static_cast<int32_t>(result), false, PresentTelemetryRecord::k_NoWarmupAction, repeatIndex);
                 m_PresentFailureCount.fetch_add(1, std::memory_order_relaxed);
-                CLUSTER_LOG_ERROR << "NvAPI_D3D1x_Present failed: " << result;
+                CLUSTER_LOG_ERROR << "Present failed: " << result;
                 return false;
             }
 
-            if (m_NeedToWarmUpBarrier)
+            if (!m_NeedToWarmUpBarrier)
+            {
+                m_PresentTelemetry.Write(frameIndex, presentStartTick, presentEndTick,
+                    static_cast<int32_t>(result), false, PresentTelemetryRecord::k_NoWarmupAction, repeatIndex);
+            }
+            else
             {
-                const auto barrierWarmupAction = m_BarrierWarmupCallback();
+                const auto barrierWarmupAction = m_BarrierWarmup.OnPresentCompleted();
+                EventTrace::Instance().Write(EventTraceId::WarmupAction, static_cast<int64_t>(barrierWarmupAction),
+                    repeatIndex);
+                QUADROSYNC_PROBE_WARMUP_ACTION(frameIndex, repeatIndex, static_cast<int32_t>(barrierWarmupAction));
+                m_PresentTelemetry.Write(frameIndex, presentStartTick, presentEndTick,
+                    static_cast<int32_t>(result), false, static_cast<uint8_t>(barrierWarmupAction), repeatIndex);
                 if (barrierWarmupAction == BarrierWarmupAction::RepeatPresent)
                 {
+                    const auto& profiler = PluginProfiler::Instance();
+                    profiler.BeginMarker(PluginProfilerMarker::BarrierWarmupRepeat);
                     pGraphicsDevice->PrepareSinglePresentRepeat();
+                    profiler.EndMarker(PluginProfilerMarker::BarrierWarmupRepeat);
+                    profiler.SetCounter(PluginProfilerCounter::WarmupRepeats, ++m_WarmupRepeatCount);
                     continue;
                 }
                 if (barrierWarmupAction == BarrierWarmupAction::BarrierWarmedUp)
                 {
                     pGraphicsDevice->ConcludePresentRepeats();
                     m_NeedToWarmUpBarrier = false;
+                    // Remarks: The counter keeps reporting the repeats of this warmup until the next one repeats.
+                    m_WarmupRepeatCount = 0;
                 }
             }
             break;
@@ -301,6 +510,167 @@ namespace GfxQuadroSync
         return true;
     }
 
+    void PluginCSwapGroupClient::EnableAsyncPresent(const uint32_t maxInFlightFrames)
+    {
+        CLUSTER_LOG << "EnableAsyncPresent: " << maxInFlightFrames;
+        if (maxInFlightFrames == 0)
+        {
+            m_PresentWorker.Stop();
+        }
+        else if (!m_PresentWorker.IsRunning() || m_PresentWorker.GetMaxInFlightFrames() != maxInFlightFrames)
+        {
+            m_PresentWorker.Start(maxInFlightFrames);
+        }
+    }
+
+    void PluginCSwapGroupClient::PresentFrame(const uint64_t frameIndex, IGraphicsDevice* const pGraphicsDevice)
+    {
+        const auto presentStartTick = GetCurrentPerformanceCounterTick();
+        TracePresentBegin(presentStartTick, frameIndex, 0);
+        const auto result = m_SyncApi->Present(*pGraphicsDevice);
+        const auto presentEndTick = GetCurrentPerformanceCounterTick();
+        const auto presentDurationUs =
+            (presentEndTick - presentStartTick) * 1000000 / m_PerformanceCounterFrequency;
+        m_PresentStatistics.Record(presentDurationUs);
+        TracePresentEnd(presentEndTick, frameIndex, 0, result, presentDurationUs, IsBarrierBound());
+        m_PresentTelemetry.Write(frameIndex, presentStartTick, presentEndTick, static_cast<int32_t>(result), false,
+            PresentTelemetryRecord::k_NoWarmupAction, 0);
+        if (result != SyncApiStatus::Ok)
+        {
+            m_PresentFailureCount.fetch_add(1, std::memory_order_relaxed);
+            CLUSTER_LOG_ERROR << "Present failed: " << result;
+            return;
+        }
+
+        m_PresentSuccessCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    SyncApiStatus PluginCSwapGroupClient::JoinSwapGroup(IUnknown* const pDevice, IDXGISwapChain* const pSwapChain,
+        const uint32_t group, const bool blocking)
+    {
+        const auto status = m_SyncApi->JoinSwapGroup(pDevice, pSwapChain, group, blocking);
+        EventTrace::Instance().Write(EventTraceId::JoinSwapGroup, group, blocking ? 1 : 0,
+            static_cast<int64_t>(status));
+        return status;
+    }
+
+    SyncApiStatus PluginCSwapGroupClient::BindSwapBarrier(IUnknown* const pDevice, const uint32_t group,
+        const uint32_t barrier)
+    {
+        const auto status = m_SyncApi->BindSwapBarrier(pDevice, group, barrier);
+        EventTrace::Instance().Write(EventTraceId::BindSwapBarrier, group, barrier, static_cast<int64_t>(status));
+        return status;
+    }
+
+    void PluginCSwapGroupClient::EnableFrameHold(IGraphicsDevice* const pGraphicsDevice, const bool value)
+    {
+        WaitForPendingPresents();
+        CLUSTER_LOG << "EnableFrameHold: " << (value ? "true" : "false");
+        if (!value && m_FrameHoldEnabled && pGraphicsDevice != nullptr)
+        {
+            ConcludeFrameHold(pGraphicsDevice);
+            pGraphicsDevice->ReleaseHeldFrame();
+        }
+        m_FrameHoldEnabled = value;
+    }
+
+    bool PluginCSwapGroupClient::HoldFrame(IGraphicsDevice* const pGraphicsDevice)
+    {
+        WaitForPendingPresents();
+        // Remarks: Presents of the barrier warmup are counted by BarrierWarmup, they must not be mixed with others.
+        if (!m_FrameHoldEnabled || m_NeedToWarmUpBarrier || pGraphicsDevice == nullptr ||
+            m_HeldFramePresentCount == std::numeric_limits<uint16_t>::max() || !PresentHeldFrame(pGraphicsDevice))
+        {
+            m_FrameHoldFailureCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    void PluginCSwapGroupClient::ConcludeFrameHold(IGraphicsDevice* const pGraphicsDevice)
+    {
+        if (m_HeldFramePresentCount == 0)
+        {
+            return;
+        }
+
+        // Some swap chains must be back to the back buffer Unity rendered to before presenting its next frame, so
+        // keep presenting the held frame until they are.
+        while (pGraphicsDevice->GetPendingHeldFramePresentCount() > 0 && PresentHeldFrame(pGraphicsDevice))
+        {
+        }
+        m_HeldFramePresentCount = 0;
+    }
+
+    bool PluginCSwapGroupClient::PresentHeldFrame(IGraphicsDevice* const pGraphicsDevice)
+    {
+        if (!pGraphicsDevice->PrepareHeldFramePresent())
+        {
+            return false;
+        }
+
+        // Remarks: Recorded as a repeat of the last frame rendered by Unity (but outside of any barrier warmup).
+        const auto frameIndex = m_RenderCount > 0 ? m_RenderCount - 1 : 0;
+        const auto holdIndex = ++m_HeldFramePresentCount;
+        SyncApiStatus result;
+        uint64_t presentStartTick;
+        const bool throughBarrier = !m_PresentScheduler.IsStarted() && IsBarrierBound();
+        if (m_PresentScheduler.IsStarted())
+        {
+            m_PresentScheduler.WaitForNextPresent();
+            presentStartTick = GetCurrentPerformanceCounterTick();
+            TracePresentBegin(presentStartTick, frameIndex, holdIndex);
+            result = pGraphicsDevice->Present() ? SyncApiStatus::Ok : SyncApiStatus::Error;
+        }
+        else
+        {
+            presentStartTick = GetCurrentPerformanceCounterTick();
+            TracePresentBegin(presentStartTick, frameIndex, holdIndex);
+            result = m_SyncApi->Present(*pGraphicsDevice);
+        }
+        const auto presentEndTick = GetCurrentPerformanceCounterTick();
+        const auto presentDurationUs =
+            (presentEndTick - presentStartTick) * 1000000 / m_PerformanceCounterFrequency;
+        m_PresentStatistics.Record(presentDurationUs);
+        TracePresentEnd(presentEndTick, frameIndex, holdIndex, result, presentDurationUs, throughBarrier);
+        m_PresentTelemetry.Write(frameIndex, presentStartTick, presentEndTick, static_cast<int32_t>(result), false,
+            PresentTelemetryRecord::k_NoWarmupAction, holdIndex);
+        if (result != SyncApiStatus::Ok)
+        {
+            m_PresentFailureCount.fetch_add(1, std::memory_order_relaxed);
+            CLUSTER_LOG_ERROR << "Present of held frame failed: " << result;
+            return false;
+        }
+
+        m_HeldFrameCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool PluginCSwapGroupClient::RenderScheduled(const uint64_t frameIndex, IGraphicsDevice* const pGraphicsDevice)
+    {
+        // Remarks: Nodes are synchronized by presenting at the same time, so there is no barrier to warm up.
+        m_PresentScheduler.WaitForNextPresent();
+        const auto presentStartTick = GetCurrentPerformanceCounterTick();
+        TracePresentBegin(presentStartTick, frameIndex, 0);
+        const auto result = pGraphicsDevice->Present() ? SyncApiStatus::Ok : SyncApiStatus::Error;
+        const auto presentEndTick = GetCurrentPerformanceCounterTick();
+        const auto presentDurationUs =
+            (presentEndTick - presentStartTick) * 1000000 / m_PerformanceCounterFrequency;
+        m_PresentStatistics.Record(presentDurationUs);
+        TracePresentEnd(presentEndTick, frameIndex, 0, result, presentDurationUs, false);
+        m_PresentTelemetry.Write(frameIndex, presentStartTick, presentEndTick, static_cast<int32_t>(result), false,
+            PresentTelemetryRecord::k_NoWarmupAction, 0);
+        if (result != SyncApiStatus::Ok)
+        {
+            m_PresentFailureCount.fetch_add(1, std::memory_order_relaxed);
+            CLUSTER_LOG_ERROR << "Present failed: " << result;
+            return false;
+        }
+
+        m_PresentSuccessCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
     void PluginCSwapGroupClient::EnableSystem(IUnknown* const pDevice,
         IDXGISwapChain* const pSwapChain,
         const bool value)
@@ -314,28 +684,30 @@ namespace GfxQuadroSync
                                                  IDXGISwapChain* const pSwapChain,
                                                  const bool value)
     {
-        const NvU32 newSwapGroup = (value) ? 1 : 0;
+        WaitForPendingPresents();
+        const uint32_t newSwapGroup = (value) ? 1 : 0;
         CLUSTER_LOG << "EnableSwapGroup: (" << (value ? "true" : "false") << ", newSwapGroup ID is " << newSwapGroup;
 
         if ((newSwapGroup != m_GroupId) && (newSwapGroup <= m_GSyncSwapGroups))
         {
-            const auto status = NvAPI_D3D1x_JoinSwapGroup(pDevice, pSwapChain, newSwapGroup, (newSwapGroup > 0));
+            const auto status = JoinSwapGroup(pDevice, pSwapChain, newSwapGroup, (newSwapGroup > 0));
+            QUADROSYNC_PROBE_ENABLE_SWAP_GROUP(value ? 1 : 0, static_cast<int32_t>(status));
 
-            if (status == NvAPI_Status::NVAPI_OK)
+            if (status == SyncApiStatus::Ok)
             {
-                CLUSTER_LOG << "NvAPI_D3D1x_JoinSwapGroup returned NVAPI_OK";
+                CLUSTER_LOG << "JoinSwapGroup successful";
                 m_GroupId = newSwapGroup;
             }
             else
             {
-                CLUSTER_LOG_ERROR << "NvAPI_D3D1x_JoinSwapGroup failed: " << status;
+                CLUSTER_LOG_ERROR << "JoinSwapGroup failed: " << status;
 
 #ifdef _DEBUG
                 CLUSTER_LOG << "Values before Query: m_GroupeId(" << m_GroupId << "), m_BarrierId (" << m_BarrierId << ")";
 
-                NvU32 groupId;
-                NvU32 barrierId;
-                NvAPI_D3D1x_QuerySwapGroup(pDevice, pSwapChain, &groupId, &barrierId);
+                uint32_t groupId = 0;
+                uint32_t barrierId = 0;
+                m_SyncApi->QuerySwapGroup(pDevice, pSwapChain, groupId, barrierId);
                 m_GroupId = groupId;
                 m_BarrierId = barrierId;
 
@@ -347,32 +719,41 @@ namespace GfxQuadroSync
 
     void PluginCSwapGroupClient::EnableSwapBarrier(IUnknown* const pDevice, const bool value)
     {
+        WaitForPendingPresents();
         if (m_GroupId == 1)
         {
-            const NvU32 newSwapBarrier = (value) ? 1 : 0;
+            const uint32_t newSwapBarrier = (value) ? 1 : 0;
             CLUSTER_LOG << "EnableSwapBarrier: " << (value ? "true" : "false") << ", newSwapBarrier ID is " << newSwapBarrier;
 
             if ((newSwapBarrier != m_BarrierId) && (newSwapBarrier <= m_GSyncBarriers))
             {
-                const auto status = NvAPI_D3D1x_BindSwapBarrier(pDevice, m_GroupId, newSwapBarrier);
+                const auto status = BindSwapBarrier(pDevice, m_GroupId, newSwapBarrier);
+                QUADROSYNC_PROBE_ENABLE_SWAP_BARRIER(value ? 1 : 0, static_cast<int32_t>(status));
 
-                if (status == NvAPI_Status::NVAPI_OK)
+                if (status == SyncApiStatus::Ok)
                 {
-                    CLUSTER_LOG << "NvAPI_D3D1x_BindSwapBarrier returned NVAPI_OK";
+                    CLUSTER_LOG << "BindSwapBarrier successful";
                     m_BarrierId = newSwapBarrier;
+                    if (m_BarrierId > 0)
+                    {
+                        // Only a barrier that was bound again has to be warmed up (and repeat presents) again.
+                        m_NeedToWarmUpBarrier = true;
+                    }
                 }
                 else
                 {
-                    CLUSTER_LOG_ERROR << "NvAPI_D3D1x_BindSwapBarrier failed: " << status;
+                    CLUSTER_LOG_ERROR << "BindSwapBarrier failed: " << status;
                 }
             }
-            CLUSTER_LOG << "EnableSwapBarrier: already set, nothing has been called";
+            else
+            {
+                CLUSTER_LOG << "EnableSwapBarrier: already set, nothing has been called";
+            }
         }
         else
         {
             CLUSTER_LOG << "EnableSwapBarrier: (NULL), m_GroupId is different than 1";
         }
-        m_NeedToWarmUpBarrier = true;
     }
 
     void PluginCSwapGroupClient::EnableSyncCounter(const bool value)
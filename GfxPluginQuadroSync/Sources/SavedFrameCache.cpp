@@ -0,0 +1,39 @@
+#include "SavedFrameCache.h"
+#include "Logger.h"
+
+namespace GfxQuadroSync
+{
+    bool SavedFrameCache::TryReuse(const SavedFrameDescription& description)
+    {
+        if (m_Valid && m_Description == description)
+        {
+            ++m_ReuseCount;
+            return true;
+        }
+
+        if (m_Valid)
+        {
+            CLUSTER_LOG << "SavedFrameCache: back buffers changed from " << m_Description.width << "x"
+                << m_Description.height << " (format " << m_Description.format << ") to " << description.width << "x"
+                << description.height << " (format " << description.format << "), reallocating";
+        }
+        return false;
+    }
+
+    void SavedFrameCache::OnAllocated(const SavedFrameDescription& description)
+    {
+        m_Description = description;
+        m_Valid = true;
+        ++m_AllocationCount;
+    }
+
+    void SavedFrameCache::OnReleased()
+    {
+        if (m_Valid)
+        {
+            ++m_ReleaseCount;
+        }
+        m_Valid = false;
+        m_Description = SavedFrameDescription();
+    }
+}
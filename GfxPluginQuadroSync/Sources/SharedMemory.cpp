@@ -0,0 +1,166 @@
+#include "SharedMemory.h"
+#include "Logger.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace GfxQuadroSync
+{
+    SharedMemory::~SharedMemory()
+    {
+        reset();
+    }
+
+    SharedMemory::SharedMemory(SharedMemory&& toMove) noexcept
+    {
+        *this = std::move(toMove);
+    }
+
+    SharedMemory& SharedMemory::operator=(SharedMemory&& toMove) noexcept
+    {
+        std::swap(m_Data, toMove.m_Data);
+        std::swap(m_Size, toMove.m_Size);
+        std::swap(m_Name, toMove.m_Name);
+        std::swap(m_Created, toMove.m_Created);
+#ifdef _WIN32
+        std::swap(m_Handle, toMove.m_Handle);
+#endif
+        return *this;
+    }
+
+#ifdef _WIN32
+    bool SharedMemory::CreateOrOpen(const std::string& name, const size_t size, bool& created)
+    {
+        reset();
+
+        const auto fullName = "Local\\" + name;
+        const auto handle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+            static_cast<DWORD>(static_cast<uint64_t>(size) >> 32), static_cast<DWORD>(size), fullName.c_str());
+        if (handle == NULL)
+        {
+            CLUSTER_LOG_ERROR << "CreateFileMapping failed for " << fullName << ": " << GetLastError();
+            return false;
+        }
+        created = GetLastError() != ERROR_ALREADY_EXISTS;
+
+        const auto data = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+        if (data == nullptr)
+        {
+            CLUSTER_LOG_ERROR << "MapViewOfFile failed for " << fullName << ": " << GetLastError();
+            CloseHandle(handle);
+            return false;
+        }
+
+        m_Handle = handle;
+        m_Data = data;
+        m_Size = size;
+        m_Name = name;
+        m_Created = created;
+        return true;
+    }
+
+    void SharedMemory::reset()
+    {
+        if (m_Data != nullptr)
+        {
+            UnmapViewOfFile(m_Data);
+            m_Data = nullptr;
+        }
+        if (m_Handle != nullptr)
+        {
+            // Remarks: The name disappears automatically with the last handle, nothing else to do.
+            CloseHandle(m_Handle);
+            m_Handle = nullptr;
+        }
+        m_Size = 0;
+        m_Name.clear();
+        m_Created = false;
+    }
+#else
+    bool SharedMemory::CreateOrOpen(const std::string& name, const size_t size, bool& created)
+    {
+        reset();
+
+        const auto fullName = "/" + name;
+        created = true;
+        int fd = shm_open(fullName.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+        if (fd < 0 && errno == EEXIST)
+        {
+            created = false;
+            fd = shm_open(fullName.c_str(), O_RDWR, S_IRUSR | S_IWUSR);
+        }
+        if (fd < 0)
+        {
+            CLUSTER_LOG_ERROR << "shm_open failed for " << fullName << ": " << strerror(errno);
+            return false;
+        }
+
+        if (created && ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            CLUSTER_LOG_ERROR << "ftruncate failed for " << fullName << ": " << strerror(errno);
+            close(fd);
+            shm_unlink(fullName.c_str());
+            return false;
+        }
+
+        // Remarks: The creator might not have sized the memory yet and accessing it before it does would SIGBUS.
+        struct stat fileStatus;
+        for (int attempt = 0; !created && fstat(fd, &fileStatus) == 0 &&
+             fileStatus.st_size < static_cast<off_t>(size) && attempt < 1000; ++attempt)
+        {
+            usleep(1000);
+        }
+        if (!created && (fstat(fd, &fileStatus) != 0 || fileStatus.st_size < static_cast<off_t>(size)))
+        {
+            CLUSTER_LOG_ERROR << fullName << " is smaller than the expected " << size << " bytes";
+            close(fd);
+            return false;
+        }
+
+        const auto data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED)
+        {
+            CLUSTER_LOG_ERROR << "mmap failed for " << fullName << ": " << strerror(errno);
+            if (created)
+            {
+                shm_unlink(fullName.c_str());
+            }
+            return false;
+        }
+
+        m_Data = data;
+        m_Size = size;
+        m_Name = name;
+        m_Created = created;
+        return true;
+    }
+
+    void SharedMemory::reset()
+    {
+        if (m_Data != nullptr)
+        {
+            munmap(m_Data, m_Size);
+            m_Data = nullptr;
+        }
+        if (m_Created)
+        {
+            // Remarks: Processes that still have it mapped can continue to use it, it is only the name that goes away.
+            shm_unlink(("/" + m_Name).c_str());
+        }
+        m_Size = 0;
+        m_Name.clear();
+        m_Created = false;
+    }
+#endif
+}
@@ -0,0 +1,210 @@
+#include "SimulatedNetwork.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <queue>
+
+namespace GfxQuadroSync
+{
+    namespace
+    {
+        typedef std::chrono::steady_clock Clock;
+
+        struct Datagram
+        {
+            Clock::time_point deliveryTime;
+            /// To keep the order of datagrams with the same delivery time.
+            uint64_t sequence;
+            /// Shared by every receiver of the datagram.
+            std::shared_ptr<const std::vector<uint8_t>> data;
+
+            bool operator>(const Datagram& other) const
+            {
+                return deliveryTime != other.deliveryTime ? deliveryTime > other.deliveryTime :
+                    sequence > other.sequence;
+            }
+        };
+
+        uint64_t NextRandom(uint64_t& state)
+        {
+            // splitmix64 (same as SimulatedSyncApi) so results do not depend on the standard library.
+            uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            return z ^ (z >> 31);
+        }
+    }
+
+    struct SimulatedNetwork::Inbox
+    {
+        std::mutex lock;
+        std::condition_variable added;
+        std::priority_queue<Datagram, std::vector<Datagram>, std::greater<Datagram>> datagrams;
+        uint64_t nextSequence = 0;
+        /// Node id of the endpoint (its creation order).
+        int address = 0;
+    };
+
+    class SimulatedNetwork::Endpoint final : public IDatagramTransport
+    {
+    public:
+        Endpoint(SimulatedNetwork& network, std::shared_ptr<Inbox> inbox, const uint64_t seed)
+            : m_Network(network)
+            , m_Inbox(std::move(inbox))
+            , m_RandomState(seed)
+        {
+        }
+
+        ~Endpoint()
+        {
+            m_Network.Remove(m_Inbox.get());
+        }
+
+        bool Send(const void* const data, const size_t size) override
+        {
+            m_Network.Deliver(m_Inbox.get(), -1, m_RandomState, data, size);
+            return true;
+        }
+
+        bool SendTo(const uint8_t nodeId, const void* const data, const size_t size) override
+        {
+            m_Network.Deliver(m_Inbox.get(), nodeId, m_RandomState, data, size);
+            return true;
+        }
+
+        int Receive(void* const buffer, const size_t size, const std::chrono::microseconds timeout) override
+        {
+            const auto deadline = Clock::now() + timeout;
+            std::unique_lock<std::mutex> lock(m_Inbox->lock);
+            for (;;)
+            {
+                const auto now = Clock::now();
+                if (!m_Inbox->datagrams.empty() && m_Inbox->datagrams.top().deliveryTime <= now)
+                {
+                    const auto& data = *m_Inbox->datagrams.top().data;
+                    const auto received = std::min(size, data.size());
+                    memcpy(buffer, data.data(), received);
+                    m_Inbox->datagrams.pop();
+                    return static_cast<int>(received);
+                }
+                if (now >= deadline)
+                {
+                    return 0;
+                }
+
+                auto wakeUpTime = deadline;
+                if (!m_Inbox->datagrams.empty())
+                {
+                    wakeUpTime = std::min(wakeUpTime, m_Inbox->datagrams.top().deliveryTime);
+                }
+                m_Inbox->added.wait_until(lock, wakeUpTime);
+            }
+        }
+
+    private:
+        SimulatedNetwork& m_Network;
+        const std::shared_ptr<Inbox> m_Inbox;
+        uint64_t m_RandomState;
+    };
+
+    SimulatedNetwork::SimulatedNetwork(const Config& config)
+        : m_Config(config)
+        , m_Inboxes(std::make_shared<const Inboxes>())
+    {
+    }
+
+    SimulatedNetwork::~SimulatedNetwork() = default;
+
+    std::unique_ptr<IDatagramTransport> SimulatedNetwork::CreateEndpoint()
+    {
+        auto inbox = std::make_shared<Inbox>();
+        uint64_t seed = m_Config.seed;
+        {
+            std::lock_guard<std::mutex> lock(m_Lock);
+            auto inboxes = std::make_shared<Inboxes>(*m_Inboxes);
+            inbox->address = static_cast<int>(m_CreatedEndpointCount);
+            inboxes->push_back(inbox);
+            m_Inboxes = std::move(inboxes);
+            seed += ++m_CreatedEndpointCount * 0x9e3779b97f4a7c15ull;
+        }
+        return std::make_unique<Endpoint>(*this, std::move(inbox), NextRandom(seed));
+    }
+
+    uint64_t SimulatedNetwork::GetSentCount() const
+    {
+        return m_SentCount.load(std::memory_order_relaxed);
+    }
+
+    uint64_t SimulatedNetwork::GetDeliveredCount() const
+    {
+        return m_DeliveredCount.load(std::memory_order_relaxed);
+    }
+
+    uint64_t SimulatedNetwork::GetDroppedCount() const
+    {
+        return m_DroppedCount.load(std::memory_order_relaxed);
+    }
+
+    void SimulatedNetwork::Deliver(const Inbox* const sender, const int destination, uint64_t& randomState,
+        const void* const data, const size_t size)
+    {
+        const auto now = Clock::now();
+        const auto bytes = static_cast<const uint8_t*>(data);
+        const auto sharedData = std::make_shared<const std::vector<uint8_t>>(bytes, bytes + size);
+
+        std::shared_ptr<const Inboxes> inboxes;
+        {
+            std::lock_guard<std::mutex> lock(m_Lock);
+            inboxes = m_Inboxes;
+        }
+
+        uint64_t deliveredCount = 0;
+        uint64_t droppedCount = 0;
+        for (const auto& inbox : *inboxes)
+        {
+            if (inbox.get() == sender || (destination >= 0 && inbox->address != destination))
+            {
+                continue;
+            }
+            // Remarks: Keep only the upper 53 bits for an uniform double in [0, 1).
+            if (m_Config.lossProbability > 0.0 &&
+                static_cast<double>(NextRandom(randomState) >> 11) * (1.0 / 9007199254740992.0) <
+                m_Config.lossProbability)
+            {
+                ++droppedCount;
+                continue;
+            }
+
+            auto delay = m_Config.latency;
+            if (m_Config.jitter.count() > 0)
+            {
+                delay += std::chrono::microseconds(NextRandom(randomState) % (m_Config.jitter.count() + 1));
+            }
+
+            std::lock_guard<std::mutex> inboxLock(inbox->lock);
+            const auto deliveryTime = now + delay;
+            // Only wake up the receiver if it has to deliver earlier than what it is waiting for.
+            const bool newEarliest = inbox->datagrams.empty() || deliveryTime < inbox->datagrams.top().deliveryTime;
+            inbox->datagrams.push(Datagram{deliveryTime, inbox->nextSequence++, sharedData});
+            if (newEarliest)
+            {
+                inbox->added.notify_all();
+            }
+            ++deliveredCount;
+        }
+
+        m_SentCount.fetch_add(1, std::memory_order_relaxed);
+        m_DeliveredCount.fetch_add(deliveredCount, std::memory_order_relaxed);
+        m_DroppedCount.fetch_add(droppedCount, std::memory_order_relaxed);
+    }
+
+    void SimulatedNetwork::Remove(const Inbox* const inbox)
+    {
+        std::lock_guard<std::mutex> lock(m_Lock);
+        auto inboxes = std::make_shared<Inboxes>(*m_Inboxes);
+        inboxes->erase(std::remove_if(inboxes->begin(), inboxes->end(),
+            [inbox](const std::shared_ptr<Inbox>& candidate) { return candidate.get() == inbox; }), inboxes->end());
+        m_Inboxes = std::move(inboxes);
+    }
+}
@@ -0,0 +1,264 @@
+#include "SimulatedSyncApi.h"
+#include "IGraphicsDevice.h"
+#include "PerformanceCounter.h"
+
+#include <algorithm>
+
+namespace GfxQuadroSync
+{
+    SimulatedSyncApi::SimulatedSyncApi(const Config& config)
+        : m_Config(config)
+        , m_RandomState(config.seed)
+        , m_NodeArrivalNs(std::max(config.nodeCount, 1u), 0)
+    {
+    }
+
+    SimulatedSyncApi::~SimulatedSyncApi()
+    {
+        if (m_InstalledAsPerformanceCounterSource)
+        {
+            SetPerformanceCounterSource(nullptr, nullptr);
+        }
+    }
+
+    void SimulatedSyncApi::InjectFailure(const Operation operation, const SyncApiStatus status, const uint32_t count)
+    {
+        auto& injectedFailure = m_InjectedFailures[static_cast<size_t>(operation)];
+        injectedFailure.status = status;
+        injectedFailure.remaining = count;
+    }
+
+    void SimulatedSyncApi::InstallAsPerformanceCounterSource()
+    {
+        SetPerformanceCounterSource(&GetPerformanceCounterTick, this);
+        m_InstalledAsPerformanceCounterSource = true;
+    }
+
+    SyncApiStatus SimulatedSyncApi::Initialize()
+    {
+        SyncApiStatus status;
+        return ConsumeInjectedFailure(Operation::Initialize, status) ? status : SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus SimulatedSyncApi::SetupWorkstationSwapGroupFeature(bool)
+    {
+        SyncApiStatus status;
+        return ConsumeInjectedFailure(Operation::SetupWorkstationSwapGroupFeature, status) ? status : SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus SimulatedSyncApi::QueryMaxSwapGroup(IUnknown*, uint32_t& maxGroups, uint32_t& maxBarriers)
+    {
+        SyncApiStatus status;
+        if (ConsumeInjectedFailure(Operation::QueryMaxSwapGroup, status))
+        {
+            return status;
+        }
+        maxGroups = m_Config.maxSwapGroups;
+        maxBarriers = m_Config.maxSwapBarriers;
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus SimulatedSyncApi::JoinSwapGroup(IUnknown*, IDXGISwapChain* const pSwapChain, const uint32_t group,
+        bool)
+    {
+        SyncApiStatus status;
+        if (ConsumeInjectedFailure(Operation::JoinSwapGroup, status))
+        {
+            return status;
+        }
+        if (group > m_Config.maxSwapGroups)
+        {
+            return SyncApiStatus::InvalidArgument;
+        }
+        if (group == 0)
+        {
+            // Leaving a swap group the swap chain is not in does nothing
+            if (pSwapChain == m_SwapChain)
+            {
+                ReleaseSwapChain(pSwapChain);
+            }
+            return SyncApiStatus::Ok;
+        }
+        // Remarks: Replaces the swap chain in the group (if any) and keeps the barrier bound to the group.
+        m_GroupId = group;
+        m_SwapChain = pSwapChain;
+        return SyncApiStatus::Ok;
+    }
+
+    void SimulatedSyncApi::ReleaseSwapChain(IDXGISwapChain* const pSwapChain)
+    {
+        if (m_GroupId > 0 && pSwapChain == m_SwapChain)
+        {
+            m_GroupId = 0;
+            m_BarrierId = 0;
+            m_SwapChain = nullptr;
+        }
+    }
+
+    SyncApiStatus SimulatedSyncApi::BindSwapBarrier(IUnknown*, const uint32_t group, const uint32_t barrier)
+    {
+        SyncApiStatus status;
+        if (ConsumeInjectedFailure(Operation::BindSwapBarrier, status))
+        {
+            return status;
+        }
+        if (group == 0 || group != m_GroupId || barrier > m_Config.maxSwapBarriers)
+        {
+            return SyncApiStatus::InvalidArgument;
+        }
+        if (barrier != m_BarrierId)
+        {
+            m_BarrierId = barrier;
+            m_PresentsSinceBarrierBound = 0;
+        }
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus SimulatedSyncApi::QuerySwapGroup(IUnknown*, IDXGISwapChain* const pSwapChain, uint32_t& group,
+        uint32_t& barrier)
+    {
+        SyncApiStatus status;
+        if (ConsumeInjectedFailure(Operation::QuerySwapGroup, status))
+        {
+            return status;
+        }
+        const bool inSwapGroup = pSwapChain == m_SwapChain;
+        group = inSwapGroup ? m_GroupId : 0;
+        barrier = inSwapGroup ? m_BarrierId : 0;
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus SimulatedSyncApi::QueryFrameCount(IUnknown*, uint32_t& frameCount)
+    {
+        SyncApiStatus status;
+        if (ConsumeInjectedFailure(Operation::QueryFrameCount, status))
+        {
+            return status;
+        }
+        frameCount = static_cast<uint32_t>((m_NowNs - m_FrameCountResetNs) / m_Config.refreshPeriodNs);
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus SimulatedSyncApi::ResetFrameCount(IUnknown*)
+    {
+        SyncApiStatus status;
+        if (ConsumeInjectedFailure(Operation::ResetFrameCount, status))
+        {
+            return status;
+        }
+        m_FrameCountResetNs = m_NowNs - m_NowNs % m_Config.refreshPeriodNs;
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus SimulatedSyncApi::Present(IGraphicsDevice& graphicsDevice)
+    {
+        SyncApiStatus status;
+        if (ConsumeInjectedFailure(Operation::Present, status))
+        {
+            return status;
+        }
+        if (m_Config.presentFailureProbability > 0.0 && NextUniform() < m_Config.presentFailureProbability)
+        {
+            return m_Config.presentFailureStatus;
+        }
+
+        // Barrier is released once every node arrived (if active and presenting a swap chain in the swap group)
+        const bool inSwapGroup = graphicsDevice.GetSwapChain() == m_SwapChain;
+        const bool barrierActive = m_GroupId > 0 && m_BarrierId > 0 && inSwapGroup &&
+            m_PresentsSinceBarrierBound >= m_Config.barrierWarmupPresents;
+        if (!barrierActive)
+        {
+            ++m_UnsynchronizedPresentCount;
+        }
+        if (m_BarrierId > 0 && m_PresentsSinceBarrierBound < m_Config.barrierWarmupPresents)
+        {
+            ++m_PresentsSinceBarrierBound;
+        }
+        const uint64_t localArrivalNs = m_NowNs;
+        uint64_t barrierNs = localArrivalNs;
+        if (barrierActive)
+        {
+            for (size_t nodeIndex = 1; nodeIndex < m_NodeArrivalNs.size(); ++nodeIndex)
+            {
+                barrierNs = std::max(barrierNs, m_NodeArrivalNs[nodeIndex]);
+            }
+        }
+        m_TotalBarrierWaitNs += barrierNs - localArrivalNs;
+
+        // And flip happens on the next vblank
+        uint64_t releaseNs = barrierNs;
+        const uint32_t syncInterval = graphicsDevice.GetSyncInterval();
+        if (syncInterval > 0)
+        {
+            const auto period = m_Config.refreshPeriodNs;
+            const auto localVblankNs = (localArrivalNs + period - 1) / period * period;
+            const auto vblankNs = (barrierNs + period - 1) / period * period;
+            if (vblankNs > localVblankNs)
+            {
+                ++m_MissedVblankCount;
+            }
+            releaseNs = vblankNs + (syncInterval - 1) * period;
+        }
+
+        // Simulated nodes start working on the next frame as soon as they are released.
+        for (size_t nodeIndex = 1; nodeIndex < m_NodeArrivalNs.size(); ++nodeIndex)
+        {
+            m_NodeArrivalNs[nodeIndex] = releaseNs + NextRenderTimeNs(nodeIndex);
+        }
+
+        m_NowNs = releaseNs;
+        if (barrierActive && m_Config.barrierJitterNs > 0)
+        {
+            m_NowNs += NextRandom() % (m_Config.barrierJitterNs + 1);
+        }
+        ++m_PresentCount;
+        return SyncApiStatus::Ok;
+    }
+
+    bool SimulatedSyncApi::ConsumeInjectedFailure(const Operation operation, SyncApiStatus& status)
+    {
+        auto& injectedFailure = m_InjectedFailures[static_cast<size_t>(operation)];
+        if (injectedFailure.remaining == 0)
+        {
+            return false;
+        }
+        --injectedFailure.remaining;
+        status = injectedFailure.status;
+        return true;
+    }
+
+    uint64_t SimulatedSyncApi::NextRandom()
+    {
+        // splitmix64, fully specified (as opposed to the std distributions) so results are the same everywhere.
+        uint64_t z = (m_RandomState += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    double SimulatedSyncApi::NextUniform()
+    {
+        return static_cast<double>(NextRandom() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    uint64_t SimulatedSyncApi::NextRenderTimeNs(const size_t nodeIndex)
+    {
+        const auto renderTimeNs = nodeIndex < m_Config.nodeRenderTimeNs.size() ?
+            m_Config.nodeRenderTimeNs[nodeIndex] : m_Config.renderTimeNs;
+        const auto renderTimeJitterNs = nodeIndex < m_Config.nodeRenderTimeJitterNs.size() ?
+            m_Config.nodeRenderTimeJitterNs[nodeIndex] : m_Config.renderTimeJitterNs;
+        const auto jitter = std::min(renderTimeJitterNs, renderTimeNs);
+        if (jitter == 0)
+        {
+            return renderTimeNs;
+        }
+        return renderTimeNs - jitter + NextRandom() % (jitter * 2 + 1);
+    }
+
+    uint64_t SimulatedSyncApi::GetPerformanceCounterTick(void* const context)
+    {
+        const auto nowNs = static_cast<const SimulatedSyncApi*>(context)->m_NowNs;
+        const auto frequency = GetPerformanceCounterFrequency();
+        return nowNs / 1000000000ull * frequency + nowNs % 1000000000ull * frequency / 1000000000ull;
+    }
+}
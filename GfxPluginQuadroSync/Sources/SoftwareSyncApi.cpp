@@ -0,0 +1,823 @@
+#include "SoftwareSyncApi.h"
+#include "IGraphicsDevice.h"
+#include "Logger.h"
+#include "MessageSerialization.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace GfxQuadroSync
+{
+    namespace
+    {
+        // Messages exchanged between nodes:
+        // - Header:  uint32 magic, uint8 version, uint8 type.
+        // - Arrive:  uint8 nodeId, uint64 generation, uint64 release time of generation - 1 (in ns, 0 if unknown).
+        // - Gather:  uint8 nodeId, uint64 generation, uint64 min and uint64 max release time of generation - 1 of the
+        //            subtree of the node (in ns, min is 0 if any is unknown).
+        // - Release: uint8 nodeId, uint64 generation.
+        // - Notify:  uint8 nodeId, uint64 generation, uint8 round, uint64 min and uint64 max release time of
+        //            generation - 1 of the nodes the sender heard of (in ns, min is 0 if any is unknown).
+        // - Resend:  uint8 nodeId, uint64 generation, uint8 round (the sender still waits on our Notify of that round).
+        // Multi-byte values are little endian.
+        constexpr uint32_t k_MessageMagic = 0x42535147; // "GQSB"
+        constexpr uint8_t k_MessageVersion = 1;
+        constexpr size_t k_HeaderSize = 6;
+        constexpr size_t k_ArriveSize = k_HeaderSize + 17;
+        constexpr size_t k_GatherSize = k_HeaderSize + 25;
+        constexpr size_t k_ReleaseSize = k_HeaderSize + 9;
+        constexpr size_t k_NotifySize = k_HeaderSize + 26;
+        constexpr size_t k_ResendSize = k_HeaderSize + 10;
+        constexpr size_t k_MaxMessageSize = 64;
+
+        /// Maximum factor applied to resendInterval when backing off (Tree and Dissemination).
+        constexpr int k_MaxResendBackoff = 16;
+
+        enum class MessageType : uint8_t
+        {
+            Arrive = 1,
+            Gather = 2,
+            Release = 3,
+            Notify = 4,
+            Resend = 5,
+        };
+
+        size_t WriteHeader(uint8_t* const message, const MessageType type, const uint8_t nodeId,
+            const uint64_t generation)
+        {
+            WriteUInt32(message, k_MessageMagic);
+            message[4] = k_MessageVersion;
+            message[5] = static_cast<uint8_t>(type);
+            message[k_HeaderSize] = nodeId;
+            WriteUInt64(message + k_HeaderSize + 1, generation);
+            return k_HeaderSize + 9;
+        }
+
+        uint64_t ToNanoseconds(const std::chrono::steady_clock::time_point time)
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+        }
+
+        /// List of the node ids in the bit vector (for logging).
+        std::string ToString(const std::bitset<256>& nodes)
+        {
+            std::ostringstream os;
+            for (size_t nodeId = 0; nodeId < nodes.size(); ++nodeId)
+            {
+                if (nodes.test(nodeId))
+                {
+                    os << (os.tellp() > 0 ? ", " : "") << nodeId;
+                }
+            }
+            return os.str();
+        }
+    }
+
+    SoftwareSyncApi::SoftwareSyncApi(const Config& config, std::unique_ptr<IDatagramTransport> transport)
+        : m_Config(config)
+        , m_Transport(std::move(transport))
+        , m_Algorithm(config.algorithm)
+        , m_ActiveNodes(config.nodes)
+    {
+        // Nodes are ranked by node id to build the topology of Tree and Dissemination (so that every node builds the
+        // same one).
+        std::vector<uint8_t> rankToNodeId;
+        uint32_t rank = 0;
+        for (size_t nodeId = 0; nodeId < m_Config.nodes.size(); ++nodeId)
+        {
+            if (nodeId == m_Config.nodeId)
+            {
+                rank = static_cast<uint32_t>(rankToNodeId.size());
+            }
+            if (m_Config.nodes.test(nodeId) || nodeId == m_Config.nodeId)
+            {
+                rankToNodeId.push_back(static_cast<uint8_t>(nodeId));
+            }
+        }
+        const auto nodeCount = static_cast<uint32_t>(rankToNodeId.size());
+        const auto fanOut = std::max(m_Config.fanOut, 1u);
+
+        if (m_Config.algorithm == BarrierAlgorithm::Tree)
+        {
+            if (rank > 0)
+            {
+                m_ParentNodeId = rankToNodeId[(rank - 1) / fanOut];
+            }
+            for (uint64_t childRank = static_cast<uint64_t>(rank) * fanOut + 1;
+                 childRank <= static_cast<uint64_t>(rank) * fanOut + fanOut && childRank < nodeCount; ++childRank)
+            {
+                m_Children.set(rankToNodeId[childRank]);
+            }
+            for (uint64_t interiorRank = 0; interiorRank * fanOut + 1 < nodeCount; ++interiorRank)
+            {
+                m_InteriorNodes.set(rankToNodeId[interiorRank]);
+            }
+        }
+        else if (m_Config.algorithm == BarrierAlgorithm::Dissemination)
+        {
+            // After round r we heard of the (fanOut + 1)^(r + 1) nodes preceding us (ourselves included).
+            for (uint64_t distance = 1; distance < nodeCount; distance *= fanOut + 1)
+            {
+                DisseminationRound round;
+                for (uint64_t multiple = 1; multiple <= fanOut && multiple * distance < nodeCount; ++multiple)
+                {
+                    const auto offset = static_cast<uint32_t>(multiple * distance);
+                    round.sources.set(rankToNodeId[(rank + nodeCount - offset) % nodeCount]);
+                    round.targets.push_back(rankToNodeId[(rank + offset) % nodeCount]);
+                }
+                m_Rounds.push_back(std::move(round));
+            }
+            m_Round = static_cast<uint32_t>(m_Rounds.size());
+            m_Notified.resize(m_Rounds.size());
+            m_NotifiedNext.resize(m_Rounds.size());
+        }
+    }
+
+    SoftwareSyncApi::~SoftwareSyncApi() = default;
+
+    SyncApiStatus SoftwareSyncApi::Initialize()
+    {
+        if (m_Config.hostInstanceCount > 1 && !m_HostBarrier.IsOpen() &&
+            !m_HostBarrier.Open(m_Config.hostBarrierName, m_Config.hostInstanceCount, m_Config.hostInstanceIndex))
+        {
+            return SyncApiStatus::ApiNotInitialized;
+        }
+        if (!m_Transport && !IsHostFollower())
+        {
+            CLUSTER_LOG_ERROR << "SoftwareSyncApi: no transport to communicate with other nodes";
+            return SyncApiStatus::ApiNotInitialized;
+        }
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus SoftwareSyncApi::SetupWorkstationSwapGroupFeature(bool)
+    {
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus SoftwareSyncApi::QueryMaxSwapGroup(IUnknown*, uint32_t& maxGroups, uint32_t& maxBarriers)
+    {
+        maxGroups = 1;
+        maxBarriers = 1;
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus SoftwareSyncApi::JoinSwapGroup(IUnknown*, IDXGISwapChain*, const uint32_t group, bool)
+    {
+        if (group > 1)
+        {
+            return SyncApiStatus::InvalidArgument;
+        }
+        m_GroupId = group;
+        if (m_GroupId == 0)
+        {
+            m_BarrierId = 0;
+        }
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus SoftwareSyncApi::BindSwapBarrier(IUnknown*, const uint32_t group, const uint32_t barrier)
+    {
+        if (barrier > 1 || group != m_GroupId || (barrier > 0 && m_GroupId == 0))
+        {
+            return SyncApiStatus::InvalidArgument;
+        }
+        if (!m_Transport && !IsHostFollower())
+        {
+            return SyncApiStatus::ApiNotInitialized;
+        }
+        m_BarrierId = barrier;
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus SoftwareSyncApi::QuerySwapGroup(IUnknown*, IDXGISwapChain*, uint32_t& group, uint32_t& barrier)
+    {
+        group = m_GroupId;
+        barrier = m_BarrierId;
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus SoftwareSyncApi::QueryFrameCount(IUnknown*, uint32_t& frameCount)
+    {
+        frameCount = static_cast<uint32_t>(m_Generation - m_FrameCountBaseGeneration);
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus SoftwareSyncApi::ResetFrameCount(IUnknown*)
+    {
+        m_FrameCountBaseGeneration = m_Generation;
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus SoftwareSyncApi::Present(IGraphicsDevice& graphicsDevice)
+    {
+        if (m_BarrierId > 0)
+        {
+            if (IsHostFollower())
+            {
+                WaitOnHostBarrier();
+            }
+            else if (m_HostBarrier.IsOpen())
+            {
+                m_HostBarrier.WaitForOtherInstances(m_Config.timeout);
+                WaitOnBarrier();
+                m_HostBarrier.Release(m_Generation);
+            }
+            else
+            {
+                WaitOnBarrier();
+            }
+        }
+        return graphicsDevice.Present() ? SyncApiStatus::Ok : SyncApiStatus::Error;
+    }
+
+    void SoftwareSyncApi::WaitOnBarrier()
+    {
+        ++m_Generation;
+        const auto arrivalTime = Clock::now();
+        const auto deadline = arrivalTime + m_Config.timeout;
+        bool released = Arrive();
+        auto resendInterval = m_Config.resendInterval;
+        auto nextSendTime = arrivalTime + resendInterval;
+        bool timedOut = false;
+        uint8_t message[k_MaxMessageSize];
+        while (!released)
+        {
+            const auto now = Clock::now();
+            if (now >= deadline)
+            {
+                timedOut = true;
+                break;
+            }
+            if (now >= nextSendTime)
+            {
+                ResendArrival();
+                // Remarks: Tree and Dissemination are meant for large clusters, back off so that nodes waiting on a
+                // slow node do not make it even slower by flooding it with requests.
+                if (m_Algorithm != BarrierAlgorithm::AllToAll)
+                {
+                    resendInterval = std::min(resendInterval * 2, m_Config.resendInterval * k_MaxResendBackoff);
+                }
+                nextSendTime = now + resendInterval;
+            }
+
+            const auto wait = std::chrono::ceil<std::chrono::microseconds>(std::min(deadline, nextSendTime) - now);
+            const int received = m_Transport->Receive(message, sizeof(message), wait);
+            if (received < 0)
+            {
+                // Nothing more we can do to synchronize this present, the error has already been logged by the
+                // transport.
+                timedOut = true;
+                break;
+            }
+            if (received > 0)
+            {
+                released = ProcessMessage(message, received);
+            }
+        }
+
+        const auto releaseTime = Clock::now();
+        m_BarrierWaitStatistics.Record(
+            std::chrono::duration_cast<std::chrono::microseconds>(releaseTime - arrivalTime).count());
+        if (timedOut)
+        {
+            m_TimeoutCount.fetch_add(1, std::memory_order_relaxed);
+            auto missing = GetMissingNodes();
+            if (m_Algorithm == BarrierAlgorithm::Tree)
+            {
+                missing = OnTreeTimeout(missing);
+            }
+            if (missing.any() && m_Algorithm == BarrierAlgorithm::Dissemination)
+            {
+                CLUSTER_LOG_WARNING << "SoftwareSyncApi: generation " << m_Generation << " timed out in round "
+                                    << m_Round << " waiting on node(s) " << ToString(missing);
+            }
+            else if (missing.any())
+            {
+                CLUSTER_LOG_WARNING << "SoftwareSyncApi: generation " << m_Generation << " timed out, no longer "
+                                    << "waiting on node(s) " << ToString(missing);
+                m_ActiveNodes &= ~missing;
+            }
+        }
+        else
+        {
+            m_SuspectedNodes.reset();
+        }
+        OnReleased(releaseTime);
+    }
+
+    void SoftwareSyncApi::WaitOnHostBarrier()
+    {
+        // Remarks: The representative can wait up to timeout on us and the other instances and then up to timeout on
+        // the other nodes.
+        const auto arrivalTime = Clock::now();
+        uint64_t generation = 0;
+        std::chrono::nanoseconds releaseLatency(0);
+        const bool released = m_HostBarrier.ArriveAndWait(m_Config.timeout * 2, generation, releaseLatency);
+        m_BarrierWaitStatistics.Record(
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - arrivalTime).count());
+        if (released)
+        {
+            m_Generation = generation;
+            m_ReleaseCount.fetch_add(1, std::memory_order_relaxed);
+            m_HostReleaseLatencyStatistics.Record(
+                std::chrono::duration_cast<std::chrono::microseconds>(releaseLatency).count());
+        }
+        else
+        {
+            CLUSTER_LOG_WARNING << "SoftwareSyncApi: timed out waiting on the representative of the computer";
+            ++m_Generation;
+            m_TimeoutCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    bool SoftwareSyncApi::Arrive()
+    {
+        m_Complete = false;
+        switch (m_Algorithm)
+        {
+        case BarrierAlgorithm::Tree:
+            m_Arrived = m_ArrivedNext;
+            m_ArrivedNext.reset();
+            m_Gathered = false;
+            return ProgressTree();
+        case BarrierAlgorithm::Dissemination:
+            m_Notified.swap(m_NotifiedNext);
+            for (auto& notified : m_NotifiedNext)
+            {
+                notified.reset();
+            }
+            m_Round = 0;
+            m_ReleaseTimes[(m_Generation - 1) & 1].Merge(m_Config.nodeId, m_PreviousReleaseTimeNs,
+                m_PreviousReleaseTimeNs);
+            if (!m_Rounds.empty())
+            {
+                SendNotify(0);
+            }
+            return ProgressDissemination();
+        case BarrierAlgorithm::AllToAll:
+        default:
+            m_Arrived = m_ArrivedNext;
+            m_Arrived.set(m_Config.nodeId);
+            m_ArrivedNext.reset();
+            SendArrive();
+            m_Complete = (m_ActiveNodes & ~m_Arrived).none();
+            return m_Complete;
+        }
+    }
+
+    void SoftwareSyncApi::ResendArrival()
+    {
+        switch (m_Algorithm)
+        {
+        case BarrierAlgorithm::Tree:
+            if (m_Gathered)
+            {
+                SendGather();
+            }
+            break;
+        case BarrierAlgorithm::Dissemination:
+            // Remarks: Only ask the sources we are missing (rather than repeating every notification we sent) to
+            // keep the number of messages low when the barrier is slow to release.
+            if (m_Round < m_Rounds.size())
+            {
+                SendResend(m_Rounds[m_Round].sources & ~m_Notified[m_Round]);
+            }
+            break;
+        case BarrierAlgorithm::AllToAll:
+        default:
+            SendArrive();
+            break;
+        }
+    }
+
+    std::bitset<256> SoftwareSyncApi::GetMissingNodes() const
+    {
+        switch (m_Algorithm)
+        {
+        case BarrierAlgorithm::Tree:
+            // Remarks: Once every child arrived we wait on our parent (that we cannot skip, see OnTreeTimeout).
+            return m_Children & m_ActiveNodes & ~m_Arrived;
+        case BarrierAlgorithm::Dissemination:
+            return m_Round < m_Rounds.size() ? m_Rounds[m_Round].sources & ~m_Notified[m_Round] : std::bitset<256>();
+        case BarrierAlgorithm::AllToAll:
+        default:
+            return m_ActiveNodes & ~m_Arrived;
+        }
+    }
+
+    void SoftwareSyncApi::SendArrive()
+    {
+        uint8_t message[k_ArriveSize];
+        const auto offset = WriteHeader(message, MessageType::Arrive, m_Config.nodeId, m_Generation);
+        WriteUInt64(message + offset, m_PreviousReleaseTimeNs);
+        m_Transport->Send(message, sizeof(message));
+    }
+
+    void SoftwareSyncApi::SendGather()
+    {
+        const auto& releaseTimes = m_ReleaseTimes[(m_Generation - 1) & 1];
+        const bool complete = releaseTimes.received.any() && !releaseTimes.incomplete;
+        uint8_t message[k_GatherSize];
+        const auto offset = WriteHeader(message, MessageType::Gather, m_Config.nodeId, m_Generation);
+        WriteUInt64(message + offset, complete ? releaseTimes.minNs : 0);
+        WriteUInt64(message + offset + 8, complete ? releaseTimes.maxNs : 0);
+        m_Transport->SendTo(static_cast<uint8_t>(m_ParentNodeId), message, sizeof(message));
+    }
+
+    void SoftwareSyncApi::SendRelease(const int nodeId, const uint64_t generation)
+    {
+        uint8_t message[k_ReleaseSize];
+        WriteHeader(message, MessageType::Release, m_Config.nodeId, generation);
+        if (nodeId < 0)
+        {
+            m_Transport->Send(message, sizeof(message));
+        }
+        else
+        {
+            m_Transport->SendTo(static_cast<uint8_t>(nodeId), message, sizeof(message));
+        }
+    }
+
+    void SoftwareSyncApi::SendNotify(const uint32_t round)
+    {
+        for (const auto target : m_Rounds[round].targets)
+        {
+            SendNotify(target, m_Generation, round);
+        }
+    }
+
+    void SoftwareSyncApi::SendNotify(const uint8_t nodeId, const uint64_t generation, const uint32_t round)
+    {
+        const auto& releaseTimes = m_ReleaseTimes[(generation - 1) & 1];
+        const bool complete = releaseTimes.received.any() && !releaseTimes.incomplete;
+        uint8_t message[k_NotifySize];
+        auto offset = WriteHeader(message, MessageType::Notify, m_Config.nodeId, generation);
+        message[offset++] = static_cast<uint8_t>(round);
+        WriteUInt64(message + offset, complete ? releaseTimes.minNs : 0);
+        WriteUInt64(message + offset + 8, complete ? releaseTimes.maxNs : 0);
+        m_Transport->SendTo(nodeId, message, sizeof(message));
+    }
+
+    void SoftwareSyncApi::SendResend(const std::bitset<256>& nodes)
+    {
+        uint8_t message[k_ResendSize];
+        const auto offset = WriteHeader(message, MessageType::Resend, m_Config.nodeId, m_Generation);
+        message[offset] = static_cast<uint8_t>(m_Round);
+        for (size_t nodeId = 0; nodeId < nodes.size(); ++nodeId)
+        {
+            if (nodes.test(nodeId))
+            {
+                m_Transport->SendTo(static_cast<uint8_t>(nodeId), message, sizeof(message));
+            }
+        }
+    }
+
+    bool SoftwareSyncApi::ProcessMessage(const uint8_t* const message, const int size)
+    {
+        if (size < static_cast<int>(k_ReleaseSize) || ReadUInt32(message) != k_MessageMagic ||
+            message[4] != k_MessageVersion)
+        {
+            return false;
+        }
+
+        const auto nodeId = message[k_HeaderSize];
+        if (nodeId == m_Config.nodeId || !m_Config.nodes.test(nodeId))
+        {
+            return false;
+        }
+        const auto generation = ReadUInt64(message + k_HeaderSize + 1);
+        const auto* const payload = message + k_HeaderSize + 9;
+
+        // Remarks: Messages of other algorithms are ignored (every node must use the same algorithm), except for the
+        // Arrive of a node whose Tree fell back to AllToAll.
+        const auto type = static_cast<MessageType>(message[5]);
+        switch (m_Algorithm)
+        {
+        case BarrierAlgorithm::Tree:
+            if (type == MessageType::Gather && size >= static_cast<int>(k_GatherSize))
+            {
+                return ProcessGather(nodeId, generation, ReadUInt64(payload), ReadUInt64(payload + 8));
+            }
+            if (type == MessageType::Arrive && size >= static_cast<int>(k_ArriveSize))
+            {
+                CLUSTER_LOG_WARNING << "SoftwareSyncApi: node " << static_cast<int>(nodeId) << " fell back to the "
+                                    << "AllToAll algorithm, doing the same";
+                FallBackToAllToAll();
+                // Our arrival at the current generation was only reported to our parent.
+                SendArrive();
+                return ProcessArrive(nodeId, generation, ReadUInt64(payload));
+            }
+            return type == MessageType::Release && ProcessRelease(nodeId, generation);
+        case BarrierAlgorithm::Dissemination:
+            if (type == MessageType::Notify && size >= static_cast<int>(k_NotifySize))
+            {
+                return ProcessNotify(nodeId, generation, payload[0], ReadUInt64(payload + 1), ReadUInt64(payload + 9));
+            }
+            return type == MessageType::Resend && size >= static_cast<int>(k_ResendSize) &&
+                ProcessResend(nodeId, generation, payload[0]);
+        case BarrierAlgorithm::AllToAll:
+        default:
+            return type == MessageType::Arrive && size >= static_cast<int>(k_ArriveSize) &&
+                ProcessArrive(nodeId, generation, ReadUInt64(payload));
+        }
+    }
+
+    bool SoftwareSyncApi::ProcessArrive(const uint8_t nodeId, const uint64_t generation,
+        const uint64_t previousReleaseTimeNs)
+    {
+        if (!m_ActiveNodes.test(nodeId))
+        {
+            CLUSTER_LOG << "SoftwareSyncApi: node " << static_cast<int>(nodeId) << " is back, waiting on it again";
+            m_ActiveNodes.set(nodeId);
+        }
+
+        if (generation == m_Generation)
+        {
+            m_Arrived.set(nodeId);
+            m_ReleaseTimes[(generation - 1) & 1].Add(nodeId, previousReleaseTimeNs);
+            m_Complete = (m_ActiveNodes & ~m_Arrived).none();
+            return m_Complete;
+        }
+        if (generation == m_Generation + 1)
+        {
+            // The sender could only get to the next generation if the barrier of the current one was released (we
+            // simply lost some of the messages).
+            m_ArrivedNext.set(nodeId);
+            m_ReleaseTimes[m_Generation & 1].Add(nodeId, previousReleaseTimeNs);
+            return true;
+        }
+        if (generation > m_Generation + 1)
+        {
+            JumpToGeneration(generation - 1, nodeId);
+            m_ArrivedNext.set(nodeId);
+            return true;
+        }
+        return false;
+    }
+
+    bool SoftwareSyncApi::ProcessGather(const uint8_t nodeId, const uint64_t generation,
+        const uint64_t minReleaseTimeNs, const uint64_t maxReleaseTimeNs)
+    {
+        if (!m_Children.test(nodeId))
+        {
+            // Still tells that the barrier of a generation was released.
+            if (generation > m_Generation + 1)
+            {
+                JumpToGeneration(generation - 1, nodeId);
+            }
+            return generation > m_Generation;
+        }
+        if (!m_ActiveNodes.test(nodeId))
+        {
+            CLUSTER_LOG << "SoftwareSyncApi: node " << static_cast<int>(nodeId) << " is back, waiting on it again";
+            m_ActiveNodes.set(nodeId);
+        }
+
+        if (generation < m_Generation)
+        {
+            // We were released (or timed out) while the child missed the release.
+            SendRelease(nodeId, generation);
+            return false;
+        }
+        if (generation == m_Generation)
+        {
+            m_Arrived.set(nodeId);
+            m_ReleaseTimes[(generation - 1) & 1].Merge(nodeId, minReleaseTimeNs, maxReleaseTimeNs);
+            return ProgressTree();
+        }
+        if (generation > m_Generation + 1)
+        {
+            JumpToGeneration(generation - 1, nodeId);
+        }
+        // The child could only get to the next generation if the barrier of the current one was released.
+        m_ArrivedNext.set(nodeId);
+        m_ReleaseTimes[m_Generation & 1].Merge(nodeId, minReleaseTimeNs, maxReleaseTimeNs);
+        return true;
+    }
+
+    bool SoftwareSyncApi::ProcessRelease(const uint8_t nodeId, const uint64_t generation)
+    {
+        if (generation > m_Generation)
+        {
+            JumpToGeneration(generation, nodeId);
+        }
+        return generation == m_Generation;
+    }
+
+    bool SoftwareSyncApi::ProcessNotify(const uint8_t nodeId, const uint64_t generation, const uint32_t round,
+        const uint64_t minReleaseTimeNs, const uint64_t maxReleaseTimeNs)
+    {
+        if (generation < m_Generation)
+        {
+            return false;
+        }
+
+        const bool isSource = round < m_Rounds.size() && m_Rounds[round].sources.test(nodeId);
+        if (generation == m_Generation)
+        {
+            if (isSource)
+            {
+                m_Notified[round].set(nodeId);
+                m_ReleaseTimes[(generation - 1) & 1].Merge(nodeId, minReleaseTimeNs, maxReleaseTimeNs);
+                return ProgressDissemination();
+            }
+            return false;
+        }
+        if (generation > m_Generation + 1)
+        {
+            JumpToGeneration(generation - 1, nodeId);
+        }
+        // The sender could only get to the next generation if every node arrived at the current one.
+        if (isSource)
+        {
+            m_NotifiedNext[round].set(nodeId);
+            m_ReleaseTimes[m_Generation & 1].Merge(nodeId, minReleaseTimeNs, maxReleaseTimeNs);
+        }
+        return true;
+    }
+
+    bool SoftwareSyncApi::ProcessResend(const uint8_t nodeId, const uint64_t generation, const uint32_t round)
+    {
+        if (generation < m_Generation)
+        {
+            // The sender missed some of the notifications of a generation that is over, anything from a later
+            // generation releases it.
+            SendNotify(nodeId, m_Generation, 0);
+            return false;
+        }
+        if (generation == m_Generation)
+        {
+            const auto& targets = round < m_Rounds.size() ? m_Rounds[round].targets : std::vector<uint8_t>();
+            if (round <= m_Round && std::find(targets.begin(), targets.end(), nodeId) != targets.end())
+            {
+                SendNotify(nodeId, m_Generation, round);
+            }
+            return false;
+        }
+        // The sender could only get to the next generation if every node arrived at the current one.
+        if (generation > m_Generation + 1)
+        {
+            JumpToGeneration(generation - 1, nodeId);
+        }
+        return true;
+    }
+
+    bool SoftwareSyncApi::ProgressTree()
+    {
+        if (m_Gathered || (m_Children & m_ActiveNodes & ~m_Arrived).any())
+        {
+            return false;
+        }
+        m_ReleaseTimes[(m_Generation - 1) & 1].Merge(m_Config.nodeId, m_PreviousReleaseTimeNs,
+            m_PreviousReleaseTimeNs);
+        if (m_ParentNodeId < 0)
+        {
+            SendRelease(-1, m_Generation);
+            m_Complete = true;
+            return true;
+        }
+        m_Gathered = true;
+        SendGather();
+        return false;
+    }
+
+    bool SoftwareSyncApi::ProgressDissemination()
+    {
+        while (m_Round < m_Rounds.size() && (m_Rounds[m_Round].sources & ~m_Notified[m_Round]).none())
+        {
+            ++m_Round;
+            if (m_Round < m_Rounds.size())
+            {
+                SendNotify(m_Round);
+            }
+        }
+        m_Complete = m_Round == m_Rounds.size();
+        return m_Complete;
+    }
+
+    void SoftwareSyncApi::JumpToGeneration(const uint64_t generation, const uint8_t nodeId)
+    {
+        CLUSTER_LOG_WARNING << "SoftwareSyncApi: jumping from generation " << m_Generation << " to " << generation
+                            << " of the barrier to catch up with node " << static_cast<int>(nodeId);
+        m_Generation = generation;
+        m_ArrivedNext.reset();
+        for (auto& notified : m_NotifiedNext)
+        {
+            notified.reset();
+        }
+        m_ReleaseTimes[0].Reset();
+        m_ReleaseTimes[1].Reset();
+    }
+
+    std::bitset<256> SoftwareSyncApi::OnTreeTimeout(const std::bitset<256>& missingChildren)
+    {
+        // Skipping a child that has children of its own would lose its whole subtree (they keep reporting to it), and
+        // nobody releases the barrier if our parent (or an ancestor) is gone.  Wait on them once more in case it was
+        // caused by a node further away in the tree, and fall back to AllToAll if they time out again.
+        auto suspected = missingChildren & m_InteriorNodes;
+        if (missingChildren.none() && m_ParentNodeId >= 0)
+        {
+            suspected.set(m_ParentNodeId);
+        }
+        if ((suspected & m_SuspectedNodes).any())
+        {
+            CLUSTER_LOG_WARNING << "SoftwareSyncApi: generation " << m_Generation << " timed out again waiting on "
+                                << "node(s) " << ToString(suspected & m_SuspectedNodes) << ", falling back to the "
+                                << "AllToAll algorithm";
+            FallBackToAllToAll();
+            return std::bitset<256>();
+        }
+        m_SuspectedNodes = suspected;
+        if (suspected.any())
+        {
+            CLUSTER_LOG_WARNING << "SoftwareSyncApi: generation " << m_Generation << " timed out waiting on node(s) "
+                                << ToString(suspected);
+        }
+        return missingChildren & ~m_InteriorNodes;
+    }
+
+    void SoftwareSyncApi::FallBackToAllToAll()
+    {
+        // Remarks: Our next Arrive (multicast) makes the other nodes fall back as well.
+        m_Algorithm = BarrierAlgorithm::AllToAll;
+        m_ActiveNodes = m_Config.nodes;
+        m_Arrived.reset();
+        m_Arrived.set(m_Config.nodeId);
+        m_ArrivedNext.reset();
+        m_SuspectedNodes.reset();
+        m_ReleaseTimes[0].Reset();
+        m_ReleaseTimes[1].Reset();
+    }
+
+    void SoftwareSyncApi::OnReleased(const Clock::time_point releaseTime)
+    {
+        m_ReleaseCount.fetch_add(1, std::memory_order_relaxed);
+
+        // Every node sent the release time of the previous generation with its arrival to this generation.
+        // With Tree and Dissemination they were combined along the way (so only known by the root with Tree).
+        auto& previousReleaseTimes = m_ReleaseTimes[(m_Generation - 1) & 1];
+        const bool allReleaseTimes = m_Algorithm == BarrierAlgorithm::AllToAll ?
+            (m_ActiveNodes & ~previousReleaseTimes.received).none() :
+            m_Complete && previousReleaseTimes.received.any() && !previousReleaseTimes.incomplete;
+        if (allReleaseTimes)
+        {
+            m_ReleaseSkewStatistics.Record((previousReleaseTimes.maxNs - previousReleaseTimes.minNs) / 1000);
+        }
+        previousReleaseTimes.Reset();
+
+        m_PreviousReleaseTimeNs = ToNanoseconds(releaseTime);
+        if (m_Algorithm == BarrierAlgorithm::AllToAll)
+        {
+            m_ReleaseTimes[m_Generation & 1].Add(m_Config.nodeId, m_PreviousReleaseTimeNs);
+        }
+    }
+
+    void SoftwareSyncApi::ReleaseTimes::Add(const uint8_t nodeId, const uint64_t releaseTimeNs)
+    {
+        if (releaseTimeNs == 0)
+        {
+            return;
+        }
+        if (received.none())
+        {
+            minNs = releaseTimeNs;
+            maxNs = releaseTimeNs;
+        }
+        else
+        {
+            minNs = std::min(minNs, releaseTimeNs);
+            maxNs = std::max(maxNs, releaseTimeNs);
+        }
+        received.set(nodeId);
+    }
+
+    void SoftwareSyncApi::ReleaseTimes::Merge(const uint8_t nodeId, const uint64_t otherMinNs,
+        const uint64_t otherMaxNs)
+    {
+        if (otherMinNs == 0)
+        {
+            incomplete = true;
+            return;
+        }
+        if (received.none())
+        {
+            minNs = otherMinNs;
+            maxNs = otherMaxNs;
+        }
+        else
+        {
+            minNs = std::min(minNs, otherMinNs);
+            maxNs = std::max(maxNs, otherMaxNs);
+        }
+        received.set(nodeId);
+    }
+
+    void SoftwareSyncApi::ReleaseTimes::Reset()
+    {
+        received.reset();
+        minNs = 0;
+        maxNs = 0;
+        incomplete = false;
+    }
+}
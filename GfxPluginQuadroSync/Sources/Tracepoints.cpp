@@ -0,0 +1,35 @@
+#include "Tracepoints.h"
+
+#if defined(_WIN32) && !defined(QUADROSYNC_USDT)
+// {8c84e33f-eeb2-5b3b-0600-643ac053846f}, hashed from the name (like EventSource does) so that tools can also enable
+// the provider as "*Unity.ClusterDisplay.GfxPluginQuadroSync".
+TRACELOGGING_DEFINE_PROVIDER(g_GfxQuadroSyncTraceLoggingProvider, "Unity.ClusterDisplay.GfxPluginQuadroSync",
+    (0x8c84e33f, 0xeeb2, 0x5b3b, 0x06, 0x00, 0x64, 0x3a, 0xc0, 0x53, 0x84, 0x6f));
+
+// Remarks: Registering a provider that is already registered is an error.
+static bool s_TraceLoggingProviderRegistered = false;
+#endif
+
+namespace GfxQuadroSync
+{
+    void RegisterTracepoints()
+    {
+#if defined(_WIN32) && !defined(QUADROSYNC_USDT)
+        if (!s_TraceLoggingProviderRegistered)
+        {
+            s_TraceLoggingProviderRegistered = SUCCEEDED(TraceLoggingRegister(g_GfxQuadroSyncTraceLoggingProvider));
+        }
+#endif
+    }
+
+    void UnregisterTracepoints()
+    {
+#if defined(_WIN32) && !defined(QUADROSYNC_USDT)
+        if (s_TraceLoggingProviderRegistered)
+        {
+            TraceLoggingUnregister(g_GfxQuadroSyncTraceLoggingProvider);
+            s_TraceLoggingProviderRegistered = false;
+        }
+#endif
+    }
+}
@@ -0,0 +1,181 @@
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "UdpSocket.h"
+#include "Logger.h"
+
+#include <cstring>
+#include <type_traits>
+
+namespace GfxQuadroSync
+{
+    namespace
+    {
+#ifdef _WIN32
+        int GetLastSocketError() { return WSAGetLastError(); }
+        void CloseSocket(const SOCKET socket) { closesocket(socket); }
+
+        bool InitializeSockets()
+        {
+            static const bool s_Initialized = []()
+            {
+                WSADATA wsaData;
+                return WSAStartup(MAKEWORD(2, 2), &wsaData) == 0;
+            }();
+            return s_Initialized;
+        }
+#else
+        int GetLastSocketError() { return errno; }
+        void CloseSocket(const int socket) { close(socket); }
+        bool InitializeSockets() { return true; }
+#endif
+
+        template<typename T>
+        bool SetSocketOption(const decltype(socket(0, 0, 0)) socketHandle, const int level, const int option,
+            const T& value)
+        {
+            return setsockopt(socketHandle, level, option, reinterpret_cast<const char*>(&value), sizeof(value)) == 0;
+        }
+    }
+
+    static_assert(sizeof(sockaddr_in) <= 16, "sockaddr_in does not fit in UdpSocket::m_Destination");
+
+    UdpSocket::~UdpSocket()
+    {
+        Close();
+    }
+
+    bool UdpSocket::OpenMulticast(const std::string& multicastAddress, const uint16_t port,
+        const std::string& adapterAddress)
+    {
+        Close();
+        if (!InitializeSockets())
+        {
+            CLUSTER_LOG_ERROR << "Failed to initialize sockets";
+            return false;
+        }
+
+        in_addr multicastInAddr{};
+        in_addr adapterInAddr{};
+        adapterInAddr.s_addr = htonl(INADDR_ANY);
+        if (inet_pton(AF_INET, multicastAddress.c_str(), &multicastInAddr) != 1 ||
+            (!adapterAddress.empty() && inet_pton(AF_INET, adapterAddress.c_str(), &adapterInAddr) != 1))
+        {
+            CLUSTER_LOG_ERROR << "Invalid multicast (" << multicastAddress << ") or adapter (" << adapterAddress
+                              << ") address";
+            return false;
+        }
+
+        const auto socketHandle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (socketHandle == static_cast<std::decay_t<decltype(socketHandle)>>(k_InvalidSocket))
+        {
+            CLUSTER_LOG_ERROR << "Failed to create socket: " << GetLastSocketError();
+            return false;
+        }
+
+        const int reuseAddress = 1;
+        const unsigned char timeToLive = 1;
+        const unsigned char loopback = 1;
+        sockaddr_in bindAddress{};
+        bindAddress.sin_family = AF_INET;
+        bindAddress.sin_port = htons(port);
+#ifdef _WIN32
+        // Same as the managed UdpAgent, bind on the adapter.
+        bindAddress.sin_addr = adapterInAddr;
+#else
+        // Binding on the adapter address would filter out multicast datagrams on posix systems.
+        bindAddress.sin_addr.s_addr = htonl(INADDR_ANY);
+#endif
+        ip_mreq membership{};
+        membership.imr_multiaddr = multicastInAddr;
+        membership.imr_interface = adapterInAddr;
+
+        if (!SetSocketOption(socketHandle, SOL_SOCKET, SO_REUSEADDR, reuseAddress) ||
+            !SetSocketOption(socketHandle, IPPROTO_IP, IP_MULTICAST_IF, adapterInAddr) ||
+            !SetSocketOption(socketHandle, IPPROTO_IP, IP_MULTICAST_TTL, timeToLive) ||
+            !SetSocketOption(socketHandle, IPPROTO_IP, IP_MULTICAST_LOOP, loopback) ||
+            bind(socketHandle, reinterpret_cast<const sockaddr*>(&bindAddress), sizeof(bindAddress)) != 0 ||
+            !SetSocketOption(socketHandle, IPPROTO_IP, IP_ADD_MEMBERSHIP, membership))
+        {
+            CLUSTER_LOG_ERROR << "Failed to setup multicast socket on " << multicastAddress << ':' << port << ": "
+                              << GetLastSocketError();
+            CloseSocket(socketHandle);
+            return false;
+        }
+
+        sockaddr_in destination{};
+        destination.sin_family = AF_INET;
+        destination.sin_port = htons(port);
+        destination.sin_addr = multicastInAddr;
+        memcpy(m_Destination, &destination, sizeof(destination));
+        m_Socket = static_cast<SocketHandle>(socketHandle);
+        return true;
+    }
+
+    void UdpSocket::Close()
+    {
+        if (m_Socket != k_InvalidSocket)
+        {
+            CloseSocket(m_Socket);
+            m_Socket = k_InvalidSocket;
+        }
+    }
+
+    bool UdpSocket::Send(const void* const data, const size_t size)
+    {
+        if (m_Socket == k_InvalidSocket)
+        {
+            return false;
+        }
+        const auto sent = sendto(m_Socket, static_cast<const char*>(data), static_cast<int>(size), 0,
+            reinterpret_cast<const sockaddr*>(m_Destination), sizeof(sockaddr_in));
+        return sent == static_cast<std::decay_t<decltype(sent)>>(size);
+    }
+
+    int UdpSocket::Receive(void* const buffer, const size_t size, const std::chrono::microseconds timeout)
+    {
+        if (m_Socket == k_InvalidSocket)
+        {
+            return -1;
+        }
+
+        const auto timeoutMs = static_cast<int>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(timeout + std::chrono::microseconds(999)).count());
+#ifdef _WIN32
+        WSAPOLLFD pollFd{};
+        pollFd.fd = m_Socket;
+        pollFd.events = POLLRDNORM;
+        const int pollResult = WSAPoll(&pollFd, 1, timeoutMs);
+#else
+        pollfd pollFd{};
+        pollFd.fd = m_Socket;
+        pollFd.events = POLLIN;
+        const int pollResult = poll(&pollFd, 1, timeoutMs);
+        if (pollResult < 0 && errno == EINTR)
+        {
+            return 0;
+        }
+#endif
+        if (pollResult < 0)
+        {
+            return -1;
+        }
+        if (pollResult == 0)
+        {
+            return 0;
+        }
+
+        const auto received = recv(m_Socket, static_cast<char*>(buffer), static_cast<int>(size), 0);
+        return received < 0 ? -1 : static_cast<int>(received);
+    }
+}
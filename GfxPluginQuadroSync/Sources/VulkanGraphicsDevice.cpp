@@ -0,0 +1,492 @@
+#include "VulkanGraphicsDevice.h"
+#include "Logger.h"
+
+#include <cstdint>
+#include <exception>
+
+namespace GfxQuadroSync
+{
+    namespace
+    {
+        template <typename FunctionType>
+        bool LoadFunction(const PFN_vkVoidFunction function, const char* const name, FunctionType& loaded)
+        {
+            loaded = reinterpret_cast<FunctionType>(function);
+            if (loaded == nullptr)
+            {
+                CLUSTER_LOG_ERROR << "VulkanGraphicsDevice: failed to get " << name;
+                return false;
+            }
+            return true;
+        }
+
+        void CheckResult(const VkResult result, const char* const operation)
+        {
+            if (result != VK_SUCCESS)
+            {
+                CLUSTER_LOG_ERROR << operation << " failed: " << result;
+                throw std::exception();
+            }
+        }
+
+        VkImageMemoryBarrier MakeImageBarrier(const VkImage image, const VkImageLayout oldLayout,
+            const VkImageLayout newLayout, const VkAccessFlags srcAccessMask, const VkAccessFlags dstAccessMask)
+        {
+            VkImageMemoryBarrier barrier = {};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.srcAccessMask = srcAccessMask;
+            barrier.dstAccessMask = dstAccessMask;
+            barrier.oldLayout = oldLayout;
+            barrier.newLayout = newLayout;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = image;
+            barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+            return barrier;
+        }
+    }
+
+    VulkanGraphicsDevice::VulkanGraphicsDevice(
+        const VkInstance instance,
+        const VkPhysicalDevice physicalDevice,
+        const VkDevice device,
+        const VkQueue queue,
+        const uint32_t queueFamilyIndex,
+        const PFN_vkGetInstanceProcAddr getInstanceProcAddr)
+        : m_PhysicalDevice(physicalDevice)
+        , m_Device(device)
+        , m_Queue(queue)
+        , m_QueueFamilyIndex(queueFamilyIndex)
+    {
+        auto& functions = m_Functions;
+        bool loaded = LoadFunction(getInstanceProcAddr(instance, "vkGetPhysicalDeviceMemoryProperties"),
+            "vkGetPhysicalDeviceMemoryProperties", functions.vkGetPhysicalDeviceMemoryProperties);
+        loaded = LoadFunction(getInstanceProcAddr(instance, "vkGetDeviceProcAddr"), "vkGetDeviceProcAddr",
+            functions.vkGetDeviceProcAddr) && loaded;
+        if (functions.vkGetDeviceProcAddr != nullptr)
+        {
+            const auto loadDeviceFunction = [this, &loaded](const char* const name, auto& function)
+            {
+                loaded = LoadFunction(m_Functions.vkGetDeviceProcAddr(m_Device, name), name, function) && loaded;
+            };
+            loadDeviceFunction("vkDeviceWaitIdle", functions.vkDeviceWaitIdle);
+            loadDeviceFunction("vkQueueSubmit", functions.vkQueueSubmit);
+            loadDeviceFunction("vkQueuePresentKHR", functions.vkQueuePresentKHR);
+            loadDeviceFunction("vkAcquireNextImageKHR", functions.vkAcquireNextImageKHR);
+            loadDeviceFunction("vkGetSwapchainImagesKHR", functions.vkGetSwapchainImagesKHR);
+            loadDeviceFunction("vkCreateCommandPool", functions.vkCreateCommandPool);
+            loadDeviceFunction("vkDestroyCommandPool", functions.vkDestroyCommandPool);
+            loadDeviceFunction("vkAllocateCommandBuffers", functions.vkAllocateCommandBuffers);
+            loadDeviceFunction("vkBeginCommandBuffer", functions.vkBeginCommandBuffer);
+            loadDeviceFunction("vkEndCommandBuffer", functions.vkEndCommandBuffer);
+            loadDeviceFunction("vkCmdPipelineBarrier", functions.vkCmdPipelineBarrier);
+            loadDeviceFunction("vkCmdCopyImage", functions.vkCmdCopyImage);
+            loadDeviceFunction("vkCreateImage", functions.vkCreateImage);
+            loadDeviceFunction("vkDestroyImage", functions.vkDestroyImage);
+            loadDeviceFunction("vkGetImageMemoryRequirements", functions.vkGetImageMemoryRequirements);
+            loadDeviceFunction("vkAllocateMemory", functions.vkAllocateMemory);
+            loadDeviceFunction("vkFreeMemory", functions.vkFreeMemory);
+            loadDeviceFunction("vkBindImageMemory", functions.vkBindImageMemory);
+            loadDeviceFunction("vkCreateSemaphore", functions.vkCreateSemaphore);
+            loadDeviceFunction("vkDestroySemaphore", functions.vkDestroySemaphore);
+            loadDeviceFunction("vkCreateFence", functions.vkCreateFence);
+            loadDeviceFunction("vkDestroyFence", functions.vkDestroyFence);
+            loadDeviceFunction("vkWaitForFences", functions.vkWaitForFences);
+            loadDeviceFunction("vkResetFences", functions.vkResetFences);
+        }
+
+        if (!loaded)
+        {
+            // Remarks: GetDevice returning nullptr will make the plugin report the device as missing.
+            m_Device = VK_NULL_HANDLE;
+        }
+    }
+
+    VulkanGraphicsDevice::~VulkanGraphicsDevice()
+    {
+        FreeRepeatResources();
+    }
+
+    IDXGISwapChain* VulkanGraphicsDevice::GetSwapChain() const
+    {
+        // Remarks: VkSwapchainKHR is a pointer on 64 bits platforms and an uint64_t on 32 bits platforms, both can be
+        // reinterpret_cast to a pointer.
+        return reinterpret_cast<IDXGISwapChain*>(m_Swapchain.swapchain);
+    }
+
+    void VulkanGraphicsDevice::SetSwapchain(const Swapchain& swapchain)
+    {
+        if (swapchain.swapchain != m_Swapchain.swapchain)
+        {
+            FreeRepeatResources();
+            m_PendingPresentQueue = VK_NULL_HANDLE;
+        }
+        m_Swapchain = swapchain;
+    }
+
+    bool VulkanGraphicsDevice::SetPendingPresent(const VkQueue queue, const VkPresentInfoKHR& presentInfo)
+    {
+        if (m_Device == VK_NULL_HANDLE || m_Swapchain.swapchain == VK_NULL_HANDLE || presentInfo.swapchainCount != 1 ||
+            presentInfo.pSwapchains[0] != m_Swapchain.swapchain)
+        {
+            return false;
+        }
+
+        // Remarks: presentInfo.pNext is not kept, chained structures are only valid until the intercepted
+        // vkQueuePresentKHR returns while the present might be repeated later.
+        m_PendingPresentQueue = queue;
+        m_PendingImageIndex = presentInfo.pImageIndices[0];
+        m_PendingWaitSemaphores.assign(presentInfo.pWaitSemaphores,
+            presentInfo.pWaitSemaphores + presentInfo.waitSemaphoreCount);
+        return true;
+    }
+
+    bool VulkanGraphicsDevice::Present()
+    {
+        if (!HasPendingPresent())
+        {
+            CLUSTER_LOG_ERROR << "VulkanGraphicsDevice::Present: nothing to present";
+            return false;
+        }
+
+        VkPresentInfoKHR presentInfo = {};
+        presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+        presentInfo.waitSemaphoreCount = static_cast<uint32_t>(m_PendingWaitSemaphores.size());
+        presentInfo.pWaitSemaphores = m_PendingWaitSemaphores.data();
+        presentInfo.swapchainCount = 1;
+        presentInfo.pSwapchains = &m_Swapchain.swapchain;
+        presentInfo.pImageIndices = &m_PendingImageIndex;
+
+        const auto queue = m_PendingPresentQueue;
+        m_PendingPresentQueue = VK_NULL_HANDLE;
+        m_LastPresentResult = m_Functions.vkQueuePresentKHR(queue, &presentInfo);
+
+        // Remarks: Out of date swap chains are recreated by Unity (once it sees the result of the present).
+        if (m_LastPresentResult < 0 && m_LastPresentResult != VK_ERROR_OUT_OF_DATE_KHR)
+        {
+            CLUSTER_LOG_ERROR << "vkQueuePresentKHR failed: " << m_LastPresentResult;
+            return false;
+        }
+        return true;
+    }
+
+    void VulkanGraphicsDevice::InitiatePresentRepeats()
+    {
+        if (!HasPendingPresent())
+        {
+            return;
+        }
+
+        constexpr VkImageUsageFlags copyUsage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        if ((m_Swapchain.usage & copyUsage) != copyUsage)
+        {
+            if (!m_MissingTransferUsageLogged)
+            {
+                CLUSTER_LOG_ERROR << "VulkanGraphicsDevice: images of the swap chain cannot be copied, presents will "
+                    << "not be repeated";
+                m_MissingTransferUsageLogged = true;
+            }
+            return;
+        }
+
+        if (!AreRepeatResourcesCreated())
+        {
+            try
+            {
+                CreateRepeatResources();
+            }
+            catch (const std::exception&)
+            {
+                FreeRepeatResources();
+                return;
+            }
+        }
+
+        // Copy the image to present (once rendered) to the image we will repeat, the present then waits on that copy.
+        WaitForFence();
+        const auto imageIndex = m_PendingImageIndex;
+        if (Submit(m_SaveCommandBuffers[imageIndex], static_cast<uint32_t>(m_PendingWaitSemaphores.size()),
+            m_PendingWaitSemaphores.data(), m_PresentReadySemaphores[imageIndex]))
+        {
+            m_PendingWaitSemaphores.assign(1, m_PresentReadySemaphores[imageIndex]);
+        }
+    }
+
+    void VulkanGraphicsDevice::PrepareSinglePresentRepeat()
+    {
+        if (!AreRepeatResourcesCreated())
+        {
+            return;
+        }
+
+        // Remarks: m_AcquireSemaphore can only be reused once the copy waiting on it is done.
+        WaitForFence();
+
+        uint32_t imageIndex = 0;
+        const auto result = m_Functions.vkAcquireNextImageKHR(m_Device, m_Swapchain.swapchain, UINT64_MAX,
+            m_AcquireSemaphore, VK_NULL_HANDLE, &imageIndex);
+        if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR)
+        {
+            CLUSTER_LOG_ERROR << "vkAcquireNextImageKHR failed: " << result;
+            return;
+        }
+
+        if (Submit(m_RestoreCommandBuffers[imageIndex], 1, &m_AcquireSemaphore, m_PresentReadySemaphores[imageIndex]))
+        {
+            m_PendingPresentQueue = m_Queue;
+            m_PendingImageIndex = imageIndex;
+            m_PendingWaitSemaphores.assign(1, m_PresentReadySemaphores[imageIndex]);
+        }
+    }
+
+    void VulkanGraphicsDevice::ConcludePresentRepeats()
+    {
+        // Remarks: Unlike IDXGISwapChain3::GetCurrentBackBufferIndex, vkAcquireNextImageKHR tells Unity which image to
+        // render to, so there is no need to realign anything with the images we acquired.
+        FreeRepeatResources();
+    }
+
+    void VulkanGraphicsDevice::CreateRepeatResources()
+    {
+        auto& functions = m_Functions;
+
+        uint32_t imageCount = 0;
+        CheckResult(functions.vkGetSwapchainImagesKHR(m_Device, m_Swapchain.swapchain, &imageCount, nullptr),
+            "vkGetSwapchainImagesKHR");
+        m_SwapchainImages.resize(imageCount);
+        CheckResult(functions.vkGetSwapchainImagesKHR(m_Device, m_Swapchain.swapchain, &imageCount,
+            m_SwapchainImages.data()), "vkGetSwapchainImagesKHR");
+        m_SwapchainImages.resize(imageCount);
+
+        // Image to repeat
+        VkImageCreateInfo imageCreateInfo = {};
+        imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageCreateInfo.format = m_Swapchain.format;
+        imageCreateInfo.extent = {m_Swapchain.extent.width, m_Swapchain.extent.height, 1};
+        imageCreateInfo.mipLevels = 1;
+        imageCreateInfo.arrayLayers = 1;
+        imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageCreateInfo.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        CheckResult(functions.vkCreateImage(m_Device, &imageCreateInfo, nullptr, &m_SavedImage), "vkCreateImage");
+
+        VkMemoryRequirements memoryRequirements;
+        functions.vkGetImageMemoryRequirements(m_Device, m_SavedImage, &memoryRequirements);
+        VkPhysicalDeviceMemoryProperties memoryProperties;
+        functions.vkGetPhysicalDeviceMemoryProperties(m_PhysicalDevice, &memoryProperties);
+        uint32_t memoryTypeIndex = UINT32_MAX;
+        for (uint32_t typeIndex = 0; typeIndex < memoryProperties.memoryTypeCount; ++typeIndex)
+        {
+            if ((memoryRequirements.memoryTypeBits & (1u << typeIndex)) == 0)
+            {
+                continue;
+            }
+            if (memoryTypeIndex == UINT32_MAX || (memoryProperties.memoryTypes[typeIndex].propertyFlags &
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) != 0)
+            {
+                memoryTypeIndex = typeIndex;
+                if ((memoryProperties.memoryTypes[typeIndex].propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) != 0)
+                {
+                    break;
+                }
+            }
+        }
+        if (memoryTypeIndex == UINT32_MAX)
+        {
+            CLUSTER_LOG_ERROR << "VulkanGraphicsDevice: no memory type for the image to repeat";
+            throw std::exception();
+        }
+
+        VkMemoryAllocateInfo allocateInfo = {};
+        allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocateInfo.allocationSize = memoryRequirements.size;
+        allocateInfo.memoryTypeIndex = memoryTypeIndex;
+        CheckResult(functions.vkAllocateMemory(m_Device, &allocateInfo, nullptr, &m_SavedImageMemory),
+            "vkAllocateMemory");
+        CheckResult(functions.vkBindImageMemory(m_Device, m_SavedImage, m_SavedImageMemory, 0), "vkBindImageMemory");
+
+        // Copy command buffers (recorded once, they are the same every time)
+        VkCommandPoolCreateInfo commandPoolCreateInfo = {};
+        commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        commandPoolCreateInfo.queueFamilyIndex = m_QueueFamilyIndex;
+        CheckResult(functions.vkCreateCommandPool(m_Device, &commandPoolCreateInfo, nullptr, &m_CommandPool),
+            "vkCreateCommandPool");
+
+        std::vector<VkCommandBuffer> commandBuffers(imageCount * 2);
+        VkCommandBufferAllocateInfo commandBufferAllocateInfo = {};
+        commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        commandBufferAllocateInfo.commandPool = m_CommandPool;
+        commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        commandBufferAllocateInfo.commandBufferCount = static_cast<uint32_t>(commandBuffers.size());
+        CheckResult(functions.vkAllocateCommandBuffers(m_Device, &commandBufferAllocateInfo, commandBuffers.data()),
+            "vkAllocateCommandBuffers");
+        m_SaveCommandBuffers.assign(commandBuffers.begin(), commandBuffers.begin() + imageCount);
+        m_RestoreCommandBuffers.assign(commandBuffers.begin() + imageCount, commandBuffers.end());
+        for (uint32_t imageIndex = 0; imageIndex < imageCount; ++imageIndex)
+        {
+            RecordCopy(m_SaveCommandBuffers[imageIndex], m_SwapchainImages[imageIndex], true);
+            RecordCopy(m_RestoreCommandBuffers[imageIndex], m_SwapchainImages[imageIndex], false);
+        }
+
+        // Synchronization
+        VkSemaphoreCreateInfo semaphoreCreateInfo = {};
+        semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        m_PresentReadySemaphores.resize(imageCount, VK_NULL_HANDLE);
+        for (auto& semaphore : m_PresentReadySemaphores)
+        {
+            CheckResult(functions.vkCreateSemaphore(m_Device, &semaphoreCreateInfo, nullptr, &semaphore),
+                "vkCreateSemaphore");
+        }
+        CheckResult(functions.vkCreateSemaphore(m_Device, &semaphoreCreateInfo, nullptr, &m_AcquireSemaphore),
+            "vkCreateSemaphore");
+
+        VkFenceCreateInfo fenceCreateInfo = {};
+        fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        CheckResult(functions.vkCreateFence(m_Device, &fenceCreateInfo, nullptr, &m_CopyDoneFence), "vkCreateFence");
+    }
+
+    void VulkanGraphicsDevice::RecordCopy(const VkCommandBuffer commandBuffer, const VkImage swapchainImage,
+        const bool toSavedImage)
+    {
+        auto& functions = m_Functions;
+
+        VkCommandBufferBeginInfo beginInfo = {};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        CheckResult(functions.vkBeginCommandBuffer(commandBuffer, &beginInfo), "vkBeginCommandBuffer");
+
+        // Remarks: Source stage of the first barrier is the stage at which the submit waits on its semaphores.
+        VkImageMemoryBarrier preCopyBarriers[2];
+        uint32_t preCopyBarrierCount = 0;
+        VkImageMemoryBarrier postCopyBarriers[2];
+        uint32_t postCopyBarrierCount = 0;
+        if (toSavedImage)
+        {
+            preCopyBarriers[preCopyBarrierCount++] = MakeImageBarrier(swapchainImage, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, 0, VK_ACCESS_TRANSFER_READ_BIT);
+            preCopyBarriers[preCopyBarrierCount++] = MakeImageBarrier(m_SavedImage, VK_IMAGE_LAYOUT_UNDEFINED,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0, VK_ACCESS_TRANSFER_WRITE_BIT);
+            postCopyBarriers[postCopyBarrierCount++] = MakeImageBarrier(swapchainImage,
+                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, 0, 0);
+            postCopyBarriers[postCopyBarrierCount++] = MakeImageBarrier(m_SavedImage,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+        }
+        else
+        {
+            // Remarks: Content of the acquired image does not matter since it is entirely overwritten.
+            preCopyBarriers[preCopyBarrierCount++] = MakeImageBarrier(swapchainImage, VK_IMAGE_LAYOUT_UNDEFINED,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0, VK_ACCESS_TRANSFER_WRITE_BIT);
+            postCopyBarriers[postCopyBarrierCount++] = MakeImageBarrier(swapchainImage,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, VK_ACCESS_TRANSFER_WRITE_BIT, 0);
+        }
+
+        functions.vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0, 0, nullptr, 0, nullptr, preCopyBarrierCount, preCopyBarriers);
+
+        VkImageCopy region = {};
+        region.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        region.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        region.extent = {m_Swapchain.extent.width, m_Swapchain.extent.height, 1};
+        functions.vkCmdCopyImage(commandBuffer,
+            toSavedImage ? swapchainImage : m_SavedImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            toSavedImage ? m_SavedImage : swapchainImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+        functions.vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0, 0, nullptr, 0, nullptr, postCopyBarrierCount, postCopyBarriers);
+
+        CheckResult(functions.vkEndCommandBuffer(commandBuffer), "vkEndCommandBuffer");
+    }
+
+    bool VulkanGraphicsDevice::Submit(const VkCommandBuffer commandBuffer, const uint32_t waitSemaphoreCount,
+        const VkSemaphore* const waitSemaphores, const VkSemaphore signalSemaphore)
+    {
+        const std::vector<VkPipelineStageFlags> waitStages(waitSemaphoreCount, VK_PIPELINE_STAGE_TRANSFER_BIT);
+        VkSubmitInfo submitInfo = {};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.waitSemaphoreCount = waitSemaphoreCount;
+        submitInfo.pWaitSemaphores = waitSemaphores;
+        submitInfo.pWaitDstStageMask = waitStages.data();
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &commandBuffer;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = &signalSemaphore;
+        const auto result = m_Functions.vkQueueSubmit(m_Queue, 1, &submitInfo, m_CopyDoneFence);
+        if (result != VK_SUCCESS)
+        {
+            CLUSTER_LOG_ERROR << "vkQueueSubmit failed to submit the copy of the image to repeat: " << result;
+            return false;
+        }
+        m_CopyPending = true;
+        return true;
+    }
+
+    void VulkanGraphicsDevice::WaitForFence()
+    {
+        if (!m_CopyPending)
+        {
+            return;
+        }
+
+        const auto result = m_Functions.vkWaitForFences(m_Device, 1, &m_CopyDoneFence, VK_TRUE, UINT64_MAX);
+        if (result != VK_SUCCESS)
+        {
+            CLUSTER_LOG_WARNING << "vkWaitForFences failed: " << result;
+        }
+        m_Functions.vkResetFences(m_Device, 1, &m_CopyDoneFence);
+        m_CopyPending = false;
+    }
+
+    void VulkanGraphicsDevice::FreeRepeatResources()
+    {
+        if (m_Device == VK_NULL_HANDLE || (m_SavedImage == VK_NULL_HANDLE && m_SwapchainImages.empty()))
+        {
+            return;
+        }
+
+        // Remarks: Presents that might still be waiting on our semaphores are not tracked by any fence, so wait on
+        // everything.  Not a problem since it is only done once the barrier is warmed up.
+        m_Functions.vkDeviceWaitIdle(m_Device);
+        m_CopyPending = false;
+
+        if (m_CopyDoneFence != VK_NULL_HANDLE)
+        {
+            m_Functions.vkDestroyFence(m_Device, m_CopyDoneFence, nullptr);
+            m_CopyDoneFence = VK_NULL_HANDLE;
+        }
+        if (m_AcquireSemaphore != VK_NULL_HANDLE)
+        {
+            m_Functions.vkDestroySemaphore(m_Device, m_AcquireSemaphore, nullptr);
+            m_AcquireSemaphore = VK_NULL_HANDLE;
+        }
+        for (const auto semaphore : m_PresentReadySemaphores)
+        {
+            if (semaphore != VK_NULL_HANDLE)
+            {
+                m_Functions.vkDestroySemaphore(m_Device, semaphore, nullptr);
+            }
+        }
+        m_PresentReadySemaphores.clear();
+        if (m_CommandPool != VK_NULL_HANDLE)
+        {
+            // Remarks: Also frees the command buffers allocated from it.
+            m_Functions.vkDestroyCommandPool(m_Device, m_CommandPool, nullptr);
+            m_CommandPool = VK_NULL_HANDLE;
+        }
+        m_SaveCommandBuffers.clear();
+        m_RestoreCommandBuffers.clear();
+        if (m_SavedImage != VK_NULL_HANDLE)
+        {
+            m_Functions.vkDestroyImage(m_Device, m_SavedImage, nullptr);
+            m_SavedImage = VK_NULL_HANDLE;
+        }
+        if (m_SavedImageMemory != VK_NULL_HANDLE)
+        {
+            m_Functions.vkFreeMemory(m_Device, m_SavedImageMemory, nullptr);
+            m_SavedImageMemory = VK_NULL_HANDLE;
+        }
+        m_SwapchainImages.clear();
+    }
+}
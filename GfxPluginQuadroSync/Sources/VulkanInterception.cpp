@@ -0,0 +1,370 @@
+#include "VulkanInterception.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace GfxQuadroSync
+{
+    namespace
+    {
+        constexpr const char* k_SurfaceCapabilities2ExtensionName = "VK_KHR_get_surface_capabilities2";
+        constexpr const char* k_PhysicalDeviceProperties2ExtensionName = "VK_KHR_get_physical_device_properties2";
+
+        /// vkGetInstanceProcAddr of the Vulkan loader (from which we get the functions we intercept).
+        PFN_vkGetInstanceProcAddr s_GetInstanceProcAddr = nullptr;
+        VulkanPresentHandler s_PresentHandler = nullptr;
+
+        // Remarks: Set while Unity creates its instance and device (before any present).
+        VkInstance s_Instance = VK_NULL_HANDLE;
+        bool s_SurfaceCapabilities2Enabled = false;
+        VkPhysicalDevice s_PhysicalDevice = VK_NULL_HANDLE;
+        bool s_PresentBarrierEnabled = false;
+        bool s_DeviceCreated = false;
+        PFN_vkGetDeviceProcAddr s_GetDeviceProcAddr = nullptr;
+        PFN_vkCreateSwapchainKHR s_CreateSwapchain = nullptr;
+        PFN_vkDestroySwapchainKHR s_DestroySwapchain = nullptr;
+        PFN_vkQueuePresentKHR s_QueuePresent = nullptr;
+
+        // Remarks: Swap chains could be created from any thread.
+        std::mutex s_SwapchainsLock;
+        std::vector<VulkanGraphicsDevice::Swapchain> s_Swapchains;
+
+        template <typename FunctionType>
+        FunctionType GetInstanceFunction(const char* const name)
+        {
+            return reinterpret_cast<FunctionType>(s_GetInstanceProcAddr(s_Instance, name));
+        }
+
+        bool ContainsExtension(const std::vector<const char*>& extensions, const char* const name)
+        {
+            return std::any_of(extensions.begin(), extensions.end(),
+                [name](const char* const extension) { return strcmp(extension, name) == 0; });
+        }
+
+        bool IsInstanceExtensionSupported(const char* const name)
+        {
+            const auto enumerateExtensions = reinterpret_cast<PFN_vkEnumerateInstanceExtensionProperties>(
+                s_GetInstanceProcAddr(VK_NULL_HANDLE, "vkEnumerateInstanceExtensionProperties"));
+            uint32_t extensionCount = 0;
+            if (enumerateExtensions == nullptr ||
+                enumerateExtensions(nullptr, &extensionCount, nullptr) != VK_SUCCESS)
+            {
+                return false;
+            }
+            std::vector<VkExtensionProperties> extensions(extensionCount);
+            enumerateExtensions(nullptr, &extensionCount, extensions.data());
+            return std::any_of(extensions.begin(), extensions.begin() + extensionCount,
+                [name](const VkExtensionProperties& extension) { return strcmp(extension.extensionName, name) == 0; });
+        }
+
+        bool IsPresentBarrierSupported(const VkPhysicalDevice physicalDevice)
+        {
+#ifdef VK_NV_present_barrier
+            // Remarks: VK_NV_present_barrier requires VK_KHR_get_surface_capabilities2 on the instance.
+            if (!s_SurfaceCapabilities2Enabled)
+            {
+                return false;
+            }
+
+            const auto enumerateExtensions = GetInstanceFunction<PFN_vkEnumerateDeviceExtensionProperties>(
+                "vkEnumerateDeviceExtensionProperties");
+            uint32_t extensionCount = 0;
+            if (enumerateExtensions == nullptr ||
+                enumerateExtensions(physicalDevice, nullptr, &extensionCount, nullptr) != VK_SUCCESS)
+            {
+                return false;
+            }
+            std::vector<VkExtensionProperties> extensions(extensionCount);
+            enumerateExtensions(physicalDevice, nullptr, &extensionCount, extensions.data());
+            if (std::none_of(extensions.begin(), extensions.begin() + extensionCount,
+                [](const VkExtensionProperties& extension)
+                { return strcmp(extension.extensionName, VK_NV_PRESENT_BARRIER_EXTENSION_NAME) == 0; }))
+            {
+                return false;
+            }
+
+            auto getFeatures2 = GetInstanceFunction<PFN_vkGetPhysicalDeviceFeatures2>("vkGetPhysicalDeviceFeatures2");
+            if (getFeatures2 == nullptr)
+            {
+                getFeatures2 = GetInstanceFunction<PFN_vkGetPhysicalDeviceFeatures2>(
+                    "vkGetPhysicalDeviceFeatures2KHR");
+            }
+            if (getFeatures2 == nullptr)
+            {
+                return false;
+            }
+            VkPhysicalDevicePresentBarrierFeaturesNV presentBarrierFeatures = {};
+            presentBarrierFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_BARRIER_FEATURES_NV;
+            VkPhysicalDeviceFeatures2 features = {};
+            features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features.pNext = &presentBarrierFeatures;
+            getFeatures2(physicalDevice, &features);
+            return presentBarrierFeatures.presentBarrier == VK_TRUE;
+#else
+            (void)physicalDevice;
+            return false;
+#endif
+        }
+
+        VKAPI_ATTR VkResult VKAPI_CALL CreateInstance(const VkInstanceCreateInfo* const pCreateInfo,
+            const VkAllocationCallbacks* const pAllocator, VkInstance* const pInstance)
+        {
+            const auto createInstance = reinterpret_cast<PFN_vkCreateInstance>(
+                s_GetInstanceProcAddr(VK_NULL_HANDLE, "vkCreateInstance"));
+
+            // Enable what VK_NV_present_barrier depends on (if not already enabled by Unity).
+            std::vector<const char*> extensions(pCreateInfo->ppEnabledExtensionNames,
+                pCreateInfo->ppEnabledExtensionNames + pCreateInfo->enabledExtensionCount);
+            const auto originalExtensionCount = extensions.size();
+            for (const auto name : {k_SurfaceCapabilities2ExtensionName, k_PhysicalDeviceProperties2ExtensionName})
+            {
+                if (!ContainsExtension(extensions, name) && IsInstanceExtensionSupported(name))
+                {
+                    extensions.push_back(name);
+                }
+            }
+            auto createInfo = *pCreateInfo;
+            createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+            createInfo.ppEnabledExtensionNames = extensions.data();
+
+            auto result = createInstance(&createInfo, pAllocator, pInstance);
+            if (result != VK_SUCCESS && extensions.size() != originalExtensionCount)
+            {
+                CLUSTER_LOG_WARNING << "vkCreateInstance failed with the extensions required by VK_NV_present_barrier: "
+                    << result;
+                extensions.resize(originalExtensionCount);
+                createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+                result = createInstance(&createInfo, pAllocator, pInstance);
+            }
+            if (result == VK_SUCCESS)
+            {
+                s_Instance = *pInstance;
+                s_SurfaceCapabilities2Enabled = ContainsExtension(extensions, k_SurfaceCapabilities2ExtensionName);
+            }
+            return result;
+        }
+
+        VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(const VkPhysicalDevice physicalDevice,
+            const VkDeviceCreateInfo* const pCreateInfo, const VkAllocationCallbacks* const pAllocator,
+            VkDevice* const pDevice)
+        {
+            const auto createDevice = GetInstanceFunction<PFN_vkCreateDevice>("vkCreateDevice");
+
+            auto presentBarrierEnabled = IsPresentBarrierSupported(physicalDevice);
+            auto result = VK_ERROR_INITIALIZATION_FAILED;
+#ifdef VK_NV_present_barrier
+            if (presentBarrierEnabled)
+            {
+                std::vector<const char*> extensions(pCreateInfo->ppEnabledExtensionNames,
+                    pCreateInfo->ppEnabledExtensionNames + pCreateInfo->enabledExtensionCount);
+                extensions.push_back(VK_NV_PRESENT_BARRIER_EXTENSION_NAME);
+                VkPhysicalDevicePresentBarrierFeaturesNV presentBarrierFeatures = {};
+                presentBarrierFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_BARRIER_FEATURES_NV;
+                presentBarrierFeatures.pNext = const_cast<void*>(pCreateInfo->pNext);
+                presentBarrierFeatures.presentBarrier = VK_TRUE;
+                auto createInfo = *pCreateInfo;
+                createInfo.pNext = &presentBarrierFeatures;
+                createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+                createInfo.ppEnabledExtensionNames = extensions.data();
+                result = createDevice(physicalDevice, &createInfo, pAllocator, pDevice);
+                if (result != VK_SUCCESS)
+                {
+                    CLUSTER_LOG_WARNING << "vkCreateDevice failed with VK_NV_present_barrier enabled: " << result;
+                    presentBarrierEnabled = false;
+                }
+            }
+#endif
+            if (!presentBarrierEnabled)
+            {
+                result = createDevice(physicalDevice, pCreateInfo, pAllocator, pDevice);
+            }
+            if (result != VK_SUCCESS)
+            {
+                return result;
+            }
+
+            CLUSTER_LOG << "Vulkan device created, VK_NV_present_barrier "
+                << (presentBarrierEnabled ? "enabled" : "not available");
+            s_PhysicalDevice = physicalDevice;
+            s_PresentBarrierEnabled = presentBarrierEnabled;
+            s_GetDeviceProcAddr = GetInstanceFunction<PFN_vkGetDeviceProcAddr>("vkGetDeviceProcAddr");
+            s_CreateSwapchain = GetInstanceFunction<PFN_vkCreateSwapchainKHR>("vkCreateSwapchainKHR");
+            s_DestroySwapchain = GetInstanceFunction<PFN_vkDestroySwapchainKHR>("vkDestroySwapchainKHR");
+            s_QueuePresent = GetInstanceFunction<PFN_vkQueuePresentKHR>("vkQueuePresentKHR");
+            s_DeviceCreated = true;
+            return result;
+        }
+
+        VKAPI_ATTR VkResult VKAPI_CALL CreateSwapchain(const VkDevice device,
+            const VkSwapchainCreateInfoKHR* const pCreateInfo, const VkAllocationCallbacks* const pAllocator,
+            VkSwapchainKHR* const pSwapchain)
+        {
+            auto createInfo = *pCreateInfo;
+
+            // Images have to be copied to repeat presents.
+            const auto getSurfaceCapabilities = GetInstanceFunction<PFN_vkGetPhysicalDeviceSurfaceCapabilitiesKHR>(
+                "vkGetPhysicalDeviceSurfaceCapabilitiesKHR");
+            VkSurfaceCapabilitiesKHR surfaceCapabilities;
+            if (getSurfaceCapabilities != nullptr &&
+                getSurfaceCapabilities(s_PhysicalDevice, createInfo.surface, &surfaceCapabilities) == VK_SUCCESS)
+            {
+                createInfo.imageUsage |= surfaceCapabilities.supportedUsageFlags &
+                    (VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+            }
+
+            auto presentBarrierEnabled = s_PresentBarrierEnabled;
+#ifdef VK_NV_present_barrier
+            VkSwapchainPresentBarrierCreateInfoNV presentBarrierCreateInfo = {};
+            presentBarrierCreateInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_PRESENT_BARRIER_CREATE_INFO_NV;
+            presentBarrierCreateInfo.pNext = const_cast<void*>(pCreateInfo->pNext);
+            presentBarrierCreateInfo.presentBarrierEnable = VK_TRUE;
+            if (presentBarrierEnabled)
+            {
+                createInfo.pNext = &presentBarrierCreateInfo;
+            }
+#endif
+
+            auto result = s_CreateSwapchain(device, &createInfo, pAllocator, pSwapchain);
+            if (result != VK_SUCCESS && presentBarrierEnabled)
+            {
+                CLUSTER_LOG_WARNING << "vkCreateSwapchainKHR failed with the present barrier enabled: " << result;
+                createInfo.pNext = pCreateInfo->pNext;
+                presentBarrierEnabled = false;
+                result = s_CreateSwapchain(device, &createInfo, pAllocator, pSwapchain);
+            }
+            if (result != VK_SUCCESS)
+            {
+                // Last chance, exactly as requested by Unity.
+                createInfo = *pCreateInfo;
+                result = s_CreateSwapchain(device, &createInfo, pAllocator, pSwapchain);
+            }
+            if (result != VK_SUCCESS)
+            {
+                return result;
+            }
+
+            VulkanGraphicsDevice::Swapchain swapchain;
+            swapchain.swapchain = *pSwapchain;
+            swapchain.format = createInfo.imageFormat;
+            swapchain.extent = createInfo.imageExtent;
+            swapchain.usage = createInfo.imageUsage;
+            swapchain.presentBarrierEnabled = presentBarrierEnabled;
+            std::lock_guard<std::mutex> lock(s_SwapchainsLock);
+            s_Swapchains.push_back(swapchain);
+            return result;
+        }
+
+        VKAPI_ATTR void VKAPI_CALL DestroySwapchain(const VkDevice device, const VkSwapchainKHR swapchain,
+            const VkAllocationCallbacks* const pAllocator)
+        {
+            {
+                std::lock_guard<std::mutex> lock(s_SwapchainsLock);
+                s_Swapchains.erase(std::remove_if(s_Swapchains.begin(), s_Swapchains.end(),
+                    [swapchain](const VulkanGraphicsDevice::Swapchain& created)
+                    { return created.swapchain == swapchain; }), s_Swapchains.end());
+            }
+            s_DestroySwapchain(device, swapchain, pAllocator);
+        }
+
+        VKAPI_ATTR VkResult VKAPI_CALL QueuePresent(const VkQueue queue, const VkPresentInfoKHR* const pPresentInfo)
+        {
+            auto result = VK_SUCCESS;
+            if (s_PresentHandler != nullptr && s_PresentHandler(queue, *pPresentInfo, result))
+            {
+                if (pPresentInfo->pResults != nullptr)
+                {
+                    std::fill(pPresentInfo->pResults, pPresentInfo->pResults + pPresentInfo->swapchainCount, result);
+                }
+                return result;
+            }
+            return s_QueuePresent(queue, pPresentInfo);
+        }
+
+        PFN_vkVoidFunction GetDeviceHook(const char* name);
+
+        VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetDeviceProcAddr(const VkDevice device, const char* const name)
+        {
+            const auto hook = GetDeviceHook(name);
+            return hook != nullptr ? hook : s_GetDeviceProcAddr(device, name);
+        }
+
+        PFN_vkVoidFunction GetDeviceHook(const char* const name)
+        {
+            if (strcmp(name, "vkGetDeviceProcAddr") == 0)
+            {
+                return reinterpret_cast<PFN_vkVoidFunction>(&GetDeviceProcAddr);
+            }
+            if (strcmp(name, "vkCreateSwapchainKHR") == 0)
+            {
+                return reinterpret_cast<PFN_vkVoidFunction>(&CreateSwapchain);
+            }
+            if (strcmp(name, "vkDestroySwapchainKHR") == 0)
+            {
+                return reinterpret_cast<PFN_vkVoidFunction>(&DestroySwapchain);
+            }
+            if (strcmp(name, "vkQueuePresentKHR") == 0)
+            {
+                return reinterpret_cast<PFN_vkVoidFunction>(&QueuePresent);
+            }
+            return nullptr;
+        }
+
+        VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetInstanceProcAddr(const VkInstance instance, const char* const name)
+        {
+            if (strcmp(name, "vkGetInstanceProcAddr") == 0)
+            {
+                return reinterpret_cast<PFN_vkVoidFunction>(&GetInstanceProcAddr);
+            }
+            if (strcmp(name, "vkCreateInstance") == 0)
+            {
+                return reinterpret_cast<PFN_vkVoidFunction>(&CreateInstance);
+            }
+            if (strcmp(name, "vkCreateDevice") == 0)
+            {
+                return reinterpret_cast<PFN_vkVoidFunction>(&CreateDevice);
+            }
+            const auto hook = GetDeviceHook(name);
+            return hook != nullptr ? hook : s_GetInstanceProcAddr(instance, name);
+        }
+
+        PFN_vkGetInstanceProcAddr UNITY_INTERFACE_API OnInitialization(
+            const PFN_vkGetInstanceProcAddr getInstanceProcAddr, void*)
+        {
+            CLUSTER_LOG << "Intercepting Vulkan initialization";
+            s_GetInstanceProcAddr = getInstanceProcAddr;
+            return &GetInstanceProcAddr;
+        }
+    }
+
+    bool InterceptVulkanInitialization(IUnityGraphicsVulkan* const unityGraphicsVulkan,
+        const VulkanPresentHandler presentHandler)
+    {
+        s_PresentHandler = presentHandler;
+        if (!unityGraphicsVulkan->InterceptInitialization(&OnInitialization, nullptr))
+        {
+            CLUSTER_LOG_WARNING << "Failed to intercept Vulkan initialization (is the plugin preloaded?)";
+            return false;
+        }
+        return true;
+    }
+
+    bool IsVulkanInitializationIntercepted()
+    {
+        return s_DeviceCreated;
+    }
+
+    VulkanGraphicsDevice::Swapchain GetInterceptedVulkanSwapchain(const VkSwapchainKHR swapchain)
+    {
+        std::lock_guard<std::mutex> lock(s_SwapchainsLock);
+        if (swapchain == VK_NULL_HANDLE)
+        {
+            return s_Swapchains.empty() ? VulkanGraphicsDevice::Swapchain() : s_Swapchains.back();
+        }
+        const auto found = std::find_if(s_Swapchains.begin(), s_Swapchains.end(),
+            [swapchain](const VulkanGraphicsDevice::Swapchain& created) { return created.swapchain == swapchain; });
+        return found != s_Swapchains.end() ? *found : VulkanGraphicsDevice::Swapchain();
+    }
+}
@@ -0,0 +1,73 @@
+#include "VulkanPresentBarrierSyncApi.h"
+#include "IGraphicsDevice.h"
+
+namespace GfxQuadroSync
+{
+    SyncApiStatus VulkanPresentBarrierSyncApi::QueryMaxSwapGroup(IUnknown*, uint32_t& maxGroups,
+        uint32_t& maxBarriers)
+    {
+        maxGroups = 1;
+        maxBarriers = 1;
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus VulkanPresentBarrierSyncApi::JoinSwapGroup(IUnknown*, IDXGISwapChain* const pSwapChain,
+        const uint32_t group, bool)
+    {
+        if (pSwapChain == nullptr)
+        {
+            return SyncApiStatus::InvalidHandle;
+        }
+        if (group > 1)
+        {
+            return SyncApiStatus::InvalidArgument;
+        }
+        m_GroupId = group;
+        if (m_GroupId == 0)
+        {
+            m_BarrierId = 0;
+        }
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus VulkanPresentBarrierSyncApi::BindSwapBarrier(IUnknown*, const uint32_t group,
+        const uint32_t barrier)
+    {
+        if (barrier > 1 || group != m_GroupId || (barrier > 0 && m_GroupId == 0))
+        {
+            return SyncApiStatus::InvalidArgument;
+        }
+        m_BarrierId = barrier;
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus VulkanPresentBarrierSyncApi::QuerySwapGroup(IUnknown*, IDXGISwapChain*, uint32_t& group,
+        uint32_t& barrier)
+    {
+        group = m_GroupId;
+        barrier = m_BarrierId;
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus VulkanPresentBarrierSyncApi::QueryFrameCount(IUnknown*, uint32_t& frameCount)
+    {
+        frameCount = m_PresentCount;
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus VulkanPresentBarrierSyncApi::ResetFrameCount(IUnknown*)
+    {
+        m_PresentCount = 0;
+        return SyncApiStatus::Ok;
+    }
+
+    SyncApiStatus VulkanPresentBarrierSyncApi::Present(IGraphicsDevice& graphicsDevice)
+    {
+        if (!graphicsDevice.Present())
+        {
+            return SyncApiStatus::Error;
+        }
+        ++m_PresentCount;
+        return SyncApiStatus::Ok;
+    }
+}
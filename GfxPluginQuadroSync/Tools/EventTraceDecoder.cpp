@@ -0,0 +1,291 @@
+// Converts a trace file written by EventTrace (see StartEventTrace) to text (one line per event) or to the Chrome trace
+// event JSON format (to be opened in chrome://tracing, Perfetto, ...).  Events are listed oldest first, records that
+// were overwritten by newer ones or not completely written (process killed while writing them) are skipped and
+// counted on stderr.
+//
+// Usage: EventTraceDecoder <trace file> [--format text|chrome] [--output <file>]
+
+#include "EventTrace.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace GfxQuadroSync;
+
+namespace
+{
+    enum class OutputFormat
+    {
+        Text,
+        Chrome,
+    };
+
+    struct Parameters
+    {
+        const char* tracePath = nullptr;
+        const char* outputPath = nullptr;
+        OutputFormat format = OutputFormat::Text;
+    };
+
+    /// Record copied out of the trace file.
+    struct Event
+    {
+        uint64_t recordIndex;
+        uint64_t tick;
+        uint32_t threadId;
+        uint16_t eventId;
+        int64_t args[3];
+    };
+
+    struct Trace
+    {
+        uint32_t processId = 0;
+        uint64_t performanceCounterFrequency = 0;
+        uint64_t startTick = 0;
+        uint64_t writtenCount = 0;
+        uint64_t overwrittenCount = 0;
+        uint64_t incompleteCount = 0;
+        std::vector<Event> events;
+    };
+
+    bool ParseArguments(const int argc, char** argv, Parameters& parameters)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* const argument = argv[i];
+            if (argument[0] != '-')
+            {
+                parameters.tracePath = argument;
+                continue;
+            }
+            if (i + 1 >= argc)
+            {
+                std::cerr << "Missing value for " << argument << std::endl;
+                return false;
+            }
+            const char* const value = argv[++i];
+            if (std::strcmp(argument, "--format") == 0 && std::strcmp(value, "text") == 0)
+                parameters.format = OutputFormat::Text;
+            else if (std::strcmp(argument, "--format") == 0 && std::strcmp(value, "chrome") == 0)
+                parameters.format = OutputFormat::Chrome;
+            else if (std::strcmp(argument, "--output") == 0)
+                parameters.outputPath = value;
+            else
+            {
+                std::cerr << "Unknown argument " << argument << " " << value << std::endl;
+                return false;
+            }
+        }
+        if (parameters.tracePath == nullptr)
+        {
+            std::cerr << "Usage: EventTraceDecoder <trace file> [--format text|chrome] [--output <file>]" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool LoadTrace(const char* const path, Trace& trace)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+        {
+            std::cerr << "Failed to open " << path << std::endl;
+            return false;
+        }
+        const auto fileSize = static_cast<size_t>(file.tellg());
+        if (fileSize < sizeof(EventTraceHeader))
+        {
+            std::cerr << path << " is too small to be a trace file" << std::endl;
+            return false;
+        }
+        // Remarks: Stored in uint64_t so that the header and records are properly aligned.
+        std::vector<uint64_t> content((fileSize + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(content.data()), static_cast<std::streamsize>(fileSize));
+        if (!file)
+        {
+            std::cerr << "Failed to read " << path << std::endl;
+            return false;
+        }
+
+        const auto& header = *reinterpret_cast<const EventTraceHeader*>(content.data());
+        if (header.magic != EventTraceHeader::k_Magic)
+        {
+            std::cerr << path << " is not a trace file" << std::endl;
+            return false;
+        }
+        if (header.version != EventTraceHeader::k_Version || header.headerSize != sizeof(EventTraceHeader) ||
+            header.recordSize != sizeof(EventTraceRecord))
+        {
+            std::cerr << path << " was written by an unsupported version (" << header.version << ")" << std::endl;
+            return false;
+        }
+        if (header.recordCount == 0 ||
+            fileSize < sizeof(EventTraceHeader) + static_cast<size_t>(header.recordCount) * sizeof(EventTraceRecord))
+        {
+            std::cerr << path << " is truncated" << std::endl;
+            return false;
+        }
+
+        trace.processId = header.processId;
+        trace.performanceCounterFrequency = header.performanceCounterFrequency;
+        trace.startTick = header.startTick;
+        trace.writtenCount = header.writeIndex.load(std::memory_order_relaxed);
+        const auto records = reinterpret_cast<const EventTraceRecord*>(&header + 1);
+        const auto firstIndex = trace.writtenCount > header.recordCount ? trace.writtenCount - header.recordCount : 0;
+        trace.overwrittenCount = firstIndex;
+        for (auto recordIndex = firstIndex; recordIndex < trace.writtenCount; ++recordIndex)
+        {
+            const auto& record = records[recordIndex % header.recordCount];
+            if (record.sequence.load(std::memory_order_relaxed) != recordIndex + 1)
+            {
+                ++trace.incompleteCount;
+                continue;
+            }
+            Event event;
+            event.recordIndex = recordIndex;
+            event.tick = record.tick;
+            event.threadId = record.threadId;
+            event.eventId = record.eventId;
+            std::copy(std::begin(record.args), std::end(record.args), std::begin(event.args));
+            trace.events.push_back(event);
+        }
+
+        // Remarks: Records are reserved in order but the tick can be fetched a little before reserving the record, so
+        // the order of the records is not exactly the order of the events.
+        std::stable_sort(trace.events.begin(), trace.events.end(),
+            [](const Event& left, const Event& right) { return left.tick < right.tick; });
+        return true;
+    }
+
+    /// Time of an event relative to the start of the trace, in microseconds.
+    double GetEventTimeUs(const Trace& trace, const Event& event)
+    {
+        const auto ticks = static_cast<double>(static_cast<int64_t>(event.tick - trace.startTick));
+        return ticks * 1000000.0 / static_cast<double>(trace.performanceCounterFrequency);
+    }
+
+    void WriteText(const Trace& trace, std::ostream& output)
+    {
+        output << "# processId=" << trace.processId << " frequency=" << trace.performanceCounterFrequency
+               << " written=" << trace.writtenCount << " overwritten=" << trace.overwrittenCount
+               << " incomplete=" << trace.incompleteCount << "\n";
+        output << std::fixed << std::setprecision(3);
+        for (const auto& event : trace.events)
+        {
+            output << std::setw(16) << GetEventTimeUs(trace, event) << " tid=" << event.threadId << " ";
+            const auto description = GetEventTraceDescription(event.eventId);
+            if (description == nullptr)
+            {
+                output << "Unknown(" << event.eventId << ") " << event.args[0] << " " << event.args[1] << " "
+                       << event.args[2] << "\n";
+                continue;
+            }
+            output << description->name;
+            for (size_t argIndex = 0; argIndex < 3; ++argIndex)
+            {
+                if (description->argumentNames[argIndex] != nullptr)
+                {
+                    output << " " << description->argumentNames[argIndex] << "=" << event.args[argIndex];
+                }
+            }
+            output << "\n";
+        }
+    }
+
+    void WriteChromeArgs(const EventTraceDescription* const description, const Event& event, std::ostream& output)
+    {
+        output << "\"args\":{";
+        bool first = true;
+        for (size_t argIndex = 0; argIndex < 3; ++argIndex)
+        {
+            if (description != nullptr && description->argumentNames[argIndex] == nullptr)
+            {
+                continue;
+            }
+            output << (first ? "" : ",") << "\"";
+            if (description != nullptr)
+                output << description->argumentNames[argIndex];
+            else
+                output << "arg" << argIndex;
+            output << "\":" << event.args[argIndex];
+            first = false;
+        }
+        output << "}";
+    }
+
+    void WriteChrome(const Trace& trace, std::ostream& output)
+    {
+        output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        output << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << trace.processId
+               << ",\"args\":{\"name\":\"GfxPluginQuadroSync\"}}";
+        output << std::fixed << std::setprecision(3);
+        for (const auto& event : trace.events)
+        {
+            const auto description = GetEventTraceDescription(event.eventId);
+            const auto eventId = static_cast<EventTraceId>(event.eventId);
+            output << ",\n{\"name\":\"";
+            if (eventId == EventTraceId::PresentBegin || eventId == EventTraceId::PresentEnd)
+            {
+                // Remarks: Begin / end pair, displayed as a slice covering the present.
+                output << "Present\",\"ph\":\"" << (eventId == EventTraceId::PresentBegin ? "B" : "E") << "\"";
+            }
+            else if (description != nullptr)
+            {
+                output << description->name << "\",\"ph\":\"i\",\"s\":\"t\"";
+            }
+            else
+            {
+                output << "Unknown(" << event.eventId << ")\",\"ph\":\"i\",\"s\":\"t\"";
+            }
+            output << ",\"pid\":" << trace.processId << ",\"tid\":" << event.threadId
+                   << ",\"ts\":" << GetEventTimeUs(trace, event) << ",";
+            WriteChromeArgs(description, event, output);
+            output << "}";
+        }
+        output << "\n]}\n";
+    }
+}
+
+int main(const int argc, char** argv)
+{
+    Parameters parameters;
+    if (!ParseArguments(argc, argv, parameters))
+    {
+        return 1;
+    }
+
+    Trace trace;
+    if (!LoadTrace(parameters.tracePath, trace))
+    {
+        return 1;
+    }
+    if (trace.overwrittenCount > 0 || trace.incompleteCount > 0)
+    {
+        std::cerr << trace.overwrittenCount << " event(s) overwritten and " << trace.incompleteCount
+                  << " event(s) incompletely written were skipped" << std::endl;
+    }
+
+    std::ofstream outputFile;
+    if (parameters.outputPath != nullptr)
+    {
+        outputFile.open(parameters.outputPath);
+        if (!outputFile)
+        {
+            std::cerr << "Failed to create " << parameters.outputPath << std::endl;
+            return 1;
+        }
+    }
+    auto& output = parameters.outputPath != nullptr ? static_cast<std::ostream&>(outputFile) : std::cout;
+    if (parameters.format == OutputFormat::Chrome)
+        WriteChrome(trace, output);
+    else
+        WriteText(trace, output);
+    output.flush();
+    return output ? 0 : 1;
+}
@@ -0,0 +1,56 @@
+#!/usr/bin/env bash
+# Histogram of the duration of the presents of GfxPluginQuadroSync, measured by bpftrace between the present_begin and
+# present_end USDT probes (see Includes/Tracepoints.h), printed every interval and when stopped (Ctrl+C).  Also counts
+# the status returned by the presents and the barrier warmup actions.
+#
+# Usage: sudo PresentHistogramBpftrace.sh <path of GfxPluginQuadroSync.so> [pid] [interval seconds]
+#
+# Without a pid, every process using the library is traced.
+
+set -euo pipefail
+
+if [ $# -lt 1 ]; then
+    echo "Usage: $0 <path of GfxPluginQuadroSync.so> [pid] [interval seconds]" >&2
+    exit 1
+fi
+
+library=$(readlink -f "$1")
+pid=${2:-}
+interval=${3:-10}
+
+program="
+usdt:${library}:gfxquadrosync:present_begin
+{
+    @start[tid] = nsecs;
+}
+
+usdt:${library}:gfxquadrosync:present_end
+/@start[tid]/
+{
+    @present_us = hist((nsecs - @start[tid]) / 1000);
+    @present_status[arg2] = count();
+    delete(@start[tid]);
+}
+
+usdt:${library}:gfxquadrosync:warmup_action
+{
+    @warmup_actions[arg2] = count();
+}
+
+interval:s:${interval}
+{
+    time(\"%H:%M:%S present duration (us)\n\");
+    print(@present_us);
+}
+
+END
+{
+    clear(@start);
+}
+"
+
+if [ -n "${pid}" ]; then
+    exec bpftrace -p "${pid}" -e "${program}"
+else
+    exec bpftrace -e "${program}"
+fi
@@ -0,0 +1,73 @@
+# Histogram of the duration of the presents of GfxPluginQuadroSync from its PresentEnd TraceLogging event (durationUs
+# field, see Includes/Tracepoints.h), recorded with an ETW session for a number of seconds.  Must be run from an
+# elevated prompt.
+#
+# Usage: PresentHistogramEtw.ps1 [-Seconds N] [-OutputDirectory <directory to keep the .etl and .xml files in>]
+
+param(
+    [int]$Seconds = 10,
+    [string]$OutputDirectory = $env:TEMP
+)
+
+$ErrorActionPreference = 'Stop'
+
+# Unity.ClusterDisplay.GfxPluginQuadroSync
+$provider = '{8c84e33f-eeb2-5b3b-0600-643ac053846f}'
+$sessionName = 'GfxPluginQuadroSyncPresents'
+$etlPath = Join-Path $OutputDirectory 'GfxPluginQuadroSyncPresents.etl'
+$xmlPath = Join-Path $OutputDirectory 'GfxPluginQuadroSyncPresents.xml'
+
+logman start $sessionName -p $provider -o $etlPath -ets | Out-Null
+try
+{
+    Start-Sleep -Seconds $Seconds
+}
+finally
+{
+    logman stop $sessionName -ets | Out-Null
+}
+
+# Remarks: tracerpt decodes TraceLogging events (self describing) without any manifest.
+tracerpt $etlPath -o $xmlPath -of XML -y | Out-Null
+[xml]$events = Get-Content $xmlPath
+
+# Power of 2 buckets, same as the hist() of bpftrace.
+$counts = @{}
+$total = 0
+$maxBucket = -1
+foreach ($event in $events.Events.Event)
+{
+    $duration = $event.EventData.Data | Where-Object { $_.Name -eq 'durationUs' }
+    if ($null -eq $duration)
+    {
+        continue
+    }
+
+    $value = [uint64]$duration.'#text'
+    $bucket = -1
+    if ($value -gt 0)
+    {
+        $bucket = 0
+        while ([Math]::Pow(2, $bucket + 1) -le $value)
+        {
+            ++$bucket
+        }
+    }
+    $counts[$bucket] = 1 + $(if ($counts.ContainsKey($bucket)) { $counts[$bucket] } else { 0 })
+    $maxBucket = [Math]::Max($maxBucket, $bucket)
+    ++$total
+}
+
+if ($total -eq 0)
+{
+    Write-Output 'No present recorded'
+    exit 1
+}
+
+Write-Output "$total presents, duration (us):"
+for ($bucket = -1; $bucket -le $maxBucket; ++$bucket)
+{
+    $label = if ($bucket -eq -1) { '[0]' } else { '[{0}, {1})' -f [Math]::Pow(2, $bucket), [Math]::Pow(2, $bucket + 1) }
+    $count = if ($counts.ContainsKey($bucket)) { $counts[$bucket] } else { 0 }
+    Write-Output ('{0,-20} {1,8}' -f $label, $count)
+}
@@ -0,0 +1,74 @@
+#!/usr/bin/env bash
+# Histogram of the duration of the presents of GfxPluginQuadroSync from the present_end USDT probe (its 4th argument
+# is the duration of the present in microseconds, see Includes/Tracepoints.h), recorded with perf for a number of
+# seconds.  For systems without bpftrace.
+#
+# Usage: sudo PresentHistogramPerf.sh <path of GfxPluginQuadroSync.so> <pid> [seconds]
+
+set -euo pipefail
+
+if [ $# -lt 2 ]; then
+    echo "Usage: $0 <path of GfxPluginQuadroSync.so> <pid> [seconds]" >&2
+    exit 1
+fi
+
+library=$(readlink -f "$1")
+pid=$2
+seconds=${3:-10}
+data=$(mktemp --suffix=.perf.data)
+trap 'rm -f "${data}"; perf probe -q -d "sdt_gfxquadrosync:present_end" 2>/dev/null || true' EXIT
+
+# Remarks: perf finds the USDT probes of the binaries in its build-id cache.
+perf buildid-cache --add "${library}"
+perf probe -q -x "${library}" "sdt_gfxquadrosync:present_end" 2>/dev/null || true
+perf record -q -e "sdt_gfxquadrosync:present_end" -p "${pid}" -o "${data}" -- sleep "${seconds}"
+
+# Power of 2 buckets, same as the hist() of bpftrace.
+perf script -i "${data}" -F trace 2>/dev/null | awk '
+    # Remarks: Arguments are printed in decimal or hexadecimal depending on the perf version.
+    function parse(text,    value, i)
+    {
+        if (text !~ /^0x/)
+            return text + 0;
+        value = 0;
+        for (i = 3; i <= length(text); ++i)
+            value = value * 16 + index("0123456789abcdef", tolower(substr(text, i, 1))) - 1;
+        return value;
+    }
+    BEGIN {
+        maxBucket = -1;
+    }
+    {
+        for (i = 1; i <= NF; ++i)
+        {
+            if ($i ~ /^arg4=/)
+            {
+                value = parse(substr($i, 6));
+                bucket = 0;
+                while ((2 ^ (bucket + 1)) <= value)
+                    ++bucket;
+                if (value == 0)
+                    bucket = -1;
+                ++counts[bucket];
+                ++total;
+                if (bucket > maxBucket)
+                    maxBucket = bucket;
+            }
+        }
+    }
+    END {
+        if (total == 0)
+        {
+            print "No present recorded";
+            exit 1;
+        }
+        printf("%d presents, duration (us):\n", total);
+        for (bucket = -1; bucket <= maxBucket; ++bucket)
+        {
+            if (bucket == -1)
+                label = "[0]";
+            else
+                label = sprintf("[%d, %d)", 2 ^ bucket, 2 ^ (bucket + 1));
+            printf("%-20s %8d\n", label, counts[bucket]);
+        }
+    }'
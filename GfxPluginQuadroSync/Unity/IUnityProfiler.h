@@ -0,0 +1,196 @@
+// Unity Native Plugin API copyright © 2015 Unity Technologies ApS
+//
+// Licensed under the Unity Companion License for Unity - dependent projects--see[Unity Companion License](http://www.unity3d.com/legal/licenses/Unity_Companion_License).
+//
+// Unless expressly provided otherwise, the Software under this license is made available strictly on an “AS IS” BASIS WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED.Please review the license for details on these and other terms and conditions.
+
+#pragma once
+#include "IUnityInterface.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// Subset of the profiler interface used by the plugin (markers, threads and counters).  IUnityProfilerV2 (counters) is
+// available since Unity 2021.2.
+
+typedef uint16_t UnityProfilerMarkerId;
+typedef uint16_t UnityProfilerCategoryId;
+typedef uint64_t UnityProfilerThreadId;
+
+enum UnityBuiltinProfilerCategory_
+{
+    kUnityProfilerCategoryRender = 0,
+    kUnityProfilerCategoryScripts = 1,
+    kUnityProfilerCategoryManagedJobs = 2,
+    kUnityProfilerCategoryBurstJobs = 3,
+    kUnityProfilerCategoryGUI = 4,
+    kUnityProfilerCategoryPhysics = 5,
+    kUnityProfilerCategoryAnimation = 6,
+    kUnityProfilerCategoryAI = 7,
+    kUnityProfilerCategoryAudio = 8,
+    kUnityProfilerCategoryAudioJob = 9,
+    kUnityProfilerCategoryAudioUpdateJob = 10,
+    kUnityProfilerCategoryVideo = 11,
+    kUnityProfilerCategoryParticles = 12,
+    kUnityProfilerCategoryGi = 13,
+    kUnityProfilerCategoryNetwork = 14,
+    kUnityProfilerCategoryLoading = 15,
+    kUnityProfilerCategoryOther = 16,
+    kUnityProfilerCategoryGC = 17,
+    kUnityProfilerCategoryVSync = 18,
+    kUnityProfilerCategoryOverhead = 19,
+    kUnityProfilerCategoryPlayerLoop = 20,
+    kUnityProfilerCategoryDirector = 21,
+    kUnityProfilerCategoryVR = 22,
+    kUnityProfilerCategoryAllocation = 23,
+    kUnityProfilerCategoryInternal = 24,
+    kUnityProfilerCategoryFileIO = 25,
+    kUnityProfilerCategoryUISystemLayout = 26,
+    kUnityProfilerCategoryUISystemRender = 27,
+    kUnityProfilerCategoryVFX = 28,
+    kUnityProfilerCategoryBuildInterface = 29,
+    kUnityProfilerCategoryInput = 30,
+    kUnityProfilerCategoryVirtualTexturing = 31,
+};
+typedef uint16_t UnityBuiltinProfilerCategory;
+
+enum UnityProfilerMarkerFlag_
+{
+    kUnityProfilerMarkerFlagDefault = 0,
+
+    kUnityProfilerMarkerFlagScriptUser = 1 << 1,
+    kUnityProfilerMarkerFlagScriptInvoke = 1 << 5,
+    kUnityProfilerMarkerFlagScriptEnterLeave = 1 << 6,
+
+    kUnityProfilerMarkerFlagAvailabilityEditor = 1 << 2,
+    kUnityProfilerMarkerFlagAvailabilityNonDev = 1 << 3,
+
+    kUnityProfilerMarkerFlagWarning = 1 << 4,
+
+    kUnityProfilerMarkerFlagCounter = 1 << 7,
+
+    kUnityProfilerMarkerFlagVerbosityDebug = 1 << 10,
+    kUnityProfilerMarkerFlagVerbosityInternal = 1 << 11,
+    kUnityProfilerMarkerFlagVerbosityAdvanced = 1 << 12,
+};
+typedef uint16_t UnityProfilerMarkerFlags;
+
+enum UnityProfilerMarkerEventType_
+{
+    kUnityProfilerMarkerEventTypeBegin = 0,
+    kUnityProfilerMarkerEventTypeEnd = 1,
+    kUnityProfilerMarkerEventTypeSingle = 2,
+};
+typedef uint16_t UnityProfilerMarkerEventType;
+
+typedef struct UnityProfilerMarkerDesc
+{
+    // Per-marker callback chain pointer. Don't modify.
+    const void* callback;
+    const UnityProfilerMarkerId id;
+    const UnityProfilerMarkerFlags flags;
+    const UnityProfilerCategoryId categoryId;
+    const char* const name;
+    const void* const metaDataDesc;
+} UnityProfilerMarkerDesc;
+
+enum UnityProfilerMarkerDataType_
+{
+    kUnityProfilerMarkerDataTypeNone = 0,
+    kUnityProfilerMarkerDataTypeInstanceId = 1,
+    kUnityProfilerMarkerDataTypeInt32 = 2,
+    kUnityProfilerMarkerDataTypeUInt32 = 3,
+    kUnityProfilerMarkerDataTypeInt64 = 4,
+    kUnityProfilerMarkerDataTypeUInt64 = 5,
+    kUnityProfilerMarkerDataTypeFloat = 6,
+    kUnityProfilerMarkerDataTypeDouble = 7,
+    kUnityProfilerMarkerDataTypeString = 8,
+    kUnityProfilerMarkerDataTypeString16 = 9,
+    kUnityProfilerMarkerDataTypeBlob8 = 11,
+    kUnityProfilerMarkerDataTypeGfxResourceId = 12,
+    kUnityProfilerMarkerDataTypeCount
+};
+typedef uint8_t UnityProfilerMarkerDataType;
+
+enum UnityProfilerMarkerDataUnit_
+{
+    kUnityProfilerMarkerDataUnitUndefined = 0,
+    kUnityProfilerMarkerDataUnitTimeNanoseconds = 1,
+    kUnityProfilerMarkerDataUnitBytes = 2,
+    kUnityProfilerMarkerDataUnitCount = 3,
+    kUnityProfilerMarkerDataUnitPercent = 4,
+    kUnityProfilerMarkerDataUnitFrequencyHz = 5,
+};
+typedef uint8_t UnityProfilerMarkerDataUnit;
+
+typedef struct UnityProfilerMarkerData
+{
+    const UnityProfilerMarkerDataType type;
+    const uint8_t reserved0;
+    const uint16_t reserved1;
+    const uint32_t size;
+    const void* ptr;
+} UnityProfilerMarkerData;
+
+enum UnityProfilerCounterFlags_
+{
+    kUnityProfilerCounterFlagNone = 0,
+    kUnityProfilerCounterFlushOnEndOfFrame = 1 << 1,
+    kUnityProfilerCounterFlagResetToZeroOnFlush = 1 << 2,
+    kUnityProfilerCounterFlagAtomic = 1 << 3,
+    kUnityProfilerCounterFlagGetter = 1 << 4,
+};
+typedef uint16_t UnityProfilerCounterFlags;
+
+typedef void (UNITY_INTERFACE_API * UnityProfilerCounterStatePtrCallback)(void* userData);
+
+// Profiler interface of Unity 2019.1 to 2021.1 (no counters).
+UNITY_DECLARE_INTERFACE(IUnityProfiler)
+{
+    // Emit a begin, end or single event of a marker (created by CreateMarker) on the current thread.
+    void(UNITY_INTERFACE_API * EmitEvent)(const UnityProfilerMarkerDesc* markerDesc, UnityProfilerMarkerEventType eventType, uint16_t eventDataCount, const UnityProfilerMarkerData* eventData);
+
+    // Is the profiler currently recording?
+    int(UNITY_INTERFACE_API * IsEnabled)();
+
+    // Is the profiler available at all?  (only in the editor and in development players)
+    int(UNITY_INTERFACE_API * IsAvailable)();
+
+    // Create a marker, the descriptor is owned by Unity and lives until the end of the process.
+    int(UNITY_INTERFACE_API * CreateMarker)(const UnityProfilerMarkerDesc** desc, const char* name, UnityProfilerCategoryId category, UnityProfilerMarkerFlags flags, int eventDataCount);
+
+    int(UNITY_INTERFACE_API * SetMarkerMetadataName)(const UnityProfilerMarkerDesc* desc, int index, const char* metadataName, UnityProfilerMarkerDataType metadataType, UnityProfilerMarkerDataUnit metadataUnit);
+
+    // Register the current thread so that its events are displayed in the timeline.
+    int(UNITY_INTERFACE_API * RegisterThread)(UnityProfilerThreadId* threadId, const char* groupName, const char* name);
+
+    int(UNITY_INTERFACE_API * UnregisterThread)(UnityProfilerThreadId threadId);
+};
+UNITY_REGISTER_INTERFACE_GUID(0x2CE79ED8316A4833ULL, 0x87076B2013E1571FULL, IUnityProfiler)
+
+// Profiler interface of Unity 2021.2 and later (adds categories and counters).
+UNITY_DECLARE_INTERFACE(IUnityProfilerV2)
+{
+    void(UNITY_INTERFACE_API * EmitEvent)(const UnityProfilerMarkerDesc* markerDesc, UnityProfilerMarkerEventType eventType, uint16_t eventDataCount, const UnityProfilerMarkerData* eventData);
+
+    int(UNITY_INTERFACE_API * IsEnabled)();
+
+    int(UNITY_INTERFACE_API * IsAvailable)();
+
+    int(UNITY_INTERFACE_API * CreateMarker)(const UnityProfilerMarkerDesc** desc, const char* name, UnityProfilerCategoryId category, UnityProfilerMarkerFlags flags, int eventDataCount);
+
+    int(UNITY_INTERFACE_API * SetMarkerMetadataName)(const UnityProfilerMarkerDesc* desc, int index, const char* metadataName, UnityProfilerMarkerDataType metadataType, UnityProfilerMarkerDataUnit metadataUnit);
+
+    int(UNITY_INTERFACE_API * CreateCategory)(UnityProfilerCategoryId* category, const char* name, uint32_t unused);
+
+    int(UNITY_INTERFACE_API * RegisterThread)(UnityProfilerThreadId* threadId, const char* groupName, const char* name);
+
+    int(UNITY_INTERFACE_API * UnregisterThread)(UnityProfilerThreadId threadId);
+
+    // Create a counter, *counter points to valueSize bytes of storage (owned by Unity) the value is written to.  With
+    // kUnityProfilerCounterFlushOnEndOfFrame the value is sampled at the end of every frame, otherwise when
+    // FlushCounterValue is called.
+    int(UNITY_INTERFACE_API * CreateCounterValue)(void** counter, const char* name, UnityProfilerCategoryId category, UnityProfilerMarkerFlags flags, UnityProfilerMarkerDataType valueType, UnityProfilerMarkerDataUnit valueUnit, size_t valueSize, UnityProfilerCounterFlags counterFlags, UnityProfilerCounterStatePtrCallback activateFunc, UnityProfilerCounterStatePtrCallback deactivateFunc, void* userData);
+
+    void(UNITY_INTERFACE_API * FlushCounterValue)(void* counter);
+};
+UNITY_REGISTER_INTERFACE_GUID(0xB957E0189CB6A30BULL, 0x83CE589AE85B9068ULL, IUnityProfilerV2)
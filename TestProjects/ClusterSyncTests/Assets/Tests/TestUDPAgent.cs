@@ -35,6 +35,10 @@ public TestUdpAgent(TestUdpAgentNetwork network, MessageType[] receivedMessageTy
 
         public IPAddress AdapterAddress { get; }
 
+        public IPAddress MulticastAddress { get; } = IPAddress.Parse("224.0.1.0");
+
+        public int Port { get; } = 25690;
+
         public int MaximumMessageSize { get; } = 1257; // Some random number, a little bit smaller than what we can expect to have
 
         public void SendMessage<TM>(MessageType messageType, TM message) where TM : unmanaged
@@ -36,7 +36,17 @@ public enum FrameSyncFence
         /// <summary>
         /// The fence is implemented by a third party. No fence is inserted by Cluster Display.
         /// </summary>
-        External
+        External,
+        /// <summary>
+        /// Use a swap barrier implemented in software by the QuadroSync plugin (nodes exchange datagrams before every
+        /// present), for clusters without Quadro Sync hardware.
+        /// </summary>
+        /// <remarks>
+        /// Every node must know the number of nodes of the cluster
+        /// (<see cref="ClusterParams.SoftwareSwapBarrierNodeCount"/>), node ids must be consecutive starting at 0.
+        /// If the barrier cannot be initialized, will fall back to <see cref="Network"/>.
+        /// </remarks>
+        Software
     }
 
     /// <summary>
@@ -113,6 +123,14 @@ public TimeSpan CommunicationTimeout
         [Tooltip("Synchronization method")]
         public FrameSyncFence Fence;
 
+        [Tooltip("Number of nodes (emitter, repeaters and backups) synchronized by the software swap barrier of " +
+            "FrameSyncFence.Software.")]
+        public int SoftwareSwapBarrierNodeCount;
+
+        [Tooltip("Repeaters present their last frame again through the swap barrier when the data of the next frame " +
+            "is late, so that the other nodes keep presenting at the refresh rate.")]
+        public bool HoldLateFrames;
+
         [SerializeField]
         [Tooltip("Timeout for performing node registration (seconds)")]
         float m_HandshakeTimeoutSec;
@@ -206,6 +224,7 @@ public static ClusterParams ApplyCommandLine(ClusterParams clusterParams)
             ApplyArgument(ref clusterParams.HeadlessEmitter, CommandLineParser.headlessEmitter);
             ApplyArgument(ref clusterParams.AdapterName, CommandLineParser.adapterName);
             ApplyArgument(ref clusterParams.TargetFps, CommandLineParser.targetFps);
+            ApplyArgument(ref clusterParams.HoldLateFrames, CommandLineParser.holdLateFrames);
 
             if (CommandLineParser.handshakeTimeout.Defined)
             {
@@ -217,6 +236,12 @@ public static ClusterParams ApplyCommandLine(ClusterParams clusterParams)
                 clusterParams.CommunicationTimeout = TimeSpan.FromMilliseconds(CommandLineParser.communicationTimeout.Value);
             }
 
+            if (CommandLineParser.softwareSwapBarrier.Defined)
+            {
+                clusterParams.Fence = FrameSyncFence.Software;
+                clusterParams.SoftwareSwapBarrierNodeCount = CommandLineParser.softwareSwapBarrier.Value;
+            }
+
             if (CommandLineParser.disableQuadroSync.Defined)
             {
                 clusterParams.Fence = FrameSyncFence.Network;
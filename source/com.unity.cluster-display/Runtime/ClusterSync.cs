@@ -148,7 +148,9 @@ public string GetDiagnostics()
                    $"\r\n\r\n Quadro Sync State:" +
                    $"\r\n\tInitialization: " + quadroSyncState.InitializationState.ToDescriptiveText() +
                    $"\r\n\tSwap group / barrier identifier: {quadroSyncState.SwapGroupId} / {quadroSyncState.SwapBarrierId}" +
-                   $"\r\n\tPresent success / failure: {quadroSyncState.PresentedFramesSuccess} / {quadroSyncState.PresentedFramesFailure}";
+                   $"\r\n\tPresent success / failure: {quadroSyncState.PresentedFramesSuccess} / {quadroSyncState.PresentedFramesFailure}" +
+                   $"\r\n\tFrame count queries / extrapolations: {quadroSyncState.FrameCountHardwareQueries} / {quadroSyncState.FrameCountExtrapolations}" +
+                   $"\r\n\tFrame count extrapolation error (last / max): {quadroSyncState.FrameCountLastExtrapolationError} / {quadroSyncState.FrameCountMaxExtrapolationError}";
         }
 
         void InstanceLog(string msg) => ClusterDebug.Log($"[{nameof(ClusterSync)} instance \"{InstanceName}\"]: {msg}");
@@ -365,6 +367,8 @@ bool TryInitialize(ClusterParams clusterParams)
                     CommunicationTimeout = clusterParams.CommunicationTimeout,
                     RepeatersDelayed = clusterParams.DelayRepeaters,
                     Fence = clusterParams.Fence,
+                    SoftwareSwapBarrierNodeCount = clusterParams.SoftwareSwapBarrierNodeCount,
+                    HoldLateFrames = clusterParams.HoldLateFrames,
                     InputSync = clusterParams.InputSync,
                     HasAtLeastOneBackupNode = clusterParams.BackupCount > 0
                 };
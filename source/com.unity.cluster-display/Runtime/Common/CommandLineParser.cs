@@ -232,6 +232,8 @@ internal class Vector2IntArgument : BaseArgument<Vector2Int>
         internal static readonly IntArgument overscan                       = new IntArgument("-overscan");
 
         internal static readonly BoolArgument disableQuadroSync             = new BoolArgument("-disableQuadroSync");
+        internal static readonly IntArgument softwareSwapBarrier            = new IntArgument("-softwareSwapBarrier");
+        internal static readonly BoolArgument holdLateFrames                = new BoolArgument("-holdLateFrames");
 
         internal static readonly StringArgument adapterName                 = new StringArgument("-adapterName");
         internal static readonly StringArgument multicastAddress            = new StringArgument(GetNodeType, tryParse: TryParseMulticastAddress);
@@ -259,7 +261,9 @@ internal class Vector2IntArgument : BaseArgument<Vector2Int>
             port,
             handshakeTimeout,
             communicationTimeout,
-            disableQuadroSync
+            disableQuadroSync,
+            softwareSwapBarrier,
+            holdLateFrames
         };
 
         // Since this property is referenced by some arguments when this class is initialized, this will be one of the very first things called.
@@ -312,6 +312,16 @@ interface IUdpAgent
         /// </summary>
         IPAddress AdapterAddress { get; }
 
+        /// <summary>
+        /// Multicast address to which messages are sent.
+        /// </summary>
+        IPAddress MulticastAddress { get; }
+
+        /// <summary>
+        /// Port to which messages are sent and on which messages are received.
+        /// </summary>
+        int Port { get; }
+
         /// <summary>
         /// Maximum combined size for <c>Marshal.SizeOf(typeof(TM)) + additionalData.Length</c> when sending a message
         /// with the SendMessage methods.
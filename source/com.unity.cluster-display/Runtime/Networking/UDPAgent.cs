@@ -140,6 +140,10 @@ public void Dispose()
 
         public IPAddress AdapterAddress { get; private set; }
 
+        public IPAddress MulticastAddress => m_Config.MulticastIp;
+
+        public int Port => m_Config.Port;
+
         public int MaximumMessageSize { get; private set; }
 
         public void SendMessage<TM>(MessageType messageType, TM message) where TM: unmanaged
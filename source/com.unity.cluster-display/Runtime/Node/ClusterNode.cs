@@ -36,6 +36,18 @@ struct ClusterNodeConfig
         /// </summary>
         public FrameSyncFence Fence { get; set; }
 
+        /// <summary>
+        /// Number of nodes (with consecutive ids starting at 0) synchronized by the software swap barrier of
+        /// <see cref="FrameSyncFence.Software"/>.
+        /// </summary>
+        public int SoftwareSwapBarrierNodeCount { get; set; }
+
+        /// <summary>
+        /// Do repeaters present their last frame again (through the swap barrier) for every refresh the data of the
+        /// next frame is late?
+        /// </summary>
+        public bool HoldLateFrames { get; set; }
+
         /// <summary>
         /// The input subsystem synchronized by the cluster.
         /// </summary>
@@ -135,7 +135,7 @@ public EmitterNode(ClusterNodeConfig config, EmitterNodeConfig emitterConfig, IU
             EmitterConfig = emitterConfig;
             if (!emitterConfig.RepeatersSurveyResult?.Any() ?? true)
             {
-                SetInitialState(Config.Fence is FrameSyncFence.Hardware ?
+                SetInitialState(Config.Fence is FrameSyncFence.Hardware or FrameSyncFence.Software ?
                     HardwareSyncInitState.Create(this) : new WelcomeRepeatersState(this));
             }
             else
@@ -281,8 +281,7 @@ bool HandleThisNodeNotEmitterAnymore(IReadOnlyList<ClusterTopologyEntry> topolog
         /// <see cref="MessageType"/> that the UdpClient must process upon reception.
         /// </summary>
         static MessageType[] s_ReceiveMessageTypes = {MessageType.RegisteringWithEmitter,
-            MessageType.RetransmitFrameData, MessageType.RepeaterWaitingToStartFrame, MessageType.QuitReceived,
-            MessageType.QuadroBarrierWarmupStatus};
+            MessageType.RetransmitFrameData, MessageType.RepeaterWaitingToStartFrame, MessageType.QuitReceived};
 
         /// <summary>
         /// Last analyzed topology change.
@@ -23,7 +23,7 @@ public RepeaterNode(ClusterNodeConfig config, IUdpAgent udpAgent, bool isBackup
         {
             NodeRole = isBackup ? NodeRole.Backup : NodeRole.Repeater;
             UdpAgent.AddPreProcess(UdpAgentPreProcessPriorityTable.EmitterPlaceholder, PreProcessReceivedMessage);
-            SetInitialState(Config.Fence is FrameSyncFence.Hardware ?
+            SetInitialState(Config.Fence is FrameSyncFence.Hardware or FrameSyncFence.Software ?
                 HardwareSyncInitState.Create(this) : new RegisterWithEmitterState(this));
         }
 
@@ -166,7 +166,7 @@ PreProcessResult PreProcessReceivedMessage(ReceivedMessageBase received)
         /// </summary>
         static MessageType[] s_ReceiveMessageTypes = {MessageType.RepeaterRegistered,
             MessageType.FrameData, MessageType.EmitterWaitingToStartFrame, MessageType.PropagateQuit,
-            MessageType.QuadroBarrierWarmupHeartbeat, MessageType.SurveyRepeaters,
+            MessageType.SurveyRepeaters,
             MessageType.RetransmitReceivedFrameData
         };
 
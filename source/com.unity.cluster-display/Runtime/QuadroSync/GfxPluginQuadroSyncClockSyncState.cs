@@ -0,0 +1,52 @@
+using System;
+using System.Runtime.InteropServices;
+// ReSharper disable UnassignedGetOnlyAutoProperty
+
+namespace Unity.ClusterDisplay
+{
+    /// <summary>
+    /// Estimate of the cluster time (the clock of the emitter) as returned by
+    /// <see cref="GfxPluginQuadroSyncSystem.FetchClockSyncState"/>.
+    /// </summary>
+    /// <remarks>Any change to this struct must be matched in QuadroSyncClockSyncState in GfxQuadroSync.cpp.</remarks>
+    [StructLayout(LayoutKind.Sequential)]
+    public readonly struct GfxPluginQuadroSyncClockSyncState
+    {
+        [MarshalAs(UnmanagedType.U1)]
+        readonly bool m_Valid;
+
+        /// <summary>
+        /// Is the estimate valid (the synchronization is started and at least one sample was received)?
+        /// </summary>
+        public bool Valid => m_Valid;
+        /// <summary>
+        /// Time of this node (in nanoseconds of the plugin's clock) when the state was fetched.
+        /// </summary>
+        public long LocalTimeNs { get; }
+        /// <summary>
+        /// Cluster time (in nanoseconds of the emitter's clock) when the state was fetched.
+        /// </summary>
+        public long ClusterTimeNs { get; }
+        /// <summary>
+        /// To be added to the local time to get the cluster time (in nanoseconds).
+        /// </summary>
+        public long OffsetNs { get; }
+        /// <summary>
+        /// Maximum error on <see cref="OffsetNs"/> (in nanoseconds).
+        /// </summary>
+        public long UncertaintyNs { get; }
+        /// <summary>
+        /// Round trip of the sample the estimate comes from (in nanoseconds).
+        /// </summary>
+        public long RoundTripNs { get; }
+        /// <summary>
+        /// Number of samples received.
+        /// </summary>
+        public ulong SampleCount { get; }
+
+        /// <summary>
+        /// Maximum error on <see cref="OffsetNs"/>.
+        /// </summary>
+        public TimeSpan Uncertainty => TimeSpan.FromTicks(UncertaintyNs / 100);
+    }
+}
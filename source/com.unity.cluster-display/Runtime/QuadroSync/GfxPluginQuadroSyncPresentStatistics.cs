@@ -0,0 +1,144 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace Unity.ClusterDisplay
+{
+    /// <summary>
+    /// Statistics about how long the presents done by the QuadroSync plugin took (which is mostly how long we are
+    /// waiting on the swap barrier) as returned by <see cref="GfxPluginQuadroSyncSystem.FetchPresentStatistics"/>.
+    /// </summary>
+    /// <remarks>Any change to this struct must be matched in QuadroSyncPresentStatistics in GfxQuadroSync.cpp.</remarks>
+    [StructLayout(LayoutKind.Sequential)]
+    public unsafe struct GfxPluginQuadroSyncPresentStatistics
+    {
+        /// <summary>
+        /// Number of worst presents kept in the statistics.
+        /// </summary>
+        public const int OutlierCount = 8;
+        /// <summary>
+        /// Number of bits used for the linear sub-buckets of each power of two of the histogram.
+        /// </summary>
+        public const int HistogramSubBucketBits = 6;
+        /// <summary>
+        /// Number of buckets of the histogram.
+        /// </summary>
+        public const int HistogramBucketCount = 1408;
+
+        /// <summary>
+        /// Create a new <see cref="GfxPluginQuadroSyncPresentStatistics"/> ready to be filled by the plugin.
+        /// </summary>
+        public static GfxPluginQuadroSyncPresentStatistics Create()
+        {
+            var ret = new GfxPluginQuadroSyncPresentStatistics();
+            ret.m_Size = (uint)Marshal.SizeOf<GfxPluginQuadroSyncPresentStatistics>();
+            return ret;
+        }
+
+        /// <summary>
+        /// Version of the struct as filled by the plugin.
+        /// </summary>
+        public uint Version => m_Version;
+        /// <summary>
+        /// Number of presents measured.
+        /// </summary>
+        public ulong Count => m_Count;
+        /// <summary>
+        /// Shortest present.
+        /// </summary>
+        public TimeSpan Min => TimeSpanFromMicroseconds(m_MinUs);
+        /// <summary>
+        /// Longest present.
+        /// </summary>
+        public TimeSpan Max => TimeSpanFromMicroseconds(m_MaxUs);
+        /// <summary>
+        /// Average duration of the presents.
+        /// </summary>
+        public TimeSpan Mean => m_Count > 0 ? TimeSpanFromMicroseconds(m_SumUs / m_Count) : TimeSpan.Zero;
+
+        /// <summary>
+        /// Returns one of the worst recent presents.
+        /// </summary>
+        /// <param name="index">Index of the outlier, 0 being the longest one.</param>
+        /// <returns>Duration of the present and its index (lower 32 bits).  Duration is 0 for unused entries.</returns>
+        public (TimeSpan Duration, uint PresentIndex) GetOutlier(int index)
+        {
+            if (index is < 0 or >= OutlierCount)
+            {
+                throw new ArgumentOutOfRangeException(nameof(index));
+            }
+            return (TimeSpanFromMicroseconds(m_Outliers[index * 2]), m_Outliers[index * 2 + 1]);
+        }
+
+        /// <summary>
+        /// Returns the number of presents counted in a bucket of the histogram.
+        /// </summary>
+        /// <param name="index">Index of the bucket.</param>
+        public ulong GetHistogramBucket(int index)
+        {
+            if (index is < 0 or >= HistogramBucketCount)
+            {
+                throw new ArgumentOutOfRangeException(nameof(index));
+            }
+            return m_Histogram[index];
+        }
+
+        /// <summary>
+        /// Returns the shortest duration counted in a bucket of the histogram.
+        /// </summary>
+        /// <param name="index">Index of the bucket.</param>
+        public static TimeSpan GetHistogramBucketLowerBound(int index)
+        {
+            const int subBucketCount = 1 << HistogramSubBucketBits;
+            if (index < subBucketCount * 2)
+            {
+                return TimeSpanFromMicroseconds((ulong)index);
+            }
+            int shift = index / subBucketCount - 1;
+            ulong subBucket = (ulong)(index % subBucketCount + subBucketCount);
+            return TimeSpanFromMicroseconds(subBucket << shift);
+        }
+
+        /// <summary>
+        /// Returns an approximation (precise to the size of the histogram's buckets) of the given percentile.
+        /// </summary>
+        /// <param name="percentile">Percentile in the [0, 100] range.</param>
+        public TimeSpan GetPercentile(double percentile)
+        {
+            ulong total = 0;
+            for (int i = 0; i < HistogramBucketCount; ++i)
+            {
+                total += m_Histogram[i];
+            }
+            if (total == 0)
+            {
+                return TimeSpan.Zero;
+            }
+
+            var threshold = (ulong)Math.Ceiling(total * Math.Clamp(percentile, 0.0, 100.0) / 100.0);
+            ulong cumulated = 0;
+            for (int i = 0; i < HistogramBucketCount; ++i)
+            {
+                cumulated += m_Histogram[i];
+                if (cumulated >= threshold && cumulated > 0)
+                {
+                    return GetHistogramBucketLowerBound(i);
+                }
+            }
+            return GetHistogramBucketLowerBound(HistogramBucketCount - 1);
+        }
+
+        static TimeSpan TimeSpanFromMicroseconds(ulong microseconds) =>
+            TimeSpan.FromTicks((long)microseconds * (TimeSpan.TicksPerMillisecond / 1000));
+
+        uint m_Size;
+        uint m_Version;
+        ulong m_Count;
+        ulong m_SumUs;
+        ulong m_MinUs;
+        ulong m_MaxUs;
+        fixed uint m_Outliers[OutlierCount * 2];
+        uint m_HistogramSubBucketBits;
+        uint m_HistogramBucketCount;
+        fixed ulong m_Histogram[HistogramBucketCount];
+    }
+}
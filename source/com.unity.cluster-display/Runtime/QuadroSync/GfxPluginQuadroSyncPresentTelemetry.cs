@@ -0,0 +1,222 @@
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Threading;
+
+namespace Unity.ClusterDisplay
+{
+    /// <summary>
+    /// Information about a single present done by the QuadroSync plugin.
+    /// </summary>
+    public readonly struct GfxPluginQuadroSyncPresentRecord
+    {
+        internal GfxPluginQuadroSyncPresentRecord(ulong recordIndex, ulong frameIndex, long presentStartTick,
+            long presentEndTick, long ticksPerSecond, int status, bool skippedSync,
+            GfxPluginQuadroSyncSystem.BarrierWarmupAction? warmupAction, ushort repeatIndex)
+        {
+            RecordIndex = recordIndex;
+            FrameIndex = frameIndex;
+            PresentStartTick = presentStartTick;
+            PresentEndTick = presentEndTick;
+            m_TicksPerSecond = ticksPerSecond;
+            Status = status;
+            SkippedSync = skippedSync;
+            WarmupAction = warmupAction;
+            RepeatIndex = repeatIndex;
+        }
+
+        /// <summary>
+        /// Index of the record since the plugin was loaded.
+        /// </summary>
+        public ulong RecordIndex { get; }
+        /// <summary>
+        /// Index of the frame (number of synchronized presents requested to the plugin).
+        /// </summary>
+        public ulong FrameIndex { get; }
+        /// <summary>
+        /// Performance counter tick (same time base as <see cref="System.Diagnostics.Stopwatch.GetTimestamp"/> on
+        /// Windows) when present was entered.
+        /// </summary>
+        public long PresentStartTick { get; }
+        /// <summary>
+        /// Performance counter tick when present returned.
+        /// </summary>
+        public long PresentEndTick { get; }
+        /// <summary>
+        /// How long the present took.
+        /// </summary>
+        public TimeSpan Duration => m_TicksPerSecond > 0 ?
+            TimeSpan.FromSeconds((PresentEndTick - PresentStartTick) / (double)m_TicksPerSecond) : TimeSpan.Zero;
+        /// <summary>
+        /// Status returned by the present call (0 if successful).
+        /// </summary>
+        public int Status { get; }
+        /// <summary>
+        /// Was the synchronized present skipped?
+        /// </summary>
+        public bool SkippedSync { get; }
+        /// <summary>
+        /// Barrier warmup action taken after the present (null if the barrier was not warming up).
+        /// </summary>
+        public GfxPluginQuadroSyncSystem.BarrierWarmupAction? WarmupAction { get; }
+        /// <summary>
+        /// Index of the present repeat (0 for the first present of a frame).
+        /// </summary>
+        public ushort RepeatIndex { get; }
+
+        readonly long m_TicksPerSecond;
+    }
+
+    /// <summary>
+    /// Gives access to the ring of <see cref="GfxPluginQuadroSyncPresentRecord"/> maintained by the QuadroSync plugin.
+    /// </summary>
+    /// <remarks>The ring lives in native memory and is read directly using a seqlock protocol, so there is no P/Invoke
+    /// involved in reading it.  The same ring is also available to other processes in a shared memory block named
+    /// "GfxPluginQuadroSyncTelemetry_&lt;process id&gt;".<br/><br/>
+    /// Any change to the layout must be matched in PresentTelemetry.h.</remarks>
+    public unsafe class GfxPluginQuadroSyncPresentTelemetry
+    {
+        /// <summary>
+        /// Returns access to the present telemetry ring of the plugin.
+        /// </summary>
+        /// <returns>The telemetry or null if the plugin does not provide telemetry (or provides an unknown version).
+        /// </returns>
+        public static GfxPluginQuadroSyncPresentTelemetry Open()
+        {
+            var header = (Header*)GfxPluginQuadroSyncSystem.GfxPluginQuadroSyncUtilities.GetPresentTelemetry().ToPointer();
+            if (header == null || header->Magic != k_Magic || header->Version != k_Version ||
+                header->RecordSize != sizeof(Record) || header->RecordCount == 0)
+            {
+                return null;
+            }
+            return new GfxPluginQuadroSyncPresentTelemetry(header);
+        }
+
+        /// <summary>
+        /// Number of records written since the plugin was loaded.
+        /// </summary>
+        public ulong WriteIndex => Volatile.Read(ref m_Header->WriteIndex);
+
+        /// <summary>
+        /// Number of records kept in the ring.
+        /// </summary>
+        public uint Capacity => m_Header->RecordCount;
+
+        /// <summary>
+        /// Try to read a record.
+        /// </summary>
+        /// <param name="recordIndex">Index of the record to read.</param>
+        /// <param name="record">Receives the record.</param>
+        /// <returns>Was the record read?  It will fail if it is not yet written or was already overwritten.</returns>
+        public bool TryRead(ulong recordIndex, out GfxPluginQuadroSyncPresentRecord record)
+        {
+            var source = m_Records + recordIndex % m_Header->RecordCount;
+            for (int attempt = 0; attempt < k_MaxReadAttempts; ++attempt)
+            {
+                uint sequenceBefore = Volatile.Read(ref source->Sequence);
+                if ((sequenceBefore & 1) != 0)
+                {
+                    // Writer is in the middle of updating it, try again.
+                    continue;
+                }
+
+                var copy = *source;
+
+                Interlocked.MemoryBarrier();
+                if (Volatile.Read(ref source->Sequence) != sequenceBefore)
+                {
+                    continue;
+                }
+
+                if (copy.RecordIndex != recordIndex)
+                {
+                    break;
+                }
+
+                record = new(copy.RecordIndex, copy.FrameIndex, (long)copy.PresentStartTick,
+                    (long)copy.PresentEndTick, (long)m_Header->PerformanceCounterFrequency, copy.Status,
+                    copy.SkippedSync != 0,
+                    copy.WarmupAction != k_NoWarmupAction ?
+                        (GfxPluginQuadroSyncSystem.BarrierWarmupAction)copy.WarmupAction : null,
+                    copy.RepeatIndex);
+                return true;
+            }
+
+            record = default;
+            return false;
+        }
+
+        /// <summary>
+        /// Read all the records written since the last call to this method.
+        /// </summary>
+        /// <param name="records">List to which records are added.</param>
+        /// <returns>Number of records that were lost (overwritten before we had the time to read them).</returns>
+        public ulong ReadNew(List<GfxPluginQuadroSyncPresentRecord> records)
+        {
+            ulong writeIndex = WriteIndex;
+            ulong lost = 0;
+            if (writeIndex - m_NextReadIndex > m_Header->RecordCount)
+            {
+                lost = writeIndex - m_Header->RecordCount - m_NextReadIndex;
+                m_NextReadIndex = writeIndex - m_Header->RecordCount;
+            }
+
+            for (; m_NextReadIndex < writeIndex; ++m_NextReadIndex)
+            {
+                if (TryRead(m_NextReadIndex, out var record))
+                {
+                    records.Add(record);
+                }
+                else
+                {
+                    ++lost;
+                }
+            }
+            return lost;
+        }
+
+        GfxPluginQuadroSyncPresentTelemetry(Header* header)
+        {
+            m_Header = header;
+            m_Records = (Record*)((byte*)header + header->HeaderSize);
+            m_NextReadIndex = WriteIndex;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        struct Header
+        {
+            public uint Magic;
+            public uint Version;
+            public uint HeaderSize;
+            public uint RecordSize;
+            public uint RecordCount;
+            public uint Reserved;
+            public ulong PerformanceCounterFrequency;
+            public ulong WriteIndex;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        struct Record
+        {
+            public uint Sequence;
+            public int Status;
+            public ulong RecordIndex;
+            public ulong FrameIndex;
+            public ulong PresentStartTick;
+            public ulong PresentEndTick;
+            public byte SkippedSync;
+            public byte WarmupAction;
+            public ushort RepeatIndex;
+            public uint Reserved;
+        }
+
+        const uint k_Magic = 0x54505147;
+        const uint k_Version = 1;
+        const byte k_NoWarmupAction = 0xFF;
+        const int k_MaxReadAttempts = 16;
+
+        readonly Header* m_Header;
+        readonly Record* m_Records;
+        ulong m_NextReadIndex;
+    }
+}
@@ -75,6 +75,10 @@ public enum GfxPluginQuadroSyncInitializationState
         /// Warmup of the swap barrier took longer than expected.
         /// </summary>
         BarrierWarmupTimeout = 15,
+        /// <summary>
+        /// Warmup of the swap barrier failed to communicate with the other nodes.
+        /// </summary>
+        BarrierWarmupNetworkFailure = 16,
     }
 
     public static class GfxPluginQuadroSyncInitializationStateExtension
@@ -104,6 +108,7 @@ enumValue switch
                 GfxPluginQuadroSyncInitializationState.UnexpectedException => "Unexpected exception during the initialization process",
                 GfxPluginQuadroSyncInitializationState.UnexpectedTermination => "Unexpected end of cluster display system",
                 GfxPluginQuadroSyncInitializationState.BarrierWarmupTimeout => "Timeout during warmup of the swap barrier",
+                GfxPluginQuadroSyncInitializationState.BarrierWarmupNetworkFailure => "Network failure during warmup of the swap barrier",
                 _ => "Unknown initialization state"
             };
 
@@ -116,9 +121,67 @@ enumValue switch
             };
     }
 
+    /// <summary>
+    /// State of the swap barrier warmup performed by the GfxPluginQuadroSyncSystem plugin.
+    /// </summary>
+    /// <remarks>Any change must be reflected in BarrierWarmupState in BarrierWarmup.h.</remarks>
+    public enum GfxPluginQuadroSyncBarrierWarmupState
+    {
+        /// <summary>
+        /// Warmup of the swap barrier has not been started.
+        /// </summary>
+        NotStarted = 0,
+        /// <summary>
+        /// Nodes are presenting in a coordinated way until their swap barrier is warmed up.
+        /// </summary>
+        InProgress = 1,
+        /// <summary>
+        /// Swap barrier is warmed up and every node has done the same number of presents.
+        /// </summary>
+        Succeeded = 2,
+        /// <summary>
+        /// Warmup of the swap barrier took longer than the allowed time.
+        /// </summary>
+        Timeout = 3,
+        /// <summary>
+        /// Warmup was aborted (by <see cref="GfxPluginQuadroSyncSystem.AbortBarrierWarmup"/>).
+        /// </summary>
+        Aborted = 4,
+        /// <summary>
+        /// Failed to setup communication with the other nodes of the cluster.
+        /// </summary>
+        NetworkFailure = 5,
+    }
+
+    /// <summary>
+    /// Lifecycle of the graphics device and swap chain the GfxPluginQuadroSyncSystem plugin presents to.
+    /// </summary>
+    /// <remarks>Any change must be reflected in GraphicsContextState in GfxQuadroSync.cpp.</remarks>
+    public enum GfxPluginQuadroSyncGraphicsContextState
+    {
+        /// <summary>
+        /// No graphics device (plugin not initialized or device shut down).
+        /// </summary>
+        NoDevice = 0,
+        /// <summary>
+        /// Device and swap chain have to be validated (again) before being used.
+        /// </summary>
+        Unvalidated = 1,
+        /// <summary>
+        /// Unity is resetting the device, the plugin does not present until it is done.
+        /// </summary>
+        Resetting = 2,
+        /// <summary>
+        /// Device and swap chain were validated and are used to present.
+        /// </summary>
+        Valid = 3,
+    }
+
     /// <summary>
     /// Status of the QuadroSync plugin as returned by <see cref="GfxPluginQuadroSyncSystem.FetchState"/>.
     /// </summary>
+    /// <remarks>Any change must be reflected in QuadroSyncState in GfxQuadroSync.cpp, new properties must always be
+    /// added at the end (see <see cref="GfxPluginQuadroSyncStateBlock"/>).</remarks>
     [StructLayout(LayoutKind.Sequential)]
     public readonly struct GfxPluginQuadroSyncState
     {
@@ -142,5 +205,110 @@ enumValue switch
         /// Number of frames that failed to be presented using QuadroSync's present call
         /// </summary>
         public ulong PresentedFramesFailure { get; }
+        /// <summary>
+        /// Number of times the hardware frame counter was queried (it is only queried once in a while and extrapolated
+        /// in between).
+        /// </summary>
+        public ulong FrameCountHardwareQueries { get; }
+        /// <summary>
+        /// Number of frame counts that were extrapolated instead of queried from the hardware.
+        /// </summary>
+        public ulong FrameCountExtrapolations { get; }
+        /// <summary>
+        /// Difference (in frames) between the hardware and extrapolated frame count measured on the last hardware query.
+        /// </summary>
+        public int FrameCountLastExtrapolationError { get; }
+        /// <summary>
+        /// Largest absolute difference (in frames) between the hardware and extrapolated frame count.
+        /// </summary>
+        public uint FrameCountMaxExtrapolationError { get; }
+        /// <summary>
+        /// State of the swap barrier warmup.
+        /// </summary>
+        public GfxPluginQuadroSyncBarrierWarmupState BarrierWarmupState { get; }
+        /// <summary>
+        /// Number of presents the emitter did while repeaters were paused during the swap barrier warmup (indicates how
+        /// many frames are queued in the present pipeline).
+        /// </summary>
+        public uint BarrierWarmupPresentWhileRepeatersArePaused { get; }
+        /// <summary>
+        /// Duration of the swap barrier warmup in microseconds (up to now if it is still in progress).
+        /// </summary>
+        public ulong BarrierWarmupDurationUs { get; }
+        /// <summary>
+        /// Number of times the software swap barrier was released (0 when using the Quadro Sync hardware, see
+        /// <see cref="GfxPluginQuadroSyncSystem.UseSoftwareSwapBarrier"/>).
+        /// </summary>
+        public ulong SoftwareBarrierReleases { get; }
+        /// <summary>
+        /// Number of times the software swap barrier timed out waiting on other nodes.
+        /// </summary>
+        public ulong SoftwareBarrierTimeouts { get; }
+        /// <summary>
+        /// Number of scheduled presents whose time was already passed when the plugin started waiting (see
+        /// <see cref="GfxPluginQuadroSyncSystem.UseScheduledPresents"/>).
+        /// </summary>
+        public ulong ScheduledPresentsLate { get; }
+        /// <summary>
+        /// Number of scheduled presents for which the time assigned by the emitter was not received in time.
+        /// </summary>
+        public ulong ScheduledPresentsMissingTarget { get; }
+        /// <summary>
+        /// State of the graphics device and swap chain the plugin presents to.
+        /// </summary>
+        public GfxPluginQuadroSyncGraphicsContextState GraphicsContextState { get; }
+        /// <summary>
+        /// Number of times the graphics device and swap chain were validated (again after every device reset).
+        /// </summary>
+        public ulong GraphicsContextValidations { get; }
+        /// <summary>
+        /// Number of times the swap chain was replaced by Unity and put back in the swap group.
+        /// </summary>
+        public ulong SwapGroupRejoins { get; }
+        /// <summary>
+        /// Number of swap group rejoins after which the swap barrier had to be bound (and warmed up) again.
+        /// </summary>
+        public ulong SwapGroupRejoinWarmups { get; }
+        /// <summary>
+        /// Time spent by the last swap group rejoin in microseconds (not including the warmup).
+        /// </summary>
+        public ulong LastSwapGroupRejoinDurationUs { get; }
+        /// <summary>
+        /// Number of times the resources used to repeat presents during swap barrier warmups were allocated.
+        /// </summary>
+        public ulong SavedFrameAllocations { get; }
+        /// <summary>
+        /// Number of swap barrier warmups that reused the resources allocated by a previous warmup.
+        /// </summary>
+        public ulong SavedFrameReuses { get; }
+        /// <summary>
+        /// Number of times these resources were released because the back buffers were resized or the device lost.
+        /// </summary>
+        public ulong SavedFrameReleases { get; }
+        /// <summary>
+        /// Number of presents of a held frame (QuadroSyncHoldFrame render event).
+        /// </summary>
+        public ulong HeldFrames { get; }
+        /// <summary>
+        /// Number of frame holds that could not present the held frame.
+        /// </summary>
+        public ulong FrameHoldFailures { get; }
+        /// <summary>
+        /// Number of frames presented by the present worker thread.
+        /// </summary>
+        public ulong AsyncPresents { get; }
+        /// <summary>
+        /// Number of frames for which the rendering thread had to wait on the present worker (too many frames in
+        /// flight).
+        /// </summary>
+        public ulong AsyncPresentStalls { get; }
+        /// <summary>
+        /// Total time the rendering thread waited on the present worker in microseconds.
+        /// </summary>
+        public ulong AsyncPresentStallUs { get; }
+        /// <summary>
+        /// Number of log messages of the plugin dropped because they were logged faster than they could be delivered.
+        /// </summary>
+        public ulong DroppedLogMessages { get; }
     }
 }
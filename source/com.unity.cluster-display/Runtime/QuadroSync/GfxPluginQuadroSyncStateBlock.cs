@@ -0,0 +1,103 @@
+using System;
+using System.Runtime.InteropServices;
+using System.Threading;
+
+namespace Unity.ClusterDisplay
+{
+    /// <summary>
+    /// Gives access to the <see cref="GfxPluginQuadroSyncState"/> published by the QuadroSync plugin after every frame,
+    /// render event and device event.
+    /// </summary>
+    /// <remarks>The state lives in native memory and is read directly using a seqlock protocol, so there is no
+    /// P/Invoke involved in reading it and every property of a read state is consistent with the others.  The state
+    /// only grows at the end, so properties unknown to the plugin keep their default value.<br/><br/>
+    /// Any change to the layout of the header must be matched in StateBlock.h.</remarks>
+    public unsafe class GfxPluginQuadroSyncStateBlock
+    {
+        /// <summary>
+        /// Returns access to the state block of the plugin.
+        /// </summary>
+        /// <returns>The state block or null if the plugin does not provide it (or provides an unknown version).
+        /// </returns>
+        public static GfxPluginQuadroSyncStateBlock Open()
+        {
+            var header = (Header*)GfxPluginQuadroSyncSystem.GfxPluginQuadroSyncUtilities.GetStateBlock().ToPointer();
+            if (header == null || header->Magic != k_Magic || header->Version != k_Version ||
+                header->HeaderSize < sizeof(Header))
+            {
+                return null;
+            }
+            return new GfxPluginQuadroSyncStateBlock(header);
+        }
+
+        /// <summary>
+        /// Number of times the plugin published its state.
+        /// </summary>
+        public ulong PublishCount => Volatile.Read(ref m_Header->PublishCount);
+
+        /// <summary>
+        /// Try to read the last state published by the plugin.
+        /// </summary>
+        /// <param name="state">Receives the state.</param>
+        /// <returns>Was the state read?  It will fail if nothing was published yet or if the plugin kept publishing
+        /// while we were reading it.</returns>
+        public bool TryRead(out GfxPluginQuadroSyncState state)
+        {
+            state = default;
+            if (PublishCount == 0)
+            {
+                return false;
+            }
+
+            var copySize = Math.Min(m_Header->StateSize, (uint)sizeof(GfxPluginQuadroSyncState));
+            for (int attempt = 0; attempt < k_MaxReadAttempts; ++attempt)
+            {
+                uint sequenceBefore = Volatile.Read(ref m_Header->Sequence);
+                if ((sequenceBefore & 1) != 0)
+                {
+                    // Plugin is in the middle of publishing it, try again.
+                    continue;
+                }
+
+                GfxPluginQuadroSyncState copy = default;
+                Buffer.MemoryCopy(m_State, &copy, sizeof(GfxPluginQuadroSyncState), copySize);
+
+                Interlocked.MemoryBarrier();
+                if (Volatile.Read(ref m_Header->Sequence) != sequenceBefore)
+                {
+                    continue;
+                }
+
+                state = copy;
+                return true;
+            }
+
+            return false;
+        }
+
+        GfxPluginQuadroSyncStateBlock(Header* header)
+        {
+            m_Header = header;
+            m_State = (byte*)header + header->HeaderSize;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        struct Header
+        {
+            public uint Magic;
+            public uint Version;
+            public uint HeaderSize;
+            public uint StateSize;
+            public uint Sequence;
+            public uint Reserved;
+            public ulong PublishCount;
+        }
+
+        const uint k_Magic = 0x42535147;
+        const uint k_Version = 1;
+        const int k_MaxReadAttempts = 16;
+
+        readonly Header* m_Header;
+        readonly byte* m_State;
+    }
+}
@@ -3,6 +3,7 @@
 using System.Runtime.InteropServices;
 using UnityEngine;
 using UnityEngine.Rendering;
+using Utils;
 
 [assembly: InternalsVisibleTo("Unity.ClusterDisplay.Editor.Tests")]
 
@@ -65,11 +66,33 @@ public enum EQuadroSyncRenderEvent
             /// <summary>
             /// Indicate to QuadroSync that the next frame should be presented without performing any synchronization.
             /// </summary>
-            QuadroSyncSkipSyncForNextFrame
+            QuadroSyncSkipSyncForNextFrame,
+
+            /// <summary>
+            /// Enables or disables saving every frame so that it can be presented again by
+            /// <see cref="QuadroSyncHoldFrame"/> (D3D11 and D3D12).
+            /// </summary>
+            QuadroSyncEnableFrameHold,
+
+            /// <summary>
+            /// Presents the last frame again through the swap barrier because the next one is not ready in time.
+            /// </summary>
+            QuadroSyncHoldFrame,
+
+            /// <summary>
+            /// Presents from a native worker thread (D3D12), data is the number of frames that can be waiting to be
+            /// presented (0 to present from the rendering thread again).
+            /// </summary>
+            QuadroSyncEnableAsyncPresent,
+
+            /// <summary>
+            /// Waits for every frame handed to the present worker thread to be presented.
+            /// </summary>
+            QuadroSyncWaitForPresent
         }
 
         /// <summary>
-        /// How QuadroSync must behave following a call to the BarrierWarmupCallback.
+        /// How QuadroSync behaves following a present done while the swap barrier is warming up.
         /// </summary>
         public enum BarrierWarmupAction
         {
@@ -82,21 +105,64 @@ public enum BarrierWarmupAction
             /// </summary>
             ContinueToNextFrame,
             /// <summary>
-            /// Consider QuadroSync Barrier as warmed up and ready to be used (so the warmup callback will not be called
-            /// anymore).
+            /// Consider QuadroSync Barrier as warmed up and ready to be used.
             /// </summary>
             BarrierWarmedUp
         }
 
+        /// <summary>
+        /// Statistics of the software swap barrier that can be fetched with
+        /// <see cref="FetchSoftwareSwapBarrierStatistics"/>.
+        /// </summary>
+        /// <remarks>Any change must be reflected in SoftwareSwapBarrierStatistic in GfxQuadroSync.cpp.</remarks>
+        public enum SoftwareSwapBarrierStatistic
+        {
+            /// <summary>
+            /// Time between the arrival of this node at the barrier and its release.
+            /// </summary>
+            BarrierWait = 0,
+            /// <summary>
+            /// Time between the first and last node to be released (only meaningful when nodes share the same clock).
+            /// </summary>
+            ReleaseSkew = 1,
+            /// <summary>
+            /// Time between the release of the barrier of the instances running on the same computer by their
+            /// representative and this instance waking up.
+            /// </summary>
+            HostReleaseLatency = 2
+        }
+
+        /// <summary>
+        /// Algorithm used by the software swap barrier to synchronize the nodes (every node must use the same one).
+        /// </summary>
+        /// <remarks>Any change must be reflected in SoftwareSyncApi::BarrierAlgorithm in SoftwareSyncApi.h.</remarks>
+        public enum SoftwareSwapBarrierAlgorithm : byte
+        {
+            /// <summary>
+            /// Every node multicasts its arrival and waits on the arrival of every other node.
+            /// </summary>
+            AllToAll = 0,
+            /// <summary>
+            /// Arrivals are combined up a tree of fan-out children per node, the root multicasts the release (scales to
+            /// large clusters).  Leaves that stop responding are dropped after the timeout, every node falls back to
+            /// <see cref="AllToAll"/> when a parent (or a child having children of its own) times out twice in a row.
+            /// </summary>
+            Tree = 1,
+            /// <summary>
+            /// Every node notifies fan-out other nodes per round for log(nodes) / log(fan-out + 1) rounds.
+            /// </summary>
+            Dissemination = 2
+        }
+
         internal static class GfxPluginQuadroSyncUtilities
         {
 #if UNITY_EDITOR_WIN
             const string k_DLLPath = "Packages/com.unity.cluster-display/Runtime/Plugins/x86_64/GfxPluginQuadroSync.dll";
-#elif UNITY_STANDALONE
-            const string k_DLLPath = "GfxPluginQuadroSync";
+#elif UNITY_EDITOR_LINUX
+            const string k_DLLPath =
+                "Packages/com.unity.cluster-display/Runtime/Plugins/x86_64/libGfxPluginQuadroSync.so";
 #else
-            const string k_DLLPath = "";
-#error "System not implemented"
+            const string k_DLLPath = "GfxPluginQuadroSync";
 #endif
             [UnmanagedFunctionPointer(CallingConvention.StdCall)]
             public delegate void NewLogMessageCallback(int logType, IntPtr message);
@@ -108,11 +174,139 @@ internal static class GfxPluginQuadroSyncUtilities
             public static extern void SetLogCallback(
                 [MarshalAs(UnmanagedType.FunctionPtr)] NewLogMessageCallback newLogMessageCallback);
 
+            /// <summary>
+            /// Parameters of <see cref="StartBarrierWarmup"/>.
+            /// </summary>
+            /// <remarks>Any change to this struct must be matched in QuadroSyncBarrierWarmupParameters in
+            /// GfxQuadroSync.cpp.</remarks>
+            [StructLayout(LayoutKind.Sequential)]
+            public struct BarrierWarmupParameters
+            {
+                [MarshalAs(UnmanagedType.LPStr)]
+                public string MulticastAddress;
+                [MarshalAs(UnmanagedType.LPStr)]
+                public string AdapterAddress;
+                public ushort Port;
+                public byte NodeId;
+                [MarshalAs(UnmanagedType.U1)]
+                public bool IsEmitter;
+                public uint PresentsToSkip;
+                public uint TimeoutMs;
+                public ulong Repeaters0;
+                public ulong Repeaters1;
+                public ulong Repeaters2;
+                public ulong Repeaters3;
+            }
+
+            [DllImport(k_DLLPath, CharSet = CharSet.Ansi, CallingConvention = CallingConvention.StdCall)]
+            [return: MarshalAs(UnmanagedType.I1)]
+            public static extern bool StartBarrierWarmup(ref BarrierWarmupParameters parameters);
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            public static extern void AbortBarrierWarmup();
+
+            /// <summary>
+            /// Parameters of <see cref="UseSoftwareSwapBarrier"/>.
+            /// </summary>
+            /// <remarks>Any change to this struct must be matched in QuadroSyncSoftwareSwapBarrierParameters in
+            /// GfxQuadroSync.cpp.</remarks>
+            [StructLayout(LayoutKind.Sequential)]
+            public struct SoftwareSwapBarrierParameters
+            {
+                [MarshalAs(UnmanagedType.LPStr)]
+                public string MulticastAddress;
+                [MarshalAs(UnmanagedType.LPStr)]
+                public string AdapterAddress;
+                public ushort Port;
+                public byte NodeId;
+                public uint TimeoutMs;
+                public ulong Nodes0;
+                public ulong Nodes1;
+                public ulong Nodes2;
+                public ulong Nodes3;
+                [MarshalAs(UnmanagedType.LPStr)]
+                public string HostBarrierName;
+                public byte HostInstanceCount;
+                public byte HostInstanceIndex;
+                public SoftwareSwapBarrierAlgorithm Algorithm;
+                public byte FanOut;
+            }
+
+            [DllImport(k_DLLPath, CharSet = CharSet.Ansi, CallingConvention = CallingConvention.StdCall)]
+            [return: MarshalAs(UnmanagedType.I1)]
+            public static extern bool UseSoftwareSwapBarrier(ref SoftwareSwapBarrierParameters parameters);
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            [return: MarshalAs(UnmanagedType.I1)]
+            public static extern bool GetSoftwareSwapBarrierStatistics(SoftwareSwapBarrierStatistic statistic,
+                ref GfxPluginQuadroSyncPresentStatistics statistics);
+
+            /// <summary>
+            /// Parameters of <see cref="StartClockSync"/>.
+            /// </summary>
+            /// <remarks>Any change to this struct must be matched in QuadroSyncClockSyncParameters in
+            /// GfxQuadroSync.cpp.</remarks>
+            [StructLayout(LayoutKind.Sequential)]
+            public struct ClockSyncParameters
+            {
+                [MarshalAs(UnmanagedType.LPStr)]
+                public string MulticastAddress;
+                [MarshalAs(UnmanagedType.LPStr)]
+                public string AdapterAddress;
+                public ushort Port;
+                public byte NodeId;
+                [MarshalAs(UnmanagedType.U1)]
+                public bool IsEmitter;
+                public uint ProbeIntervalMs;
+            }
+
             [DllImport(k_DLLPath, CharSet = CharSet.Ansi, CallingConvention = CallingConvention.StdCall)]
-            public static extern void SetBarrierWarmupCallback(IntPtr barrierWarmupCallback);
+            [return: MarshalAs(UnmanagedType.I1)]
+            public static extern bool StartClockSync(ref ClockSyncParameters parameters);
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            public static extern void GetClockSyncState(ref GfxPluginQuadroSyncClockSyncState state);
+
+            /// <summary>
+            /// Parameters of <see cref="UseScheduledPresents"/>.
+            /// </summary>
+            /// <remarks>Any change to this struct must be matched in QuadroSyncScheduledPresentsParameters in
+            /// GfxQuadroSync.cpp.</remarks>
+            [StructLayout(LayoutKind.Sequential)]
+            public struct ScheduledPresentsParameters
+            {
+                [MarshalAs(UnmanagedType.LPStr)]
+                public string MulticastAddress;
+                [MarshalAs(UnmanagedType.LPStr)]
+                public string AdapterAddress;
+                public ushort Port;
+                [MarshalAs(UnmanagedType.U1)]
+                public bool IsEmitter;
+                public byte LeadPeriods;
+                public uint RefreshPeriodUs;
+            }
+
+            [DllImport(k_DLLPath, CharSet = CharSet.Ansi, CallingConvention = CallingConvention.StdCall)]
+            [return: MarshalAs(UnmanagedType.I1)]
+            public static extern bool UseScheduledPresents(ref ScheduledPresentsParameters parameters);
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            [return: MarshalAs(UnmanagedType.I1)]
+            public static extern bool GetScheduledPresentJitterStatistics(
+                ref GfxPluginQuadroSyncPresentStatistics statistics);
 
             [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
             public static extern void GetState(ref GfxPluginQuadroSyncState state);
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            [return: MarshalAs(UnmanagedType.I1)]
+            public static extern bool GetPresentStatistics(ref GfxPluginQuadroSyncPresentStatistics statistics);
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            public static extern IntPtr GetPresentTelemetry();
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            public static extern IntPtr GetStateBlock();
         }
 
         static GfxPluginQuadroSyncSystem()
@@ -139,7 +333,6 @@ public static void DisableLogging()
         static void ClearCallbacks()
         {
             GfxPluginQuadroSyncUtilities.SetLogCallback(null);
-            GfxPluginQuadroSyncUtilities.SetBarrierWarmupCallback(IntPtr.Zero);
         }
 
         /// <summary>
@@ -152,7 +345,9 @@ public static void ExecuteQuadroSyncCommand(EQuadroSyncRenderEvent id, IntPtr da
             var cmdBuffer = new CommandBuffer();
 
             if (SystemInfo.graphicsDeviceType == GraphicsDeviceType.Direct3D11 ||
-                SystemInfo.graphicsDeviceType == GraphicsDeviceType.Direct3D12)
+                SystemInfo.graphicsDeviceType == GraphicsDeviceType.Direct3D12 ||
+                SystemInfo.graphicsDeviceType == GraphicsDeviceType.Vulkan ||
+                SystemInfo.graphicsDeviceType == GraphicsDeviceType.OpenGLCore)
             {
                 cmdBuffer.IssuePluginEventAndData(GfxPluginQuadroSyncUtilities.GetRenderEventFunc(), (int)id, data);
             }
@@ -161,33 +356,262 @@ public static void ExecuteQuadroSyncCommand(EQuadroSyncRenderEvent id, IntPtr da
         }
 
         /// <summary>
-        /// Sets the callback to call to ensure all nodes are properly synchronized while quadro sync barrier is warming
-        /// up.
+        /// Enables or disables saving every frame before presenting it so that it can be presented again by
+        /// <see cref="HoldFrame"/>.
+        /// </summary>
+        /// <param name="value">Save frames?</param>
+        public static void EnableFrameHold(bool value)
+        {
+            ExecuteQuadroSyncCommand(EQuadroSyncRenderEvent.QuadroSyncEnableFrameHold, new IntPtr(value ? 1 : 0));
+        }
+
+        /// <summary>
+        /// Presents the last frame again through the swap barrier (when the next one will not be ready for the next
+        /// refresh) so that the other nodes keep presenting at the refresh rate instead of waiting on this one.
+        /// </summary>
+        /// <remarks>Does nothing if <see cref="EnableFrameHold"/> was not called, the number of frames held can be
+        /// followed through <see cref="GfxPluginQuadroSyncState.HeldFrames"/>.</remarks>
+        public static void HoldFrame()
+        {
+            ExecuteQuadroSyncCommand(EQuadroSyncRenderEvent.QuadroSyncHoldFrame, IntPtr.Zero);
+        }
+
+        /// <summary>
+        /// Presents (and waits on the swap barrier) from a native worker thread so that the rendering thread can work
+        /// on the next frame instead of blocking until the whole cluster reached the barrier (D3D12 only).
+        /// </summary>
+        /// <param name="maxInFlightFrames">Number of frames that can be waiting to be presented, 0 to present from the
+        /// rendering thread again.</param>
+        /// <remarks>The number of frames in flight is also limited to the number of buffers of the swap chain minus
+        /// one, the plugin waits for a back buffer to be presented before Unity renders to it again.</remarks>
+        public static void EnableAsyncPresent(uint maxInFlightFrames)
+        {
+            ExecuteQuadroSyncCommand(EQuadroSyncRenderEvent.QuadroSyncEnableAsyncPresent,
+                new IntPtr(maxInFlightFrames));
+        }
+
+        /// <summary>
+        /// Waits (on the rendering thread) for every frame handed to the present worker thread to be presented.
+        /// </summary>
+        /// <remarks>Not needed to render to the back buffer (the plugin already waits for it), only before using
+        /// something the presents in flight might still be using.</remarks>
+        public static void WaitForPresent()
+        {
+            ExecuteQuadroSyncCommand(EQuadroSyncRenderEvent.QuadroSyncWaitForPresent, IntPtr.Zero);
+        }
+
+        /// <summary>
+        /// Starts warming up the swap barrier in coordination with the other nodes of the cluster (the warmup is
+        /// performed by the plugin on the rendering thread, progress can be followed through
+        /// <see cref="GfxPluginQuadroSyncState.BarrierWarmupState"/>).
+        /// </summary>
+        /// <param name="udpAgent">Agent used by the cluster to communicate (the warmup uses the same multicast
+        /// address and adapter on the following port).</param>
+        /// <param name="nodeId">Identifier of this node.</param>
+        /// <param name="isEmitter">Is this node the emitter (driving the warmup) or a repeater?</param>
+        /// <param name="repeaters">Repeaters the emitter has to wait on (ignored by repeaters).</param>
+        /// <param name="presentsToSkip">Number of presents the emitter skips before starting to warm up.</param>
+        /// <param name="timeout">Maximum duration of the warmup.</param>
+        /// <returns>Was the warmup started?</returns>
+        internal static bool StartBarrierWarmup(IUdpAgent udpAgent, byte nodeId, bool isEmitter,
+            NodeIdBitVectorReadOnly repeaters, uint presentsToSkip, TimeSpan timeout)
+        {
+            var parameters = new GfxPluginQuadroSyncUtilities.BarrierWarmupParameters()
+            {
+                MulticastAddress = udpAgent.MulticastAddress.ToString(),
+                AdapterAddress = udpAgent.AdapterAddress.ToString(),
+                Port = (ushort)(udpAgent.Port + 1),
+                NodeId = nodeId,
+                IsEmitter = isEmitter,
+                PresentsToSkip = presentsToSkip,
+                TimeoutMs = (uint)Math.Min(timeout.TotalMilliseconds, uint.MaxValue)
+            };
+            repeaters?.CopyTo(out parameters.Repeaters0, out parameters.Repeaters1, out parameters.Repeaters2,
+                out parameters.Repeaters3);
+            return GfxPluginQuadroSyncUtilities.StartBarrierWarmup(ref parameters);
+        }
+
+        /// <summary>
+        /// Aborts the swap barrier warmup started by <see cref="StartBarrierWarmup"/> (if still in progress).
+        /// </summary>
+        public static void AbortBarrierWarmup()
+        {
+            GfxPluginQuadroSyncUtilities.AbortBarrierWarmup();
+        }
+
+        /// <summary>
+        /// Use a swap barrier implemented in software (nodes exchanging datagrams before every present) instead of the
+        /// Quadro Sync hardware.  Must be called before <see cref="EQuadroSyncRenderEvent.QuadroSyncInitialize"/>.
+        /// </summary>
+        /// <param name="udpAgent">Agent used by the cluster to communicate (the software barrier uses the same
+        /// multicast address and adapter on the port following the one of the barrier warmup).</param>
+        /// <param name="nodeId">Identifier of this node.</param>
+        /// <param name="nodes">Every node of the cluster.</param>
+        /// <param name="timeout">Maximum time to wait on the other nodes before presenting anyway.</param>
+        /// <param name="hostInstanceCount">Number of instances running on this computer (only the first one takes
+        /// part in the barrier with the other nodes, <paramref name="nodes"/> must then only contain the first instance
+        /// of every computer).</param>
+        /// <param name="hostInstanceIndex">Index of this instance among the ones running on this computer.</param>
+        /// <param name="algorithm">Algorithm used to synchronize the nodes (must be the same on every node).</param>
+        /// <param name="fanOut">Number of children of every node (<see cref="SoftwareSwapBarrierAlgorithm.Tree"/>)
+        /// or of nodes notified per round (<see cref="SoftwareSwapBarrierAlgorithm.Dissemination"/>), 0 for the
+        /// default.</param>
+        /// <returns>Will the software swap barrier be used?</returns>
+        internal static bool UseSoftwareSwapBarrier(IUdpAgent udpAgent, byte nodeId, NodeIdBitVectorReadOnly nodes,
+            TimeSpan timeout, byte hostInstanceCount = 1, byte hostInstanceIndex = 0,
+            SoftwareSwapBarrierAlgorithm algorithm = SoftwareSwapBarrierAlgorithm.AllToAll, byte fanOut = 0)
+        {
+            var parameters = new GfxPluginQuadroSyncUtilities.SoftwareSwapBarrierParameters()
+            {
+                MulticastAddress = udpAgent.MulticastAddress.ToString(),
+                AdapterAddress = udpAgent.AdapterAddress.ToString(),
+                Port = (ushort)(udpAgent.Port + 2),
+                NodeId = nodeId,
+                TimeoutMs = (uint)Math.Min(timeout.TotalMilliseconds, uint.MaxValue),
+                HostBarrierName = $"GfxQuadroSyncHostBarrier_{udpAgent.Port}",
+                HostInstanceCount = hostInstanceCount,
+                HostInstanceIndex = hostInstanceIndex,
+                Algorithm = algorithm,
+                FanOut = fanOut
+            };
+            nodes?.CopyTo(out parameters.Nodes0, out parameters.Nodes1, out parameters.Nodes2, out parameters.Nodes3);
+            return GfxPluginQuadroSyncUtilities.UseSoftwareSwapBarrier(ref parameters);
+        }
+
+        /// <summary>
+        /// Fetch statistics about the software swap barrier (in the same format as
+        /// <see cref="FetchPresentStatistics"/>).
+        /// </summary>
+        /// <param name="statistic">The statistic to fetch.</param>
+        /// <returns>The statistics or <c>null</c> if the software swap barrier is not used.</returns>
+        public static GfxPluginQuadroSyncPresentStatistics? FetchSoftwareSwapBarrierStatistics(
+            SoftwareSwapBarrierStatistic statistic)
+        {
+            var toReturn = GfxPluginQuadroSyncPresentStatistics.Create();
+            if (!GfxPluginQuadroSyncUtilities.GetSoftwareSwapBarrierStatistics(statistic, ref toReturn))
+            {
+                return null;
+            }
+            return toReturn;
+        }
+
+        /// <summary>
+        /// Starts estimating (in the background) the offset between the clock of this node and the clock of the
+        /// emitter, so that times of different nodes can be compared (see <see cref="FetchClockSyncState"/>).
+        /// </summary>
+        /// <param name="udpAgent">Agent used by the cluster to communicate (the clock synchronization uses the same
+        /// multicast address and adapter on the port following the one of the software swap barrier).</param>
+        /// <param name="nodeId">Identifier of this node.</param>
+        /// <param name="isEmitter">Is this node the emitter (whose clock is the cluster time) or a repeater?</param>
+        /// <returns>Was the synchronization started?</returns>
+        internal static bool StartClockSync(IUdpAgent udpAgent, byte nodeId, bool isEmitter)
+        {
+            var parameters = new GfxPluginQuadroSyncUtilities.ClockSyncParameters()
+            {
+                MulticastAddress = udpAgent.MulticastAddress.ToString(),
+                AdapterAddress = udpAgent.AdapterAddress.ToString(),
+                Port = (ushort)(udpAgent.Port + 3),
+                NodeId = nodeId,
+                IsEmitter = isEmitter
+            };
+            return GfxPluginQuadroSyncUtilities.StartClockSync(ref parameters);
+        }
+
+        /// <summary>
+        /// Fetch the current estimate of the cluster time.
         /// </summary>
-        /// <param name="func">The callback</param>
-        public static void SetBarrierWarmupCallback(Func<BarrierWarmupAction> func)
+        /// <returns>The estimate (<see cref="GfxPluginQuadroSyncClockSyncState.Valid"/> is false if
+        /// <see cref="StartClockSync"/> was not called or no sample was received yet).</returns>
+        public static GfxPluginQuadroSyncClockSyncState FetchClockSyncState()
         {
-            // We have to keep a managed copy of the delegate because (from GetFunctionPointerForDelegate remarks):
-            // You must manually keep the delegate from being collected by the garbage collector from managed code. The
-            // garbage collector does not track references to unmanaged code.
-            s_SetBarrierWarmupCallback = func;
-            GfxPluginQuadroSyncUtilities.SetBarrierWarmupCallback(
-                func != null ? Marshal.GetFunctionPointerForDelegate(func) : IntPtr.Zero);
+            var toReturn = new GfxPluginQuadroSyncClockSyncState();
+            GfxPluginQuadroSyncUtilities.GetClockSyncState(ref toReturn);
+            return toReturn;
+        }
+
+        /// <summary>
+        /// Present every frame at a cluster time assigned by the emitter instead of waiting on a swap barrier (for
+        /// clusters without Quadro Sync hardware).  Must be called before
+        /// <see cref="EQuadroSyncRenderEvent.QuadroSyncInitialize"/> and repeaters must also call
+        /// <see cref="StartClockSync"/>.
+        /// </summary>
+        /// <param name="udpAgent">Agent used by the cluster to communicate (scheduled presents use the same multicast
+        /// address and adapter on the port following the one of the clock synchronization).</param>
+        /// <param name="isEmitter">Is this node the emitter (assigning the present time of every frame)?</param>
+        /// <param name="refreshPeriod">Refresh period of the displays.</param>
+        /// <returns>Will presents be scheduled?</returns>
+        internal static bool UseScheduledPresents(IUdpAgent udpAgent, bool isEmitter, TimeSpan refreshPeriod)
+        {
+            var parameters = new GfxPluginQuadroSyncUtilities.ScheduledPresentsParameters()
+            {
+                MulticastAddress = udpAgent.MulticastAddress.ToString(),
+                AdapterAddress = udpAgent.AdapterAddress.ToString(),
+                Port = (ushort)(udpAgent.Port + 4),
+                IsEmitter = isEmitter,
+                RefreshPeriodUs = (uint)Math.Min(refreshPeriod.Ticks / 10, uint.MaxValue)
+            };
+            return GfxPluginQuadroSyncUtilities.UseScheduledPresents(ref parameters);
+        }
+
+        /// <summary>
+        /// Fetch statistics about how late scheduled presents were compared to the time assigned by the emitter (in the
+        /// same format as <see cref="FetchPresentStatistics"/>).
+        /// </summary>
+        /// <returns>The statistics or <c>null</c> if presents are not scheduled.</returns>
+        public static GfxPluginQuadroSyncPresentStatistics? FetchScheduledPresentJitterStatistics()
+        {
+            var toReturn = GfxPluginQuadroSyncPresentStatistics.Create();
+            if (!GfxPluginQuadroSyncUtilities.GetScheduledPresentJitterStatistics(ref toReturn))
+            {
+                return null;
+            }
+            return toReturn;
         }
-        // ReSharper disable once NotAccessedField.Local -> See comment in SetBarrierWarmupCallback
-        static Func<BarrierWarmupAction> s_SetBarrierWarmupCallback;
 
         /// <summary>
         /// Fetch the state of GfxPluginQuadroSync.
         /// </summary>
         /// <returns>The state of GfxPluginQuadroSync</returns>
-        /// <remarks>This is not a simple readonly property as getting this state is not "free" and fetching of the
-        /// latest value is done every time the method is called.</remarks>
+        /// <remarks>Returns the state last published by the plugin in its <see cref="GfxPluginQuadroSyncStateBlock"/>
+        /// (read without any call to the plugin, so cheap enough to be done every frame).  Falls back to asking the
+        /// plugin (with properties that are not necessarily consistent with each other) when nothing was published
+        /// yet.</remarks>
         public static GfxPluginQuadroSyncState FetchState()
         {
+            if (!s_StateBlockOpened)
+            {
+                // Only try once, a plugin that does not provide the block will not start doing so.
+                s_StateBlock = GfxPluginQuadroSyncStateBlock.Open();
+                s_StateBlockOpened = true;
+            }
+            if (s_StateBlock != null && s_StateBlock.TryRead(out var state))
+            {
+                return state;
+            }
+
             var toReturn = new GfxPluginQuadroSyncState();
             GfxPluginQuadroSyncUtilities.GetState(ref toReturn);
             return toReturn;
         }
+
+        static GfxPluginQuadroSyncStateBlock s_StateBlock;
+        static bool s_StateBlockOpened;
+
+        /// <summary>
+        /// Fetch statistics about how long presents (and so waiting on the swap barrier) are taking.
+        /// </summary>
+        /// <returns>The statistics.</returns>
+        /// <remarks>The returned struct is fairly large (it contains the whole histogram), so this should not be
+        /// called every frame.</remarks>
+        public static GfxPluginQuadroSyncPresentStatistics FetchPresentStatistics()
+        {
+            var toReturn = GfxPluginQuadroSyncPresentStatistics.Create();
+            if (!GfxPluginQuadroSyncUtilities.GetPresentStatistics(ref toReturn))
+            {
+                throw new InvalidOperationException("GfxPluginQuadroSync does not support the requested version of " +
+                    "the present statistics.");
+            }
+            return toReturn;
+        }
     }
 }
@@ -2,6 +2,7 @@
 using Unity.ClusterDisplay.Utils;
 using UnityEngine;
 using UnityEngine.PlayerLoop;
+using Utils;
 
 namespace Unity.ClusterDisplay
 {
@@ -26,6 +27,10 @@ protected override (NodeState, DoFrameResult?) DoFrameImplementation()
 #if UNITY_EDITOR
                 ClusterDebug.Log("You are attempting to initialize Quadro Sync swap barriers in the Editor. This will likely fail.");
 #endif
+                if (Node.Config.Fence is FrameSyncFence.Software && !UseSoftwareSwapBarrier())
+                {
+                    ClusterDebug.LogError("Failed to set up the software swap barrier.");
+                }
                 GfxPluginQuadroSyncSystem.ExecuteQuadroSyncCommand(GfxPluginQuadroSyncSystem.EQuadroSyncRenderEvent.QuadroSyncInitialize, new IntPtr());
 
                 // We won't know immediately if everything worked (and if we are really using hardware acceleration), so
@@ -43,6 +48,29 @@ protected override (NodeState, DoFrameResult?) DoFrameImplementation()
             return base.DoFrameImplementation();
         }
 
+        /// <summary>
+        /// Ask the plugin to use its software swap barrier (between the nodes of
+        /// <see cref="ClusterNodeConfig.SoftwareSwapBarrierNodeCount"/>) instead of the Quadro Sync hardware.
+        /// </summary>
+        /// <returns>Will the software swap barrier be used?</returns>
+        bool UseSoftwareSwapBarrier()
+        {
+            var nodeCount = Node.Config.SoftwareSwapBarrierNodeCount;
+            if (nodeCount <= Node.Config.NodeId || nodeCount > byte.MaxValue + 1)
+            {
+                ClusterDebug.LogError($"Invalid number of nodes for the software swap barrier: {nodeCount}.");
+                return false;
+            }
+
+            var nodes = new NodeIdBitVector();
+            for (int nodeId = 0; nodeId < nodeCount; ++nodeId)
+            {
+                nodes[(byte)nodeId] = true;
+            }
+            return GfxPluginQuadroSyncSystem.UseSoftwareSwapBarrier(Node.UdpAgent, Node.Config.NodeId, nodes,
+                Node.Config.CommunicationTimeout);
+        }
+
         protected GfxPluginQuadroSyncInitializationState InitializationState { get; private set; }
             = GfxPluginQuadroSyncInitializationState.NotInitialized;
 
@@ -62,34 +90,62 @@ protected void ReportInitializationError(GfxPluginQuadroSyncInitializationState
         }
 
         /// <summary>
-        /// Wrapper around <see cref="GfxPluginQuadroSyncSystem.SetBarrierWarmupCallback"/> that deals with exceptions.
+        /// Starts the warmup of the swap barrier (performed by the plugin in coordination with the other nodes) and
+        /// monitors it until it is done.
         /// </summary>
-        /// <param name="func"></param>
-        protected void SetBarrierWarmupCallback(Func<GfxPluginQuadroSyncSystem.BarrierWarmupAction> func)
+        /// <param name="repeaters">Repeaters the emitter has to wait on (null for repeaters).</param>
+        /// <param name="presentsToSkip">Number of presents the emitter skips before starting to warm up.</param>
+        /// <remarks>QuadroSync Swap Barrier does not enter in action immediately and so nodes have to present in a
+        /// coordinated way (using the network) until it is up and running.</remarks>
+        protected void StartBarrierWarmup(NodeIdBitVectorReadOnly repeaters, uint presentsToSkip)
         {
-            if (func != null)
+            bool isEmitter = Node.NodeRole is NodeRole.Emitter;
+            if (!GfxPluginQuadroSyncSystem.StartBarrierWarmup(Node.UdpAgent, Node.Config.NodeId, isEmitter, repeaters,
+                    presentsToSkip, Node.Config.HandshakeTimeout))
             {
-                GfxPluginQuadroSyncSystem.SetBarrierWarmupCallback(() =>
-                {
-                    try
-                    {
-                        return func();
-                    }
-                    catch (Exception e)
-                    {
-                        ClusterDebug.LogException(e);
-                        ReportInitializationError(GfxPluginQuadroSyncInitializationState.UnexpectedException);
-                        if (ServiceLocator.TryGet<IClusterSyncState>(out var clusterSyncState))
-                        {
-                            clusterSyncState.Terminate();
-                        }
-                        return GfxPluginQuadroSyncSystem.BarrierWarmupAction.ContinueToNextFrame;
-                    }
-                });
+                ClusterDebug.LogError("Failed to start the warmup of the QuadroSync swap barrier.");
+            }
+
+            m_TerminateOnBarrierWarmupFailure = isEmitter;
+            PlayerLoopExtensions.RegisterUpdate<TimeUpdate.WaitForLastPresentationAndUpdateTime, CheckBarrierWarmupState>(
+                MonitorBarrierWarmup);
+        }
+
+        struct CheckBarrierWarmupState { }
+
+        void MonitorBarrierWarmup()
+        {
+            // Unblock if the cluster display is terminating for whatever reason
+            if (ServiceLocator.TryGet<IClusterSyncState>(out var clusterSyncState) && clusterSyncState.IsTerminated)
+            {
+                GfxPluginQuadroSyncSystem.AbortBarrierWarmup();
             }
-            else
+
+            var warmupState = GfxPluginQuadroSyncSystem.FetchState().BarrierWarmupState;
+            if (warmupState is GfxPluginQuadroSyncBarrierWarmupState.NotStarted or
+                GfxPluginQuadroSyncBarrierWarmupState.InProgress)
             {
-                GfxPluginQuadroSyncSystem.SetBarrierWarmupCallback(null);
+                return;
+            }
+
+            // Warmup is over, we do not need to be called again
+            PlayerLoopExtensions.DeregisterUpdate<CheckBarrierWarmupState>(MonitorBarrierWarmup);
+            if (warmupState == GfxPluginQuadroSyncBarrierWarmupState.Succeeded)
+            {
+                return;
+            }
+
+            ReportInitializationError(warmupState switch
+            {
+                GfxPluginQuadroSyncBarrierWarmupState.Timeout =>
+                    GfxPluginQuadroSyncInitializationState.BarrierWarmupTimeout,
+                GfxPluginQuadroSyncBarrierWarmupState.Aborted =>
+                    GfxPluginQuadroSyncInitializationState.UnexpectedTermination,
+                _ => GfxPluginQuadroSyncInitializationState.BarrierWarmupNetworkFailure
+            });
+            if (m_TerminateOnBarrierWarmupFailure && clusterSyncState is {IsTerminated: false})
+            {
+                clusterSyncState.Terminate();
             }
         }
 
@@ -113,16 +169,8 @@ void ProcessQuadroSyncInitResult()
         }
 
         /// <summary>
-        /// If we are waiting for a frame to be presented for more than 150 milliseconds it means that we are blocked
-        /// waiting for other nodes to render the frame and so the barrier is up and running.
-        /// </summary>
-        /// <remarks>150 was chosen as it is a few time longer than the slower rate that we should expect running at (24
-        /// fps) and presenting should in theory never wait more than 1 frame (or 2 or maybe 3 if things are going
-        /// really bad).</remarks>
-        protected static readonly TimeSpan k_BlockDelay = TimeSpan.FromMilliseconds(150);
-        /// <summary>
-        /// We need to repeat messages once in a while in case it gets lost (UDP is not reliable).
+        /// Does a failure of the barrier warmup terminates the cluster?
         /// </summary>
-        protected static readonly TimeSpan k_RepeatMessageInterval = TimeSpan.FromMilliseconds(25);
+        bool m_TerminateOnBarrierWarmupFailure;
     }
 }
@@ -17,7 +17,7 @@ class HardwareSyncInitState: NodeState
     {
         public static NodeState Create(ClusterNode node)
         {
-#if UNITY_STANDALONE_WIN
+#if UNITY_STANDALONE_WIN || UNITY_STANDALONE_LINUX
             return node.NodeRole switch
             {
                 NodeRole.Emitter => new QuadroSyncInitEmitterState(node),
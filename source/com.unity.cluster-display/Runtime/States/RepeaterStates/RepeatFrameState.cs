@@ -82,8 +82,17 @@ protected override (NodeState, DoFrameResult?) DoFrameImplementation()
             {
                 // Get the FrameData to use for the frame we are about to start
                 m_FrameDataAssembler.WillNeedFrame(Node.FrameIndex);
+                long holdFrameDeadline = GetHoldFrameDeadline();
                 while (receivedMessage == null && Stopwatch.GetTimestamp() <= doFrameDeadline)
                 {
+                    // The frame will not be ready for the next refresh, present the last one again so that the other
+                    // nodes do not wait on us at the swap barrier.
+                    if (Stopwatch.GetTimestamp() >= holdFrameDeadline)
+                    {
+                        GfxPluginQuadroSyncSystem.HoldFrame();
+                        holdFrameDeadline = GetHoldFrameDeadline();
+                    }
+
                     // Stop execution immediately if we are running for a backup node that is ready to become an emitter
                     // node.
                     if (Node.IsBackupToEmitterSwitchReady())
@@ -92,8 +101,8 @@ protected override (NodeState, DoFrameResult?) DoFrameImplementation()
                     }
 
                     // Get the next message we receive on the network
-                    receivedMessage = udpAgent.TryConsumeNextReceivedMessage(
-                        StopwatchUtils.TimeUntil(doFrameDeadline, s_MaxWaitForSingleMessage));
+                    receivedMessage = udpAgent.TryConsumeNextReceivedMessage(StopwatchUtils.TimeUntil(
+                        Math.Min(doFrameDeadline, holdFrameDeadline), s_MaxWaitForSingleMessage));
                     if (receivedMessage == null)
                     {
                         continue;
@@ -146,6 +155,23 @@ protected override (NodeState, DoFrameResult?) DoFrameImplementation()
 
         protected override IntPtr GetProfilerMarker() => s_ProfilerMarker;
 
+        /// <summary>
+        /// Returns when to present the last frame again if the data of the frame is still not received.
+        /// </summary>
+        /// <returns>One refresh from now or <see cref="long.MaxValue"/> if frames are not held (the swap barrier is
+        /// not used or <see cref="ClusterNodeConfig.HoldLateFrames"/> is not set).</returns>
+        long GetHoldFrameDeadline()
+        {
+            if (!Node.Config.HoldLateFrames || Node.UsingNetworkSync)
+            {
+                return long.MaxValue;
+            }
+
+            var refreshRate = UnityEngine.Screen.currentResolution.refreshRateRatio.value;
+            return refreshRate > 0 ? StopwatchUtils.TimestampIn(TimeSpan.FromSeconds(1.0 / refreshRate)) :
+                long.MaxValue;
+        }
+
         /// <summary>
         /// Perform network based synchronization
         /// </summary>